@@ -13,7 +13,7 @@
 // [x] use variable size array buffers for each tracker datum instead of [kMaxTrack]
 // [x] turn the truth/GEANT information into vectors
 // [ ] move hit_trkid into the track information, remove kMaxTrackers
-// [ ] turn the hit information into vectors (~1 MB worth), remove kMaxHits
+// [x] turn the hit information into vectors (~1 MB worth), remove kMaxHits
 // [ ] fill the tree branch by branch
 // 
 // Current implementation:
@@ -41,7 +41,12 @@
 // AnalysisTreeDataStruct can be initialized first (and with unusable track data
 // structures), and then the TrackDataStruct instances are initialized one by
 // one when the number of tracks needed is known.
-// A similar mechanism is implemented for the truth information.
+// A similar mechanism is implemented for the truth information, and for the
+// hit and vertex information: their buffers are sized on each event to the
+// number of hits and vertices, instead of a fixed compile-time maximum, so
+// that neither memory nor clearing time is spent on data that is not there.
+// Blocks which are not enabled in the configuration (`SaveHitInfo` etc.) are
+// never resized, have no branch in the tree and cost no clearing time.
 // 
 // The "UseBuffers: false" mode assumes that on each event a new
 // AnalysisTreeDataStruct is created with unusable tracker data, connected to
@@ -138,10 +143,8 @@
 #include "TTimeStamp.h"
 
 constexpr int kNplanes       = 3;     //number of wire planes
-constexpr int kMaxHits       = 25000; //maximum number of hits;
 constexpr int kMaxTrackHits  = 2000;  //maximum number of hits on a track
 constexpr int kMaxTrackers   = 15;    //number of trackers passed into fTrackModuleLabel
-constexpr unsigned short kMaxVertices   = 100;    //max number of 3D vertices
 constexpr unsigned short kMaxAuxDets = 4; ///< max number of auxiliary detector cells per MC particle
 
 /// total_extent\<T\>::value has the total number of elements of an array
@@ -352,24 +355,26 @@ namespace icarus {
     // Double_t   taulife;              //electron lifetime
     Char_t     isdata;               //flag, 0=MC 1=data
 
-    // hit information (non-resizeable, 45x kMaxHits = 900k bytes worth)
+    // hit information
+    size_t MaxHits = 0; ///! how many hits there is currently room for
     Int_t    no_hits;                  //number of hits
-    Short_t  hit_tpc[kMaxHits];        //tpc number
-    Short_t  hit_plane[kMaxHits];      //plane number
-    Short_t  hit_wire[kMaxHits];       //wire number
-    Short_t  hit_channel[kMaxHits];    //channel ID
-    Float_t  hit_peakT[kMaxHits];      //peak time
-    Float_t  hit_charge[kMaxHits];     //charge (area)
-    Float_t  hit_ph[kMaxHits];         //amplitude
-    Float_t  hit_startT[kMaxHits];     //hit start time
-    Float_t  hit_endT[kMaxHits];       //hit end time
-    Float_t  hit_nelec[kMaxHits];     //hit number of electrons
-    Float_t  hit_energy[kMaxHits];       //hit energy
-    Short_t  hit_trkid[kMaxHits];      //is this hit associated with a reco track?
+    std::vector<Short_t>  hit_tpc;     //tpc number
+    std::vector<Short_t>  hit_plane;   //plane number
+    std::vector<Short_t>  hit_wire;    //wire number
+    std::vector<Short_t>  hit_channel; //channel ID
+    std::vector<Float_t>  hit_peakT;   //peak time
+    std::vector<Float_t>  hit_charge;  //charge (area)
+    std::vector<Float_t>  hit_ph;      //amplitude
+    std::vector<Float_t>  hit_startT;  //hit start time
+    std::vector<Float_t>  hit_endT;    //hit end time
+    std::vector<Float_t>  hit_nelec;   //hit number of electrons
+    std::vector<Float_t>  hit_energy;  //hit energy
+    std::vector<Short_t>  hit_trkid;   //is this hit associated with a reco track?
 
     // vertex information
+    size_t MaxVertices = 0; ///! how many vertices there is currently room for
     Short_t  nvtx;                     //number of vertices
-    Float_t  vtx[kMaxVertices][3];     //vtx[3]  
+    std::vector<BoxedArray<Float_t[3]>> vtx; //vtx[3]
 
     //track information
     Char_t   kNTracker;
@@ -547,6 +552,12 @@ namespace icarus {
     /// Allocates data structures for the given number of trackers (no Clear())
     void SetTrackers(size_t nTrackers) { TrackData.resize(nTrackers); }
 
+    /// Resize the data structure for hits
+    void ResizeHits(int nHits);
+    
+    /// Resize the data structure for vertices
+    void ResizeVertices(int nVertices);
+    
     /// Resize the data structure for MCNeutrino particles
     void ResizeMCNeutrino(int nNeutrinos);
     
@@ -567,7 +578,7 @@ namespace icarus {
     size_t GetNTrackers() const { return TrackData.size(); }
     
     /// Returns the number of hits for which memory is allocated
-    size_t GetMaxHits() const { return kMaxHits; }
+    size_t GetMaxHits() const { return MaxHits; }
     
     /// Returns the number of trackers for which memory is allocated
     size_t GetMaxTrackers() const { return TrackData.capacity(); }
@@ -1201,23 +1212,21 @@ void icarus::AnalysisTreeDataStruct::ClearLocalData() {
 
   no_hits = 0;
  
-  std::fill(hit_tpc, hit_tpc + sizeof(hit_tpc)/sizeof(hit_tpc[0]), -9999);
-  std::fill(hit_plane, hit_plane + sizeof(hit_plane)/sizeof(hit_plane[0]), -9999);
-  std::fill(hit_wire, hit_wire + sizeof(hit_wire)/sizeof(hit_wire[0]), -9999);
-  std::fill(hit_channel, hit_channel + sizeof(hit_channel)/sizeof(hit_channel[0]), -9999);
-  std::fill(hit_peakT, hit_peakT + sizeof(hit_peakT)/sizeof(hit_peakT[0]), -99999.);
-  std::fill(hit_charge, hit_charge + sizeof(hit_charge)/sizeof(hit_charge[0]), -99999.);
-  std::fill(hit_ph, hit_ph + sizeof(hit_ph)/sizeof(hit_ph[0]), -99999.);
-  std::fill(hit_startT, hit_startT + sizeof(hit_startT)/sizeof(hit_startT[0]), -99999.);
-  std::fill(hit_endT, hit_endT + sizeof(hit_endT)/sizeof(hit_endT[0]), -99999.);
-  std::fill(hit_trkid, hit_trkid + sizeof(hit_trkid)/sizeof(hit_trkid[0]), -9999);
-  std::fill(hit_nelec, hit_nelec + sizeof(hit_nelec)/sizeof(hit_nelec[0]), -99999.);
-  std::fill(hit_energy, hit_energy + sizeof(hit_energy)/sizeof(hit_energy[0]), -99999.);
+  FillWith(hit_tpc, -9999);
+  FillWith(hit_plane, -9999);
+  FillWith(hit_wire, -9999);
+  FillWith(hit_channel, -9999);
+  FillWith(hit_peakT, -99999.);
+  FillWith(hit_charge, -99999.);
+  FillWith(hit_ph, -99999.);
+  FillWith(hit_startT, -99999.);
+  FillWith(hit_endT, -99999.);
+  FillWith(hit_trkid, -9999);
+  FillWith(hit_nelec, -99999.);
+  FillWith(hit_energy, -99999.);
 
   nvtx = 0;
-  for (size_t ivtx = 0; ivtx < kMaxVertices; ++ivtx) {
-    std::fill(vtx[ivtx], vtx[ivtx]+3, -99999.);
-  }
+  for (auto& vertex: vtx) FillWith(vertex, -99999.);
 
   mcevts_truth = 0;
   mcevts_truthcry = -99999;
@@ -1339,6 +1348,33 @@ void icarus::AnalysisTreeDataStruct::Clear() {
     (TrackData.begin(), TrackData.end(), std::mem_fn(&TrackDataStruct::Clear));
 } // icarus::AnalysisTreeDataStruct::Clear()
 
+void icarus::AnalysisTreeDataStruct::ResizeHits(int nHits) {
+
+  // minimum size is 1, so that we always have an address
+  MaxHits = (size_t) std::max(nHits, 1);
+  hit_tpc.resize(MaxHits);
+  hit_plane.resize(MaxHits);
+  hit_wire.resize(MaxHits);
+  hit_channel.resize(MaxHits);
+  hit_peakT.resize(MaxHits);
+  hit_charge.resize(MaxHits);
+  hit_ph.resize(MaxHits);
+  hit_startT.resize(MaxHits);
+  hit_endT.resize(MaxHits);
+  hit_nelec.resize(MaxHits);
+  hit_energy.resize(MaxHits);
+  hit_trkid.resize(MaxHits);
+
+} // icarus::AnalysisTreeDataStruct::ResizeHits()
+
+void icarus::AnalysisTreeDataStruct::ResizeVertices(int nVertices) {
+
+  // minimum size is 1, so that we always have an address
+  MaxVertices = (size_t) std::max(nVertices, 1);
+  vtx.resize(MaxVertices);
+
+} // icarus::AnalysisTreeDataStruct::ResizeVertices()
+
 void icarus::AnalysisTreeDataStruct::ResizeMCNeutrino(int nNeutrinos){
 
   //min size is 1, to guarantee an address
@@ -1851,6 +1887,10 @@ void icarus::AnalysisTree::analyze(const art::Event& evt)
   nMCNeutrinos = mclist.size();
 
   CreateData(); // tracker data is created with default constructor
+  if (fSaveHitInfo)
+    fData->ResizeHits(hitlist.size());
+  if (fSaveVertexInfo)
+    fData->ResizeVertices(vtxlist.size());
   if (fSaveGenieInfo){
     fData->ResizeGenie(nGeniePrimaries);
     fData->ResizeMCNeutrino(nMCNeutrinos);
@@ -1918,13 +1958,7 @@ void icarus::AnalysisTree::analyze(const art::Event& evt)
   //hit information
   if (fSaveHitInfo){
     fData->no_hits = (int) NHits;
-    if (NHits > kMaxHits) {
-      // got this error? consider increasing kMaxHits
-      // (or ask for a redesign using vectors)
-      mf::LogError("AnalysisTree:limits") << "event has " << NHits
-        << " hits, only kMaxHits=" << kMaxHits << " stored in tree";
-    }
-    for (size_t i = 0; i < NHits && i < kMaxHits ; ++i){//loop over hits
+    for (size_t i = 0; i < NHits; ++i){//loop over hits
       fData->hit_channel[i] = hitlist[i]->Channel();
       fData->hit_tpc[i]     = hitlist[i]->WireID().TPC;
       fData->hit_plane[i]   = hitlist[i]->WireID().Plane;
@@ -1968,7 +2002,7 @@ void icarus::AnalysisTree::analyze(const art::Event& evt)
     if (evt.getByLabel(fHitsModuleLabel,hitListHandle)){
       //Find tracks associated with hits
       art::FindManyP<recob::Track> fmtk(hitListHandle,evt,fTrackModuleLabel[0]);
-      for (size_t i = 0; i < NHits && i < kMaxHits ; ++i){//loop over hits
+      for (size_t i = 0; i < NHits; ++i){//loop over hits
         if (fmtk.isValid()){
 	  if (fmtk.at(i).size()!=0){
 	    fData->hit_trkid[i] = fmtk.at(i)[0]->ID();
@@ -1983,13 +2017,7 @@ void icarus::AnalysisTree::analyze(const art::Event& evt)
   //vertex information
   if (fSaveVertexInfo){
     fData->nvtx = NVertices;
-    if (NVertices > kMaxVertices){
-      // got this error? consider increasing kMaxVerticestra
-      // (or ask for a redesign using vectors)
-      mf::LogError("AnalysisTree:limits") << "event has " << NVertices
-        << " vertices, only kMaxVertices=" << kMaxVertices << " stored in tree";
-    }
-    for (size_t i = 0; i < NVertices && i < kMaxVertices ; ++i){//loop over hits
+    for (size_t i = 0; i < NVertices; ++i){//loop over vertices
       Double_t xyz[3] = {};
       vtxlist[i]->XYZ(xyz);
       for (size_t j = 0; j<3; ++j) fData->vtx[i][j] = xyz[j];
@@ -2134,7 +2162,7 @@ void icarus::AnalysisTree::analyze(const art::Event& evt)
       */
       Float_t minsdist = 10000;
       Float_t minedist = 10000;
-      for (int ivx = 0; ivx < fData->nvtx && ivx < kMaxVertices; ++ivx){
+      for (int ivx = 0; ivx < fData->nvtx; ++ivx){
         Float_t sdist = sqrt(pow(TrackerData.trkstartx[iTrk]-fData->vtx[ivx][0],2)+
                              pow(TrackerData.trkstarty[iTrk]-fData->vtx[ivx][1],2)+
                              pow(TrackerData.trkstartz[iTrk]-fData->vtx[ivx][2],2));
@@ -212,7 +212,11 @@ void HitEfficiencyAna::analyze(const art::Event& event)
     
     // Make a pass through all hits to make contrasting plots
     std::cout << "-- Run: " << fRun << ", SubRun: " << fSubRun << ", Event: " << fEvent << " -------" << std::endl;
-    for(auto& hitHistTool : fHitHistogramToolVec) hitHistTool->fillHistograms(event);
+
+    // The MC truth indices are built once for this event, and shared by the tools
+    icarus::SimChannelTruthIndexSet<art::Event> truthIndices(event);
+
+    for(auto& hitHistTool : fHitHistogramToolVec) hitHistTool->fillHistograms(event, truthIndices);
     
     fTree->Fill();
 
@@ -12,11 +12,19 @@
 
 #include <iomanip>
 #include <TH1F.h>
+#include <TAxis.h>
+#include <THLimitsFinder.h>
 #include <TProfile.h>
 #include <vector>
 #include <string>
 #include <array>
 #include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <set>
 
 //Framework includes
 #include "art/Framework/Core/ModuleMacros.h" 
@@ -93,6 +101,20 @@ namespace icarus {
 
   private:
 
+    /// Assigns a cluster label to each candidate hit (-1 if isolated).
+    std::vector<int> ClusterHits
+      (std::vector<int> const& wires, std::vector<float> const& samples) const;
+
+    /// Straight line fit of a cluster, iteratively excluding the farthest hit.
+    int FitTrackLine(std::vector<float> const& whc, std::vector<float> const& shc,
+                     float& pendenza, float& intercetta) const;
+
+    // objects for the per-track fits: created once, reset at each use
+    std::unique_ptr<TH1F> h_fitres;
+    std::unique_ptr<TH1F> h_fitres_expo;
+    std::unique_ptr<TGraphErrors> gr_fit;
+    std::unique_ptr<TGraphAsymmErrors> gr_fit_asymm;
+
     TH1F* puritytpc0;
     TH1F* puritytpc1;
     TH1F* puritytpc2;
@@ -169,6 +191,97 @@ int fdsclusfcl;
 
 //#endif 
 
+namespace {
+
+  /**
+   * Standard deviation of the values filled into a `TH1F` with `nBins` bins and
+   * automatic range, without the histogram.
+   * 
+   * Such histogram holds the first entries in a buffer, then picks its range
+   * from them; entries filled after that which fall out of the range are not
+   * included in the statistics. This class reproduces that behaviour, using
+   * ROOT's own range finder and axis.
+   */
+  class AutoRangeStdDev {
+  public:
+    explicit AutoRangeStdDev(int nBins)
+      : fNBins(nBins), fBufferSize(TH1::GetDefaultBufferSize())
+      { fBuffer.reserve(fBufferSize); }
+
+    void clear()
+      { fBuffer.clear(); fAxis.reset(); fSumw = fSumwx = fSumwx2 = 0.0; }
+
+    void fill(double x)
+      {
+        if (!fAxis) {
+          if (fBuffer.size() < fBufferSize) { fBuffer.push_back(x); return; }
+          emptyBuffer();
+        }
+        add(x);
+      }
+
+    double stdDev()
+      {
+        if (!fAxis && !fBuffer.empty()) emptyBuffer();
+        if (fSumw == 0.0) return 0.0;
+        double const mean = fSumwx / fSumw;
+        return std::sqrt(std::max(fSumwx2 / fSumw - mean * mean, 0.0));
+      }
+
+  private:
+    int fNBins;
+    std::size_t fBufferSize;
+    std::vector<double> fBuffer; ///< Entries before the range is set.
+    std::optional<TAxis> fAxis; ///< Histogram axis, once the range is set.
+    double fSumw = 0.0, fSumwx = 0.0, fSumwx2 = 0.0;
+
+    void add(double x)
+      {
+        int const bin = fAxis->FindFixBin(x);
+        if ((bin == 0) || (bin > fAxis->GetNbins())) return; // under/overflow
+        fSumw += 1.0; fSumwx += x; fSumwx2 += x * x;
+      }
+
+    void emptyBuffer()
+      {
+        auto const [ minIt, maxIt ]
+          = std::minmax_element(fBuffer.begin(), fBuffer.end());
+        double xmin = *minIt, xmax = *maxIt;
+        if (xmin >= xmax) { xmin -= 1; xmax += 1; }
+        int nBins = fNBins;
+        THLimitsFinder::OptimizeLimits(fNBins, nBins, xmin, xmax, false);
+        fAxis.emplace(nBins, xmin, xmax);
+        for (double x: fBuffer) add(x);
+        fBuffer.clear();
+      }
+
+  }; // AutoRangeStdDev
+
+
+  void SetGraphPoints(TGraphErrors& graph, std::size_t n,
+    Double_t const* x, Double_t const* y, Double_t const* ex, Double_t const* ey)
+  {
+    graph.Set(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      graph.SetPoint(i, x[i], y[i]);
+      graph.SetPointError(i, ex[i], ey[i]);
+    }
+  }
+
+  void SetGraphPoints(TGraphAsymmErrors& graph, std::size_t n,
+    Double_t const* x, Double_t const* y, Double_t const* exl,
+    Double_t const* exh, Double_t const* eyl, Double_t const* eyh)
+  {
+    graph.Set(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      graph.SetPoint(i, x[i], y[i]);
+      graph.SetPointError(i, exl[i], exh[i], eyl[i], eyh[i]);
+    }
+  }
+
+} // local namespace
+
+
 namespace icarus{
 
   //--------------------------------------------------------------------
@@ -262,6 +375,14 @@ namespace icarus{
     if(fFillAnaTuple)
       purityTuple = tfs->make<TNtuple>("purityTuple","Purity Tuple","run:ev:tpc:att");
 
+    // not written to the output file
+    h_fitres = std::make_unique<TH1F>("h111","delta aree",200,-10,10);
+    h_fitres->SetDirectory(nullptr);
+    h_fitres_expo = std::make_unique<TH1F>("h111e","delta aree",100,-1000.,1000.);
+    h_fitres_expo->SetDirectory(nullptr);
+    gr_fit = std::make_unique<TGraphErrors>();
+    gr_fit_asymm = std::make_unique<TGraphAsymmErrors>();
+
   }
   
   void ICARUSPurityDQM::endJob()
@@ -306,14 +427,10 @@ namespace icarus{
   int punto_taglio=a->size()*(b)+0.5;
   //cout << punto_taglio << " e " << a->size() << endl;
   if(punto_taglio==0)punto_taglio=1;
-std::vector<float>* usedhere=new std::vector<float>;
- for(int j=0;j<(int)a->size();j++)usedhere->push_back((*a)[j]);
-
-  //cout << (*usedhere)[punto_taglio-1] << " PRIMA " << endl;
-std::sort(usedhere->begin(),usedhere->end(), [](float &c, float &d){ return c<d; });
-  //cout << (*usedhere)[punto_taglio-1] << " DOPO " << endl;
-  taglio=(*usedhere)[punto_taglio-1];
-  delete usedhere;
+  // only the value at the cut position is needed, not a full sort
+  std::vector<float> usedhere(a->begin(), a->end());
+  std::nth_element(usedhere.begin(), usedhere.begin() + (punto_taglio-1), usedhere.end());
+  taglio=usedhere[punto_taglio-1];
   }
   return taglio;
 
@@ -341,6 +458,127 @@ std::sort(usedhere->begin(),usedhere->end(), [](float &c, float &d){ return c<d;
 */
   }
       
+  std::vector<int> ICARUSPurityDQM::ClusterHits
+    (std::vector<int> const& wires, std::vector<float> const& samples) const
+  {
+    // Two hits are neighbours if closer than fdwclusfcl wires and fdsclusfcl
+    // samples. All the ordered pairs of neighbours are visited in index order:
+    // a pair of unlabelled hits starts a new cluster labelled after the first
+    // hit, a pair with one labelled hit extends that cluster, and a pair of
+    // hits with different labels moves to the label of the first hit all the
+    // hits of the label of the second one up to the second one included (and
+    // not beyond it), exactly as the original scan of all the hit pairs did.
+    // Neighbours are found via a per-wire index of the hits instead of testing
+    // all pairs, and the hits of each label are tracked to avoid scanning all
+    // the hits at each relabelling.
+    std::size_t const nHits = wires.size();
+    std::vector<int> labels(nHits, -1);
+    if (nHits == 0) return labels;
+
+    // per-wire index of the hits, in increasing index order
+    auto const [ minWireIt, maxWireIt ] = std::minmax_element(wires.begin(), wires.end());
+    int const minWire = *minWireIt;
+    int const maxWire = *maxWireIt;
+    std::vector<std::size_t> wireStart(maxWire - minWire + 2, 0);
+    for (int w: wires) ++wireStart[w - minWire + 1];
+    std::partial_sum(wireStart.begin(), wireStart.end(), wireStart.begin());
+    std::vector<std::size_t> wireHits(nHits);
+    std::vector<std::size_t> next(wireStart.begin(), wireStart.end() - 1);
+    for (std::size_t i = 0; i < nHits; ++i) wireHits[next[wires[i] - minWire]++] = i;
+
+    std::vector<std::set<std::size_t>> members(nHits + 1); // hits of each label
+    auto setLabel = [&labels,&members](std::size_t i, int label)
+      { labels[i] = label; members[label].insert(i); };
+
+    std::vector<std::size_t> neighbours;
+    for (std::size_t i = 0; i < nHits; ++i) {
+      neighbours.clear();
+      int const wLow = std::max(wires[i] - fdwclusfcl + 1, minWire);
+      int const wHigh = std::min(wires[i] + fdwclusfcl - 1, maxWire);
+      for (int w = wLow; w <= wHigh; ++w) {
+        for (std::size_t k = wireStart[w - minWire]; k < wireStart[w - minWire + 1]; ++k) {
+          std::size_t const j = wireHits[k];
+          if ((j != i) && (std::abs(samples[i] - samples[j]) < fdsclusfcl))
+            neighbours.push_back(j);
+        }
+      }
+      std::sort(neighbours.begin(), neighbours.end());
+
+      for (std::size_t const j: neighbours) {
+        if (labels[i] < 0 && labels[j] < 0) {
+          setLabel(i, i + 1);
+          setLabel(j, i + 1);
+        }
+        else if (labels[i] > 0 && labels[j] < 0) setLabel(j, labels[i]);
+        else if (labels[i] < 0 && labels[j] > 0) setLabel(i, labels[j]);
+        else if (labels[i] != labels[j]) {
+          std::set<std::size_t>& from = members[labels[j]];
+          auto const moved = from.upper_bound(j);
+          int const label = labels[i];
+          for (auto it = from.begin(); it != moved; ++it) setLabel(*it, label);
+          from.erase(from.begin(), moved);
+        }
+      } // for neighbours
+    } // for hits
+
+    return labels;
+  }
+
+  int ICARUSPurityDQM::FitTrackLine(std::vector<float> const& whc, std::vector<float> const& shc,
+                                    float& pendenza, float& intercetta) const
+  {
+    // At each iteration the hit farthest from the fitted line, if beyond
+    // fdisfcl, is excluded; the least squares sums are updated by removing
+    // that hit, rather than fitting again all the remaining ones.
+    int const nHits = whc.size();
+    std::vector<Double_t> wires(nHits);
+    std::vector<Double_t> samples(nHits);
+    for(int k=0;k<nHits;k++)
+      {
+        wires[k]=whc[k]*3;
+        samples[k]=shc[k]*0.628;
+      }
+
+    // sums are relative to the average point, for numerical stability
+    Double_t const x0 = std::accumulate(wires.begin(), wires.end(), 0.0) / nHits;
+    Double_t const y0 = std::accumulate(samples.begin(), samples.end(), 0.0) / nHits;
+    Double_t n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for(int k=0;k<nHits;k++)
+      {
+        Double_t const dx = wires[k] - x0;
+        Double_t const dy = samples[k] - y0;
+        n += 1; sx += dx; sy += dy; sxx += dx*dx; sxy += dx*dy;
+      }
+
+    std::vector<bool> escluse(nHits, false);
+    for(int j=0;j<nHits;j++)
+      {
+        Double_t const slope = (n*sxy - sx*sy) / (n*sxx - sx*sx);
+        pendenza=slope;
+        intercetta=y0 + (sy - slope*sx)/n - slope*x0;
+        float distance_maximal=fdisfcl;
+        int quella_a_distance_maximal=0;
+        int found_max=0;
+        for(int jj=0;jj<nHits;jj++)
+          {
+            if(escluse[jj]) continue;
+            if((abs((pendenza)*(wires[jj])-samples[jj]+intercetta)/sqrt((pendenza)*pendenza+1))>distance_maximal)
+              {
+                found_max=1;
+                quella_a_distance_maximal=jj;
+                distance_maximal=(abs(pendenza*wires[jj]-samples[jj]+intercetta)/sqrt(pendenza*pendenza+1));
+              }
+          }
+        if(found_max==0) return 1;
+
+        escluse[quella_a_distance_maximal]=true;
+        Double_t const dx = wires[quella_a_distance_maximal] - x0;
+        Double_t const dy = samples[quella_a_distance_maximal] - y0;
+        n -= 1; sx -= dx; sy -= dy; sxx -= dx*dx; sxy -= dx*dy;
+      }
+    return 0;
+  }
+
   void ICARUSPurityDQM::produce(art::Event& evt)
   {
     
@@ -369,6 +607,7 @@ std::sort(usedhere->begin(),usedhere->end(), [](float &c, float &d){ return c<d;
     purity_info.Subrun = evt.subRun(); //evt.time().timeHigh()-1598580000;//evt.subRun();
     purity_info.Event = evt.event();
     std::ofstream purh("dump_purity_hits.out",std::ios::app);
+    AutoRangeStdDev noiseRMS{ 20000 }; // "h111","delta aree",20000,0,0
 
     for(const auto& digitlabel : fDigitModuleLabel)
       {
@@ -389,18 +628,16 @@ std::sort(usedhere->begin(),usedhere->end(), [](float &c, float &d){ return c<d;
 	  }
 	
 	
-	std::vector<int> *www0=new std::vector<int>;
-	std::vector<float> *sss0=new std::vector<float>;
-	std::vector<float> *hhh0=new std::vector<float>;
-	std::vector<float> *ehh0=new std::vector<float>;
-	std::vector<int> *www2=new std::vector<int>;
-	std::vector<float> *sss2=new std::vector<float>;
-	std::vector<float> *hhh2=new std::vector<float>;
-	std::vector<float> *ehh2=new std::vector<float>;
-	std::vector<int> *ccc0=new std::vector<int>;
-	std::vector<int> *ccc2=new std::vector<int>;
-	std::vector<float> *aaa0=new std::vector<float>;
-	std::vector<float> *aaa2=new std::vector<float>;
+	std::vector<int> www0;
+	std::vector<float> sss0;
+	std::vector<float> hhh0;
+	std::vector<float> ehh0;
+	std::vector<int> www2;
+	std::vector<float> sss2;
+	std::vector<float> hhh2;
+	std::vector<float> ehh2;
+	std::vector<float> aaa0;
+	std::vector<float> aaa2;
 	
 	
         short int used[4096];	
@@ -422,7 +659,6 @@ std::sort(usedhere->begin(),usedhere->end(), [](float &c, float &d){ return c<d;
 	    fDataSize = rawDigit->Samples();
 	    rawadc.resize(fDataSize);
 	    
-	    for(int ijk=0;ijk<4096;ijk++)used[ijk]=0;
 	    //UNCOMPRESS THE DATA.
 	    int pedestal = (int)rawDigit->GetPedestal();
 	    float pedestal2 = rawDigit->GetPedestal();
@@ -433,11 +669,12 @@ std::sort(usedhere->begin(),usedhere->end(), [](float &c, float &d){ return c<d;
 	    float quale_sample_massimo;
 	    //    if (plane==0) {
 	    if ((int)plane==fplanefcl && cryostat==fcryofcl){
+	      for(int ijk=0;ijk<4096;ijk++)used[ijk]=0;
 	      for(int volte=0;volte<fquantevoltefcl;volte++){	
             massimo=0;
            quale_sample_massimo=-1;
 
-              TH1F *h111 = new TH1F("h111","delta aree",20000,0,0);
+              noiseRMS.clear();
               for (unsigned int ijk=0; ijk<(fDataSize); ijk++)
                 {
 		  if ((rawDigit->ADC(ijk)-pedestal2)>massimo && ijk>150 && ijk<(fDataSize-150) && used[ijk]==0)
@@ -469,11 +706,10 @@ std::sort(usedhere->begin(),usedhere->end(), [](float &c, float &d){ return c<d;
 
                   }
                   else{
-		    if(used[ijk]==0)h111->Fill(rawDigit->ADC(ijk)-pedestal2-basebase);
+		    if(used[ijk]==0)noiseRMS.fill(rawDigit->ADC(ijk)-pedestal2-basebase);
                   }                  
 		}
-              sigma_pedestal=h111->GetRMS();
-              h111->Delete();
+              sigma_pedestal=noiseRMS.stdDev();
               h_rms->Fill(sigma_pedestal);
               if(fdumphitsfcl==1)purh<<evt.event()<< " " <<iWire<<" "<<tpc<<" "<<cryostat<<" "<<basebase<<" "<<base_massimo_after<<" " <<base_massimo_before<<" "<<pedestal2<<" "<<sigma_pedestal<< " "  << quale_sample_massimo << " " << massimo << std::endl;
 
@@ -481,31 +717,27 @@ std::sort(usedhere->begin(),usedhere->end(), [](float &c, float &d){ return c<d;
                 {
                      if(fdumphitsfcl==1)purh<<iWire<<" "<<tpc<<" "<<cryostat<< " CANDIDATE HIT "  << quale_sample_massimo << " " << massimo << std::endl;
 
-                     if(tpc==0)www0->push_back(iWire+64);            
-                     if(tpc==0)sss0->push_back(quale_sample_massimo);
-                     if(tpc==0)hhh0->push_back(massimo);
-                     if(tpc==0)ehh0->push_back(sigma_pedestal);
-                     if(tpc==0)ccc0->push_back(-1);
-                     if(tpc==1)www0->push_back(iWire+64+2536);
-                     if(tpc==1)sss0->push_back(quale_sample_massimo);
-                     if(tpc==1)hhh0->push_back(massimo);
-                     if(tpc==1)ehh0->push_back(sigma_pedestal);
-                     if(tpc==1)ccc0->push_back(-1);
-                     if(tpc==2)www2->push_back(iWire+64);
-                     if(tpc==2)sss2->push_back(quale_sample_massimo);
-                     if(tpc==2)hhh2->push_back(massimo);
-                     if(tpc==2)ehh2->push_back(sigma_pedestal);
-                     if(tpc==2)ccc2->push_back(-1);
-                     if(tpc==3)www2->push_back(iWire+64+2536);
-                     if(tpc==3)sss2->push_back(quale_sample_massimo);
-                     if(tpc==3)hhh2->push_back(massimo);
-                     if(tpc==3)ehh2->push_back(sigma_pedestal);
-                     if(tpc==3)ccc2->push_back(-1);
-
-		     if(tpc==0)aaa0->push_back(areaarea);
-		     if(tpc==1)aaa0->push_back(areaarea);
-		     if(tpc==2)aaa2->push_back(areaarea);
-		     if(tpc==3)aaa2->push_back(areaarea);
+                     if(tpc==0)www0.push_back(iWire+64);            
+                     if(tpc==0)sss0.push_back(quale_sample_massimo);
+                     if(tpc==0)hhh0.push_back(massimo);
+                     if(tpc==0)ehh0.push_back(sigma_pedestal);
+                     if(tpc==1)www0.push_back(iWire+64+2536);
+                     if(tpc==1)sss0.push_back(quale_sample_massimo);
+                     if(tpc==1)hhh0.push_back(massimo);
+                     if(tpc==1)ehh0.push_back(sigma_pedestal);
+                     if(tpc==2)www2.push_back(iWire+64);
+                     if(tpc==2)sss2.push_back(quale_sample_massimo);
+                     if(tpc==2)hhh2.push_back(massimo);
+                     if(tpc==2)ehh2.push_back(sigma_pedestal);
+                     if(tpc==3)www2.push_back(iWire+64+2536);
+                     if(tpc==3)sss2.push_back(quale_sample_massimo);
+                     if(tpc==3)hhh2.push_back(massimo);
+                     if(tpc==3)ehh2.push_back(sigma_pedestal);
+
+		     if(tpc==0)aaa0.push_back(areaarea);
+		     if(tpc==1)aaa0.push_back(areaarea);
+		     if(tpc==2)aaa2.push_back(areaarea);
+		     if(tpc==3)aaa2.push_back(areaarea);
                      for(int ijk=0;ijk<330;ijk++)
           {
 	int ent_value=quale_sample_massimo+ijk-165;
@@ -516,148 +748,75 @@ std::sort(usedhere->begin(),usedhere->end(), [](float &c, float &d){ return c<d;
                 }
             }
 	  }
-////std::cout << "SIZE " << www0->size() << " " << www1->size() << " " << www2->size() << " " << www3->size() << std::endl;	
-	for (unsigned int ijk=0; ijk<www0->size(); ijk++)
-	  {
-	    for (unsigned int ijk2=0; ijk2<www0->size(); ijk2++)
-	      {
-		if (fabs((*www0)[ijk]-(*www0)[ijk2])<fdwclusfcl && ijk!=ijk2 && fabs((*sss0)[ijk]-(*sss0)[ijk2])<fdsclusfcl)
-		  {
-		    if ((*ccc0)[ijk]<0 && (*ccc0)[ijk2]<0)
-		      {
-			(*ccc0)[ijk]=ijk+1;
-			(*ccc0)[ijk2]=ijk+1;
-		      }
-		    else if ((*ccc0)[ijk]>0 && (*ccc0)[ijk2]<0)
-		      {
-			(*ccc0)[ijk2]=(*ccc0)[ijk];
-		      }
-		    else if ((*ccc0)[ijk]<0 && (*ccc0)[ijk2]>0)
-		      {
-			(*ccc0)[ijk]=(*ccc0)[ijk2];
-		      }
-		    else if ((*ccc0)[ijk]>0 && (*ccc0)[ijk2]>0)
-		      {
-			for (unsigned int ijk3=0; ijk3<www0->size(); ijk3++)
-			  {
-			    if(((*ccc0)[ijk3])==((*ccc0)[ijk2]))(*ccc0)[ijk3]=(*ccc0)[ijk];
-			  }
-		      }
-		  }
-	      }
-	  }
+	// clusters of neighbouring candidate hits, on each TPC pair
+	std::vector<int> const ccc0 = ClusterHits(www0, sss0);
+	std::vector<int> const ccc2 = ClusterHits(www2, sss2);
 	
+	// cluster labels are at most the number of hits
+	std::size_t const maxLabels = std::max(www0.size(), www2.size()) + 1;
+	std::vector<std::array<Int_t, 4>> clusters_creation(maxLabels, std::array<Int_t, 4>{ 0, 0, 0, 0 });
+	std::vector<std::array<Int_t, 4>> clusters_swire(maxLabels, std::array<Int_t, 4>{ 100000, 100000, 100000, 100000 });
+	std::vector<std::array<Int_t, 4>> clusters_lwire(maxLabels, std::array<Int_t, 4>{ 0, 0, 0, 0 });
+	std::vector<std::array<Int_t, 4>> clusters_ssample(maxLabels, std::array<Int_t, 4>{ 100000, 100000, 100000, 100000 });
+	std::vector<std::array<Int_t, 4>> clusters_lsample(maxLabels, std::array<Int_t, 4>{ 0, 0, 0, 0 });
 	
-	for (unsigned int ijk=0; ijk<www2->size(); ijk++)
-	  {
-            ////std::cout << " WWW2 " << ijk << std::endl;
-	    for (unsigned int ijk2=0; ijk2<www2->size(); ijk2++)
-	      {
-		if (fabs((*www2)[ijk]-(*www2)[ijk2])<fdwclusfcl && ijk!=ijk2 && fabs((*sss2)[ijk]-(*sss2)[ijk2])<fdsclusfcl)
-		  {
-		    if ((*ccc2)[ijk]<0 && (*ccc2)[ijk2]<0)
-		      {
-			(*ccc2)[ijk]=ijk+1;
-			(*ccc2)[ijk2]=ijk+1;
-		      }
-		    else if ((*ccc2)[ijk]>0 && (*ccc2)[ijk2]<0)
-		      {
-			(*ccc2)[ijk2]=(*ccc2)[ijk];
-		      }
-		    else if ((*ccc2)[ijk]<0 && (*ccc2)[ijk2]>0)
-		      {
-			(*ccc2)[ijk]=(*ccc2)[ijk2];
-		      }
-		    else if ((*ccc2)[ijk]>0 && (*ccc2)[ijk2]>0)
-		      {
-			for (unsigned int ijk3=0; ijk3<www2->size(); ijk3++)
-			  {
-			    if(((*ccc2)[ijk3])==((*ccc2)[ijk2]))(*ccc2)[ijk3]=(*ccc2)[ijk];
-			  }
-		      }
-		  }
-	      }
-	  }
-	
-	
-	Int_t clusters_creation[4][30000];
-	//Int_t clusters_avewire[4][1000];
-	Int_t clusters_swire[4][30000];
-	Int_t clusters_lwire[4][30000];
-	Int_t clusters_ssample[4][30000];
-	Int_t clusters_lsample[4][30000];
-	
-	Int_t clusters_nn[1000];
-	Int_t clusters_vi[1000];
-	Int_t clusters_qq[1000];
-	//Int_t clusters_avewire[4][1000];
-	Int_t clusters_dw[1000];
-	Int_t clusters_ds[1000];
-        Double_t clusters_mw[1000];
-        Double_t clusters_ms[1000];
-        Double_t clusters_mintime[1000];
-	
-	
-	for (unsigned int ijk=0; ijk<4; ijk++) {
-          for (unsigned int ijk2=0; ijk2<30000; ijk2++) {
-	    clusters_creation[ijk][ijk2]=0;
-	    clusters_swire[ijk][ijk2]=100000;
-	    clusters_lwire[ijk][ijk2]=0;
-	    clusters_ssample[ijk][ijk2]=100000;
-	    clusters_lsample[ijk][ijk2]=0;
-	    if (ijk2<1000 && ijk>2) {
-	      clusters_nn[ijk2]=-1;
-	      clusters_vi[ijk2]=-1;
-	      clusters_dw[ijk2]=-1;
-	      clusters_ds[ijk2]=-1;
-	      clusters_qq[ijk2]=-1;
-              clusters_mw[ijk2]=-1;
-              clusters_ms[ijk2]=-1;
-              clusters_mintime[ijk2]=-1;
-	    }
-          }
-	}
+	std::vector<Int_t> clusters_nn;
+	std::vector<Int_t> clusters_vi;
+	std::vector<Int_t> clusters_qq;
+	std::vector<Int_t> clusters_dw;
+	std::vector<Int_t> clusters_ds;
+        std::vector<Double_t> clusters_mw;
+        std::vector<Double_t> clusters_ms;
+        std::vector<Double_t> clusters_mintime;
+	std::vector<std::vector<unsigned int>> clusters_hits; // hit indices of each cluster
 	
-	for (unsigned int ijk=0; ijk<www0->size(); ijk++)
+	for (unsigned int ijk=0; ijk<www0.size(); ijk++)
 	  {
-	    if ((*ccc0)[ijk]>0) {
-              int numero=(*ccc0)[ijk];
-              clusters_creation[0][numero]+=1;
-              if((*www0)[ijk]<clusters_swire[0][numero])clusters_swire[0][numero]=(*www0)[ijk];
-              if((*www0)[ijk]>clusters_lwire[0][numero])clusters_lwire[0][numero]=(*www0)[ijk];
-              if((*sss0)[ijk]<clusters_ssample[0][numero])clusters_ssample[0][numero]=(*sss0)[ijk];
-              if((*sss0)[ijk]>clusters_lsample[0][numero])clusters_lsample[0][numero]=(*sss0)[ijk];
+	    if (ccc0[ijk]>0) {
+              int numero=ccc0[ijk];
+              clusters_creation[numero][0]+=1;
+              if(www0[ijk]<clusters_swire[numero][0])clusters_swire[numero][0]=www0[ijk];
+              if(www0[ijk]>clusters_lwire[numero][0])clusters_lwire[numero][0]=www0[ijk];
+              if(sss0[ijk]<clusters_ssample[numero][0])clusters_ssample[numero][0]=sss0[ijk];
+              if(sss0[ijk]>clusters_lsample[numero][0])clusters_lsample[numero][0]=sss0[ijk];
 	    }
 	  }
-	for (unsigned int ijk=0; ijk<www2->size(); ijk++)
+	for (unsigned int ijk=0; ijk<www2.size(); ijk++)
 	  {
-	    if ((*ccc2)[ijk]>0) {
-              int numero=(*ccc2)[ijk];
-              clusters_creation[2][numero]+=1;
-              if((*www2)[ijk]<clusters_swire[2][numero])clusters_swire[2][numero]=(*www2)[ijk];
-              if((*www2)[ijk]>clusters_lwire[2][numero])clusters_lwire[2][numero]=(*www2)[ijk];
-              if((*sss2)[ijk]<clusters_ssample[2][numero])clusters_ssample[2][numero]=(*sss2)[ijk];
-              if((*sss2)[ijk]>clusters_lsample[2][numero])clusters_lsample[2][numero]=(*sss2)[ijk];
+	    if (ccc2[ijk]>0) {
+              int numero=ccc2[ijk];
+              clusters_creation[numero][2]+=1;
+              if(www2[ijk]<clusters_swire[numero][2])clusters_swire[numero][2]=www2[ijk];
+              if(www2[ijk]>clusters_lwire[numero][2])clusters_lwire[numero][2]=www2[ijk];
+              if(sss2[ijk]<clusters_ssample[numero][2])clusters_ssample[numero][2]=sss2[ijk];
+              if(sss2[ijk]>clusters_lsample[numero][2])clusters_lsample[numero][2]=sss2[ijk];
 	    }
 	  }
 	
 	int quanti_clusters=0;
-	for (unsigned int ijk=0; ijk<4; ijk++) {
-          for (unsigned int ijk2=0; ijk2<30000; ijk2++) {
-	    if(clusters_creation[ijk][ijk2]>50)
+	for (unsigned int ijk=0; ijk<4; ijk+=2) {
+          std::vector<int> const& ccc = (ijk == 0)? ccc0: ccc2;
+          for (unsigned int ijk2=0; ijk2<maxLabels; ijk2++) {
+	    if(clusters_creation[ijk2][ijk]>50)
               {
-		////std::cout<<clusters_creation[ijk][ijk2] << " CLUSTER MINE " << clusters_swire[ijk][ijk2] << " " << clusters_lwire[ijk][ijk2] << " " << clusters_ssample[ijk][ijk2] << " " << clusters_lsample[ijk][ijk2] << std::endl;
-		clusters_qq[quanti_clusters]=clusters_creation[ijk][ijk2];
-		clusters_vi[quanti_clusters]=ijk;
-		clusters_nn[quanti_clusters]=ijk2;
-		clusters_dw[quanti_clusters]=clusters_lwire[ijk][ijk2]-clusters_swire[ijk][ijk2];
-		clusters_ds[quanti_clusters]=clusters_lsample[ijk][ijk2]-clusters_ssample[ijk][ijk2];
-                clusters_mw[quanti_clusters]=(clusters_lwire[ijk][ijk2]+clusters_swire[ijk][ijk2])*0.5;
-                clusters_ms[quanti_clusters]=(clusters_lsample[ijk][ijk2]+clusters_ssample[ijk][ijk2])*0.5;
-                clusters_mintime[quanti_clusters]=(clusters_ssample[ijk][ijk2]);
+		clusters_qq.push_back(clusters_creation[ijk2][ijk]);
+		clusters_vi.push_back(ijk);
+		clusters_nn.push_back(ijk2);
+		clusters_dw.push_back(clusters_lwire[ijk2][ijk]-clusters_swire[ijk2][ijk]);
+		clusters_ds.push_back(clusters_lsample[ijk2][ijk]-clusters_ssample[ijk2][ijk]);
+                clusters_mw.push_back((clusters_lwire[ijk2][ijk]+clusters_swire[ijk2][ijk])*0.5);
+                clusters_ms.push_back((clusters_lsample[ijk2][ijk]+clusters_ssample[ijk2][ijk])*0.5);
+                clusters_mintime.push_back(clusters_ssample[ijk2][ijk]);
+		clusters_hits.emplace_back();
 		quanti_clusters+=1;
               }
           }
+          // collect the hits of the selected clusters, in their original order
+          std::vector<int> clusterIndex(maxLabels, -1);
+          for (int icl = 0; icl < quanti_clusters; ++icl)
+            if (clusters_vi[icl] == (Int_t) ijk) clusterIndex[clusters_nn[icl]] = icl;
+          for (unsigned int ih=0; ih<ccc.size(); ih++)
+            if ((ccc[ih] > 0) && (clusterIndex[ccc[ih]] >= 0)) clusters_hits[clusterIndex[ccc[ih]]].push_back(ih);
 	}
 	
 	
@@ -669,146 +828,93 @@ std::sort(usedhere->begin(),usedhere->end(), [](float &c, float &d){ return c<d;
 	    if (clusters_ds[icl]>2250 && clusters_dw[icl]>100)
 	      {//if analisi
 		
-		std::vector<float> *whc=new std::vector<float>;
-		std::vector<float> *shc=new std::vector<float>;
-		std::vector<float> *ahc=new std::vector<float>;
-		std::vector<float> *fahc=new std::vector<float>;
+		std::vector<float> whc;
+		std::vector<float> shc;
+		std::vector<float> ahc;
+		std::vector<float> fahc;
 		
 		if (clusters_vi[icl]==0) {
-		  for (unsigned int ijk=0; ijk<www0->size(); ijk++) {
-		    if ((*ccc0)[ijk]==clusters_nn[icl]) {
-                      whc->push_back((*www0)[ijk]);
-                      shc->push_back((*sss0)[ijk]);
-                      ///ahc->push_back((*hhh0)[ijk]);
-                      ahc->push_back((*aaa0)[ijk]);
-                      fahc->push_back((*hhh0)[ijk]);
+		  for (unsigned int ijk: clusters_hits[icl]) {
+		    {
+                      whc.push_back(www0[ijk]);
+                      shc.push_back(sss0[ijk]);
+                      ///ahc.push_back(hhh0[ijk]);
+                      ahc.push_back(aaa0[ijk]);
+                      fahc.push_back(hhh0[ijk]);
 		    }
 		  }
 		}
 		if (clusters_vi[icl]==2) {
-		  for (unsigned int ijk=0; ijk<www2->size(); ijk++) {
-		    if ((*ccc2)[ijk]==clusters_nn[icl]) {
-                      whc->push_back((*www2)[ijk]);
-                      shc->push_back((*sss2)[ijk]);
-                      ahc->push_back((*aaa2)[ijk]);
-                      //ahc->push_back((*hhh2)[ijk]);
-                      fahc->push_back((*hhh2)[ijk]);
+		  for (unsigned int ijk: clusters_hits[icl]) {
+		    {
+                      whc.push_back(www2[ijk]);
+                      shc.push_back(sss2[ijk]);
+                      ahc.push_back(aaa2[ijk]);
+                      //ahc.push_back(hhh2[ijk]);
+                      fahc.push_back(hhh2[ijk]);
 		    }
 		  }
 		}
 		
 		
-		////std::cout << " CLUSTER INFO " << icl << " " << clusters_qq[icl] << " " << whc->size() << std::endl;
+		////std::cout << " CLUSTER INFO " << icl << " " << clusters_qq[icl] << " " << whc.size() << std::endl;
 		
 		
-		if(whc->size()>100)//prima 0
+		if(whc.size()>100)//prima 0
 		  {
-		    float pendenza=0;float intercetta=0;int found_ok=0;
-		    std::vector<int> *escluse=new std::vector<int>;
-/*
-for(int j=0;j<(int)whc->size();j++)
-{
-if(((*shc)[j]-clusters_mintime[icl]<200) || ((*shc)[j]-clusters_mintime[icl])>2150)escluse->push_back(j);
-}
-*/
-		    for(int j=0;j<(int)whc->size();j++)
-		      {
-			if(found_ok<1)
-			  {
-			    Double_t wires[10000];
-			    Double_t samples[10000];
-			    Double_t ex[10000];
-			    Double_t quale[10000];
-			    Double_t ey[10000];
-			    int quanti=0;
-			    for(int k=0;k<(int)whc->size();k++)
-			      {
-				if(Nothere(escluse,k)==3)
-				  {
-				    wires[quanti]=(*whc)[k]*3;
-				    samples[quanti]=(*shc)[k]*0.628;
-				    ex[quanti]=0;
-				    ey[quanti]=0;
-				    quale[quanti]=k;
-				    quanti+=1;
-				  }
-			      }
-			    ////////std::cout << quanti << std::endl;
-			    TGraphErrors *gr3 = new TGraphErrors(quanti,wires,samples,ex,ey);
-			    gr3->Fit("pol1","Q");
-			    TF1 *fitfunc = gr3->GetFunction("pol1");
-			    pendenza=fitfunc->GetParameter(1);
-			    intercetta=fitfunc->GetParameter(0);
-			    float distance_maximal=fdisfcl;
-			    int quella_a_distance_maximal=0;
-			    int found_max=0;
-			    for(int jj=0;jj<quanti;jj++)
-			      {
-				if((abs((pendenza)*(wires[jj])-samples[jj]+intercetta)/sqrt((pendenza)*pendenza+1))>distance_maximal)
-				  {
-				    found_max=1;
-				    quella_a_distance_maximal=quale[jj];
-				    distance_maximal=(abs(pendenza*wires[jj]-samples[jj]+intercetta)/sqrt(pendenza*pendenza+1));
-				  }
-			      }
-			    if(found_max==1)escluse->push_back(quella_a_distance_maximal);
-			    if(found_max==0)found_ok=1;
-			  }
-		      }
-		    ////std::cout << escluse->size() << " escluse " << whc->size() << " " << found_ok << std::endl;
-		    delete escluse;
-		    std::vector<float> *hittime=new std::vector<float>;
-		    std::vector<float> *hitwire=new std::vector<float>;
-		    std::vector<float> *hitarea=new std::vector<float>;
-		    std::vector<float> *hittimegood=new std::vector<float>;
-		    std::vector<float> *hitareagood=new std::vector<float>;
-		    std::vector<float> *hitwiregood=new std::vector<float>;
+		    float pendenza=0;float intercetta=0;
+		    int const found_ok=FitTrackLine(whc,shc,pendenza,intercetta);
+		    std::vector<float> hittime;
+		    std::vector<float> hitwire;
+		    std::vector<float> hitarea;
+		    std::vector<float> hittimegood;
+		    std::vector<float> hitareagood;
+		    std::vector<float> hitwiregood;
 		    ///////std::cout <<  found_ok << std::endl;
 		    ///////std::cout <<  pendenza << std::endl;
 		    ///////std::cout <<  intercetta << std::endl;
 		    if(found_ok==1)
 		      {
-			for(int kkk=0;kkk<(int)whc->size();kkk++)
+			for(int kkk=0;kkk<(int)whc.size();kkk++)
 			  {
-			    if((*ahc)[kkk]>0)// && (((*shc)[kkk]-clusters_mintime[icl]<200) || ((*shc)[kkk]-clusters_mintime[icl])<2150))
+			    if(ahc[kkk]>0)// && ((shc[kkk]-clusters_mintime[icl]<200) || (shc[kkk]-clusters_mintime[icl])<2150))
 			      {
-				float distance=(abs(pendenza*((*whc)[kkk]*3)-(*shc)[kkk]*0.628+intercetta))/sqrt(pendenza*pendenza+1);
+				float distance=(abs(pendenza*(whc[kkk]*3)-shc[kkk]*0.628+intercetta))/sqrt(pendenza*pendenza+1);
 				if(distance<=fdisfcl)
 				  {
-				    //cout << log((*ahc)[kkk]/(0.4*peach)) << endl;
-				    hittime->push_back((*shc)[kkk]*0.4);
-				    hitwire->push_back((*whc)[kkk]);
-				    hitarea->push_back((*ahc)[kkk]);
-                                    h_hit_height->Fill((*fahc)[kkk]);
-                                    h_hit_area->Fill((*ahc)[kkk]);
-                                    h_hit_height_area->Fill((*fahc)[kkk],(*ahc)[kkk]);
+				    //cout << log(ahc[kkk]/(0.4*peach)) << endl;
+				    hittime.push_back(shc[kkk]*0.4);
+				    hitwire.push_back(whc[kkk]);
+				    hitarea.push_back(ahc[kkk]);
+                                    h_hit_height->Fill(fahc[kkk]);
+                                    h_hit_area->Fill(ahc[kkk]);
+                                    h_hit_height_area->Fill(fahc[kkk],ahc[kkk]);
 
 				  }
 			      }
 			  }
 			//float result_rms=0.14;
 			////std::cout << result_rms << endl;
-			Double_t area[10000];
-			Double_t nologarea[10000];
-			Double_t tempo[10000];
-			Double_t ex[10000];
-			//Double_t quale[10000];
-			Double_t ey[10000];
-			Double_t ek[10000];
-			Double_t ez[10000];
-			////std::cout <<  hitarea->size() << " dimensione hitarea" << std::endl;
+			std::vector<Double_t> area(hitarea.size());
+			std::vector<Double_t> nologarea(hitarea.size());
+			std::vector<Double_t> tempo(hitarea.size());
+			std::vector<Double_t> ex(hitarea.size());
+			std::vector<Double_t> ey(hitarea.size());
+			std::vector<Double_t> ek(hitarea.size());
+			std::vector<Double_t> ez(hitarea.size());
+			////std::cout <<  hitarea.size() << " dimensione hitarea" << std::endl;
 
 			////std::cout<<""<<std::endl;
 			////std::cout<<"HERE line 802"<<std::endl;
 			////std::cout<<""<<std::endl;
                         //std::ofstream purh("dump_purity_hits.out",std::ios::app);
 
-			if(hitarea->size()>100)//prima 30
+			if(hitarea.size()>100)//prima 30
 			  {
-			    h_ratio->Fill(((float)whc->size())/((float)clusters_dw[icl]));
-                            h_ratio_3->Fill(clusters_ds[icl],((float)whc->size())/((float)clusters_dw[icl]));
+			    h_ratio->Fill(((float)whc.size())/((float)clusters_dw[icl]));
+                            h_ratio_3->Fill(clusters_ds[icl],((float)whc.size())/((float)clusters_dw[icl]));
 
-                            ////std::cout << "RATIO INFO 1 " << (float)hitarea->size() << " " << (float)clusters_dw[icl] << " " << (((float)hitarea->size())/((float)clusters_dw[icl])) << std::endl;	
+                            ////std::cout << "RATIO INFO 1 " << (float)hitarea.size() << " " << (float)clusters_dw[icl] << " " << (((float)hitarea.size())/((float)clusters_dw[icl])) << std::endl;	
 			    float minimo=100000;
 			    float massimo=0;
                             float wire_minimo=100000;
@@ -822,34 +928,34 @@ if(((*shc)[j]-clusters_mintime[icl]<200) || ((*shc)[j]-clusters_mintime[icl])>21
                             float sample_minimo=-1;
                             int quante_hit_nel_range_tempo=0;
 			    purh<< evt.run() << " " << evt.subRun() << "  " << evt.event() << "  -1 " <<  " -1 " << " -1 " << " -1 " << std::endl;
-                            for(int kk=0;kk<(int)hitarea->size();kk++)
+                            for(int kk=0;kk<(int)hitarea.size();kk++)
                               {
-				if(fdumphitsfcl==1)purh<< evt.run() << " SELECTED " << evt.subRun() << "  " << evt.event() << "  " << tpc_number <<  " " << (*hitwire)[kk] << " " << (*hittime)[kk] << " " << (*hitarea)[kk] << std::endl;
+				if(fdumphitsfcl==1)purh<< evt.run() << " SELECTED " << evt.subRun() << "  " << evt.event() << "  " << tpc_number <<  " " << hitwire[kk] << " " << hittime[kk] << " " << hitarea[kk] << std::endl;
 
 quante_hit_nel_range_tempo+=1;
-                                if((*hittime)[kk]>massimo)
+                                if(hittime[kk]>massimo)
                               {
-                               massimo=(*hittime)[kk];
-                               wire_del_massimo=(*hitwire)[kk];
+                               massimo=hittime[kk];
+                               wire_del_massimo=hitwire[kk];
                               }
 
 
-                                if((*hittime)[kk]<minimo)
+                                if(hittime[kk]<minimo)
                               {
-                               minimo=(*hittime)[kk];
-                               wire_del_minimo=(*hitwire)[kk];
+                               minimo=hittime[kk];
+                               wire_del_minimo=hitwire[kk];
                               }
 
 
-                                if((*hitwire)[kk]>wire_massimo)
+                                if(hitwire[kk]>wire_massimo)
                               {
-                               wire_massimo=(*hitwire)[kk];
+                               wire_massimo=hitwire[kk];
                               }
 
 
-                                if((*hitwire)[kk]<wire_minimo)
+                                if(hitwire[kk]<wire_minimo)
                               {
-                               wire_minimo=(*hitwire)[kk];
+                               wire_minimo=hitwire[kk];
                               }
 
                               }
@@ -862,10 +968,10 @@ quante_hit_nel_range_tempo+=1;
                             h_ratio_after_2->Fill(((float)quante_hit_nel_range_tempo)/fabs(wire_massimo-wire_minimo+1));
                             h_ratio_after_3->Fill(delta_sample_selected,((float)quante_hit_nel_range_tempo)/fabs(wire_massimo-wire_minimo+1));
 
-                            ////std::cout << "RATIO INFO 2 " << (float)hitarea->size() << " " << fabs(delta_wire_selected) << " " << (((float)hitarea->size())/fabs(delta_wire_selected)) << std::endl;
+                            ////std::cout << "RATIO INFO 2 " << (float)hitarea.size() << " " << fabs(delta_wire_selected) << " " << (((float)hitarea.size())/fabs(delta_wire_selected)) << std::endl;
 
-			    ////std::cout << hitarea->size() << std::endl;
-			    //int gruppi=hitarea->size()/50;
+			    ////std::cout << hitarea.size() << std::endl;
+			    //int gruppi=hitarea.size()/50;
 			    int gruppi=fgruppifcl;//originale 8
 			    ////std::cout << gruppi << std::endl;
 			    
@@ -876,64 +982,68 @@ quante_hit_nel_range_tempo+=1;
 			    ////std::cout << starting_value_tau << " VALORE INDICATIVO TAU " << std::endl;
 			    //if(tpc_number==2 || tpc_number==5)starting_value_tau=6500;
 			    //if(tpc_number==10 || tpc_number==13)starting_value_tau=5700;
+			    // lifetime-corrected areas, the same for all the groups
+			    std::vector<double> hitareacorr(hitarea.size());
+			    for(int kk=0;kk<(int)hitarea.size();kk++)
+			      hitareacorr[kk]=hitarea[kk]*exp(hittime[kk]/starting_value_tau);
+			    std::vector<float> hitpertaglio;
 			    for(int stp=0;stp<=gruppi;stp++)
 			      {
-				std::vector<float>* hitpertaglio=new std::vector<float>;
+				hitpertaglio.clear();
 				////std::cout << 500+stp*steptime << " time " << 500+(stp+1)*(steptime) << std::endl;
 				///////////std::cout << minimo+stp*steptime << " " << minimo+(stp+1)*(steptime) << std::endl;
-				for(int kk=0;kk<(int)hitarea->size();kk++)
+				for(int kk=0;kk<(int)hitarea.size();kk++)
 				  {
-				    if((*hittime)[kk]>=(minimo+stp*steptime) && (*hittime)[kk]<=(minimo+(stp+1)*(steptime))) 
-				      hitpertaglio->push_back((*hitarea)[kk]*exp((*hittime)[kk]/starting_value_tau));
+				    if(hittime[kk]>=(minimo+stp*steptime) && hittime[kk]<=(minimo+(stp+1)*(steptime))) 
+				      hitpertaglio.push_back(hitareacorr[kk]);
 				  }
-				///////////std::cout << hitpertaglio->size() << std::endl;
-				float tagliomax=FoundMeanLog(hitpertaglio,fmaxfcl);//0.9
-				float tagliomin=FoundMeanLog(hitpertaglio,fminfcl);//0.05
+				///////////std::cout << hitpertaglio.size() << std::endl;
+				float tagliomax=FoundMeanLog(&hitpertaglio,fmaxfcl);//0.9
+				float tagliomin=FoundMeanLog(&hitpertaglio,fminfcl);//0.05
 				//float tagliomin=0;
 				//float tagliomax=1000000;
-				delete hitpertaglio;
 				////std::cout << tagliomax << " t " << std::endl;
-				for(int kk=0;kk<(int)hitarea->size();kk++)
+				for(int kk=0;kk<(int)hitarea.size();kk++)
 				  {
-				    ////std::cout << (*hittime)[kk] << " " << (*hitwire)[kk] << " " << (*hitarea)[kk] << " " << (minimo+stp*steptime) << " " << (minimo+(stp+1)*steptime) << " " << (*hitarea)[kk]*exp((*hittime)[kk]/starting_value_tau) << std::endl;
-				    if((*hittime)[kk]>(minimo+stp*steptime) && 
-				       (*hittime)[kk]<(minimo+(stp+1)*steptime) &&
-				       (*hitarea)[kk]*exp((*hittime)[kk]/starting_value_tau)<tagliomax && 
-				       (*hitarea)[kk]*exp((*hittime)[kk]/starting_value_tau)>tagliomin)
+				    ////std::cout << hittime[kk] << " " << hitwire[kk] << " " << hitarea[kk] << " " << (minimo+stp*steptime) << " " << (minimo+(stp+1)*steptime) << " " << hitarea[kk]*exp(hittime[kk]/starting_value_tau) << std::endl;
+				    if(hittime[kk]>(minimo+stp*steptime) && 
+				       hittime[kk]<(minimo+(stp+1)*steptime) &&
+				       hitareacorr[kk]<tagliomax && 
+				       hitareacorr[kk]>tagliomin)
 				      {
-					////std::cout << ((*hitarea)[kk]*exp((*hittime)[kk]/1400)) << " GOOD " << (*hitarea)[kk] << " " << (*hittime)[kk] << std::endl;
-					hitareagood->push_back((*hitarea)[kk]);
-					hittimegood->push_back((*hittime)[kk]);
-					hitwiregood->push_back((*hitwire)[kk]);
+					////std::cout << (hitarea[kk]*exp(hittime[kk]/1400)) << " GOOD " << hitarea[kk] << " " << hittime[kk] << std::endl;
+					hitareagood.push_back(hitarea[kk]);
+					hittimegood.push_back(hittime[kk]);
+					hitwiregood.push_back(hitwire[kk]);
 				      }
 				  }
 			      }
-			    ////std::cout << hitareagood->size() << " hitareagood" << std::endl;    
+			    ////std::cout << hitareagood.size() << " hitareagood" << std::endl;    
 if(delta_sample_selected>1900)
 {
-                    for(int k=0;k<(int)whc->size();k++)
+                    for(int k=0;k<(int)whc.size();k++)
                       {
-                        h_hittime->Fill((*shc)[k]-clusters_mintime[icl]);
+                        h_hittime->Fill(shc[k]-clusters_mintime[icl]);
                       }
-                    for(int k=0;k<(int)hittime->size();k++)
+                    for(int k=0;k<(int)hittime.size();k++)
                       {
-                        h_hittime_2->Fill((*hittime)[k]/0.4-clusters_mintime[icl]);
+                        h_hittime_2->Fill(hittime[k]/0.4-clusters_mintime[icl]);
                       }
 
-                    for(int k=0;k<(int)hittimegood->size();k++)
+                    for(int k=0;k<(int)hittimegood.size();k++)
                       {
-                        h_hittime_3->Fill((*hittimegood)[k]/0.4-clusters_mintime[icl]);
+                        h_hittime_3->Fill(hittimegood[k]/0.4-clusters_mintime[icl]);
                       }
 }
 
-			    for(int k=0;k<(int)hitareagood->size();k++)
+			    for(int k=0;k<(int)hitareagood.size();k++)
 			      {
-                                if(fdumphitsfcl==1)purh<< evt.run() << " AFTER CLEAN " << evt.subRun() << "  " << evt.event() << "  " << tpc_number <<  " " << (*hitwiregood)[k] << " " << (*hittimegood)[k] << " " << (*hitareagood)[k] << std::endl;
-				//if((*hittimegood)[k]-600*0.4<=1000)//correzione 15/08
-				    tempo[k]=(*hittimegood)[k];
-				    area[k]=log((*hitareagood)[k]);
-				    ////std::cout << (*hitareagood)[k] << " " << area[k] << std::endl;
-				    nologarea[k]=((*hitareagood)[k]);
+                                if(fdumphitsfcl==1)purh<< evt.run() << " AFTER CLEAN " << evt.subRun() << "  " << evt.event() << "  " << tpc_number <<  " " << hitwiregood[k] << " " << hittimegood[k] << " " << hitareagood[k] << std::endl;
+				//if(hittimegood[k]-600*0.4<=1000)//correzione 15/08
+				    tempo[k]=hittimegood[k];
+				    area[k]=log(hitareagood[k]);
+				    ////std::cout << hitareagood[k] << " " << area[k] << std::endl;
+				    nologarea[k]=(hitareagood[k]);
 				    ex[k]=0;
 				    ez[k]=60;
 				    ey[k]=0.23;
@@ -941,18 +1051,18 @@ if(delta_sample_selected>1900)
 			    ////std::cout<<""<<std::endl;
 			    ////std::cout<<"HERE line 872"<<std::endl;
 			    ////std::cout<<""<<std::endl;
-			    TGraphErrors *gr31 = new TGraphErrors(hitareagood->size(),tempo,area,ex,ey);
-			    //TGraphErrors *gr4 = new TGraphErrors(hitareagood->size(),tempo,nologarea,ex,ey);
-			    gr31->Fit("pol1","Q");
-			    TF1 *fit = gr31->GetFunction("pol1");
+			    SetGraphPoints(*gr_fit,hitareagood.size(),tempo.data(),area.data(),ex.data(),ey.data());
+			    gr_fit->Fit("pol1","Q");
+			    TF1 *fit = gr_fit->GetFunction("pol1");
 			    float slope_purity=fit->GetParameter(1);
 			    //float error_slope_purity=fit->GetParError(1);
 			    float intercetta_purezza=fit->GetParameter(0);
 			    
-			    TH1F *h111 = new TH1F("h111","delta aree",200,-10,10);
+			    TH1F *h111 = h_fitres.get();
+			    h111->Reset();
 			    float sum_per_rms_test=0;
                             int quanti_in_h111=0;
-			    for(int k=0;k<(int)hitareagood->size();k++)
+			    for(int k=0;k<(int)hitareagood.size();k++)
 			      {
 				h111->Fill(area[k]-slope_purity*tempo[k]-intercetta_purezza);
 				sum_per_rms_test+=(area[k]-slope_purity*tempo[k]-intercetta_purezza)*(area[k]-slope_purity*tempo[k]-intercetta_purezza);
@@ -966,22 +1076,22 @@ if(delta_sample_selected>1900)
                         error=fitg->GetParameter(2);
                         }
                         ////std::cout << " error " << error << std::endl;
-                        //float error_2=sqrt(sum_per_rms_test/(hitareagood->size()-2));
+                        //float error_2=sqrt(sum_per_rms_test/(hitareagood.size()-2));
                         ////std::cout << " error vero" << error_2 << std::endl;
-                        h111->Delete();
 
 
 
-		      TGraphErrors *gr4 = new TGraphErrors(hitareagood->size(),tempo,nologarea,ex,ey);
-		      gr4->Fit("expo","Q");
-		      TF1 *fite = gr4->GetFunction("expo");
+		      SetGraphPoints(*gr_fit,hitareagood.size(),tempo.data(),nologarea.data(),ex.data(),ey.data());
+		      gr_fit->Fit("expo","Q");
+		      TF1 *fite = gr_fit->GetFunction("expo");
 		      slope_purity=fite->GetParameter(1);
 		      intercetta_purezza=fite->GetParameter(0);
                       float mean_hit_area=0;
-                      float size_hit_area=hitareagood->size();
+                      float size_hit_area=hitareagood.size();
                       int quanti_in_h111e=0;
-		      TH1F *h111e = new TH1F("h111e","delta aree",100,-1000.,1000.);
-		      for(int k=0;k<(int)hitareagood->size();k++)
+		      TH1F *h111e = h_fitres_expo.get();
+		      h111e->Reset();
+		      for(int k=0;k<(int)hitareagood.size();k++)
 			{
 			  h111e->Fill(nologarea[k]-exp(slope_purity*tempo[k]+intercetta_purezza));
                           mean_hit_area+=nologarea[k]/size_hit_area;
@@ -998,9 +1108,8 @@ if(delta_sample_selected>1900)
                       }
 		      //std::cout << " errors " << error << " " << error_expo << std::endl;
 		      h_errors->Fill(error_expo);
-		      h111e->Delete();//fitge->Delete();fite->Delete();
 
-                        for(int k=0;k<(int)hitareagood->size();k++)
+                        for(int k=0;k<(int)hitareagood.size();k++)
                           {
                                 ek[k]=error_expo;
                                 ez[k]=error_expo;
@@ -1010,23 +1119,23 @@ if(delta_sample_selected>1900)
 			////std::cout<<"HERE line 906"<<std::endl;
 			////std::cout<<""<<std::endl;
 
-                        TGraphErrors *gr32 = new TGraphErrors(hitareagood->size(),tempo,area,ex,ey);
-                        gr32->Fit("pol1","Q");
+                        SetGraphPoints(*gr_fit,hitareagood.size(),tempo.data(),area.data(),ex.data(),ey.data());
+                        gr_fit->Fit("pol1","Q");
                   
-                        TF1 *fit2 = gr32->GetFunction("pol1");
+                        TF1 *fit2 = gr_fit->GetFunction("pol1");
                         float slope_purity_2=fit2->GetParameter(1);
                         float error_slope_purity_2=fit2->GetParError(1);
                         //float intercetta_purezza_2=fit2->GetParameter(0);
-                        float chiquadro=fit2->GetChisquare()/(hitareagood->size()-2);
+                        float chiquadro=fit2->GetChisquare()/(hitareagood.size()-2);
 			std::ofstream goodpuro("purity_results.out",std::ios::app);
                         std::ofstream goodpuro2("purity_results2.out",std::ios::app);
 			
                         ////std::cout << -1/slope_purity_2 << std::endl;
                         ////std::cout << -1/(slope_purity_2+error_slope_purity_2)+1/slope_purity_2 << std::endl;
                         ////std::cout << 1/slope_purity_2-1/(slope_purity_2-error_slope_purity_2) << std::endl;
-                        TGraphAsymmErrors *gr41 = new TGraphAsymmErrors (hitareagood->size(),tempo,nologarea,ex,ex,ez,ek);
-                        gr41->Fit("expo","Q");
-                        TF1 *fitexo = gr41->GetFunction("expo");
+                        SetGraphPoints(*gr_fit_asymm,hitareagood.size(),tempo.data(),nologarea.data(),ex.data(),ex.data(),ez.data(),ek.data());
+                        gr_fit_asymm->Fit("expo","Q");
+                        TF1 *fitexo = gr_fit_asymm->GetFunction("expo");
                         float slope_purity_exo=fitexo->GetParameter(1);
                         float error_slope_purity_exo=fitexo->GetParError(1);
                         //fRunSubPurity2->Fill(evt.run(),evt.subRun(),-slope_purity_exo*1000.);
@@ -1034,7 +1143,7 @@ if(delta_sample_selected>1900)
                         ////std::cout << -1/slope_purity_exo << std::endl;
                         ////std::cout << -1/(slope_purity_exo+error_slope_purity_exo)+1/slope_purity_exo << std::endl;
                         ////std::cout << 1/slope_purity_exo-1/(slope_purity_exo-error_slope_purity_exo) << std::endl;
-                        ////std::cout << fitexo->GetChisquare()/(hitareagood->size()-2) << std::endl;
+                        ////std::cout << fitexo->GetChisquare()/(hitareagood.size()-2) << std::endl;
 			
 			
                         if(fabs(slope_purity_2)<0.01 || fabs(slope_purity_exo)<0.01)
@@ -1042,7 +1151,7 @@ if(delta_sample_selected>1900)
 			    if(fabs(slope_purity_2)<0.01)purityvalues->Fill(-slope_purity_2*1000.);
                             if(fabs(slope_purity_2)<0.01)goodpuro << evt.run() << " " << evt.subRun() << "  " << evt.event() << "  " << tpc_number << "  " << slope_purity_2 << "  " << error_slope_purity_2 << " " << chiquadro << " " << clusters_dw[icl] << " " << clusters_ds[icl] << std::endl;
 			    
-			    if(fabs(slope_purity_exo)<0.01)goodpuro2<< evt.run() << " " << evt.subRun() << " " << evt.event() << " " << tpc_number+fcryofcl*10 << " " << slope_purity_exo << " " << error_slope_purity_exo << " " << fitexo->GetChisquare()/(hitareagood->size()-2) << " " << clusters_dw[icl] << " " << clusters_ds[icl] << " " << clusters_mw[icl] << " " << clusters_ms[icl] << " " << delta_wire_selected << " " << delta_sample_selected << " " << sample_minimo << " " << sample_massimo << " " << wire_del_minimo << " " << wire_del_massimo << " " << wire_minimo << " " << wire_massimo << " " << whc->size() << " " << hitarea->size() << " " << quante_hit_nel_range_tempo << " " << error_expo << " " << clusters_mintime[icl] << " " << mean_hit_area << std::endl;
+			    if(fabs(slope_purity_exo)<0.01)goodpuro2<< evt.run() << " " << evt.subRun() << " " << evt.event() << " " << tpc_number+fcryofcl*10 << " " << slope_purity_exo << " " << error_slope_purity_exo << " " << fitexo->GetChisquare()/(hitareagood.size()-2) << " " << clusters_dw[icl] << " " << clusters_ds[icl] << " " << clusters_mw[icl] << " " << clusters_ms[icl] << " " << delta_wire_selected << " " << delta_sample_selected << " " << sample_minimo << " " << sample_massimo << " " << wire_del_minimo << " " << wire_del_massimo << " " << wire_minimo << " " << wire_massimo << " " << whc.size() << " " << hitarea.size() << " " << quante_hit_nel_range_tempo << " " << error_expo << " " << clusters_mintime[icl] << " " << mean_hit_area << std::endl;
 
                   
                   if(fabs(slope_purity_exo)<0.01)
@@ -1053,12 +1162,12 @@ if(delta_sample_selected>1900)
                       tpc_tree=tpc_number+fcryofcl*10;
                       slope_tree=-slope_purity_exo*1000;
                       errslope_tree=error_slope_purity_exo*1000;
-                      chi_tree=fitexo->GetChisquare()/(hitareagood->size()-2);
+                      chi_tree=fitexo->GetChisquare()/(hitareagood.size()-2);
                       dtime_tree=delta_sample_selected;
                       dwire_tree=wire_massimo-wire_minimo+1;
                       earea_tree=error_expo;
                       marea_tree=mean_hit_area;
-                      qhits_tree=hitarea->size();
+                      qhits_tree=hitarea.size();
                       fpurTree->Fill();
                   }
                   if(fabs(slope_purity_exo)<0.01)purityvalues2->Fill(-slope_purity_exo*1000.);
@@ -1123,20 +1232,10 @@ if(delta_sample_selected>1900)
 		      }
 		    ////std::cout << "Delete hit stuff." << std::endl;
 
-		    delete hittime;
-		    delete hitarea;
-		    delete hittimegood;
-		    delete hitareagood;
-		    delete hitwiregood;
-		    delete hitwire;
 		  }
 		
 		////std::cout << "Delete cluster stuff." << std::endl;
 		
-		delete shc;
-		delete ahc;
-		delete fahc;
-		delete whc;
 	       
 	      }//fine if ananlisi
 	  }
@@ -1144,18 +1243,6 @@ if(delta_sample_selected>1900)
 
 	////std::cout << "Delete big stuff." << std::endl;
 
-	delete www0;
-	delete sss0;
-	delete hhh0;
-	delete ehh0;
-	delete ccc0;
-	delete www2;
-	delete sss2;
-	delete hhh2;
-	delete ehh2;
-	delete ccc2;
-	delete aaa0;
-	delete aaa2;
 
       }
 
@@ -0,0 +1,387 @@
+/**
+ * @file   icaruscode/Analysis/TPCPurityFit.h
+ * @brief  Closed-form principal components and robust lifetime fit for
+ *         `TPCPurityMonitor`.
+ * @date   October 18, 2026
+ *
+ * This library is header-only.
+ *
+ * The principal component analysis of the purity monitor always involves
+ * 2×2 or 3×3 symmetric matrices, whose eigenvalue problem can be solved in
+ * closed form without iterations and without any allocation.
+ * The eigenvalues are returned in increasing order and the eigenvectors are
+ * stored one per row, following the convention of the original
+ * `Eigen::SelfAdjointEigenSolver` based implementation (after transposition),
+ * so that the major axis is the last one. The sign of each eigenvector is
+ * arbitrary.
+ */
+
+#ifndef ICARUSCODE_ANALYSIS_TPCPURITYFIT_H
+#define ICARUSCODE_ANALYSIS_TPCPURITYFIT_H
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::max()
+#include <array>
+#include <cmath> // std::sqrt(), std::acos(), std::cos(), std::log(), ...
+#include <cstddef> // std::size_t
+#include <utility> // std::pair
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::purity {
+
+  /// Eigenvalues (increasing) and eigenvectors (one per row) of a matrix.
+  template <std::size_t N>
+  struct SymmetricEigenSystem {
+    using Vector_t = std::array<double, N>;
+
+    Vector_t                values{};  ///< Eigenvalues in increasing order.
+    std::array<Vector_t, N> vectors{}; ///< Normalized eigenvectors, by row.
+  }; // SymmetricEigenSystem
+
+
+  /// Result of a principal component analysis in `N` dimensions.
+  template <std::size_t N>
+  struct PrincipalComponents: SymmetricEigenSystem<N> {
+    using Vector_t = typename SymmetricEigenSystem<N>::Vector_t;
+
+    bool     ok        = false; ///< Whether the decomposition was successful.
+    int      nPoints   = 0;     ///< Number of points in the decomposition.
+    Vector_t mean{};            ///< Average position of the points.
+  }; // PrincipalComponents
+
+
+  /**
+   * @brief Solves the eigenvalue problem of `{ { xx, xy }, { xy, yy } }`.
+   * @return eigenvalues and eigenvectors, major axis last
+   */
+  inline SymmetricEigenSystem<2> solveSymmetric2x2
+    (double xx, double xy, double yy)
+  {
+    SymmetricEigenSystem<2> result;
+
+    double const halfTrace = 0.5 * (xx + yy);
+    double const radius = std::hypot(0.5 * (xx - yy), xy);
+
+    result.values = { halfTrace - radius, halfTrace + radius };
+
+    // of the two (parallel) candidates for the major axis, the longer one
+    // is the numerically safer
+    double const major = result.values[1];
+    double ax = major - yy, ay = xy;
+    double const bx = xy, by = major - xx;
+    if (bx * bx + by * by > ax * ax + ay * ay) { ax = bx; ay = by; }
+
+    double const norm = std::hypot(ax, ay);
+    if (norm > 0.0) { ax /= norm; ay /= norm; }
+    else { ax = 0.0; ay = 1.0; } // isotropic: any axis goes
+
+    result.vectors[1] = { ax, ay };
+    result.vectors[0] = { -ay, ax };
+    return result;
+  } // solveSymmetric2x2()
+
+
+  /**
+   * @brief Solves the eigenvalue problem of a symmetric 3×3 matrix.
+   * @return eigenvalues and eigenvectors, major axis last
+   *
+   * The eigenvalues are found with the trigonometric solution of the
+   * characteristic equation. The eigenvector of the most isolated eigenvalue
+   * is the kernel of the shifted matrix, and the remaining two are found by
+   * solving the 2×2 problem in the plane orthogonal to it.
+   */
+  inline SymmetricEigenSystem<3> solveSymmetric3x3(
+    double xx, double xy, double xz, double yy, double yz, double zz
+    )
+  {
+    using Vector_t = SymmetricEigenSystem<3>::Vector_t;
+
+    auto const dot = [](Vector_t const& a, Vector_t const& b)
+      { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+    auto const cross = [](Vector_t const& a, Vector_t const& b)
+      {
+        return Vector_t{
+          a[1] * b[2] - a[2] * b[1],
+          a[2] * b[0] - a[0] * b[2],
+          a[0] * b[1] - a[1] * b[0]
+        };
+      };
+    auto const scale = [](Vector_t v, double f)
+      { for (double& c: v) c *= f; return v; };
+    auto const apply = [&](Vector_t const& v) // matrix times v
+      {
+        return Vector_t{
+          xx * v[0] + xy * v[1] + xz * v[2],
+          xy * v[0] + yy * v[1] + yz * v[2],
+          xz * v[0] + yz * v[1] + zz * v[2]
+        };
+      };
+
+    SymmetricEigenSystem<3> result;
+
+    //
+    // eigenvalues
+    //
+    double const offDiag2 = xy * xy + xz * xz + yz * yz;
+    double const shift = (xx + yy + zz) / 3.0;
+    double const dx = xx - shift, dy = yy - shift, dz = zz - shift;
+    double const p2 = dx * dx + dy * dy + dz * dz + 2.0 * offDiag2;
+
+    if (!(p2 > 0.0)) { // multiple of the identity (or not a number)
+      result.values = { xx, yy, zz };
+      result.vectors = {{ { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } }};
+      return result;
+    }
+
+    double const p = std::sqrt(p2 / 6.0);
+    // half the determinant of ( A - shift ) / p
+    double const halfDet = (
+        dx * (dy * dz - yz * yz)
+      - xy * (xy * dz - yz * xz)
+      + xz * (xy * yz - dy * xz)
+      ) / (2.0 * p * p * p);
+    double const phi = std::acos(std::clamp(halfDet, -1.0, 1.0)) / 3.0;
+    double const twoPi3 = 2.0 * std::acos(-1.0) / 3.0;
+
+    double const largest = shift + 2.0 * p * std::cos(phi);
+    double const smallest = shift + 2.0 * p * std::cos(phi + twoPi3);
+    result.values = { smallest, 3.0 * shift - largest - smallest, largest };
+
+    //
+    // eigenvectors
+    //
+    // the most isolated eigenvalue has the best conditioned kernel
+    bool const lowIsolated
+      = (result.values[1] - result.values[0])
+      > (result.values[2] - result.values[1]);
+    std::size_t const iso = lowIsolated? 0: 2;
+    double const lambda = result.values[iso];
+
+    // the kernel of ( A - lambda ) is orthogonal to all its rows: pick the
+    // longest cross product among the pairs of rows
+    Vector_t const r0{ xx - lambda, xy, xz };
+    Vector_t const r1{ xy, yy - lambda, yz };
+    Vector_t const r2{ xz, yz, zz - lambda };
+    Vector_t axis = cross(r0, r1);
+    double axisNorm2 = dot(axis, axis);
+    for (Vector_t const& c: { cross(r0, r2), cross(r1, r2) }) {
+      double const n2 = dot(c, c);
+      if (n2 > axisNorm2) { axis = c; axisNorm2 = n2; }
+    }
+    if (!(axisNorm2 > 0.0)) { // degenerate: keep the diagonal solution
+      result.vectors = {{ { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } }};
+      return result;
+    }
+    axis = scale(axis, 1.0 / std::sqrt(axisNorm2));
+
+    // orthonormal basis ( u, w ) of the plane orthogonal to the axis
+    Vector_t const seed = (std::abs(axis[0]) < 0.6)
+      ? Vector_t{ 1.0, 0.0, 0.0 }: Vector_t{ 0.0, 1.0, 0.0 };
+    Vector_t u = cross(axis, seed);
+    u = scale(u, 1.0 / std::sqrt(dot(u, u)));
+    Vector_t const w = cross(axis, u);
+
+    Vector_t const Au = apply(u), Aw = apply(w);
+    SymmetricEigenSystem<2> const plane
+      = solveSymmetric2x2(dot(u, Au), dot(u, Aw), dot(w, Aw));
+
+    std::size_t const first = lowIsolated? 1: 0;
+    for (std::size_t i = 0; i < 2; ++i) {
+      auto const& c = plane.vectors[i];
+      result.vectors[first + i] = {
+        c[0] * u[0] + c[1] * w[0],
+        c[0] * u[1] + c[1] * w[1],
+        c[0] * u[2] + c[1] * w[2]
+      };
+      result.values[first + i] = plane.values[i];
+    } // for
+    result.vectors[iso] = axis;
+    result.values[iso] = lambda;
+
+    return result;
+  } // solveSymmetric3x3()
+
+
+  /**
+   * @brief Weighted principal component analysis of a set of points.
+   * @tparam N number of dimensions
+   * @param n number of candidate points
+   * @param point `point(i)` returns the `std::array<double, N>` coordinates
+   * @param weight `weight(i)` returns the weight of the point
+   * @param select `select(i)` returns whether the point is to be used
+   * @return the principal components
+   *
+   * The average is weighted by the weights, while the covariance matrix
+   * is the average of the squares of the weighted distances from it
+   * (i.e. each entry is weighted by the square of the weight).
+   * The data is visited twice and nothing is allocated.
+   */
+  template <std::size_t N, typename Point, typename Weight, typename Select>
+  PrincipalComponents<N> computePrincipalComponents
+    (std::size_t n, Point point, Weight weight, Select select)
+  {
+    static_assert(N == 2 || N == 3, "Only 2D and 3D analyses are supported.");
+
+    PrincipalComponents<N> pca;
+
+    double meanWeightSum = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+      if (!select(i)) continue;
+      double const w = weight(i);
+      auto const p = point(i);
+      for (std::size_t d = 0; d < N; ++d) pca.mean[d] += p[d] * w;
+      meanWeightSum += w;
+      ++pca.nPoints;
+    } // for
+    for (double& c: pca.mean) c /= meanWeightSum;
+
+    // packed upper triangle of the covariance matrix
+    std::array<double, N * (N + 1) / 2> cov{};
+    double weightSum = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+      if (!select(i)) continue;
+      double const w = weight(i);
+      auto const p = point(i);
+      std::array<double, N> x;
+      for (std::size_t d = 0; d < N; ++d) x[d] = (p[d] - pca.mean[d]) * w;
+      weightSum += w * w;
+      std::size_t k = 0;
+      for (std::size_t r = 0; r < N; ++r)
+        for (std::size_t c = r; c < N; ++c) cov[k++] += x[r] * x[c];
+    } // for
+    for (double& c: cov) c /= weightSum;
+
+    SymmetricEigenSystem<N> eigen;
+    if constexpr (N == 2)
+      eigen = solveSymmetric2x2(cov[0], cov[1], cov[2]);
+    else
+      eigen = solveSymmetric3x3(cov[0], cov[1], cov[2], cov[3], cov[4], cov[5]);
+
+    static_cast<SymmetricEigenSystem<N>&>(pca) = eigen;
+    pca.ok = std::all_of(pca.values.begin(), pca.values.end(),
+      [](double v){ return std::isfinite(v); });
+    return pca;
+  } // computePrincipalComponents()
+
+
+  // ---------------------------------------------------------------------------
+  /**
+   * @brief Robust fit of the logarithm of the charge versus drift time.
+   *
+   * The fitter holds the (time, log(charge)) points of one track together with
+   * their weight and a "good" flag, and performs the principal component
+   * analysis and the outlier rejection on them. The slope of the major axis
+   * is the attenuation.
+   *
+   * The buffers are kept between tracks: after the first few tracks, filling
+   * and fitting a track does not allocate memory. A fitter can't be shared
+   * among threads.
+   */
+  class LifetimeFitter {
+      public:
+
+    /// Removes all the points, keeping the memory.
+    void clear()
+      {
+        fTime.clear();
+        fLogCharge.clear();
+        fWeight.clear();
+        fGood.clear();
+      }
+
+    /// Adds a point with the specified time, charge (linear) and weight.
+    void addPoint(double time, double charge, double weight = 1.0)
+      {
+        fTime.push_back(time);
+        fLogCharge.push_back(std::log(charge));
+        fWeight.push_back(weight);
+        fGood.push_back(1);
+      }
+
+    /// Returns the number of points, good or not.
+    std::size_t size() const { return fTime.size(); }
+
+    /// Returns whether the point `i` is still used in the fit.
+    bool isGood(std::size_t i) const { return fGood[i] != 0; }
+
+    /// Excludes from the fit all points outside `[ first, last )`.
+    void keepRange(std::size_t first, std::size_t last)
+      {
+        for (std::size_t i = 0; i < first; ++i) fGood[i] = 0;
+        for (std::size_t i = last; i < fGood.size(); ++i) fGood[i] = 0;
+      }
+
+    /// Returns the principal components of the good points.
+    PrincipalComponents<2> principalComponents() const
+      {
+        return computePrincipalComponents<2>(fTime.size(),
+          [this](std::size_t i)
+            { return std::array<double, 2>{ fTime[i], fLogCharge[i] }; },
+          [this](std::size_t i){ return fWeight[i]; },
+          [this](std::size_t i){ return fGood[i] != 0; }
+          );
+      }
+
+    /**
+     * @brief Excludes the good points deviating most from the `pca` axis.
+     * @param pca principal components of the current good points
+     * @param highRejectFrac fraction of points (sorted by deviation) kept
+     *
+     * The good points are sorted by their deviation in log(charge) from the
+     * major axis of `pca`. Excluded are the lowest 1%, the ones beyond
+     * the `highRejectFrac` fraction, and the ones with charge lower than
+     * the prediction by more than a factor `exp(0.75)`.
+     */
+    void rejectOutliers(PrincipalComponents<2> const& pca, float highRejectFrac)
+      {
+        constexpr double outlierReject = 0.75;
+
+        double const slope = attenuationSlope(pca);
+
+        fDeviations.clear();
+        for (std::size_t i = 0; i < fTime.size(); ++i) {
+          if (!fGood[i]) continue;
+          double const predLogCharge
+            = (fTime[i] - pca.mean[0]) * slope + pca.mean[1];
+          fDeviations.emplace_back(fLogCharge[i] - predLogCharge, i);
+        } // for
+
+        std::sort(fDeviations.begin(), fDeviations.end(),
+          [](auto const& left, auto const& right)
+            { return left.first < right.first; }
+          );
+
+        std::size_t const loRejectIdx = 0.01 * fDeviations.size();
+        std::size_t const hiRejectIdx = highRejectFrac * fDeviations.size();
+
+        for (std::size_t idx = 0; idx < fDeviations.size(); ++idx) {
+          auto const& [ deviation, i ] = fDeviations[idx];
+          if ((idx < loRejectIdx) || (idx > hiRejectIdx)) fGood[i] = 0;
+          if (deviation < -outlierReject) fGood[i] = 0;
+        } // for
+      }
+
+    /// Returns the slope of the major axis of `pca`.
+    static double attenuationSlope(PrincipalComponents<2> const& pca)
+      { return pca.vectors[1][1] / pca.vectors[1][0]; }
+
+      private:
+
+    std::vector<double> fTime;      ///< Time of each point.
+    std::vector<double> fLogCharge; ///< Logarithm of the charge of each point.
+    std::vector<double> fWeight;    ///< Weight of each point.
+    std::vector<char>   fGood;      ///< Whether each point is used.
+
+    /// Scratch: deviation from the axis and index of each good point.
+    std::vector<std::pair<double, std::size_t>> fDeviations;
+
+  }; // class LifetimeFitter
+
+} // namespace icarus::purity
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_ANALYSIS_TPCPURITYFIT_H
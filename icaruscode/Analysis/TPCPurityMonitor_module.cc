@@ -55,19 +55,22 @@
 //purity info class
 #include "sbnobj/Common/Analysis/TPCPurityInfo.hh"
 
-// Eigen includes
-#include "Eigen/Core"
-#include "Eigen/Dense"
-#include "Eigen/Eigenvalues"
-#include "Eigen/Geometry"
-#include "Eigen/Jacobi"
+// Closed form PCA and lifetime fit
+#include "icaruscode/Analysis/TPCPurityFit.h"
+
+// TBB
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/task_arena.h"
 
 // C++ Includes
 #include <vector>
 #include <algorithm>
 #include <numeric>
 #include <functional>
-#include <tuple>
+#include <optional>
+#include <array>
+#include <limits>
 
 namespace TPCPurityMonitor
 {
@@ -98,76 +101,128 @@ public:
 
 private:
     // Define a data structure to keep track of a hit's meta data
-    using HitMetaPair            = std::pair<art::Ptr<recob::Hit>,const recob::TrackHitMeta*>;
+    using HitMetaPair            = std::pair<const recob::Hit*,const recob::TrackHitMeta*>;
     using HitMetaPairVec         = std::vector<HitMetaPair>;
 
-    // Define the basic data structure we will use
-    using StatusChargePair       = std::pair<bool,double>;
-    using HitStatusChargePair    = std::pair<HitMetaPair,StatusChargePair>;
-    using HitStatusChargePairVec = std::vector<HitStatusChargePair>;
-
-    // We would also like to keep tracy of the trajectory points along the track
-    using PointDirTuple          = std::tuple<geo::Point_t,geo::Vector_t,geo::Vector_t>;
-    using HitPointDirTupleMap    = std::unordered_map<const recob::Hit*,PointDirTuple>;
-
-    // We also need to define a container for the output of the 2D PCA Analysis
-    class PrincipalComponents2D
+    // The basic data structure we will use: a selected hit with its charge (per unit length)
+    // and the trajectory point along the track
+    struct TrackHit
     {
-    public:
-
-        using EigenValues  = Eigen::Vector2d;
-        using EigenVectors = Eigen::Matrix2d;
-
-        PrincipalComponents2D() :
-            fSVD_OK(false), fNumHitsUsed(0), fEigenValues(EigenValues::Zero()), fEigenVectors(EigenVectors::Zero()), fAvePosition(Eigen::Vector2d::Zero()) {}
+        const recob::Hit*          hit;                 ///< The selected hit
+        const recob::TrackHitMeta* meta;                ///< Its association meta data
+        double                     charge;              ///< Charge per unit length
+        geo::Point_t               position;            ///< Trajectory point position
+        geo::Vector_t              direction;           ///< Trajectory point direction
+        geo::Vector_t              wireDir;             ///< Direction of the hit wire
+    };
 
-        PrincipalComponents2D(bool ok, int nHits, const EigenValues& eigenValues, const EigenVectors& eigenVecs, const Eigen::Vector2d& avePos) :
-            fSVD_OK(ok), fNumHitsUsed(nHits), fEigenValues(eigenValues), fEigenVectors(eigenVecs), fAvePosition(avePos) {}
+    using TrackHitVec            = std::vector<TrackHit>;
 
-        bool                   getSvdOK()                 const {return fSVD_OK;}
-        int                    getNumHitsUsed()           const {return fNumHitsUsed;}
-        const EigenValues&     getEigenValues()           const {return fEigenValues;}
-        const EigenVectors&    getEigenVectors()          const {return fEigenVectors;}
-        const Eigen::Vector2d& getAvePosition()           const {return fAvePosition;}
-        void                   flipAxis(size_t axis)            { fEigenVectors.row(axis) = -fEigenVectors.row(axis);}
+    // Containers for the output of the 2D and 3D PCA Analysis
+    // NOTE: the major axis will be the last entry, the minor axis will be the first
+    using PrincipalComponents2D  = icarus::purity::PrincipalComponents<2>;
+    using PrincipalComponents3D  = icarus::purity::PrincipalComponents<3>;
 
-    private:
-
-        bool            fSVD_OK;             ///< SVD Decomposition was successful
-        int             fNumHitsUsed;        ///< Number of hits in the decomposition
-        EigenValues     fEigenValues;        ///< Eigen values from SVD decomposition
-        EigenVectors    fEigenVectors;       ///< The three principle axes
-        Eigen::Vector2d fAvePosition;        ///< Average position of hits fed to PCA
+    // Buffers for the analysis of a track, reused from track to track by each thread
+    struct TrackScratch
+    {
+        HitMetaPairVec                 selectedHitMetaVec;  ///< Hits selected on the plane
+        std::vector<unsigned>          tpcHitCounts;        ///< Number of selected hits per TPC
+        TrackHitVec                    trackHitVec;         ///< Hits in the analysis
+        std::vector<unsigned>          wireVec;             ///< Wires of the hits
+        std::vector<size_t>            indexOrder;          ///< Hits in track index order
+        icarus::purity::LifetimeFitter fitter;              ///< The charge vs time fit
     };
 
-    // We also need to define a container for the output of the 2D PCA Analysis
-    class PrincipalComponents3D
+    // Content of the diagnostic tuple for one track
+    struct DiagnosticTupleData
     {
-    public:
-
-        using EigenValues  = Eigen::Vector3d;
-        using EigenVectors = Eigen::Matrix3d;
+        int                        fRunNumber;          ///< run number this event
+        int                        fSubRunNumber;       ///< sub run number this event
+        int                        fEventNumber;        ///< event number this event
+        int                        fCryostat;           ///< Cryostat for given track
+        int                        fTPC;                ///< TPC for given track
+        int                        fTrackIdx;           ///< index of track
+        int                        fWireRange;          ///< Last - first wire number
+        int                        fWires;              ///< Number wires spanned
+        int                        fTicks;              ///< Number ticks spanned
+        double                     fAttenuation;        ///< Attenuation from calc
+        double                     fError;              ///< Error from calc
+        std::vector<double>        fTrackStartXVec;     ///< Starting x position of track
+        std::vector<double>        fTrackStartYVec;     ///< Starting y position of track
+        std::vector<double>        fTrackStartZVec;     ///< Starting z position of track
+        std::vector<double>        fTrackDirXVec;       ///< Starting x direction of track
+        std::vector<double>        fTrackDirYVec;       ///< Starting x direction of track
+        std::vector<double>        fTrackDirZVec;       ///< Starting x direction of track
+        std::vector<double>        fTrackEndXVec;       ///< Ending x position of track
+        std::vector<double>        fTrackEndYVec;       ///< Ending y position of track
+        std::vector<double>        fTrackEndZVec;       ///< Ending z position of track
+        std::vector<double>        fTrackEndDirXVec;    ///< Ending x direction of track
+        std::vector<double>        fTrackEndDirYVec;    ///< Ending x direction of track
+        std::vector<double>        fTrackEndDirZVec;    ///< Ending x direction of track
+        std::vector<double>        fPCAAxes2D;          ///< Axes for PCA
+        std::vector<double>        fEigenValues2D;      ///< Eigen values 
+        std::vector<double>        fMeanPosition2D;     ///< Mean position used for PCA
+        std::vector<double>        fPCAAxes3D;          ///< Axes for PCA 3D
+        std::vector<double>        fEigenValues3D;      ///< Eigen values 3D
+        std::vector<double>        fMeanPosition3D;     ///< Mean position used for PCA
+        std::vector<double>        fTickVec;            ///< vector of ticks
+        std::vector<double>        fChargeVec;          ///< vector of hit charges
+        std::vector<double>        fDeltaXVec;          ///< Keep track of hits path length from track fit
+        std::vector<double>        fGoodnessOfFitVec;   ///< Goodness of the hit's fit
+        std::vector<int>           fDegreesOfFreeVec;   ///< Degrees of freedom
+        std::vector<int>           fSnippetLengthVec;   ///< Lenght from start/end of hit
+        std::vector<bool>          fGoodHitVec;         ///< Hits were considered good
+        std::vector<double>        fCosThetaYZ;         ///< cos(thetaYZ) hit trajector to wire
+    };
 
-        PrincipalComponents3D() :
-            fSVD_OK(false), fNumHitsUsed(0), fEigenValues(EigenValues::Zero()), fEigenVectors(EigenVectors::Zero()), fAvePosition(Eigen::Vector3d::Zero()) {}
+    // The result of the analysis of one track
+    struct TrackPurity
+    {
+        anab::TPCPurityInfo        purityInfo;          ///< The output purity information
+        DiagnosticTupleData        diagnostics;         ///< Filled only if the tuple is requested
+    };
 
-        PrincipalComponents3D(bool ok, int nHits, const EigenValues& eigenValues, const EigenVectors& eigenVecs, const Eigen::Vector3d& avePos) :
-            fSVD_OK(ok), fNumHitsUsed(nHits), fEigenValues(eigenValues), fEigenVectors(eigenVecs), fAvePosition(avePos) {}
+    using TrackPurityVec         = std::vector<std::optional<TrackPurity>>;
 
-        bool                   getSvdOK()                 const {return fSVD_OK;}
-        int                    getNumHitsUsed()           const {return fNumHitsUsed;}
-        const EigenValues&     getEigenValues()           const {return fEigenValues;}
-        const EigenVectors&    getEigenVectors()          const {return fEigenVectors;}
-        const Eigen::Vector3d& getAvePosition()           const {return fAvePosition;}
-        void                   flipAxis(size_t axis)            { fEigenVectors.row(axis) = -fEigenVectors.row(axis);}
+    // Define a class to handle processing of the tracks in parallel
+    class multiThreadTrackProcessing
+    {
+    public:
+        multiThreadTrackProcessing(const TPCPurityMonitor&           parent,
+                                   const std::vector<recob::Track>&  tracks,
+                                   const HitMetaPairVec&             trackHitMetaVec,
+                                   const std::vector<size_t>&        trackHitOffsets,
+                                   TrackPurityVec&                   trackPurityVec)
+            : fTPCPurityMonitor(parent),
+              fTracks(tracks),
+              fTrackHitMetaVec(trackHitMetaVec),
+              fTrackHitOffsets(trackHitOffsets),
+              fTrackPurityVec(trackPurityVec)
+        {}
+
+        void operator()(const tbb::blocked_range<size_t>& range) const
+        {
+            TrackScratch& scratch = fTPCPurityMonitor.fTrackScratchVec[tbb::this_task_arena::current_thread_index()];
 
+            for (size_t trackIdx = range.begin(); trackIdx < range.end(); trackIdx++)
+            {
+                TrackPurity trackPurity;
+
+                if (fTPCPurityMonitor.ProcessTrack(fTracks[trackIdx],
+                                                   fTrackHitMetaVec.data() + fTrackHitOffsets[trackIdx],
+                                                   fTrackHitMetaVec.data() + fTrackHitOffsets[trackIdx + 1],
+                                                   scratch,
+                                                   trackPurity))
+                    fTrackPurityVec[trackIdx] = std::move(trackPurity);
+            }
+        }
     private:
-
-        bool            fSVD_OK;             ///< SVD Decomposition was successful
-        int             fNumHitsUsed;        ///< Number of hits in the decomposition
-        EigenValues     fEigenValues;        ///< Eigen values from SVD decomposition
-        EigenVectors    fEigenVectors;       ///< The three principle axes
-        Eigen::Vector3d fAvePosition;        ///< Average position of hits fed to PCA
+        const TPCPurityMonitor&          fTPCPurityMonitor;
+        const std::vector<recob::Track>& fTracks;
+        const HitMetaPairVec&            fTrackHitMetaVec;
+        const std::vector<size_t>&       fTrackHitOffsets;
+        TrackPurityVec&                  fTrackPurityVec;
     };
 
     // This method reads in any parameters from the .fcl files. This
@@ -176,12 +231,8 @@ private:
     // interactive event display.
     void reconfigure(fhicl::ParameterSet const& pset);
 
-    // Compute the principle axes
-    void GetPrincipalComponents2D(const HitStatusChargePairVec& hitPairVector, PrincipalComponents2D& pca)                       const;
-    void GetPrincipalComponents3D(const HitStatusChargePairVec& hitPairVector, HitPointDirTupleMap&, PrincipalComponents3D& pca) const;
-
-    // Reject outliers
-    void RejectOutliers(HitStatusChargePairVec& hitPairVector, const PrincipalComponents2D& pca) const;
+    // Analyze a single track, returns false if the track is not usable
+    bool ProcessTrack(const recob::Track&, const HitMetaPair* firstHit, const HitMetaPair* lastHit, TrackScratch&, TrackPurity&) const;
 
     // The following typedefs will, obviously, be useful
     double length(const recob::Track* track);
@@ -204,46 +255,13 @@ private:
     float                      fSamplingRate;       ///< Recover the sampling rate from the clock data
 
     // Output tuple variables
-    int                        fRunNumber;          ///< run number this event
-    int                        fSubRunNumber;       ///< sub run number this event
-    int                        fEventNumber;        ///< event number this event
-    int                        fCryostat;           ///< Cryostat for given track
-    int                        fTPC;                ///< TPC for given track
-    int                        fTrackIdx;           ///< index of track
-    int                        fWireRange;          ///< Last - first wire number
-    int                        fWires;              ///< Number wires spanned
-    int                        fTicks;              ///< Number ticks spanned
-    double                     fAttenuation;        ///< Attenuation from calc
-    double                     fError;              ///< Error from calc
-    std::vector<double>        fTrackStartXVec;     ///< Starting x position of track
-    std::vector<double>        fTrackStartYVec;     ///< Starting y position of track
-    std::vector<double>        fTrackStartZVec;     ///< Starting z position of track
-    std::vector<double>        fTrackDirXVec;       ///< Starting x direction of track
-    std::vector<double>        fTrackDirYVec;       ///< Starting x direction of track
-    std::vector<double>        fTrackDirZVec;       ///< Starting x direction of track
-    std::vector<double>        fTrackEndXVec;       ///< Ending x position of track
-    std::vector<double>        fTrackEndYVec;       ///< Ending y position of track
-    std::vector<double>        fTrackEndZVec;       ///< Ending z position of track
-    std::vector<double>        fTrackEndDirXVec;    ///< Ending x direction of track
-    std::vector<double>        fTrackEndDirYVec;    ///< Ending x direction of track
-    std::vector<double>        fTrackEndDirZVec;    ///< Ending x direction of track
-    std::vector<double>        fPCAAxes2D;          ///< Axes for PCA
-    std::vector<double>        fEigenValues2D;      ///< Eigen values 
-    std::vector<double>        fMeanPosition2D;     ///< Mean position used for PCA
-    std::vector<double>        fPCAAxes3D;          ///< Axes for PCA 3D
-    std::vector<double>        fEigenValues3D;      ///< Eigen values 3D
-    std::vector<double>        fMeanPosition3D;     ///< Mean position used for PCA
-    std::vector<double>        fTickVec;            ///< vector of ticks
-    std::vector<double>        fChargeVec;          ///< vector of hit charges
-    std::vector<double>        fDeltaXVec;          ///< Keep track of hits path length from track fit
-    std::vector<double>        fGoodnessOfFitVec;   ///< Goodness of the hit's fit
-    std::vector<int>           fDegreesOfFreeVec;   ///< Degrees of freedom
-    std::vector<int>           fSnippetLengthVec;   ///< Lenght from start/end of hit
-    std::vector<bool>          fGoodHitVec;         ///< Hits were considered good
-    std::vector<double>        fCosThetaYZ;         ///< cos(thetaYZ) hit trajector to wire
+    DiagnosticTupleData        fDiagnostics;        ///< Content of the current tuple entry
 
     TTree*                     fDiagnosticTree;     ///< Pointer to our tree
 
+    // Per thread buffers
+    mutable std::vector<TrackScratch> fTrackScratchVec;
+
     int fNumEvents;
 
     // Other variables that will be shared between different methods.
@@ -273,6 +291,9 @@ TPCPurityMonitor::TPCPurityMonitor(fhicl::ParameterSet const& parameterSet)
 
     // Read in the parameters from the .fcl file.
     this->reconfigure(parameterSet);
+
+    // Tracks are analyzed in parallel, each thread with its own buffers
+    fTrackScratchVec.resize(tbb::this_task_arena::max_concurrency());
 }
 
 //-----------------------------------------------------------------------
@@ -295,44 +316,44 @@ void TPCPurityMonitor::beginJob()
     
         fDiagnosticTree = tfs->make<TTree>("PurityMonitor","");
 
-        fDiagnosticTree->Branch("run",         &fRunNumber,     "run/I");
-        fDiagnosticTree->Branch("subrun",      &fSubRunNumber,  "subrun/I");
-        fDiagnosticTree->Branch("event",       &fEventNumber,   "event/I");
-        fDiagnosticTree->Branch("cryostat",    &fCryostat,      "cryostat/I");
-        fDiagnosticTree->Branch("tpc",         &fTPC,           "tpc/I");
-        fDiagnosticTree->Branch("trackidx",    &fTrackIdx,      "trackidx/I");
-        fDiagnosticTree->Branch("wirerange",   &fWireRange,     "wirerange/I");
-        fDiagnosticTree->Branch("nwires",      &fWires,         "nwires/I");
-        fDiagnosticTree->Branch("nticks",      &fTicks,         "nticks/I");
-        fDiagnosticTree->Branch("attenuation", &fAttenuation,   "attenuation/D");
-        fDiagnosticTree->Branch("error",       &fError,         "error/D");
-
-        fDiagnosticTree->Branch("trkstartx",   "std::vector<double>", &fTrackStartXVec);
-        fDiagnosticTree->Branch("trkstarty",   "std::vector<double>", &fTrackStartYVec);
-        fDiagnosticTree->Branch("trkstartz",   "std::vector<double>", &fTrackStartZVec);
-        fDiagnosticTree->Branch("trkdirx",     "std::vector<double>", &fTrackDirXVec);
-        fDiagnosticTree->Branch("trkdiry",     "std::vector<double>", &fTrackDirYVec);
-        fDiagnosticTree->Branch("trkdirz",     "std::vector<double>", &fTrackDirZVec);
-        fDiagnosticTree->Branch("trkendx",     "std::vector<double>", &fTrackEndXVec);
-        fDiagnosticTree->Branch("trkendy",     "std::vector<double>", &fTrackEndYVec);
-        fDiagnosticTree->Branch("trkendz",     "std::vector<double>", &fTrackEndZVec);
-        fDiagnosticTree->Branch("trkenddirx",  "std::vector<double>", &fTrackEndDirXVec);
-        fDiagnosticTree->Branch("trkenddiry",  "std::vector<double>", &fTrackEndDirYVec);
-        fDiagnosticTree->Branch("trkenddirz",  "std::vector<double>", &fTrackEndDirZVec);
-        fDiagnosticTree->Branch("pcavec2d",    "std::vector<double>", &fPCAAxes2D);
-        fDiagnosticTree->Branch("eigenvec2d",  "std::vector<double>", &fEigenValues2D);
-        fDiagnosticTree->Branch("meanpos2d",   "std::vector<double>", &fMeanPosition2D);
-        fDiagnosticTree->Branch("pcavec3d",    "std::vector<double>", &fPCAAxes3D);
-        fDiagnosticTree->Branch("eigenvec3d",  "std::vector<double>", &fEigenValues3D);
-        fDiagnosticTree->Branch("meanpos3d",   "std::vector<double>", &fMeanPosition3D);
-        fDiagnosticTree->Branch("tickvec",     "std::vector<double>", &fTickVec);
-        fDiagnosticTree->Branch("chargevec",   "std::vector<double>", &fChargeVec);
-        fDiagnosticTree->Branch("deltaxvec",   "std::vector<double>", &fDeltaXVec);
-        fDiagnosticTree->Branch("goodnessvec", "std::vector<double>", &fGoodnessOfFitVec);
-        fDiagnosticTree->Branch("freedomvec",  "std::vector<int>",    &fDegreesOfFreeVec);
-        fDiagnosticTree->Branch("snippetvec",  "std::vector<int>",    &fSnippetLengthVec);
-        fDiagnosticTree->Branch("goodhitvec",  "std::vector<bool>",   &fGoodHitVec);
-        fDiagnosticTree->Branch("costhetaYZ",  "std::vector<double>", &fCosThetaYZ);
+        fDiagnosticTree->Branch("run",         &fDiagnostics.fRunNumber,     "run/I");
+        fDiagnosticTree->Branch("subrun",      &fDiagnostics.fSubRunNumber,  "subrun/I");
+        fDiagnosticTree->Branch("event",       &fDiagnostics.fEventNumber,   "event/I");
+        fDiagnosticTree->Branch("cryostat",    &fDiagnostics.fCryostat,      "cryostat/I");
+        fDiagnosticTree->Branch("tpc",         &fDiagnostics.fTPC,           "tpc/I");
+        fDiagnosticTree->Branch("trackidx",    &fDiagnostics.fTrackIdx,      "trackidx/I");
+        fDiagnosticTree->Branch("wirerange",   &fDiagnostics.fWireRange,     "wirerange/I");
+        fDiagnosticTree->Branch("nwires",      &fDiagnostics.fWires,         "nwires/I");
+        fDiagnosticTree->Branch("nticks",      &fDiagnostics.fTicks,         "nticks/I");
+        fDiagnosticTree->Branch("attenuation", &fDiagnostics.fAttenuation,   "attenuation/D");
+        fDiagnosticTree->Branch("error",       &fDiagnostics.fError,         "error/D");
+
+        fDiagnosticTree->Branch("trkstartx",   "std::vector<double>", &fDiagnostics.fTrackStartXVec);
+        fDiagnosticTree->Branch("trkstarty",   "std::vector<double>", &fDiagnostics.fTrackStartYVec);
+        fDiagnosticTree->Branch("trkstartz",   "std::vector<double>", &fDiagnostics.fTrackStartZVec);
+        fDiagnosticTree->Branch("trkdirx",     "std::vector<double>", &fDiagnostics.fTrackDirXVec);
+        fDiagnosticTree->Branch("trkdiry",     "std::vector<double>", &fDiagnostics.fTrackDirYVec);
+        fDiagnosticTree->Branch("trkdirz",     "std::vector<double>", &fDiagnostics.fTrackDirZVec);
+        fDiagnosticTree->Branch("trkendx",     "std::vector<double>", &fDiagnostics.fTrackEndXVec);
+        fDiagnosticTree->Branch("trkendy",     "std::vector<double>", &fDiagnostics.fTrackEndYVec);
+        fDiagnosticTree->Branch("trkendz",     "std::vector<double>", &fDiagnostics.fTrackEndZVec);
+        fDiagnosticTree->Branch("trkenddirx",  "std::vector<double>", &fDiagnostics.fTrackEndDirXVec);
+        fDiagnosticTree->Branch("trkenddiry",  "std::vector<double>", &fDiagnostics.fTrackEndDirYVec);
+        fDiagnosticTree->Branch("trkenddirz",  "std::vector<double>", &fDiagnostics.fTrackEndDirZVec);
+        fDiagnosticTree->Branch("pcavec2d",    "std::vector<double>", &fDiagnostics.fPCAAxes2D);
+        fDiagnosticTree->Branch("eigenvec2d",  "std::vector<double>", &fDiagnostics.fEigenValues2D);
+        fDiagnosticTree->Branch("meanpos2d",   "std::vector<double>", &fDiagnostics.fMeanPosition2D);
+        fDiagnosticTree->Branch("pcavec3d",    "std::vector<double>", &fDiagnostics.fPCAAxes3D);
+        fDiagnosticTree->Branch("eigenvec3d",  "std::vector<double>", &fDiagnostics.fEigenValues3D);
+        fDiagnosticTree->Branch("meanpos3d",   "std::vector<double>", &fDiagnostics.fMeanPosition3D);
+        fDiagnosticTree->Branch("tickvec",     "std::vector<double>", &fDiagnostics.fTickVec);
+        fDiagnosticTree->Branch("chargevec",   "std::vector<double>", &fDiagnostics.fChargeVec);
+        fDiagnosticTree->Branch("deltaxvec",   "std::vector<double>", &fDiagnostics.fDeltaXVec);
+        fDiagnosticTree->Branch("goodnessvec", "std::vector<double>", &fDiagnostics.fGoodnessOfFitVec);
+        fDiagnosticTree->Branch("freedomvec",  "std::vector<int>",    &fDiagnostics.fDegreesOfFreeVec);
+        fDiagnosticTree->Branch("snippetvec",  "std::vector<int>",    &fDiagnostics.fSnippetLengthVec);
+        fDiagnosticTree->Branch("goodhitvec",  "std::vector<bool>",   &fDiagnostics.fGoodHitVec);
+        fDiagnosticTree->Branch("costhetaYZ",  "std::vector<double>", &fDiagnostics.fCosThetaYZ);
     }
 
 
@@ -373,7 +394,7 @@ void TPCPurityMonitor::reconfigure(fhicl::ParameterSet const& p)
 //-----------------------------------------------------------------------
 void TPCPurityMonitor::produce(art::Event& event)
 {
-    //setup output vector#include "lardataobj/RecoBase/TrackHitMeta.h"
+    //setup output vector
     std::unique_ptr< std::vector<anab::TPCPurityInfo> > outputPtrVector(new std::vector<anab::TPCPurityInfo>());
 
     fNumEvents++;
@@ -391,293 +412,57 @@ void TPCPurityMonitor::produce(art::Event& event)
         
         if (!trackHandle.isValid()) continue;
 
-        // I don't know another way to do this... but we need to build a map from hit to spacepoint
-        // since we don't seem to have a way to go that direction with what we have for kalman fit
-        // tracks. 
-        using HitToSpacePointMap = std::unordered_map<const recob::Hit*,const recob::SpacePoint*>;
-        
-        HitToSpacePointMap hitToSpacePointMap;
-
-        using PointCloud = std::vector<geo::Point_t>;
-
-        PointCloud pointCloud;
-
         // Recover the collection of associations between tracks and hits and hits and spacepoints
         art::FindManyP<recob::Hit,recob::TrackHitMeta> trackHitAssns(trackHandle, event, trackLabel);
 
-        // Loop over tracks and recover hits
-        for(size_t trackIdx = 0; trackIdx < trackHandle->size(); trackIdx++)
-        {
-            art::Ptr<recob::Track> track(trackHandle,trackIdx);
-
-            const std::vector<art::Ptr<recob::Hit>>&      trackHitsVec(trackHitAssns.at(track.key()));
-            const std::vector<const recob::TrackHitMeta*> metaHitsVec = trackHitAssns.data(track.key());
-
-            // Focus on selected hits:
-            // 1) Pick out hits on a single plane given by fhicl parameter
-            // 2) multiplicity == 1 which should give us clean gaussian shaped pulses
-            using TPCToHitMetaPairVecMap = std::unordered_map<unsigned int,HitMetaPairVec>;
-
-            TPCToHitMetaPairVecMap selectedHitMetaVecMap;
-
-            for(size_t idx=0; idx<trackHitsVec.size(); idx++)
-            {
-                art::Ptr<recob::Hit> hit(trackHitsVec.at(idx));
-
-                if (hit->WireID().Plane == fSelectedPlane && hit->Multiplicity() == 1) selectedHitMetaVecMap[hit->WireID().TPC].emplace_back(hit,metaHitsVec.at(idx));
-            }
-
-            if (selectedHitMetaVecMap.empty()) continue;
-
-            // Currently we need to limit the analysis to a single TPC and we have tracks which may have been stitched across the cathode... 
-            // For now, we search and find the TPC with the most hits
-            TPCToHitMetaPairVecMap::iterator bestMapItr = selectedHitMetaVecMap.begin();
-
-            for(TPCToHitMetaPairVecMap::iterator mapItr = selectedHitMetaVecMap.begin(); mapItr != selectedHitMetaVecMap.end(); mapItr++)
-            {
-                if (mapItr->second.size() > bestMapItr->second.size()) bestMapItr = mapItr;
-            }
-
-            HitMetaPairVec& selectedHitMetaVec = bestMapItr->second;
-
-            // Need a minimum number of hits
-            if (selectedHitMetaVec.size() < fMinNumHits) continue;
-
-            // Sort hits by increasing time 
-            std::sort(selectedHitMetaVec.begin(),selectedHitMetaVec.end(),[](const auto& left, const auto& right){return left.first->PeakTime() < right.first->PeakTime();});
-
-            // Require track to have a minimum range in ticks
-            if (selectedHitMetaVec.back().first->PeakTime() - selectedHitMetaVec.front().first->PeakTime() < fMinTickRange) continue;
-
-            // At this point we should have a vector of art::Ptrs to hits on the selected plane
-            // So we should be able to now transition to computing the attenuation
-            // Start by forming a vector of pairs of the time (in ticks) and the ln of charge derated by an assumed lifetime
-            HitStatusChargePairVec hitStatusChargePairVec;
-            HitPointDirTupleMap    hitPointDirTupleMap;
-
-            float  firstHitTime(selectedHitMetaVec.front().first->PeakTime());
-            double maxDeltaX(1.5);   // Assume a "long hit" would be no more than 1.5 cm in length
-            double wirePitch(0.3);
-
-            for(const auto& hitMetaPair: selectedHitMetaVec)
-            {
-                unsigned int trkHitIndex = hitMetaPair.second->Index();
-                double       deltaX      = 0.3;                         // Set this to 3 mm just in case no corresponding point
-                double       cosTheta    = -100.;
-
-                if (trkHitIndex != std::numeric_limits<unsigned int>::max() && track->HasValidPoint(trkHitIndex))
-                {
-                    geo::Point_t        hitPos  = track->LocationAtPoint(trkHitIndex);
-                    geo::Vector_t       hitDir  = track->DirectionAtPoint(trkHitIndex);
-                    const geo::WireGeo& wireGeo = fGeometry->Wire(hitMetaPair.first->WireID());
-                    geo::Vector_t       wireDir(wireGeo.Direction()[0],wireGeo.Direction()[1],wireGeo.Direction()[2]);
-
-                    pointCloud.emplace_back(hitPos);
-
-                    cosTheta = std::abs(hitDir.Dot(wireDir));
-
-                    if (cosTheta < 1.)
-                    {
-                        deltaX = std::min(wirePitch / (1. - cosTheta), maxDeltaX);
-                    }
-                    else deltaX = maxDeltaX;
-
-                    double charge = fUseHitIntegral ? hitMetaPair.first->Integral() : hitMetaPair.first->SummedADC(); 
-
-                    hitStatusChargePairVec.emplace_back(hitMetaPair,StatusChargePair(true,charge/deltaX));
-                    hitPointDirTupleMap[hitMetaPair.first.get()] = PointDirTuple(hitPos,hitDir,wireDir);
-                }
-            }
-
-            size_t numOrig   = hitStatusChargePairVec.size();
-            size_t lowCutIdx = fMinRejectFraction * numOrig;
-            size_t hiCutIdx  = fMaxRejectFraction * numOrig;
-
-            // Will require a minimum number of hits left over to proceed
-            if (lowCutIdx + 10 >= hiCutIdx)
-            {
-                std::cout << "*****>>>> lowCutIdx >= hiCutIdx: " << lowCutIdx << ", " << hiCutIdx << std::endl;
-                continue;
-            }
-
-//            HitStatusChargePairVec(hitStatusChargePairVec.begin() + lowCutIdx, hitStatusChargePairVec.begin() + hiCutIdx).swap(hitStatusChargePairVec);
-
-            // Put back in time order
-//            std::sort(hitStatusChargePairVec.begin(),hitStatusChargePairVec.end(),[](const auto& left, const auto& right){return left.first->PeakTime() < right.first->PeakTime();});
-
-            // Tag the leading and trailing hits so as to not use them
-            std::transform(hitStatusChargePairVec.begin(),hitStatusChargePairVec.begin()+lowCutIdx,hitStatusChargePairVec.begin(),      [](const auto& hitPair){return HitStatusChargePair(hitPair.first,StatusChargePair(false,hitPair.second.second));});
-            std::transform(hitStatusChargePairVec.begin()+hiCutIdx,hitStatusChargePairVec.end(),hitStatusChargePairVec.begin()+hiCutIdx,[](const auto& hitPair){return HitStatusChargePair(hitPair.first,StatusChargePair(false,hitPair.second.second));});
-
-            PrincipalComponents2D pca;
+        // Resolve the hits of all the tracks here, so that the parallel processing below
+        // only deals with plain pointers: the hits of track i are in [offsets[i], offsets[i+1])
+        HitMetaPairVec      trackHitMetaVec;
+        std::vector<size_t> trackHitOffsets(1, 0);
 
-            GetPrincipalComponents2D(hitStatusChargePairVec, pca);
+        trackHitOffsets.reserve(trackHandle->size() + 1);
 
-            // Reject the outliers
-            RejectOutliers(hitStatusChargePairVec, pca);
-
-            // Recompute the pca
-            GetPrincipalComponents2D(hitStatusChargePairVec, pca);
-
-            // If the PCA faild then we should bail out 
-            if (!pca.getSvdOK()) continue;
-
-            // Now get the 3D PCA so we can use this to help select on track straightness
-            PrincipalComponents3D pca3D;
+        for(size_t trackIdx = 0; trackIdx < trackHandle->size(); trackIdx++)
+        {
+            const std::vector<art::Ptr<recob::Hit>>&      trackHitsVec(trackHitAssns.at(trackIdx));
+            const std::vector<const recob::TrackHitMeta*>& metaHitsVec(trackHitAssns.data(trackIdx));
 
-            GetPrincipalComponents3D(hitStatusChargePairVec, hitPointDirTupleMap, pca3D);
+            for(size_t idx=0; idx<trackHitsVec.size(); idx++) trackHitMetaVec.emplace_back(trackHitsVec[idx].get(),metaHitsVec[idx]);
 
-            const PrincipalComponents2D::EigenVectors& eigenVectors = pca.getEigenVectors();
+            trackHitOffsets.push_back(trackHitMetaVec.size());
+        }
 
-            double attenuation = eigenVectors.row(1)[1] / eigenVectors.row(1)[0];
+        // Analyze the tracks in parallel, then collect the results in track order
+        TrackPurityVec trackPurityVec(trackHandle->size());
 
-            // Want to find the wire range (or should it be the number of wires?)
-            unsigned maxWire(0);
-            unsigned minWire(100000);
+        multiThreadTrackProcessing trackProcessing(*this, *trackHandle, trackHitMetaVec, trackHitOffsets, trackPurityVec);
 
-            std::set<unsigned> usedWiresSet;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, trackHandle->size()), trackProcessing);
 
-            for(const auto& hitPair : hitStatusChargePairVec)
-            {
-                unsigned wire = hitPair.first.first->WireID().Wire;
-
-                usedWiresSet.insert(wire);
+        for(size_t trackIdx = 0; trackIdx < trackPurityVec.size(); trackIdx++)
+        {
+            if (!trackPurityVec[trackIdx]) continue;
 
-                if (wire > maxWire) maxWire = wire;
-                if (wire < minWire) minWire = wire;
-            }
+            TrackPurity& trackPurity = *trackPurityVec[trackIdx];
 
-            geo::WireID wireID  = hitStatusChargePairVec.front().first.first->WireID();
-			  
-			anab::TPCPurityInfo purityInfo;
+            anab::TPCPurityInfo& purityInfo = trackPurity.purityInfo;
 
-			purityInfo.Run         = event.run();
-			purityInfo.Subrun      = event.subRun();
-			purityInfo.Event       = event.event();
-            purityInfo.Cryostat    = wireID.Cryostat;
-			purityInfo.TPC         = wireID.TPC;
-			purityInfo.Wires       = usedWiresSet.size(); //maxWire - minWire;
-            purityInfo.Ticks       = hitStatusChargePairVec.back().first.first->PeakTime() - firstHitTime;
-            purityInfo.Attenuation = -attenuation;
-			purityInfo.FracError   = std::sqrt(pca.getEigenValues()[0] / pca.getEigenValues()[1]);
+            purityInfo.Run    = event.run();
+            purityInfo.Subrun = event.subRun();
+            purityInfo.Event  = event.event();
 
             outputPtrVector->emplace_back(purityInfo);
 
             if (fDiagnosticTuple)
             {
-                fRunNumber    = event.run();
-                fSubRunNumber = event.subRun();
-                fEventNumber  = event.event();
-                fCryostat     = wireID.Cryostat;
-                fTPC          = wireID.TPC;
-                fTrackIdx     = trackIdx; 
-                fWireRange    = maxWire - minWire;
-                fWires        = usedWiresSet.size();
-                fTicks        = hitStatusChargePairVec.back().first.first->PeakTime() - firstHitTime;
-                fAttenuation  = -attenuation;
-                fError        = std::sqrt(pca.getEigenValues()[0] / pca.getEigenValues()[1]);
-
-                // Test putting this back into track index order
-                std::sort(hitStatusChargePairVec.begin(),hitStatusChargePairVec.end(),[](const auto& left,const auto& right){return left.first.second->Index() < right.first.second->Index();});
-
-                const geo::Point_t& trackStartPos = track->LocationAtPoint(hitStatusChargePairVec.front().first.second->Index());
-                const geo::Vector_t trackStartDir = track->DirectionAtPoint(hitStatusChargePairVec.front().first.second->Index());
-
-                fTrackStartXVec.emplace_back(trackStartPos.X());
-                fTrackStartYVec.emplace_back(trackStartPos.Y());
-                fTrackStartZVec.emplace_back(trackStartPos.Z());
-                fTrackDirXVec.emplace_back(trackStartDir.X());
-                fTrackDirYVec.emplace_back(trackStartDir.Y());
-                fTrackDirZVec.emplace_back(trackStartDir.Z());
-
-                const geo::Point_t& trackEndPos = track->LocationAtPoint(hitStatusChargePairVec.back().first.second->Index());
-                const geo::Vector_t trackEndDir = track->DirectionAtPoint(hitStatusChargePairVec.back().first.second->Index());
-
-                fTrackEndXVec.emplace_back(trackEndPos.X());
-                fTrackEndYVec.emplace_back(trackEndPos.Y());
-                fTrackEndZVec.emplace_back(trackEndPos.Z());
-                fTrackEndDirXVec.emplace_back(trackEndDir.X());
-                fTrackEndDirYVec.emplace_back(trackEndDir.Y());
-                fTrackEndDirZVec.emplace_back(trackEndDir.Z());
-
-                // 2D PCA of time vs charge
-                for(size_t rowIdx = 0; rowIdx < 2; rowIdx++)
-                {
-                    for(size_t colIdx = 0; colIdx < 2; colIdx++) fPCAAxes2D.emplace_back(eigenVectors.row(rowIdx)[colIdx]);
-                }
-
-                fEigenValues2D.emplace_back(pca.getEigenValues()[0]); 
-                fEigenValues2D.emplace_back(pca.getEigenValues()[1]); 
-
-                fMeanPosition2D.emplace_back(pca.getAvePosition()[0]);
-                fMeanPosition2D.emplace_back(pca.getAvePosition()[1]);
-
-                // 3D PCA of track trajectory points
-                const PrincipalComponents3D::EigenVectors& eigenVectors3D = pca3D.getEigenVectors();
-
-                for(size_t rowIdx = 0; rowIdx < 3; rowIdx++)
-                {
-                    for(size_t colIdx = 0; colIdx < 3; colIdx++) fPCAAxes3D.emplace_back(eigenVectors3D.row(rowIdx)[colIdx]);
-                }
-
-                fEigenValues3D.emplace_back(pca3D.getEigenValues()[0]); 
-                fEigenValues3D.emplace_back(pca3D.getEigenValues()[1]); 
-                fEigenValues3D.emplace_back(pca3D.getEigenValues()[2]); 
-
-                fMeanPosition3D.emplace_back(pca3D.getAvePosition()[0]);
-                fMeanPosition3D.emplace_back(pca3D.getAvePosition()[1]);
-                fMeanPosition3D.emplace_back(pca3D.getAvePosition()[2]);
-
-                for(const auto& hitPair : hitStatusChargePairVec)
-                {
-                    fTickVec.emplace_back(hitPair.first.first->PeakTime());
-                    fChargeVec.emplace_back(hitPair.second.second);
-                    fDeltaXVec.emplace_back(hitPair.first.second->Dx());
-                    fGoodnessOfFitVec.emplace_back(hitPair.first.first->GoodnessOfFit());
-                    fDegreesOfFreeVec.emplace_back(hitPair.first.first->DegreesOfFreedom());
-                    fSnippetLengthVec.emplace_back(hitPair.first.first->EndTick() - hitPair.first.first->StartTick());
-                    fGoodHitVec.emplace_back(hitPair.second.first);
-
-                    // Want the cos(theta_yz) for this hit
-                    const geo::Vector_t& hitDir  = std::get<1>(hitPointDirTupleMap[hitPair.first.first.get()]);
-                    const geo::Vector_t& wireDir = std::get<2>(hitPointDirTupleMap[hitPair.first.first.get()]);
-
-                    // Wire will already be in the YZ plane, but need to project hitDir to that plane
-                    geo::Vector_t hitDirYZ(0.,hitDir.Y(),hitDir.Z());
-
-                    hitDirYZ /= std::sqrt(hitDirYZ.Mag2());
-
-                    fCosThetaYZ.emplace_back(hitDirYZ.Dot(wireDir));
-                }
+                fDiagnostics = std::move(trackPurity.diagnostics);
 
-                fDiagnosticTree->Fill();
+                fDiagnostics.fRunNumber    = event.run();
+                fDiagnostics.fSubRunNumber = event.subRun();
+                fDiagnostics.fEventNumber  = event.event();
+                fDiagnostics.fTrackIdx     = trackIdx;
 
-                fTrackStartXVec.clear();
-                fTrackStartYVec.clear();
-                fTrackStartZVec.clear();
-                fTrackDirXVec.clear();
-                fTrackDirYVec.clear();
-                fTrackDirZVec.clear();
-                fTrackEndXVec.clear();
-                fTrackEndYVec.clear();
-                fTrackEndZVec.clear();
-                fTrackEndDirXVec.clear();
-                fTrackEndDirYVec.clear();
-                fTrackEndDirZVec.clear();
-                fPCAAxes2D.clear(); 
-                fEigenValues2D.clear(); 
-                fMeanPosition2D.clear();
-                fPCAAxes3D.clear(); 
-                fEigenValues3D.clear(); 
-                fMeanPosition3D.clear();
-                fTickVec.clear(); 
-                fChargeVec.clear();
-                fDeltaXVec.clear();
-                fGoodnessOfFitVec.clear();
-                fDegreesOfFreeVec.clear();
-                fSnippetLengthVec.clear();
-                fGoodHitVec.clear();
-                fCosThetaYZ.clear();
+                fDiagnosticTree->Fill();
             }
         }
     }
@@ -751,215 +536,238 @@ double TPCPurityMonitor::projectedLength(const recob::Track* track)
     return result;
 }
 
-
-void TPCPurityMonitor::GetPrincipalComponents2D(const HitStatusChargePairVec& hitPairVector, PrincipalComponents2D& pca) const
+bool TPCPurityMonitor::ProcessTrack(const recob::Track&  track,
+                                    const HitMetaPair*   firstHit,
+                                    const HitMetaPair*   lastHit,
+                                    TrackScratch&        scratch,
+                                    TrackPurity&         trackPurity) const
 {
-    // Run through the HitPairList and get the mean position of all the hits
-    Eigen::Vector2d meanPos(Eigen::Vector2d::Zero());
-    double          meanWeightSum(0.);
-    int             numPairsInt(0);
+    // Focus on selected hits:
+    // 1) Pick out hits on a single plane given by fhicl parameter
+    // 2) multiplicity == 1 which should give us clean gaussian shaped pulses
+    HitMetaPairVec&        selectedHitMetaVec = scratch.selectedHitMetaVec;
+    std::vector<unsigned>& tpcHitCounts       = scratch.tpcHitCounts;
 
-    float startTime = 0.; //hitPairVector.front().first->PeakTime();
+    selectedHitMetaVec.clear();
+    tpcHitCounts.clear();
 
-    for (const auto& hitPair : hitPairVector) 
+    for(const HitMetaPair* hitMetaItr = firstHit; hitMetaItr != lastHit; hitMetaItr++)
     {
-        if (!hitPair.second.first) continue;
+        const recob::Hit* hit = hitMetaItr->first;
 
-        const recob::Hit* hit = hitPair.first.first.get();
+        if (hit->WireID().Plane != fSelectedPlane || hit->Multiplicity() != 1) continue;
 
-        // Weight the hit by the peak time difference significance
-        double weight = fWeightByChiSq ? 1./hit->GoodnessOfFit() : 1.; 
+        selectedHitMetaVec.emplace_back(*hitMetaItr);
 
-        meanPos(0) += fSamplingRate * (hit->PeakTime() - startTime) * weight;
-        meanPos(1) += std::log(hitPair.second.second) * weight;
-        numPairsInt++;
+        if (hit->WireID().TPC >= tpcHitCounts.size()) tpcHitCounts.resize(hit->WireID().TPC + 1, 0);
 
-        meanWeightSum += weight;
+        tpcHitCounts[hit->WireID().TPC]++;
     }
 
-    meanPos /= meanWeightSum;
+    if (selectedHitMetaVec.empty()) return false;
 
-    // Define elements of our covariance matrix
-    double xi2(0.);
-    double xiyi(0.);
-    double yi2(0.0);
-    double weightSum(0.);
+    // Currently we need to limit the analysis to a single TPC and we have tracks which may have been stitched across the cathode... 
+    // For now, we search and find the TPC with the most hits
+    unsigned bestTPC = std::distance(tpcHitCounts.begin(), std::max_element(tpcHitCounts.begin(), tpcHitCounts.end()));
 
-    // Back through the hits to build the matrix
-    for (const auto& hitPair : hitPairVector) 
-    {
-        if (!hitPair.second.first) continue;
+    // Need a minimum number of hits
+    if (tpcHitCounts[bestTPC] < fMinNumHits) return false;
 
-        const recob::Hit* hit = hitPair.first.first.get();
+    selectedHitMetaVec.erase(std::remove_if(selectedHitMetaVec.begin(),selectedHitMetaVec.end(),[bestTPC](const auto& hitMetaPair){return hitMetaPair.first->WireID().TPC != bestTPC;}),selectedHitMetaVec.end());
 
-        double weight = fWeightByChiSq ? 1./hit->GoodnessOfFit() : 1.;
+    // Sort hits by increasing time 
+    std::sort(selectedHitMetaVec.begin(),selectedHitMetaVec.end(),[](const auto& left, const auto& right){return left.first->PeakTime() < right.first->PeakTime();});
 
-        double x = (fSamplingRate * (hit->PeakTime() - startTime) - meanPos(0)) * weight;
-        double y = (std::log(hitPair.second.second) - meanPos(1)) * weight;
+    // Require track to have a minimum range in ticks
+    if (selectedHitMetaVec.back().first->PeakTime() - selectedHitMetaVec.front().first->PeakTime() < fMinTickRange) return false;
 
-        weightSum += weight * weight;
+    // At this point we should have a vector of pointers to hits on the selected plane
+    // So we should be able to now transition to computing the attenuation
+    // Start by forming a vector of the time (in ticks) and the ln of charge derated by an assumed lifetime
+    TrackHitVec&                    trackHitVec = scratch.trackHitVec;
+    icarus::purity::LifetimeFitter& fitter      = scratch.fitter;
 
-        xi2  += x * x;
-        xiyi += x * y;
-        yi2  += y * y;
-    }
+    trackHitVec.clear();
+    fitter.clear();
 
-    // Using Eigen package
-    Eigen::Matrix2d sig;
+    float  firstHitTime(selectedHitMetaVec.front().first->PeakTime());
+    double maxDeltaX(1.5);   // Assume a "long hit" would be no more than 1.5 cm in length
+    double wirePitch(0.3);
 
-    sig << xi2, xiyi, xiyi, yi2;
+    for(const auto& hitMetaPair: selectedHitMetaVec)
+    {
+        const recob::Hit* hit         = hitMetaPair.first;
+        unsigned int      trkHitIndex = hitMetaPair.second->Index();
+        double            deltaX      = 0.3;                         // Set this to 3 mm just in case no corresponding point
+        double            cosTheta    = -100.;
 
-    sig *= 1. / weightSum;
+        if (trkHitIndex != std::numeric_limits<unsigned int>::max() && track.HasValidPoint(trkHitIndex))
+        {
+            geo::Point_t        hitPos  = track.LocationAtPoint(trkHitIndex);
+            geo::Vector_t       hitDir  = track.DirectionAtPoint(trkHitIndex);
+            const geo::WireGeo& wireGeo = fGeometry->Wire(hit->WireID());
+            geo::Vector_t       wireDir(wireGeo.Direction()[0],wireGeo.Direction()[1],wireGeo.Direction()[2]);
 
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eigenMat(sig);
+            cosTheta = std::abs(hitDir.Dot(wireDir));
 
-    if (eigenMat.info() == Eigen::ComputationInfo::Success) 
-    {
-        // Now copy outputPrincipalCo
-        // The returned eigen values and vectors will be returned in an xyz system where x is the smallest spread,
-        // y is the next smallest and z is the largest. Adopt that convention going forward
-        PrincipalComponents2D::EigenValues  eigenVals = eigenMat.eigenvalues();
-        PrincipalComponents2D::EigenVectors eigenVecs = eigenMat.eigenvectors().transpose();
-
-        // Store away
-        // NOTE: the major axis will be the second entry, the minor axis will be the first
-        pca = PrincipalComponents2D(true, numPairsInt, eigenVals, eigenVecs, meanPos);
+            if (cosTheta < 1.)
+            {
+                deltaX = std::min(wirePitch / (1. - cosTheta), maxDeltaX);
+            }
+            else deltaX = maxDeltaX;
+
+            double charge = fUseHitIntegral ? hit->Integral() : hit->SummedADC(); 
+
+            // Weight the hit by the peak time difference significance
+            double weight = fWeightByChiSq ? 1./hit->GoodnessOfFit() : 1.; 
+
+            trackHitVec.push_back({hit, hitMetaPair.second, charge/deltaX, hitPos, hitDir, wireDir});
+            fitter.addPoint(fSamplingRate * hit->PeakTime(), charge/deltaX, weight);
+        }
     }
-    else 
+
+    size_t numOrig   = trackHitVec.size();
+    size_t lowCutIdx = fMinRejectFraction * numOrig;
+    size_t hiCutIdx  = fMaxRejectFraction * numOrig;
+
+    // Will require a minimum number of hits left over to proceed
+    if (lowCutIdx + 10 >= hiCutIdx)
     {
-        mf::LogDebug("Cluster3D") << "PCA decompose failure, numPairs = " << numPairsInt << std::endl;
-        pca = PrincipalComponents2D();
+        mf::LogDebug("TPCPurityMonitor") << "*****>>>> lowCutIdx >= hiCutIdx: " << lowCutIdx << ", " << hiCutIdx << std::endl;
+        return false;
     }
 
-    return;
-}
+    // Tag the leading and trailing hits so as to not use them
+    fitter.keepRange(lowCutIdx, hiCutIdx);
 
-void TPCPurityMonitor::GetPrincipalComponents3D(const HitStatusChargePairVec& hitPairVector, HitPointDirTupleMap& hitPointDirTupleMap, PrincipalComponents3D& pca) const
-{
-    // Run through the HitPairList and get the mean position of all the hits
-    Eigen::Vector3d meanPos(Eigen::Vector3d::Zero());
-    double          meanWeightSum(0.);
-    int             numPairsInt(0);
+    PrincipalComponents2D pca = fitter.principalComponents();
 
-    for (const auto& hitPair : hitPairVector) 
-    {
-        if (!hitPair.second.first) continue;
+    // Reject the outliers
+    fitter.rejectOutliers(pca, fOutlierRejectFrac);
 
-        const recob::Hit* hit = hitPair.first.first.get();
+    // Recompute the pca
+    pca = fitter.principalComponents();
 
-        geo::Point_t hitPos = std::get<0>(hitPointDirTupleMap[hit]);
+    // If the PCA faild then we should bail out 
+    if (!pca.ok)
+    {
+        mf::LogDebug("TPCPurityMonitor") << "PCA decompose failure, numPairs = " << pca.nPoints << std::endl;
+        return false;
+    }
 
-        // Weight the hit by the peak time difference significance
-        double weight = fWeightByChiSq ? 1./hit->GoodnessOfFit() : 1.; 
+    double attenuation = icarus::purity::LifetimeFitter::attenuationSlope(pca);
+    double fracError   = std::sqrt(pca.values[0] / pca.values[1]);
 
-        meanPos += Eigen::Vector3d(hitPos.X(),hitPos.Y(),hitPos.Z());
+    // Want to find the wire range (or should it be the number of wires?)
+    std::vector<unsigned>& wireVec = scratch.wireVec;
 
-        numPairsInt++;
+    wireVec.clear();
 
-        meanWeightSum += weight;
-    }
+    for(const auto& trackHit : trackHitVec) wireVec.push_back(trackHit.hit->WireID().Wire);
 
-    meanPos /= meanWeightSum;
+    std::sort(wireVec.begin(),wireVec.end());
 
-    // Define elements of our covariance matrix
-    double xi2(0.);
-    double xiyi(0.);
-    double xizi(0.);
-    double yi2(0.);
-    double yizi(0.);
-    double zi2(0.);
-    double weightSum(0.);
+    unsigned minWire   = wireVec.front();
+    unsigned maxWire   = wireVec.back();
+    unsigned usedWires = std::distance(wireVec.begin(),std::unique(wireVec.begin(),wireVec.end()));
 
-    // Back through the hits to build the matrix
-    for (const auto& hitPair : hitPairVector) 
-    {
-        if (!hitPair.second.first) continue;
+    geo::WireID wireID = trackHitVec.front().hit->WireID();
+    int         ticks  = trackHitVec.back().hit->PeakTime() - firstHitTime;
 
-        const recob::Hit* hit = hitPair.first.first.get();
+    anab::TPCPurityInfo& purityInfo = trackPurity.purityInfo;
 
-        double weight = fWeightByChiSq ? 1./hit->GoodnessOfFit() : 1.;
+    purityInfo.Cryostat    = wireID.Cryostat;
+    purityInfo.TPC         = wireID.TPC;
+    purityInfo.Wires       = usedWires; //maxWire - minWire;
+    purityInfo.Ticks       = trackHitVec.back().hit->PeakTime() - firstHitTime;
+    purityInfo.Attenuation = -attenuation;
+    purityInfo.FracError   = fracError;
 
-        geo::Point_t    hitPos         = std::get<0>(hitPointDirTupleMap[hit]);
-        Eigen::Vector3d weightedHitPos = Eigen::Vector3d(hitPos.X(),hitPos.Y(),hitPos.Z()) - meanPos;
+    if (!fDiagnosticTuple) return true;
 
-        weightSum += weight * weight;
+    DiagnosticTupleData& diagnostics = trackPurity.diagnostics;
 
-        xi2  += weightedHitPos[0] * weightedHitPos[0];
-        xiyi += weightedHitPos[0] * weightedHitPos[1];
-        xizi += weightedHitPos[0] * weightedHitPos[2];
-        yi2  += weightedHitPos[1] * weightedHitPos[1];
-        yizi += weightedHitPos[1] * weightedHitPos[2];
-        zi2  += weightedHitPos[2] * weightedHitPos[2];
-    }
+    diagnostics.fCryostat    = wireID.Cryostat;
+    diagnostics.fTPC         = wireID.TPC;
+    diagnostics.fWireRange   = maxWire - minWire;
+    diagnostics.fWires       = usedWires;
+    diagnostics.fTicks       = ticks;
+    diagnostics.fAttenuation = -attenuation;
+    diagnostics.fError       = fracError;
 
-    // Using Eigen package
-    Eigen::Matrix3d sig;
+    // Now get the 3D PCA of the track trajectory points of the good hits
+    PrincipalComponents3D pca3D = icarus::purity::computePrincipalComponents<3>(trackHitVec.size(),
+        [&trackHitVec](size_t idx){const geo::Point_t& pos = trackHitVec[idx].position; return std::array<double,3>{pos.X(),pos.Y(),pos.Z()};},
+        [this,&trackHitVec](size_t idx){return fWeightByChiSq ? 1./trackHitVec[idx].hit->GoodnessOfFit() : 1.;},
+        [&fitter](size_t idx){return fitter.isGood(idx);});
 
-    sig << xi2, xiyi, xizi, xiyi, yi2, yizi, xizi, yizi, zi2;
+    // Test putting this back into track index order
+    std::vector<size_t>& indexOrder = scratch.indexOrder;
 
-    sig *= 1. / weightSum;
+    indexOrder.resize(trackHitVec.size());
+    std::iota(indexOrder.begin(),indexOrder.end(),0);
+    std::sort(indexOrder.begin(),indexOrder.end(),[&trackHitVec](size_t left, size_t right){return trackHitVec[left].meta->Index() < trackHitVec[right].meta->Index();});
 
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigenMat(sig);
+    const geo::Point_t& trackStartPos = track.LocationAtPoint(trackHitVec[indexOrder.front()].meta->Index());
+    const geo::Vector_t trackStartDir = track.DirectionAtPoint(trackHitVec[indexOrder.front()].meta->Index());
 
-    if (eigenMat.info() == Eigen::ComputationInfo::Success) 
-    {
-        // Now copy outputPrincipalCo
-        // The returned eigen values and vectors will be returned in an xyz system where x is the smallest spread,
-        // y is the next smallest and z is the largest. Adopt that convention going forward
-        PrincipalComponents3D::EigenValues  eigenVals = eigenMat.eigenvalues();
-        PrincipalComponents3D::EigenVectors eigenVecs = eigenMat.eigenvectors().transpose();
-
-        // Store away
-        // NOTE: the major axis will be the second entry, the minor axis will be the first
-        pca = PrincipalComponents3D(true, numPairsInt, eigenVals, eigenVecs, meanPos);
-    }
-    else 
-    {
-        mf::LogDebug("Cluster3D") << "PCA decompose failure, numPairs = " << numPairsInt << std::endl;
-        pca = PrincipalComponents3D();
-    }
+    diagnostics.fTrackStartXVec.emplace_back(trackStartPos.X());
+    diagnostics.fTrackStartYVec.emplace_back(trackStartPos.Y());
+    diagnostics.fTrackStartZVec.emplace_back(trackStartPos.Z());
+    diagnostics.fTrackDirXVec.emplace_back(trackStartDir.X());
+    diagnostics.fTrackDirYVec.emplace_back(trackStartDir.Y());
+    diagnostics.fTrackDirZVec.emplace_back(trackStartDir.Z());
 
-    return;
-}
+    const geo::Point_t& trackEndPos = track.LocationAtPoint(trackHitVec[indexOrder.back()].meta->Index());
+    const geo::Vector_t trackEndDir = track.DirectionAtPoint(trackHitVec[indexOrder.back()].meta->Index());
 
-void TPCPurityMonitor::RejectOutliers(HitStatusChargePairVec& hitPairVector, const PrincipalComponents2D& pca) const
-{
-    double                 slope  = pca.getEigenVectors().row(1)[1] / pca.getEigenVectors().row(1)[0];
-    const Eigen::Vector2d& avePos = pca.getAvePosition(); 
+    diagnostics.fTrackEndXVec.emplace_back(trackEndPos.X());
+    diagnostics.fTrackEndYVec.emplace_back(trackEndPos.Y());
+    diagnostics.fTrackEndZVec.emplace_back(trackEndPos.Z());
+    diagnostics.fTrackEndDirXVec.emplace_back(trackEndDir.X());
+    diagnostics.fTrackEndDirYVec.emplace_back(trackEndDir.Y());
+    diagnostics.fTrackEndDirZVec.emplace_back(trackEndDir.Z());
 
-    using HitPairDeltaLogChargePair    = std::pair<HitStatusChargePair*,double>;
-    using HitPairDeltaLogChargePairVec = std::vector<HitPairDeltaLogChargePair>;
+    // 2D PCA of time vs charge
+    for(size_t rowIdx = 0; rowIdx < 2; rowIdx++)
+    {
+        for(size_t colIdx = 0; colIdx < 2; colIdx++) diagnostics.fPCAAxes2D.emplace_back(pca.vectors[rowIdx][colIdx]);
 
-    HitPairDeltaLogChargePairVec hitPairDeltaLogChargePairVec;
+        diagnostics.fEigenValues2D.emplace_back(pca.values[rowIdx]); 
+        diagnostics.fMeanPosition2D.emplace_back(pca.mean[rowIdx]);
+    }
 
-    for(auto& hitPair : hitPairVector)
+    // 3D PCA of track trajectory points
+    for(size_t rowIdx = 0; rowIdx < 3; rowIdx++)
     {
-        // We are only interested in the "good" hits here
-        if (hitPair.second.first)
-        {
-            double predLogCharge  = (fSamplingRate * hitPair.first.first->PeakTime() - avePos[0]) * slope + avePos[1];
-            double deltaLogCharge = std::log(hitPair.second.second) - predLogCharge;
+        for(size_t colIdx = 0; colIdx < 3; colIdx++) diagnostics.fPCAAxes3D.emplace_back(pca3D.vectors[rowIdx][colIdx]);
 
-            hitPairDeltaLogChargePairVec.emplace_back(&hitPair,deltaLogCharge);
-        }
+        diagnostics.fEigenValues3D.emplace_back(pca3D.values[rowIdx]); 
+        diagnostics.fMeanPosition3D.emplace_back(pca3D.mean[rowIdx]);
     }
 
-    // Sort hits by their deviation from the prediction
-    std::sort(hitPairDeltaLogChargePairVec.begin(),hitPairDeltaLogChargePairVec.end(),[](const auto& left, const auto& right){return left.second < right.second;});
+    for(size_t idx : indexOrder)
+    {
+        const TrackHit& trackHit = trackHitVec[idx];
 
-    // Go through and tag those we are rejecting
-    size_t loRejectIdx = 0.01 * hitPairDeltaLogChargePairVec.size();
-    size_t hiRejectIdx = fOutlierRejectFrac * hitPairDeltaLogChargePairVec.size();
+        diagnostics.fTickVec.emplace_back(trackHit.hit->PeakTime());
+        diagnostics.fChargeVec.emplace_back(trackHit.charge);
+        diagnostics.fDeltaXVec.emplace_back(trackHit.meta->Dx());
+        diagnostics.fGoodnessOfFitVec.emplace_back(trackHit.hit->GoodnessOfFit());
+        diagnostics.fDegreesOfFreeVec.emplace_back(trackHit.hit->DegreesOfFreedom());
+        diagnostics.fSnippetLengthVec.emplace_back(trackHit.hit->EndTick() - trackHit.hit->StartTick());
+        diagnostics.fGoodHitVec.emplace_back(fitter.isGood(idx));
 
-    const double outlierReject = 0.75;
+        // Want the cos(theta_yz) for this hit
+        // Wire will already be in the YZ plane, but need to project hitDir to that plane
+        geo::Vector_t hitDirYZ(0.,trackHit.direction.Y(),trackHit.direction.Z());
 
-    for(size_t idx = 0; idx < hitPairDeltaLogChargePairVec.size(); idx++)
-    {
-        if (idx < loRejectIdx || idx > hiRejectIdx)                    hitPairDeltaLogChargePairVec[idx].first->second.first = false;
-        if (hitPairDeltaLogChargePairVec[idx].second < -outlierReject) hitPairDeltaLogChargePairVec[idx].first->second.first = false;
+        hitDirYZ /= std::sqrt(hitDirYZ.Mag2());
+
+        diagnostics.fCosThetaYZ.emplace_back(hitDirYZ.Dot(trackHit.wireDir));
     }
 
-    return;
+    return true;
 }
 
 
@@ -9,6 +9,8 @@
 // from cetlib version v3_07_02.
 /////////////////////////////////////////////////////////////////////////////////
 
+#include "icaruscode/Analysis/tools/SimChannelTruthIndex.h"
+
 #include "art/Framework/Core/EDAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
@@ -516,8 +518,10 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
 
     int ntrk_reco = 0;
 
-    art::Handle< std::vector<sim::SimChannel>> simChannelHandle;
-    evt.getByLabel(fSimChannelProducerLabel, simChannelHandle);
+    // The truth index relates particles (track id's) to the channels and tdc ranges where they deposit energy (or
+    // electrons), and to their MCParticle; it is built once for this event
+    std::unique_ptr<const icarus::SimChannelTruthIndex> truthIndex =
+        icarus::SimChannelTruthIndex::forEvent(evt, fSimChannelProducerLabel, fMCParticleProducerLabel);
 
     
     art::Handle< std::vector<simb::MCParticle>> mcParticleHandle;
@@ -529,7 +533,7 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
     //fElectronsToGeV = 1./larParameters->GeVToElectrons();
 
     // If there is no sim channel informaton then exit
-    if (!simChannelHandle.isValid() || simChannelHandle->empty() || 
+    if (!truthIndex                 || truthIndex->nSimChannels() == 0 || 
         !simEnergyHandle.isValid()  || simEnergyHandle->empty()  ||
         !mcParticleHandle.isValid() ) return;
 
@@ -538,24 +542,6 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
 	      << " SubRun: "<< fSubRun<< std::endl;
     */
   
-    // There are several things going on here... for each channel we have particles (track id's) depositing energy in a range to ticks
-    // So... for each channel we want to build a structure that relates particles to tdc ranges and deposited energy (or electrons)
-    // Here is a complicated structure:
-    using TDCToIDEMap             = std::map<unsigned short, sim::IDE>; // We need this one in order
-    using ChanToTDCToIDEMap       = std::map<raw::ChannelID_t, TDCToIDEMap>;
-    using PartToChanToTDCToIDEMap = std::unordered_map<int, ChanToTDCToIDEMap>;
-
-    PartToChanToTDCToIDEMap partToChanToTDCToIDEMap;
-  
-    // Build out the above data structure
-    for(const auto& simChannel : *simChannelHandle)
-    {
-        for(const auto& tdcide : simChannel.TDCIDEMap())
-        {
-            for(const auto& ide : tdcide.second) partToChanToTDCToIDEMap[ide.trackID][simChannel.Channel()][tdcide.first] = ide;
-        }
-    }
-
     // Here we make a map between track ID and associatied SimEnergyDeposit objects
     // We'll need this for sorting out the track direction at each hit
     using SimEnergyDepositVec = std::vector<const sim::SimEnergyDeposit*>;
@@ -590,14 +576,6 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
 
     HitToMCPartToIdxMap hitToMcPartToIdxMap;
     
-    // It is useful to create a mapping between trackID and MCParticle
-    using TrackIDToMCParticleMap = std::unordered_map<int, const simb::MCParticle*>;
-    
-    TrackIDToMCParticleMap trackIDToMCParticleMap;
-    
-    for(const auto& mcParticle : *mcParticleHandle)
-        trackIDToMCParticleMap[mcParticle.TrackId()] = &mcParticle;
-    
     const lariov::ChannelStatusProvider& chanFilt = art::ServiceHandle<lariov::ChannelStatusService>()->GetProvider();
 
     // Look up the list of bad channels
@@ -610,18 +588,16 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
     std::vector<int> nSimulatedWiresVec = {0,0,0};
 
     std::cout << "***************** EVENT " << fEvent << " ******************" << std::endl;
-    std::cout << "-- Looping over channels for hit efficiency, # MC Track IDs: " << partToChanToTDCToIDEMap.size() << std::endl;
+    std::cout << "-- Looping over channels for hit efficiency, # MC Track IDs: " << truthIndex->tracks().size() << std::endl;
 
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
 
     // Initiate loop over MC Track IDs <--> SimChannel information by wire and TDC
-    for(const auto& partToChanInfo : partToChanToTDCToIDEMap)
+    for(const auto& trackDeposits : truthIndex->tracks())
     {
-        TrackIDToMCParticleMap::const_iterator trackIDToMCPartItr = trackIDToMCParticleMap.find(partToChanInfo.first);
-    
-        if (trackIDToMCPartItr == trackIDToMCParticleMap.end()) continue;
+        const simb::MCParticle* mcParticle = truthIndex->particle(trackDeposits.trackID);
     
-        const simb::MCParticle* mcParticle = trackIDToMCPartItr->second;
+        if (!mcParticle) continue;
 
         int         trackPDGCode = mcParticle->PdgCode();
         std::string processName  = mcParticle->Process();
@@ -634,7 +610,7 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
         std::cout << ">>>> Loop on MCParticle: " << mcParticle << ", pdg: " << trackPDGCode << ", process: " << processName << std::endl;
 
         // Let's recover the SimEnergyDeposit vector for this track
-//        PartToSimEnergyMap::iterator simEneDepItr = partToSimEnergyMap.find(partToChanInfo.first);
+//        PartToSimEnergyMap::iterator simEneDepItr = partToSimEnergyMap.find(trackDeposits.trackID);
 
 //        if (simEneDepItr == partToSimEnergyMap.end())
 //        {
@@ -647,7 +623,7 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
 
 //        std::sort(simEnergyDepositVec.begin(),simEnergyDepositVec.end(),[](const auto& left,const auto& right){return left->T() < right->T();});
 
-//        std::cout << "  -- Processing track id: " << partToChanInfo.first << ", with " << simEnergyDepositVec.size() << " SimEnergyDeposit objects" << ", # channels: " << partToChanInfo.second.size() << std::endl;
+//        std::cout << "  -- Processing track id: " << trackDeposits.trackID << ", with " << simEnergyDepositVec.size() << " SimEnergyDeposit objects" << ", # channels: " << trackDeposits.channels.size() << std::endl;
       
         fSimPDG = trackPDGCode;
         fSimTrackID = mcParticle->TrackId();
@@ -675,19 +651,19 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
           // then we want to keep a running position
         std::vector<Eigen::Vector3f> lastPositionVec = {partStartPos,partStartPos,partStartPos};
 
-        std::cout << "  *** Looping over channels, have " << partToChanInfo.second.size() << " channels" << std::endl;
+        std::cout << "  *** Looping over channels, have " << trackDeposits.channels.size() << " channels" << std::endl;
 
-        for(const auto& chanToTDCToIDEMap : partToChanInfo.second)
+        for(const auto& chanDeposits : trackDeposits.channels)
         {
     	        // skip bad channels
             if (fUseBadChannelDB)
             {
     	          // This is the "correct" way to check and remove bad channels...
-                if( chanFilt.Status(chanToTDCToIDEMap.first) < fMinAllowedChanStatus)
+                if( chanFilt.Status(chanDeposits.channel) < fMinAllowedChanStatus)
                 {
-                    std::vector<geo::WireID> wids = fGeometry->ChannelToWire(chanToTDCToIDEMap.first);
-                    std::cout << "*** skipping bad channel with status: " << chanFilt.Status(chanToTDCToIDEMap.first) 
-                          << " for channel: "                         << chanToTDCToIDEMap.first 
+                    std::vector<geo::WireID> wids = fGeometry->ChannelToWire(chanDeposits.channel);
+                    std::cout << "*** skipping bad channel with status: " << chanFilt.Status(chanDeposits.channel) 
+                          << " for channel: "                         << chanDeposits.channel 
                           << ", plane: "                              << wids[0].Plane 
                           << ", wire: "                               << wids[0].Wire    << std::endl;
                           continue;
@@ -698,12 +674,12 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
     	      // If so then we try that
             if (badChannelHandle.isValid())
             {
-                std::vector<int>::const_iterator badItr = std::find(badChannelHandle->begin(),badChannelHandle->end(),chanToTDCToIDEMap.first);
+                std::vector<int>::const_iterator badItr = std::find(badChannelHandle->begin(),badChannelHandle->end(),chanDeposits.channel);
     
                 if (badItr != badChannelHandle->end()) continue;
             }
      
-            TDCToIDEMap    tdcToIDEMap = chanToTDCToIDEMap.second;
+            const icarus::SimChannelTruthIndex::DepositRange& tdcDeposits = chanDeposits.deposits;
             float          totalElectrons(0.);
             float          totalEnergy(0.);
             float          maxElectrons(0.);
@@ -713,7 +689,7 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
             
         	     // The below try-catch block may no longer be necessary
         	     // Decode the channel and make sure we have a valid one
-            std::vector<geo::WireID> wids = fGeometry->ChannelToWire(chanToTDCToIDEMap.first);
+            std::vector<geo::WireID> wids = fGeometry->ChannelToWire(chanDeposits.channel);
         
         	  // Recover plane and wire in the plane
             unsigned int plane = wids[0].Plane;
@@ -723,23 +699,23 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
             
 	    nSimulatedWiresVec[plane]++;  // Loop insures channels are unique here
             
-            for(const auto& ideVal : tdcToIDEMap)
+            for(const auto& ideVal : tdcDeposits)
             {
-                totalElectrons += ideVal.second.numElectrons;
-                totalEnergy    += ideVal.second.energy;
+                totalElectrons += ideVal.ide->numElectrons;
+                totalEnergy    += ideVal.ide->energy;
         
-                if (maxElectrons < ideVal.second.numElectrons)
+                if (maxElectrons < ideVal.ide->numElectrons)
                 {
-                    maxElectrons    = ideVal.second.numElectrons;
-                    maxElectronsTDC = ideVal.first;
+                    maxElectrons    = ideVal.ide->numElectrons;
+                    maxElectronsTDC = ideVal.tdc;
                 }
         
-                avePosition += Eigen::Vector3f(ideVal.second.x,ideVal.second.y,ideVal.second.z);
+                avePosition += Eigen::Vector3f(ideVal.ide->x,ideVal.ide->y,ideVal.ide->z);
             }
         
     	      // Get local track direction by using the average position of deposited charge as the current position
     	      // and then subtracting the last position
-            avePosition /= float(tdcToIDEMap.size());
+            avePosition /= float(tdcDeposits.size());
     
             Eigen::Vector3f partDirVec = avePosition - lastPositionVec[plane];
     
@@ -756,8 +732,8 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
             
             //nSimChannelHitVec[plane]++;
             	  //	  std::cout << "after the check --- line 469   "<< nSimChannelHitVec[plane] << std::endl; 	    
-            unsigned short startTDC = tdcToIDEMap.begin()->first;
-            unsigned short stopTDC  = tdcToIDEMap.rbegin()->first;
+            unsigned short startTDC = tdcDeposits.front().tdc;
+            unsigned short stopTDC  = tdcDeposits.back().tdc;
             
             	  // Convert to ticks to get in same units as hits
             unsigned short startTick = clockData.TPCTDC2Tick(startTDC)        + fOffsetVec[plane];
@@ -826,7 +802,7 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
             const recob::Hit* bestHit     = 0;
              // The next mission is to recover the hits associated to this Wire
     		    // The easiest way to do this is to simply look up all the hits on this channel and then match
-            ChanToHitVecMap::iterator hitIter = channelToHitVec.find(chanToTDCToIDEMap.first);
+            ChanToHitVecMap::iterator hitIter = channelToHitVec.find(chanDeposits.channel);
 
             if (hitIter != channelToHitVec.end())
             {
@@ -877,9 +853,9 @@ void ThroughgoingmuonAnalyzer::analyze(art::Event const& evt)
                     {
                         unsigned short hitTDC = clockData.TPCTick2TDC(tick - fOffsetVec[plane]);
              
-                        TDCToIDEMap::iterator ideIterator = tdcToIDEMap.find(hitTDC);
+                        const icarus::SimChannelTruthIndex::Deposit* deposit = icarus::SimChannelTruthIndex::findTDC(tdcDeposits, hitTDC);
 			
-                        if (ideIterator != tdcToIDEMap.end()) nElectronsTotalBest += ideIterator->second.numElectrons;
+                        if (deposit) nElectronsTotalBest += deposit->ide->numElectrons;
 		      }
                     // Ok, now we need to figure out which trajectory point this hit is associated to 
                     // Use the associated IDE to get the x,y,z position for this hit
@@ -1,4 +1,5 @@
 #include "icaruscode/Analysis/tools/IHitEfficiencyHistogramTool.h"
+#include "icaruscode/Analysis/tools/SimChannelTruthIndex.h"
 
 #include "fhiclcpp/ParameterSet.h"
 #include "art/Utilities/ToolMacros.h"
@@ -14,6 +15,8 @@
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom()
 
 #include "lardataobj/RecoBase/Wire.h"
+#include "icaruscode/IcarusObj/ChannelROI.h"
+#include "icaruscode/TPC/Utilities/ChannelROIWireView.h"
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/Simulation/SimChannel.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
@@ -95,6 +98,7 @@ public:
      *  @brief Interface for filling histograms
      */
     void fillHistograms(const art::Event&)  const override;
+    void fillHistograms(const art::Event&, icarus::SimChannelTruthIndexSet<art::Event>&)  const override;
     
 private:
     
@@ -311,35 +315,27 @@ void HitEfficiencyAnalysis::clear() const
 }
     
 void HitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
+{
+    // Without indices shared by the module, this tool builds its own
+    icarus::SimChannelTruthIndexSet<art::Event> truthIndices(event);
+
+    fillHistograms(event, truthIndices);
+}
+
+void HitEfficiencyAnalysis::fillHistograms(const art::Event& event, icarus::SimChannelTruthIndexSet<art::Event>& truthIndices) const
 {
     // Basic assumption is that the list of input Wire producers and Hit producers are the same length
     // and the entries match. Here we check the length
     if (fWireProducerLabelVec.size() != fHitProducerLabelVec.size()) return;
     
-    // Recover SimChannel info
-    art::Handle< std::vector<sim::SimChannel>> simChannelHandle;
-    event.getByLabel(fSimChannelProducerLabel, simChannelHandle);
-    
+    // Recover the truth index of SimChannel info: for each channel we have particles (track id's) depositing energy
+    // in a range of ticks, and the index relates particles to channels, tdc ranges and deposited energy (or electrons)
+    // It is built once for this event, and shared with the other tools
+    const icarus::SimChannelTruthIndex* truthIndex =
+        truthIndices.get(fSimChannelProducerLabel, fMCParticleProducerLabel);
+
     // If there is no sim channel informaton then exit
-    if (!simChannelHandle.isValid() || simChannelHandle->empty()) return;
-    
-    // There are several things going on here... for each channel we have particles (track id's) depositing energy in a range to ticks
-    // So... for each channel we want to build a structure that relates particles to tdc ranges and deposited energy (or electrons)
-    // Here is a complicated structure:
-    using TDCToIDEMap             = std::map<unsigned short, float>;
-    using ChanToTDCToIDEMap       = std::map<raw::ChannelID_t, TDCToIDEMap>;
-    using PartToChanToTDCToIDEMap = std::map<int, ChanToTDCToIDEMap>;
-    
-    PartToChanToTDCToIDEMap partToChanToTDCToIDEMap;
-    
-    // Build out the above data structure
-    for(const auto& simChannel : *simChannelHandle)
-    {
-        for(const auto& tdcide : simChannel.TDCIDEMap())
-        {
-            for(const auto& ide : tdcide.second) partToChanToTDCToIDEMap[ide.trackID][simChannel.Channel()][tdcide.first] = ide.numElectrons;
-        }
-    }
+    if (!truthIndex || truthIndex->nSimChannels() == 0) return;
 
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
 
@@ -349,13 +345,17 @@ void HitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
         art::Handle< std::vector<recob::Wire> > wireHandle;
         event.getByLabel(fWireProducerLabelVec[tpcID], wireHandle);
         
+        // Without recob::Wire output, read the recob::ChannelROI of the same producer directly
+        art::Handle< std::vector<recob::ChannelROI> > channelROIHandle;
+        if (!wireHandle.isValid()) event.getByLabel(fWireProducerLabelVec[tpcID], channelROIHandle);
+        
         art::Handle< std::vector<recob::Hit> > hitHandle;
         event.getByLabel(fHitProducerLabelVec[tpcID], hitHandle);
         
         art::Handle< std::vector<simb::MCParticle>> mcParticleHandle;
         event.getByLabel(fMCParticleProducerLabel, mcParticleHandle);
         
-        if (!wireHandle.isValid() || !hitHandle.isValid() || !mcParticleHandle.isValid()) return;
+        if ((!wireHandle.isValid() && !channelROIHandle.isValid()) || !hitHandle.isValid() || !mcParticleHandle.isValid()) return;
     
         // Find the associations between wire data and hits
         // What we want to be able to do is look up hits that have been associated to Wire data
@@ -366,11 +366,20 @@ void HitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
         // what needs to be done?
         // First we should build out a straightforward channel to Wire map so we can look up a given
         // channel's Wire data as we loop over SimChannels.
-        using ChanToWireMap = std::map<raw::ChannelID_t,const recob::Wire*>;
+        using ChanToWireMap     = std::map<raw::ChannelID_t,const recob::Wire*>;
+        using ChanToWireViewMap = std::map<raw::ChannelID_t,recob::ChannelROIWireView>;
         
-        ChanToWireMap channelToWireMap;
+        ChanToWireMap     channelToWireMap;
+        ChanToWireViewMap channelToWireViewMap;
         
-        for(const auto& wire : *wireHandle) channelToWireMap[wire.Channel()] = &wire;
+        if (wireHandle.isValid())
+        {
+            for(const auto& wire : *wireHandle) channelToWireMap[wire.Channel()] = &wire;
+        }
+        else
+        {
+            for(const auto& channelROI : *channelROIHandle) channelToWireViewMap.insert_or_assign(channelROI.Channel(), recob::ChannelROIWireView(channelROI));
+        }
         
         // First we should map out all hits by channel so we can easily look up from sim channels
         // Then go through the sim channels and match hits
@@ -379,31 +388,24 @@ void HitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
         
         for(const auto& hit : *hitHandle) channelToHitVec[hit.Channel()].push_back(&hit);
         
-        // It is useful to create a mapping between trackID and MCParticle
-        using TrackIDToMCParticleMap = std::map<int, const simb::MCParticle*>;
-        
-        TrackIDToMCParticleMap trackIDToMCParticleMap;
-        
-        for(const auto& mcParticle : *mcParticleHandle) trackIDToMCParticleMap[mcParticle.TrackId()] = &mcParticle;
-        
         std::vector<int> nSimChannelHitVec = {0,0,0};
         std::vector<int> nRecobHitVec      = {0,0,0};
 
-        for(const auto& partToChanInfo : partToChanToTDCToIDEMap)
+        for(const auto& trackDeposits : truthIndex->tracks())
         {
-            TrackIDToMCParticleMap::const_iterator trackIDToMCPartItr = trackIDToMCParticleMap.find(partToChanInfo.first);
+            const simb::MCParticle* mcParticle = truthIndex->particle(trackDeposits.trackID);
 
-            if (trackIDToMCPartItr == trackIDToMCParticleMap.end()) continue;
+            if (!mcParticle) continue;
 
-            int         trackPDGCode = trackIDToMCPartItr->second->PdgCode();
-            std::string processName  = trackIDToMCPartItr->second->Process();
+            int         trackPDGCode = mcParticle->PdgCode();
+            std::string processName  = mcParticle->Process();
 
             // Looking for primary muons (e.g. CR Tracks)
             if (fabs(trackPDGCode) != 13 || processName != "primary") continue;
     
-            for(const auto& chanToTDCToIDEMap : partToChanInfo.second)
+            for(const auto& chanDeposits : trackDeposits.channels)
             {
-                TDCToIDEMap tdcToIDEMap = chanToTDCToIDEMap.second;
+                const icarus::SimChannelTruthIndex::DepositRange& tdcDeposits = chanDeposits.deposits;
                 float       totalElectrons(0.);
                 float       maxElectrons(0.);
                 int         nMatchedWires(0);
@@ -411,17 +413,17 @@ void HitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
         
                 // The below try-catch block may no longer be necessary
                 // Decode the channel and make sure we have a valid one
-                std::vector<geo::WireID> wids = fGeometry->ChannelToWire(chanToTDCToIDEMap.first);
+                std::vector<geo::WireID> wids = fGeometry->ChannelToWire(chanDeposits.channel);
         
                 // Recover plane and wire in the plane
                 unsigned int plane = wids[0].Plane;
 //                unsigned int wire  = wids[0].Wire;
         
-                for(const auto& ideVal : tdcToIDEMap)
+                for(const auto& ideVal : tdcDeposits)
                 {
-                    totalElectrons += ideVal.second;
+                    totalElectrons += ideVal.ide->numElectrons;
         
-                    maxElectrons = std::max(maxElectrons,ideVal.second);
+                    maxElectrons = std::max(maxElectrons,ideVal.ide->numElectrons);
                 }
         
                 totalElectrons = std::min(totalElectrons, float(99900.));
@@ -431,8 +433,8 @@ void HitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
         
                 nSimChannelHitVec.at(plane)++;
     
-                unsigned short startTDC = tdcToIDEMap.begin()->first;
-                unsigned short stopTDC  = tdcToIDEMap.rbegin()->first;
+                unsigned short startTDC = tdcDeposits.front().tdc;
+                unsigned short stopTDC  = tdcDeposits.back().tdc;
         
                 // Convert to ticks to get in same units as hits
                 unsigned short startTick = clockData.TPCTDC2Tick(startTDC) + fOffsetVec.at(plane);
@@ -453,35 +455,35 @@ void HitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
                 unsigned short hitStartTickBest(0);
                 unsigned short midHitTickBest(0);
         
-                // Start by recovering the Wire associated to this channel
-                ChanToWireMap::const_iterator wireItr = channelToWireMap.find(chanToTDCToIDEMap.first);
+                // Start by recovering the Wire associated to this channel, either as recob::Wire or as a
+                // view of the recob::ChannelROI when that is what the producer made
+                ChanToWireMap::const_iterator     wireItr = channelToWireMap.find(chanDeposits.channel);
+                ChanToWireViewMap::const_iterator viewItr = channelToWireViewMap.find(chanDeposits.channel);
         
-                if (wireItr != channelToWireMap.end())
+                if (wireItr != channelToWireMap.end() || viewItr != channelToWireViewMap.end())
                 {
-                    const recob::Wire::RegionsOfInterest_t&       signalROI = wireItr->second->SignalROI();
-                    const lar::sparse_vector<float>::datarange_t* wireRangePtr(NULL);
-        
                     // Here we need to match the range of the ROI's on the given Wire with the tick range from the SimChannel
-                    for(const auto& range : signalROI.get_ranges())
+                    auto overlapsROI = [startTick,stopTick](const auto& ranges)
                     {
-                        // #################################################
-                        // ### Getting a vector of signals for this wire ###
-                        // #################################################
-                        //std::vector<float> signal(wire->Signal());
-        
-                        const std::vector<float>& signal          = range.data();
-                        raw::TDCtick_t            roiFirstBinTick = range.begin_index();
-                        raw::TDCtick_t            roiLastBinTick  = roiFirstBinTick + signal.size();
-        
-                        // If no overlap then go to next
-                        if (roiFirstBinTick > stopTick || roiLastBinTick < startTick) continue;
+                        for(const auto& range : ranges)
+                        {
+                            raw::TDCtick_t roiFirstBinTick = range.begin_index();
+                            raw::TDCtick_t roiLastBinTick  = roiFirstBinTick + range.size();
+                
+                            // If no overlap then go to next
+                            if (roiFirstBinTick > stopTick || roiLastBinTick < startTick) continue;
+                
+                            return true;
+                        }
+                
+                        return false;
+                    };
         
-                        wireRangePtr = &range;
-                        break;
-                    }
+                    bool foundROI = wireItr != channelToWireMap.end() ? overlapsROI(wireItr->second->SignalROI().get_ranges())
+                                                                      : overlapsROI(viewItr->second.get_ranges());
         
                     // Check that we have found the wire range
-                    if (wireRangePtr)
+                    if (foundROI)
                     {
                         const recob::Hit* rejectedHit = 0;
                         const recob::Hit* bestHit     = 0;
@@ -490,7 +492,7 @@ void HitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
     
                         // The next mission is to recover the hits associated to this Wire
                         // The easiest way to do this is to simply look up all the hits on this channel and then match
-                        ChanToHitVecMap::iterator hitIter = channelToHitVec.find(chanToTDCToIDEMap.first);
+                        ChanToHitVecMap::iterator hitIter = channelToHitVec.find(chanDeposits.channel);
         
                         if (hitIter != channelToHitVec.end())
                         {
@@ -541,9 +543,9 @@ void HitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
                                 {
                                     unsigned short hitTDC = clockData.TPCTick2TDC(tick - fOffsetVec.at(plane));
         
-                                    TDCToIDEMap::iterator ideIterator = tdcToIDEMap.find(hitTDC);
+                                    const icarus::SimChannelTruthIndex::Deposit* deposit = icarus::SimChannelTruthIndex::findTDC(tdcDeposits, hitTDC);
         
-                                    if (ideIterator != tdcToIDEMap.end()) nElectronsTotalBest += ideIterator->second;
+                                    if (deposit) nElectronsTotalBest += deposit->ide->numElectrons;
                                 }
                             }
         
@@ -565,7 +567,7 @@ void HitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
                                 unsigned short hitStopTick  = rejectedHit->PeakTime() + fSigmaVec.at(plane) * rejectedHit->RMS();
         
                                 std::cout << "**> TPC: " << rejectedHit->WireID().TPC << ", Plane " << rejectedHit->WireID().Plane << ", wire: " << rejectedHit->WireID().Wire << ", hit start/ stop     tick: " << hitStartTick <<     "/" << hitStopTick << ", start/stop ticks: " << startTick << "/" << stopTick << std::endl;
-                                std::cout << "    TPC/Plane/Wire: " << wids[0].TPC << "/" << plane << "/" << wids[0].Wire << ", Track # hits: " << partToChanInfo.second.size() << ", # hits: "     <<  hitIter->second.size() << ", #  electrons: " << totalElectrons << ", pulse Height: " << rejectedHit->PeakAmplitude() << ", charge: " << rejectedHit->Integral()  << ", " << rejectedHit->SummedADC() << std::endl;
+                                std::cout << "    TPC/Plane/Wire: " << wids[0].TPC << "/" << plane << "/" << wids[0].Wire << ", Track # hits: " << trackDeposits.channels.size() << ", # hits: "     <<  hitIter->second.size() << ", #  electrons: " << totalElectrons << ", pulse Height: " << rejectedHit->PeakAmplitude() << ", charge: " << rejectedHit->Integral()  << ", " << rejectedHit->SummedADC() << std::endl;
                             }
                             else
                             {
@@ -17,6 +17,7 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art_root_io/TFileService.h"
 #include "art/Framework/Principal/Event.h"
+#include "icaruscode/Analysis/tools/SimChannelTruthIndex.h"
 
 class TTree;
 
@@ -61,6 +62,20 @@ public:
      *  @brief Interface for filling histograms
      */
     virtual void fillHistograms(const art::Event&)  const = 0;
+
+    /**
+     *  @brief Interface for filling histograms, with the MC truth indices of the event
+     *
+     *  @param Event                    the event being processed
+     *  @param SimChannelTruthIndexSet  MC truth indices shared by all the tools for this event
+     *
+     *  Tools using MC truth should get their index from the set; by default the
+     *  set is ignored.
+     */
+    virtual void fillHistograms(const art::Event& event, icarus::SimChannelTruthIndexSet<art::Event>&) const
+    {
+        fillHistograms(event);
+    }
 };
 
 #endif
@@ -0,0 +1,164 @@
+#include "icaruscode/Analysis/tools/SimChannelTruthIndex.h"
+
+#include <algorithm>
+
+namespace icarus
+{
+
+//----------------------------------------------------------------------------
+/// Constructor.
+///
+/// Arguments:
+///
+/// simChannels - the SimChannels to index
+/// mcParticles - the MCParticles to relate to track IDs (optional)
+///
+SimChannelTruthIndex::SimChannelTruthIndex(const std::vector<sim::SimChannel>&  simChannels,
+                                           const std::vector<simb::MCParticle>* mcParticles) :
+    fNSimChannels(simChannels.size())
+{
+    size_t nDeposits(0);
+
+    for(const auto& simChannel : simChannels)
+        for(const auto& tdcide : simChannel.TDCIDEMap()) nDeposits += tdcide.second.size();
+
+    fDeposits.reserve(nDeposits);
+
+    for(const auto& simChannel : simChannels)
+    {
+        raw::ChannelID_t channel = simChannel.Channel();
+
+        for(const auto& tdcide : simChannel.TDCIDEMap())
+        {
+            for(const auto& ide : tdcide.second) fDeposits.push_back({ide.trackID, channel, tdcide.first, &ide});
+        }
+    }
+
+    // Deposits sharing track, channel and TDC keep their SimChannel order
+    std::stable_sort(fDeposits.begin(),fDeposits.end(),[](const auto& left, const auto& right)
+        {
+            if (left.trackID != right.trackID) return left.trackID < right.trackID;
+            if (left.channel != right.channel) return left.channel < right.channel;
+            return left.tdc < right.tdc;
+        });
+
+    // Cut the deposits in per track and per channel ranges, first as indices and
+    // then as ranges, once the vectors are complete and will not move anymore
+    std::vector<size_t> trackFirstChannel;  // first entry in fTrackChannels of each track
+    std::vector<size_t> channelFirstDeposit; // first deposit of each track/channel
+
+    for(size_t depIdx = 0; depIdx < fDeposits.size(); depIdx++)
+    {
+        const Deposit& deposit  = fDeposits[depIdx];
+        bool           newTrack = depIdx == 0 || deposit.trackID != fDeposits[depIdx - 1].trackID;
+
+        if (newTrack)
+        {
+            fTrackIndex[deposit.trackID] = fTracks.size();
+            fTracks.push_back({deposit.trackID, {}, {}});
+            trackFirstChannel.push_back(fTrackChannels.size());
+        }
+
+        if (newTrack || deposit.channel != fDeposits[depIdx - 1].channel)
+        {
+            fTrackChannelIndex[trackChannelKey(deposit.trackID, deposit.channel)] = fTrackChannels.size();
+            fTrackChannels.push_back({deposit.channel, {}});
+            channelFirstDeposit.push_back(depIdx);
+        }
+    }
+
+    trackFirstChannel.push_back(fTrackChannels.size());
+    channelFirstDeposit.push_back(fDeposits.size());
+
+    const Deposit* deposits = fDeposits.data();
+
+    for(size_t chanIdx = 0; chanIdx < fTrackChannels.size(); chanIdx++)
+        fTrackChannels[chanIdx].deposits = DepositRange(deposits + channelFirstDeposit[chanIdx], deposits + channelFirstDeposit[chanIdx + 1]);
+
+    for(size_t trackIdx = 0; trackIdx < fTracks.size(); trackIdx++)
+    {
+        const ChannelDeposits* firstChannel = fTrackChannels.data() + trackFirstChannel[trackIdx];
+        const ChannelDeposits* lastChannel  = fTrackChannels.data() + trackFirstChannel[trackIdx + 1];
+
+        fTracks[trackIdx].channels = Range<const ChannelDeposits>(firstChannel, lastChannel);
+        fTracks[trackIdx].deposits = DepositRange(firstChannel->deposits.begin(), (lastChannel - 1)->deposits.end());
+    }
+
+    // Now the channel view, with all the particles on a channel sorted by TDC
+    // (and then by track ID, from the order above)
+    fChannelDeposits.resize(fDeposits.size());
+
+    std::transform(fDeposits.begin(),fDeposits.end(),fChannelDeposits.begin(),[](const auto& deposit){return &deposit;});
+
+    std::stable_sort(fChannelDeposits.begin(),fChannelDeposits.end(),[](const auto& left, const auto& right)
+        {
+            if (left->channel != right->channel) return left->channel < right->channel;
+            return left->tdc < right->tdc;
+        });
+
+    for(auto depItr = fChannelDeposits.cbegin(); depItr != fChannelDeposits.cend();)
+    {
+        raw::ChannelID_t channel = (*depItr)->channel;
+        auto             lastItr = std::find_if(depItr,fChannelDeposits.cend(),[channel](const auto& deposit){return deposit->channel != channel;});
+
+        fChannelIndex[channel] = DepositPtrRange(&*depItr, &*depItr + std::distance(depItr,lastItr));
+
+        depItr = lastItr;
+    }
+
+    if (mcParticles)
+    {
+        for(const auto& mcParticle : *mcParticles) fParticleIndex[mcParticle.TrackId()] = &mcParticle;
+    }
+}
+
+//----------------------------------------------------------------------------
+const SimChannelTruthIndex::TrackDeposits* SimChannelTruthIndex::track(int trackID) const
+{
+    auto trackItr = fTrackIndex.find(trackID);
+
+    return trackItr != fTrackIndex.end() ? &fTracks[trackItr->second] : nullptr;
+}
+
+//----------------------------------------------------------------------------
+SimChannelTruthIndex::DepositRange SimChannelTruthIndex::trackChannel(int trackID, raw::ChannelID_t channel) const
+{
+    auto chanItr = fTrackChannelIndex.find(trackChannelKey(trackID, channel));
+
+    return chanItr != fTrackChannelIndex.end() ? fTrackChannels[chanItr->second].deposits : DepositRange();
+}
+
+//----------------------------------------------------------------------------
+SimChannelTruthIndex::DepositPtrRange SimChannelTruthIndex::channel(raw::ChannelID_t channel) const
+{
+    auto chanItr = fChannelIndex.find(channel);
+
+    return chanItr != fChannelIndex.end() ? chanItr->second : DepositPtrRange();
+}
+
+//----------------------------------------------------------------------------
+const simb::MCParticle* SimChannelTruthIndex::particle(int trackID) const
+{
+    auto partItr = fParticleIndex.find(trackID);
+
+    return partItr != fParticleIndex.end() ? partItr->second : nullptr;
+}
+
+//----------------------------------------------------------------------------
+SimChannelTruthIndex::DepositRange SimChannelTruthIndex::tdcRange(const DepositRange& deposits, unsigned short firstTDC, unsigned short lastTDC)
+{
+    const Deposit* first = std::lower_bound(deposits.begin(),deposits.end(),firstTDC,[](const auto& deposit, unsigned short tdc){return deposit.tdc < tdc;});
+    const Deposit* last  = std::upper_bound(first,deposits.end(),lastTDC,[](unsigned short tdc, const auto& deposit){return tdc < deposit.tdc;});
+
+    return DepositRange(first, last);
+}
+
+//----------------------------------------------------------------------------
+const SimChannelTruthIndex::Deposit* SimChannelTruthIndex::findTDC(const DepositRange& deposits, unsigned short tdc)
+{
+    DepositRange atTDC = tdcRange(deposits, tdc, tdc);
+
+    return atTDC.empty() ? nullptr : &atTDC.back();
+}
+
+} // end icarus namespace
@@ -0,0 +1,223 @@
+#ifndef SIMCHANNELTRUTHINDEX_H
+#define SIMCHANNELTRUTHINDEX_H
+////////////////////////////////////////////////////////////////////////
+//
+// Class:       SimChannelTruthIndex
+// File:        SimChannelTruthIndex.h
+//
+//              This provides a flat, sorted index of the ionization
+//              deposits (sim::IDE) found in the SimChannels of an event,
+//              to be shared by the analysis tools which need to relate
+//              MC particles to channels and TDC ticks.
+//
+//              Deposits are stored once, sorted by track ID, channel and
+//              TDC; the deposits of a particle, of a particle on a channel
+//              and of a channel (from all particles, sorted by TDC) are
+//              contiguous ranges which are found in constant time.
+//              Within those ranges, a TDC interval is found by bisection.
+//              The index also relates track IDs to their MCParticle.
+//
+//              The index holds pointers into the data products it was
+//              built from, and it is valid only while they are.
+//              Use `forEvent()` to build the index of the current event
+//              once, in the module or tool which uses it, and drop it at the
+//              end of the event: an index is never reused for another event.
+//              `SimChannelTruthIndexSet` shares the indices of one event
+//              among several tools, building each one on first request.
+//
+// Created on October 18, 2026
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "lardataobj/Simulation/SimChannel.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "nusimdata/SimulationBase/MCParticle.h"
+#include "canvas/Utilities/InputTag.h"
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace icarus
+{
+
+class SimChannelTruthIndex
+{
+public:
+
+    /// A single deposit of a particle on a channel at a TDC tick
+    struct Deposit
+    {
+        int              trackID;
+        raw::ChannelID_t channel;
+        unsigned short   tdc;
+        const sim::IDE*  ide;
+    };
+
+    /// A contiguous range of elements in the index
+    template <typename T>
+    class Range
+    {
+    public:
+        Range() = default;
+        Range(T* first, T* last) : fFirst(first), fLast(last) {}
+
+        T*     begin()                   const {return fFirst;}
+        T*     end()                     const {return fLast;}
+        size_t size()                    const {return fLast - fFirst;}
+        bool   empty()                   const {return fFirst == fLast;}
+        T&     front()                   const {return *fFirst;}
+        T&     back()                    const {return *(fLast - 1);}
+        T&     operator[](size_t idx)    const {return fFirst[idx];}
+
+    private:
+        T* fFirst = nullptr;
+        T* fLast  = nullptr;
+    };
+
+    /// Deposits of one particle, sorted by channel and TDC
+    using DepositRange    = Range<const Deposit>;
+
+    /// Deposits of all particles on one channel, sorted by TDC and track ID
+    using DepositPtrRange = Range<const Deposit* const>;
+
+    /// Deposits of a particle on one channel, sorted by TDC
+    struct ChannelDeposits
+    {
+        raw::ChannelID_t channel;
+        DepositRange     deposits;
+    };
+
+    /// All the deposits of a particle, channel by channel
+    struct TrackDeposits
+    {
+        int                           trackID;
+        Range<const ChannelDeposits>  channels;
+        DepositRange                  deposits;
+    };
+
+    /// Builds the index; `mcParticles` may be null
+    SimChannelTruthIndex(const std::vector<sim::SimChannel>&   simChannels,
+                         const std::vector<simb::MCParticle>*  mcParticles = nullptr);
+
+    // The ranges point into the index itself
+    SimChannelTruthIndex(const SimChannelTruthIndex&)            = delete;
+    SimChannelTruthIndex& operator=(const SimChannelTruthIndex&) = delete;
+
+    /// Builds the index for the products with the specified labels in `event`
+    /// (null if there are no SimChannels); MCParticles are optional.
+    template <typename Event>
+    static std::unique_ptr<const SimChannelTruthIndex> forEvent(const Event&          event,
+                                                                const art::InputTag&  simChannelLabel,
+                                                                const art::InputTag&  mcParticleLabel);
+
+    /// All the particles with deposits, sorted by track ID
+    const std::vector<TrackDeposits>& tracks() const {return fTracks;}
+
+    /// Deposits of the particle `trackID` (null if it has none)
+    const TrackDeposits* track(int trackID) const;
+
+    /// Deposits of the particle `trackID` on `channel` (empty if none)
+    DepositRange trackChannel(int trackID, raw::ChannelID_t channel) const;
+
+    /// Deposits of all the particles on `channel` (empty if none)
+    DepositPtrRange channel(raw::ChannelID_t channel) const;
+
+    /// The MCParticle with the specified track ID (null if not available)
+    const simb::MCParticle* particle(int trackID) const;
+
+    /// Number of SimChannels the index was built from
+    size_t nSimChannels() const {return fNSimChannels;}
+
+    /// Total number of deposits in the index
+    size_t nDeposits() const {return fDeposits.size();}
+
+    /// The part of `deposits` in the TDC interval [ `firstTDC`, `lastTDC` ]
+    static DepositRange tdcRange(const DepositRange& deposits, unsigned short firstTDC, unsigned short lastTDC);
+
+    /// The (last) deposit of `deposits` at `tdc` (null if none)
+    static const Deposit* findTDC(const DepositRange& deposits, unsigned short tdc);
+
+private:
+
+    static std::uint64_t trackChannelKey(int trackID, raw::ChannelID_t channel)
+    {
+        return (std::uint64_t(std::uint32_t(trackID)) << 32) | std::uint32_t(channel);
+    }
+
+    size_t                                                 fNSimChannels;       ///< Number of indexed SimChannels
+    std::vector<Deposit>                                   fDeposits;           ///< Sorted by track, channel, TDC
+    std::vector<const Deposit*>                            fChannelDeposits;    ///< Sorted by channel, TDC, track
+    std::vector<ChannelDeposits>                           fTrackChannels;      ///< Per track and channel
+    std::vector<TrackDeposits>                             fTracks;             ///< Per track
+    std::unordered_map<int, size_t>                        fTrackIndex;         ///< Track ID to `fTracks` index
+    std::unordered_map<std::uint64_t, size_t>              fTrackChannelIndex;  ///< Track/channel to `fTrackChannels` index
+    std::unordered_map<raw::ChannelID_t, DepositPtrRange>  fChannelIndex;       ///< Channel to `fChannelDeposits` range
+    std::unordered_map<int, const simb::MCParticle*>       fParticleIndex;      ///< Track ID to MCParticle
+};
+
+//----------------------------------------------------------------------------
+template <typename Event>
+std::unique_ptr<const SimChannelTruthIndex> SimChannelTruthIndex::forEvent(const Event&         event,
+                                                                           const art::InputTag& simChannelLabel,
+                                                                           const art::InputTag& mcParticleLabel)
+{
+    auto simChannelHandle = event.template getHandle<std::vector<sim::SimChannel>>(simChannelLabel);
+
+    if (!simChannelHandle.isValid()) return {};
+
+    auto mcParticleHandle = event.template getHandle<std::vector<simb::MCParticle>>(mcParticleLabel);
+
+    return std::make_unique<const SimChannelTruthIndex>(*simChannelHandle, mcParticleHandle.isValid() ? mcParticleHandle.product() : nullptr);
+}
+
+//----------------------------------------------------------------------------
+/// The indices of one event, shared by the modules and tools processing it.
+/// Each index is built on the first request for its input labels; the set
+/// must be created for each event and dropped at its end.
+template <typename Event>
+class SimChannelTruthIndexSet
+{
+public:
+
+    explicit SimChannelTruthIndexSet(const Event& event) : fEvent(event) {}
+
+    /// The index of the products with the specified labels (null if there are
+    /// no SimChannels), as from `SimChannelTruthIndex::forEvent()`
+    const SimChannelTruthIndex* get(const art::InputTag& simChannelLabel, const art::InputTag& mcParticleLabel);
+
+    /// Number of indices built so far
+    size_t size() const {return fIndices.size();}
+
+private:
+
+    struct Entry
+    {
+        art::InputTag                               simChannelLabel;
+        art::InputTag                               mcParticleLabel;
+        std::unique_ptr<const SimChannelTruthIndex> index;
+    };
+
+    const Event&       fEvent;
+    std::vector<Entry> fIndices;    ///< Indices built so far (few: linear search)
+};
+
+//----------------------------------------------------------------------------
+template <typename Event>
+const SimChannelTruthIndex* SimChannelTruthIndexSet<Event>::get(const art::InputTag& simChannelLabel,
+                                                                const art::InputTag& mcParticleLabel)
+{
+    for(const auto& entry : fIndices)
+    {
+        if (entry.simChannelLabel == simChannelLabel && entry.mcParticleLabel == mcParticleLabel) return entry.index.get();
+    }
+
+    fIndices.push_back({simChannelLabel, mcParticleLabel, SimChannelTruthIndex::forEvent(fEvent, simChannelLabel, mcParticleLabel)});
+
+    return fIndices.back().index.get();
+}
+
+} // end icarus namespace
+#endif
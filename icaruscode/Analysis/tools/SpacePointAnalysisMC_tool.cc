@@ -1,4 +1,5 @@
 #include "icaruscode/Analysis/tools/IHitEfficiencyHistogramTool.h"
+#include "icaruscode/Analysis/tools/SimChannelTruthIndex.h"
 
 #include "fhiclcpp/ParameterSet.h"
 #include "art/Utilities/ToolMacros.h"
@@ -352,6 +353,7 @@ public:
      *  @brief Interface for filling histograms
      */
     void fillHistograms(const art::Event&)  const override;
+    void fillHistograms(const art::Event&, icarus::SimChannelTruthIndexSet<art::Event>&)  const override;
 
 private:
 
@@ -367,9 +369,6 @@ private:
     // Define structures for relating SimChannel to Voxels
     using SimIDESet                = std::set<const sim::IDE*,ideCompare>;
     using IDEToVoxelIDMap          = std::unordered_map<const sim::IDE*, sim::LArVoxelID>;
-    using VoxelIDToIDESetMap       = std::map<sim::LArVoxelID, SimIDESet>;
-    using TDCToIDEMap              = std::map<unsigned short, SimIDESet>; // We need this one in order
-    using ChanToTDCToIDEMap        = std::map<raw::ChannelID_t, TDCToIDEMap>;
     using VoxelIDSet               = std::set<sim::LArVoxelID>;
 
     // And, of course, what we need is to be able to track a voxel back to the IDEs in each tick on each plane
@@ -377,11 +376,10 @@ private:
     using PlaneToTDCToIDESetMap    = std::map<unsigned short, TDCToIDESetMap>;
     using VoxelIDToPlaneTDCIDEMap  = std::map<sim::LArVoxelID, PlaneToTDCToIDESetMap>;
 
-    // The following creates a trackID mapping
+    // The following relates channels to the deposits of a track
     using TDCIDEPair               = std::pair<unsigned short, const sim::IDE*>;
     using TickTDCIDEVec            = std::vector<TDCIDEPair>;
     using ChanToTDCIDEMap          = std::unordered_map<raw::ChannelID_t,TickTDCIDEVec>;
-    using TrackIDChanToTDCIDEMap   = std::unordered_map<int,ChanToTDCIDEMap>;
 
     // More data structures, here we want to keep track of the start/peak/end of the charge deposit along a wire for a given track
     using ChargeDeposit            = std::tuple<TDCIDEPair,TDCIDEPair,TDCIDEPair,float,float>;
@@ -390,16 +388,19 @@ private:
     using TrackToChanChargeMap     = std::unordered_map<int,ChanToChargeMap>;
 
     // Define a function to map IDE's from SimChannel objects to Track IDs
-    void makeTrackToChanChargeMap(const TrackIDChanToTDCIDEMap&, TrackToChanChargeMap&, float&, int&) const;
+    void makeTrackToChanChargeMap(const icarus::SimChannelTruthIndex&, TrackToChanChargeMap&, float&, int&) const;
+
+    // The deposits of a track on a channel above the energy threshold
+    void selectDeposits(const icarus::SimChannelTruthIndex::DepositRange&, TickTDCIDEVec&) const;
 
     // Relate hits to voxels
     using HitPointerVec        = std::vector<const recob::Hit*>;
     using RecobHitToVoxelIDMap = std::unordered_map<const recob::Hit*, VoxelIDSet>;
 
-    void compareHitsToSim(const art::Event&, const ChanToTDCToIDEMap&, const ChanToChargeMap&, const ChanToTDCIDEMap&, const IDEToVoxelIDMap&, RecobHitToVoxelIDMap&) const;
+    void compareHitsToSim(const art::Event&, const icarus::SimChannelTruthIndex&, const ChanToChargeMap&, const ChanToTDCIDEMap&, const IDEToVoxelIDMap&, RecobHitToVoxelIDMap&) const;
 
     void matchHitSim(const detinfo::DetectorClocksData& clockData,
-                     const HitPointerVec&, const ChanToTDCToIDEMap&, const ChargeDepositVec&, const ChanToTDCIDEMap&, const IDEToVoxelIDMap&, RecobHitToVoxelIDMap&) const;
+                     const HitPointerVec&, const icarus::SimChannelTruthIndex&, const ChargeDepositVec&, const ChanToTDCIDEMap&, const IDEToVoxelIDMap&, RecobHitToVoxelIDMap&) const;
 
     void compareSpacePointsToSim(const art::Event&,
                                  const detinfo::DetectorClocksData& clockData,
@@ -531,6 +532,14 @@ void SpacePointAnalysisMC::clear() const
 }
 
 void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
+{
+    // Without indices shared by the module, this tool builds its own
+    icarus::SimChannelTruthIndexSet<art::Event> truthIndices(event);
+
+    fillHistograms(event, truthIndices);
+}
+
+void SpacePointAnalysisMC::fillHistograms(const art::Event& event, icarus::SimChannelTruthIndexSet<art::Event>& truthIndices) const
 {
     // Ok... this is starting to grow too much and get out of control... we will need to break it up directly...
 
@@ -542,6 +551,11 @@ void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
 
     if (!simChannelHandle.isValid() || simChannelHandle->empty() ) return;
 
+    // The truth index relates particles (track id's) to channels and tdc ranges; it is built once for this event,
+    // and shared with the other tools
+    const icarus::SimChannelTruthIndex* truthIndex =
+        truthIndices.get(fSimChannelProducerLabel, fMCParticleProducerLabel);
+
     art::Handle<std::vector<sim::SimEnergyDeposit>> simEnergyHandle;
     event.getByLabel(fSimEnergyProducerLabel, simEnergyHandle);
 
@@ -557,15 +571,10 @@ void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
 
     // First task is to build a map between ides and voxel ids (that we calcualate based on position)
     // and also get the reverse since it will be useful in the end.
-    // At the same time should also build a mapping of ides per channel so we can do quick hit lookup
+    // The ides per channel and per track come from the truth index
     IDEToVoxelIDMap         ideToVoxelIDMap;
-    VoxelIDToIDESetMap      voxelIDToIDEMap;
-    ChanToTDCToIDEMap       chanToTDCToIDEMap;
-    VoxelIDSet              simChannelVoxelIDSet;
     VoxelIDToPlaneTDCIDEMap voxelIDToPlaneTDCIDEMap;
 
-    TrackIDChanToTDCIDEMap trackIDChanToTDCIDEMap;
-
     // Fill the above maps/structures
     for(const auto& simChannel : *simChannelHandle)
     {
@@ -582,11 +591,6 @@ void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
                 sim::LArVoxelID voxelID(ide.x,ide.y,ide.z,0.);
 
                 ideToVoxelIDMap[&ide]    = voxelID;
-                voxelIDToIDEMap[voxelID].insert(&ide);
-                chanToTDCToIDEMap[simChannel.Channel()][tdcide.first].insert(&ide);
-                simChannelVoxelIDSet.insert(voxelID);
-
-                trackIDChanToTDCIDEMap[ide.trackID][simChannel.Channel()].emplace_back(tdcide.first,&ide);
 
                 voxelIDToPlaneTDCIDEMap[voxelID][wireID.Plane][tdcide.first].insert(&ide);
 
@@ -602,7 +606,7 @@ void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
     float bestTotDepEne(0.);
     int   bestTrackID(0);
 
-    makeTrackToChanChargeMap(trackIDChanToTDCIDEMap, trackToChanChargeMap, bestTotDepEne, bestTrackID);
+    makeTrackToChanChargeMap(*truthIndex, trackToChanChargeMap, bestTotDepEne, bestTrackID);
 
     // Ok, for my next trick I want to build a mapping between hits and voxel IDs. Note that any given hit can be associated to more than one voxel...
     // We do this on the entire hit collection, ultimately we will want to consider SpacePoint efficiency (this could be done in the loop over SpacePoints
@@ -612,13 +616,26 @@ void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
 
     RecobHitToVoxelIDMap recobHitToVoxelIDMap;
 
-    ChanToTDCIDEMap& chanToTDCIDEMap = trackIDChanToTDCIDEMap[bestTrackID];
+    // The deposits of the "best" track, channel by channel
+    ChanToTDCIDEMap chanToTDCIDEMap;
+
+    if (const icarus::SimChannelTruthIndex::TrackDeposits* bestTrackDeposits = truthIndex->track(bestTrackID))
+    {
+        for(const auto& chanDeposits : bestTrackDeposits->channels)
+        {
+            TickTDCIDEVec tdcIDEVec;
+
+            selectDeposits(chanDeposits.deposits, tdcIDEVec);
+
+            if (!tdcIDEVec.empty()) chanToTDCIDEMap[chanDeposits.channel] = std::move(tdcIDEVec);
+        }
+    }
 
     // Recover the "best" track info to start
     TrackToChanChargeMap::const_iterator chanToChargeMapItr = trackToChanChargeMap.find(bestTrackID);
 
     // Process the hit/simulation
-    compareHitsToSim(event, chanToTDCToIDEMap, chanToChargeMapItr->second, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
+    compareHitsToSim(event, *truthIndex, chanToChargeMapItr->second, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
 
     // Now do the space points
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
@@ -632,26 +649,50 @@ void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
     return;
 }
 
-void SpacePointAnalysisMC::makeTrackToChanChargeMap(const TrackIDChanToTDCIDEMap& trackIDChanToTDCIDEMap,
-                                                  TrackToChanChargeMap&         trackToChanChargeMap,
-                                                  float&                        bestTotDepEne,
-                                                  int&                          bestTrackID) const
+void SpacePointAnalysisMC::selectDeposits(const icarus::SimChannelTruthIndex::DepositRange& deposits,
+                                          TickTDCIDEVec&                                   tdcIDEVec) const
 {
+    tdcIDEVec.clear();
+
+    for(const auto& deposit : deposits)
+    {
+        if (deposit.ide->energy < fSimChannelMinEnergy) continue;
+
+        tdcIDEVec.emplace_back(deposit.tdc,deposit.ide);
+    }
+
+    return;
+}
+
+void SpacePointAnalysisMC::makeTrackToChanChargeMap(const icarus::SimChannelTruthIndex& truthIndex,
+                                                  TrackToChanChargeMap&               trackToChanChargeMap,
+                                                  float&                              bestTotDepEne,
+                                                  int&                                bestTrackID) const
+{
+    // Deposits of the current track on the current channel, above threshold
+    TickTDCIDEVec tdcIDEVec;
+
     // Pretty straightforward looping here...
-    for(const auto& trackIDEPair : trackIDChanToTDCIDEMap)
+    for(const auto& trackDeposits : truthIndex.tracks())
     {
-        ChanToChargeMap& chanToChargeMap = trackToChanChargeMap[trackIDEPair.first];
+        ChanToChargeMap* chanToChargeMap = nullptr;
 
         float trackTotDepE(0.);
 
-        for(const auto& chanTDCIDEPair : trackIDEPair.second)
+        for(const auto& chanDeposits : trackDeposits.channels)
         {
-            ChargeDepositVec& chargeDepositVec = chanToChargeMap[chanTDCIDEPair.first];
+            selectDeposits(chanDeposits.deposits, tdcIDEVec);
+
+            if (tdcIDEVec.empty()) continue;
+
+            if (!chanToChargeMap) chanToChargeMap = &trackToChanChargeMap[trackDeposits.trackID];
+
+            ChargeDepositVec& chargeDepositVec = (*chanToChargeMap)[chanDeposits.channel];
 
             // Keep track of first,peak,last/ene
-            TDCIDEPair firstPair = chanTDCIDEPair.second.front();
+            TDCIDEPair firstPair = tdcIDEVec.front();
             TDCIDEPair peakPair  = firstPair;
-            TDCIDEPair lastPair  = chanTDCIDEPair.second.back();
+            TDCIDEPair lastPair  = tdcIDEVec.back();
 
             // Keep watch for gaps
             TDCIDEPair prevPair  = firstPair;
@@ -660,7 +701,7 @@ void SpacePointAnalysisMC::makeTrackToChanChargeMap(const TrackIDChanToTDCIDEMap
             float snippetDepEne(0.);
             float snippetNumElectrons(0.);
 
-            for(const auto& tdcIDEPair : chanTDCIDEPair.second)
+            for(const auto& tdcIDEPair : tdcIDEVec)
             {
                 float depEne = tdcIDEPair.second->energy;
 
@@ -690,7 +731,7 @@ void SpacePointAnalysisMC::makeTrackToChanChargeMap(const TrackIDChanToTDCIDEMap
 
         if (trackTotDepE > bestTotDepEne)
         {
-            bestTrackID   = trackIDEPair.first;
+            bestTrackID   = trackDeposits.trackID;
             bestTotDepEne = trackTotDepE;
         }
     }
@@ -699,7 +740,7 @@ void SpacePointAnalysisMC::makeTrackToChanChargeMap(const TrackIDChanToTDCIDEMap
 }
 
 void SpacePointAnalysisMC::compareHitsToSim(const art::Event&        event,                          // For recovering data from event store
-                                          const ChanToTDCToIDEMap& chanToTDCToIDEMap,              // This gives us ability to retrieve total charge deposits
+                                          const icarus::SimChannelTruthIndex& truthIndex,          // This gives us ability to retrieve total charge deposits
                                           const ChanToChargeMap&   chanToChargeMap,                // Charge deposit for specific track
                                           const ChanToTDCIDEMap&   chanToTDCIDEMap,                // Charge deposit for specific track
                                           const IDEToVoxelIDMap&   ideToVoxelIDMap,                // Mapping of ide info to voxels
@@ -777,7 +818,7 @@ void SpacePointAnalysisMC::compareHitsToSim(const art::Event&        event,
             }
 
             // Process the current list of hits (which will be on the same snippet)
-            matchHitSim(clockData, hitVec, chanToTDCToIDEMap, chargeDepositVec, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
+            matchHitSim(clockData, hitVec, truthIndex, chargeDepositVec, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
 
             hitVec.clear();
             hitVec.emplace_back(hitPtr);
@@ -785,7 +826,7 @@ void SpacePointAnalysisMC::compareHitsToSim(const art::Event&        event,
         }
 
         // Make sure to catch the last set of hits in the group
-        if (!hitVec.empty()) matchHitSim(clockData, hitVec, chanToTDCToIDEMap, chargeDepositVec, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
+        if (!hitVec.empty()) matchHitSim(clockData, hitVec, truthIndex, chargeDepositVec, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
     }
 
     return;
@@ -793,7 +834,7 @@ void SpacePointAnalysisMC::compareHitsToSim(const art::Event&        event,
 
 void SpacePointAnalysisMC::matchHitSim(const detinfo::DetectorClocksData& clockData,
                                      const HitPointerVec&               hitPointerVec,                  // Hits to match to simulation
-                                     const ChanToTDCToIDEMap&           chanToTDCToIDEMap,              // This gives us ability to retrieve total charge deposits
+                                     const icarus::SimChannelTruthIndex& truthIndex,                    // This gives us ability to retrieve total charge deposits
                                      const ChargeDepositVec&            chargeDepositVec,               // Charge deposit for specific track
                                      const ChanToTDCIDEMap&             chanToTDCIDEMap,                // Charge deposit for specific track
                                      const IDEToVoxelIDMap&             ideToVoxelIDMap,                // Mapping of ide info to voxels
@@ -885,14 +926,12 @@ void SpacePointAnalysisMC::matchHitSim(const detinfo::DetectorClocksData& clockD
             int   bestTicks(lastSimTick - firstSimTick + 1);
 
             // We want to get the total energy deposit from all particles in the ticks for this hit
-            const TDCToIDEMap& tdcToIDEMap = chanToTDCToIDEMap.find(hit->Channel())->second;
-            for(const auto& tdcToIDEPair : tdcToIDEMap)
+            for(const auto& deposit : truthIndex.channel(hit->Channel()))
             {
-                for(const auto& ide : tdcToIDEPair.second)
-                {
-                    totDepEne       += ide->energy;
-                    totNumElectrons += ide->numElectrons;
-                }
+                if (deposit->ide->energy < fSimChannelMinEnergy) continue;
+
+                totDepEne       += deposit->ide->energy;
+                totNumElectrons += deposit->ide->numElectrons;
             }
 
             // One final time through to find sim ticks that "matter"
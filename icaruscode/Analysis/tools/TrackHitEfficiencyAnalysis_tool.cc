@@ -1,4 +1,5 @@
 #include "icaruscode/Analysis/tools/IHitEfficiencyHistogramTool.h"
+#include "icaruscode/Analysis/tools/SimChannelTruthIndex.h"
 
 #include "fhiclcpp/ParameterSet.h"
 #include "art/Utilities/ToolMacros.h"
@@ -16,6 +17,8 @@
 
 #include "lardataobj/RawData/RawDigit.h"
 #include "lardataobj/RecoBase/Wire.h"
+#include "icaruscode/IcarusObj/ChannelROI.h"
+#include "icaruscode/TPC/Utilities/ChannelROIWireView.h"
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/Simulation/SimChannel.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
@@ -100,6 +103,7 @@ public:
      *  @brief Interface for filling histograms
      */
     void fillHistograms(const art::Event&)  const override;
+    void fillHistograms(const art::Event&, icarus::SimChannelTruthIndexSet<art::Event>&)  const override;
     
 private:
     
@@ -390,6 +394,14 @@ void TrackHitEfficiencyAnalysis::clear() const
 }
 
 void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
+{
+    // Without indices shared by the module, this tool builds its own
+    icarus::SimChannelTruthIndexSet<art::Event> truthIndices(event);
+
+    fillHistograms(event, truthIndices);
+}
+
+void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event, icarus::SimChannelTruthIndexSet<art::Event>& truthIndices) const
 {
    // std::cout << " filling histos " << std::endl;
     // Basic assumption is that the producer label vecs for RawDigits and Wire data are
@@ -399,51 +411,32 @@ void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
     // Always clear the tuple
     clear();
     
-    art::Handle< std::vector<sim::SimChannel>> simChannelHandle;
-    event.getByLabel(fSimChannelProducerLabel, simChannelHandle);
+    // The truth index relates particles (track id's) to the channels and tdc ranges where they deposit energy (or
+    // electrons), and to their MCParticle; it is built once for this event, and shared with the other tools
+    const icarus::SimChannelTruthIndex* truthIndex =
+        truthIndices.get(fSimChannelProducerLabel, fMCParticleProducerLabel);
     
     art::Handle< std::vector<simb::MCParticle>> mcParticleHandle;
     event.getByLabel(fMCParticleProducerLabel, mcParticleHandle);
 
     // If there is no sim channel informaton then exit
-    if (!simChannelHandle.isValid() || simChannelHandle->empty() || !mcParticleHandle.isValid()) return;
+    if (!truthIndex || truthIndex->nSimChannels() == 0 || !mcParticleHandle.isValid()) return;
     
-    // There are several things going on here... for each channel we have particles (track id's) depositing energy in a range to ticks
-    // So... for each channel we want to build a structure that relates particles to tdc ranges and deposited energy (or electrons)
-    // Here is a complicated structure:
-//    using TDCToIDEMap             = std::map<unsigned short, sim::IDE>; // We need this one in order
-//    using ChanToTDCToIDEMap       = std::map<raw::ChannelID_t, TDCToIDEMap>;
+    // For each channel of a particle we keep the deposits above threshold, in tdc order
     using TDCIDEPair              = std::pair<unsigned short, const sim::IDE*>;
     using TickTDCIDEVec           = std::vector<TDCIDEPair>;
-    using ChanToTDCIDEMap         = std::unordered_map<raw::ChannelID_t,TickTDCIDEVec>;
-    using PartToChanToTDCToIDEMap = std::unordered_map<int, ChanToTDCIDEMap>;
     
-    PartToChanToTDCToIDEMap partToChanToTDCToIDEMap;
-    
-    // Build out the above data structure
-    for(const auto& simChannel : *simChannelHandle)
-    {
-        raw::ChannelID_t channel = simChannel.Channel();
-
-        for(const auto& tdcide : simChannel.TDCIDEMap())
-        {
-            for(const auto& ide : tdcide.second) //chanToTDCToIDEMap[simChannel.Channel()][tdcide.first] = ide;
-            {
-                if (ide.energy < fSimChannelMinEnergy) continue;
-                
-                partToChanToTDCToIDEMap[ide.trackID][channel].emplace_back(tdcide.first,&ide);
-                
-                if (ide.energy < std::numeric_limits<float>::epsilon()) mf::LogDebug("SpacePointAnalysis") << ">> epsilon simchan deposited energy: " << ide.energy << std::endl;
-            }
-        }
-    }
+    TickTDCIDEVec tdcToIDEVec;
     
     // what needs to be done?
     // First we define a straightforward channel to Wire map so we can look up a given
     // channel's Wire data as we loop over SimChannels.
-    using ChanToWireMap = std::unordered_map<raw::ChannelID_t,const recob::Wire*>;
+    // When a producer made recob::ChannelROI rather than recob::Wire, they are read directly through a view
+    using ChanToWireMap     = std::unordered_map<raw::ChannelID_t,const recob::Wire*>;
+    using ChanToWireViewMap = std::unordered_map<raw::ChannelID_t,recob::ChannelROIWireView>;
     
-    ChanToWireMap channelToWireMap;
+    ChanToWireMap     channelToWireMap;
+    ChanToWireViewMap channelToWireViewMap;
     
     // We will use the presence of a RawDigit as an indicator of a good channel... So
     // we want a mapping between channel and RawDigit
@@ -464,9 +457,19 @@ void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
         art::Handle< std::vector<recob::Wire> > wireHandle;
         event.getByLabel(fWireProducerLabelVec[tpcID], wireHandle);
 
-        if (!rawDigitHandle.isValid() || !wireHandle.isValid()) return;
+        art::Handle< std::vector<recob::ChannelROI> > channelROIHandle;
+        if (!wireHandle.isValid()) event.getByLabel(fWireProducerLabelVec[tpcID], channelROIHandle);
+
+        if (!rawDigitHandle.isValid() || (!wireHandle.isValid() && !channelROIHandle.isValid())) return;
         
-        for(const auto& wire : *wireHandle) channelToWireMap[wire.Channel()] = &wire;
+        if (wireHandle.isValid())
+        {
+            for(const auto& wire : *wireHandle) channelToWireMap[wire.Channel()] = &wire;
+        }
+        else
+        {
+            for(const auto& channelROI : *channelROIHandle) channelToWireViewMap.insert_or_assign(channelROI.Channel(), recob::ChannelROIWireView(channelROI));
+        }
         
         for(const auto& rawDigit : *rawDigitHandle) chanToRawDigitMap[rawDigit.Channel()] = &rawDigit;
     }
@@ -485,14 +488,6 @@ void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
         for(const auto& hit : *hitHandle) channelToHitVec[hit.Channel()].push_back(&hit);
     }
     
-    // It is useful to create a mapping between trackID and MCParticle
-    using TrackIDToMCParticleMap = std::unordered_map<int, const simb::MCParticle*>;
-    
-    TrackIDToMCParticleMap trackIDToMCParticleMap;
-    
-    for(const auto& mcParticle : *mcParticleHandle)
-      trackIDToMCParticleMap[mcParticle.TrackId()] = &mcParticle;
-    
     const lariov::ChannelStatusProvider& chanFilt = art::ServiceHandle<lariov::ChannelStatusService>()->GetProvider();
     
     std::vector<int> nSimChannelHitVec  = {0,0,0};
@@ -504,21 +499,21 @@ void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
     
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
 
-    for(const auto& partToChanInfo : partToChanToTDCToIDEMap)
+    for(const auto& trackDeposits : truthIndex->tracks())
     {
-        TrackIDToMCParticleMap::const_iterator trackIDToMCPartItr = trackIDToMCParticleMap.find(partToChanInfo.first);
+        const simb::MCParticle* mcParticle = truthIndex->particle(trackDeposits.trackID);
         
-        if (trackIDToMCPartItr == trackIDToMCParticleMap.end()) continue;
+        if (!mcParticle) continue;
         
-        int         trackPDGCode = trackIDToMCPartItr->second->PdgCode();
-        std::string processName  = trackIDToMCPartItr->second->Process();
+        int         trackPDGCode = mcParticle->PdgCode();
+        std::string processName  = mcParticle->Process();
 
         // Looking for primary muons (e.g. CR Tracks)
         if (fabs(trackPDGCode) != 13 || processName != "primary") continue;
 
         // Recover particle position and angle information
-        Eigen::Vector3f partStartPos(trackIDToMCPartItr->second->Vx(),trackIDToMCPartItr->second->Vy(),trackIDToMCPartItr->second->Vz());
-        Eigen::Vector3f partStartDir(trackIDToMCPartItr->second->Px(),trackIDToMCPartItr->second->Py(),trackIDToMCPartItr->second->Pz());
+        Eigen::Vector3f partStartPos(mcParticle->Vx(),mcParticle->Vy(),mcParticle->Vz());
+        Eigen::Vector3f partStartDir(mcParticle->Px(),mcParticle->Py(),mcParticle->Pz());
         
         partStartDir.normalize();
         
@@ -530,16 +525,30 @@ void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
         // then we want to keep a running position
         std::vector<Eigen::Vector3f> lastPositionVec = {partStartPos,partStartPos,partStartPos};
 
-        for(const auto& chanToTDCToIDEMap : partToChanInfo.second)
+        for(const auto& chanDeposits : trackDeposits.channels)
         {
+            tdcToIDEVec.clear();
+            
+            for(const auto& deposit : chanDeposits.deposits)
+            {
+                if (deposit.ide->energy < fSimChannelMinEnergy) continue;
+                
+                tdcToIDEVec.emplace_back(deposit.tdc,deposit.ide);
+                
+                if (deposit.ide->energy < std::numeric_limits<float>::epsilon()) mf::LogDebug("SpacePointAnalysis") << ">> epsilon simchan deposited energy: " << deposit.ide->energy << std::endl;
+            }
+            
+            // Channels with no deposit above threshold are not considered
+            if (tdcToIDEVec.empty()) continue;
+            
             // skip bad channels
             if (fUseBadChannelDB)
             {
                 // This is the "correct" way to check and remove bad channels...
-                if( chanFilt.Status(chanToTDCToIDEMap.first) < fMinAllowedChanStatus)
+                if( chanFilt.Status(chanDeposits.channel) < fMinAllowedChanStatus)
                 {
-                std::vector<geo::WireID> wids = fGeometry->ChannelToWire(chanToTDCToIDEMap.first);
-                std::cout << "*** skipping bad channel with status: " << chanFilt.Status(chanToTDCToIDEMap.first) << " for channel: " << chanToTDCToIDEMap.first << ", plane: " << wids[0].Plane << ", wire: " << wids[0].Wire    << std::endl;
+                std::vector<geo::WireID> wids = fGeometry->ChannelToWire(chanDeposits.channel);
+                std::cout << "*** skipping bad channel with status: " << chanFilt.Status(chanDeposits.channel) << " for channel: " << chanDeposits.channel << ", plane: " << wids[0].Plane << ", wire: " << wids[0].Wire    << std::endl;
                     continue;
                 }
             }
@@ -549,11 +558,11 @@ void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
             if (badChannelHandle.isValid())
             {
                 // Here we query the input list from the wirecell processing
-                std::vector<int>::const_iterator badItr = std::find(badChannelHandle->begin(),badChannelHandle->end(),chanToTDCToIDEMap.first);
+                std::vector<int>::const_iterator badItr = std::find(badChannelHandle->begin(),badChannelHandle->end(),chanDeposits.channel);
     
                 if (badItr != badChannelHandle->end()) continue;
                 //            {
-                //                ChanToRawDigitMap::const_iterator rawDigitItr = chanToRawDigitMap.find(chanToTDCToIDEMap.first);
+                //                ChanToRawDigitMap::const_iterator rawDigitItr = chanToRawDigitMap.find(chanDeposits.channel);
                 //
                 //                if (rawDigitItr != chanToRawDigitMap.end())
                 //                {
@@ -565,26 +574,22 @@ void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
                 //
                 //                    getTruncatedMeanRMS(rawDigitItr->second->ADCs(), nSig, mean, rmsFull, rmsTrunc, nTrunc);
                 //
-                //                    std::cout << "--> Rejecting channel: " << chanToTDCToIDEMap.first << " from bad channel list, rms: " << rmsFull << std::endl;
+                //                    std::cout << "--> Rejecting channel: " << chanDeposits.channel << " from bad channel list, rms: " << rmsFull << std::endl;
                 //                }
                 //
                 //                continue;
                 //            }
             }
         
-            TickTDCIDEVec  tdcToIDEVec = chanToTDCToIDEMap.second;
             float          totalElectrons(0.);
             float          maxElectrons(0.);
             unsigned short maxElectronsTDC(0);
             int            nMatchedWires(0);
             int            nMatchedHits(0);
-
-            // Make sure the vector is time ordered
-            std::sort(tdcToIDEVec.begin(),tdcToIDEVec.end(),[](const auto& left, const auto& right){return left.first < right.first;});
         
             // The below try-catch block may no longer be necessary
             // Decode the channel and make sure we have a valid one
-            std::vector<geo::WireID> wids = fGeometry->ChannelToWire(chanToTDCToIDEMap.first);
+            std::vector<geo::WireID> wids = fGeometry->ChannelToWire(chanDeposits.channel);
         
             // Recover plane and wire in the plane
             unsigned int plane = wids[0].Plane;
@@ -662,36 +667,36 @@ void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
             unsigned short hitStopTickBest(0);
             unsigned short hitStartTickBest(0);
         
-            // Start by recovering the Wire associated to this channel
-            ChanToWireMap::const_iterator wireItr = channelToWireMap.find(chanToTDCToIDEMap.first);
+            // Start by recovering the Wire associated to this channel, either as recob::Wire or as a
+            // view of the recob::ChannelROI when that is what the producer made
+            ChanToWireMap::const_iterator     wireItr = channelToWireMap.find(chanDeposits.channel);
+            ChanToWireViewMap::const_iterator viewItr = channelToWireViewMap.find(chanDeposits.channel);
             
-            if (wireItr != channelToWireMap.end())
+            if (wireItr != channelToWireMap.end() || viewItr != channelToWireViewMap.end())
             {
-                const recob::Wire::RegionsOfInterest_t&       signalROI = wireItr->second->SignalROI();
-                const lar::sparse_vector<float>::datarange_t* wireRangePtr(NULL);
-                
                 // Here we need to match the range of the ROI's on the given Wire with the tick range from the SimChannel
-                for(const auto& range : signalROI.get_ranges())
+                auto overlapsROI = [startTick,stopTick](const auto& ranges)
                 {
-                    // #################################################
-                    // ### Getting a vector of signals for this wire ###
-                    // #################################################
-                    //std::vector<float> signal(wire->Signal());
-                    
-                    const std::vector<float>& signal          = range.data();
-                    raw::TDCtick_t            roiFirstBinTick = range.begin_index();
-                    raw::TDCtick_t            roiLastBinTick  = roiFirstBinTick + signal.size();
-                    
-                    // If no overlap then go to next
-                    if (roiFirstBinTick > stopTick || roiLastBinTick < startTick) continue;
-                    
-                    wireRangePtr = &range;
-                    break;
-                }
+                    for(const auto& range : ranges)
+                    {
+                        raw::TDCtick_t roiFirstBinTick = range.begin_index();
+                        raw::TDCtick_t roiLastBinTick  = roiFirstBinTick + range.size();
+            
+                        // If no overlap then go to next
+                        if (roiFirstBinTick > stopTick || roiLastBinTick < startTick) continue;
+            
+                        return true;
+                    }
+            
+                    return false;
+                };
+            
+                bool foundROI = wireItr != channelToWireMap.end() ? overlapsROI(wireItr->second->SignalROI().get_ranges())
+                                                                  : overlapsROI(viewItr->second.get_ranges());
                 
                 // Check that we have found the wire range
                 // Note that if we have not matched an ROI then we can't have a hit either so skip search for that...
-                if (wireRangePtr)
+                if (foundROI)
                 {
                     const recob::Hit* rejectedHit = 0;
                     const recob::Hit* bestHit     = 0;
@@ -700,7 +705,7 @@ void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
                     
                     // The next mission is to recover the hits associated to this Wire
                     // The easiest way to do this is to simply look up all the hits on this channel and then match
-                    ChanToHitVecMap::iterator hitIter = channelToHitVec.find(chanToTDCToIDEMap.first);
+                    ChanToHitVecMap::iterator hitIter = channelToHitVec.find(chanDeposits.channel);
                     
                     if (hitIter != channelToHitVec.end())
                     {
@@ -793,7 +798,7 @@ void TrackHitEfficiencyAnalysis::fillHistograms(const art::Event& event) const
                             unsigned short hitStopTick  = rejectedHit->PeakTime() + fSigmaVec[plane] * rejectedHit->RMS();
         
                             mf::LogDebug("TrackHitEfficiencyAnalysis") << "**> TPC: " << rejectedHit->WireID().TPC << ", Plane " << rejectedHit->WireID().Plane << ", wire: " << rejectedHit->WireID().Wire << ", hit startstop            tick: " << hitStartTick << "/" << hitStopTick << ", start/stop ticks: " << startTick << "/" << stopTick << std::endl;
-                            mf::LogDebug("TrackHitEfficiencyAnalysis") << "    TPC/Plane/Wire: " << wids[0].TPC << "/" << plane << "/" << wids[0].Wire << ", Track # hits: " << partToChanInfo.second.size() << ", # hits: "<<         hitIter->second.size() << ", # electrons: " << totalElectrons << ", pulse Height: " << rejectedHit->PeakAmplitude() << ", charge: " << rejectedHit->Integral()      << ", " <<rejectedHit->SummedADC() << std::endl;
+                            mf::LogDebug("TrackHitEfficiencyAnalysis") << "    TPC/Plane/Wire: " << wids[0].TPC << "/" << plane << "/" << wids[0].Wire << ", Track # hits: " << trackDeposits.channels.size() << ", # hits: "<<         hitIter->second.size() << ", # electrons: " << totalElectrons << ", pulse Height: " << rejectedHit->PeakAmplitude() << ", charge: " << rejectedHit->Integral()      << ", " <<rejectedHit->SummedADC() << std::endl;
                         }
                         else
                         {
@@ -238,6 +238,9 @@ void CRTAutoVeto::analyze(art::Event const& ev)
     fDist.clear();
     fDelay.clear();
 
+    //Intitialize CRTBackTracker
+    bt->Initialize(ev);
+
     //loop over CRTHits
     for(auto const& hit : crthits) {
        std::cout << "found hit in region, " << hit.tagger << std::endl; 
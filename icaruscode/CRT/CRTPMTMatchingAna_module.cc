@@ -37,6 +37,7 @@
 #include "sbnobj/Common/CRT/CRTTrack.hh"
 #include "icaruscode/CRT/CRTUtils/CRTCommonUtils.h"
 #include "icaruscode/CRT/CRTUtils/CRTBackTracker.h"
+#include "icaruscode/CRT/CRTUtils/CRTPMTMatchingAlg.h"
 #include "sbnobj/Common/Trigger/ExtraTriggerInfo.h"
 
 //C++ includes
@@ -118,6 +119,8 @@ private:
   //  CRTBackTracker* bt;
   CRTCommonUtils *crtutil;
 
+  CRTPMTMatchingAlg fMatchAlg;  ///< time matching of CRT hits with flashes and OpHits
+
   map<int,art::InputTag> fFlashLabels;
 
   TTree* fMatchTree;
@@ -172,6 +175,7 @@ icarus::crt::CRTPMTMatchingAna::CRTPMTMatchingAna(fhicl::ParameterSet const& p)
   ,fHitVelocityMin(p.get<double>("HitVelocityMin",1.))
    // bt(new CRTBackTracker(p.get<fhicl::ParameterSet>("CRTBackTrack"))),
   ,crtutil(new CRTCommonUtils())
+  ,fMatchAlg(fFlashPeThresh, fHitPeThresh, fCoinWindow)
   // More initializers here.
 {
   // Call appropriate consumes<>() for any products to be retrieved by this module.
@@ -285,6 +289,54 @@ void icarus::crt::CRTPMTMatchingAna::analyze(art::Event const& e)
 
   fNCrt = crtHitList.size();
 
+  // position of the optical detector of an OpHit
+  auto opDetCenter = [this](int opChannel) {
+    CRTPMTMatchingAlg::Position_t pos;
+    fGeometryService->OpDetGeoFromOpChannel(opChannel).GetCenter(pos.data());
+    return pos;
+  };
+
+  // Describe flashes and OpHits once for the matching of all the CRT hits:
+  // flashes in the order of the flash lists, with their barycentre and their
+  // earliest OpHit, looked up once per flash list
+  if(!crtHitList.empty()) {
+
+    std::vector<CRTPMTMatchingAlg::FlashInfo> flashes;
+    for(auto const& flashList : opFlashLists) {
+
+      art::FindManyP<recob::OpHit> findManyHits(flashHandles[flashList.first], e, fFlashLabels[flashList.first]);
+
+      for(size_t iflash=0; iflash<flashList.second.size(); iflash++) {
+
+        auto const& flash = flashList.second[iflash];
+        CRTPMTMatchingAlg::FlashInfo info{ flash->Time(), flash->TotalPE(), { 0., flash->YCenter(), flash->ZCenter() }, flashList.first };
+
+        // flashes below threshold are never matched, their hits are not needed
+        if(flash->TotalPE()>=fFlashPeThresh) {
+          for(auto const& hit : findManyHits.at(iflash)) {
+            double tPmt = hit->PeakTime();
+            if(tPmt < info.firstHit.time) {
+              info.firstHit = { tPmt, hit->PE(), opDetCenter(hit->OpChannel()) };
+              info.hasHits = true;
+            }
+          }
+        }
+
+        flashes.push_back(info);
+      }//for OpFlash in this flash list
+    }//for flash lists
+    fMatchAlg.SetFlashes(std::move(flashes));
+
+    std::vector<CRTPMTMatchingAlg::OpHitInfo> opHits;
+    opHits.reserve(opHitList.size());
+    for(auto const& hit : opHitList) {
+      CRTPMTMatchingAlg::OpHitInfo info{ hit->PeakTime(), hit->PE(), { 0., 0., 0. } };
+      if(hit->PE()>=fHitPeThresh) info.position = opDetCenter(hit->OpChannel());
+      opHits.push_back(info);
+    }
+    fMatchAlg.SetOpHits(std::move(opHits));
+  }
+
   for(auto const& crt : crtHitList){
     vector<double> xyzt, xyzerr;
     TVector3 rcrt(crt->x_pos,crt->y_pos,crt->z_pos);
@@ -314,69 +366,43 @@ void icarus::crt::CRTPMTMatchingAna::analyze(art::Event const& e)
     fCrtRegion.push_back(crtutil->AuxDetRegionNameToNum(crt->tagger));
 
     // -- flash match --
+    // unmatched quantities are stored as DBL_MAX
     int matchtpc = -1;
     double tdiff = DBL_MAX, rdiff=DBL_MAX, peflash=DBL_MAX;
-    bool matched=false;
     xyzt.clear();
     double flashHitT = DBL_MAX, flashHitPE=DBL_MAX, flashHitDiff=DBL_MAX;
     vector<double> flashHitxyzt;
 
-    for(auto const& flashList : opFlashLists) {
-
-      art::FindManyP<recob::OpHit> findManyHits(flashHandles[flashList.first], e, fFlashLabels[flashList.first]);
-
-      for(size_t iflash=0; iflash<flashList.second.size(); iflash++) {
-
-	auto const& flash = flashList.second[iflash];
-	if(flash->TotalPE()<fFlashPeThresh){
-	  continue;
-	}
-
-	double tflash = flash->Time();//*1e3;//-fOpDelay;
-
-	TVector3 rflash(0,flash->YCenter(),flash->ZCenter());
-	TVector3 vdiff = rcrt-rflash;
-	//std::cout << "flash time: "<<flash->Time() << " absdiff : "<< abs(tcrt-tflash)<< std::endl;
-	if(abs(tcrt-tflash)<abs(tdiff)) {
-	  peflash = flash->TotalPE();
-	  tdiff = tcrt-tflash;
-	  rdiff = vdiff.Mag();
-	  xyzt.clear();
-	  xyzt.push_back(rflash.X());
-	  xyzt.push_back(rflash.Y());
-	  xyzt.push_back(rflash.Z());
-	  xyzt.push_back(tflash);
-	  matched = true;
-	  matchtpc = flashList.first;
-
-	  vector<art::Ptr<recob::OpHit>> hits = findManyHits.at(iflash);
-	  for(auto const& hit : hits) {
-	    double tPmt = hit->PeakTime();//*1.e3;//-fOpDelay;
-	    if( tPmt < flashHitT) {
-	      flashHitT = tPmt;
-	      flashHitPE = hit->PE();
-	      //FlashHit position/time
-	      double pos[3];
-	      fGeometryService->OpDetGeoFromOpChannel(hit->OpChannel()).GetCenter(pos);
-	      flashHitxyzt.clear();
-	      for(int i=0; i<3; i++) flashHitxyzt.push_back(pos[i]);
-	      flashHitxyzt.push_back(flashHitT);
-
-	      //FlashHit distance
-	      TVector3 rflashHit(pos[0],pos[1],pos[2]);
-	      TVector3 vdiffHit = rcrt-rflashHit;
-	      flashHitDiff = vdiffHit.Mag();
-	    }
-	  }//loop over flash hits
-	}//if minimum tdiff
-      }//for OpFlash in this flash list
-    }//for flash lists
-    if(!matched) {
-      peflash = DBL_MAX;
+    CRTPMTMatchingAlg::FlashMatch const flashMatch = fMatchAlg.MatchFlash(tcrt);
+
+    if(flashMatch.matched()) {
+      auto const& flash = fMatchAlg.Flashes()[flashMatch.flash];
+      TVector3 rflash(flash.barycentre[0],flash.barycentre[1],flash.barycentre[2]);
+      TVector3 vdiff = rcrt-rflash;
+      peflash = flash.totalPE;
+      tdiff = tcrt-flash.time;
+      rdiff = vdiff.Mag();
+      xyzt = { rflash.X(), rflash.Y(), rflash.Z(), flash.time };
+      matchtpc = flash.tpc;
+    }
+    else {
       for(int i=0; i<4; i++) xyzt.push_back(DBL_MAX);
     }
 
-    fMatchFlash.push_back(matched);
+    if(flashMatch.hasFirstHit()) {
+      auto const& hit = fMatchAlg.Flashes()[flashMatch.firstHitFlash].firstHit;
+      flashHitT = hit.time;
+      flashHitPE = hit.pe;
+      //FlashHit position/time
+      flashHitxyzt = { hit.position[0], hit.position[1], hit.position[2], flashHitT };
+
+      //FlashHit distance
+      TVector3 rflashHit(hit.position[0],hit.position[1],hit.position[2]);
+      TVector3 vdiffHit = rcrt-rflashHit;
+      flashHitDiff = vdiffHit.Mag();
+    }
+
+    fMatchFlash.push_back(flashMatch.matched());
     fTofFlash.push_back(tdiff);
     fTofPeFlash.push_back(peflash);
     fTofXYZTFlash.push_back(xyzt);
@@ -388,47 +414,29 @@ void icarus::crt::CRTPMTMatchingAna::analyze(art::Event const& e)
     fDistFlashHit.push_back(flashHitDiff);
 
     // -- match OpHits to CRTHits --
+    // the OpHit with the most PE within the coincidence window
     tdiff = DBL_MAX;
-    matched = false;
     peflash = DBL_MAX;
     rdiff = DBL_MAX;
     xyzt.clear();
 
-    double pemax = 0.;
-    for(auto const& hit : opHitList) {
-      double thit = hit->PeakTime();//*1e3-fOpDelay;
-      if(hit->PE()<fHitPeThresh){
-	continue;
-      }
-
-
-      //if(abs(tcrt-thit)<abs(tdiff)) {
-      if(abs(tcrt-thit)<fCoinWindow && hit->PE()>pemax) {
-	pemax = hit->PE();
-
-	//hitXYZT
-	double pos[3];
-	fGeometryService->OpDetGeoFromOpChannel(hit->OpChannel()).GetCenter(pos);
-
-	//distHit
-	TVector3 rhit (pos[0],pos[1],pos[2]);
-	TVector3 vdiff = rcrt-rhit;
-	rdiff = vdiff.Mag();
-	peflash = hit->PE();
-	tdiff = tcrt-thit;
-	xyzt.clear();
-	for(int i=0; i<3; i++) xyzt.push_back(pos[i]);
-	xyzt.push_back(thit);
-
-	matched = true;
-	std::cout << "thit: "<<thit << " , tcrt: " << tcrt << " , tdiff " << tdiff  << std::endl;
-      }//if min tof
-    }//for OpHits
-    if(!matched) {
-      tdiff = DBL_MAX;
-      peflash = DBL_MAX;
-      rdiff = DBL_MAX;
-      xyzt.clear();
+    std::size_t const ihit = fMatchAlg.MatchOpHit(tcrt);
+    bool const matched = ihit != CRTPMTMatchingAlg::NoMatch;
+
+    if(matched) {
+      auto const& hit = fMatchAlg.OpHits()[ihit];
+
+      //distHit
+      TVector3 rhit (hit.position[0],hit.position[1],hit.position[2]);
+      TVector3 vdiff = rcrt-rhit;
+      rdiff = vdiff.Mag();
+      peflash = hit.pe;
+      tdiff = tcrt-hit.time;
+      xyzt = { hit.position[0], hit.position[1], hit.position[2], hit.time };
+
+      MF_LOG_DEBUG("CRTPMTMatching: ") << "thit: " << hit.time << " , tcrt: " << tcrt << " , tdiff " << tdiff;
+    }
+    else {
       for(int i=0; i<4; i++) xyzt.push_back(DBL_MAX);
     }
     fMatchHit.push_back(matched);
@@ -557,7 +557,7 @@ namespace crt {
     fSubRun = event.subRun();
 
     //CRTBackTracker matches CRTProducts to the true trackIDs
-    //bt.Initialize(event);
+    bt.Initialize(event);
 
     // Define "handle" to Generator level MCTruth objects
     art::Handle< vector<simb::MCTruth>> genHandle;
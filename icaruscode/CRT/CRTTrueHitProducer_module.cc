@@ -114,9 +114,9 @@ void icarus::crt::CRTTrueHitProducer::produce(art::Event & event)
   
     vector<std::pair<CRTHit, vector<AuxDetIDE>>> crtHitPairs = hitAlg.CreateCRTHits(adscList);
   
-    for(auto const& crtHitPair : crtHitPairs){
+    for(auto& crtHitPair : crtHitPairs){
   
-        CRTHitcol->push_back(crtHitPair.first);
+        CRTHitcol->push_back(std::move(crtHitPair.first));
         art::Ptr<CRTHit> hitPtr = makeHitPtr(CRTHitcol->size()-1);
         nHits++;
   
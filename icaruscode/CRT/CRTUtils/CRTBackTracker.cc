@@ -1,5 +1,22 @@
 #include "icaruscode/CRT/CRTUtils/CRTBackTracker.h"
 
+// c++
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+    // Like getValidHandle(), but returning a plain handle
+    template <typename T>
+    art::Handle<std::vector<T>> GetRequiredHandle(const art::Event& event, const art::InputTag& label){
+        auto handle = event.getHandle<std::vector<T>>(label);
+        if(!handle.isValid()) throw *handle.whyFailed();
+        return handle;
+    }
+
+}// local namespace
+
+
 namespace icarus{
  namespace crt{
 
@@ -18,6 +35,13 @@ namespace icarus{
         fCRTSimHitLabel = config.CRTSimHitLabel();
         fCRTTrackLabel = config.CRTTrackLabel();
         fRollupUnsavedIds = config.RollupUnsavedIds();
+
+        // The indices depend on the configuration
+        fIndexEvent.reset();
+        fDataIndex = {};
+        fTrueHitIndex = {};
+        fSimHitIndex = {};
+        fTrackIndex = {};
       
         return;
     }
@@ -28,6 +52,7 @@ namespace icarus{
         bool findData = false, findSimHit = false;
  
         // Clear those data structures!
+        fIndexEvent.reset();
         fTrueHitTrueIds.clear();
         fDataTrueIds.clear();
         fSimHitTrueIds.clear();
@@ -145,295 +170,281 @@ namespace icarus{
         }//if CRTrack product found
         else
             mf::LogWarning("CRTBackTracker") << "no CRTTrack products found";
+
+        // Index the same products for the queries by content
+        fDataIndex = crtDataHandle.isValid()? BuildDataIndex(event, crtDataHandle): ProductIndex<CRTData>{};
+        fTrueHitIndex = crtTrueHitHandle.isValid()? BuildTrueHitIndex(event, crtTrueHitHandle): ProductIndex<CRTHit>{};
+        fSimHitIndex = crtSimHitHandle.isValid()
+          ? BuildSimHitIndex(event, crtSimHitHandle, fDataIndex): ProductIndex<CRTHit>{};
+        fTrackIndex = crtTrackHandle.isValid()
+          ? BuildTrackIndex(event, crtTrackHandle, fSimHitIndex, fDataIndex): ProductIndex<CRTTrack>{};
+        fIndexEvent = event.id();
       
     }//Initialize
 
     // ---------------------------------------------------------------------------------------    
     // Check that two CRT data products are the same
     bool CRTBackTracker::DataCompare(const CRTData& data1, const CRTData& data2){
-    
-      if(data1.fMac5  != data2.fMac5)  return false;
-      if(data1.fTs0   != data2.fTs0)   return false;
-      if(data1.fTs1   != data2.fTs1)   return false;
-      if(data1.fEntry != data2.fEntry) return false;
-      for(int ch=0; ch<64; ch++) {
-          if(data1.fAdc[ch] != data2.fAdc[ch]) return false;
-      }
-    
-      return true;
+      return details::SameContent(data1, data2);
     }
 
     // ----------------------------------------------------------------------------------------    
     // Check that two CRT hits are the same
     bool CRTBackTracker::HitCompare(const CRTHit& hit1, const CRTHit& hit2){
-    
-      if(hit1.ts1_ns != hit2.ts1_ns) return false;
-      if(hit1.plane != hit2.plane) return false;
-      if(hit1.x_pos != hit2.x_pos) return false;
-      if(hit1.y_pos != hit2.y_pos) return false;
-      if(hit1.z_pos != hit2.z_pos) return false;
-      if(hit1.x_err != hit2.x_err) return false;
-      if(hit1.y_err != hit2.y_err) return false;
-      if(hit1.z_err != hit2.z_err) return false;
-      if(hit1.tagger != hit2.tagger) return false;
-    
-      return true;
+      return details::SameContent(hit1, hit2);
     }
 
     // -----------------------------------------------------------------------------------------    
     // Check that two CRT tracks are the same
     bool CRTBackTracker::TrackCompare(const CRTTrack& track1, const CRTTrack& track2){
-    
-      if(track1.ts1_ns != track2.ts1_ns) return false;
-      if(track1.plane1 != track2.plane1) return false;
-      if(track1.x1_pos != track2.x1_pos) return false;
-      if(track1.y1_pos != track2.y1_pos) return false;
-      if(track1.z1_pos != track2.z1_pos) return false;
-      if(track1.x1_err != track2.x1_err) return false;
-      if(track1.y1_err != track2.y1_err) return false;
-      if(track1.z1_err != track2.z1_err) return false;
-      if(track1.plane2 != track2.plane2) return false;
-      if(track1.x2_pos != track2.x2_pos) return false;
-      if(track1.y2_pos != track2.y2_pos) return false;
-      if(track1.z2_pos != track2.z2_pos) return false;
-      if(track1.x2_err != track2.x2_err) return false;
-      if(track1.y2_err != track2.y2_err) return false;
-      if(track1.z2_err != track2.z2_err) return false;
-    
-      return true;
+      return details::SameContent(track1, track2);
+    }
+
+    // --------------------------------------------------------------------------------------------
+    CRTBackTracker::ProductIndex<CRTBackTracker::CRTData> CRTBackTracker::DataIndex(const art::Event& event,
+                                                                                    const art::Handle<std::vector<CRTData>>& handle) const {
+
+      if(IsInitializedFor(event) && fDataIndex.IsFor(handle)) return fDataIndex;
+      return BuildDataIndex(event, handle);
+    }
+
+    // --------------------------------------------------------------------------------------------
+    CRTBackTracker::ProductIndex<CRTBackTracker::CRTHit> CRTBackTracker::TrueHitIndex(const art::Event& event,
+                                                                                      const art::Handle<std::vector<CRTHit>>& handle) const {
+
+      if(IsInitializedFor(event) && fTrueHitIndex.IsFor(handle)) return fTrueHitIndex;
+      return BuildTrueHitIndex(event, handle);
+    }
+
+    // --------------------------------------------------------------------------------------------
+    CRTBackTracker::ProductIndex<CRTBackTracker::CRTHit> CRTBackTracker::SimHitIndex(const art::Event& event,
+                                                                                     const art::Handle<std::vector<CRTHit>>& handle) const {
+
+      if(IsInitializedFor(event) && fSimHitIndex.IsFor(handle)) return fSimHitIndex;
+      return BuildSimHitIndex(event, handle, OptionalDataIndex(event));
+    }
+
+    // --------------------------------------------------------------------------------------------
+    CRTBackTracker::ProductIndex<CRTBackTracker::CRTTrack> CRTBackTracker::TrackIndex(const art::Event& event,
+                                                                                      const art::Handle<std::vector<CRTTrack>>& handle) const {
+
+      if(IsInitializedFor(event) && fTrackIndex.IsFor(handle)) return fTrackIndex;
+
+      auto const dataIndex = OptionalDataIndex(event);
+      return BuildTrackIndex(event, handle, OptionalSimHitIndex(event, dataIndex), dataIndex);
+    }
+
+    // --------------------------------------------------------------------------------------------
+    CRTBackTracker::ProductIndex<CRTBackTracker::CRTData> CRTBackTracker::OptionalDataIndex(const art::Event& event) const {
+
+      auto const crtDataHandle = event.getHandle<std::vector<CRTData>>(fCRTDataLabel);
+      return crtDataHandle.isValid()? DataIndex(event, crtDataHandle): ProductIndex<CRTData>{};
+    }
+
+    // --------------------------------------------------------------------------------------------
+    CRTBackTracker::ProductIndex<CRTBackTracker::CRTHit> CRTBackTracker::OptionalSimHitIndex(const art::Event& event,
+                                                                                             const ProductIndex<CRTData>& dataIndex) const {
+
+      auto const crtSimHitHandle = event.getHandle<std::vector<CRTHit>>(fCRTSimHitLabel);
+      if(!crtSimHitHandle.isValid()) return {};
+      if(IsInitializedFor(event) && fSimHitIndex.IsFor(crtSimHitHandle)) return fSimHitIndex;
+      return BuildSimHitIndex(event, crtSimHitHandle, dataIndex);
+    }
+
+    // --------------------------------------------------------------------------------------------
+    CRTBackTracker::ProductIndex<CRTBackTracker::CRTData> CRTBackTracker::BuildDataIndex(const art::Event& event,
+                                                                                         const art::Handle<std::vector<CRTData>>& handle) const {
+
+      art::FindManyP<sim::AuxDetIDE> findManyIdes(handle, event, fCRTDataLabel);
+      std::vector<IdEnergies> truth(handle->size());
+
+      for(size_t data_i = 0; data_i < truth.size(); data_i++){
+          for(auto const& ide : findManyIdes.at(data_i))
+              truth[data_i].emplace_back(TrueId(*ide), ide->energyDeposited);
+      }
+
+      return { handle.id(), std::make_shared<details::CollectionIndex<CRTData> const>(*handle, std::move(truth)) };
+    }
+
+    // --------------------------------------------------------------------------------------------
+    CRTBackTracker::ProductIndex<CRTBackTracker::CRTHit> CRTBackTracker::BuildTrueHitIndex(const art::Event& event,
+                                                                                           const art::Handle<std::vector<CRTHit>>& handle) const {
+
+      art::FindManyP<sim::AuxDetIDE> findManyIdes(handle, event, fCRTTrueHitLabel);
+      std::vector<IdEnergies> truth(handle->size());
+
+      for(size_t hit_i = 0; hit_i < truth.size(); hit_i++){
+          for(auto const& ide : findManyIdes.at(hit_i))
+              truth[hit_i].emplace_back(TrueId(*ide), ide->energyDeposited);
+      }
+
+      return { handle.id(), std::make_shared<details::CollectionIndex<CRTHit> const>(*handle, std::move(truth)) };
+    }
+
+    // --------------------------------------------------------------------------------------------
+    CRTBackTracker::ProductIndex<CRTBackTracker::CRTHit> CRTBackTracker::BuildSimHitIndex(const art::Event& event,
+                                                                                          const art::Handle<std::vector<CRTHit>>& handle,
+                                                                                          const ProductIndex<CRTData>& dataIndex) const {
+
+      std::vector<art::Ptr<CRTHit>> hits;
+      art::fill_ptr_vector(hits, handle);
+
+      return { handle.id(), std::make_shared<details::CollectionIndex<CRTHit> const>
+                              (*handle, HitTruthFromData(event, fCRTSimHitLabel, hits, dataIndex)) };
+    }
+
+    // --------------------------------------------------------------------------------------------
+    CRTBackTracker::ProductIndex<CRTBackTracker::CRTTrack> CRTBackTracker::BuildTrackIndex(const art::Event& event,
+                                                                                           const art::Handle<std::vector<CRTTrack>>& handle,
+                                                                                           const ProductIndex<CRTHit>& simHitIndex,
+                                                                                           const ProductIndex<CRTData>& dataIndex) const {
+
+      art::FindManyP<CRTHit> findManyHits(handle, event, fCRTTrackLabel);
+      std::vector<IdEnergies> truth(handle->size());
+
+      for(size_t track_i = 0; track_i < truth.size(); track_i++){
+
+          std::vector<art::Ptr<CRTHit>> hits = findManyHits.at(track_i);
+
+          // Hits from the CRTSimHit collection have their truth already indexed
+          bool const indexed = simHitIndex.index && std::all_of(hits.begin(), hits.end(),
+            [&](const art::Ptr<CRTHit>& hit){ return hit.id() == simHitIndex.product; });
+
+          if(indexed){
+              for(auto const& hit : hits){
+                  const IdEnergies& hitTruth = simHitIndex.index->Truth(hit.key());
+                  truth[track_i].insert(truth[track_i].end(), hitTruth.begin(), hitTruth.end());
+              }
+          }
+          else{
+              for(auto const& hitTruth : HitTruthFromData(event, fCRTSimHitLabel, hits, dataIndex))
+                  truth[track_i].insert(truth[track_i].end(), hitTruth.begin(), hitTruth.end());
+          }
+      }
+
+      return { handle.id(), std::make_shared<details::CollectionIndex<CRTTrack> const>(*handle, std::move(truth)) };
+    }
+
+    // --------------------------------------------------------------------------------------------
+    std::vector<CRTBackTracker::IdEnergies> CRTBackTracker::HitTruthFromData(const art::Event& event, const art::InputTag& label,
+                                                                             const std::vector<art::Ptr<CRTHit>>& hits,
+                                                                             const ProductIndex<CRTData>& dataIndex) const {
+
+      art::FindManyP<CRTData> findManyData(hits, event, label);
+      std::vector<IdEnergies> truth(hits.size());
+
+      for(size_t hit_i = 0; hit_i < hits.size(); hit_i++){
+
+          std::vector<art::Ptr<CRTData>> data = findManyData.at(hit_i);
+
+          // Data from the CRTData collection have their truth already indexed
+          bool const indexed = dataIndex.index && std::all_of(data.begin(), data.end(),
+            [&](const art::Ptr<CRTData>& datum){ return datum.id() == dataIndex.product; });
+
+          if(indexed){
+              for(auto const& datum : data){
+                  const IdEnergies& dataTruth = dataIndex.index->Truth(datum.key());
+                  truth[hit_i].insert(truth[hit_i].end(), dataTruth.begin(), dataTruth.end());
+              }
+          }
+          else{
+              art::FindManyP<sim::AuxDetIDE> findManyIdes(data, event, fCRTDataLabel);
+              for(size_t i = 0; i < data.size(); i++){
+                  for(auto const& ide : findManyIdes.at(i))
+                      truth[hit_i].emplace_back(TrueId(*ide), ide->energyDeposited);
+              }
+          }
+      }
+
+      return truth;
+    }
+
+    // --------------------------------------------------------------------------------------------
+    int CRTBackTracker::TrueId(const sim::AuxDetIDE& ide) const {
+
+      int id = ide.trackID;
+      if(fRollupUnsavedIds) id = std::abs(id);
+      return id;
     }
 
     // --------------------------------------------------------------------------------------------    
     // Get all the true particle IDs that contributed to the CRT data product
     std::vector<int> CRTBackTracker::AllTrueIds(const art::Event& event, const CRTData& data){
     
-      std::vector<int> ids;
-    
-      // Get a handle to the CRT data in the event
-      auto crtDataHandle = event.getValidHandle<std::vector<CRTData>>(fCRTDataLabel);
-      art::FindManyP<sim::AuxDetIDE> findManyIdes(crtDataHandle, event, fCRTDataLabel);
+      auto const crtDataHandle = GetRequiredHandle<CRTData>(event, fCRTDataLabel);
+      auto const dataIndex = DataIndex(event, crtDataHandle).index;
     
       // Find which one matches the data passed to the function
-      int data_i = 0, index = 0;
-   
-      int nmatch=0; 
-      for(auto const& crtData : (*crtDataHandle)){
-    
-        if(DataCompare(crtData, data)) {
-            data_i = index;
-            nmatch++;
-        }
-    
-        index++;
-      }
-      if(nmatch==0) 
+      auto const match = dataIndex->Find(*crtDataHandle, data);
+
+      if(match.count==0) 
           mf::LogError("CRTBackTracker::AllTrueIds") << "no matches for provided CRTData product found!";
-      if(nmatch>1) 
+      if(match.count>1) 
           mf::LogError("CRTBackTracker::AllTrueIds") << "multiple matches for given CRTData product found!";
 
-      // Get all the true IDs from all the IDEs in the hit
-      std::vector<art::Ptr<sim::AuxDetIDE>> ides = findManyIdes.at(data_i);
-    
-      for(size_t i = 0; i < ides.size(); i++){
-    
-        int id = ides[i]->trackID;
-    
-        if(fRollupUnsavedIds) id = std::abs(id);
-    
-        ids.push_back(id);
-      }
-    
-      // Remove any repeated IDs
-      std::sort(ids.begin(), ids.end());
-      ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
-    
-      return ids;
+      return details::SortedIds(dataIndex->Truth(match.index));
     }
 
     // ---------------------------------------------------------------------------------------------    
     // Get all the true particle IDs that contributed to the sim CRT hit
     std::vector<int> CRTBackTracker::AllTrueIds(const art::Event& event, const CRTHit& hit){
     
-        std::vector<int> ids;
-      
-        // Get a handle to the CRT hits in the event
-        art::Handle< std::vector<CRTHit> > crtSimHitHandle;
-        art::Handle< std::vector<CRTHit> > crtTrueHitHandle;
- 
         // Find which one matches the hit passed to the function
-        int hit_i = -1, tmp_hit_i = -1, index = 0;
-        bool sim=false, findsim=false, findtrue=false;      
+        int hit_i = -1;
+        bool sim=false;
+        IndexPtr<CRTHit> simHitIndex, trueHitIndex;
 
         //try to get a handle to CRTSimHits
-        if(event.getByLabel(fCRTSimHitLabel,crtSimHitHandle)) {
-            findsim = true;
-            //find vector index matching the passed CRTHit
-            for(auto const& crtHit : (*crtSimHitHandle)){
-      
-                if(HitCompare(crtHit, hit)) tmp_hit_i = index;
-                index++;
-            }
-
-            if(tmp_hit_i!=-1) {
-                hit_i = tmp_hit_i;
-                tmp_hit_i=-1;
+        auto const crtSimHitHandle = event.getHandle<std::vector<CRTHit>>(fCRTSimHitLabel);
+        if(crtSimHitHandle.isValid()) {
+            simHitIndex = SimHitIndex(event, crtSimHitHandle).index;
+            auto const match = simHitIndex->Find(*crtSimHitHandle, hit);
+            if(match.count>0) {
+                hit_i = match.index;
                 sim=true;
             }
         }
 
         //try to get handle to CRTTrueHits
-        if(event.getByLabel(fCRTTrueHitLabel,crtTrueHitHandle)) {
-            findtrue = true;
-            index=0;
-            //find vector index matching the passed CRTHit
-            for(auto const& crtHit : (*crtTrueHitHandle)){
-                
-                if(HitCompare(crtHit, hit)) tmp_hit_i = index;
-                index++;
-            }
-            if(tmp_hit_i!=-1){
+        auto const crtTrueHitHandle = event.getHandle<std::vector<CRTHit>>(fCRTTrueHitLabel);
+        if(crtTrueHitHandle.isValid()) {
+            trueHitIndex = TrueHitIndex(event, crtTrueHitHandle).index;
+            auto const match = trueHitIndex->Find(*crtTrueHitHandle, hit);
+            if(match.count>0){
                 if(hit_i!=-1) {
                     mf::LogError("CRTBackTracker::AllTrueIds") << "True/Sim CRTHit ID ambiguity!";
-                    return ids;
+                    return {};
                 }
-                hit_i=tmp_hit_i;
+                hit_i=match.index;
             }
         }
         if(hit_i==-1) {
             mf::LogError("CRTBackTracker::AllTrueIds") << "no match for passed CRTHit found!";
-            return ids;
+            return {};
         }
-        if(!findsim && !findtrue) {
-            mf::LogError("CRTBackTracker::AllTrueIds") << "no handle to CRTHits could be found!";
-            return ids;
-        }
-
-        // Get the crt data associated to that hit and the IDEs associate to the data
-        std::vector<art::Ptr<sim::AuxDetIDE>> ides;
-      
-        // Get all the true IDs from all the IDEs in the hit
-        if(sim) {
-            art::FindManyP<CRTData> findManyData(crtSimHitHandle, event, fCRTSimHitLabel);
-            std::vector<art::Ptr<CRTData>> data;
-            data = findManyData.at(hit_i);
-            art::FindManyP<sim::AuxDetIDE> findManySimIdes(data, event, fCRTDataLabel);
-            for(size_t i = 0; i < data.size(); i++){
-      
-                ides = findManySimIdes.at(i);
-                for(size_t j = 0; j < ides.size(); j++){
-      
-                    int id = ides[j]->trackID;
-                    if(fRollupUnsavedIds) id = std::abs(id);
-                    ids.push_back(id);
-                }
-            }
-        }//if sim
-        else {
-            art::FindManyP<sim::AuxDetIDE> findManyTrueIdes(crtTrueHitHandle, event, fCRTTrueHitLabel);
-            ides = findManyTrueIdes.at(hit_i);
-            for(auto const& ide : ides) {
-                int id = ide->trackID;
-                if(fRollupUnsavedIds) id = std::abs(id);
-                ids.push_back(id);
-            }
-        }//else true
 
-        // Remove any repeated IDs
-        std::sort(ids.begin(), ids.end());
-        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
-      
-        return ids;
+        return details::SortedIds(sim? simHitIndex->Truth(hit_i): trueHitIndex->Truth(hit_i));
     }
 
     //-----------------------------------------------------------------------------------------------    
     // Get all the true particle IDs that contributed to the CRT track
     std::vector<int> CRTBackTracker::AllTrueIds(const art::Event& event, const CRTTrack& track){
     
-      std::vector<int> ids;
-      // Get a handle to the CRT tracks in the event
-      auto crtTrackHandle = event.getValidHandle<std::vector<CRTTrack>>(fCRTTrackLabel);
-      art::FindManyP<CRTHit> findManyHits(crtTrackHandle, event, fCRTTrackLabel);
-      // Find which one matches the track passed to the function
-      int track_i = 0, index = 0;
-    
-      for(auto const& crtTrack : (*crtTrackHandle)){
-    
-        if(TrackCompare(crtTrack, track)) track_i = index;
-        index++;
-      }
-    
-      // Get the crt hits associated to that hit and the data associate to the hits
-      std::vector<art::Ptr<CRTHit>> hits = findManyHits.at(track_i);
-      art::FindManyP<CRTData> findManyData(hits, event, fCRTSimHitLabel);
-    
-      // Get all the true IDs from all the IDEs in the track
-      for(size_t i = 0; i < hits.size(); i++){
-    
-        std::vector<art::Ptr<CRTData>> data = findManyData.at(i);
-        art::FindManyP<sim::AuxDetIDE> findManyIdes(data, event, fCRTDataLabel);
-        for(size_t j = 0; j < data.size(); j++){
-    
-          std::vector<art::Ptr<sim::AuxDetIDE>> ides = findManyIdes.at(j);
-          for(size_t k = 0; k < ides.size(); k++){
-    
-            int id = ides[k]->trackID;
-            if(fRollupUnsavedIds) id = std::abs(id);
-            ids.push_back(id);
-    
-          }
-        }
-      }
-    
-      // Remove any repeated IDs
-      std::sort(ids.begin(), ids.end());
-      ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
-    
-      return ids;
+      auto const crtTrackHandle = GetRequiredHandle<CRTTrack>(event, fCRTTrackLabel);
+      auto const trackIndex = TrackIndex(event, crtTrackHandle).index;
+
+      // Find which one matches the track passed to the function (the first one if none)
+      return details::SortedIds(trackIndex->Truth(trackIndex->Find(*crtTrackHandle, track).index));
     }
 
     //------------------------------------------------------------------------------------------    
     // Get the true particle ID that contributed the most energy to the CRT data product
     int CRTBackTracker::TrueIdFromTotalEnergy(const art::Event& event, const CRTData& data){
     
-      std::map<int, double> ids;
-    
-      // Get a handle to the CRT data in the event
-      auto crtDataHandle = event.getValidHandle<std::vector<CRTData>>(fCRTDataLabel);
-      art::FindManyP<sim::AuxDetIDE> findManyIdes(crtDataHandle, event, fCRTDataLabel);
-    
-      // Find which one matches the data passed to the function
-      int data_i = 0, index = 0;
-    
-      for(auto const& crtData : (*crtDataHandle)){
+      auto const crtDataHandle = GetRequiredHandle<CRTData>(event, fCRTDataLabel);
+      auto const dataIndex = DataIndex(event, crtDataHandle).index;
     
-        if(DataCompare(crtData, data)) data_i = index;
-        index++;
-      }
-    
-      // Get all the true IDs from all the IDEs in the hit
-      std::vector<art::Ptr<sim::AuxDetIDE>> ides = findManyIdes.at(data_i);
-    
-      for(size_t i = 0; i < ides.size(); i++){
-    
-        int id = ides[i]->trackID;
-        if(fRollupUnsavedIds) id = std::abs(id);
-        ids[id] += ides[i]->energyDeposited;
-      }
-    
-      // Find the true ID that contributed the most energy
-      double maxEnergy = -1;
-      int trueId = -99999;
-    
-      for(auto &id : ids){
-    
-        if(id.second > maxEnergy){
-    
-          maxEnergy = id.second;
-          trueId = id.first;
-        }
-      }
-    
-      return trueId;
+      return details::MaxEnergyId(dataIndex->Truth(dataIndex->Find(*crtDataHandle, data).index));
     }
 
     //-------------------------------------------------------------------------------------------
@@ -463,54 +474,10 @@ namespace icarus{
     // Get the true particle ID that contributed the most energy to the CRT hit
     int CRTBackTracker::TrueIdFromTotalEnergy(const art::Event& event, const CRTHit& hit){
     
-      std::map<int, double> ids;
-    
-      // Get a handle to the CRT hits in the event
-      auto crtHitHandle = event.getValidHandle<std::vector<CRTHit>>(fCRTSimHitLabel);
-      art::FindManyP<CRTData> findManyData(crtHitHandle, event, fCRTSimHitLabel);
-    
-      // Find which one matches the hit passed to the function
-      int hit_i = 0, index = 0;
-    
-      for(auto const& crtHit : (*crtHitHandle)){
-    
-        if(HitCompare(crtHit, hit)) hit_i = index;
-        index++;
-      }
-    
-      // Get the crt data associated to that hit and the IDEs associate to the data
-      std::vector<art::Ptr<CRTData>> data = findManyData.at(hit_i);
-      art::FindManyP<sim::AuxDetIDE> findManyIdes(data, event, fCRTDataLabel);
-    
-      // Get all the true IDs from all the IDEs in the hit
-      for(size_t i = 0; i < data.size(); i++){
-    
-        std::vector<art::Ptr<sim::AuxDetIDE>> ides = findManyIdes.at(i);
-    
-        for(size_t j = 0; j < ides.size(); j++){
-    
-          int id = ides[j]->trackID;
-          if(fRollupUnsavedIds) id = std::abs(id);
-          ids[id] += ides[j]->energyDeposited;
-        }
-      }
-    
-      // Find the true ID that contributed the most energy
-      double maxEnergy = -1;
-      int trueId = -99999;
-    
-      for(auto &id : ids){
-    
-        if(id.second > maxEnergy){
-    
-          maxEnergy = id.second;
-          trueId = id.first;
-    
-        }
-      }
-    
-      return trueId;
+      auto const crtHitHandle = GetRequiredHandle<CRTHit>(event, fCRTSimHitLabel);
+      auto const simHitIndex = SimHitIndex(event, crtHitHandle).index;
     
+      return details::MaxEnergyId(simHitIndex->Truth(simHitIndex->Find(*crtHitHandle, hit).index));
     }
 
     //-----------------------------------------------------------------------------------------
@@ -542,59 +509,10 @@ namespace icarus{
     // Get the true particle ID that contributed the most energy to the CRT track
     int CRTBackTracker::TrueIdFromTotalEnergy(const art::Event& event, const CRTTrack& track){
     
-      std::map<int, double> ids;
-    
-      // Get a handle to the CRT tracks in the event
-      auto crtTrackHandle = event.getValidHandle<std::vector<CRTTrack>>(fCRTTrackLabel);
-      art::FindManyP<CRTHit> findManyHits(crtTrackHandle, event, fCRTTrackLabel);
-    
-      // Find which one matches the track passed to the function
-      int track_i = 0, index = 0;
-    
-      for(auto const& crtTrack : (*crtTrackHandle)){
-    
-        if(TrackCompare(crtTrack, track)) track_i = index;
-        index++;
-      }
-    
-      // Get the crt hits associated to that hit and the data associate to the hits
-      std::vector<art::Ptr<CRTHit>> hits = findManyHits.at(track_i);
-      art::FindManyP<CRTData> findManyData(hits, event, fCRTSimHitLabel);
-    
-      // Get all the true IDs from all the IDEs in the track
-      for(size_t i = 0; i < hits.size(); i++){
-    
-        std::vector<art::Ptr<CRTData>> data = findManyData.at(i);
-        art::FindManyP<sim::AuxDetIDE> findManyIdes(data, event, fCRTDataLabel);
-    
-        for(size_t j = 0; j < data.size(); j++){
-    
-          std::vector<art::Ptr<sim::AuxDetIDE>> ides = findManyIdes.at(j);
-    
-          for(size_t k = 0; k < ides.size(); k++){
-    
-            int id = ides[k]->trackID;
-            if(fRollupUnsavedIds) id = std::abs(id);
-            ids[id] += ides[k]->energyDeposited;
-          }
-        }
-    
-      }
-    
-      // Find the true ID that contributed the most energy
-      double maxEnergy = -1;
-      int trueId = -99999;
-    
-      for(auto &id : ids){
-    
-        if(id.second > maxEnergy){
-    
-          maxEnergy = id.second;
-          trueId = id.first;
-        }
-      }
+      auto const crtTrackHandle = GetRequiredHandle<CRTTrack>(event, fCRTTrackLabel);
+      auto const trackIndex = TrackIndex(event, crtTrackHandle).index;
     
-      return trueId;
+      return details::MaxEnergyId(trackIndex->Truth(trackIndex->Find(*crtTrackHandle, track).index));
     }
 
     //--------------------------------------------------------------------------
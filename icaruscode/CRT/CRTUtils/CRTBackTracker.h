@@ -30,8 +30,12 @@
 #include "sbnobj/ICARUS/CRT/CRTData.hh"
 #include "sbnobj/Common/CRT/CRTHit.hh"
 #include "sbnobj/Common/CRT/CRTTrack.hh"
+#include "icaruscode/CRT/CRTUtils/CRTBackTrackerIndex.h"
 
 // c++
+#include <map>
+#include <memory>
+#include <optional>
 #include <vector>
 
 namespace icarus{
@@ -79,17 +83,21 @@ class icarus::crt::CRTBackTracker {
 
     void reconfigure(const Config& config);
 
-    // Initialize to speed things up
+    // Initialize to speed things up: must be called for each event, before any query on it
     void Initialize(const art::Event& event);
 
     // Check that two CRT data products are the same
-    bool DataCompare(const CRTData& data1, const CRTData& data2);
+    static bool DataCompare(const CRTData& data1, const CRTData& data2);
 
     // Check that two CRT hits are the same
-    bool HitCompare(const CRTHit& hit1, const CRTHit& hit2);
+    static bool HitCompare(const CRTHit& hit1, const CRTHit& hit2);
 
     // Check that two CRT tracks are the same
-    bool TrackCompare(const CRTTrack& track1, const CRTTrack& track2);
+    static bool TrackCompare(const CRTTrack& track1, const CRTTrack& track2);
+
+    // The following queries look the object up (by content, as the Compare functions)
+    // in the indices built by Initialize() for the event, and can then be called concurrently;
+    // without Initialize(), each query indexes the collections it needs anew
 
     // Get all the true particle IDs that contributed to the CRT data product
     std::vector<int> AllTrueIds(const art::Event& event, const CRTData& data);
@@ -120,6 +128,52 @@ class icarus::crt::CRTBackTracker {
 
   private:
 
+    using IdEnergies = details::IdEnergies;
+
+    template <typename T>
+    using IndexPtr = std::shared_ptr<details::CollectionIndex<T> const>;
+
+    // Index of a collection, and the product it was built from
+    template <typename T>
+    struct ProductIndex {
+      art::ProductID product;
+      IndexPtr<T> index;
+
+      bool IsFor(const art::Handle<std::vector<T>>& handle) const
+        { return index && (handle.id() == product) && (handle->size() == index->size()); }
+    };
+
+    // Index of the collection in `handle`: the one from Initialize() if current, a new one otherwise
+    ProductIndex<CRTData> DataIndex(const art::Event& event, const art::Handle<std::vector<CRTData>>& handle) const;
+    ProductIndex<CRTHit> TrueHitIndex(const art::Event& event, const art::Handle<std::vector<CRTHit>>& handle) const;
+    ProductIndex<CRTHit> SimHitIndex(const art::Event& event, const art::Handle<std::vector<CRTHit>>& handle) const;
+    ProductIndex<CRTTrack> TrackIndex(const art::Event& event, const art::Handle<std::vector<CRTTrack>>& handle) const;
+
+    // Index of the configured CRTData (CRTSimHit) collection, empty if not in the event
+    ProductIndex<CRTData> OptionalDataIndex(const art::Event& event) const;
+    ProductIndex<CRTHit> OptionalSimHitIndex(const art::Event& event, const ProductIndex<CRTData>& dataIndex) const;
+
+    // New index of the collection in `handle`, reusing the indices of the associated collections
+    ProductIndex<CRTData> BuildDataIndex(const art::Event& event, const art::Handle<std::vector<CRTData>>& handle) const;
+    ProductIndex<CRTHit> BuildTrueHitIndex(const art::Event& event, const art::Handle<std::vector<CRTHit>>& handle) const;
+    ProductIndex<CRTHit> BuildSimHitIndex(const art::Event& event, const art::Handle<std::vector<CRTHit>>& handle,
+                                          const ProductIndex<CRTData>& dataIndex) const;
+    ProductIndex<CRTTrack> BuildTrackIndex(const art::Event& event, const art::Handle<std::vector<CRTTrack>>& handle,
+                                           const ProductIndex<CRTHit>& simHitIndex,
+                                           const ProductIndex<CRTData>& dataIndex) const;
+
+    // Whether the indices were built by Initialize() for `event`
+    bool IsInitializedFor(const art::Event& event) const
+      { return fIndexEvent && (*fIndexEvent == event.id()); }
+
+    // Truth of the data associated with `hits` via `label`
+    std::vector<IdEnergies> HitTruthFromData(const art::Event& event, const art::InputTag& label,
+                                             const std::vector<art::Ptr<CRTHit>>& hits,
+                                             const ProductIndex<CRTData>& dataIndex) const;
+
+    // Rolled up true ID of an IDE
+    int TrueId(const sim::AuxDetIDE& ide) const;
+
     art::InputTag fCRTTrueHitLabel;
     art::InputTag fCRTDataLabel;
     art::InputTag fCRTSimHitLabel;
@@ -131,6 +185,13 @@ class icarus::crt::CRTBackTracker {
     std::map<int, std::map<int, double>> fSimHitTrueIds;
     std::map<int, std::map<int, double>> fTrackTrueIds;
 
+    // Indices built by Initialize(), for the event with ID `fIndexEvent`
+    std::optional<art::EventID> fIndexEvent;
+    ProductIndex<CRTData> fDataIndex;
+    ProductIndex<CRTHit> fTrueHitIndex;
+    ProductIndex<CRTHit> fSimHitIndex;
+    ProductIndex<CRTTrack> fTrackIndex;
+
 };
 
 #endif
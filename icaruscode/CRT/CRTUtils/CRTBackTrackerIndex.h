@@ -0,0 +1,215 @@
+#ifndef CRTBACKTRACKERINDEX_H_SEEN
+
+#define CRTBACKTRACKERINDEX_H_SEEN
+
+/////////////////////////////////////////////////////////////////
+// CRTBackTrackerIndex.h
+//
+// Truth of the elements of a CRT data product collection, and
+// lookup of the elements by content, for CRTBackTracker.
+//
+// An index does not point into the collection it was built from:
+// the collection is passed again to each lookup, and an index can
+// not outlive the data it describes.
+/////////////////////////////////////////////////////////////////
+
+// Utility libraries
+#include "sbnobj/ICARUS/CRT/CRTData.hh"
+#include "sbnobj/Common/CRT/CRTHit.hh"
+#include "sbnobj/Common/CRT/CRTTrack.hh"
+
+// c++
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+namespace icarus{
+ namespace crt {
+  namespace details {
+
+    // Contributing true IDs and their energy, in association order
+    using IdEnergies = std::vector<std::pair<int, double>>;
+
+    // ------------------------------------------------------------------------------------------
+    // Check that two CRT data products are the same
+    inline bool SameContent(const icarus::crt::CRTData& data1, const icarus::crt::CRTData& data2){
+
+      if(data1.fMac5  != data2.fMac5)  return false;
+      if(data1.fTs0   != data2.fTs0)   return false;
+      if(data1.fTs1   != data2.fTs1)   return false;
+      if(data1.fEntry != data2.fEntry) return false;
+      for(int ch=0; ch<64; ch++) {
+          if(data1.fAdc[ch] != data2.fAdc[ch]) return false;
+      }
+
+      return true;
+    }
+
+    // Check that two CRT hits are the same
+    inline bool SameContent(const sbn::crt::CRTHit& hit1, const sbn::crt::CRTHit& hit2){
+
+      if(hit1.ts1_ns != hit2.ts1_ns) return false;
+      if(hit1.plane != hit2.plane) return false;
+      if(hit1.x_pos != hit2.x_pos) return false;
+      if(hit1.y_pos != hit2.y_pos) return false;
+      if(hit1.z_pos != hit2.z_pos) return false;
+      if(hit1.x_err != hit2.x_err) return false;
+      if(hit1.y_err != hit2.y_err) return false;
+      if(hit1.z_err != hit2.z_err) return false;
+      if(hit1.tagger != hit2.tagger) return false;
+
+      return true;
+    }
+
+    // Check that two CRT tracks are the same
+    inline bool SameContent(const sbn::crt::CRTTrack& track1, const sbn::crt::CRTTrack& track2){
+
+      if(track1.ts1_ns != track2.ts1_ns) return false;
+      if(track1.plane1 != track2.plane1) return false;
+      if(track1.x1_pos != track2.x1_pos) return false;
+      if(track1.y1_pos != track2.y1_pos) return false;
+      if(track1.z1_pos != track2.z1_pos) return false;
+      if(track1.x1_err != track2.x1_err) return false;
+      if(track1.y1_err != track2.y1_err) return false;
+      if(track1.z1_err != track2.z1_err) return false;
+      if(track1.plane2 != track2.plane2) return false;
+      if(track1.x2_pos != track2.x2_pos) return false;
+      if(track1.y2_pos != track2.y2_pos) return false;
+      if(track1.z2_pos != track2.z2_pos) return false;
+      if(track1.x2_err != track2.x2_err) return false;
+      if(track1.y2_err != track2.y2_err) return false;
+      if(track1.z2_err != track2.z2_err) return false;
+
+      return true;
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Hash of a value, consistent with comparison with `!=`
+    template <typename T>
+    std::size_t HashValue(const T& value){
+        if constexpr(std::is_floating_point_v<T>)
+            return std::hash<T>{}((value == T{ 0 })? T{ 0 }: value); // 0 and -0 are equal
+        else
+            return std::hash<T>{}(value);
+    }
+
+    template <typename... Args>
+    std::size_t HashValues(std::size_t seed, const Args&... values){
+        ((seed ^= HashValue(values) + 0x9e3779b9 + (seed << 6) + (seed >> 2)), ...);
+        return seed;
+    }
+
+    // Content hashes, consistent with SameContent()
+    inline std::size_t ContentHash(const icarus::crt::CRTData& data){
+        std::size_t seed = HashValues(0, data.fMac5, data.fTs0, data.fTs1, data.fEntry);
+        for(int ch=0; ch<64; ch++) seed = HashValues(seed, data.fAdc[ch]);
+        return seed;
+    }
+
+    inline std::size_t ContentHash(const sbn::crt::CRTHit& hit){
+        return HashValues(0, hit.ts1_ns, hit.plane, hit.x_pos, hit.y_pos, hit.z_pos,
+                          hit.x_err, hit.y_err, hit.z_err, hit.tagger);
+    }
+
+    inline std::size_t ContentHash(const sbn::crt::CRTTrack& track){
+        return HashValues(0, track.ts1_ns,
+                          track.plane1, track.x1_pos, track.y1_pos, track.z1_pos, track.x1_err, track.y1_err, track.z1_err,
+                          track.plane2, track.x2_pos, track.y2_pos, track.z2_pos, track.x2_err, track.y2_err, track.z2_err);
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Sorted true IDs, without repetitions
+    inline std::vector<int> SortedIds(const IdEnergies& truth){
+        std::vector<int> ids;
+        ids.reserve(truth.size());
+        for(auto const& idEnergy : truth) ids.push_back(idEnergy.first);
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+
+    // True ID that contributed the most energy
+    inline int MaxEnergyId(const IdEnergies& truth){
+
+        std::map<int, double> ids;
+        for(auto const& idEnergy : truth) ids[idEnergy.first] += idEnergy.second;
+
+        double maxEnergy = -1;
+        int trueId = -99999;
+
+        for(auto &id : ids){
+
+            if(id.second > maxEnergy){
+
+                maxEnergy = id.second;
+                trueId = id.first;
+            }
+        }
+
+        return trueId;
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Truth of each element of a collection, and lookup of the elements by content
+    template <typename T>
+    class CollectionIndex {
+
+      public:
+
+        struct Match_t {
+            std::size_t index = 0;   // last element with the same content
+            unsigned int count = 0;  // number of elements with the same content
+        };
+
+        // `truth` holds the contributions to each element of `collection`
+        CollectionIndex(const std::vector<T>& collection, std::vector<IdEnergies> truth):
+            fTruth(std::move(truth))
+        {
+            fLookup.reserve(collection.size());
+            for(std::size_t i = 0; i < collection.size(); i++){
+
+                const T& element = collection[i];
+                if(!SameContent(element, element)) continue; // never matches (NaN)
+
+                fLookup.emplace(ContentHash(element), i);
+            }
+        }
+
+        // Number of elements in the indexed collection
+        std::size_t size() const { return fTruth.size(); }
+
+        // Elements of `collection` (the indexed one) with the same content as `element`
+        Match_t Find(const std::vector<T>& collection, const T& element) const {
+
+            Match_t match;
+            auto const [ first, last ] = fLookup.equal_range(ContentHash(element));
+            for(auto it = first; it != last; ++it){
+
+                std::size_t const i = it->second;
+                if((i >= collection.size()) || !SameContent(collection[i], element)) continue;
+
+                if((match.count == 0) || (i > match.index)) match.index = i;
+                match.count++;
+            }
+            return match;
+        }
+
+        const IdEnergies& Truth(std::size_t index) const { return fTruth.at(index); }
+
+      private:
+
+        std::vector<IdEnergies> fTruth;
+        std::unordered_multimap<std::size_t, std::size_t> fLookup; // content hash to element index
+
+    };
+
+  }// namespace details
+ }// namespace crt
+}// namespace icarus
+
+#endif
@@ -3,13 +3,56 @@
 
 #include "icaruscode/CRT/CRTUtils/CRTDetSimAlg.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+//-------------------------------------------------------------------------------------------
+int Tagger::FirstLayer() const {
+    for (size_t layer = 0; layer < kMaxLayers; ++layer)
+        if (layerid.test(layer)) return layer;
+    return kMaxLayers;
+}
+
+void Tagger::SetChannelLayer(int channel, int layid) {
+    if (channel < 0 || channel >= (int)kMaxChannels)
+        throw cet::exception("CRTDetSimAlg") << "channel " << channel << " out of bounds for FEB!";
+    const int layer = LayerIndex(layid);
+    layerid.set(layer);
+    chanlayer[channel] = layer;
+}
+
+void Tagger::AddData(ChanData const& chan, AuxDetIDE const& deposit) {
+    data.push_back(chan);
+    ide.push_back(deposit);
+}
+
+void Tagger::SortByTime() {
+    //sorting the indices takes the same comparisons and swaps as sorting the
+    //(data, ide) pairs would, so signals with the same time keep the same order
+    vector<size_t> order(data.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+        [this](size_t a, size_t b){ return data[a].ts < data[b].ts; });
+
+    vector<ChanData> sortedData;
+    vector<AuxDetIDE> sortedIDE;
+    sortedData.reserve(order.size());
+    sortedIDE.reserve(order.size());
+    for (size_t i : order) {
+        sortedData.push_back(data[i]);
+        sortedIDE.push_back(std::move(ide[i]));
+    }
+    data = std::move(sortedData);
+    ide = std::move(sortedIDE);
+}//Tagger::SortByTime()
+
 namespace icarus{
  namespace crt {
 
-    bool TimeOrderCRTData(std::pair<ChanData, AuxDetIDE> crtdat1, 
-                          std::pair<ChanData, AuxDetIDE> crtdat2) {
-        return ( crtdat1.first.ts < crtdat2.first.ts );
-    }//TimeOrderCRTData()
 
     //-------------------------------------------------------------------------------------------
     //constructor 
@@ -83,8 +126,6 @@ namespace icarus{
         if(fTaggers.size()==0)
             return dataCol;
 
-	int eve=1;
-
         int ncombined_c=0, ncombined_m=0, ncombined_d=0; //channel signals close in time, biasing first signal entering into track and hold circuit
         int nmiss_lock_c=0, nmiss_lock_d=0, nmiss_lock_m=0; //channel signals missed due to channel already locked, but before readout (dead time)
         int nmiss_dead_c=0, nmiss_dead_d=0, nmiss_dead_m=0; //track losses from deadtime
@@ -92,10 +133,41 @@ namespace icarus{
         int nmiss_coin_c = 0;
         int nmiss_coin_d = 0;
         int nmiss_coin_m = 0;
-        int event = 0;                    //FEB entry number (can have multiple per art event)
         int nhit_m=0, nhit_c=0, nhit_d=0; //channels with signals contained in readout of FEB
         int neve_m=0, neve_c=0, neve_d=0; //no. readouts of FEBs for each subsystem
 
+        // FEBs in mac5 order; the output is merged in this order regardless of
+        // the order the boards are processed in
+        vector<pair<uint8_t, Tagger*>> febs;
+        febs.reserve(fTaggers.size());
+        for (auto& trg : fTaggers) febs.emplace_back(trg.first, &trg.second);
+
+        //time order ChannelData objects in each FEB by T0;
+        //the MINOS coincidence search relies on all FEBs being sorted
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, febs.size()),
+            [&febs](tbb::blocked_range<size_t> const& range) {
+                for (size_t i = range.begin(); i != range.end(); ++i)
+                    febs[i].second->SortByTime();
+            });
+
+        //MINOS modules in the same region and adjacent layer, candidates for coincidence
+        vector<vector<Tagger const*>> partners(febs.size());
+        if (fApplyCoincidenceM) {
+            for (size_t i = 0; i < febs.size(); ++i) {
+                Tagger const& trg = *(febs[i].second);
+                if (trg.type != 'm') continue;
+                for (auto const& feb2 : febs) {
+                    Tagger const& trg2 = *(feb2.second);
+                    if( trg2.type!='m' || //is other mod 'm' type
+                      trg.modid == trg2.modid || //other mod not same as this one
+                      trg.reg != trg2.reg || //other mod is in same region
+                      trg2.FirstLayer() == trg.FirstLayer()) //modules are in adjacent layers
+                        continue;
+                    partners[i].push_back(&trg2);
+                }
+            }
+        }
+
         // Loop over all FEBs (key for taggers) with a hit and check coincidence requirement.
         // For each FEB, find channel providing trigger and determine if
         //  other hits are in concidence with the trigger (keep) 
@@ -103,301 +175,50 @@ namespace icarus{
         //  or if hits are part of a different event (keep for now)
         // First apply dead time correction, biasing effect if configured to do so.
         // Front-end logic: For CERN or DC modules require at least one hit in each X-X layer.
+        // FEBs are independent of each other and are processed in parallel,
+        // unless the verbose printout is requested.
         if (fUltraVerbose) std::cout << '\n' << "about to loop over taggers (size " << fTaggers.size() << " )" << std::endl;
 
-        for (auto trg : fTaggers) {
-            //if(trg.second.data.size()!=trg.second.ide.size())
-            //    std::cout << "WARNING DATA AND INDEX VECTOR SIZE MISMATCH!" << std::endl;
-
-            event = 0;
-            ChanData *chanTrigData(nullptr);
-            ChanData *chanTmpData(nullptr);
-            set<int> trackNHold = {}; //set of channels close in time to triggered readout above threshold
-            set<int> layerNHold = {}; //layers with channels above threshold (used for checking layer-layer coincidence)
-            if((int)trg.first==INT_MAX) std::cout << "WARNING: bad mac5 found!" << std::endl;
-            bool minosPairFound = false, istrig=false;
-            vector<ChanData> passingData; //data to be included in "readout" of FEB
-            vector<AuxDetIDE> passingIDE;
-            uint64_t ttrig=0.0, ttmp=0.0;  //time stamps on trigger channel, channel considered as part of readout
-            AuxDetIDE idetmp;
-            size_t trigIndex = 0;
-            uint16_t adc[64];
-
-            //check "open" coincidence (just check if coincdence possible w/hit in both layers) 
-            if (trg.second.type=='c' && fApplyCoincidenceC && trg.second.layerid.size()<2) {
-                nmiss_opencoin_c++;
-                continue;
-            }
-            if (trg.second.type=='d' && fApplyCoincidenceD && trg.second.layerid.size()<2) {
-                nmiss_opencoin_d++;
-                continue;
+        vector<FEBReadout> readouts(febs.size());
+        auto processFEBs = [&](tbb::blocked_range<size_t> const& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i)
+                ProcessTagger(febs[i].first, *(febs[i].second), partners[i], readouts[i]);
+        };
+        if (fUltraVerbose)
+            processFEBs(tbb::blocked_range<size_t>(0, febs.size()));
+        else
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, febs.size()), processFEBs);
+
+        for (size_t i = 0; i < febs.size(); ++i) {
+            Tagger const& trg = *(febs[i].second);
+            FEBReadout& readout = readouts[i];
+            const int nReadouts = readout.data.size();
+
+            switch (trg.type) {
+                case 'c' :
+                    ncombined_c += readout.ncombined; nmiss_lock_c += readout.nmiss_lock;
+                    nmiss_dead_c += readout.nmiss_dead; nmiss_opencoin_c += readout.nmiss_opencoin;
+                    nmiss_coin_c += readout.nmiss_coin; nhit_c += readout.nhit; neve_c += nReadouts;
+                    break;
+                case 'd' :
+                    ncombined_d += readout.ncombined; nmiss_lock_d += readout.nmiss_lock;
+                    nmiss_dead_d += readout.nmiss_dead; nmiss_opencoin_d += readout.nmiss_opencoin;
+                    nmiss_coin_d += readout.nmiss_coin; nhit_d += readout.nhit; neve_d += nReadouts;
+                    break;
+                case 'm' :
+                    ncombined_m += readout.ncombined; nmiss_lock_m += readout.nmiss_lock;
+                    nmiss_dead_m += readout.nmiss_dead;
+                    nmiss_coin_m += readout.nmiss_coin; nhit_m += readout.nhit; neve_m += nReadouts;
+                    break;
             }
 
-            //time order ChannalData objects in this FEB by T0
-            std::sort((trg.second.data).begin(),(trg.second.data).end(),TimeOrderCRTData);
-
-            if (fUltraVerbose) std::cout << "processing data for FEB " << (int)trg.first << " with "
-                                    << trg.second.data.size() << " entries..." << '\n'
-                                    << "    type: " <<  trg.second.type << '\n'
-                                    << "    region: " <<  trg.second.reg << '\n'
-                                    << "    layerID: " << *trg.second.layerid.begin() << '\n' << std::endl;
-
-            //outer (primary) loop over all data products for this FEB
-            for ( size_t i=0; i< trg.second.data.size(); i++ ) {
-
-              //get data for earliest entry
-              if(i==0) {
-                chanTrigData = &(trg.second.data[0].first);
-                ttrig = chanTrigData->ts; //time stamp [ns]
-                trackNHold.insert(chanTrigData->channel);
-                layerNHold.insert(trg.second.chanlayer[chanTrigData->channel]);
-                passingData.push_back(*chanTrigData);
-                passingIDE.push_back(trg.second.data[0].second);
-                ttmp = ttrig; 
-                idetmp = passingIDE.back();
-                if(trg.second.type!='m')
-                    continue;
-              }
-
-              else {
-                chanTmpData = &(trg.second.data[i].first);
-                ttmp = chanTmpData->ts;
-                idetmp = trg.second.data[i].second;
-              }
-
-              //for C and D modules only and coin. enabled, if assumed trigger channel has no coincidence
-              // set trigger channel to tmp channel and try again
-              if ( layerNHold.size()==1 &&
-                   ( (trg.second.type=='c' && fApplyCoincidenceC && ttmp-ttrig>fLayerCoincidenceWindowC) ||
-                     (trg.second.type=='d' && fApplyCoincidenceD && ttmp-ttrig>fLayerCoincidenceWindowD )))
-              {
-                   trigIndex++;
-                   chanTrigData = &(trg.second.data[trigIndex].first);
-                   i = trigIndex; //+1
-                   ttrig = chanTrigData->ts;
-                   trackNHold.clear();
-                   layerNHold.clear();
-                   passingData.clear();
-                   passingIDE.clear();
-                   trackNHold.insert(chanTrigData->channel);
-                   layerNHold.insert(trg.second.chanlayer[chanTrigData->channel]);
-                   passingData.push_back(*chanTrigData);
-                   passingIDE.push_back(trg.second.data[trigIndex].second);
-                   if(trg.second.type=='c') nmiss_coin_c++;
-                   if(trg.second.type=='d') nmiss_coin_d++;
-                   continue;
-              }
-
-              if(fUltraVerbose)
-                  std::cout << "checking for coincidence..." << std::endl;
-              //check if coincidence condtion met
-              //for c and d modules, just need time stamps within tagger obj
-              //for m modules, need to check coincidence with other tagger objs
-              if (trg.second.type=='m' && !minosPairFound && fApplyCoincidenceM) {
-                  for (auto trg2 :fTaggers) {
-
-                      if( trg2.second.type!='m' || //is other mod 'm' type
-                        trg.second.modid == trg2.second.modid || //other mod not same as this one
-                        trg.second.reg != trg2.second.reg || //other mod is in same region
-                        *trg2.second.layerid.begin() == *trg.second.layerid.begin()) //modules are in adjacent layers
-                          continue;
-
-                      //find entry within coincidence window starting with this FEB's
-                      //triggering channel in coincidence candidate's FEB
-                      for ( size_t j=0; j< trg2.second.data.size(); j++ ) {
-                          uint64_t t2tmp = trg2.second.data[j].first.ts; //in us
-                          if ( util::absDiff(t2tmp,ttrig) < fLayerCoincidenceWindowM) {
-                              minosPairFound = true;
-                              break;
-                          }
-                      }
-                      //we found a valid pair so move on to next step
-                      if (minosPairFound)
-                          break;
-                  }//inner loop over febs (taggers)
-
-                  //if no coincidence pairs found, reinitialize and move to next FEB
-                  if(!minosPairFound) {
-                      if(fUltraVerbose) 
-                          std::cout << "MINOS pair NOT found! Skipping to next FEB..." << std::endl;
-                      if(trg.second.data.size()==1) continue;
-                      trigIndex++;
-                      chanTrigData = &(trg.second.data[trigIndex].first);
-                      i = trigIndex;//+1;
-                      ttrig = chanTrigData->ts;
-                      trackNHold.clear();
-                      layerNHold.clear();
-                      passingData.clear();
-                      passingIDE.clear();
-                      trackNHold.insert(chanTrigData->channel);
-                      layerNHold.insert(trg.second.chanlayer[chanTrigData->channel]);
-                      passingData.push_back(*chanTrigData);
-	      	      passingIDE.push_back(trg.second.data[trigIndex].second);
-                      nmiss_coin_m++;
-                      continue;
-                  }
-                  else
-                      istrig = true;
-              }//if minos module and no pair yet found
-
-              if(fUltraVerbose) 
-                  std::cout << "done checking coinceidence...moving on to latency effects..." << std::endl;
-              if(!minosPairFound && trg.second.type=='m') 
-                  std::cout << "WARNING: !minosPairFound...should not see this message!" << std::endl;
-
-              int adctmp = 0;
-              //currently assuming layer coincidence window is same as track and hold window (FIX ME!)
-              if (i>0 && ((trg.second.type=='c' && ttmp < ttrig + fLayerCoincidenceWindowC) || 
-                  (trg.second.type=='d' && ttmp < ttrig + fLayerCoincidenceWindowD) ||
-                  (trg.second.type=='m' && ttmp < ttrig + fLayerCoincidenceWindowM)) )
-              {
-
-                  //if channel not locked
-                  if ((trackNHold.insert(chanTmpData->channel)).second) {
-
-                      //channel added to vector of ChannelData for current FEB readout
-                      passingData.push_back(*chanTmpData);
-	              passingIDE.push_back(idetmp);
-
-                      //if not m module, check to see if strip is first in time in adjacent layer w.r.t. trigger strip
-                      if (layerNHold.insert(trg.second.chanlayer[chanTmpData->channel]).second
-                         && trg.second.type != 'm')
-                      {
-                          //flagging strips which produce triggering condition (layer-layer coincidence)
-                          istrig = true;
-                      }
-                  } //end if channel not locked
-
-                  //check for signal biasing
-                  else if (ttmp < ttrig + fBiasTime) {
-                      for(size_t dat=0; dat<passingData.size(); dat++) {
-                          if(passingData[dat].channel!=chanTmpData->channel)
-                              continue;
-                          adctmp = passingData[dat].adc;
-                          adctmp += chanTmpData->adc;
-                          if(adctmp>fQMax) adctmp = fQMax;
-                          passingData[dat].adc = adctmp;
-                          passingIDE.push_back(idetmp);
-                          break;
-
-                      }
-
-                      switch (trg.second.type) {
-                          case 'c' : ncombined_c++; break;
-                          case 'd' : ncombined_d++; break;
-                          case 'm' : ncombined_m++; break;
-                      }
-                  } //channel is locked but hit close in time to bias pulse height
-
-                  else switch (trg.second.type) {
-                      case 'c' : nmiss_lock_c++; break;
-                      case 'd' : nmiss_lock_d++; break;
-                      case 'm' : nmiss_lock_m++; break;
-                  } //data is discarded (not writeable)
-
-              }//if hits inside track and hold window
-
-              else if ( i>0 && ttmp <= ttrig + fDeadTime ) {
-                  switch (trg.second.type) {
-                      case 'c' : nmiss_dead_c++; break;
-                      case 'd' : nmiss_dead_d++; break;
-                      case 'm' : nmiss_dead_m++; break;
-                  }
-              } // hits occuring during digitization lost (dead time)
-
-              //"read out" data for this event, first hit after dead time as next trigger channel
-              else if ( ttmp > ttrig + fDeadTime) {
-
-                if(istrig)
-                  {int regnum = fCrtutils->AuxDetRegionNameToNum(trg.second.reg);
-                  if( (fRegions.insert(regnum)).second) fRegCounts[regnum] = 1;
-                  else fRegCounts[regnum]++;
-
-                  if (fUltraVerbose) {
-                      std::cout << "creating CRTData product just after deadtime" << '\n'
-                                << "  event:          " << eve << '\n'
-                                << "  mac5:           " << trg.first << '\n'
-                                << "  FEB entry:      " << event << '\n'
-                                << "  trig time:      " << ttrig << '\n'
-                                << "  trig channel:   " << chanTrigData->channel << '\n'
-                                << "  passing data:   " << std::endl;
-                      for(size_t i=0; i<passingData.size(); i++) {
-                          std::cout
-                                << "     index:          " << i << '\n'
-                                << "     channel:        " << passingData[i].channel << '\n'
-                                << "     t0:             " << passingData[i].ts << '\n'
-                                << "     adc:            " << passingData[i].adc << std::endl;
-                      }
-                  }
-
-                  if(passingData.size()>passingIDE.size()) 
-                      std::cout << "data/IDE size mismatch!" <<  passingData.size()-passingIDE.size() << std::endl;
-                  FillAdcArr(passingData,adc);
-                  dataCol.push_back(std::make_pair(
-                    FillCRTData(trg.first,event,ttrig,ttrig,adc),
-                    passingIDE) );
-
-                  if (fUltraVerbose) std::cout << " ...success!" << std::endl;
-                  event++;
-                  if (trg.second.type=='c') {neve_c++; nhit_c+=passingData.size(); }
-                  if (trg.second.type=='d') {neve_d++; nhit_d+=passingData.size(); }
-                  if (trg.second.type=='m') {neve_m++; nhit_m+=passingData.size(); } }
-                  trigIndex = i;
-                  ttrig = ttmp;
-                  chanTrigData = chanTmpData;
-                  passingData.clear();
-                  passingIDE.clear();
-                  trackNHold.clear();
-                  layerNHold.clear();
-                  passingData.push_back(*chanTrigData);
-                  passingIDE.push_back(idetmp);
-                  trackNHold.insert(chanTrigData->channel);
-                  layerNHold.insert(trg.second.chanlayer[chanTmpData->channel]);
-                  minosPairFound = false;
-                  istrig = false;
-              }
-
-              if (!(ttmp > ttrig + fDeadTime) && i==trg.second.data.size()-1 && istrig) {
-
-                  if (fUltraVerbose) {
-                      std::cout << "creating CRTData product at end of FEB events..." << '\n'
-                                << "  event:          " << eve << '\n'
-                                << "  mac5:           " << trg.first << '\n'
-                                << "  FEB entry:      " << event << '\n'
-                                << "  trig time:      " << ttrig << '\n'
-                                << "  trig channel:   " << chanTrigData->channel << '\n'
-                                << "  passing data:   " << std::endl;
-                      for(size_t i=0; i<passingData.size(); i++) {
-                          std::cout
-                                << "     index:          " << i << '\n'
-                                << "     channel:        " << passingData[i].channel << '\n'
-                                << "     t0:             " << passingData[i].ts << '\n'
-                                << "     adc:            " << passingData[i].adc << std::endl;
-                      }
-                  }
-
-                  int regnum = fCrtutils->AuxDetRegionNameToNum(trg.second.reg);
-                  if( (fRegions.insert(regnum)).second) fRegCounts[regnum] = 1;
-                  else fRegCounts[regnum]++;
-
-                  if(passingData.size()>passingIDE.size()) 
-                      std::cout << "data/IDE size mismatch! " << passingData.size()-passingIDE.size() << std::endl;
-                  FillAdcArr(passingData,adc);
-                  dataCol.push_back( std::make_pair(
-                    FillCRTData(trg.first,event,ttrig,ttrig,adc),
-                    passingIDE) );
-                  if (fUltraVerbose) 
-                      std::cout << " ...success!" << std::endl;
-                  event++;
-                  if (trg.second.type=='c') {neve_c++; nhit_c+=passingData.size(); }
-                  if (trg.second.type=='d') {neve_d++; nhit_d+=passingData.size(); }
-                  if (trg.second.type=='m') {neve_m++; nhit_m+=passingData.size(); }
-
-              }//if last event and not already written 
-            }//for data entries (hits)
-
-            if(fUltraVerbose) std::cout << " outside loop over FEB data entries...moving on to next FEB..." << std::endl;
+            if (nReadouts > 0) {
+                int regnum = fCrtutils->AuxDetRegionNameToNum(trg.reg);
+                if( (fRegions.insert(regnum)).second) fRegCounts[regnum] = nReadouts;
+                else fRegCounts[regnum] += nReadouts;
+            }
 
+            std::move(readout.data.begin(), readout.data.end(), std::back_inserter(dataCol));
         } // for taggers
 
         if (fVerbose) {
@@ -461,6 +282,210 @@ namespace icarus{
 
     }//end CreateData()
 
+    //-----------------------------------------------------------------------------
+    // front-end emulation for a single FEB: a forward sweep over its time-ordered signals.
+    // the trigger candidate is moved forward (and the sweep restarted after it) whenever
+    // the required layer-layer coincidence is not found.
+    void CRTDetSimAlg::ProcessTagger(uint8_t mac5, Tagger const& tagger,
+                                     vector<Tagger const*> const& partners,
+                                     FEBReadout& readout) const
+    {
+        readout = FEBReadout{};
+
+        vector<ChanData> const& data = tagger.data;
+        vector<AuxDetIDE> const& ide = tagger.ide;
+        const char type = tagger.type;
+
+        //check "open" coincidence (just check if coincdence possible w/hit in both layers) 
+        if ( ((type=='c' && fApplyCoincidenceC) || (type=='d' && fApplyCoincidenceD))
+             && tagger.layerid.count()<2 ) {
+            readout.nmiss_opencoin++;
+            return;
+        }
+
+        if (fUltraVerbose) std::cout << "processing data for FEB " << (int)mac5 << " with "
+                                << data.size() << " entries..." << '\n'
+                                << "    type: " <<  type << '\n'
+                                << "    region: " <<  tagger.reg << '\n'
+                                << "    layerID: " << tagger.FirstLayer() << '\n' << std::endl;
+
+        int event = 0; //FEB entry number (can have multiple per art event)
+        std::bitset<Tagger::kMaxChannels> trackNHold; //channels close in time to triggered readout above threshold
+        std::bitset<Tagger::kMaxLayers> layerNHold; //layers with channels above threshold (used for checking layer-layer coincidence)
+        std::array<size_t, Tagger::kMaxChannels> passingIndex; //index in passingData of each locked channel
+        bool minosPairFound = false, istrig=false;
+        vector<ChanData> passingData; //data to be included in "readout" of FEB
+        vector<AuxDetIDE> passingIDE;
+        uint64_t ttrig=0.0, ttmp=0.0;  //time stamps on trigger channel, channel considered as part of readout
+        size_t trigIndex = 0;
+        uint16_t adc[64];
+
+        //start a new readout candidate with the signal at index `trig` as trigger
+        auto setTrigger = [&](size_t trig) {
+            trigIndex = trig;
+            ttrig = data[trig].ts;
+            trackNHold.reset();
+            layerNHold.reset();
+            passingData.clear();
+            passingIDE.clear();
+            trackNHold.set(data[trig].channel);
+            layerNHold.set(tagger.chanlayer[data[trig].channel]);
+            passingIndex[data[trig].channel] = 0;
+            passingData.push_back(data[trig]);
+            passingIDE.push_back(ide[trig]);
+        };
+
+        //push the current readout candidate to the output
+        auto writeReadout = [&](const char* when) {
+            if (fUltraVerbose) {
+                std::cout << "creating CRTData product " << when << '\n'
+                          << "  mac5:           " << (int)mac5 << '\n'
+                          << "  FEB entry:      " << event << '\n'
+                          << "  trig time:      " << ttrig << '\n'
+                          << "  trig channel:   " << data[trigIndex].channel << '\n'
+                          << "  passing data:   " << std::endl;
+                for(size_t i=0; i<passingData.size(); i++) {
+                    std::cout
+                          << "     index:          " << i << '\n'
+                          << "     channel:        " << passingData[i].channel << '\n'
+                          << "     t0:             " << passingData[i].ts << '\n'
+                          << "     adc:            " << passingData[i].adc << std::endl;
+                }
+            }
+
+            if(passingData.size()>passingIDE.size()) 
+                std::cout << "data/IDE size mismatch! " << passingData.size()-passingIDE.size() << std::endl;
+            FillAdcArr(passingData,adc);
+            readout.data.emplace_back(FillCRTData(mac5,event,ttrig,ttrig,adc), passingIDE);
+            if (fUltraVerbose) std::cout << " ...success!" << std::endl;
+            event++;
+            readout.nhit += passingData.size();
+        };
+
+        //layer coincidence window; currently assumed to be the same as track and hold window (FIX ME!)
+        const double coinWindow = (type=='c')? fLayerCoincidenceWindowC
+                                : (type=='d')? fLayerCoincidenceWindowD
+                                : fLayerCoincidenceWindowM;
+        const bool applyLayerCoin = (type=='c' && fApplyCoincidenceC) || (type=='d' && fApplyCoincidenceD);
+
+        //outer (primary) loop over all data products for this FEB
+        for ( size_t i=0; i< data.size(); i++ ) {
+
+          //get data for earliest entry
+          if(i==0) {
+            setTrigger(0);
+            ttmp = ttrig; 
+            if(type!='m')
+                continue;
+          }
+          else {
+            ttmp = data[i].ts;
+          }
+
+          //for C and D modules only and coin. enabled, if assumed trigger channel has no coincidence
+          // set trigger channel to tmp channel and try again
+          if ( layerNHold.count()==1 && applyLayerCoin && ttmp-ttrig>coinWindow ) {
+               setTrigger(trigIndex+1);
+               i = trigIndex;
+               readout.nmiss_coin++;
+               continue;
+          }
+
+          //check if coincidence condtion met
+          //for c and d modules, just need time stamps within tagger obj
+          //for m modules, need to check coincidence with other tagger objs
+          if (type=='m' && !minosPairFound && fApplyCoincidenceM) {
+              for (Tagger const* trg2 : partners) {
+                  //find entry within coincidence window of this FEB's triggering channel
+                  if (HasDataInWindow(*trg2, ttrig, fLayerCoincidenceWindowM)) {
+                      minosPairFound = true;
+                      break;
+                  }
+              }
+
+              //if no coincidence pairs found, reinitialize and move to next FEB
+              if(!minosPairFound) {
+                  if(fUltraVerbose) 
+                      std::cout << "MINOS pair NOT found! Skipping to next FEB..." << std::endl;
+                  if(data.size()==1) continue;
+                  setTrigger(trigIndex+1);
+                  i = trigIndex;
+                  readout.nmiss_coin++;
+                  continue;
+              }
+              else
+                  istrig = true;
+          }//if minos module and no pair yet found
+
+          ChanData const& chanTmpData = data[i];
+
+          if (i>0 && ttmp < ttrig + coinWindow) {
+
+              //if channel not locked
+              if (!trackNHold.test(chanTmpData.channel)) {
+
+                  //channel added to vector of ChannelData for current FEB readout
+                  trackNHold.set(chanTmpData.channel);
+                  passingIndex[chanTmpData.channel] = passingData.size();
+                  passingData.push_back(chanTmpData);
+                  passingIDE.push_back(ide[i]);
+
+                  //if not m module, check to see if strip is first in time in adjacent layer w.r.t. trigger strip
+                  const int layer = tagger.chanlayer[chanTmpData.channel];
+                  if (!layerNHold.test(layer)) {
+                      layerNHold.set(layer);
+                      //flagging strips which produce triggering condition (layer-layer coincidence)
+                      if (type != 'm') istrig = true;
+                  }
+              } //end if channel not locked
+
+              //check for signal biasing
+              else if (ttmp < ttrig + fBiasTime) {
+                  ChanData& locked = passingData[passingIndex[chanTmpData.channel]];
+                  int adctmp = locked.adc + chanTmpData.adc;
+                  if(adctmp>fQMax) adctmp = fQMax;
+                  locked.adc = adctmp;
+                  passingIDE.push_back(ide[i]);
+                  readout.ncombined++;
+              } //channel is locked but hit close in time to bias pulse height
+
+              else readout.nmiss_lock++; //data is discarded (not writeable)
+
+          }//if hits inside track and hold window
+
+          else if ( i>0 && ttmp <= ttrig + fDeadTime ) {
+              readout.nmiss_dead++;
+          } // hits occuring during digitization lost (dead time)
+
+          //"read out" data for this event, first hit after dead time as next trigger channel
+          else if ( ttmp > ttrig + fDeadTime) {
+              if(istrig) writeReadout("just after deadtime");
+              setTrigger(i);
+              minosPairFound = false;
+              istrig = false;
+          }
+
+          if (!(ttmp > ttrig + fDeadTime) && i==data.size()-1 && istrig)
+              writeReadout("at end of FEB events...");
+
+        }//for data entries (hits)
+
+        if(fUltraVerbose) std::cout << " outside loop over FEB data entries...moving on to next FEB..." << std::endl;
+
+    }//end ProcessTagger()
+
+    //-----------------------------------------------------------------------------
+    bool CRTDetSimAlg::HasDataInWindow(Tagger const& tagger, uint64_t t, double window) {
+        //data is time-ordered: the closest entries to t are the ones around it
+        auto const& data = tagger.data;
+        auto it = std::lower_bound(data.begin(), data.end(), t,
+            [](ChanData const& chan, uint64_t t){ return chan.ts < t; });
+        if (it != data.end() && util::absDiff(it->ts, t) < window) return true;
+        if (it != data.begin() && util::absDiff(std::prev(it)->ts, t) < window) return true;
+        return false;
+    }
+
+
     //-----------------------------------------------------------------------------
     // intented to be called within loop over AuxDetChannels and provided the 
     // AuxDetChannelID, AuxDetSensitiveChannelID, vector of AuxDetIDEs and 
@@ -672,21 +697,18 @@ namespace icarus{
                     (!fApplyStripCoinC && (q0>fQThresholdC || q1>fQThresholdC)) )
                 {
                     Tagger& tagger = fTaggers[mac5];
-                    tagger.layerid.insert(layid);
-                    tagger.chanlayer[channel0ID] = layid;
-                    tagger.chanlayer[channel1ID] = layid;
+                    tagger.SetChannelLayer(channel0ID, layid);
+                    tagger.SetChannelLayer(channel1ID, layid);
                     tagger.reg = region;
                     tagger.type = 'c';
                     tagger.modid = adid;
                     if (q0>fQThresholdC) {
-                        tagger.data.push_back(
-                          std::make_pair(FillChanData(channel0ID,q0,t0),ide));
+                        tagger.AddData(FillChanData(channel0ID,q0,t0), ide);
                         fNchandat_c++;
                     }
                     else fNmissthr_c++;
                     if (q1>fQThresholdC) {
-                        tagger.data.push_back(
-                          std::make_pair(FillChanData(channel1ID,q1,t1),ide));
+                        tagger.AddData(FillChanData(channel1ID,q1,t1), ide);
                         fNchandat_c++;
                     }
                     else fNmissthr_c++;
@@ -696,37 +718,31 @@ namespace icarus{
 
             if (auxDetType=='d' && q0 > fQThresholdD) {
                     Tagger& tagger = fTaggers[mac5];
-                    tagger.layerid.insert(layid);
-                    tagger.chanlayer[channel0ID] = layid;
+                    tagger.SetChannelLayer(channel0ID, layid);
                     tagger.reg = region;
                     tagger.type = 'd';
                     tagger.modid = adid;
-                    tagger.data.push_back(
-                      std::make_pair(FillChanData(channel0ID,q0,t0),ide));
+                    tagger.AddData(FillChanData(channel0ID,q0,t0), ide);
                     fNchandat_d++;
             }//if one strip above threshold
 
             if (auxDetType=='m') {
                     if(q0 > fQThresholdM) {
                       Tagger& tagger = fTaggers[mac5];
-                      tagger.layerid.insert(layid);
-                      tagger.chanlayer[channel0ID] = layid;
+                      tagger.SetChannelLayer(channel0ID, layid);
                       tagger.reg = region;
                       tagger.type = 'm';
                       tagger.modid = adid;
-                      tagger.data.push_back(
-                        std::make_pair(FillChanData(channel0ID,q0,t0),ide));
+                      tagger.AddData(FillChanData(channel0ID,q0,t0), ide);
                       fNchandat_m++;
                     }
                     if(q0Dual > fQThresholdM && fCrtutils->NFeb(adid)==2) {
                       Tagger& tagger = fTaggers[mac5dual];
-                      tagger.layerid.insert(layid);
-                      tagger.chanlayer[channel0ID] = layid;
+                      tagger.SetChannelLayer(channel0ID, layid);
                       tagger.reg = region;
                       tagger.type = 'm';
                       tagger.modid = adid;
-                      tagger.data.push_back(
-                        std::make_pair(FillChanData(channel0ID,q0Dual,t0Dual),ide));
+                      tagger.AddData(FillChanData(channel0ID,q0Dual,t0Dual), ide);
                       fNchandat_m++;
                     }
                     if(q0 > fQThresholdM && q0Dual > fQThresholdM) fNdual_m++;
@@ -911,7 +927,7 @@ namespace icarus{
 
     //----------------------------------------------------------------
     // function to make fill CRTData products a bit easer
-    CRTData CRTDetSimAlg::FillCRTData(uint8_t mac, uint32_t entry, uint64_t t0, uint64_t t1, uint16_t adc[64]){
+    CRTData CRTDetSimAlg::FillCRTData(uint8_t mac, uint32_t entry, uint64_t t0, uint64_t t1, uint16_t adc[64]) const {
         CRTData dat;
         dat.fMac5 = mac;
         dat.fEntry = entry;
@@ -925,7 +941,7 @@ namespace icarus{
     }
  
     //------------------------------------------------------------------
-    ChanData CRTDetSimAlg::FillChanData(int channel, uint16_t adc, uint64_t ts) {
+    ChanData CRTDetSimAlg::FillChanData(int channel, uint16_t adc, uint64_t ts) const {
         ChanData dat;
         dat.channel = channel;
         dat.adc = adc;
@@ -935,7 +951,7 @@ namespace icarus{
     }
 
     //---------------------------------------------------------------------------
-    void CRTDetSimAlg::FillAdcArr(const vector<ChanData>& data, uint16_t arr[64]) {
+    void CRTDetSimAlg::FillAdcArr(const vector<ChanData>& data, uint16_t arr[64]) const {
        for(int chan=0; chan<64; chan++)
            arr[chan] = 0;
        for(auto const& dat : data) {
@@ -22,6 +22,8 @@
 #include "CLHEP/Random/RandPoisson.h"
 
 //C++ includes
+#include <array>
+#include <bitset>
 #include <cmath>
 #include <map>
 #include <set>
@@ -56,13 +58,41 @@ struct ChanData {
     uint64_t ts;
 };//ChanData
 
+/**
+ * Signals above threshold collected by one front-end board (FEB).
+ *
+ * The signals are stored as parallel arrays: `data` holds the small records
+ * used by the front-end emulation, `ide` the true energy deposit producing
+ * each of them, which is only copied to the output. `SortByTime()` orders
+ * both arrays by time stamp.
+ */
 struct Tagger {
+    static constexpr std::size_t kMaxChannels = 64; //channels in a FEB
+    static constexpr std::size_t kMaxLayers = 3; //two layers, plus one for undetermined layer
+
     char type;
     int modid;
     string reg; //crt region where FEB is located
-    set<int> layerid; //keep track of layers hit accross whole event window
-    map<int,int> chanlayer; //map chan # to layer
-    vector<pair<ChanData,AuxDetIDE>> data; //time and charge info for each channel > thresh
+    std::bitset<kMaxLayers> layerid; //keep track of layers hit accross whole event window
+    std::array<int, kMaxChannels> chanlayer {}; //map chan # to layer
+    vector<ChanData> data; //time and charge info for each channel > thresh
+    vector<AuxDetIDE> ide; //energy deposit for each entry in data
+
+    /// Converts a layer ID into its index in `layerid` and `chanlayer`.
+    static int LayerIndex(int layid)
+      { return (layid == 0 || layid == 1)? layid: static_cast<int>(kMaxLayers) - 1; }
+
+    /// Index of the lowest layer with signals in this FEB.
+    int FirstLayer() const;
+
+    /// Records that `channel` belongs to the layer `layid`.
+    void SetChannelLayer(int channel, int layid);
+
+    /// Adds a signal and the energy deposit which produced it.
+    void AddData(ChanData const& chan, AuxDetIDE const& deposit);
+
+    /// Orders the signals by increasing time stamp.
+    void SortByTime();
 };//Tagger
 
 
@@ -82,6 +112,17 @@ class icarus::crt::CRTDetSimAlg {
 
  private:
 
+    /// Readouts and front-end losses of a single FEB, filled by `ProcessTagger()`.
+    struct FEBReadout {
+        vector<pair<CRTData, vector<AuxDetIDE>>> data; //readouts, in time order
+        int nhit = 0;         //channel signals in the readouts
+        int ncombined = 0;    //signals combined with an earlier one in the same channel
+        int nmiss_lock = 0;   //signals lost to a locked channel
+        int nmiss_dead = 0;   //signals lost to dead time
+        int nmiss_opencoin = 0; //1 if no layer-layer coincidence was possible
+        int nmiss_coin = 0;   //trigger candidates without coincidence
+    };
+
     //fhicl configurable vars
     bool   fVerbose;
     bool   fUltraVerbose;
@@ -154,9 +195,27 @@ class icarus::crt::CRTDetSimAlg {
     uint64_t GetChannelTriggerTicks(detinfo::ElecClock& clock,
                                   double t0, float npeMean, float r);
 
-    CRTData  FillCRTData(uint8_t mac, uint32_t entry, uint64_t t0, uint64_t ts1, uint16_t adc[32]);
-    ChanData FillChanData(int channel, uint16_t adc, uint64_t ts);
-    void FillAdcArr(const vector<ChanData>& data, uint16_t arr[32]);
+    /**
+     * Emulates the front-end trigger, track-and-hold and dead time of one FEB.
+     *
+     * @param mac5 ID of the board
+     * @param tagger signals of the board, already sorted by time
+     * @param partners MINOS boards which can provide layer coincidence
+     * @param[out] readout the readouts of the board and the signal losses
+     *
+     * The signals of `tagger` are swept forward in time; the function does not
+     * modify any data member and may be run concurrently on different boards.
+     */
+    void ProcessTagger(uint8_t mac5, Tagger const& tagger,
+                       vector<Tagger const*> const& partners,
+                       FEBReadout& readout) const;
+
+    /// Returns whether any signal of `tagger` is within `window` of `t` [ns].
+    static bool HasDataInWindow(Tagger const& tagger, uint64_t t, double window);
+
+    CRTData  FillCRTData(uint8_t mac, uint32_t entry, uint64_t t0, uint64_t ts1, uint16_t adc[64]) const;
+    ChanData FillChanData(int channel, uint16_t adc, uint64_t ts) const;
+    void FillAdcArr(const vector<ChanData>& data, uint16_t arr[64]) const;
 };
 
 #endif
@@ -0,0 +1,140 @@
+#include "icaruscode/CRT/CRTUtils/CRTPMTMatchingAlg.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace icarus::crt;
+
+//----------------------------------------------------------------------
+CRTPMTMatchingAlg::CRTPMTMatchingAlg(double flashPEThreshold, double hitPEThreshold, double coincidenceWindow)
+  : fFlashPEThreshold(flashPEThreshold)
+  , fHitPEThreshold(hitPEThreshold)
+  , fCoincidenceWindow(coincidenceWindow)
+{}
+
+//----------------------------------------------------------------------
+void CRTPMTMatchingAlg::SetFlashes(std::vector<FlashInfo> flashes){
+
+  fFlashes = std::move(flashes);
+
+  // flashes above threshold, sorted by time (and by input order on ties)
+  std::vector<std::size_t> sorted;
+  for(std::size_t i = 0; i < fFlashes.size(); i++){
+    if(fFlashes[i].totalPE < fFlashPEThreshold) continue;
+    sorted.push_back(i);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+    [this](std::size_t a, std::size_t b){ return fFlashes[a].time < fFlashes[b].time; });
+
+  fSortedFlashTimes.resize(sorted.size());
+  for(std::size_t i = 0; i < sorted.size(); i++) fSortedFlashTimes[i] = fFlashes[sorted[i]].time;
+
+  // sparse table of the lowest input index in each run of 2^k sorted flashes
+  fFirstFlashTable.clear();
+  if(sorted.empty()) return;
+  fFirstFlashTable.push_back(std::move(sorted));
+  for(std::size_t width = 2; width <= fSortedFlashTimes.size(); width *= 2){
+    std::vector<std::size_t> const& prev = fFirstFlashTable.back();
+    std::vector<std::size_t> level(fSortedFlashTimes.size() - width + 1);
+    for(std::size_t i = 0; i < level.size(); i++)
+      level[i] = std::min(prev[i], prev[i + width / 2]);
+    fFirstFlashTable.push_back(std::move(level));
+  }
+}
+
+//----------------------------------------------------------------------
+void CRTPMTMatchingAlg::SetOpHits(std::vector<OpHitInfo> opHits){
+
+  fOpHits = std::move(opHits);
+
+  fSortedOpHits.clear();
+  for(std::size_t i = 0; i < fOpHits.size(); i++){
+    if(fOpHits[i].pe < fHitPEThreshold) continue;
+    fSortedOpHits.push_back(i);
+  }
+  std::stable_sort(fSortedOpHits.begin(), fSortedOpHits.end(),
+    [this](std::size_t a, std::size_t b){ return fOpHits[a].time < fOpHits[b].time; });
+
+  fSortedOpHitTimes.resize(fSortedOpHits.size());
+  for(std::size_t i = 0; i < fSortedOpHits.size(); i++) fSortedOpHitTimes[i] = fOpHits[fSortedOpHits[i]].time;
+}
+
+//----------------------------------------------------------------------
+CRTPMTMatchingAlg::FlashMatch CRTPMTMatchingAlg::MatchFlash(double tcrt) const {
+
+  FlashMatch match;
+  double firstHitTime = std::numeric_limits<double>::max();
+
+  // Walk through the flashes which would in turn be the closest one when
+  // scanning them in input order: the first one, then the first one closer
+  // than it, and so on; the last one is the match.
+  std::size_t iflash = FirstFlashIn(0, fSortedFlashTimes.size());
+  while(iflash != NoMatch){
+    FlashInfo const& flash = fFlashes[iflash];
+    match.flash = iflash;
+    if(flash.hasHits && flash.firstHit.time < firstHitTime){
+      firstHitTime = flash.firstHit.time;
+      match.firstHitFlash = iflash;
+    }
+
+    // all the flashes before this one in input order are farther than it,
+    // so the next closer one is the first among the closer ones
+    auto const [first, last] = FlashesCloserThan(tcrt, std::abs(tcrt - flash.time));
+    iflash = FirstFlashIn(first, last);
+  }
+
+  return match;
+}
+
+//----------------------------------------------------------------------
+std::size_t CRTPMTMatchingAlg::MatchOpHit(double tcrt) const {
+
+  auto const begin = fSortedOpHitTimes.begin();
+  auto const split = std::lower_bound(begin, fSortedOpHitTimes.end(), tcrt);
+  auto const first = std::partition_point(begin, split,
+    [this,tcrt](double t){ return !(tcrt - t < fCoincidenceWindow); });
+  auto const last = std::partition_point(split, fSortedOpHitTimes.end(),
+    [this,tcrt](double t){ return t - tcrt < fCoincidenceWindow; });
+
+  // the most PE in the window, the first one in input order on ties
+  std::size_t best = NoMatch;
+  double pemax = 0.;
+  for(auto it = first; it != last; ++it){
+    std::size_t const ihit = fSortedOpHits[it - begin];
+    double const pe = fOpHits[ihit].pe;
+    if(pe > pemax || (pe == pemax && best != NoMatch && ihit < best)){
+      pemax = pe;
+      best = ihit;
+    }
+  }
+
+  return best;
+}
+
+//----------------------------------------------------------------------
+std::size_t CRTPMTMatchingAlg::FirstFlashIn(std::size_t first, std::size_t last) const {
+
+  if(first >= last) return NoMatch;
+
+  std::size_t level = 0;
+  while((std::size_t(2) << level) <= last - first) level++;
+
+  std::vector<std::size_t> const& table = fFirstFlashTable[level];
+  return std::min(table[first], table[last - (std::size_t(1) << level)]);
+}
+
+//----------------------------------------------------------------------
+std::pair<std::size_t, std::size_t> CRTPMTMatchingAlg::FlashesCloserThan(double tcrt, double maxDist) const {
+
+  // the distance is computed as |tcrt - t| in the scan, which is monotonic on
+  // either side of tcrt: the closer flashes are a contiguous range
+  auto const begin = fSortedFlashTimes.begin();
+  auto const split = std::lower_bound(begin, fSortedFlashTimes.end(), tcrt);
+  auto const first = std::partition_point(begin, split,
+    [tcrt,maxDist](double t){ return !(tcrt - t < maxDist); });
+  auto const last = std::partition_point(split, fSortedFlashTimes.end(),
+    [tcrt,maxDist](double t){ return t - tcrt < maxDist; });
+
+  return { std::size_t(first - begin), std::size_t(last - begin) };
+}
@@ -0,0 +1,107 @@
+#ifndef ICARUS_CRTPMTMATCHINGALG_H
+#define ICARUS_CRTPMTMATCHINGALG_H
+
+// C++ includes
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace icarus {
+ namespace crt {
+    class CRTPMTMatchingAlg;
+ }
+}
+
+/**
+ * Matches CRT hits in time with optical flashes and with optical hits.
+ *
+ * The flashes and the optical hits of an event are described once, with the
+ * quantities needed for the matching (time, PE, barycentre, position of the
+ * optical detector), and sorted in time; each CRT hit time is then matched by
+ * bisection, without scanning all of them.
+ *
+ * The results are the same as scanning the flashes and the hits in the order
+ * they were given:
+ *  * the matched flash is the closest in time among the ones above threshold
+ *    (the first one given, on ties);
+ *  * the "first hit" of the match is the earliest optical hit of the flashes
+ *    which have been the closest in time so far during that scan (this is how
+ *    `CRTPMTMatchingAna` has always filled its `FlashHit` variables);
+ *  * the matched optical hit is the one with the most PE within the
+ *    coincidence window among the ones above threshold (the first one, on ties).
+ */
+class icarus::crt::CRTPMTMatchingAlg {
+
+ public:
+
+    using Position_t = std::array<double, 3>;
+
+    static constexpr std::size_t NoMatch = std::numeric_limits<std::size_t>::max();
+
+    /// An optical hit: time, PE and center of its optical detector.
+    struct OpHitInfo {
+        double     time;
+        double     pe;
+        Position_t position;
+    };
+
+    /// An optical flash, with its barycentre and its earliest optical hit.
+    struct FlashInfo {
+        double     time;
+        double     totalPE;
+        Position_t barycentre;             ///< (0, y, z) of the flash
+        int        tpc;                    ///< label key of the flash collection
+        OpHitInfo  firstHit { std::numeric_limits<double>::max(), 0., { 0., 0., 0. } };
+        bool       hasHits = false;        ///< whether `firstHit` is set
+    };
+
+    /// Result of the flash matching of a CRT hit: indices in the input flashes.
+    struct FlashMatch {
+        std::size_t flash = NoMatch;          ///< matched flash
+        std::size_t firstHitFlash = NoMatch;  ///< flash with the "first hit"
+
+        bool matched() const { return flash != NoMatch; }
+        bool hasFirstHit() const { return firstHitFlash != NoMatch; }
+    };
+
+    CRTPMTMatchingAlg(double flashPEThreshold, double hitPEThreshold, double coincidenceWindow);
+
+    /// Sets the flashes of the event, in the order they would be scanned.
+    void SetFlashes(std::vector<FlashInfo> flashes);
+
+    /// Sets the optical hits of the event, in the order they would be scanned.
+    void SetOpHits(std::vector<OpHitInfo> opHits);
+
+    const std::vector<FlashInfo>& Flashes() const { return fFlashes; }
+    const std::vector<OpHitInfo>& OpHits() const { return fOpHits; }
+
+    /// Matches a CRT hit at time `tcrt` with the flashes.
+    FlashMatch MatchFlash(double tcrt) const;
+
+    /// Matches a CRT hit at time `tcrt` with the optical hits (`NoMatch` if none).
+    std::size_t MatchOpHit(double tcrt) const;
+
+ private:
+
+    /// Lowest index among the sorted flashes in [`first`, `last`) (`NoMatch` if empty).
+    std::size_t FirstFlashIn(std::size_t first, std::size_t last) const;
+
+    /// Range of sorted flashes closer than `maxDist` to `tcrt`.
+    std::pair<std::size_t, std::size_t> FlashesCloserThan(double tcrt, double maxDist) const;
+
+    double fFlashPEThreshold;
+    double fHitPEThreshold;
+    double fCoincidenceWindow;
+
+    std::vector<FlashInfo>                fFlashes;
+    std::vector<OpHitInfo>                fOpHits;
+
+    std::vector<double>                   fSortedFlashTimes;   ///< times of flashes above threshold
+    std::vector<std::vector<std::size_t>> fFirstFlashTable;    ///< sparse table: lowest index in 2^k sorted flashes
+    std::vector<double>                   fSortedOpHitTimes;   ///< times of optical hits above threshold
+    std::vector<std::size_t>              fSortedOpHits;       ///< their indices, sorted by time then index
+};
+
+#endif
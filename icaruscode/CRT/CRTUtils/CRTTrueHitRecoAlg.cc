@@ -4,6 +4,9 @@
 #include "icaruscode/CRT/CRTUtils/CRTTrueHitRecoAlg.h"
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom()
 
+#include <algorithm>
+#include <tuple>
+
 using namespace icarus::crt;
 
 //----------------------------------------------------------------------
@@ -35,19 +38,19 @@ void CRTTrueHitRecoAlg::reconfigure(const Config& config){
 
 //------------------------------------------------------------------------------
 vector<pair<sbn::crt::CRTHit,vector<sim::AuxDetIDE>>> CRTTrueHitRecoAlg::CreateCRTHits(
-       vector<art::Ptr<sim::AuxDetSimChannel>> adscList) 
+       const vector<art::Ptr<sim::AuxDetSimChannel>>& adscList) 
 {
     vector<pair<CRTHit,vector<sim::AuxDetIDE>>> hitCol;
-    map<int,map<int,tagger>> trackTaggers; //trackID -> (moduleID -> tagger )
-   
-    //fill taggers
+
+    //collect the strip deposits
+    fDeposits.clear();
+
     //loop over AuxDetSimChannels 
     for(auto const& adsc : adscList) {
 
         const int    adID    = adsc->AuxDetID();
-        const int    layerID = fCrtutils->GetLayerID(adsc);
-        const char   type    = fCrtutils->GetAuxDetType(adID);
-        const string region  = fCrtutils->GetAuxDetRegion(adID);
+        ModuleInfo&  info    = GetModuleInfo(adID);
+        const int    layerID = GetLayerID(adsc, info);
         const int    adsID   = adsc->AuxDetSensitiveID();
 
         //loop over AuxDetIDEs
@@ -58,181 +61,208 @@ vector<pair<sbn::crt::CRTHit,vector<sim::AuxDetIDE>>> CRTTrueHitRecoAlg::CreateC
                 continue;
             if(!fRollupUnusedIds && ide.trackID<0)
                 continue;
-            tagger& tag = (trackTaggers[ide.trackID])[adID];
-            tag.type = type;
-            tag.region = region;
-            tag.layerID.insert(layerID);
-            tag.stripLayer[adsID] = layerID;
-            tag.stripIDE[adsID] = ide;
+            fDeposits.push_back({ ide.trackID, adID, adsID, layerID, ide, TLorentzVector() });
         }//AuxDetIDEs
     }//AuxDetSimChannels
 
+    //order by track, module and strip; of many deposits in the same strip, the last one is kept
+    std::stable_sort(fDeposits.begin(), fDeposits.end(), [](StripDeposit const& a, StripDeposit const& b)
+        { return std::tie(a.trackID, a.moduleID, a.stripID) < std::tie(b.trackID, b.moduleID, b.stripID); });
+
+    auto const sameStrip = [](StripDeposit const& a, StripDeposit const& b)
+        { return a.trackID == b.trackID && a.moduleID == b.moduleID && a.stripID == b.stripID; };
+
+    size_t nDeposits = 0;
+    for(size_t i = 0; i < fDeposits.size(); i++) {
+        if(i+1 < fDeposits.size() && sameStrip(fDeposits[i], fDeposits[i+1])) continue;
+        if(nDeposits != i) fDeposits[nDeposits] = std::move(fDeposits[i]);
+        fDeposits[nDeposits].point = fCrtutils->AvgIDEPoint(fDeposits[nDeposits].ide);
+        nDeposits++;
+    }
+    fDeposits.resize(nDeposits);
+
     int nmisscd=0, nmisspair=0;
 
     //apply logic to form hits
     //loop over trackIDs
-    for (auto const& trk : trackTaggers) {
-
-        map <int,tagger> mTaggers; //MINOS module ID -> tagger
-        // loop over taggers: modID->strip hit info
-        for (auto const& tag : trk.second) {
-    
-            vector<sim::AuxDetIDE> vide; //IDEs in hit
-            //XYZTVector 
-            TLorentzVector rHit(0.,0.,0.,0.); //average hit position
-            vector<uint8_t> feb_id = {(fCrtutils->ADToMac( tag.first)).first};
-            map<uint8_t,vector< pair<int,float> > > pesmap; 
-            float peshit = 0.;
-            double xerr=0., yerr=0., zerr = 0.;
+    for(size_t trackBegin = 0; trackBegin < fDeposits.size(); ) {
+
+        const int trackID = fDeposits[trackBegin].trackID;
+
+        //modules hit by this track
+        fTrackModules.clear();
+        size_t trackEnd = trackBegin;
+        for(; trackEnd < fDeposits.size() && fDeposits[trackEnd].trackID == trackID; trackEnd++) {
+            StripDeposit const& strip = fDeposits[trackEnd];
+            if(fTrackModules.empty() || fTrackModules.back().moduleID != strip.moduleID)
+                fTrackModules.push_back({ strip.moduleID, trackEnd, trackEnd, strip.layerID, strip.layerID });
+            ModuleDeposits& module = fTrackModules.back();
+            module.end = trackEnd + 1;
+            module.minLayer = std::min(module.minLayer, strip.layerID);
+            module.maxLayer = std::max(module.maxLayer, strip.layerID);
+        }
+        trackBegin = trackEnd;
+
+        fRegionRank.assign(fRegionNames.size(), std::numeric_limits<size_t>::max());
+        fMinosModules.clear();
+        size_t nRegions = 0;
+
+        // loop over modules
+        for(size_t moduleIdx = 0; moduleIdx < fTrackModules.size(); moduleIdx++) {
+
+            ModuleDeposits const& module = fTrackModules[moduleIdx];
+            ModuleInfo const& info = fModuleInfo[module.moduleID];
 
 	    // if c or d type module
-            if (tag.second.type=='c' || tag.second.type=='d') {
+            if (info.type=='c' || info.type=='d') {
 
                 // if "X-Y" coincidence
-                if (tag.second.layerID.size()>1) {
-    
-                    // loop over module strips map: stripID->pos 4-vec
-                    for (auto const& ide : tag.second.stripIDE) {
-                        rHit += fCrtutils->AvgIDEPoint(ide.second);
-                        vide.push_back(ide.second);
-                        peshit+=ide.second.energyDeposited*1000;
-                        pesmap[feb_id[0]].push_back(std::make_pair(ide.first,ide.second.energyDeposited*1000));
-                    }
-    
-                    rHit*=1.0/tag.second.stripIDE.size();                    
-                    rHit.SetT(rHit.T()+fGlobalT0Offset); 
-
-                    //hit position RMS
-                    for ( auto const& ide : tag.second.stripIDE) {
-                        //XYZTVector 
-                        TLorentzVector point = fCrtutils->AvgIDEPoint(ide.second);
-                        xerr += pow(point.X()-rHit.X(),2);
-                        yerr += pow(point.Y()-rHit.Y(),2);
-                        zerr += pow(point.Z()-rHit.Z(),2);
-                    }
-                    xerr = sqrt(xerr/(tag.second.stripIDE.size()-1));
-                    yerr = sqrt(yerr/(tag.second.stripIDE.size()-1));
-                    zerr = sqrt(zerr/(tag.second.stripIDE.size()-1));
-    
-                } //if coincidence
-                else{
-                    nmisscd++;
-                    continue;
+                if (module.minLayer != module.maxLayer) {
+                    fGroup.assign(1, moduleIdx);
+                    AddHit(hitCol, fGroup, false);
                 }
-   
-                hitCol.push_back(std::make_pair( 
-                            FillCrtHit(feb_id, pesmap, peshit, rHit.T(), rHit.T(), 0, rHit.X(), xerr, 
-                              rHit.Y(), yerr, rHit.Z(), zerr, tag.second.region),
-                            vide) ); 
+                else nmisscd++;
 
             }//if c or d type
     
-            if ( tag.second.type=='m' ) {
-                mTaggers[tag.first] = tag.second;
+            if ( info.type=='m' ) {
+                if(fRegionRank[info.region] == std::numeric_limits<size_t>::max())
+                    fRegionRank[info.region] = nRegions++;
+                fMinosModules.emplace_back(fRegionRank[info.region], moduleIdx);
             }
     
-        } //loop over taggers
-
-        set <int> mPairs; //keep track of used auxdetIDs
-        for (auto const& tag : mTaggers) {
-
-           if (mPairs.find(tag.first) != mPairs.end()) continue; //don't double count   
-
-            vector<sim::AuxDetIDE> vide; //IDEs in hit
-            //XYZTVector 
-            TLorentzVector rHit(0.,0.,0.,0.); //average hit position
-            auto macpair = fCrtutils->ADToMac(tag.first);
-            uint8_t mac1 = macpair.first;
-            uint8_t mac11 = macpair.second;
-            vector<uint8_t> feb_id = {mac1};
-            if(mac1!=mac11) feb_id.push_back(mac11);
-            map<uint8_t,vector< pair<int,float> > > pesmap;
-            float peshit = 0.; 
-            bool pairFound = false;
-            double xerr=0., yerr=0., zerr = 0.;   
-            set<int> layers;
-            layers.insert(*(tag.second.layerID.begin()));
-            mPairs.insert(tag.first);
-
-            for (auto const& ide : tag.second.stripIDE) {
-                rHit += fCrtutils->AvgIDEPoint(ide.second);
-                vide.push_back(ide.second);
-                peshit+=ide.second.energyDeposited*1000;
-                pesmap[mac1].push_back(std::make_pair(ide.first,ide.second.energyDeposited*1000));
+        } //loop over modules
+
+        //all MINOS modules in the same region are merged into a hit,
+        //which needs at least two different layers
+        std::stable_sort(fMinosModules.begin(), fMinosModules.end(),
+            [](pair<size_t,size_t> const& a, pair<size_t,size_t> const& b){ return a.first < b.first; });
+
+        for(size_t groupBegin = 0; groupBegin < fMinosModules.size(); ) {
+
+            fGroup.clear();
+            int minLayer = fTrackModules[fMinosModules[groupBegin].second].minLayer;
+            int maxLayer = minLayer;
+            size_t groupEnd = groupBegin;
+            for(; groupEnd < fMinosModules.size() && fMinosModules[groupEnd].first == fMinosModules[groupBegin].first; groupEnd++) {
+                ModuleDeposits const& module = fTrackModules[fMinosModules[groupEnd].second];
+                fGroup.push_back(fMinosModules[groupEnd].second);
+                minLayer = std::min(minLayer, module.minLayer);
+                maxLayer = std::max(maxLayer, module.minLayer);
             }
+            groupBegin = groupEnd;
 
-            //inner loop over mTaggers (try to find a coincidence match) 
-            for (auto const& tag2 : mTaggers) {
-                if ( tag.first == tag2.first ) continue; //not the same module
-                if ( mPairs.find(tag2.first) != mPairs.end()) continue; //not aleady counted
-                if ( tag.second.region != tag2.second.region ) continue; //modules in same region
-
-                layers.insert(*(tag2.second.layerID.begin()));
-    
-                //mark module as counted
-                mPairs.insert(tag2.first);
-
-                //mac5's for 2nd module in pair
-                macpair = fCrtutils->ADToMac(tag2.first);
-                uint8_t mac2 = macpair.first;
-                uint8_t mac22 = macpair.second;
-                feb_id.push_back(mac2);
-                if(mac2!=mac22) feb_id.push_back(mac22);    
-
-                // loop over module strips map: stripID->pos 4-vec
-                for (auto const& ide : tag2.second.stripIDE) {
-                    rHit += fCrtutils->AvgIDEPoint(ide.second);
-                    vide.push_back(ide.second);
-                    peshit+=ide.second.energyDeposited*1000;
-                    pesmap[mac2].push_back(std::make_pair(ide.first,ide.second.energyDeposited*1000));
-                }//for xyzt in second tagger (module)
- 
-                if(layers.size()==2)
-                    pairFound = true;
-            }//inner loop over taggers
-    
-            if (pairFound) {
-
-                rHit*=1.0/vide.size();
-                rHit.SetT(rHit.T()+fGlobalT0Offset);
-
-                //hit position RMS
-                for ( auto const& ide : vide) {
-                    //XYZTVector 
-                    TLorentzVector point = fCrtutils->AvgIDEPoint(ide);
-                    xerr += pow(point.X()-rHit.X(),2);
-                    yerr += pow(point.Y()-rHit.Y(),2);
-                    zerr += pow(point.Z()-rHit.Z(),2);
-                }
-
-                xerr = sqrt(xerr/(vide.size()-1));
-                yerr = sqrt(yerr/(vide.size()-1));
-                zerr = sqrt(zerr/(vide.size()-1));
-
-                hitCol.push_back(std::make_pair(
-                            FillCrtHit(feb_id, pesmap, peshit, rHit.T(), rHit.T(), 0, rHit.X(), xerr,
-                              rHit.Y(), yerr, rHit.Z(), zerr, tag.second.region),
-                            vide) );
-
-            } 
+            if (minLayer != maxLayer) AddHit(hitCol, fGroup, true);
             else nmisspair++;
     
-        } // outer loop over minos taggers
-    } //loop over trackTaggers
+        } // loop over minos regions
+    } //loop over tracks
  
     std::cout << "CRTTrueHitRecoAlg: nmisscd=" << nmisscd << ", nmissm=" << nmisspair << std::endl;
    
     return hitCol;
 }
 
+//------------------------------------------------------------------------------
+void CRTTrueHitRecoAlg::AddHit(vector<pair<CRTHit,vector<sim::AuxDetIDE>>>& hitCol,
+                               const vector<size_t>& modules, bool bothMacs)
+{
+    vector<sim::AuxDetIDE> vide; //IDEs in hit
+    //XYZTVector 
+    TLorentzVector rHit(0.,0.,0.,0.); //average hit position
+    vector<uint8_t> feb_id;
+    map<uint8_t,vector< pair<int,float> > > pesmap; 
+    float peshit = 0.;
+    double xerr=0., yerr=0., zerr = 0.;
+
+    // loop over module strips
+    for (size_t moduleIdx : modules) {
+
+        ModuleDeposits const& module = fTrackModules[moduleIdx];
+        auto const& macpair = GetMacs(module.moduleID);
+        feb_id.push_back(macpair.first);
+        if(bothMacs && macpair.first!=macpair.second) feb_id.push_back(macpair.second);
+
+        vector< pair<int,float> >& pes = pesmap[macpair.first];
+        for (size_t i = module.begin; i < module.end; i++) {
+            StripDeposit const& strip = fDeposits[i];
+            rHit += strip.point;
+            vide.push_back(strip.ide);
+            peshit+=strip.ide.energyDeposited*1000;
+            pes.push_back(std::make_pair(strip.stripID,strip.ide.energyDeposited*1000));
+        }
+    }
+
+    rHit*=1.0/vide.size();
+    rHit.SetT(rHit.T()+fGlobalT0Offset);
+
+    //hit position RMS
+    for (size_t moduleIdx : modules) {
+        ModuleDeposits const& module = fTrackModules[moduleIdx];
+        for (size_t i = module.begin; i < module.end; i++) {
+            TLorentzVector const& point = fDeposits[i].point;
+            xerr += pow(point.X()-rHit.X(),2);
+            yerr += pow(point.Y()-rHit.Y(),2);
+            zerr += pow(point.Z()-rHit.Z(),2);
+        }
+    }
+
+    xerr = sqrt(xerr/(vide.size()-1));
+    yerr = sqrt(yerr/(vide.size()-1));
+    zerr = sqrt(zerr/(vide.size()-1));
+
+    const string& region = fRegionNames[fModuleInfo[fTrackModules[modules.front()].moduleID].region];
+
+    hitCol.emplace_back(
+        FillCrtHit(std::move(feb_id), std::move(pesmap), peshit, rHit.T(), rHit.T(), 0, rHit.X(), xerr,
+                   rHit.Y(), yerr, rHit.Z(), zerr, region),
+        std::move(vide));
+}
+
+//------------------------------------------------------------------------------
+CRTTrueHitRecoAlg::ModuleInfo& CRTTrueHitRecoAlg::GetModuleInfo(int adID)
+{
+    if((size_t)adID >= fModuleInfo.size()) fModuleInfo.resize(adID+1);
+
+    ModuleInfo& info = fModuleInfo[adID];
+    if(!info.known) {
+        info.type = fCrtutils->GetAuxDetType(adID);
+        const string region = fCrtutils->GetAuxDetRegion(adID);
+        info.region = std::find(fRegionNames.begin(), fRegionNames.end(), region) - fRegionNames.begin();
+        if(info.region == fRegionNames.size()) fRegionNames.push_back(region);
+        info.known = true;
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+int CRTTrueHitRecoAlg::GetLayerID(const art::Ptr<sim::AuxDetSimChannel>& adsc, ModuleInfo& info)
+{
+    const size_t adsID = adsc->AuxDetSensitiveID();
+    if(adsID >= info.stripLayers.size()) info.stripLayers.resize(adsID+1, kUnknownLayer);
+    if(info.stripLayers[adsID] == kUnknownLayer) info.stripLayers[adsID] = fCrtutils->GetLayerID(adsc);
+    return info.stripLayers[adsID];
+}
+
+//------------------------------------------------------------------------------
+const pair<uint8_t,uint8_t>& CRTTrueHitRecoAlg::GetMacs(int adID)
+{
+    ModuleInfo& info = fModuleInfo[adID];
+    if(!info.hasMacs) {
+        info.macs = fCrtutils->ADToMac(adID);
+        info.hasMacs = true;
+    }
+    return info.macs;
+}
+
 //--------------------------------------------------------------------------------------------
 // Function to make filling a CRTHit a bit faster
 sbn::crt::CRTHit CRTTrueHitRecoAlg::FillCrtHit(vector<uint8_t> tfeb_id, map<uint8_t,vector<pair<int,float>>> tpesmap, 
                             float peshit, double time0, double time1, int plane,
                             double x, double ex, double y, double ey, double z, double ez, string tagger){
     CRTHit crtHit;
-    crtHit.feb_id      = tfeb_id;
-    crtHit.pesmap      = tpesmap;
+    crtHit.feb_id      = std::move(tfeb_id);
+    crtHit.pesmap      = std::move(tpesmap);
     crtHit.peshit      = peshit;
     crtHit.ts0_s_corr  = time0*1e-9;
     crtHit.ts0_ns      = time0;
@@ -246,7 +276,7 @@ sbn::crt::CRTHit CRTTrueHitRecoAlg::FillCrtHit(vector<uint8_t> tfeb_id, map<uint
     crtHit.y_err       = ey;
     crtHit.z_pos       = z;
     crtHit.z_err       = ez;
-    crtHit.tagger      = tagger;
+    crtHit.tagger      = std::move(tagger);
 
     return crtHit;
 
@@ -19,6 +19,7 @@
 #include <utility>
 #include <map>
 #include <set>
+#include <limits>
 
 // ROOT includes
 //#include "Math/GenVector/XYZTVector.h"
@@ -37,14 +38,6 @@ namespace icarus {
  }
 }
 
-struct tagger {
-    char type;
-    string region;
-    std::set<int> layerID;
-    map<int,int> stripLayer;
-    map<int,sim::AuxDetIDE> stripIDE;
-};
-
 class icarus::crt::CRTTrueHitRecoAlg {
 
  public:
@@ -83,15 +76,54 @@ class icarus::crt::CRTTrueHitRecoAlg {
 
     void reconfigure(const Config& config);
 
-    vector<pair<CRTHit,vector<sim::AuxDetIDE>>> CreateCRTHits(vector<art::Ptr<sim::AuxDetSimChannel>> adscList);
+    vector<pair<CRTHit,vector<sim::AuxDetIDE>>> CreateCRTHits(const vector<art::Ptr<sim::AuxDetSimChannel>>& adscList);
 
-    // Function to make filling a CRTHit a bit faster
+    // Function to make filling a CRTHit a bit faster (containers are moved into the hit)
     CRTHit FillCrtHit(vector<uint8_t> tfeb_id, map<uint8_t,vector<pair<int,float>>> tpesmap, 
                    float peshit, double time0, double time1, int plane,
                    double x, double ex, double y, double ey, double z, double ez, std::string tagger);
 
  private:
 
+    // Energy deposited by a track in a strip (the last IDE, if more than one)
+    struct StripDeposit {
+        int            trackID;
+        int            moduleID; // AuxDet ID
+        int            stripID;  // AuxDet sensitive ID
+        int            layerID;
+        sim::AuxDetIDE ide;
+        TLorentzVector point;    // average IDE point
+    };
+
+    // Strips hit by a track in a module (range in fDeposits)
+    struct ModuleDeposits {
+        int    moduleID;
+        size_t begin;
+        size_t end;
+        int    minLayer;
+        int    maxLayer;
+    };
+
+    // Geometry information of a module, filled on first use
+    struct ModuleInfo {
+        bool        known = false;
+        char        type = 0;
+        size_t      region = 0;        // index in fRegionNames
+        bool        hasMacs = false;
+        pair<uint8_t,uint8_t> macs;
+        vector<int> stripLayers;       // kUnknownLayer if not computed yet
+    };
+
+    static constexpr int kUnknownLayer = std::numeric_limits<int>::min();
+
+    ModuleInfo& GetModuleInfo(int adID);
+    int GetLayerID(const art::Ptr<sim::AuxDetSimChannel>& adsc, ModuleInfo& info);
+    const pair<uint8_t,uint8_t>& GetMacs(int adID);
+
+    // Adds the hit from the strips of fTrackModules[i] for all i in `modules`
+    void AddHit(vector<pair<CRTHit,vector<sim::AuxDetIDE>>>& hitCol,
+                const vector<size_t>& modules, bool bothMacs);
+
     geo::GeometryCore const* fGeometryService;
     CRTCommonUtils* fCrtutils;
 
@@ -101,6 +133,17 @@ class icarus::crt::CRTTrueHitRecoAlg {
     bool   fRollupUnusedIds;
     double fGlobalT0Offset;
 
+    // cached geometry information, indexed by AuxDet ID
+    vector<ModuleInfo> fModuleInfo;
+    vector<string>     fRegionNames;
+
+    // per-event work areas, reused
+    vector<StripDeposit>   fDeposits;      // sorted by track, module and strip
+    vector<ModuleDeposits> fTrackModules;  // modules of the current track
+    vector<size_t>         fRegionRank;    // order of the regions in the current track
+    vector<pair<size_t,size_t>> fMinosModules; // (region rank, index in fTrackModules)
+    vector<size_t>         fGroup;
+
 };
 
 #endif
@@ -277,6 +277,9 @@ void CrtOpHitMatchAnalysis::analyze(art::Event const& e)
   geo::TPCGeo const& tpc11 = cryo1.TPC(1);
   ClearVecs();
 
+  //Intitialize CRTBackTracker
+  bt->Initialize(e);
+
   auto const& mctruths = //vector of MCTruths from GENIE
     *e.getValidHandle<vector<simb::MCTruth>>(fGenLabel);
 
@@ -156,6 +156,9 @@ void PhotBackground::analyze(art::Event const& e)
             continue;
     }//for MCParticles
 
+    //Intitialize CRTBackTracker
+    bt.Initialize(e);
+
     for(auto const& hit : trueHitList){
         for(const int id: bt.AllTrueIds(e,*hit)) {
             if(idToMu.find(id)==idToMu.end())
@@ -0,0 +1,127 @@
+/**
+ *  @file   ChannelMapFromSnapshot_tool.cc
+ *
+ *  @brief  Channel mapping tool reading a binary snapshot of the database.
+ *
+ */
+
+// Framework Includes
+#include "art/Utilities/ToolMacros.h"
+#include "cetlib/search_path.h"
+#include "cetlib/cpu_timer.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// ICARUS includes
+#include "icaruscode/Decode/ChannelMapping/IChannelMapping.h"
+#include "icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.h"
+
+// std includes
+#include <string>
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+// implementation follows
+
+namespace icarusDB {
+/**
+ *  @brief  ChannelMapFromSnapshot class definiton
+ *
+ *  The channel mapping is read from a snapshot file created with
+ *  `MakeChannelMapSnapshot` (see `icarusDB::ChannelMapSnapshot`), which is
+ *  mapped in memory: no database query and no parsing is needed.
+ *
+ *  Configuration parameters:
+ *  * `SnapshotFile` (string): name of the snapshot file, searched for in
+ *    `FW_SEARCH_PATH`
+ */
+class ChannelMapFromSnapshot : virtual public IChannelMapping
+{
+public:
+  /**
+   *  @brief  Constructor
+   *
+   *  @param  pset
+   */
+  explicit ChannelMapFromSnapshot(fhicl::ParameterSet const &pset);
+
+  virtual int BuildTPCFragmentIDToReadoutIDMap(TPCFragmentIDToReadoutIDMap&) const override;
+
+  virtual int BuildTPCReadoutBoardToChannelMap(TPCReadoutBoardToChannelMap&) const override;
+
+  virtual int BuildFragmentToDigitizerChannelMap(FragmentToDigitizerChannelMap&) const override;
+
+  virtual int BuildCRTChannelIDToHWtoSimMacAddressPairMap(CRTChannelIDToHWtoSimMacAddressPairMap&) const override;
+  virtual int BuildTopCRTHWtoSimMacAddressPairMap(TopCRTHWtoSimMacAddressPairMap&) const override;
+
+  virtual int BuildSideCRTCalibrationMap(SideCRTChannelToCalibrationMap&) const override;
+
+private:
+
+  std::string              fSnapshotFileName; //< File name of the snapshot
+  ChannelMapSnapshot::Maps fMaps;             //< Content of the snapshot
+};
+
+ChannelMapFromSnapshot::ChannelMapFromSnapshot(fhicl::ParameterSet const &pset)
+{
+    fSnapshotFileName = pset.get<std::string>("SnapshotFile");
+
+    std::string fullFileName;
+    cet::search_path searchPath("FW_SEARCH_PATH");
+
+    if (!searchPath.find_file(fSnapshotFileName, fullFileName))
+      throw cet::exception("ChannelMapFromSnapshot") << "Can't find input file: '" << fSnapshotFileName << "'\n";
+
+    cet::cpu_timer theClock;
+    theClock.start();
+
+    fMaps = ChannelMapSnapshot::fromFile(fullFileName).toMaps();
+
+    theClock.stop();
+
+    mf::LogInfo("ChannelMapFromSnapshot") << "Channel mapping read from '" << fullFileName
+      << "' in " << theClock.accumulated_real_time() << " s";
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+int ChannelMapFromSnapshot::BuildTPCFragmentIDToReadoutIDMap(TPCFragmentIDToReadoutIDMap& fragmentBoardMap) const
+{
+    fragmentBoardMap = fMaps.tpcFragments;
+    return 0;
+}
+
+int ChannelMapFromSnapshot::BuildTPCReadoutBoardToChannelMap(TPCReadoutBoardToChannelMap& rbChanMap) const
+{
+    rbChanMap = fMaps.tpcBoards;
+    return 0;
+}
+
+int ChannelMapFromSnapshot::BuildFragmentToDigitizerChannelMap(FragmentToDigitizerChannelMap& fragmentToDigitizerChannelMap) const
+{
+    fragmentToDigitizerChannelMap = fMaps.pmtFragments;
+    return 0;
+}
+
+int ChannelMapFromSnapshot::BuildCRTChannelIDToHWtoSimMacAddressPairMap(CRTChannelIDToHWtoSimMacAddressPairMap& crtChannelIDToHWtoSimMacAddressPairMap) const
+{
+    crtChannelIDToHWtoSimMacAddressPairMap = fMaps.crtChannels;
+    return 0;
+}
+
+int ChannelMapFromSnapshot::BuildTopCRTHWtoSimMacAddressPairMap(TopCRTHWtoSimMacAddressPairMap& topcrtHWtoSimMacAddressPairMap) const
+{
+    topcrtHWtoSimMacAddressPairMap = fMaps.topCRT;
+    return 0;
+}
+
+int ChannelMapFromSnapshot::BuildSideCRTCalibrationMap(SideCRTChannelToCalibrationMap& sideCRTChannelToCalibrationMap) const
+{
+    sideCRTChannelToCalibrationMap = fMaps.sideCRTCalibration;
+    return 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+DEFINE_ART_CLASS_TOOL(ChannelMapFromSnapshot)
+} // namespace icarusDB
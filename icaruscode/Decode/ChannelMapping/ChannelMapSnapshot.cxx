@@ -0,0 +1,609 @@
+/**
+ * @file   icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.cxx
+ * @brief  Flat, memory-mappable snapshot of the ICARUS channel mapping.
+ * @date   October 18, 2026
+ * @see    icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.h
+ */
+
+// library header
+#include "icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::copy(), std::equal()
+#include <fstream>
+#include <type_traits> // std::decay_t
+#include <utility> // std::exchange(), std::move()
+#include <cerrno>
+#include <cstring> // std::memcpy(), std::strerror()
+
+// POSIX
+#include <fcntl.h> // open()
+#include <sys/mman.h> // mmap(), munmap()
+#include <sys/stat.h> // fstat()
+#include <unistd.h> // close()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Largest number of entries accepted in a dense lookup table.
+  constexpr std::uint64_t MaxDenseTableSize = 1ULL << 24;
+
+  /// Returns `n` rounded up to a multiple of 8.
+  constexpr std::size_t align8(std::size_t n) { return (n + 7) & ~std::size_t(7); }
+
+
+  /// Returns the size of a dense table covering keys `min` to `max`.
+  std::uint64_t denseTableSize
+    (char const* what, std::int64_t min, std::int64_t max)
+  {
+    std::uint64_t const size = static_cast<std::uint64_t>(max - min) + 1;
+    if (size > MaxDenseTableSize) {
+      throw cet::exception("ChannelMapSnapshot")
+        << "Keys of " << what << " span from " << min << " to " << max
+        << ", too sparse for a dense lookup table (limit: "
+        << MaxDenseTableSize << " entries).\n";
+    }
+    return size;
+  } // denseTableSize()
+
+
+  /// Converts a count into a 32-bit record field, checking it fits.
+  std::uint32_t to32(std::size_t n, char const* what) {
+    if (n >= icarusDB::ChannelMapSnapshot::NoEntry) {
+      throw cet::exception("ChannelMapSnapshot")
+        << "Too many " << what << " (" << n << ") for the snapshot format.\n";
+    }
+    return static_cast<std::uint32_t>(n);
+  } // to32()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+icarusDB::ChannelMapSnapshot::~ChannelMapSnapshot() { release(); }
+
+
+// -----------------------------------------------------------------------------
+icarusDB::ChannelMapSnapshot::ChannelMapSnapshot
+  (ChannelMapSnapshot&& from) noexcept
+  : fData(std::exchange(from.fData, nullptr))
+  , fSize(std::exchange(from.fSize, 0))
+  , fOwned(std::move(from.fOwned))
+  , fMapped(std::exchange(from.fMapped, false))
+{}
+
+
+// -----------------------------------------------------------------------------
+auto icarusDB::ChannelMapSnapshot::operator= (ChannelMapSnapshot&& from) noexcept
+  -> ChannelMapSnapshot&
+{
+  if (&from != this) {
+    release();
+    fData = std::exchange(from.fData, nullptr);
+    fSize = std::exchange(from.fSize, 0);
+    fOwned = std::move(from.fOwned);
+    fMapped = std::exchange(from.fMapped, false);
+  }
+  return *this;
+} // icarusDB::ChannelMapSnapshot::operator= ()
+
+
+// -----------------------------------------------------------------------------
+auto icarusDB::ChannelMapSnapshot::buildMaps(IChannelMapping const& tool)
+  -> Maps
+{
+  Maps maps;
+  if (tool.BuildTPCFragmentIDToReadoutIDMap(maps.tpcFragments)) {
+    throw cet::exception("ChannelMapSnapshot")
+      << "Failed to read the TPC fragment map.\n";
+  }
+  if (tool.BuildTPCReadoutBoardToChannelMap(maps.tpcBoards)) {
+    throw cet::exception("ChannelMapSnapshot")
+      << "Failed to read the TPC readout board map.\n";
+  }
+  if (tool.BuildFragmentToDigitizerChannelMap(maps.pmtFragments)) {
+    throw cet::exception("ChannelMapSnapshot")
+      << "Failed to read the PMT fragment map.\n";
+  }
+  if (tool.BuildCRTChannelIDToHWtoSimMacAddressPairMap(maps.crtChannels)) {
+    throw cet::exception("ChannelMapSnapshot")
+      << "Failed to read the side CRT MAC address map.\n";
+  }
+  if (tool.BuildTopCRTHWtoSimMacAddressPairMap(maps.topCRT)) {
+    throw cet::exception("ChannelMapSnapshot")
+      << "Failed to read the top CRT MAC address map.\n";
+  }
+  if (tool.BuildSideCRTCalibrationMap(maps.sideCRTCalibration)) {
+    throw cet::exception("ChannelMapSnapshot")
+      << "Failed to read the side CRT calibration map.\n";
+  }
+  return maps;
+} // icarusDB::ChannelMapSnapshot::buildMaps()
+
+
+// -----------------------------------------------------------------------------
+auto icarusDB::ChannelMapSnapshot::fromMaps(Maps const& maps)
+  -> ChannelMapSnapshot
+{
+  //
+  // fill all the tables in separate containers first
+  //
+
+  // TPC fragments
+  std::vector<TPCFragmentRecord> tpcFragments;
+  std::vector<std::uint32_t> tpcFragmentBoards;
+  std::string crateNames;
+  for (auto const& [ fragmentID, crateAndBoards ]: maps.tpcFragments) {
+    auto const& [ crateName, boards ] = crateAndBoards;
+    tpcFragments.push_back({
+      fragmentID,
+      to32(crateNames.size(), "crate name characters"),
+      to32(crateName.size(), "crate name characters"),
+      to32(tpcFragmentBoards.size(), "TPC readout boards"),
+      to32(boards.size(), "TPC readout boards")
+    });
+    crateNames += crateName;
+    tpcFragmentBoards.insert(tpcFragmentBoards.end(), boards.begin(), boards.end());
+  } // for TPC fragments
+
+  // TPC readout boards
+  std::vector<TPCBoardRecord> tpcBoards;
+  std::vector<ChannelPlaneRecord> tpcChannels;
+  for (auto const& [ boardID, slotAndChannels ]: maps.tpcBoards) {
+    auto const& [ slot, channels ] = slotAndChannels;
+    tpcBoards.push_back({
+      boardID, slot,
+      to32(tpcChannels.size(), "TPC channels"),
+      to32(channels.size(), "TPC channels")
+    });
+    for (auto const& [ channel, plane ]: channels)
+      tpcChannels.push_back({ channel, plane });
+  } // for TPC readout boards
+
+  // PMT digitizers
+  std::vector<PMTFragmentRecord> pmtFragments;
+  std::vector<DigitizerChannelRecord> pmtChannels;
+  for (auto const& [ dbKey, channels ]: maps.pmtFragments) {
+    pmtFragments.push_back({
+      to32(dbKey, "PMT digitizer keys"),
+      to32(pmtChannels.size(), "PMT channels"),
+      to32(channels.size(), "PMT channels")
+    });
+    for (auto const& [ digitizerChannel, channelID ]: channels)
+      pmtChannels.push_back({ digitizerChannel, channelID });
+  } // for PMT digitizers
+
+  // CRT
+  std::vector<CRTChannelRecord> crtChannels;
+  for (auto const& [ channelID, macAddresses ]: maps.crtChannels)
+    crtChannels.push_back({ channelID, macAddresses.first, macAddresses.second });
+
+  std::vector<TopCRTRecord> topCRT;
+  for (auto const& [ hwMacAddress, simMacAddress ]: maps.topCRT)
+    topCRT.push_back({ hwMacAddress, simMacAddress });
+
+  std::vector<SideCRTCalibrationRecord> sideCRTCalibrations;
+  for (auto const& [ key, calib ]: maps.sideCRTCalibration) {
+    sideCRTCalibrations.push_back({
+      static_cast<std::int32_t>(key.first), static_cast<std::int32_t>(key.second),
+      calib.first, calib.second
+    });
+  }
+
+  //
+  // dense lookup tables
+  //
+  struct DenseTable {
+    std::vector<std::uint32_t> values;
+    std::uint32_t base = 0;
+    std::uint32_t base2 = 0;
+    std::uint32_t stride = 0;
+  };
+
+  // one-dimension table: `key(record)` -> `value(index, record)`
+  auto makeDense = [](char const* what, auto const& records, auto key,
+    auto value, std::uint32_t defValue)
+    {
+      DenseTable table;
+      if (records.empty()) return table;
+      std::uint32_t min = key(records.front()), max = min;
+      for (auto const& record: records) {
+        min = std::min(min, key(record));
+        max = std::max(max, key(record));
+      }
+      table.base = min;
+      table.values.assign(denseTableSize(what, min, max), defValue);
+      // later records override earlier ones with the same key
+      for (std::size_t i = 0; i < records.size(); ++i)
+        table.values[key(records[i]) - min] = value(i, records[i]);
+      return table;
+    };
+  auto recordIndex
+    = [](std::size_t i, auto const&){ return static_cast<std::uint32_t>(i); };
+
+  DenseTable const tpcFragmentIndex = makeDense("TPC fragment IDs",
+    tpcFragments, [](TPCFragmentRecord const& r){ return r.fragmentID; },
+    recordIndex, NoEntry);
+  DenseTable const tpcBoardIndex = makeDense("TPC readout board IDs",
+    tpcBoards, [](TPCBoardRecord const& r){ return r.boardID; },
+    recordIndex, NoEntry);
+  DenseTable const pmtFragmentIndex = makeDense("PMT digitizer keys",
+    pmtFragments, [](PMTFragmentRecord const& r){ return r.dbKey; },
+    recordIndex, NoEntry);
+  DenseTable const crtSimMacAddresses = makeDense("CRT hardware MAC addresses",
+    crtChannels, [](CRTChannelRecord const& r){ return r.hwMacAddress; },
+    [](std::size_t, CRTChannelRecord const& r){ return r.simMacAddress; }, 0U);
+  DenseTable const topCRTSimMacAddresses = makeDense
+    ("top CRT hardware MAC addresses",
+    topCRT, [](TopCRTRecord const& r){ return r.hwMacAddress; },
+    [](std::size_t, TopCRTRecord const& r){ return r.simMacAddress; }, 0U);
+
+  // two-dimension table: (MAC5, channel) -> index
+  DenseTable sideCRTIndex;
+  if (!sideCRTCalibrations.empty()) {
+    std::int32_t minMac = sideCRTCalibrations.front().mac5, maxMac = minMac;
+    std::int32_t minChannel = sideCRTCalibrations.front().channel;
+    std::int32_t maxChannel = minChannel;
+    for (SideCRTCalibrationRecord const& r: sideCRTCalibrations) {
+      minMac = std::min(minMac, r.mac5);
+      maxMac = std::max(maxMac, r.mac5);
+      minChannel = std::min(minChannel, r.channel);
+      maxChannel = std::max(maxChannel, r.channel);
+    }
+    std::uint64_t const nMacs
+      = denseTableSize("side CRT MAC5 addresses", minMac, maxMac);
+    std::uint64_t const nChannels
+      = denseTableSize("side CRT channels", minChannel, maxChannel);
+    denseTableSize("side CRT calibration entries", 0, nMacs * nChannels - 1);
+    sideCRTIndex.base = static_cast<std::uint32_t>(minMac);
+    sideCRTIndex.base2 = static_cast<std::uint32_t>(minChannel);
+    sideCRTIndex.stride = static_cast<std::uint32_t>(nChannels);
+    sideCRTIndex.values.assign(nMacs * nChannels, NoEntry);
+    for (std::size_t i = 0; i < sideCRTCalibrations.size(); ++i) {
+      SideCRTCalibrationRecord const& r = sideCRTCalibrations[i];
+      sideCRTIndex.values
+        [(r.mac5 - minMac) * nChannels + (r.channel - minChannel)]
+        = static_cast<std::uint32_t>(i);
+    }
+  } // if side CRT calibration
+
+  //
+  // lay out the sections
+  //
+  Header header {};
+  std::copy(std::begin(Magic), std::end(Magic), header.magic);
+  header.version = FormatVersion;
+  header.byteOrder = ByteOrderMark;
+  header.nSections = NSections;
+
+  std::size_t size = align8(sizeof(Header));
+  std::vector<std::pair<void const*, std::size_t>> content(NSections);
+  auto addSection = [&header,&size,&content](
+    SectionID id, auto const& data,
+    std::uint32_t base = 0, std::uint32_t base2 = 0, std::uint32_t stride = 0
+  ) {
+    using Elem_t = std::decay_t<decltype(*data.data())>;
+    std::size_t const bytes = data.size() * sizeof(Elem_t);
+    header.sections[id]
+      = { size, data.size(), sizeof(Elem_t), base, base2, stride };
+    content[id] = { data.data(), bytes };
+    size += align8(bytes);
+  };
+  auto addDense = [&addSection](SectionID id, DenseTable const& table)
+    { addSection(id, table.values, table.base, table.base2, table.stride); };
+
+  addSection(TPCFragments, tpcFragments);
+  addDense(TPCFragmentIndex, tpcFragmentIndex);
+  addSection(TPCFragmentBoards, tpcFragmentBoards);
+  addSection(CrateNames, crateNames);
+  addSection(TPCBoards, tpcBoards);
+  addDense(TPCBoardIndex, tpcBoardIndex);
+  addSection(TPCChannels, tpcChannels);
+  addSection(PMTFragments, pmtFragments);
+  addDense(PMTFragmentIndex, pmtFragmentIndex);
+  addSection(PMTChannels, pmtChannels);
+  addSection(CRTChannels, crtChannels);
+  addDense(CRTSimMacAddresses, crtSimMacAddresses);
+  addSection(TopCRT, topCRT);
+  addDense(TopCRTSimMacAddresses, topCRTSimMacAddresses);
+  addSection(SideCRTCalibrations, sideCRTCalibrations);
+  addDense(SideCRTIndex, sideCRTIndex);
+  header.size = size;
+
+  //
+  // copy everything into a single block
+  //
+  ChannelMapSnapshot snapshot;
+  snapshot.fOwned.assign(size / sizeof(std::uint64_t), 0);
+  std::byte* const data = reinterpret_cast<std::byte*>(snapshot.fOwned.data());
+  std::memcpy(data, &header, sizeof(Header));
+  for (std::size_t id = 0; id < NSections; ++id) {
+    auto const [ src, bytes ] = content[id];
+    if (bytes > 0) std::memcpy(data + header.sections[id].offset, src, bytes);
+  }
+  snapshot.fData = data;
+  snapshot.fSize = size;
+
+  return snapshot;
+} // icarusDB::ChannelMapSnapshot::fromMaps()
+
+
+// -----------------------------------------------------------------------------
+auto icarusDB::ChannelMapSnapshot::fromFile(std::string const& path)
+  -> ChannelMapSnapshot
+{
+  int const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw cet::exception("ChannelMapSnapshot")
+      << "Channel mapping snapshot file '" << path << "' can't be opened: "
+      << std::strerror(errno) << "\n";
+  }
+
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) != 0) {
+    int const error = errno;
+    ::close(fd);
+    throw cet::exception("ChannelMapSnapshot")
+      << "Can't determine the size of channel mapping snapshot file '" << path
+      << "': " << std::strerror(error) << "\n";
+  }
+
+  std::size_t const size = static_cast<std::size_t>(fileStat.st_size);
+  if (size < sizeof(Header)) {
+    ::close(fd);
+    throw cet::exception("ChannelMapSnapshot")
+      << "File '" << path << "' is too small (" << size
+      << " bytes) to be a channel mapping snapshot.\n";
+  }
+
+  void* const data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) {
+    int const error = errno;
+    ::close(fd);
+    throw cet::exception("ChannelMapSnapshot")
+      << "Channel mapping snapshot file '" << path
+      << "' can't be mapped in memory: " << std::strerror(error) << "\n";
+  }
+  ::close(fd); // the mapping stays valid
+
+  ChannelMapSnapshot snapshot;
+  snapshot.fData = static_cast<std::byte const*>(data);
+  snapshot.fSize = size;
+  snapshot.fMapped = true;
+
+  try {
+    snapshot.validate();
+  }
+  catch (cet::exception& e) {
+    throw cet::exception("ChannelMapSnapshot", "", e)
+      << "Channel mapping snapshot file '" << path << "' can't be used.\n";
+  }
+
+  return snapshot;
+} // icarusDB::ChannelMapSnapshot::fromFile()
+
+
+// -----------------------------------------------------------------------------
+void icarusDB::ChannelMapSnapshot::write(std::string const& path) const {
+
+  std::ofstream out { path, std::ios::binary | std::ios::trunc };
+  if (!out) {
+    throw cet::exception("ChannelMapSnapshot")
+      << "Can't create channel mapping snapshot file '" << path << "'.\n";
+  }
+  out.write(reinterpret_cast<char const*>(fData), fSize);
+  out.close();
+  if (!out) {
+    throw cet::exception("ChannelMapSnapshot")
+      << "Error writing channel mapping snapshot file '" << path << "'.\n";
+  }
+
+} // icarusDB::ChannelMapSnapshot::write()
+
+
+// -----------------------------------------------------------------------------
+auto icarusDB::ChannelMapSnapshot::toMaps() const -> Maps {
+
+  Maps maps;
+
+  for (TPCFragmentRecord const& fragment: tpcFragments()) {
+    auto const boards = readoutBoards(fragment);
+    maps.tpcFragments.emplace(fragment.fragmentID, std::make_pair(
+      std::string{ crateName(fragment) },
+      std::vector<unsigned int>(boards.begin(), boards.end())
+      ));
+  }
+
+  for (TPCBoardRecord const& board: tpcBoards()) {
+    auto& [ slot, channels ] = maps.tpcBoards[board.boardID];
+    slot = board.slot;
+    for (ChannelPlaneRecord const& cp: channelPlanes(board))
+      channels.emplace_back(cp.channel, cp.plane);
+  }
+
+  for (PMTFragmentRecord const& fragment: pmtFragments()) {
+    auto& channels = maps.pmtFragments[fragment.dbKey];
+    for (DigitizerChannelRecord const& ch: digitizerChannels(fragment))
+      channels.emplace_back(ch.digitizerChannel, ch.channelID);
+  }
+
+  for (CRTChannelRecord const& ch: crtChannels()) {
+    maps.crtChannels.emplace
+      (ch.channelID, std::make_pair(ch.hwMacAddress, ch.simMacAddress));
+  }
+
+  for (TopCRTRecord const& r: topCRT())
+    maps.topCRT.emplace(r.hwMacAddress, r.simMacAddress);
+
+  for (SideCRTCalibrationRecord const& r: sideCRTCalibrations()) {
+    maps.sideCRTCalibration.emplace
+      (std::make_pair(r.mac5, r.channel), std::make_pair(r.gain, r.pedestal));
+  }
+
+  return maps;
+} // icarusDB::ChannelMapSnapshot::toMaps()
+
+
+// -----------------------------------------------------------------------------
+std::string_view icarusDB::ChannelMapSnapshot::crateName
+  (TPCFragmentRecord const& fragment) const
+{
+  return {
+    section<char>(CrateNames).begin() + fragment.crateNameOffset,
+    fragment.crateNameLength
+  };
+} // icarusDB::ChannelMapSnapshot::crateName()
+
+
+// -----------------------------------------------------------------------------
+unsigned int icarusDB::ChannelMapSnapshot::simMacAddress
+  (unsigned int hwMacAddress) const
+{
+  std::uint32_t const sim = denseLookup(CRTSimMacAddresses, hwMacAddress);
+  return (sim == NoEntry)? 0U: sim;
+} // icarusDB::ChannelMapSnapshot::simMacAddress()
+
+
+// -----------------------------------------------------------------------------
+unsigned int icarusDB::ChannelMapSnapshot::topSimMacAddress
+  (unsigned int hwMacAddress) const
+{
+  std::uint32_t const sim = denseLookup(TopCRTSimMacAddresses, hwMacAddress);
+  return (sim == NoEntry)? 0U: sim;
+} // icarusDB::ChannelMapSnapshot::topSimMacAddress()
+
+
+// -----------------------------------------------------------------------------
+std::uint32_t icarusDB::ChannelMapSnapshot::sideCRTCalibrationIndex
+  (int mac5, int channel) const
+{
+  if (!fData) return NoEntry;
+  Section const& s = header().sections[SideCRTIndex];
+  if (s.count == 0) return NoEntry;
+  std::int64_t const iMac
+    = std::int64_t{ mac5 } - static_cast<std::int32_t>(s.base);
+  std::int64_t const iChannel
+    = std::int64_t{ channel } - static_cast<std::int32_t>(s.base2);
+  if ((iMac < 0) || (iChannel < 0) || (iChannel >= s.stride)) return NoEntry;
+  std::uint64_t const i = iMac * s.stride + iChannel;
+  if (i >= s.count) return NoEntry;
+  return reinterpret_cast<std::uint32_t const*>(fData + s.offset)[i];
+} // icarusDB::ChannelMapSnapshot::sideCRTCalibrationIndex()
+
+
+// -----------------------------------------------------------------------------
+void icarusDB::ChannelMapSnapshot::validate() const {
+
+  auto fail = [](){ return cet::exception("ChannelMapSnapshot"); };
+
+  Header const& h = header();
+  if (!std::equal(std::begin(Magic), std::end(Magic), h.magic))
+    throw fail() << "Not a channel mapping snapshot (wrong signature).\n";
+  if (h.byteOrder != ByteOrderMark) {
+    throw fail() << "Channel mapping snapshot was written with a different"
+      " byte order; it needs to be generated again.\n";
+  }
+  if (h.version != FormatVersion) {
+    throw fail() << "Channel mapping snapshot has format version " << h.version
+      << ", this code supports only version " << FormatVersion
+      << "; it needs to be generated again.\n";
+  }
+  if (h.size != fSize) {
+    throw fail() << "Channel mapping snapshot should be " << h.size
+      << " bytes long, but it is " << fSize << " (truncated?).\n";
+  }
+  if (h.nSections != NSections) {
+    throw fail() << "Channel mapping snapshot has " << h.nSections
+      << " sections, " << NSections << " expected.\n";
+  }
+
+  // section boundaries
+  std::uint32_t const elementSizes[NSections] = {
+    sizeof(TPCFragmentRecord),        // TPCFragments
+    sizeof(std::uint32_t),            // TPCFragmentIndex
+    sizeof(std::uint32_t),            // TPCFragmentBoards
+    sizeof(char),                     // CrateNames
+    sizeof(TPCBoardRecord),           // TPCBoards
+    sizeof(std::uint32_t),            // TPCBoardIndex
+    sizeof(ChannelPlaneRecord),       // TPCChannels
+    sizeof(PMTFragmentRecord),        // PMTFragments
+    sizeof(std::uint32_t),            // PMTFragmentIndex
+    sizeof(DigitizerChannelRecord),   // PMTChannels
+    sizeof(CRTChannelRecord),         // CRTChannels
+    sizeof(std::uint32_t),            // CRTSimMacAddresses
+    sizeof(TopCRTRecord),             // TopCRT
+    sizeof(std::uint32_t),            // TopCRTSimMacAddresses
+    sizeof(SideCRTCalibrationRecord), // SideCRTCalibrations
+    sizeof(std::uint32_t),            // SideCRTIndex
+  };
+  for (std::size_t id = 0; id < NSections; ++id) {
+    Section const& s = h.sections[id];
+    if (s.elementSize != elementSizes[id]) {
+      throw fail() << "Section #" << id << " has elements of " << s.elementSize
+        << " bytes, " << elementSizes[id] << " expected.\n";
+    }
+    if ((s.offset % 8 != 0) || (s.offset < sizeof(Header))
+      || (s.offset > fSize) || (s.count > (fSize - s.offset) / s.elementSize)
+    ) {
+      throw fail() << "Section #" << id << " (" << s.count << " elements at "
+        << s.offset << ") exceeds the snapshot boundaries.\n";
+    }
+  } // for sections
+
+  // references between sections
+  auto checkRange = [&fail](char const* what, std::uint64_t first,
+    std::uint64_t n, std::uint64_t size)
+    {
+      if (first + n <= size) return;
+      throw fail() << "Corrupted snapshot: " << what << " [" << first << ", "
+        << (first + n) << "[ out of " << size << ".\n";
+    };
+  auto checkIndex = [this,&fail](SectionID id, char const* what, std::size_t n)
+    {
+      for (std::uint32_t const i: section<std::uint32_t>(id)) {
+        if ((i == NoEntry) || (i < n)) continue;
+        throw fail() << "Corrupted snapshot: " << what << " index " << i
+          << " out of " << n << ".\n";
+      }
+    };
+
+  std::size_t const nCrateChars = section<char>(CrateNames).size();
+  std::size_t const nFragmentBoards
+    = section<std::uint32_t>(TPCFragmentBoards).size();
+  for (TPCFragmentRecord const& r: tpcFragments()) {
+    checkRange("crate name", r.crateNameOffset, r.crateNameLength, nCrateChars);
+    checkRange("readout boards", r.firstBoard, r.nBoards, nFragmentBoards);
+  }
+  checkIndex(TPCFragmentIndex, "TPC fragment", tpcFragments().size());
+
+  std::size_t const nTPCChannels = section<ChannelPlaneRecord>(TPCChannels).size();
+  for (TPCBoardRecord const& r: tpcBoards())
+    checkRange("TPC channels", r.firstChannel, r.nChannels, nTPCChannels);
+  checkIndex(TPCBoardIndex, "TPC board", tpcBoards().size());
+
+  std::size_t const nPMTChannels
+    = section<DigitizerChannelRecord>(PMTChannels).size();
+  for (PMTFragmentRecord const& r: pmtFragments())
+    checkRange("PMT channels", r.firstChannel, r.nChannels, nPMTChannels);
+  checkIndex(PMTFragmentIndex, "PMT digitizer", pmtFragments().size());
+
+  checkIndex(SideCRTIndex, "side CRT calibration", sideCRTCalibrations().size());
+
+} // icarusDB::ChannelMapSnapshot::validate()
+
+
+// -----------------------------------------------------------------------------
+void icarusDB::ChannelMapSnapshot::release() noexcept {
+  if (fMapped && fData) ::munmap(const_cast<std::byte*>(fData), fSize);
+  fOwned.clear();
+  fData = nullptr;
+  fSize = 0;
+  fMapped = false;
+} // icarusDB::ChannelMapSnapshot::release()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,347 @@
+/**
+ * @file   icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.h
+ * @brief  Flat, memory-mappable snapshot of the ICARUS channel mapping.
+ * @date   October 18, 2026
+ * @see    icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.cxx
+ */
+
+#ifndef ICARUSCODE_DECODE_CHANNELMAPPING_CHANNELMAPSNAPSHOT_H
+#define ICARUSCODE_DECODE_CHANNELMAPPING_CHANNELMAPSNAPSHOT_H
+
+// ICARUS libraries
+#include "icaruscode/Decode/ChannelMapping/IChannelMapping.h"
+
+// C/C++ standard libraries
+#include <string>
+#include <string_view>
+#include <vector>
+#include <limits>
+#include <cstddef> // std::size_t, std::byte
+#include <cstdint> // std::uint32_t, ...
+
+
+// -----------------------------------------------------------------------------
+namespace icarusDB { class ChannelMapSnapshot; }
+/**
+ * @brief Complete TPC, PMT and CRT channel mapping in flat tables.
+ *
+ * The snapshot holds the same information as the maps filled by the
+ * `IChannelMapping` tools, stored as arrays of plain records plus dense
+ * lookup tables, so that each lookup by fragment ID, board ID or MAC address
+ * is a bound check and an array access.
+ *
+ * The whole snapshot is a single contiguous block of memory which can be
+ * written to a file (`write()`) and later mapped back in memory
+ * (`fromFile()`) without any parsing. The format carries a version number
+ * (`FormatVersion`): files with a different version, or written on a machine
+ * with a different byte order, are rejected and need to be generated again
+ * (see `MakeChannelMapSnapshot` executable).
+ *
+ * A snapshot can be created:
+ * * from the maps of a mapping tool, e.g. `ChannelMapSQLite`, via
+ *   `fromMaps(buildMaps(tool))`;
+ * * from a snapshot file, via `fromFile()`.
+ *
+ * Lookup functions return the index of the matching record, or `NoEntry`.
+ * All errors are reported with `cet::exception` (category
+ * `"ChannelMapSnapshot"`).
+ */
+class icarusDB::ChannelMapSnapshot {
+    public:
+
+  /// Version of the binary format.
+  static constexpr std::uint32_t FormatVersion = 1U;
+
+  /// Index returned by the lookup functions when the key is not present.
+  static constexpr std::uint32_t NoEntry
+    = std::numeric_limits<std::uint32_t>::max();
+
+
+  /// Minimal read-only view of a contiguous sequence of elements.
+  template <typename T>
+  class ArrayView {
+    T const* fBegin = nullptr;
+    std::size_t fSize = 0;
+      public:
+    ArrayView() = default;
+    ArrayView(T const* begin, std::size_t size): fBegin(begin), fSize(size) {}
+    T const* begin() const { return fBegin; }
+    T const* end() const { return fBegin + fSize; }
+    std::size_t size() const { return fSize; }
+    bool empty() const { return fSize == 0; }
+    T const& operator[] (std::size_t i) const { return fBegin[i]; }
+  }; // ArrayView
+
+
+  // --- BEGIN -- Records ------------------------------------------------------
+  /// TPC fragment: crate name and range of readout boards.
+  struct TPCFragmentRecord {
+    std::uint32_t fragmentID;
+    std::uint32_t crateNameOffset; ///< Start of the name in the name pool.
+    std::uint32_t crateNameLength;
+    std::uint32_t firstBoard;      ///< First entry in the readout board list.
+    std::uint32_t nBoards;
+  };
+
+  /// TPC readout board: slot and range of channels.
+  struct TPCBoardRecord {
+    std::uint32_t boardID;
+    std::uint32_t slot;
+    std::uint32_t firstChannel;    ///< First entry in the channel list.
+    std::uint32_t nChannels;
+  };
+
+  /// TPC channel and plane of a readout board channel.
+  struct ChannelPlaneRecord {
+    std::uint32_t channel;
+    std::uint32_t plane;
+  };
+
+  /// PMT digitizer (by channel mapping database key) and range of channels.
+  struct PMTFragmentRecord {
+    std::uint32_t dbKey;
+    std::uint32_t firstChannel;    ///< First entry in the digitizer channel list.
+    std::uint32_t nChannels;
+  };
+
+  /// PMT digitizer channel and channel ID.
+  struct DigitizerChannelRecord {
+    std::uint64_t digitizerChannel;
+    std::uint64_t channelID;
+  };
+
+  /// CRT channel with its hardware and simulation MAC addresses.
+  struct CRTChannelRecord {
+    std::uint32_t channelID;
+    std::uint32_t hwMacAddress;
+    std::uint32_t simMacAddress;
+  };
+
+  /// Top CRT hardware and simulation MAC address.
+  struct TopCRTRecord {
+    std::uint32_t hwMacAddress;
+    std::uint32_t simMacAddress;
+  };
+
+  /// Side CRT gain and pedestal of a channel.
+  struct SideCRTCalibrationRecord {
+    std::int32_t mac5;
+    std::int32_t channel;
+    double       gain;
+    double       pedestal;
+  };
+  // --- END ---- Records ------------------------------------------------------
+
+
+  /// All the mapping information, in the format of `IChannelMapping`.
+  struct Maps {
+    IChannelMapping::TPCFragmentIDToReadoutIDMap            tpcFragments;
+    IChannelMapping::TPCReadoutBoardToChannelMap            tpcBoards;
+    IChannelMapping::FragmentToDigitizerChannelMap          pmtFragments;
+    IChannelMapping::CRTChannelIDToHWtoSimMacAddressPairMap crtChannels;
+    IChannelMapping::TopCRTHWtoSimMacAddressPairMap         topCRT;
+    IChannelMapping::SideCRTChannelToCalibrationMap         sideCRTCalibration;
+  }; // Maps
+
+
+  ChannelMapSnapshot() = default;
+  ~ChannelMapSnapshot();
+
+  ChannelMapSnapshot(ChannelMapSnapshot const&) = delete;
+  ChannelMapSnapshot& operator=(ChannelMapSnapshot const&) = delete;
+  ChannelMapSnapshot(ChannelMapSnapshot&& from) noexcept;
+  ChannelMapSnapshot& operator=(ChannelMapSnapshot&& from) noexcept;
+
+
+  // --- BEGIN -- Creation and persistency -------------------------------------
+  /// Fills all the maps from the specified mapping tool.
+  static Maps buildMaps(IChannelMapping const& tool);
+
+  /// Creates a snapshot (in memory) of the content of `maps`.
+  static ChannelMapSnapshot fromMaps(Maps const& maps);
+
+  /// Maps in memory the snapshot in the specified file (after checking it).
+  static ChannelMapSnapshot fromFile(std::string const& path);
+
+  /// Writes the snapshot into the specified file.
+  void write(std::string const& path) const;
+
+  /// Returns the content of the snapshot as `IChannelMapping` maps.
+  Maps toMaps() const;
+
+  /// Returns the size of the snapshot in bytes.
+  std::size_t sizeInBytes() const { return fSize; }
+  // --- END ---- Creation and persistency -------------------------------------
+
+
+  // --- BEGIN -- TPC ----------------------------------------------------------
+  /// Returns the index of the TPC fragment `fragmentID`, or `NoEntry`.
+  std::uint32_t tpcFragmentIndex(unsigned int fragmentID) const
+    { return denseLookup(TPCFragmentIndex, fragmentID); }
+
+  /// Returns all TPC fragment records, sorted by fragment ID.
+  ArrayView<TPCFragmentRecord> tpcFragments() const
+    { return section<TPCFragmentRecord>(TPCFragments); }
+
+  /// Returns the crate name of the specified TPC fragment.
+  std::string_view crateName(TPCFragmentRecord const& fragment) const;
+
+  /// Returns the readout board IDs of the specified TPC fragment.
+  ArrayView<std::uint32_t> readoutBoards(TPCFragmentRecord const& fragment) const
+    {
+      return { section<std::uint32_t>(TPCFragmentBoards).begin()
+        + fragment.firstBoard, fragment.nBoards };
+    }
+
+  /// Returns the index of the TPC readout board `boardID`, or `NoEntry`.
+  std::uint32_t tpcBoardIndex(unsigned int boardID) const
+    { return denseLookup(TPCBoardIndex, boardID); }
+
+  /// Returns all TPC readout board records, sorted by board ID.
+  ArrayView<TPCBoardRecord> tpcBoards() const
+    { return section<TPCBoardRecord>(TPCBoards); }
+
+  /// Returns the channel and plane of each channel of the specified board.
+  ArrayView<ChannelPlaneRecord> channelPlanes(TPCBoardRecord const& board) const
+    {
+      return { section<ChannelPlaneRecord>(TPCChannels).begin()
+        + board.firstChannel, board.nChannels };
+    }
+  // --- END ---- TPC ----------------------------------------------------------
+
+
+  // --- BEGIN -- PMT ----------------------------------------------------------
+  /// Returns the index of the PMT digitizer with database key `dbKey`,
+  /// or `NoEntry`.
+  std::uint32_t pmtFragmentIndex(unsigned int dbKey) const
+    { return denseLookup(PMTFragmentIndex, dbKey); }
+
+  /// Returns all PMT digitizer records, sorted by database key.
+  ArrayView<PMTFragmentRecord> pmtFragments() const
+    { return section<PMTFragmentRecord>(PMTFragments); }
+
+  /// Returns the channels of the specified PMT digitizer.
+  ArrayView<DigitizerChannelRecord> digitizerChannels
+    (PMTFragmentRecord const& fragment) const
+    {
+      return { section<DigitizerChannelRecord>(PMTChannels).begin()
+        + fragment.firstChannel, fragment.nChannels };
+    }
+  // --- END ---- PMT ----------------------------------------------------------
+
+
+  // --- BEGIN -- CRT ----------------------------------------------------------
+  /// Returns all CRT channel records, sorted by channel ID.
+  ArrayView<CRTChannelRecord> crtChannels() const
+    { return section<CRTChannelRecord>(CRTChannels); }
+
+  /**
+   * @brief Returns the simulation MAC address of a hardware MAC address.
+   * @return the simulation MAC address, or `0` if not known
+   *
+   * If more channels share the same hardware address, the one with the highest
+   * channel ID wins.
+   */
+  unsigned int simMacAddress(unsigned int hwMacAddress) const;
+
+  /// Returns all top CRT records, sorted by hardware MAC address.
+  ArrayView<TopCRTRecord> topCRT() const
+    { return section<TopCRTRecord>(TopCRT); }
+
+  /// Returns the top CRT simulation MAC address, or `0` if not known.
+  unsigned int topSimMacAddress(unsigned int hwMacAddress) const;
+
+  /// Returns all side CRT calibration records, sorted by MAC5 and channel.
+  ArrayView<SideCRTCalibrationRecord> sideCRTCalibrations() const
+    { return section<SideCRTCalibrationRecord>(SideCRTCalibrations); }
+
+  /// Returns the index of the calibration of side CRT channel, or `NoEntry`.
+  std::uint32_t sideCRTCalibrationIndex(int mac5, int channel) const;
+  // --- END ---- CRT ----------------------------------------------------------
+
+
+    private:
+
+  /// Identifiers of the sections of the snapshot.
+  enum SectionID: std::uint32_t {
+    TPCFragments,        ///< `TPCFragmentRecord`
+    TPCFragmentIndex,    ///< Dense index by fragment ID.
+    TPCFragmentBoards,   ///< Readout board IDs (`std::uint32_t`).
+    CrateNames,          ///< Pool of crate names (`char`).
+    TPCBoards,           ///< `TPCBoardRecord`
+    TPCBoardIndex,       ///< Dense index by board ID.
+    TPCChannels,         ///< `ChannelPlaneRecord`
+    PMTFragments,        ///< `PMTFragmentRecord`
+    PMTFragmentIndex,    ///< Dense index by database key.
+    PMTChannels,         ///< `DigitizerChannelRecord`
+    CRTChannels,         ///< `CRTChannelRecord`
+    CRTSimMacAddresses,  ///< Dense simulation MAC address by hardware one.
+    TopCRT,              ///< `TopCRTRecord`
+    TopCRTSimMacAddresses, ///< Dense simulation MAC address by hardware one.
+    SideCRTCalibrations, ///< `SideCRTCalibrationRecord`
+    SideCRTIndex,        ///< Dense index by MAC5 (`base`) and channel (`base2`).
+    NSections
+  }; // SectionID
+
+  /// Description of a section of the snapshot.
+  struct Section {
+    std::uint64_t offset;      ///< Bytes from the start of the snapshot.
+    std::uint64_t count;       ///< Number of elements.
+    std::uint32_t elementSize; ///< Size of each element, in bytes.
+    std::uint32_t base;        ///< Key of the first element (dense tables).
+    std::uint32_t base2;       ///< Key of the first column (2D dense tables).
+    std::uint32_t stride;      ///< Number of columns (2D dense tables).
+  }; // Section
+
+  /// Header at the start of the snapshot.
+  struct Header {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;   ///< `ByteOrderMark` as written by the creator.
+    std::uint64_t size;        ///< Total size of the snapshot, in bytes.
+    std::uint32_t nSections;
+    std::uint32_t padding;
+    Section       sections[NSections];
+  }; // Header
+
+  static constexpr char Magic[8] = { 'I', 'C', 'M', 'A', 'P', 'S', 'N', 'P' };
+  static constexpr std::uint32_t ByteOrderMark = 0x01020304U;
+
+  std::byte const*           fData = nullptr; ///< Start of the snapshot.
+  std::size_t                fSize = 0;       ///< Size of the snapshot.
+  std::vector<std::uint64_t> fOwned;          ///< Storage, unless mapped.
+  bool                       fMapped = false; ///< Whether memory is mapped.
+
+  Header const& header() const
+    { return *reinterpret_cast<Header const*>(fData); }
+
+  template <typename T>
+  ArrayView<T> section(SectionID id) const
+    {
+      if (!fData) return {};
+      Section const& s = header().sections[id];
+      return { reinterpret_cast<T const*>(fData + s.offset), s.count };
+    }
+
+  /// Returns the value of the dense table `id` at `key`, or `NoEntry`.
+  std::uint32_t denseLookup(SectionID id, unsigned int key) const
+    {
+      if (!fData) return NoEntry;
+      Section const& s = header().sections[id];
+      std::uint64_t const i = static_cast<std::uint32_t>(key - s.base);
+      if ((key < s.base) || (i >= s.count)) return NoEntry;
+      return reinterpret_cast<std::uint32_t const*>(fData + s.offset)[i];
+    }
+
+  /// Checks the consistency of the snapshot; throws on failure.
+  void validate() const;
+
+  /// Releases the memory.
+  void release() noexcept;
+
+}; // class icarusDB::ChannelMapSnapshot
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_DECODE_CHANNELMAPPING_CHANNELMAPSNAPSHOT_H
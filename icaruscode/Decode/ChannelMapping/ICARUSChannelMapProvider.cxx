@@ -20,6 +20,7 @@
 #include <string>
 #include <iostream>
 #include <cassert>
+#include <cstdint> // std::uint32_t
 
 namespace icarusDB
 {
@@ -43,14 +44,14 @@ ICARUSChannelMapProvider::ICARUSChannelMapProvider(const fhicl::ParameterSet& ps
 
     theClockFragmentIDs.start();
 
-    if (fChannelMappingTool->BuildTPCFragmentIDToReadoutIDMap(fFragmentToReadoutMap))
+    if (fChannelMappingTool->BuildTPCFragmentIDToReadoutIDMap(fMaps.tpcFragments))
     {
         throw cet::exception("ICARUSChannelMapProvider") << "Cannot recover the Fragment ID channel map from the database \n";
     }
     else if (fDiagnosticOutput)
     {
-        std::cout << "FragmentID to Readout ID map has " << fFragmentToReadoutMap.size() << " elements";
-	for(const auto& pair : fFragmentToReadoutMap) std::cout << "   Frag: " << std::hex << pair.first << ", Crate: " 
+        std::cout << "FragmentID to Readout ID map has " << fMaps.tpcFragments.size() << " elements";
+	for(const auto& pair : fMaps.tpcFragments) std::cout << "   Frag: " << std::hex << pair.first << ", Crate: " 
 								<< pair.second.first << ", # boards: " << std::dec << pair.second.second.size() << std::endl;
 	
     }
@@ -63,33 +64,33 @@ ICARUSChannelMapProvider::ICARUSChannelMapProvider(const fhicl::ParameterSet& ps
 
     theClockReadoutIDs.start();
 
-    if (fChannelMappingTool->BuildTPCReadoutBoardToChannelMap(fReadoutBoardToChannelMap))
+    if (fChannelMappingTool->BuildTPCReadoutBoardToChannelMap(fMaps.tpcBoards))
     {
         std::cout << "******* FAILED TO CONFIGURE CHANNEL MAP ********" << std::endl;
         throw cet::exception("ICARUSChannelMapProvider") << "POS didn't read the F'ing database again \n";
     }
 
     // Do the channel mapping initialization
-    if (fChannelMappingTool->BuildFragmentToDigitizerChannelMap(fFragmentToDigitizerMap))
+    if (fChannelMappingTool->BuildFragmentToDigitizerChannelMap(fMaps.pmtFragments))
       {
 	throw cet::exception("ICARUSChannelMapProvider") << "Cannot recover the Fragment ID channel map from the database \n";
       }
     else if (fDiagnosticOutput)
       {
-	std::cout << "FragmentID to Readout ID map has " << fFragmentToDigitizerMap.size() << " Fragment IDs";
-	 for(const auto& pair : fFragmentToDigitizerMap) std::cout << "   Frag: " << std::hex << pair.first << ", # pairs: " 
+	std::cout << "FragmentID to Readout ID map has " << fMaps.pmtFragments.size() << " Fragment IDs";
+	 for(const auto& pair : fMaps.pmtFragments) std::cout << "   Frag: " << std::hex << pair.first << ", # pairs: " 
 								   << std::dec << pair.second.size() << std::endl;
       }
     
     // Do the channel mapping initialization for CRT
-    if (fChannelMappingTool->BuildCRTChannelIDToHWtoSimMacAddressPairMap(fCRTChannelIDToHWtoSimMacAddressPairMap))
+    if (fChannelMappingTool->BuildCRTChannelIDToHWtoSimMacAddressPairMap(fMaps.crtChannels))
       {
         throw cet::exception("CRTDecoder") << "Cannot recover the HW MAC Address  from the database \n";
       }
     else if (fDiagnosticOutput)
       {
-	std::cout << "ChannelID to MacAddress map has " << fCRTChannelIDToHWtoSimMacAddressPairMap.size() << " Channel IDs";
-	for(const auto& pair : fCRTChannelIDToHWtoSimMacAddressPairMap) std::cout <<" ChannelID: "<< pair.first
+	std::cout << "ChannelID to MacAddress map has " << fMaps.crtChannels.size() << " Channel IDs";
+	for(const auto& pair : fMaps.crtChannels) std::cout <<" ChannelID: "<< pair.first
                                                                                   << ", hw mac address: " << pair.second.first
                                                                                   <<", sim mac address: " << pair.second.second << std::endl;
 	
@@ -97,29 +98,29 @@ ICARUSChannelMapProvider::ICARUSChannelMapProvider(const fhicl::ParameterSet& ps
     
     
     // Do the channel mapping initialization for top CRT
-    if (fChannelMappingTool->BuildTopCRTHWtoSimMacAddressPairMap(fTopCRTHWtoSimMacAddressPairMap))
+    if (fChannelMappingTool->BuildTopCRTHWtoSimMacAddressPairMap(fMaps.topCRT))
       {
         throw cet::exception("CRTDecoder") << "Cannot recover the Top CRT HW MAC Address  from the database \n";
       }
     else if (fDiagnosticOutput)
       {
-	std::cout << "Top CRT MacAddress map has " << fTopCRTHWtoSimMacAddressPairMap.size() << " rows";
-        for(const auto& pair : fTopCRTHWtoSimMacAddressPairMap) std::cout << ", hw mac address: " << pair.first
+	std::cout << "Top CRT MacAddress map has " << fMaps.topCRT.size() << " rows";
+        for(const auto& pair : fMaps.topCRT) std::cout << ", hw mac address: " << pair.first
 									  <<", sim mac address: " << pair.second << std::endl;
       }
     
 
     // Do the CRT Charge Calibration initialization
-    if (fChannelMappingTool->BuildSideCRTCalibrationMap(fSideCRTChannelToCalibrationMap))
+    if (fChannelMappingTool->BuildSideCRTCalibrationMap(fMaps.sideCRTCalibration))
       {
 	std::cout << "******* FAILED TO CONFIGURE CRT Calibration  ********" << std::endl;
         throw cet::exception("ICARUSChannelMapProvider") << "Cannot recover the charge calibration information from the database \n";
       }
     else if (fDiagnosticOutput)
       {
-	std::cout << "side crt calibration map has " << fSideCRTChannelToCalibrationMap.size() << " list of rows \n";
+	std::cout << "side crt calibration map has " << fMaps.sideCRTCalibration.size() << " list of rows \n";
 
-	for(const auto& pair : fSideCRTChannelToCalibrationMap) std::cout <<" mac5: "<< pair.first.first
+	for(const auto& pair : fMaps.sideCRTCalibration) std::cout <<" mac5: "<< pair.first.first
 									  << ", chan: " << pair.first.second
 									  << ", Gain: " << pair.second.first
 									  << ", Pedestal: " << pair.second.second << std::endl;
@@ -130,6 +131,8 @@ ICARUSChannelMapProvider::ICARUSChannelMapProvider(const fhicl::ParameterSet& ps
 
     double readoutIDsTime = theClockReadoutIDs.accumulated_real_time();
 
+    buildLookupTables();
+
 
     mf::LogInfo("ICARUSChannelMapProvider") << "==> FragmentID map time: " << fragmentIDsTime << ", Readout IDs time: " << readoutIDsTime << std::endl;
     
@@ -138,71 +141,71 @@ ICARUSChannelMapProvider::ICARUSChannelMapProvider(const fhicl::ParameterSet& ps
 
 bool ICARUSChannelMapProvider::hasFragmentID(const unsigned int fragmentID) const 
 {
-    return fFragmentToReadoutMap.find(fragmentID) != fFragmentToReadoutMap.end();
+    return fSnapshot.tpcFragmentIndex(fragmentID) != ChannelMapSnapshot::NoEntry;
 }
 
 
 unsigned int ICARUSChannelMapProvider::nTPCfragmentIDs() const {
-  return fFragmentToReadoutMap.size();
+  return fMaps.tpcFragments.size();
 }
 
 
 const std::string&  ICARUSChannelMapProvider::getCrateName(const unsigned int fragmentID) const
 {
-    IChannelMapping::TPCFragmentIDToReadoutIDMap::const_iterator fragToReadoutItr = fFragmentToReadoutMap.find(fragmentID);
+    std::uint32_t const index = fSnapshot.tpcFragmentIndex(fragmentID);
 
-    if (fragToReadoutItr == fFragmentToReadoutMap.end())
+    if (index == ChannelMapSnapshot::NoEntry)
         throw cet::exception("ICARUSChannelMapProvider") << "Fragment ID " << fragmentID << " not found in lookup map when looking up crate name \n";
 
-    return fragToReadoutItr->second.first;
+    return fTPCFragmentEntries[index]->first;
 }
 
 const ReadoutIDVec& ICARUSChannelMapProvider::getReadoutBoardVec(const unsigned int fragmentID) const
 {
-    IChannelMapping::TPCFragmentIDToReadoutIDMap::const_iterator fragToReadoutItr = fFragmentToReadoutMap.find(fragmentID);
+    std::uint32_t const index = fSnapshot.tpcFragmentIndex(fragmentID);
 
-    if (fragToReadoutItr == fFragmentToReadoutMap.end())
+    if (index == ChannelMapSnapshot::NoEntry)
         throw cet::exception("ICARUSChannelMapProvider") << "Fragment ID " << fragmentID << " not found in lookup map when looking up board vector \n";
 
-    return fragToReadoutItr->second.second;
+    return fTPCFragmentEntries[index]->second;
 
 }
 
 const TPCReadoutBoardToChannelMap& ICARUSChannelMapProvider::getReadoutBoardToChannelMap() const
 {
-    return fReadoutBoardToChannelMap;
+    return fMaps.tpcBoards;
 }
 
 
 bool ICARUSChannelMapProvider::hasBoardID(const unsigned int boardID)  const
 {
-    return fReadoutBoardToChannelMap.find(boardID) != fReadoutBoardToChannelMap.end();
+    return fSnapshot.tpcBoardIndex(boardID) != ChannelMapSnapshot::NoEntry;
 }
 
 
 unsigned int ICARUSChannelMapProvider::nTPCboardIDs() const {
-  return fReadoutBoardToChannelMap.size();
+  return fMaps.tpcBoards.size();
 }
 
 
 unsigned int ICARUSChannelMapProvider::getBoardSlot(const unsigned int boardID)  const
 {
-    IChannelMapping::TPCReadoutBoardToChannelMap::const_iterator readoutBoardItr = fReadoutBoardToChannelMap.find(boardID);
+    std::uint32_t const index = fSnapshot.tpcBoardIndex(boardID);
 
-    if (readoutBoardItr == fReadoutBoardToChannelMap.end())
+    if (index == ChannelMapSnapshot::NoEntry)
         throw cet::exception("ICARUSChannelMapProvider") << "Board ID " << boardID << " not found in lookup map when looking up board slot \n";
 
-    return readoutBoardItr->second.first;
+    return fSnapshot.tpcBoards()[index].slot;
 }
 
  const ChannelPlanePairVec& ICARUSChannelMapProvider::getChannelPlanePair(const unsigned int boardID) const
 {
-    IChannelMapping::TPCReadoutBoardToChannelMap::const_iterator readoutBoardItr = fReadoutBoardToChannelMap.find(boardID);
+    std::uint32_t const index = fSnapshot.tpcBoardIndex(boardID);
 
-    if (readoutBoardItr == fReadoutBoardToChannelMap.end())
+    if (index == ChannelMapSnapshot::NoEntry)
         throw cet::exception("ICARUSChannelMapProvider") << "Board ID " << boardID << " not found in lookup map when looking up channel/plane pair \n";
 
-    return readoutBoardItr->second.second;
+    return fTPCBoardEntries[index]->second;
 
 }
 
@@ -213,7 +216,7 @@ bool ICARUSChannelMapProvider::hasPMTDigitizerID(const unsigned int fragmentID)
 
 
 unsigned int ICARUSChannelMapProvider::nPMTfragmentIDs() const {
-  return fFragmentToDigitizerMap.size();
+  return fMaps.pmtFragments.size();
 }
 
 
@@ -228,48 +231,51 @@ const DigitizerChannelChannelIDPairVec& ICARUSChannelMapProvider::getChannelIDPa
 
   unsigned int ICARUSChannelMapProvider::getSimMacAddress(const unsigned int hwmacaddress)  const
   {
-    unsigned int   simmacaddress = 0;
-
-    for(const auto& pair : fCRTChannelIDToHWtoSimMacAddressPairMap){
-      if (pair.second.first == hwmacaddress)
-	simmacaddress = pair.second.second;
-    }
-
-    return simmacaddress;
+    // if more channels share the address, the last one wins (as it always did)
+    return fSnapshot.simMacAddress(hwmacaddress);
   }
   
   unsigned int ICARUSChannelMapProvider::gettopSimMacAddress(const unsigned int hwmacaddress)  const
   {
-    unsigned int   simmacaddress = 0;
-
-    for(const auto& pair : fTopCRTHWtoSimMacAddressPairMap){
-      if (pair.first == hwmacaddress)
-	simmacaddress = pair.second;
-    }
-
-    return simmacaddress;
-    
-    /* untested:
-    auto const it = fTopCRTHWtoSimMacAddressPairMap.find(hwmacaddress);
-    return (it == fTopCRTHWtoSimMacAddressPairMap.end())? 0: it->second;
-    */
+    return fSnapshot.topSimMacAddress(hwmacaddress);
   }
    
   std::pair<double, double> ICARUSChannelMapProvider::getSideCRTCalibrationMap(int mac5, int chan) const
   {
-    auto const itGainAndPedestal = fSideCRTChannelToCalibrationMap.find({ mac5, chan });
-    return (itGainAndPedestal == fSideCRTChannelToCalibrationMap.cend())
-      ? std::pair{ -99., -99. }: itGainAndPedestal->second;
+    std::uint32_t const index = fSnapshot.sideCRTCalibrationIndex(mac5, chan);
+    if (index == ChannelMapSnapshot::NoEntry) return { -99., -99. };
+    auto const& calib = fSnapshot.sideCRTCalibrations()[index];
+    return { calib.gain, calib.pedestal };
   }
 
 auto ICARUSChannelMapProvider::findPMTfragmentEntry(unsigned int fragmentID) const
   -> DigitizerChannelChannelIDPairVec const*
 {
-  auto it = fFragmentToDigitizerMap.find(PMTfragmentIDtoDBkey(fragmentID));
-  return (it == fFragmentToDigitizerMap.end())? nullptr: &(it->second);
+  std::uint32_t const index
+    = fSnapshot.pmtFragmentIndex(PMTfragmentIDtoDBkey(fragmentID));
+  return (index == ChannelMapSnapshot::NoEntry)
+    ? nullptr: fPMTFragmentEntries[index];
 }
 
 
+void ICARUSChannelMapProvider::buildLookupTables() {
+
+  fSnapshot = ChannelMapSnapshot::fromMaps(fMaps);
+
+  // snapshot records are in the same (key) order as the map entries
+  fTPCFragmentEntries.clear();
+  for (auto const& entry: fMaps.tpcFragments)
+    fTPCFragmentEntries.push_back(&entry.second);
+  fTPCBoardEntries.clear();
+  for (auto const& entry: fMaps.tpcBoards)
+    fTPCBoardEntries.push_back(&entry.second);
+  fPMTFragmentEntries.clear();
+  for (auto const& entry: fMaps.pmtFragments)
+    fPMTFragmentEntries.push_back(&entry.second);
+
+} // ICARUSChannelMapProvider::buildLookupTables()
+
+
 constexpr unsigned int ICARUSChannelMapProvider::PMTfragmentIDtoDBkey
   (unsigned int fragmentID)
 {
@@ -10,6 +10,7 @@
 // ICARUS libraries
 #include "icaruscode/Decode/ChannelMapping/IICARUSChannelMap.h"
 #include "icaruscode/Decode/ChannelMapping/IChannelMapping.h"
+#include "icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.h"
 
 // framework libraries
 #include "fhiclcpp/ParameterSet.h"
@@ -18,6 +19,8 @@
 // C/C++ standard libraries
 #include <string>
 #include <memory> // std::unique_ptr<>
+#include <utility> // std::pair<>
+#include <vector>
 
 
 // -----------------------------------------------------------------------------
@@ -70,17 +73,19 @@ private:
     
     bool fDiagnosticOutput;
       
-    IChannelMapping::TPCFragmentIDToReadoutIDMap   fFragmentToReadoutMap;
-      
-    IChannelMapping::TPCReadoutBoardToChannelMap   fReadoutBoardToChannelMap;
-
-    IChannelMapping::FragmentToDigitizerChannelMap fFragmentToDigitizerMap; 
+    /// All the mapping tables, as filled by the mapping tool.
+    ChannelMapSnapshot::Maps                       fMaps;
 
-    IChannelMapping::CRTChannelIDToHWtoSimMacAddressPairMap fCRTChannelIDToHWtoSimMacAddressPairMap;
+    /// Flat copy of the mapping, used for constant time lookups.
+    ChannelMapSnapshot                             fSnapshot;
 
-    IChannelMapping::TopCRTHWtoSimMacAddressPairMap fTopCRTHWtoSimMacAddressPairMap;
-
-    IChannelMapping::SideCRTChannelToCalibrationMap fSideCRTChannelToCalibrationMap;
+    /// Entries of `fMaps`, in the order of the records in `fSnapshot`.
+    std::vector<IChannelMapping::TPCFragmentIDToReadoutIDMap::mapped_type const*>
+      fTPCFragmentEntries;
+    std::vector<IChannelMapping::TPCReadoutBoardToChannelMap::mapped_type const*>
+      fTPCBoardEntries;
+    std::vector<IChannelMapping::FragmentToDigitizerChannelMap::mapped_type const*>
+      fPMTFragmentEntries;
 
     std::unique_ptr<IChannelMapping>               fChannelMappingTool;
 
@@ -89,6 +94,9 @@ private:
     DigitizerChannelChannelIDPairVec const* findPMTfragmentEntry
       (unsigned int fragmentID) const;
 
+    /// Creates `fSnapshot` and the entry lists from the content of `fMaps`.
+    void buildLookupTables();
+
 }; // icarusDB::ICARUSChannelMapProvider
 
 
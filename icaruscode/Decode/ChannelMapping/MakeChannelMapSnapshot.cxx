@@ -0,0 +1,185 @@
+/**
+ * @file   icaruscode/Decode/ChannelMapping/MakeChannelMapSnapshot.cxx
+ * @brief  Utility writing a binary snapshot of the channel mapping database.
+ * @date   October 18, 2026
+ * @see    icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.h
+ *
+ * Usage:
+ *
+ *     MakeChannelMapSnapshot  config.fcl  output.snapshot
+ *
+ * The configuration file must include a configuration for `IICARUSChannelMap`
+ * service, whose `ChannelMappingTool` is used to read the mapping (e.g. from
+ * the SQLite database). The mapping is written as a snapshot file that can be
+ * read by `ChannelMapFromSnapshot` tool. The snapshot is then read back and
+ * compared to the original, and the time needed to read the mapping and to
+ * look it up from the database maps and from the snapshot is printed.
+ *
+ * It is using _art_ facilities for tool loading, but it does not run in _art_
+ * environment. So it may break without warning and without solution.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.h"
+#include "icaruscode/Decode/ChannelMapping/IChannelMapping.h"
+
+// LArSoft and framework libraries
+#include "larcorealg/TestUtils/unit_test_base.h"
+#include "art/Utilities/make_tool.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <chrono>
+#include <iostream>
+#include <memory> // std::unique_ptr<>
+#include <string>
+#include <cstdint> // std::uint32_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  using Clock_t = std::chrono::steady_clock;
+
+  /// Returns the seconds elapsed since `start`.
+  double secondsSince(Clock_t::time_point start) {
+    return std::chrono::duration<double>(Clock_t::now() - start).count();
+  }
+
+
+  /// Times `nRounds` lookups of all TPC and PMT keys via maps and snapshot.
+  void benchmarkLookups(
+    icarusDB::ChannelMapSnapshot::Maps const& maps,
+    icarusDB::ChannelMapSnapshot const& snapshot,
+    unsigned int nRounds
+  ) {
+    std::size_t nLookups = 0;
+    unsigned long long checkMaps = 0, checkSnapshot = 0;
+
+    auto start = Clock_t::now();
+    for (unsigned int round = 0; round < nRounds; ++round) {
+      for (auto const& [ fragmentID, crateAndBoards ]: maps.tpcFragments) {
+        for (unsigned int const boardID
+          : maps.tpcFragments.find(fragmentID)->second.second
+        ) {
+          auto const it = maps.tpcBoards.find(boardID);
+          if (it != maps.tpcBoards.end()) checkMaps += it->second.first;
+          ++nLookups;
+        }
+      }
+      for (auto const& [ dbKey, channels ]: maps.pmtFragments) {
+        checkMaps += maps.pmtFragments.find(dbKey)->second.size();
+        ++nLookups;
+      }
+    } // for
+    double const mapTime = secondsSince(start);
+
+    start = Clock_t::now();
+    for (unsigned int round = 0; round < nRounds; ++round) {
+      for (auto const& [ fragmentID, crateAndBoards ]: maps.tpcFragments) {
+        auto const& fragment
+          = snapshot.tpcFragments()[snapshot.tpcFragmentIndex(fragmentID)];
+        for (std::uint32_t const boardID: snapshot.readoutBoards(fragment)) {
+          std::uint32_t const index = snapshot.tpcBoardIndex(boardID);
+          if (index != icarusDB::ChannelMapSnapshot::NoEntry)
+            checkSnapshot += snapshot.tpcBoards()[index].slot;
+        }
+      }
+      for (auto const& [ dbKey, channels ]: maps.pmtFragments) {
+        checkSnapshot += snapshot.pmtFragments()
+          [snapshot.pmtFragmentIndex(dbKey)].nChannels;
+      }
+    } // for
+    double const snapshotTime = secondsSince(start);
+
+    if (nLookups == 0) return;
+    if (checkMaps != checkSnapshot) {
+      throw cet::exception("MakeChannelMapSnapshot")
+        << "Lookup results differ between maps and snapshot!\n";
+    }
+    std::cout << "Lookup of " << nLookups << " TPC boards and PMT digitizers: "
+      << (mapTime * 1e9 / nLookups) << " ns each from maps, "
+      << (snapshotTime * 1e9 / nLookups) << " ns each from snapshot"
+      << std::endl;
+  } // benchmarkLookups()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  using Environment
+    = testing::TesterEnvironment<testing::BasicEnvironmentConfiguration>;
+
+  testing::BasicEnvironmentConfiguration config("MakeChannelMapSnapshot");
+
+  //
+  // parameter parsing
+  //
+  if (argc != 3) {
+    std::cerr << "Usage:  " << argv[0] << "  config.fcl  output.snapshot"
+      << std::endl;
+    return 1;
+  }
+  config.SetConfigurationPath(argv[1]);
+  std::string const outputPath { argv[2] };
+
+  Environment const Env { config };
+
+  std::unique_ptr<icarusDB::IChannelMapping> const tool
+    = art::make_tool<icarusDB::IChannelMapping>(
+      Env.ServiceParameters("IICARUSChannelMap")
+        .get<fhicl::ParameterSet>("ChannelMappingTool")
+    );
+
+  //
+  // read from the database and write the snapshot
+  //
+  auto start = Clock_t::now();
+  icarusDB::ChannelMapSnapshot::Maps const maps
+    = icarusDB::ChannelMapSnapshot::buildMaps(*tool);
+  double const databaseTime = secondsSince(start);
+
+  icarusDB::ChannelMapSnapshot::fromMaps(maps).write(outputPath);
+
+  //
+  // read back and check
+  //
+  start = Clock_t::now();
+  icarusDB::ChannelMapSnapshot const snapshot
+    = icarusDB::ChannelMapSnapshot::fromFile(outputPath);
+  double const mapTime = secondsSince(start);
+  icarusDB::ChannelMapSnapshot::Maps const snapshotMaps = snapshot.toMaps();
+  double const snapshotTime = secondsSince(start);
+
+  if ((snapshotMaps.tpcFragments != maps.tpcFragments)
+    || (snapshotMaps.tpcBoards != maps.tpcBoards)
+    || (snapshotMaps.pmtFragments != maps.pmtFragments)
+    || (snapshotMaps.crtChannels != maps.crtChannels)
+    || (snapshotMaps.topCRT != maps.topCRT)
+    || (snapshotMaps.sideCRTCalibration != maps.sideCRTCalibration)
+  ) {
+    std::cerr << "Snapshot in '" << outputPath
+      << "' does not match the database content!" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Channel mapping snapshot written into '" << outputPath << "' ("
+    << snapshot.sizeInBytes() << " bytes):"
+    << "\n  " << maps.tpcFragments.size() << " TPC fragments, "
+    << maps.tpcBoards.size() << " TPC readout boards, "
+    << maps.pmtFragments.size() << " PMT digitizers, "
+    << maps.crtChannels.size() << " CRT channels, "
+    << maps.topCRT.size() << " top CRT modules, "
+    << maps.sideCRTCalibration.size() << " side CRT calibration entries"
+    << "\nReading the mapping: " << databaseTime << " s from database, "
+    << mapTime << " s to map the snapshot, "
+    << snapshotTime << " s to fill the maps from the snapshot"
+    << std::endl;
+
+  benchmarkLookups(maps, snapshot, 1000);
+
+  return 0;
+} // main()
@@ -11,6 +11,12 @@
 // Configuration parameters:
 //
 // DigitModuleLabel      - the source of the RawDigit collection
+// ImageProcessing       - if true, the decoded fragments are collected into
+//                         full readout plane (ROP) images, which are denoised
+//                         and searched for ROIs as a whole by ImageDecoderTool
+//                         instead of board by board by DecoderTool
+// ImageDecoderTool      - the noise filter tool for the full ROP images
+//                         (required when ImageProcessing is set)
 //
 //
 // Modeled after example from Mike Wang (mwang@fnal.gov)
@@ -22,6 +28,7 @@
 #include <algorithm>
 #include <vector>
 #include <iterator>
+#include <limits>
 
 #include "art/Framework/Core/ReplicatedProducer.h"
 #include "art/Framework/Principal/Event.h"
@@ -38,7 +45,6 @@
 #include "tbb/blocked_range.h"
 #include "tbb/task_arena.h"
 #include "tbb/spin_mutex.h"
-#include "tbb/concurrent_vector.h"
 
 #include "larcore/Geometry/Geometry.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
@@ -50,6 +56,7 @@
 
 #include "icaruscode/Utilities/ArtHandleTrackerManager.h"
 #include "icaruscode/Decode/DecoderTools/INoiseFilter.h"
+#include "icaruscode/Decode/DecoderTools/details/TPCDecoderUtils.h"
 #include "icaruscode/Decode/ChannelMapping/IICARUSChannelMap.h"
 
 #include "icarus_signal_processing/ICARUSSigProcDefs.h"
@@ -83,8 +90,8 @@ public:
     using RawDigitCollectionPtr   = std::unique_ptr<RawDigitCollection>;
     using ChannelROICollection    = std::vector<recob::ChannelROI>;
     using ChannelROICollectionPtr = std::unique_ptr<ChannelROICollection>;
-    using ConcurrentRawDigitCol   = tbb::concurrent_vector<raw::RawDigit>;
-    using ConcurrentChannelROICol = tbb::concurrent_vector<recob::ChannelROI>;
+    using ConcurrentRawDigitCol   = details::ChannelSlotCollection<raw::RawDigit>;
+    using ConcurrentChannelROICol = details::ChannelSlotCollection<recob::ChannelROI>;
 
     // Define data structures for organizing the decoded fragments
     // The idea is to form complete "images" organized by "logical" TPC. Here we are including
@@ -106,11 +113,20 @@ public:
     void processSingleFragment(size_t,
                                detinfo::DetectorClocksData const& clockData,
                                art::Handle<artdaq::Fragments>, 
+                               ChannelArrayPairVec*,
                                ConcurrentRawDigitCol&,
                                ConcurrentRawDigitCol&,
                                ConcurrentRawDigitCol&,
                                ConcurrentChannelROICol&) const;
 
+    // Function to denoise and find ROIs on a full readout plane image
+    void processSingleImage(detinfo::DetectorClocksData const& clockData,
+                            ChannelArrayPair&,
+                            ConcurrentRawDigitCol&,
+                            ConcurrentRawDigitCol&,
+                            ConcurrentRawDigitCol&,
+                            ConcurrentChannelROICol&) const;
+
 private:
     class multiThreadFragmentProcessing
     {
@@ -118,6 +134,7 @@ private:
         multiThreadFragmentProcessing(DaqDecoderICARUSTPCwROI const&        parent,
                                       detinfo::DetectorClocksData const&    clockData,
                                       art::Handle<artdaq::Fragments> const& fragmentsHandle,
+                                      ChannelArrayPairVec*                  ropImages,
                                       ConcurrentRawDigitCol&                concurrentRawRawDigits,
                                       ConcurrentRawDigitCol&                concurrentRawDigits,
                                       ConcurrentRawDigitCol&                coherentRawDigits,
@@ -125,6 +142,7 @@ private:
             : fDaqDecoderICARUSTPCwROI(parent),
               fClockData{clockData},
               fFragmentsHandle(fragmentsHandle),
+              fROPImages(ropImages),
               fConcurrentRawRawDigits(concurrentRawRawDigits),
               fConcurrentRawDigits(concurrentRawDigits),
               fCoherentRawDigits(coherentRawDigits),
@@ -134,18 +152,63 @@ private:
         void operator()(const tbb::blocked_range<size_t>& range) const
         {
             for (size_t idx = range.begin(); idx < range.end(); idx++)
-              fDaqDecoderICARUSTPCwROI.processSingleFragment(idx, fClockData, fFragmentsHandle, fConcurrentRawRawDigits, fConcurrentRawDigits, fCoherentRawDigits, fConcurrentROIs);
+              fDaqDecoderICARUSTPCwROI.processSingleFragment(idx, fClockData, fFragmentsHandle, fROPImages, fConcurrentRawRawDigits, fConcurrentRawDigits, fCoherentRawDigits, fConcurrentROIs);
         }
     private:
         const DaqDecoderICARUSTPCwROI&        fDaqDecoderICARUSTPCwROI;
         detinfo::DetectorClocksData const&    fClockData;
         art::Handle<artdaq::Fragments> const& fFragmentsHandle;
+        ChannelArrayPairVec*                  fROPImages;
         ConcurrentRawDigitCol&                fConcurrentRawRawDigits;
         ConcurrentRawDigitCol&                fConcurrentRawDigits;
         ConcurrentRawDigitCol&                fCoherentRawDigits;
         ConcurrentChannelROICol&              fConcurrentROIs;
     };
 
+    class multiThreadImageProcessing
+    {
+    public:
+        multiThreadImageProcessing(DaqDecoderICARUSTPCwROI const&     parent,
+                                   detinfo::DetectorClocksData const& clockData,
+                                   ChannelArrayPairVec&               ropImages,
+                                   ConcurrentRawDigitCol&             concurrentRawRawDigits,
+                                   ConcurrentRawDigitCol&             concurrentRawDigits,
+                                   ConcurrentRawDigitCol&             coherentRawDigits,
+                                   ConcurrentChannelROICol&           concurrentROIs)
+            : fDaqDecoderICARUSTPCwROI(parent),
+              fClockData{clockData},
+              fROPImages(ropImages),
+              fConcurrentRawRawDigits(concurrentRawRawDigits),
+              fConcurrentRawDigits(concurrentRawDigits),
+              fCoherentRawDigits(coherentRawDigits),
+              fConcurrentROIs(concurrentROIs)
+        {}
+
+        void operator()(const tbb::blocked_range<size_t>& range) const
+        {
+            for (size_t idx = range.begin(); idx < range.end(); idx++)
+              fDaqDecoderICARUSTPCwROI.processSingleImage(fClockData, fROPImages[idx], fConcurrentRawRawDigits, fConcurrentRawDigits, fCoherentRawDigits, fConcurrentROIs);
+        }
+    private:
+        const DaqDecoderICARUSTPCwROI&        fDaqDecoderICARUSTPCwROI;
+        detinfo::DetectorClocksData const&    fClockData;
+        ChannelArrayPairVec&                  fROPImages;
+        ConcurrentRawDigitCol&                fConcurrentRawRawDigits;
+        ConcurrentRawDigitCol&                fConcurrentRawDigits;
+        ConcurrentRawDigitCol&                fCoherentRawDigits;
+        ConcurrentChannelROICol&              fConcurrentROIs;
+    };
+
+    // Function to save the denoised waveform and the ROIs of one channel
+    void saveDenoisedChannel(INoiseFilter const&,
+                             size_t,
+                             raw::ChannelID_t,
+                             icarus_signal_processing::VectorFloat&,
+                             ConcurrentRawDigitCol&,
+                             ConcurrentRawDigitCol&,
+                             ConcurrentRawDigitCol&,
+                             ConcurrentChannelROICol&) const;
+
     // Function to save our RawDigits
     void saveRawDigits(const icarus_signal_processing::ArrayFloat&, 
                        const icarus_signal_processing::VectorFloat&, 
@@ -164,6 +227,7 @@ private:
     size_t                                                      fCoherentNoiseGrouping;      ///< Grouping for removing coherent noise
 
     bool fDropRawDataAfterUse;   ///< Clear fragment data product cache after use.
+    bool fImageProcessing;       ///< Denoise and find ROIs on full readout plane images.
   
     const std::string                                           fLogCategory;                ///< Output category when logging messages
 
@@ -172,6 +236,8 @@ private:
 
     // Statistics.
     int                                                         fNumEvent;             ///< Number of events seen.
+    double                                                      fFragmentStageTime;    ///< Total time spent in the fragment stage [s]
+    double                                                      fImageStageTime;       ///< Total time spent in the image stage [s]
 
     // Plane to ROP plane mapping
     using PlaneToROPPlaneMap   = std::map<geo::PlaneID,unsigned int>;
@@ -183,8 +249,40 @@ private:
     ROPToNumWiresMap                                            fROPToNumWiresMap;
     unsigned int                                                fNumROPs;
 
+    // Full readout plane images: where each channel goes in them
+    struct ImageLocation_t
+    {
+        unsigned int image = std::numeric_limits<unsigned int>::max(); ///< Index of the ROP image
+        unsigned int row   = 0;                                        ///< Channel row in the image
+    };
+
+    /// Plane number marking an image row not filled in the current event.
+    static constexpr unsigned int NoPlane = 3;
+
+    std::vector<ImageLocation_t>                                fChannelToImage;       ///< Image location of each channel
+    ChannelArrayPairVec                                         fROPImages;            ///< Persistent image buffer, one per ROP
+
+    // Output collections with one slot per channel, allocated once: the threads
+    // store each channel directly in its place in channel order
+    ConcurrentRawDigitCol                                       fRawDigitSlots;        ///< Noise filtered waveforms
+    ConcurrentRawDigitCol                                       fRawRawDigitSlots;     ///< Pedestal corrected waveforms
+    ConcurrentRawDigitCol                                       fCoherentSlots;        ///< Coherent noise corrections
+    ConcurrentChannelROICol                                     fROISlots;             ///< Candidate ROIs
+
+    // Work buffers, one per thread, reused for all the boards and channels
+    struct WorkBuffers_t
+    {
+        ChannelArrayPair                      boardData;        ///< Data of one board (without image stage)
+        ChannelArrayPair                      imageData;        ///< Filled rows of an incomplete ROP image
+        std::vector<size_t>                   imageRows;        ///< Image row of each row in `imageData`
+        icarus_signal_processing::VectorFloat pedCorWaveforms;  ///< Pedestal corrected waveform of one channel
+    };
+
+    std::vector<std::unique_ptr<WorkBuffers_t>>                 fWorkBufferVec;        ///< Work buffers, one per thread
+
     // Tools for decoding fragments depending on type
     std::vector<std::unique_ptr<INoiseFilter>>                  fDecoderToolVec;       ///< Decoder tools
+    std::vector<std::unique_ptr<INoiseFilter>>                  fImageToolVec;         ///< Noise filter tools for ROP images
 
     // Useful services, keep copies for now (we can update during begin run periods)
     geo::GeometryCore const*                                    fGeometry;             ///< pointer to Geometry service
@@ -202,7 +300,7 @@ DEFINE_ART_MODULE(DaqDecoderICARUSTPCwROI)
 ///
 DaqDecoderICARUSTPCwROI::DaqDecoderICARUSTPCwROI(fhicl::ParameterSet const & pset, art::ProcessingFrame const& frame) :
                           art::ReplicatedProducer(pset, frame),
-                          fLogCategory("DaqDecoderICARUSTPCwROI"),fNumEvent(0), fNumROPs(0)
+                          fLogCategory("DaqDecoderICARUSTPCwROI"),fNumEvent(0), fFragmentStageTime(0.), fImageStageTime(0.), fNumROPs(0)
 {
     fGeometry   = art::ServiceHandle<geo::Geometry const>{}.get();
     fChannelMap = art::ServiceHandle<icarusDB::IICARUSChannelMap const>{}.get();
@@ -225,6 +323,19 @@ DaqDecoderICARUSTPCwROI::DaqDecoderICARUSTPCwROI(fhicl::ParameterSet const & pse
         decoderTool = art::make_tool<INoiseFilter>(decoderToolParams);
     }
 
+    fWorkBufferVec.resize(max_concurrency);
+
+    for(auto& workBuffers : fWorkBufferVec) workBuffers = std::make_unique<WorkBuffers_t>();
+
+    if (fImageProcessing)
+    {
+        const fhicl::ParameterSet& imageToolParams = pset.get<fhicl::ParameterSet>("ImageDecoderTool");
+
+        fImageToolVec.resize(max_concurrency);
+
+        for(auto& imageTool : fImageToolVec) imageTool = art::make_tool<INoiseFilter>(imageToolParams);
+    }
+
     // Set up our "producers" 
     // Note that we can have multiple instances input to the module
     // Our convention will be to create a similar number of outputs with the same instance names
@@ -280,6 +391,46 @@ DaqDecoderICARUSTPCwROI::DaqDecoderICARUSTPCwROI(fhicl::ParameterSet const & pse
 
     fNumROPs++;
 
+    // The output collections have a slot for each channel in the detector
+    fRawDigitSlots.resize(fGeometry->Nchannels());
+    fROISlots.resize(fGeometry->Nchannels());
+
+    if (fOutputRawWaveform) fRawRawDigitSlots.resize(fGeometry->Nchannels());
+    if (fOutputCorrection)  fCoherentSlots.resize(fGeometry->Nchannels());
+
+    // The full readout plane images are allocated once for the whole job,
+    // one per readout plane in the detector, with one row per channel
+    if (fImageProcessing)
+    {
+        std::map<readout::ROPID,unsigned int> ropToImageMap;
+
+        fChannelToImage.resize(fGeometry->Nchannels());
+
+        for(raw::ChannelID_t channel = 0; channel < fGeometry->Nchannels(); channel++)
+        {
+            readout::ROPID ropID = fGeometry->ChannelToROP(channel);
+
+            if (!ropID) continue;
+
+            auto ropItr = ropToImageMap.find(ropID);
+
+            if (ropItr == ropToImageMap.end())
+            {
+                ropItr = ropToImageMap.emplace(ropID, fROPImages.size()).first;
+
+                unsigned int numChannels = fGeometry->Nchannels(ropID);
+
+                fROPImages.emplace_back(daq::INoiseFilter::ChannelPlaneVec(numChannels,{0,NoPlane}),
+                                        icarus_signal_processing::ArrayFloat(numChannels,icarus_signal_processing::VectorFloat(4096)));
+
+                mf::LogDebug(fLogCategory) << "Image #" << ropItr->second << " for ROP " << ropID << ": " << numChannels << " channels";
+            }
+
+            fChannelToImage[channel].image = ropItr->second;
+            fChannelToImage[channel].row   = channel - fGeometry->FirstChannelInROP(ropID);
+        }
+    }
+
     // Report.
     mf::LogInfo("DaqDecoderICARUSTPCwROI") << "DaqDecoderICARUSTPCwROI configured\n";
 }
@@ -307,6 +458,7 @@ void DaqDecoderICARUSTPCwROI::configure(fhicl::ParameterSet const & pset)
     fSigmaForTruncation    = pset.get<float                     >("NSigmaForTrucation",                                                3.5);
     fCoherentNoiseGrouping = pset.get<size_t                    >("CoherentGrouping",                                                   64);
     fDropRawDataAfterUse   = pset.get<bool                      >("DropRawDataAfterUse",                                              true);
+    fImageProcessing       = pset.get<bool                      >("ImageProcessing",                                                 false);
 }
 
 //----------------------------------------------------------------------------
@@ -351,47 +503,58 @@ void DaqDecoderICARUSTPCwROI::produce(art::Event & event, art::ProcessingFrame c
         art::Handle<artdaq::Fragments> const& daq_handle
           = dataCacheRemover.getHandle<artdaq::Fragments>(fragmentLabel);
 
-        ConcurrentRawDigitCol   concurrentRawDigits;
-        ConcurrentRawDigitCol   concurrentRawRawDigits;
-        ConcurrentRawDigitCol   coherentRawDigits;
-        ConcurrentChannelROICol concurrentROIs;
+        ConcurrentRawDigitCol&   concurrentRawDigits    = fRawDigitSlots;
+        ConcurrentRawDigitCol&   concurrentRawRawDigits = fRawRawDigitSlots;
+        ConcurrentRawDigitCol&   coherentRawDigits      = fCoherentSlots;
+        ConcurrentChannelROICol& concurrentROIs         = fROISlots;
+
+        // Discard anything left by a previous event whose processing was interrupted
+        concurrentRawDigits.clear();
+        concurrentRawRawDigits.clear();
+        coherentRawDigits.clear();
+        concurrentROIs.clear();
 
         PlaneIdxToImageMap   planeIdxToImageMap;
         PlaneIdxToChannelMap planeIdxToChannelMap;
 
-        ChannelArrayPairVec  channelArrayPairVec(fNumROPs);
-
-        // Because the arrays can be variable size we need to loop to initialize
-        for(size_t ropIdx = 0; ropIdx < fNumROPs; ropIdx++)
-        {
-            ChannelArrayPair& channelArrayPair = channelArrayPairVec[ropIdx];
-
-            channelArrayPair.first.resize(fROPToNumWiresMap[ropIdx]);
-            channelArrayPair.second.resize(fROPToNumWiresMap[ropIdx],icarus_signal_processing::VectorFloat(4096));
-
-            mf::LogDebug("DaqDecoderICARUSTPCwROI") << "**> Initializing ropIdx: " << ropIdx << " channelPairVec to " << channelArrayPair.first.size() << " channels with " << channelArrayPair.second[0].size() << " ticks" << std::endl;
-        }
+        // The image buffers are reused: only mark all their rows as not filled yet
+        for(auto& image : fROPImages)
+            std::fill(image.first.begin(),image.first.end(),daq::INoiseFilter::ChannelPlanePair(0,NoPlane));
 
         mf::LogDebug("DaqDecoderICARUSTPCwROI") << "****> Let's get ready to rumble!" << std::endl;
     
         // ... Launch multiple threads with TBB to do the deconvolution and find ROIs in parallel
         auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService>()->DataFor(event);
 
-        multiThreadFragmentProcessing fragmentProcessing(*this, clockData, daq_handle, concurrentRawRawDigits, concurrentRawDigits, coherentRawDigits, concurrentROIs);
+        cet::cpu_timer theClockStage;
+
+        theClockStage.start();
+
+        multiThreadFragmentProcessing fragmentProcessing(*this, clockData, daq_handle, fImageProcessing ? &fROPImages : nullptr, concurrentRawRawDigits, concurrentRawDigits, coherentRawDigits, concurrentROIs);
 
         tbb::parallel_for(tbb::blocked_range<size_t>(0, daq_handle->size()), fragmentProcessing);
 
+        theClockStage.stop();
+
+        fFragmentStageTime += theClockStage.accumulated_real_time();
+
         // Now let's process the resulting images
-    //    multiThreadImageProcessing imageProcessing(*this, clockData, channelArrayPairVec, concurrentRawDigits, coherentRawDigits, concurrentROIs);
+        if (fImageProcessing)
+        {
+            theClockStage.reset();
+            theClockStage.start();
 
-    //    tbb::parallel_for(tbb::blocked_range<size_t>(0, fNumROPs), imageProcessing);
-    
-        // Copy the raw digits from the concurrent vector to our output vector
-        RawDigitCollectionPtr rawDigitCollection = std::make_unique<std::vector<raw::RawDigit>>(std::move_iterator(concurrentRawDigits.begin()), 
-                                                                                                std::move_iterator(concurrentRawDigits.end()));
+            multiThreadImageProcessing imageProcessing(*this, clockData, fROPImages, concurrentRawRawDigits, concurrentRawDigits, coherentRawDigits, concurrentROIs);
+
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, fROPImages.size()), imageProcessing);
+
+            theClockStage.stop();
+
+            fImageStageTime += theClockStage.accumulated_real_time();
+        }
     
-        // Want the RawDigits to be sorted in channel order... has to be done somewhere so why not now?
-        std::sort(rawDigitCollection->begin(),rawDigitCollection->end(),[](const auto& left,const auto&right){return left.Channel() < right.Channel();});
+        // Move the raw digits to our output vector, already in channel order
+        RawDigitCollectionPtr rawDigitCollection = std::make_unique<std::vector<raw::RawDigit>>(concurrentRawDigits.extract());
 
         // What did we get back?
         mf::LogDebug("DaqDecoderICARUSTPCwROI") << "****> Total size of map: " << planeIdxToImageMap.size() << std::endl;
@@ -404,22 +567,15 @@ void DaqDecoderICARUSTPCwROI::produce(art::Event & event, art::ProcessingFrame c
         event.put(std::move(rawDigitCollection), fragmentLabel.instance());
 
         // Do the same to output the candidate ROIs
-        ChannelROICollectionPtr channelROICollection = std::make_unique<std::vector<recob::ChannelROI>>(std::move_iterator(concurrentROIs.begin()),
-                                                                                                        std::move_iterator(concurrentROIs.end()));
-
-        std::sort(channelROICollection->begin(),channelROICollection->end(),[](const auto& left, const auto& right){return left.Channel() < right.Channel();});
+        ChannelROICollectionPtr channelROICollection = std::make_unique<std::vector<recob::ChannelROI>>(concurrentROIs.extract());
 
         event.put(std::move(channelROICollection), fragmentLabel.instance());
     
     
         if (fOutputRawWaveform)
         {
-            // Copy the raw digits from the concurrent vector to our output vector
-            RawDigitCollectionPtr rawRawDigitCollection = std::make_unique<std::vector<raw::RawDigit>>(std::move_iterator(concurrentRawRawDigits.begin()), 
-                                                                                                       std::move_iterator(concurrentRawRawDigits.end()));
-    
-            // Want the RawDigits to be sorted in channel order... has to be done somewhere so why not now?
-            std::sort(rawRawDigitCollection->begin(),rawRawDigitCollection->end(),[](const auto& left,const auto&right){return left.Channel() < right.Channel();});
+            // Move the raw digits to our output vector, already in channel order
+            RawDigitCollectionPtr rawRawDigitCollection = std::make_unique<std::vector<raw::RawDigit>>(concurrentRawRawDigits.extract());
     
             // Now transfer ownership to the event store
             event.put(std::move(rawRawDigitCollection),fragmentLabel.instance() + fOutputRawWavePath);
@@ -427,12 +583,8 @@ void DaqDecoderICARUSTPCwROI::produce(art::Event & event, art::ProcessingFrame c
     
         if (fOutputCorrection)
         {
-            // Copy the raw digits from the concurrent vector to our output vector
-            RawDigitCollectionPtr coherentCollection = std::make_unique<std::vector<raw::RawDigit>>(std::move_iterator(coherentRawDigits.begin()), 
-                                                                                                    std::move_iterator(coherentRawDigits.end()));
-    
-            // Want the RawDigits to be sorted in channel order... has to be done somewhere so why not now?
-            std::sort(coherentCollection->begin(),coherentCollection->end(),[](const auto& left,const auto&right){return left.Channel() < right.Channel();});
+            // Move the raw digits to our output vector, already in channel order
+            RawDigitCollectionPtr coherentCollection = std::make_unique<std::vector<raw::RawDigit>>(coherentRawDigits.extract());
     
             // Now transfer ownership to the event store
             event.put(std::move(coherentCollection),fragmentLabel.instance() + fOutputCoherentPath);
@@ -451,6 +603,7 @@ void DaqDecoderICARUSTPCwROI::produce(art::Event & event, art::ProcessingFrame c
 void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t                             idx,
                                                     detinfo::DetectorClocksData const& clockData,
                                                     art::Handle<artdaq::Fragments>     fragmentHandle,
+                                                    ChannelArrayPairVec*               ropImages,
                                                     ConcurrentRawDigitCol&             concurrentRawRawDigitCol,
                                                     ConcurrentRawDigitCol&             concurrentRawDigitCol,
                                                     ConcurrentRawDigitCol&             coherentRawDigitCol,
@@ -526,14 +679,20 @@ void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t
     // Recover pointer to the decoder needed here
     INoiseFilter* decoderTool = fDecoderToolVec[tbb::this_task_arena::current_thread_index()].get();
 
-    // Create a local channel pair  to hold at most a boards worth of info (64 channels x 4096 ticks)
-    ChannelArrayPair channelArrayPair;
+    // The work buffers of this thread, kept from fragment to fragment
+    WorkBuffers_t& workBuffers = *fWorkBufferVec[tbb::this_task_arena::current_thread_index()];
+
+    // The channel pair holds at most a boards worth of info (64 channels x 4096 ticks)
+    // (not needed if the data goes into the readout plane images)
+    ChannelArrayPair& channelArrayPair = workBuffers.boardData;
 
-    channelArrayPair.first.resize(nChannelsPerBoard);
-    channelArrayPair.second.resize(nChannelsPerBoard,icarus_signal_processing::VectorFloat(nSamplesPerChannel));
+    if (!ropImages)
+    {
+        channelArrayPair.first.resize(nChannelsPerBoard);
+        channelArrayPair.second.resize(nChannelsPerBoard);
 
-    // Now set up for output, we need to convert back from float to short int so use this
-    raw::RawDigit::ADCvector_t wvfm(nSamplesPerChannel);
+        for(auto& rawDataVec : channelArrayPair.second) rawDataVec.resize(nSamplesPerChannel);
+    }
 
     // The first task is to recover the data from the board data block, determine and subtract the pedestals
     // and store into vectors useful for the next steps
@@ -561,6 +720,36 @@ void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t
         // Get the pointer to the start of this board's block of data
         const icarus::A2795DataBlock::data_t* dataBlock = physCrateFragment.BoardData(board);
 
+        // With the image stage, the data is copied into the rows of the readout plane
+        // images and the processing is left to that stage; each channel belongs to
+        // exactly one fragment, so the rows written here are not touched by other threads
+        if (ropImages)
+        {
+            for(size_t chanIdx = 0; chanIdx < nChannelsPerBoard; chanIdx++)
+            {
+                const auto& channelPlanePair = channelPlanePairVec[chanIdx];
+
+                // Skip channels which are not connected to a wire
+                if (channelPlanePair.second >= NoPlane || channelPlanePair.first >= fChannelToImage.size()) continue;
+
+                const ImageLocation_t& location = fChannelToImage[channelPlanePair.first];
+
+                if (location.image >= ropImages->size()) continue;
+
+                ChannelArrayPair&                      image      = (*ropImages)[location.image];
+                icarus_signal_processing::VectorFloat& rawDataVec = image.second[location.row];
+
+                rawDataVec.resize(nSamplesPerChannel);
+
+                for(size_t tick = 0; tick < nSamplesPerChannel; tick++)
+                    rawDataVec[tick] = -dataBlock[chanIdx + tick * nChannelsPerBoard];
+
+                image.first[location.row] = channelPlanePair;
+            }
+
+            continue;
+        }
+
         // Copy to input data array
         for(size_t chanIdx = 0; chanIdx < nChannelsPerBoard; chanIdx++)
         {
@@ -576,113 +765,182 @@ void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t
         //process_fragment(event, rawfrag, product_collection, header_collection);
         decoderTool->process_fragment(clockData, channelArrayPair.first, channelArrayPair.second, fCoherentNoiseGrouping);
 
-        // We need to recalculate pedestals for the noise corrected waveforms
-        icarus_signal_processing::WaveformTools<float> waveformTools;
+        for(size_t chanIdx = 0; chanIdx < nChannelsPerBoard; chanIdx++)
+        {
+            // Get the channel number on the Fragment
+            raw::ChannelID_t channel = channelPlanePairVec[chanIdx].first;
 
-        // Local storage for recomputing the the pedestals for the noise corrected data
-        float localPedestal(0.);
-        float localFullRMS(0.);
-        float localTruncRMS(0.);
-        int   localNumTruncBins(0);
-        int   localRangeBins(0);
+            saveDenoisedChannel(*decoderTool, chanIdx, channel, workBuffers.pedCorWaveforms, concurrentRawRawDigitCol, concurrentRawDigitCol, coherentRawDigitCol, concurrentROIs);
+        }
+    }
+
+    // We need to make sure the channelID information is not preserved when less than 9 boards in the fragment
+//    if (nBoardsPerFragment < 9)
+//    {
+//        std::fill(fChannelIDVec.begin() + nBoardsPerFragment * nChannelsPerBoard, fChannelIDVec.end(), -1);
+//    }
 
-        float sigmaCut(fSigmaForTruncation);
 
-        // Recover the denoised waveform
-        const icarus_signal_processing::ArrayFloat& denoised = decoderTool->getWaveLessCoherent();
+    theClockProcess.stop();
 
-        icarus_signal_processing::VectorFloat       pedCorWaveforms(denoised[0].size());
+    double totalTime = theClockProcess.accumulated_real_time();
 
-        for(size_t chanIdx = 0; chanIdx < nChannelsPerBoard; chanIdx++)
+    mf::LogDebug(fLogCategory) << "--> Exiting fragment processing for thread: " << tbb::this_task_arena::current_thread_index() << ", time: " << totalTime << std::endl;
+    return;
+}
+
+//----------------------------------------------------------------------------
+/// Denoises and finds the ROIs of a full readout plane image.
+///
+/// Rows of the image which were not filled in this event (channels from
+/// missing fragments or boards) are not given to the image tool, so that they
+/// do not enter the coherent noise groups, and they are not saved.
+///
+void DaqDecoderICARUSTPCwROI::processSingleImage(detinfo::DetectorClocksData const& clockData,
+                                                 ChannelArrayPair&                  image,
+                                                 ConcurrentRawDigitCol&             concurrentRawRawDigitCol,
+                                                 ConcurrentRawDigitCol&             concurrentRawDigitCol,
+                                                 ConcurrentRawDigitCol&             coherentRawDigitCol,
+                                                 ConcurrentChannelROICol&           concurrentROIs) const
+{
+    daq::INoiseFilter::ChannelPlaneVec&   channelVec = image.first;
+    icarus_signal_processing::ArrayFloat& dataArray  = image.second;
+
+    // The number of ticks is the one of the data; no data, nothing to do
+    auto firstFilled = std::find_if(channelVec.begin(),channelVec.end(),[](const auto& channelPlane){return channelPlane.second < NoPlane;});
+
+    if (firstFilled == channelVec.end()) return;
+
+    size_t numTicks = dataArray[std::distance(channelVec.begin(),firstFilled)].size();
+
+    WorkBuffers_t&       workBuffers = *fWorkBufferVec[tbb::this_task_arena::current_thread_index()];
+    std::vector<size_t>& filledRows  = workBuffers.imageRows;
+
+    filledRows.clear();
+
+    for(size_t rowIdx = 0; rowIdx < channelVec.size(); rowIdx++)
+    {
+        if (channelVec[rowIdx].second < NoPlane && dataArray[rowIdx].size() == numTicks) filledRows.push_back(rowIdx);
+    }
+
+    // If the image is incomplete, its filled rows are moved (not copied) in order
+    // into the compact image of this thread, and moved back after processing
+    bool              compact   = filledRows.size() < channelVec.size();
+    ChannelArrayPair& toolImage = compact ? workBuffers.imageData : image;
+
+    if (compact)
+    {
+        toolImage.first.resize(filledRows.size());
+        toolImage.second.resize(filledRows.size());
+
+        for(size_t toolIdx = 0; toolIdx < filledRows.size(); toolIdx++)
         {
-            // Get the channel number on the Fragment
-            raw::ChannelID_t channel = channelPlanePairVec[chanIdx].first;
+            toolImage.first[toolIdx] = channelVec[filledRows[toolIdx]];
+            std::swap(toolImage.second[toolIdx], dataArray[filledRows[toolIdx]]);
+        }
+    }
 
-            // Are we storing the raw waveforms?
-            if (fOutputRawWaveform)
-            {
-                const icarus_signal_processing::VectorFloat& waveform = decoderTool->getPedCorWaveforms()[chanIdx];
+    // Recover pointer to the image tool needed here
+    INoiseFilter* imageTool = fImageToolVec[tbb::this_task_arena::current_thread_index()].get();
 
-                // Need to convert from float to short int
-                std::transform(waveform.begin(),waveform.end(),wvfm.begin(),[](const auto& val){return short(std::round(val));});
-    
-                ConcurrentRawDigitCol::iterator newRawObjItr = concurrentRawRawDigitCol.emplace_back(channel,wvfm.size(),wvfm); 
+    imageTool->process_fragment(clockData, toolImage.first, toolImage.second, fCoherentNoiseGrouping);
 
-                newRawObjItr->SetPedestal(decoderTool->getPedestalVals()[chanIdx],decoderTool->getFullRMSVals()[chanIdx]);
-            }
+    for(size_t toolIdx = 0; toolIdx < toolImage.first.size(); toolIdx++)
+        saveDenoisedChannel(*imageTool, toolIdx, toolImage.first[toolIdx].first, workBuffers.pedCorWaveforms, concurrentRawRawDigitCol, concurrentRawDigitCol, coherentRawDigitCol, concurrentROIs);
 
-            if (fOutputCorrection)
-            {
-                const icarus_signal_processing::VectorFloat& corrections = decoderTool->getCorrectedMedians()[chanIdx];
+    if (compact)
+    {
+        for(size_t toolIdx = 0; toolIdx < filledRows.size(); toolIdx++)
+            std::swap(toolImage.second[toolIdx], dataArray[filledRows[toolIdx]]);
+    }
 
-                // Need to convert from float to short int
-                std::transform(corrections.begin(),corrections.end(),wvfm.begin(),[](const auto& val){return short(std::round(val));});
+    return;
+}
 
-                //ConcurrentRawDigitCol::iterator newRawObjItr = coherentRawDigitCol.emplace_back(channel,wvfm.size(),wvfm); 
-                ConcurrentRawDigitCol::iterator newRawObjItr = coherentRawDigitCol.push_back(raw::RawDigit(channel,wvfm.size(),wvfm)); 
+//----------------------------------------------------------------------------
+/// Saves the waveforms and ROIs of the channel at `chanIdx` of the last data
+/// processed by `decoderTool`; `pedCorWaveforms` is a work buffer.
+/// The waveforms are converted directly into the data products, which are
+/// stored in the slot of their channel.
+///
+void DaqDecoderICARUSTPCwROI::saveDenoisedChannel(INoiseFilter const&         decoderTool,
+                                                  size_t                      chanIdx,
+                                                  raw::ChannelID_t            channel,
+                                                  icarus_signal_processing::VectorFloat& pedCorWaveforms,
+                                                  ConcurrentRawDigitCol&      concurrentRawRawDigitCol,
+                                                  ConcurrentRawDigitCol&      concurrentRawDigitCol,
+                                                  ConcurrentRawDigitCol&      coherentRawDigitCol,
+                                                  ConcurrentChannelROICol&    concurrentROIs) const
+{
+    // We need to recalculate pedestals for the noise corrected waveforms
+    icarus_signal_processing::WaveformTools<float> waveformTools;
 
-                newRawObjItr->SetPedestal(0.,0.);
-            }
+    // Local storage for recomputing the the pedestals for the noise corrected data
+    float localPedestal(0.);
+    float localFullRMS(0.);
+    float localTruncRMS(0.);
+    int   localNumTruncBins(0);
+    int   localRangeBins(0);
 
-            // Now determine the pedestal and correct for it
-            waveformTools.getPedestalCorrectedWaveform(denoised[chanIdx],
-                                                       pedCorWaveforms,
-                                                       sigmaCut,
-                                                       localPedestal,
-                                                       localFullRMS,
-                                                       localTruncRMS,
-                                                       localNumTruncBins,
-                                                       localRangeBins);
+    float sigmaCut(fSigmaForTruncation);
 
-            // Need to convert from float to short int
-//            std::transform(denoised[chanIdx].begin(),denoised[chanIdx].end(),wvfm.begin(),[](const auto& val){return short(std::round(val));});
-            std::transform(pedCorWaveforms.begin(),pedCorWaveforms.end(),wvfm.begin(),[](const auto& val){return short(std::round(val));});
+    // Recover the denoised waveform
+    const icarus_signal_processing::VectorFloat& denoised = decoderTool.getWaveLessCoherent()[chanIdx];
 
-            ConcurrentRawDigitCol::iterator newObjItr = concurrentRawDigitCol.emplace_back(channel,wvfm.size(),wvfm); 
+    pedCorWaveforms.resize(denoised.size());
 
-            newObjItr->SetPedestal(localPedestal,localFullRMS);
+    // Need to convert from float to short int
+    auto toADC = [](const icarus_signal_processing::VectorFloat& waveform)
+    {
+        raw::RawDigit::ADCvector_t wvfm(waveform.size());
 
-            // And, finally, the ROIs 
-            const icarus_signal_processing::VectorBool& chanROIs = decoderTool->getROIVals()[chanIdx];
-            recob::ChannelROI::RegionsOfInterest_t      ROIVec;
+        details::roundToADC(waveform.data(), waveform.size(), wvfm.data());
 
-            // Go through candidate ROIs and create Wire ROIs
-            size_t roiIdx = 0;
+        return wvfm;
+    };
 
-            while(roiIdx < chanROIs.size())
-            {
-                size_t roiStartIdx = roiIdx;
+    // Are we storing the raw waveforms?
+    if (fOutputRawWaveform)
+    {
+        raw::RawDigit::ADCvector_t wvfm = toADC(decoderTool.getPedCorWaveforms()[chanIdx]);
 
-                while(roiIdx < chanROIs.size() && chanROIs[roiIdx]) roiIdx++;
+        raw::RawDigit& newRawObj = concurrentRawRawDigitCol.put(channel, raw::RawDigit(channel,wvfm.size(),std::move(wvfm)));
 
-                if (roiIdx > roiStartIdx)
-                {
-                    std::vector<short> holder(roiIdx - roiStartIdx);
+        newRawObj.SetPedestal(decoderTool.getPedestalVals()[chanIdx],decoderTool.getFullRMSVals()[chanIdx]);
+    }
 
-                    for(size_t idx = 0; idx < holder.size(); idx++) holder[idx] = wvfm[roiStartIdx+idx];
+    if (fOutputCorrection)
+    {
+        raw::RawDigit::ADCvector_t wvfm = toADC(decoderTool.getCorrectedMedians()[chanIdx]);
 
-                    ROIVec.add_range(roiStartIdx, std::move(holder));
-                }
+        raw::RawDigit& newRawObj = coherentRawDigitCol.put(channel, raw::RawDigit(channel,wvfm.size(),std::move(wvfm)));
 
-                roiIdx++;
-            }
-        
-            concurrentROIs.push_back(recob::ChannelROICreator(std::move(ROIVec),channel).move());
-        }
+        newRawObj.SetPedestal(0.,0.);
     }
 
-    // We need to make sure the channelID information is not preserved when less than 9 boards in the fragment
-//    if (nBoardsPerFragment < 9)
-//    {
-//        std::fill(fChannelIDVec.begin() + nBoardsPerFragment * nChannelsPerBoard, fChannelIDVec.end(), -1);
-//    }
+    // Now determine the pedestal and correct for it
+    waveformTools.getPedestalCorrectedWaveform(denoised,
+                                               pedCorWaveforms,
+                                               sigmaCut,
+                                               localPedestal,
+                                               localFullRMS,
+                                               localTruncRMS,
+                                               localNumTruncBins,
+                                               localRangeBins);
 
+    raw::RawDigit::ADCvector_t wvfm = toADC(pedCorWaveforms);
 
-    theClockProcess.stop();
+    raw::RawDigit& newObj = concurrentRawDigitCol.put(channel, raw::RawDigit(channel,wvfm.size(),std::move(wvfm)));
 
-    double totalTime = theClockProcess.accumulated_real_time();
+    newObj.SetPedestal(localPedestal,localFullRMS);
+
+    // And, finally, the ROIs: each candidate ROI is copied from the saved waveform
+    recob::ChannelROI::RegionsOfInterest_t ROIVec;
+
+    details::addMaskedRanges(decoderTool.getROIVals()[chanIdx], newObj.ADCs(), ROIVec);
+
+    concurrentROIs.put(channel, recob::ChannelROICreator(std::move(ROIVec),channel).move());
 
-    mf::LogDebug(fLogCategory) << "--> Exiting fragment processing for thread: " << tbb::this_task_arena::current_thread_index() << ", time: " << totalTime << std::endl;
     return;
 }
 
@@ -691,6 +949,68 @@ void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t
 void DaqDecoderICARUSTPCwROI::endJob(art::ProcessingFrame const&)
 {
     mf::LogInfo(fLogCategory) << "Looked at " << fNumEvent << " events" << std::endl;
+
+    if (fNumEvent == 0) return;
+
+    mf::LogInfo log(fLogCategory);
+
+    log << "Average time per event: " << (fFragmentStageTime / fNumEvent) << " s in the fragment stage";
+
+    if (fImageProcessing)
+    {
+        auto imageSize = [](const ChannelArrayPair& image)
+        {
+            size_t bytes = image.first.capacity() * sizeof(daq::INoiseFilter::ChannelPlanePair);
+
+            for(const auto& row : image.second) bytes += row.capacity() * sizeof(float);
+
+            return bytes;
+        };
+
+        auto arraySize = [](const icarus_signal_processing::ArrayFloat& array)
+        {
+            size_t bytes = 0;
+
+            for(const auto& row : array) bytes += row.capacity() * sizeof(float);
+
+            return bytes;
+        };
+
+        auto boolArraySize = [](const icarus_signal_processing::ArrayBool& array)
+        {
+            size_t bytes = 0;
+
+            for(const auto& row : array) bytes += row.capacity() / 8;
+
+            return bytes;
+        };
+
+        size_t imageBytes = 0;
+
+        for(const auto& image : fROPImages) imageBytes += imageSize(image);
+
+        // Each thread has its own image tool, whose output covers a full readout plane,
+        // and a compact image buffer if some image was ever incomplete
+        size_t toolBytes = 0;
+
+        for(const auto& imageTool : fImageToolVec)
+        {
+            toolBytes += arraySize(imageTool->getRawWaveforms())     + arraySize(imageTool->getPedCorWaveforms())
+                       + arraySize(imageTool->getIntrinsicRMS())     + arraySize(imageTool->getCorrectedMedians())
+                       + arraySize(imageTool->getWaveLessCoherent()) + arraySize(imageTool->getMorphedWaveforms())
+                       + boolArraySize(imageTool->getSelectionVals()) + boolArraySize(imageTool->getROIVals());
+        }
+
+        for(const auto& workBuffers : fWorkBufferVec) toolBytes += imageSize(workBuffers->imageData);
+
+        log << ", " << (fImageStageTime / fNumEvent) << " s in the image stage; "
+            << fROPImages.size() << " readout plane images using " << (imageBytes / 1048576.) << " MiB, "
+            << fImageToolVec.size() << " image tool buffers using " << (toolBytes / 1048576.) << " MiB";
+    }
+    else
+    {
+        log << "; image stage disabled, no image buffers allocated";
+    }
 }
 
 } // end of namespace
@@ -23,7 +23,7 @@ fhicl::ParameterSet
 icarus::PMTconfigurationExtractorBase::convertConfigurationDocuments(
   fhicl::ParameterSet const& container,
   std::string const& configListKey,
-  std::initializer_list<std::regex const> components // TODO template with matcher functor
+  std::initializer_list<details::KeyPattern const> components
 ) {
   
   fhicl::ParameterSet const sourceConfig
@@ -59,9 +59,9 @@ icarus::PMTconfigurationExtractorBase::convertConfigurationDocuments(
 // -----------------------------------------------------------------------------
 // ---  icarus::PMTconfigurationExtractor
 // -----------------------------------------------------------------------------
-std::vector<std::regex> const
+std::vector<icarus::details::KeyPattern> const
   icarus::PMTconfigurationExtractor::ConfigurationNames
-  { std::regex{ "icaruspmt.*" } }
+  { "icaruspmt.*" }
   ;
 
 // -----------------------------------------------------------------------------
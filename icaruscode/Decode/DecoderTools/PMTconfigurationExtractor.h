@@ -20,6 +20,7 @@
 
 // ICARUS libraries
 #include "icaruscode/Decode/ChannelMapping/IICARUSChannelMap.h"
+#include "icaruscode/Decode/DecoderTools/details/KeyPattern.h"
 #include "icaruscode/Utilities/ReadArtConfiguration.h" // util::readConfigurationFromArtPrincipal()
 #include "sbnobj/Common/PMT/Data/PMTconfiguration.h"
 #include "sbnobj/Common/PMT/Data/V1730Configuration.h"
@@ -119,18 +120,27 @@ class icarus::PMTconfigurationExtractorBase {
    * value is a parameter set that may have keys like `icaruspmtee01`,
    * `icaruspmtew02`, `icarustrigger` etc., each one with a FHiCL table as
    * `value.
+   * Simple patterns like the ones above are matched without the regular
+   * expression library (see `icarus::details::KeyPattern`).
    */
   static fhicl::ParameterSet convertConfigurationDocuments(
     fhicl::ParameterSet const& container,
     std::string const& configListKey,
-    std::initializer_list<std::regex const> components
+    std::initializer_list<details::KeyPattern const> components
     );
   
-  /// Returns whether `key` matches at least one of the regular expressions
-  /// in the [ `rbegin`, `rend` [ range.
+  /// Returns whether `key` matches at least one of the patterns
+  /// (`std::regex` or `details::KeyPattern`) in the [ `rbegin`, `rend` [ range.
   template <typename RBegin, typename REnd>
   static bool matchKey(std::string const& key, RBegin rbegin, REnd rend);
   
+  /// Returns whether the whole `key` matches `pattern`.
+  static bool matchPattern(std::string const& key, std::regex const& pattern)
+    { return std::regex_match(key, pattern); }
+  static bool matchPattern
+    (std::string const& key, details::KeyPattern const& pattern)
+    { return pattern.match(key); }
+  
   /// @}
   // --- END ---- Utility ------------------------------------------------------
   
@@ -355,8 +365,8 @@ class icarus::PMTconfigurationExtractor
   
     private:
   
-  /// Regular expressions matching all names of supported PMT configurations.
-  static std::vector<std::regex> const ConfigurationNames;
+  /// Patterns matching all names of supported PMT configurations.
+  static std::vector<details::KeyPattern> const ConfigurationNames;
   
   /// Hardware PMT channel mapping to LArSoft's.
   icarusDB::IICARUSChannelMap const* fChannelMap = nullptr;
@@ -447,7 +457,7 @@ namespace icarus::details {
       
       fhicl::ParameterSet const configDocs
         = extractor.convertConfigurationDocuments
-          (pset, "configuration_documents", { std::regex{ "icaruspmt.*" } })
+          (pset, "configuration_documents", { details::KeyPattern{ "icaruspmt.*" } })
         ;
       
       sbn::PMTconfiguration candidateConfig = extractor.extract(configDocs);
@@ -482,8 +492,8 @@ template <typename RBegin, typename REnd>
 bool icarus::PMTconfigurationExtractorBase::matchKey
   (std::string const& key, RBegin rbegin, REnd rend)
 {
-  for (auto iRegex = rbegin; iRegex != rend; ++iRegex)
-    if (std::regex_match(key, *iRegex)) return true;
+  for (auto iPattern = rbegin; iPattern != rend; ++iPattern)
+    if (matchPattern(key, *iPattern)) return true;
   return false;
 } // icarus::PMTconfigurationExtractorBase::matchKey()
 
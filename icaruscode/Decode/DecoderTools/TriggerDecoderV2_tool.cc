@@ -35,8 +35,7 @@
 #include "icaruscode/Decode/DecoderTools/IDecoder.h"
 #include "sbnobj/Common/Trigger/BeamBits.h"
 #include "icaruscode/Decode/DecoderTools/Dumpers/FragmentDumper.h" // dumpFragment()
-#include "icaruscode/Decode/DecoderTools/details/KeyedCSVparser.h"
-#include "icaruscode/Decode/DecoderTools/details/KeyValuesData.h"
+#include "icaruscode/Decode/DecoderTools/details/TriggerDataParser.h"
 #include "icarusalg/Utilities/BinaryDumpUtils.h" // hexdump() DEBUG
 
 #include <cstdlib>
@@ -44,6 +43,7 @@
 #include <iomanip> // std::setw(), std::setfill()
 #include <string_view>
 #include <memory>
+#include <optional>
 #include <array>
 
 
@@ -248,16 +248,16 @@ namespace daq
     /// Cached pointer to the trigger configuration of the current run, if any.
     icarus::TriggerConfiguration const* fTriggerConfiguration = nullptr;
     
+    /// Parser of the trigger data string (known keys are set up once per job).
+    icarus::details::TriggerDataParser const fTriggerDataParser;
+    
     
     /// Creates a `ICARUSTriggerInfo` from a generic fragment.
     icarus::ICARUSTriggerV2Fragment makeTriggerFragment
       (artdaq::Fragment const& fragment) const;
     
-    /// Parses the trigger data packet with the "standard" parser.
-    icarus::ICARUSTriggerInfo parseTriggerString(std::string_view data) const;
-    
-    /// Parses the trigger data packet with a CSV parser.
-    icarus::KeyValuesData parseTriggerStringAsCSV
+    /// Parses the trigger data packet into a typed record.
+    icarus::details::TriggerData parseTriggerString
       (std::string const& data) const;
     
     /// Name of the data product instance for the current trigger.
@@ -298,6 +298,10 @@ namespace daq
     /// Returns the beam type corresponding to the specified trigger `source`.
     static sim::BeamType_t simGateType(sbn::triggerSource source);
     
+    /// Returns the content of `value`, throws if not present.
+    template <typename T>
+    static T requireValue(std::optional<T> const& value, std::string const& key);
+    
   };
 
 
@@ -382,48 +386,21 @@ namespace daq
   } // TriggerDecoder::makeTriggerFragment()
 
   
-  icarus::ICARUSTriggerInfo TriggerDecoder::parseTriggerString
-    (std::string_view data) const
-  {
-    try {
-      return icarus::parse_ICARUSTriggerV2String(data.data());
-    }
-    catch(std::exception const& e) {
-      mf::LogSystem("TriggerDecoder")
-        << "Error while running standard parser on " << data.length()
-        << "-char long trigger string:\n==>|" << data
-        << "|<==\nError message: " << e.what();
-      throw;
-    }
-    catch(...) {
-      mf::LogSystem("TriggerDecoder")
-        << "Unidentified exception while running standard parser on "
-        << data.length() << "-char long trigger string:\n==>|" << data << "|.";
-      throw;
-    }
-  } // TriggerDecoder::parseTriggerString()
-
-
-  icarus::KeyValuesData TriggerDecoder::parseTriggerStringAsCSV
+  icarus::details::TriggerData TriggerDecoder::parseTriggerString
     (std::string const& data) const
   {
-    icarus::details::KeyedCSVparser parser;
-    parser.addPatterns({
-        { "Cryo. (EAST|WEST) Connector . and .", 1U }
-        , { "Trigger Type", 1U }
-      });
     std::string_view const dataLine = firstLine(data);
     try {
-      return parser(dataLine);
+      return fTriggerDataParser(dataLine);
     }
-    catch(icarus::details::KeyedCSVparser::Error const& e) {
+    catch(icarus::details::TriggerDataParser::Error const& e) {
       mf::LogError("TriggerDecoder")
         << "Error parsing " << dataLine.length()
         << "-char long trigger string:\n==>|" << dataLine
         << "|<==\nError message: " << e.what() << std::endl;
       throw;
     }
-  } // TriggerDecoder::parseTriggerStringAsCSV()
+  } // TriggerDecoder::parseTriggerString()
   
 
   void TriggerDecoder::setupRun(art::Run const& run) {
@@ -443,10 +420,10 @@ namespace daq
     // the decoder trusts it and references all the times with respect to it.
     uint64_t const artdaq_ts = fragment.timestamp();
     icarus::ICARUSTriggerV2Fragment frag { makeTriggerFragment(fragment) };
-    std::string data = frag.GetDataString();
-    char *buffer = const_cast<char*>(data.c_str());
-
-    icarus::ICARUSTriggerInfo datastream_info = parseTriggerString(buffer);
+    std::string const data = frag.GetDataString();
+    
+    // all the information needed from the trigger string, in a single pass
+    icarus::details::TriggerData const triggerData = parseTriggerString(data);
     uint64_t const raw_wr_ts // this is raw, unadultered, uncorrected
       = makeTimestamp(frag.getWRSeconds(), frag.getWRNanoSeconds());
     
@@ -457,21 +434,9 @@ namespace daq
       { return time + WRtimeToTriggerTime; };
     assert(correctWRtime(raw_wr_ts) == artdaq_ts);
     
-    //
-    // we parse again the trigger string for information that was not saved
-    // by the board reader in the trigger fragment nor in `datastream_info`
-    //
-    auto const parsedData = parseTriggerStringAsCSV(data); 
-    
     unsigned int beamgate_count { std::numeric_limits<unsigned int>::max() };
     std::uint64_t beamgate_ts { artdaq_ts }; // we cheat
-    /* [20210717, petrillo@slac.stanford.edu] `(pBeamGateInfo->nValues() == 3)`:
-     * this is an attempt to "support" a few Run0 runs (6017 to roughly 6043)
-     * which have the beam gate information truncated; this workaround should
-     * be removed when there is enough ICARUS data that these runs become
-     * uninteresting.
-     */
-    if (auto pBeamGateInfo = parsedData.findItem("Beam_TS")) {
+    if (triggerData.beamGate) {
       /*
        * The Veto Business:
        * 
@@ -493,13 +458,11 @@ namespace daq
         = fTriggerConfiguration? fTriggerConfiguration->vetoDelay: 0LL;
       
       
-      // if gate information is found, it must be complete
-      beamgate_count = pBeamGateInfo->getNumber<unsigned int>(0U);
+      // if gate information is found, it is complete (the parser checks)
+      beamgate_count = triggerData.beamGate->count;
       
-      uint64_t const raw_bg_ts = makeTimestamp( // raw and uncorrected too...
-        pBeamGateInfo->getNumber<unsigned int>(1U),
-        pBeamGateInfo->getNumber<unsigned int>(2U)
-        )
+      uint64_t const raw_bg_ts // raw and uncorrected too...
+        = triggerData.beamGate->timestamp()
         + triggerVetoDurationNS // ... but remove the veto time
         ;
       
@@ -509,15 +472,10 @@ namespace daq
       
     } // if has gate information
     std::uint64_t enablegate_ts { artdaq_ts };
-    if (auto pEnableGateInfo = parsedData.findItem("Enable_TS"))
+    if (triggerData.enableGate)
     {
-      // if gate information is found, it must be complete
-      //enablegate_count = pEnableGateInfo->getNumber<unsigned int>(0U);
-
-      uint64_t const raw_en_ts = makeTimestamp( // raw and uncorrected too
-                                               pEnableGateInfo->getNumber<unsigned int>(1U),
-                                               pEnableGateInfo->getNumber<unsigned int>(2U)
-                                                );
+      // raw and uncorrected too
+      uint64_t const raw_en_ts = triggerData.enableGate->timestamp();
 
       // assuming the raw times from the fragment are on the same time scale 
       // (same offset corrections)
@@ -536,7 +494,7 @@ namespace daq
         << " s (" << timestampDiff(beamgate_ts, artdaq_ts)
         << " ns relative to trigger)"
         << "\nParsed data (from " << data.size() << " characters): "
-        << parsedData << std::endl;
+        << triggerData << std::endl;
       
       if (fDebug) { // this grows tiresome quickly when processing many events
         std::cout << "Trigger packet content:\n" << data
@@ -548,12 +506,12 @@ namespace daq
     // extra trigger info
     //
     sbn::triggerSource beamGateBit;
-    switch (datastream_info.gate_type) {
+    switch (triggerData.gateType) {
       case TriggerGateTypes::BNB:{
         beamGateBit = sbn::triggerSource::BNB;
         fTriggerExtra->gateCountFromPreviousTrigger = frag.getDeltaGatesBNB();
         fTriggerExtra->previousTriggerTimestamp = frag.getLastTimestampBNB();
-        fTriggerExtra->gateCount = datastream_info.gate_id_BNB;
+        fTriggerExtra->gateCount = triggerData.gateIDBNB;
         fTriggerExtra->triggerCount = frag.getTotalTriggerBNB();
         fTriggerExtra->anyTriggerCountFromPreviousTrigger = frag.getLastTriggerBNB();
         break;
@@ -562,7 +520,7 @@ namespace daq
         beamGateBit = sbn::triggerSource::NuMI;
         fTriggerExtra->gateCountFromPreviousTrigger = frag.getDeltaGatesNuMI();
         fTriggerExtra->previousTriggerTimestamp = frag.getLastTimestampNuMI();
-        fTriggerExtra->gateCount = datastream_info.gate_id_NuMI;
+        fTriggerExtra->gateCount = triggerData.gateIDNuMI;
         fTriggerExtra->triggerCount = frag.getTotalTriggerNuMI();
         fTriggerExtra->anyTriggerCountFromPreviousTrigger = frag.getLastTriggerNuMI();
         break;
@@ -571,7 +529,7 @@ namespace daq
         beamGateBit = sbn::triggerSource::OffbeamBNB;
         fTriggerExtra->gateCountFromPreviousTrigger = frag.getDeltaGatesBNBOff();
         fTriggerExtra->previousTriggerTimestamp= frag.getLastTimestampBNBOff();
-        fTriggerExtra->gateCount = datastream_info.gate_id_BNBOff;
+        fTriggerExtra->gateCount = triggerData.gateIDOffbeamBNB;
         fTriggerExtra->triggerCount = frag.getTotalTriggerBNBOff();
         fTriggerExtra->anyTriggerCountFromPreviousTrigger = frag.getLastTriggerBNBOff();
         break;
@@ -580,7 +538,7 @@ namespace daq
         beamGateBit = sbn::triggerSource::OffbeamNuMI;
         fTriggerExtra->gateCountFromPreviousTrigger = frag.getDeltaGatesNuMIOff();
         fTriggerExtra->previousTriggerTimestamp= frag.getLastTimestampNuMIOff();
-        fTriggerExtra->gateCount = datastream_info.gate_id_NuMIOff;
+        fTriggerExtra->gateCount = triggerData.gateIDOffbeamNuMI;
         fTriggerExtra->triggerCount = frag.getTotalTriggerNuMIOff();
         fTriggerExtra->anyTriggerCountFromPreviousTrigger = frag.getLastTriggerNuMIOff();
         break;
@@ -598,12 +556,12 @@ namespace daq
     } // switch gate type
     
     fTriggerExtra->sourceType = beamGateBit;
-    fTriggerExtra->triggerType = static_cast<sbn::triggerType>(datastream_info.trigger_type);
+    fTriggerExtra->triggerType = static_cast<sbn::triggerType>(triggerData.triggerType);
     fTriggerExtra->triggerTimestamp = artdaq_ts;
     fTriggerExtra->beamGateTimestamp = beamgate_ts;
     fTriggerExtra->enableGateTimestamp = enablegate_ts;
-    fTriggerExtra->triggerID = datastream_info.wr_event_no; //all triggers (event ID)
-    fTriggerExtra->gateID = datastream_info.gate_id; //all gate types (gate ID)
+    fTriggerExtra->triggerID = triggerData.WRtrigger.count; //all triggers (event ID)
+    fTriggerExtra->gateID = triggerData.gateID; //all gate types (gate ID)
     fTriggerExtra->anyGateCountFromAnyPreviousTrigger = frag.getDeltaGates();
     fTriggerExtra->anyPreviousTriggerTimestamp = frag.getLastTimestamp();
     sbn::triggerSource previousTriggerSourceBit;
@@ -624,7 +582,7 @@ namespace daq
     fTriggerExtra->WRtimeToTriggerTime = WRtimeToTriggerTime;
     sbn::bits::triggerLocationMask locationMask;
     // trigger location: 0x01=EAST; 0x02=WEST; 0x07=ALL
-    int const triggerLocation = parsedData.getItem("Trigger Source").getNumber<int>(0);
+    int const triggerLocation = triggerData.triggerSource;
     if(triggerLocation == 1)
       locationMask = mask(sbn::triggerLocation::CryoEast);
     else if(triggerLocation == 2)
@@ -632,23 +590,27 @@ namespace daq
     else if(triggerLocation == 7)
       locationMask = mask(sbn::triggerLocation::CryoEast, sbn::triggerLocation::CryoWest);
     fTriggerExtra->triggerLocationBits = locationMask;
+    auto const& eastData
+      = triggerData.cryostats[icarus::details::TriggerData::EastCryostat];
+    auto const& westData
+      = triggerData.cryostats[icarus::details::TriggerData::WestCryostat];
     fTriggerExtra->cryostats[sbn::ExtraTriggerInfo::EastCryostat]
       = {
       // triggerCount
       (fTriggerExtra->triggerID <= 1)
-      ? 0UL: parsedData.getItem("Cryo1 EAST counts").getNumber<unsigned long int>(0),
+      ? 0UL: requireValue(eastData.triggerCount, "Cryo1 EAST counts"),
       // LVDSstatus
       {
         (triggerLocation & 1) // EE
         ? encodeLVDSbits(
                          sbn::ExtraTriggerInfo::EastCryostat, 2, /* any of the connectors */
-                         parsedData.getItem("Cryo1 EAST Connector 2 and 3").getNumber<std::uint64_t>(0, 16)
+                         requireValue(eastData.connectors23, "Cryo1 EAST Connector 2 and 3")
                          )
         : 0ULL,
         (triggerLocation & 1) // EW
         ? encodeLVDSbits(
                          sbn::ExtraTriggerInfo::EastCryostat, 0, /* any of the connectors */
-                         parsedData.getItem("Cryo1 EAST Connector 0 and 1").getNumber<std::uint64_t>(0, 16)
+                         requireValue(eastData.connectors01, "Cryo1 EAST Connector 0 and 1")
                          )
         : 0ULL
       }
@@ -657,19 +619,19 @@ namespace daq
       = {
       // triggerCount
       (fTriggerExtra->triggerID <= 1)
-      ? 0UL: parsedData.getItem("Cryo2 WEST counts").getNumber<unsigned long int>(0),
+      ? 0UL: requireValue(westData.triggerCount, "Cryo2 WEST counts"),
       // LVDSstatus
       {
         (triggerLocation & 2) // WE
         ? encodeLVDSbits(
                          sbn::ExtraTriggerInfo::WestCryostat, 2, /* any of the connectors */
-                         parsedData.getItem("Cryo2 WEST Connector 2 and 3").getNumber<std::uint64_t>(0, 16)
+                         requireValue(westData.connectors23, "Cryo2 WEST Connector 2 and 3")
                          )
         : 0ULL,
         (triggerLocation & 2) // WW
         ? encodeLVDSbits(
                          sbn::ExtraTriggerInfo::WestCryostat, 0, /* any of the connectors */
-                         parsedData.getItem("Cryo2 WEST Connector 0 and 1").getNumber<std::uint64_t>(0, 16)
+                         requireValue(westData.connectors01, "Cryo2 WEST Connector 0 and 1")
                          )
         : 0ULL
       }
@@ -726,7 +688,7 @@ namespace daq
     // relative time trigger (raw::Trigger)
     //
     fRelTrigger->emplace_back(
-      static_cast<unsigned int>(datastream_info.wr_event_no), // counter
+      static_cast<unsigned int>(triggerData.WRtrigger.count), // counter
       fDetTimings.TriggerTime().value(),                      // trigger_time
       elecGateStart.value(),                                  // beamgate_time
       mask(beamGateBit)                                       // bits
@@ -794,6 +756,15 @@ namespace daq
   } // TriggerDecoder::simGateType()
   
   
+  template <typename T>
+  T TriggerDecoder::requireValue
+    (std::optional<T> const& value, std::string const& key)
+  {
+    if (value) return *value;
+    throw icarus::details::TriggerDataParser::ItemNotFound(key);
+  } // TriggerDecoder::requireValue()
+  
+  
   DEFINE_ART_CLASS_TOOL(TriggerDecoder)
 
 }
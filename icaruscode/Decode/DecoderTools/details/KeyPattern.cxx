@@ -0,0 +1,173 @@
+/**
+ * @file   icaruscode/Decode/DecoderTools/details/KeyPattern.cxx
+ * @brief  Matcher for the simple key patterns used in decoding.
+ * @date   October 18, 2026
+ * @see    icaruscode/Decode/DecoderTools/details/KeyPattern.h
+ */
+
+// library header
+#include "icaruscode/Decode/DecoderTools/details/KeyPattern.h"
+
+// C++ standard libraries
+#include <utility> // std::move()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Largest number of variants a pattern with alternatives may expand to.
+  constexpr std::size_t MaxVariants = 64;
+
+  /// Characters with a special meaning in ECMAScript regular expressions.
+  constexpr std::string_view SpecialChars = "^$\\.*+?()[]{}|";
+
+  /// Characters quantifying the preceding element.
+  constexpr std::string_view Quantifiers = "*+?{";
+
+  /// Whether `c` is not matched by `.` (ECMAScript line terminators).
+  constexpr bool isLineTerminator(char c) { return (c == '\n') || (c == '\r'); }
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+// ---  icarus::details::KeyPattern
+// -----------------------------------------------------------------------------
+icarus::details::KeyPattern::KeyPattern(std::string const& pattern) {
+  if (!compile(pattern)) {
+    fVariants.clear();
+    fRegex.emplace(pattern);
+  }
+} // icarus::details::KeyPattern::KeyPattern()
+
+
+// -----------------------------------------------------------------------------
+bool icarus::details::KeyPattern::match(std::string_view s) const {
+
+  if (fRegex) return std::regex_match(s.begin(), s.end(), *fRegex);
+
+  for (Variant_t const& variant: fVariants)
+    if (matchFrom(variant, 0, s)) return true;
+  return false;
+
+} // icarus::details::KeyPattern::match()
+
+
+// -----------------------------------------------------------------------------
+bool icarus::details::KeyPattern::compile(std::string_view pattern) {
+
+  // appends the element, merging consecutive literals
+  auto add = [](Variant_t& variant, Element::Kind kind, char c = '\0')
+    {
+      if ((kind == Element::Kind::Literal) && !variant.empty()
+        && (variant.back().kind == Element::Kind::Literal)
+      ) {
+        variant.back().text += c;
+        return;
+      }
+      variant.push_back({ kind, std::string{} });
+      if (kind == Element::Kind::Literal) variant.back().text += c;
+    };
+
+  // parses a single element at `pos` into `variant`; returns false on failure
+  auto parseElement = [pattern,&add](std::size_t& pos, Variant_t& variant)
+    {
+      char const c = pattern[pos++];
+      bool const next = pos < pattern.size();
+      if (c == '.') {
+        if (next && (pattern[pos] == '*')) {
+          ++pos;
+          add(variant, Element::Kind::AnySequence);
+        }
+        else add(variant, Element::Kind::AnyChar);
+      }
+      else if (c == '\\') {
+        if (!next || (SpecialChars.find(pattern[pos]) == std::string_view::npos))
+          return false; // character classes and other escapes not supported
+        add(variant, Element::Kind::Literal, pattern[pos++]);
+      }
+      else if (SpecialChars.find(c) != std::string_view::npos) return false;
+      else add(variant, Element::Kind::Literal, c);
+
+      // a quantifier on anything but `.*` is not supported
+      return (pos >= pattern.size())
+        || (Quantifiers.find(pattern[pos]) == std::string_view::npos);
+    };
+
+  // parses a group of alternatives starting at `pos` (on the parenthesis)
+  auto parseGroup = [pattern,&parseElement]
+    (std::size_t& pos, std::vector<Variant_t>& alternatives)
+    {
+      ++pos;
+      while (true) {
+        if (pos >= pattern.size()) return false; // unterminated group
+        char const c = pattern[pos];
+        if (c == ')') { ++pos; break; }
+        if (c == '|') { ++pos; alternatives.emplace_back(); continue; }
+        if (c == '(') return false; // nested groups not supported
+        if (!parseElement(pos, alternatives.back())) return false;
+      } // while
+      // quantified groups are not supported
+      return (pos >= pattern.size())
+        || (Quantifiers.find(pattern[pos]) == std::string_view::npos);
+    };
+
+  fVariants.assign(1U, Variant_t{});
+  std::size_t pos = 0;
+  while (pos < pattern.size()) {
+
+    std::vector<Variant_t> alternatives(1U);
+    if (pattern[pos] != '(') {
+      // a single element, common to all variants
+      if (!parseElement(pos, alternatives.back())) return false;
+    }
+    else if (!parseGroup(pos, alternatives)) return false;
+
+    if (fVariants.size() * alternatives.size() > MaxVariants) return false;
+    std::vector<Variant_t> variants;
+    for (Variant_t const& head: fVariants) {
+      for (Variant_t const& alternative: alternatives) {
+        Variant_t variant = head;
+        for (Element const& elem: alternative) {
+          if (elem.kind != Element::Kind::Literal) variant.push_back(elem);
+          else for (char const c: elem.text) add(variant, elem.kind, c);
+        }
+        variants.push_back(std::move(variant));
+      } // for alternatives
+    } // for variants
+    fVariants = std::move(variants);
+
+  } // while
+
+  return true;
+} // icarus::details::KeyPattern::compile()
+
+
+// -----------------------------------------------------------------------------
+bool icarus::details::KeyPattern::matchFrom
+  (Variant_t const& variant, std::size_t iElem, std::string_view s)
+{
+  for (; iElem < variant.size(); ++iElem) {
+    Element const& elem = variant[iElem];
+    switch (elem.kind) {
+      case Element::Kind::Literal:
+        if (s.substr(0, elem.text.size()) != elem.text) return false;
+        s.remove_prefix(elem.text.size());
+        break;
+      case Element::Kind::AnyChar:
+        if (s.empty() || isLineTerminator(s.front())) return false;
+        s.remove_prefix(1);
+        break;
+      case Element::Kind::AnySequence:
+        // try all the lengths (`.*` can't cross a line terminator)
+        for (std::size_t n = 0; ; ++n) {
+          if (matchFrom(variant, iElem + 1, s.substr(n))) return true;
+          if ((n == s.size()) || isLineTerminator(s[n])) return false;
+        }
+    } // switch
+  } // for
+  return s.empty();
+} // icarus::details::KeyPattern::matchFrom()
+
+
+// -----------------------------------------------------------------------------
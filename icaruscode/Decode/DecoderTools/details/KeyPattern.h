@@ -0,0 +1,88 @@
+/**
+ * @file   icaruscode/Decode/DecoderTools/details/KeyPattern.h
+ * @brief  Matcher for the simple key patterns used in decoding.
+ * @date   October 18, 2026
+ * @see    icaruscode/Decode/DecoderTools/details/KeyPattern.cxx
+ */
+
+#ifndef ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_KEYPATTERN_H
+#define ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_KEYPATTERN_H
+
+// C++ standard libraries
+#include <regex>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::details { class KeyPattern; }
+/**
+ * @class icarus::details::KeyPattern
+ * @brief Matches whole strings against a regular expression pattern.
+ *
+ * This object behaves like `std::regex_match()` with a ECMAScript regular
+ * expression, but the patterns actually used to recognize keys in trigger
+ * strings and configuration names are matched by a hand-written matcher
+ * which does not allocate memory.
+ * The supported syntax is:
+ * * literal characters (special characters can be escaped by `\`);
+ * * `.` matching any character but a line terminator;
+ * * `.*` matching any sequence of those characters;
+ * * groups of alternatives, e.g. `(EAST|WEST)`, not nested.
+ *
+ * Patterns with any other syntax, and patterns specified as `std::regex`,
+ * are matched with `std::regex_match()`.
+ */
+class icarus::details::KeyPattern {
+
+    public:
+
+  /// Constructor: parses the `pattern` (regular expression syntax).
+  KeyPattern(std::string const& pattern);
+  KeyPattern(char const* pattern): KeyPattern(std::string{ pattern }) {}
+
+  /// Constructor: always uses the regular expression library.
+  KeyPattern(std::regex pattern): fRegex(std::move(pattern)) {}
+
+  /// Returns whether the whole `s` matches the pattern.
+  bool match(std::string_view s) const;
+
+  /// Returns whether the whole `s` matches the pattern.
+  bool operator() (std::string_view s) const { return match(s); }
+
+  /// Returns whether the matching is delegated to `std::regex`.
+  bool usesRegex() const { return fRegex.has_value(); }
+
+    private:
+
+  /// An element of a pattern without alternatives.
+  struct Element {
+    enum class Kind { Literal, AnyChar, AnySequence };
+    Kind kind;
+    std::string text; ///< Content of a `Literal` element.
+  }; // Element
+
+  using Variant_t = std::vector<Element>;
+
+  /// All the patterns without alternatives equivalent to the original one.
+  std::vector<Variant_t> fVariants;
+
+  /// Regular expression, used when the pattern is not supported.
+  std::optional<std::regex> fRegex;
+
+  /// Parses `pattern` into `fVariants`; returns `false` if not supported.
+  bool compile(std::string_view pattern);
+
+  /// Returns whether `s` matches the elements from `iElem` on of `variant`.
+  static bool matchFrom
+    (Variant_t const& variant, std::size_t iElem, std::string_view s);
+
+}; // icarus::details::KeyPattern
+
+
+// -----------------------------------------------------------------------------
+
+
+#endif // ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_KEYPATTERN_H
@@ -33,8 +33,6 @@ void icarus::details::KeyedCSVparser::parse
     
     auto const token = extractToken(stream);
     
-    std::string tokenStr { cbegin(token), cend(token) };
-    
     bool bKey = false;
     do {
       
@@ -51,23 +49,23 @@ void icarus::details::KeyedCSVparser::parse
       // the token may still be a key (if `bKey` is true, it is for sure: we can
       // decide that a non-key (!bKey) is actually a key, but not the opposite)
       for (auto const& [ pattern, values ]: fPatterns) {
-        if (!std::regex_match(begin(token), end(token), pattern)) continue;
+        if (!pattern.match(token)) continue;
         bKey = true; // matching a pattern implies this is a key
-        std::string const& key = tokenStr;
+        SubBuffer_t const& key = token;
         // how many values to expect:
         switch (values) {
           case FixedSize: // read the next token immediately as fixed size
             {
-              if (stream.empty()) throw MissingSize(key);
+              if (stream.empty()) throw MissingSize(std::string{ key });
               
               auto const sizeToken = peekToken(stream);
-              if (empty(sizeToken)) throw MissingSize(key);
+              if (empty(sizeToken)) throw MissingSize(std::string{ key });
               
               // the value is loaded in `forcedValues` and already excludes
               // the size token just read
               char const *b = begin(sizeToken), *e = end(sizeToken);
               if (std::from_chars(b, e, forcedValues).ptr != e)
-                throw MissingSize(key, std::string{ sizeToken });
+                throw MissingSize(std::string{ key }, std::string{ sizeToken });
               
               ++forcedValues; // the size will be forced in the values anyway
               
@@ -89,14 +87,14 @@ void icarus::details::KeyedCSVparser::parse
       
     } while (false);
     
-    if (bKey) currentItem = &(data.makeItem(std::move(tokenStr)));
+    // the only copies of the token are the ones stored in `data`
+    if (bKey) currentItem = &(data.makeItem(std::string{ token }));
     else {
       if (!currentItem) {
-        throw InvalidFormat(
-         "values started without a key ('" + tokenStr + "' is not a valid key)."
-         );
+        throw InvalidFormat("values started without a key ('"
+          + std::string{ token } + "' is not a valid key).");
       }
-      currentItem->addValue(std::move(tokenStr));
+      currentItem->addValue(std::string{ token });
     }
     
   } // while
@@ -125,7 +123,7 @@ auto icarus::details::KeyedCSVparser::addPatterns
   -> KeyedCSVparser&
 {
   for (auto& pattern: patterns)
-    fPatterns.emplace_back(std::regex{ pattern.first }, pattern.second);
+    fPatterns.emplace_back(pattern.first, pattern.second);
   return *this;
 } // icarus::details::KeyedCSVparser::addPatterns()
 
@@ -11,6 +11,7 @@
 
 // ICARUS libraries
 #include "icaruscode/Decode/DecoderTools/details/KeyValuesData.h"
+#include "icaruscode/Decode/DecoderTools/details/KeyPattern.h"
 
 // C++ standard libraries
 #include <iosfwd> // std::ostream
@@ -64,6 +65,11 @@ namespace icarus::details { class KeyedCSVparser; }
  *   );
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * will return `data` with 6 items.
+ * 
+ * The parser does not use regular expression library for the common pattern
+ * syntax (see `icarus::details::KeyPattern`), and the tokens are handled as
+ * views into the original buffer: memory is allocated only for the returned
+ * `KeyValuesData`.
  */
 class icarus::details::KeyedCSVparser {
   
@@ -128,6 +134,9 @@ class icarus::details::KeyedCSVparser {
    *   interpreted as a key though.
    * 
    * Patterns are considered in the order they were added.
+   * 
+   * Patterns specified as strings are matched without the regular expression
+   * library when their syntax allows it (see `icarus::details::KeyPattern`).
    */
   /// @{
   
@@ -141,7 +150,7 @@ class icarus::details::KeyedCSVparser {
   KeyedCSVparser& addPattern(std::regex pattern, unsigned int values)
     { fPatterns.emplace_back(std::move(pattern), values); return *this; }
   KeyedCSVparser& addPattern(std::string const& pattern, unsigned int values)
-    { return addPattern(std::regex{ pattern }, values); }
+    { fPatterns.emplace_back(pattern, values); return *this; }
   //@}
   
   //@{
@@ -167,7 +176,7 @@ class icarus::details::KeyedCSVparser {
   char const fSep = ','; ///< Character used as token separator.
   
   /// List of known patterns for matching keys, and how many values they hold.
-  std::vector<std::pair<std::regex, unsigned int>> fPatterns;
+  std::vector<std::pair<KeyPattern, unsigned int>> fPatterns;
   
   /// Returns the length of the next toke, up to the next separator (excluded).
   std::size_t findTokenLength(Buffer_t const& buffer) const noexcept;
@@ -0,0 +1,175 @@
+/**
+ * @file   icaruscode/Decode/DecoderTools/details/TPCDecoderUtils.h
+ * @brief  Some helpers for TPC decoder modules.
+ * @date   October 18, 2026
+ */
+
+#ifndef ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_TPCDECODERUTILS_H
+#define ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_TPCDECODERUTILS_H
+
+
+// TBB libraries
+#include "tbb/concurrent_vector.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::find(), std::stable_sort()
+#include <atomic>
+#include <iterator> // std::make_move_iterator()
+#include <memory> // std::unique_ptr
+#include <utility> // std::move()
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace daq::details {
+
+  template <typename T>
+  class ChannelSlotCollection;
+
+  /**
+   * @brief Converts `n` samples from `source` into ADC counts into `dest`.
+   *
+   * The result is the same as `short(std::round(source[i]))` (rounding half
+   * away from zero) for all values within the range of `short int`, but the
+   * loop does not call `std::round()` and the compiler can vectorize it.
+   */
+  inline void roundToADC(float const* source, std::size_t n, short* dest)
+    {
+      for (std::size_t i = 0; i < n; ++i) {
+        int const truncated = static_cast<int>(source[i]);
+        float const fraction = source[i] - truncated; // exact
+        dest[i] = static_cast<short>
+          (truncated + (fraction >= 0.5f) - (fraction <= -0.5f));
+      }
+    } // roundToADC()
+
+
+  /**
+   * @brief Adds to `ROIs` the `samples` in each run of `true` in `mask`.
+   * @tparam Mask type of the mask (e.g. `std::vector<bool>`)
+   * @tparam Samples type of the sample collection (random access)
+   * @tparam ROIs type of `lar::sparse_vector` of the regions of interest
+   *
+   * Each run of consecutive `true` elements of `mask` becomes a region of
+   * interest starting at the same position, with the content of `samples`
+   * copied directly from the range.
+   */
+  template <typename Mask, typename Samples, typename ROIs>
+  void addMaskedRanges(Mask const& mask, Samples const& samples, ROIs& rois)
+    {
+      auto const begin = mask.begin();
+      auto const end = mask.end();
+      auto const data = samples.begin();
+
+      auto runStart = std::find(begin, end, true);
+      while (runStart != end) {
+        auto const runEnd = std::find(runStart, end, false);
+        std::size_t const first = std::distance(begin, runStart);
+        std::size_t const last = std::distance(begin, runEnd);
+        rois.add_range(first, data + first, data + last);
+        runStart = std::find(runEnd, end, true);
+      } // while
+    } // addMaskedRanges()
+
+
+} // namespace daq::details
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Collection of one object per channel, filled concurrently.
+ * @tparam T type of object (must have a `Channel()` method)
+ *
+ * The collection has one slot for each channel ID, allocated once and reused
+ * event after event. Threads store their objects directly in the slot of
+ * their channel, and `extract()` returns them already sorted by channel.
+ * Objects with a channel beyond the table, or with a channel already filled,
+ * are kept aside and merged in channel order on extraction.
+ * If the filling is interrupted (e.g. by an exception), `clear()` discards
+ * whatever was stored before the collection is used again.
+ */
+template <typename T>
+class daq::details::ChannelSlotCollection {
+
+    public:
+
+  /// Constructor: slots for channels from `0` to `nChannels - 1`.
+  explicit ChannelSlotCollection(std::size_t nChannels = 0U)
+    { resize(nChannels); }
+
+  /// Sets the number of slots; must not be called while filling.
+  void resize(std::size_t nChannels)
+    {
+      fSlots.resize(nChannels);
+      fFilled = std::make_unique<std::atomic<bool>[]>(nChannels);
+      for (std::size_t i = 0; i < nChannels; ++i) fFilled[i] = false;
+    }
+
+  /// Returns the number of slots.
+  std::size_t nSlots() const { return fSlots.size(); }
+
+  /// Discards all the stored objects (not thread safe).
+  void clear()
+    {
+      for (std::size_t i = 0; i < fSlots.size(); ++i) {
+        if (!fFilled[i]) continue;
+        fSlots[i] = T{}; // release the content
+        fFilled[i] = false;
+      }
+      fOverflow.clear();
+    }
+
+  /// Stores `object` in the slot for `channel`; thread safe.
+  /// @return the stored object
+  T& put(std::size_t channel, T&& object)
+    {
+      if ((channel < fSlots.size()) && !fFilled[channel].exchange(true)) {
+        fSlots[channel] = std::move(object);
+        return fSlots[channel];
+      }
+      return *fOverflow.push_back(std::move(object));
+    }
+
+  /// Moves all the stored objects out, sorted by channel, and empties the
+  /// collection (not thread safe).
+  std::vector<T> extract()
+    {
+      std::vector<T> extra { std::make_move_iterator(fOverflow.begin()),
+                             std::make_move_iterator(fOverflow.end()) };
+      fOverflow.clear();
+      std::stable_sort(extra.begin(), extra.end(),
+        [](T const& a, T const& b){ return a.Channel() < b.Channel(); });
+
+      std::size_t nFilled = 0U;
+      for (std::size_t i = 0; i < fSlots.size(); ++i) nFilled += fFilled[i];
+
+      std::vector<T> objects;
+      objects.reserve(nFilled + extra.size());
+      auto itExtra = extra.begin();
+      for (std::size_t channel = 0; channel < fSlots.size(); ++channel) {
+        if (!fFilled[channel]) continue;
+        while ((itExtra != extra.end()) && (itExtra->Channel() < channel))
+          objects.push_back(std::move(*itExtra++));
+        objects.push_back(std::move(fSlots[channel]));
+        fSlots[channel] = T{}; // release the content
+        fFilled[channel] = false;
+      } // for
+      objects.insert(objects.end(), std::make_move_iterator(itExtra),
+        std::make_move_iterator(extra.end()));
+
+      return objects;
+    } // extract()
+
+    private:
+
+  std::vector<T> fSlots; ///< One object per channel.
+  std::unique_ptr<std::atomic<bool>[]> fFilled; ///< Whether each slot is set.
+  tbb::concurrent_vector<T> fOverflow; ///< Objects not fitting in the slots.
+
+}; // class daq::details::ChannelSlotCollection
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_TPCDECODERUTILS_H
@@ -0,0 +1,262 @@
+/**
+ * @file   icaruscode/Decode/DecoderTools/details/TriggerDataParser.cxx
+ * @brief  Single-pass parser of the trigger data packet string.
+ * @date   October 18, 2026
+ * @see    icaruscode/Decode/DecoderTools/details/TriggerDataParser.h
+ */
+
+// library header
+#include "icaruscode/Decode/DecoderTools/details/TriggerDataParser.h"
+
+// C++ standard libraries
+#include <algorithm> // std::min()
+#include <bitset>
+#include <ostream>
+#include <iomanip> // std::setw(), std::setfill()
+#include <stdexcept> // std::logic_error
+#include <charconv> // std::from_chars()
+#include <cctype> // std::isalpha(), std::isspace()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Characters terminating the parsed line.
+  constexpr std::string_view LineEnd { "\0\n\r", 3U };
+
+  /// Returns `s` without heading and trailing spaces.
+  std::string_view strip(std::string_view s) {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())))
+      s.remove_prefix(1);
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))
+      s.remove_suffix(1);
+    return s;
+  } // strip()
+
+  /// Removes and returns the next stripped token from `s`.
+  std::string_view extractToken(std::string_view& s, char sep = ',') {
+    std::size_t const length = std::min(s.find(sep), s.size());
+    std::string_view const token = s.substr(0, length);
+    s.remove_prefix(std::min(length + 1, s.size()));
+    return strip(token);
+  } // extractToken()
+
+  /// Returns whether `token` has the form of a key.
+  bool isKey(std::string_view token) {
+    return
+      !token.empty() && std::isalpha(static_cast<unsigned char>(token.front()));
+  } // isKey()
+
+  /// Prints a timestamp in seconds.
+  void printTime(std::ostream& out, std::uint64_t timestamp) {
+    out << (timestamp / 1'000'000'000) << "." << std::setfill('0')
+      << std::setw(9) << (timestamp % 1'000'000'000) << std::setfill(' ');
+  } // printTime()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+// ---  icarus::details::TriggerDataParser
+// -----------------------------------------------------------------------------
+template <auto Stamp>
+auto icarus::details::TriggerDataParser::timestampFields()
+  -> std::vector<Field_t>
+{
+  return {
+      { [](TriggerData& d, std::uint64_t v){ stamp(d.*Stamp).count = v; } }
+    , { [](TriggerData& d, std::uint64_t v){ stamp(d.*Stamp).seconds = v; } }
+    , { [](TriggerData& d, std::uint64_t v){ stamp(d.*Stamp).nanoseconds = v; } }
+    };
+} // icarus::details::TriggerDataParser::timestampFields()
+
+
+// -----------------------------------------------------------------------------
+icarus::details::TriggerDataParser::TriggerDataParser() {
+
+  using Data = TriggerData;
+  constexpr bool Required = true;
+  constexpr int Hex = 16;
+
+  addItem({ "WR_TS1" }, timestampFields<&Data::WRtrigger>(), Required);
+  addItem({ "Enable_TS" }, timestampFields<&Data::enableGate>());
+  addItem({ "Beam_TS" }, timestampFields<&Data::beamGate>());
+
+  addItem({ "Gate ID" },
+    { { [](Data& d, std::uint64_t v){ d.gateID = v; } } }, Required);
+  addItem({ "Gate Type" },
+    { { [](Data& d, std::uint64_t v){ d.gateType = v; } } }, Required);
+  addItem({ "Trigger Type" },
+    { { [](Data& d, std::uint64_t v){ d.triggerType = v; } } }, Required);
+  addItem({ "Trigger Source" },
+    { { [](Data& d, std::uint64_t v){ d.triggerSource = v; } } }, Required);
+
+  addItem({ "Gate ID BNB", "BNB Gate ID" },
+    { { [](Data& d, std::uint64_t v){ d.gateIDBNB = v; } } });
+  addItem({ "Gate ID NuMI", "NuMI Gate ID" },
+    { { [](Data& d, std::uint64_t v){ d.gateIDNuMI = v; } } });
+  addItem({ "Gate ID BNBOff", "Offbeam BNB Gate ID" },
+    { { [](Data& d, std::uint64_t v){ d.gateIDOffbeamBNB = v; } } });
+  addItem({ "Gate ID NuMIOff", "Offbeam NuMI Gate ID" },
+    { { [](Data& d, std::uint64_t v){ d.gateIDOffbeamNuMI = v; } } });
+
+  addItem({ "Cryo1 EAST counts" }, { { [](Data& d, std::uint64_t v)
+    { d.cryostats[Data::EastCryostat].triggerCount = v; } } });
+  addItem({ "Cryo2 WEST counts" }, { { [](Data& d, std::uint64_t v)
+    { d.cryostats[Data::WestCryostat].triggerCount = v; } } });
+
+  // early data used "Cryo." for both cryostats
+  addItem(
+    { "Cryo1 EAST Connector 0 and 1", "Cryo. EAST Connector 0 and 1" },
+    { { [](Data& d, std::uint64_t v)
+      { d.cryostats[Data::EastCryostat].connectors01 = v; }, Hex } }
+    );
+  addItem(
+    { "Cryo1 EAST Connector 2 and 3", "Cryo. EAST Connector 2 and 3" },
+    { { [](Data& d, std::uint64_t v)
+      { d.cryostats[Data::EastCryostat].connectors23 = v; }, Hex } }
+    );
+  addItem(
+    { "Cryo2 WEST Connector 0 and 1", "Cryo. WEST Connector 0 and 1" },
+    { { [](Data& d, std::uint64_t v)
+      { d.cryostats[Data::WestCryostat].connectors01 = v; }, Hex } }
+    );
+  addItem(
+    { "Cryo2 WEST Connector 2 and 3", "Cryo. WEST Connector 2 and 3" },
+    { { [](Data& d, std::uint64_t v)
+      { d.cryostats[Data::WestCryostat].connectors23 = v; }, Hex } }
+    );
+
+} // icarus::details::TriggerDataParser::TriggerDataParser()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::TriggerDataParser::parse
+  (std::string_view s, TriggerData& data) const
+{
+  // only the first line is parsed
+  s = s.substr(0, std::min(s.find_first_of(LineEnd), s.size()));
+
+  std::bitset<MaxItems> found;
+  std::string_view currentKey;
+  KeyInfo_t const* current = nullptr; // `nullptr` if key is unknown
+  std::size_t nextValue = 0;
+
+  while (!s.empty()) {
+
+    std::string_view const token = extractToken(s);
+
+    // values pending for a known key are assigned regardless of their form
+    if (current && (nextValue < current->values.size())) {
+      Field_t const& field = current->values[nextValue++];
+      std::uint64_t value = 0;
+      char const *b = token.data(), *e = b + token.size();
+      if (token.empty() || (std::from_chars(b, e, value, field.base).ptr != e))
+      {
+        throw ConversionFailed{
+          std::string{ currentKey } + "[" + std::to_string(nextValue - 1) + "]",
+          std::string{ token }, "integer"
+          };
+      }
+      field.set(data, value);
+      continue;
+    } // if value of known key
+
+    if (!isKey(token)) {
+      if (currentKey.empty()) {
+        throw InvalidFormat("values started without a key ('"
+          + std::string{ token } + "' is not a valid key).");
+      }
+      continue; // values of unknown keys, or additional ones, are ignored
+    }
+
+    currentKey = token;
+    nextValue = 0;
+    auto const itKey = fKeys.find(token);
+    if (itKey == fKeys.end()) {
+      current = nullptr;
+      continue;
+    }
+    current = &(itKey->second);
+    if (found.test(current->item)) throw DuplicateKey{ std::string{ token } };
+    found.set(current->item);
+
+  } // while
+
+  if (current && (nextValue < current->values.size())) {
+    throw MissingValues{
+      std::string{ currentKey },
+      static_cast<unsigned int>(current->values.size() - nextValue)
+      };
+  }
+
+  for (std::size_t item = 0; item < fItemNames.size(); ++item) {
+    if (fRequired[item] && !found.test(item))
+      throw ItemNotFound{ fItemNames[item] };
+  }
+
+} // icarus::details::TriggerDataParser::parse()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::TriggerDataParser::addItem(
+  std::vector<std::string> const& keys, std::vector<Field_t> values,
+  bool required /* = false */
+) {
+  std::size_t const item = fItemNames.size();
+  if (item >= MaxItems) {
+    throw std::logic_error("TriggerDataParser supports at most "
+      + std::to_string(MaxItems) + " items.");
+  }
+
+  fItemNames.push_back(keys.front());
+  fRequired.push_back(required);
+  for (std::string const& key: keys)
+    fKeys.emplace(key, KeyInfo_t{ item, values });
+
+} // icarus::details::TriggerDataParser::addItem()
+
+
+// -----------------------------------------------------------------------------
+// ---  icarus::details::TriggerData
+// -----------------------------------------------------------------------------
+std::ostream& icarus::details::operator<<
+  (std::ostream& out, TriggerData const& data)
+{
+  auto const printStamp
+    = [&out](char const* name, TriggerData::CountedTimestamp_t const& stamp)
+    {
+      out << "\n  " << name << " #" << stamp.count << " at ";
+      printTime(out, stamp.timestamp());
+      out << " s";
+    };
+
+  out << "event " << data.WRtrigger.count << ", gate #" << data.gateID
+    << " of type " << data.gateType << ", trigger type " << data.triggerType
+    << ", source 0x" << std::hex << data.triggerSource << std::dec;
+  printStamp("trigger", data.WRtrigger);
+  if (data.beamGate) printStamp("beam gate", *data.beamGate);
+  if (data.enableGate) printStamp("enable gate", *data.enableGate);
+  out << "\n  gates: BNB " << data.gateIDBNB << ", NuMI " << data.gateIDNuMI
+    << ", off-beam BNB " << data.gateIDOffbeamBNB
+    << ", off-beam NuMI " << data.gateIDOffbeamNuMI;
+
+  char const* const CryoNames[] = { "east", "west" };
+  for (std::size_t cryo = 0; cryo < data.cryostats.size(); ++cryo) {
+    TriggerData::CryostatData_t const& cryoData = data.cryostats[cryo];
+    out << "\n  " << CryoNames[cryo] << " cryostat:";
+    if (cryoData.triggerCount)
+      out << " " << *cryoData.triggerCount << " triggers;";
+    out << std::hex << std::setfill('0');
+    if (cryoData.connectors01)
+      out << " connectors 0-1: 0x" << std::setw(16) << *cryoData.connectors01;
+    if (cryoData.connectors23)
+      out << " connectors 2-3: 0x" << std::setw(16) << *cryoData.connectors23;
+    out << std::dec << std::setfill(' ');
+  } // for
+
+  return out;
+} // icarus::details::operator<< (TriggerData)
+
+
+// -----------------------------------------------------------------------------
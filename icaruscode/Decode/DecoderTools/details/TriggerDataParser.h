@@ -0,0 +1,206 @@
+/**
+ * @file   icaruscode/Decode/DecoderTools/details/TriggerDataParser.h
+ * @brief  Single-pass parser of the trigger data packet string.
+ * @date   October 18, 2026
+ * @see    icaruscode/Decode/DecoderTools/details/TriggerDataParser.cxx
+ */
+
+#ifndef ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_TRIGGERDATAPARSER_H
+#define ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_TRIGGERDATAPARSER_H
+
+// ICARUS libraries
+#include "icaruscode/Decode/DecoderTools/details/KeyedCSVparser.h"
+#include "icaruscode/Decode/DecoderTools/details/KeyValuesData.h"
+
+// C++ standard libraries
+#include <iosfwd> // std::ostream
+#include <array>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional> // std::less<>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::details {
+  struct TriggerData;
+  class TriggerDataParser;
+
+  /// Prints the content of the trigger `data` into the stream `out`.
+  std::ostream& operator<< (std::ostream& out, TriggerData const& data);
+} // namespace icarus::details
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Content of the trigger data packet string.
+ *
+ * All the information from the string used by the trigger decoder is stored
+ * here already converted into its type.
+ * Timestamps are the raw ones, as written in the string.
+ *
+ * Items which may be legitimately missing are `std::optional`; the others are
+ * required by the parser, except for the gate counts of each gate type, which
+ * are left `0` when not present.
+ */
+struct icarus::details::TriggerData {
+
+  /// A counter with the time (seconds and nanoseconds) of its last increment.
+  struct CountedTimestamp_t {
+    unsigned long int count = 0UL;
+    unsigned int seconds = 0U;
+    unsigned int nanoseconds = 0U;
+
+    /// Returns the time as a single count of nanoseconds.
+    std::uint64_t timestamp() const
+      { return seconds * 1'000'000'000ULL + nanoseconds; }
+  }; // CountedTimestamp_t
+
+  /// Trigger information from a cryostat.
+  struct CryostatData_t {
+    /// Triggers in the cryostat within the trigger window.
+    std::optional<unsigned long int> triggerCount;
+    /// LVDS status of the connectors 0 and 1 (`Cryo# XXXX Connector 0 and 1`).
+    std::optional<std::uint64_t> connectors01;
+    /// LVDS status of the connectors 2 and 3 (`Cryo# XXXX Connector 2 and 3`).
+    std::optional<std::uint64_t> connectors23;
+  }; // CryostatData_t
+
+  static constexpr std::size_t EastCryostat = 0; ///< Index of `Cryo1 EAST`.
+  static constexpr std::size_t WestCryostat = 1; ///< Index of `Cryo2 WEST`.
+
+  CountedTimestamp_t WRtrigger; ///< Event number and time from White Rabbit.
+  std::optional<CountedTimestamp_t> enableGate; ///< Enable gate opening.
+  std::optional<CountedTimestamp_t> beamGate; ///< Beam gate (includes veto).
+
+  long int gateID = 0; ///< Count of gates of any type.
+  int gateType = 0; ///< Type of gate of this trigger.
+  int triggerType = 0; ///< Type of trigger logic.
+  int triggerSource = 0; ///< Cryostats that triggered (`0x1` east, `0x2` west).
+
+  long int gateIDBNB = 0; ///< Count of BNB gates.
+  long int gateIDNuMI = 0; ///< Count of NuMI gates.
+  long int gateIDOffbeamBNB = 0; ///< Count of off-beam BNB gates.
+  long int gateIDOffbeamNuMI = 0; ///< Count of off-beam NuMI gates.
+
+  /// Information per cryostat (`EastCryostat`, `WestCryostat`).
+  std::array<CryostatData_t, 2U> cryostats;
+
+}; // icarus::details::TriggerData
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @class icarus::details::TriggerDataParser
+ * @brief Parser filling a `TriggerData` record from the trigger string.
+ *
+ * The trigger string is a comma-separated list of keys, each followed by its
+ * values, like `"WR_TS1, 36, 1656000037, 537268790, Gate ID, 12, ..."`.
+ * This parser reads the string once, converting the values of the known keys
+ * directly into the fields of a `TriggerData` object; unknown keys and their
+ * values are skipped without being converted.
+ *
+ * The list of known keys, with the type, base and destination of each of
+ * their values, is resolved once, on construction. The parser object can then
+ * be used concurrently.
+ * A known key grabs as many following elements as its known values, whatever
+ * their content (so that hexadecimal values like the LVDS connector words are
+ * not mistaken for keys). Beyond these, like with `KeyedCSVparser`, elements
+ * are considered keys if they start with a letter and values otherwise.
+ *
+ * Some keys have alternative spellings, used in different versions of the
+ * trigger data format; each of them may appear at most once in a string.
+ * The parser throws an exception deriving from `Error` if the string is
+ * malformed: a value not convertible to its expected type
+ * (`ConversionFailed`), a missing value (`MissingValues`), a repeated key
+ * (`DuplicateKey`) or a missing required key (`ItemNotFound`).
+ *
+ * The string is parsed up to the first line terminator.
+ */
+class icarus::details::TriggerDataParser {
+
+    public:
+
+  using Error = KeyValuesData::Error;
+  using ConversionFailed = KeyValuesData::ConversionFailed;
+  using DuplicateKey = KeyValuesData::DuplicateKey;
+  using ItemNotFound = KeyValuesData::ItemNotFound;
+  using MissingValues = KeyedCSVparser::MissingValues;
+  using InvalidFormat = KeyedCSVparser::InvalidFormat;
+
+
+  /// Constructor: builds the table of the known keys.
+  TriggerDataParser();
+
+  //@{
+  /// Parses the string `s` and returns its content.
+  TriggerData parse(std::string_view s) const
+    { TriggerData data; parse(s, data); return data; }
+  TriggerData operator() (std::string_view s) const { return parse(s); }
+  //@}
+
+  /// Parses the string `s` and fills `data` with it.
+  void parse(std::string_view s, TriggerData& data) const;
+
+  /// Returns the number of recognised keys (including alternative spellings).
+  std::size_t nKeys() const { return fKeys.size(); }
+
+    private:
+
+  /// Function storing a `value` into its destination in `data`.
+  using Setter_t = void(*)(TriggerData& data, std::uint64_t value);
+
+  /// Destination of one value.
+  struct Field_t {
+    Setter_t set; ///< How to store the value.
+    int base = 10; ///< Numerical base of the value in the string.
+  }; // Field_t
+
+  /// Description of a known key.
+  struct KeyInfo_t {
+    std::size_t item; ///< Index of the item (shared by alternative spellings).
+    std::vector<Field_t> values; ///< Destination of each value, in order.
+  }; // KeyInfo_t
+
+  /// Largest number of distinct items.
+  static constexpr std::size_t MaxItems = 64U;
+
+  /// Known keys.
+  std::map<std::string, KeyInfo_t, std::less<>> fKeys;
+
+  /// Names of all the items (first spelling), by item index.
+  std::vector<std::string> fItemNames;
+
+  /// Whether each item is required.
+  std::vector<bool> fRequired;
+
+
+  /// Registers a new item with all its spellings.
+  void addItem(
+    std::vector<std::string> const& keys, std::vector<Field_t> values,
+    bool required = false
+    );
+
+  /// Returns the fields for the `CountedTimestamp_t` member `Stamp`.
+  template <auto Stamp>
+  static std::vector<Field_t> timestampFields();
+
+  //@{
+  /// Returns the timestamp `s`, creating it if needed.
+  static TriggerData::CountedTimestamp_t& stamp
+    (TriggerData::CountedTimestamp_t& s) { return s; }
+  static TriggerData::CountedTimestamp_t& stamp
+    (std::optional<TriggerData::CountedTimestamp_t>& s)
+    { return s? *s: s.emplace(); }
+  //@}
+
+}; // icarus::details::TriggerDataParser
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_TRIGGERDATAPARSER_H
@@ -63,14 +63,19 @@
  *  The units in LArSoft are cm for distances and ns for time.
  *  The use of `TLorentzVector` below does not imply space and time have the same units
  *   (do not use `TLorentzVector::Boost()`).
+ *
+ *  The input file is read via `evgen::HepMCFileReader`, which indexes all the
+ *  events in it at the beginning of the job. Events are then read in sequence
+ *  starting from the one at position `SkipEvents` in the file (default: `0`,
+ *  the first one), which allows jobs to process different portions of the
+ *  same file. Asking for more events than the file has left after the skipped
+ *  ones is an error (`cet::exception`): events are never read twice.
  */
+#include "icaruscode/Generators/HepMCFileReader.h"
 #include <string>
-#include <fstream>
+#include <vector>
+#include <memory>
 #include <math.h>
-#include <map>
-#include <iomanip>
-#include <algorithm>
-#include <sstream>
 #include <glob.h>
 #include <cstdlib>  // for unsetenv()
 #include "art/Framework/Core/EDProducer.h"
@@ -106,9 +111,12 @@ public:
   void beginRun(art::Run & run)                   override;
   void endSubRun(art::SubRun& sr)     override;
 private:
-  std::ifstream open_file();
+  std::string find_input_file() const;
   std::string fInputFilePath; ///< Path to the HEPMC input file, relative to `FW_SEARCH_PATH`.
-  std::ifstream* fInputFile;
+  std::size_t fSkipEvents;    ///< Number of events to skip at the start of the file.
+  std::unique_ptr<HepMCFileReader> fInputFile; ///< Indexed input file.
+  std::size_t fNextEvent;     ///< Position in the file of the next event to read.
+  std::vector<HepMCFileReader::Particle> fParticles; ///< Particles of the current event.
   
   double         fEventsPerPOT;     ///< Number of events per POT (to be set)
   int            fEventsPerSubRun;  ///< Keeps track of the number of processed events per subrun
@@ -118,7 +126,8 @@ private:
 evgen::HepMCFileGen::HepMCFileGen(fhicl::ParameterSet const & p)
   : EDProducer{p}
   , fInputFilePath(p.get<std::string>("InputFilePath"))
-  , fInputFile(nullptr)
+  , fSkipEvents(p.get<std::size_t>("SkipEvents", 0))
+  , fNextEvent(0)
   , fEventsPerPOT{p.get<double>("EventsPerPOT", -1.)}
   , fEventsPerSubRun(0)
 {
@@ -128,15 +137,15 @@ evgen::HepMCFileGen::HepMCFileGen(fhicl::ParameterSet const & p)
 }
 //------------------------------------------------------------------------------
 
-std::ifstream evgen::HepMCFileGen::open_file()
+std::string evgen::HepMCFileGen::find_input_file() const
 {
   /*
    * The plan:
    *  1. expand the path in FW_SEARCH_PATH (only if relative path)
    *  2. copy it into scratch area (only if starts with `/pnfs`)
-   *  3. open the file (original or copy) and return the opened file
+   *  3. return the path of the file (original or copy)
    * 
-   * Throws a cet::exception if eventually file is not found.
+   * The file is opened (and checked) by the reader.
    */
   
   std::string fullFileName = fInputFilePath;
@@ -158,27 +167,33 @@ std::ifstream evgen::HepMCFileGen::open_file()
       << "IFDH fetch: '" << fInputFilePath << "' -> '" << fullFileName << "'";
   }
   
-  //
-  // attempt to open
-  //
   mf::LogDebug("HepMCFileGen")
     << "Reading input file '" << fInputFilePath << "' as:\n" << fullFileName;
-  std::ifstream inputFile(fullFileName);
-  if (inputFile) return inputFile;
-  
-  // all attempts failed, give up:
-  throw cet::exception("HepMCFileGen")
-    << "HEPMC input file '" << fInputFilePath << "' can't be opened.\n";
+  return fullFileName;
   
-} // evgen::HepMCFileGen::open_file()
+} // evgen::HepMCFileGen::find_input_file()
 
 
 
 //------------------------------------------------------------------------------
 void evgen::HepMCFileGen::beginJob()
 {
-  fInputFile = new std::ifstream(open_file());
+  fInputFile = std::make_unique<HepMCFileReader>(find_input_file());
   
+  if (fInputFile->nEvents() == 0) {
+    throw cet::exception("HepMCFileGen")
+      << "HEPMC input file '" << fInputFilePath << "' contains no event.\n";
+  }
+  if (fSkipEvents >= fInputFile->nEvents()) {
+    throw cet::exception("HepMCFileGen")
+      << "Requested to skip " << fSkipEvents << " events, but HEPMC input file '"
+      << fInputFilePath << "' has only " << fInputFile->nEvents() << ".\n";
+  }
+  fNextEvent = fSkipEvents;
+  
+  mf::LogInfo("HepMCFileGen")
+    << "HEPMC input file '" << fInputFilePath << "' has "
+    << fInputFile->nEvents() << " events; starting from #" << fNextEvent;
 }
 //------------------------------------------------------------------------------
 void evgen::HepMCFileGen::beginRun(art::Run& run)
@@ -199,72 +214,44 @@ void evgen::HepMCFileGen::endSubRun(art::SubRun& sr)
 //------------------------------------------------------------------------------
 void evgen::HepMCFileGen::produce(art::Event & e)
 {
-  // check that the file is still good
-  if( !fInputFile->good() || fInputFile->peek() == EOF) {
-    open_file();
-  }
-  if( !fInputFile->good() || fInputFile->peek() == EOF) {
-    throw cet::exception("HepMCFileGen") << "input text file "
-                                        << " cannot be read in produce().\n";
+  // events are never reused (they would duplicate the ones of other jobs)
+  if (fNextEvent >= fInputFile->nEvents()) {
+    throw cet::exception("HepMCFileGen")
+      << "All " << fInputFile->nEvents() << " events from HEPMC input file '"
+      << fInputFilePath << "' (starting from #" << fSkipEvents
+      << ") have been used: input file cannot be read in produce().\n";
   }
   std::unique_ptr< std::vector<simb::MCTruth> > truthcol(new std::vector<simb::MCTruth>);
   simb::MCTruth truth;
-  // declare the variables for reading in the event record
-  int            event          = 0;
-  unsigned short nParticles           = 0;
-  int            status         = 0;
-  int                   pdg            = 0;
-  int                   firstMother    = 0;
-  int                   secondMother   = 0;
-  int                   firstDaughter  = 0;
-  int                   secondDaughter = 0;
-  double          xMomentum      = 0.;
-  double          yMomentum           = 0.;
-  double          zMomentum           = 0.;
-  double          energy              = 0.;
-  double          mass                = 0.;
-  double          xPosition           = 0.;
-  double          yPosition           = 0.;
-  double          zPosition           = 0.;
-  double          time                = 0.;
   bool set_neutrino = false;
   // neutrino
   int ccnc = -1, mode = -1, itype = -1, target = -1, nucleon = -1, quark = -1;
   double w = -1, x = -1, y = -1, qsqr = -1;
-  // read in line to get event number and number of particles
-  std::string oneLine;
-  std::getline(*fInputFile, oneLine);
-  std::istringstream inputLine;
-  inputLine.str(oneLine);
-  inputLine >> event >> nParticles;
-  // now read in all the lines for the particles
+  // read the event number and all the particles
   // in this interaction. only particles with
   // status = 1 get tracked in Geant4. see GENIE GHepStatus
-  for(unsigned short i = 0; i < nParticles; ++i){
-    std::getline(*fInputFile, oneLine);
-    inputLine.clear();
-    inputLine.str(oneLine);
-    inputLine >> status >> pdg
-              >> firstMother >> secondMother >> firstDaughter >> secondDaughter
-              >> xMomentum   >> yMomentum    >> zMomentum     >> energy >> mass
-              >> xPosition   >> yPosition    >> zPosition     >> time;
-    std::cout<<"pdg_all"<<pdg<<"xmomentum_all"<<xMomentum<<"ymomentum_all"<<yMomentum<<"zposition_all"<<zPosition<<std::endl;
-    TLorentzVector pos(xPosition, yPosition, zPosition, time);
-    TLorentzVector mom(xMomentum, yMomentum, zMomentum, energy);
-    simb::MCParticle part(i, pdg, "primary", firstMother, mass, status);
+  int const event = fInputFile->readEvent(fNextEvent++, fParticles);
+  mf::LogDebug log("HepMCFileGen");
+  log << "Event " << event << " with " << fParticles.size() << " particles";
+  for(std::size_t i = 0; i < fParticles.size(); ++i){
+    HepMCFileReader::Particle const& p = fParticles[i];
+    TLorentzVector pos(p.xPosition, p.yPosition, p.zPosition, p.time);
+    TLorentzVector mom(p.xMomentum, p.yMomentum, p.zMomentum, p.energy);
+    simb::MCParticle part(i, p.pdg, "primary", p.firstMother, p.mass, p.status);
     part.AddTrajectoryPoint(pos, mom);
     //if (abs(pdg) == 18 || abs(pdg) == 12) 
-    if (abs(pdg) == 52 )  // Animesh made changes
+    if (abs(p.pdg) == 52 )  // Animesh made changes
 	{
       set_neutrino = true;
-      ccnc = firstDaughter; // for the neutrino we write ccnc in place of 1st daugther
-      mode = secondDaughter; // for the neutrino we write mode in place of 2nd daugther
+      ccnc = p.firstDaughter; // for the neutrino we write ccnc in place of 1st daugther
+      mode = p.secondDaughter; // for the neutrino we write mode in place of 2nd daugther
       itype = -1;
       target = nucleon = quark = w = x = y = qsqr = -1;
-     std::cout<<"pdg_mother"<<pdg<<"xmomentum_mother"<<xMomentum<<"ymomentum_mother"<<yMomentum<<"zposition_mother"<<zPosition<<std::endl;
     } 
     truth.Add(part);
-     std::cout << i << "  Particle added with Pdg " << part.PdgCode() << ", Mother " << part.Mother() << ", track id " << part.TrackId() << ", ene " << part.E() << std::endl;
+    log << "\n" << i << "  Particle added with Pdg " << part.PdgCode() << ", Mother " << part.Mother() << ", track id " << part.TrackId() << ", ene " << part.E()
+      << ", momentum (" << p.xMomentum << ", " << p.yMomentum << ", " << p.zMomentum << ")"
+      << ", z position " << p.zPosition;
   }
  
   if (set_neutrino) {
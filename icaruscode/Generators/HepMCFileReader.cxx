@@ -0,0 +1,278 @@
+/**
+ * @file   icaruscode/Generators/HepMCFileReader.cxx
+ * @brief  Indexed reader of the text (HEPEVT-like) files for `HepMCFileGen`.
+ * @date   October 18, 2026
+ * @see    icaruscode/Generators/HepMCFileReader.h
+ */
+
+// library header
+#include "icaruscode/Generators/HepMCFileReader.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <charconv> // std::from_chars()
+#include <system_error> // std::errc
+#include <utility> // std::exchange(), std::move()
+#include <cerrno>
+#include <cstdlib> // std::strtod()
+#include <cstring> // std::strerror()
+
+// POSIX
+#include <fcntl.h> // open()
+#include <sys/mman.h> // mmap(), munmap()
+#include <sys/stat.h> // fstat()
+#include <unistd.h> // close()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Returns the line starting at `pos` (without end of line characters),
+  /// and moves `pos` to the start of the next line.
+  std::string_view nextLine(std::string_view text, std::size_t& pos) {
+    std::size_t const start = pos;
+    std::size_t end = text.find('\n', start);
+    if (end == std::string_view::npos) end = pos = text.size();
+    else pos = end + 1;
+    if ((end > start) && (text[end - 1] == '\r')) --end;
+    return text.substr(start, end - start);
+  } // nextLine()
+
+
+  /// Returns whether the character separates fields.
+  constexpr bool isSpace(char c) { return (c == ' ') || (c == '\t'); }
+
+
+  /// Returns whether `line` has no field at all.
+  bool isBlank(std::string_view line) {
+    for (char const c: line) if (!isSpace(c) && (c != '\r')) return false;
+    return true;
+  } // isBlank()
+
+
+  /// Reads whitespace-separated numbers in sequence from a line.
+  class FieldParser {
+    char const* fPos;
+    char const* const fEnd;
+
+    /// Skips the separators; returns whether a field follows.
+    bool skipSpaces()
+      {
+        while ((fPos != fEnd) && isSpace(*fPos)) ++fPos;
+        return fPos != fEnd;
+      }
+
+    /// Moves past a successful conversion ending at `end`, if it ends a field.
+    bool accept(std::errc ec, char const* end)
+      {
+        if ((ec != std::errc{}) || ((end != fEnd) && !isSpace(*end)))
+          return false;
+        fPos = end;
+        return true;
+      }
+
+    /// Skips the optional `+` sign (accepted by streams, not by `from_chars`).
+    char const* numberStart() const
+      { return ((*fPos == '+') && (fPos + 1 != fEnd))? fPos + 1: fPos; }
+
+      public:
+    explicit FieldParser(std::string_view line)
+      : fPos(line.data()), fEnd(line.data() + line.size()) {}
+
+    /// Parses the next field as an integral number.
+    template <typename T>
+    bool next(T& value)
+      {
+        if (!skipSpaces()) return false;
+        auto const [ end, ec ] = std::from_chars(numberStart(), fEnd, value);
+        return accept(ec, end);
+      }
+
+    /// Parses the next field as a real number.
+    bool next(double& value)
+      {
+        if (!skipSpaces()) return false;
+#if defined(__cpp_lib_to_chars)
+        auto const [ end, ec ] = std::from_chars(numberStart(), fEnd, value);
+        return accept(ec, end);
+#else // no floating point support in std::from_chars()
+        // the mapped text is not null-terminated: copy the field
+        char buffer[64];
+        std::size_t length = 0;
+        for (char const* p = fPos; (p != fEnd) && !isSpace(*p); ++p) {
+          if (length + 1 == sizeof(buffer)) return false;
+          buffer[length++] = *p;
+        }
+        buffer[length] = '\0';
+        char* bufferEnd = nullptr;
+        errno = 0;
+        value = std::strtod(buffer, &bufferEnd);
+        if ((bufferEnd != buffer + length) || (length == 0) || (errno == ERANGE))
+          return false;
+        fPos += length;
+        return true;
+#endif // __cpp_lib_to_chars
+      }
+
+  }; // class FieldParser
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+evgen::HepMCFileReader::HepMCFileReader(std::string const& path)
+  : fPath(path)
+{
+  int const fd = ::open(fPath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw cet::exception("HepMCFileReader")
+      << "HEPMC input file '" << fPath << "' can't be opened: "
+      << std::strerror(errno) << "\n";
+  }
+
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) != 0) {
+    int const error = errno;
+    ::close(fd);
+    throw cet::exception("HepMCFileReader")
+      << "Can't determine the size of HEPMC input file '" << fPath << "': "
+      << std::strerror(error) << "\n";
+  }
+
+  fSize = static_cast<std::size_t>(fileStat.st_size);
+  if (fSize > 0) {
+    void* const data = ::mmap(nullptr, fSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      int const error = errno;
+      ::close(fd);
+      throw cet::exception("HepMCFileReader")
+        << "HEPMC input file '" << fPath << "' can't be mapped in memory: "
+        << std::strerror(error) << "\n";
+    }
+    fData = static_cast<char const*>(data);
+  }
+  ::close(fd); // the mapping stays valid
+
+  buildIndex();
+
+} // evgen::HepMCFileReader::HepMCFileReader()
+
+
+// -----------------------------------------------------------------------------
+evgen::HepMCFileReader::~HepMCFileReader() { unmap(); }
+
+
+// -----------------------------------------------------------------------------
+evgen::HepMCFileReader::HepMCFileReader(HepMCFileReader&& from) noexcept
+  : fPath(std::move(from.fPath))
+  , fData(std::exchange(from.fData, nullptr))
+  , fSize(std::exchange(from.fSize, 0))
+  , fEvents(std::move(from.fEvents))
+{}
+
+
+// -----------------------------------------------------------------------------
+auto evgen::HepMCFileReader::operator= (HepMCFileReader&& from) noexcept
+  -> HepMCFileReader&
+{
+  if (&from != this) {
+    unmap();
+    fPath = std::move(from.fPath);
+    fData = std::exchange(from.fData, nullptr);
+    fSize = std::exchange(from.fSize, 0);
+    fEvents = std::move(from.fEvents);
+  }
+  return *this;
+} // evgen::HepMCFileReader::operator= ()
+
+
+// -----------------------------------------------------------------------------
+int evgen::HepMCFileReader::readEvent
+  (std::size_t iEvent, std::vector<Particle>& particles) const
+{
+  if (iEvent >= fEvents.size()) {
+    throw cet::exception("HepMCFileReader")
+      << "Requested event #" << iEvent << " from HEPMC input file '" << fPath
+      << "', which has only " << fEvents.size() << " events.\n";
+  }
+  EventIndex const& event = fEvents[iEvent];
+
+  std::string_view const text = content();
+  std::size_t pos = event.offset;
+
+  particles.resize(event.nParticles);
+  for (std::size_t iPart = 0; iPart < event.nParticles; ++iPart) {
+    std::string_view const line = nextLine(text, pos);
+    FieldParser fields(line);
+    Particle& p = particles[iPart];
+    bool const ok
+      =  fields.next(p.status)        && fields.next(p.pdg)
+      && fields.next(p.firstMother)   && fields.next(p.secondMother)
+      && fields.next(p.firstDaughter) && fields.next(p.secondDaughter)
+      && fields.next(p.xMomentum)     && fields.next(p.yMomentum)
+      && fields.next(p.zMomentum)     && fields.next(p.energy)
+      && fields.next(p.mass)
+      && fields.next(p.xPosition)     && fields.next(p.yPosition)
+      && fields.next(p.zPosition)     && fields.next(p.time)
+      ;
+    if (!ok) {
+      throw cet::exception("HepMCFileReader")
+        << fPath << ":" << (event.line + 1 + iPart)
+        << ": invalid particle line: '" << line << "'\n";
+    }
+  } // for particles
+
+  return event.number;
+} // evgen::HepMCFileReader::readEvent()
+
+
+// -----------------------------------------------------------------------------
+void evgen::HepMCFileReader::buildIndex() {
+
+  std::string_view const text = content();
+
+  std::size_t pos = 0;
+  std::size_t lineNo = 0;
+  while (pos < text.size()) {
+
+    std::string_view const header = nextLine(text, pos);
+    ++lineNo;
+    if (isBlank(header)) continue;
+
+    EventIndex event { pos, lineNo, 0, 0 };
+    FieldParser fields(header);
+    if (!fields.next(event.number) || !fields.next(event.nParticles)) {
+      throw cet::exception("HepMCFileReader")
+        << fPath << ":" << lineNo << ": invalid event header: '" << header
+        << "'\n";
+    }
+
+    // skip the particle lines
+    for (std::size_t iPart = 0; iPart < event.nParticles; ++iPart) {
+      if (pos >= text.size()) {
+        throw cet::exception("HepMCFileReader")
+          << fPath << ":" << event.line << ": event " << event.number
+          << " declares " << event.nParticles << " particles, but the file ends"
+          << " after " << iPart << " of them.\n";
+      }
+      nextLine(text, pos);
+      ++lineNo;
+    } // for particles
+
+    fEvents.push_back(event);
+  } // while
+
+} // evgen::HepMCFileReader::buildIndex()
+
+
+// -----------------------------------------------------------------------------
+void evgen::HepMCFileReader::unmap() noexcept {
+  if (fData) ::munmap(const_cast<char*>(fData), fSize);
+  fData = nullptr;
+  fSize = 0;
+} // evgen::HepMCFileReader::unmap()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,134 @@
+/**
+ * @file   icaruscode/Generators/HepMCFileReader.h
+ * @brief  Indexed reader of the text (HEPEVT-like) files for `HepMCFileGen`.
+ * @date   October 18, 2026
+ * @see    icaruscode/Generators/HepMCFileReader.cxx
+ */
+
+#ifndef ICARUSCODE_GENERATORS_HEPMCFILEREADER_H
+#define ICARUSCODE_GENERATORS_HEPMCFILEREADER_H
+
+// C/C++ standard libraries
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace evgen { class HepMCFileReader; }
+/**
+ * @brief Random access reader of a text file in the `HepMCFileGen` format.
+ *
+ * The format is described in `evgen::HepMCFileGen` documentation: each event
+ * has a header line with event number and number of particles, followed by
+ * one line per particle with 15 fields.
+ *
+ * The file is mapped in memory and scanned once on construction to record
+ * where each event starts. After that, any event can be parsed directly
+ * by its position in the file (`readEvent()`), without any I/O or
+ * intermediate string. Empty lines between events are ignored.
+ *
+ * The numbers are parsed with `std::from_chars()`; if the standard library
+ * does not support it for floating point numbers, `std::strtod()` is used
+ * instead.
+ *
+ * Format errors are reported via `cet::exception` (category
+ * `"HepMCFileReader"`) with the line number of the offending line: the
+ * structure of the whole file is checked on construction, the particle fields
+ * only when the event is read.
+ *
+ * Reading is a `const` operation and the reader may be shared among threads.
+ */
+class evgen::HepMCFileReader {
+    public:
+
+  /// Content of one particle line.
+  struct Particle {
+    int    status         = 0;
+    int    pdg            = 0;
+    int    firstMother    = 0;
+    int    secondMother   = 0;
+    int    firstDaughter  = 0;
+    int    secondDaughter = 0;
+    double xMomentum      = 0.;
+    double yMomentum      = 0.;
+    double zMomentum      = 0.;
+    double energy         = 0.;
+    double mass           = 0.;
+    double xPosition      = 0.;
+    double yPosition      = 0.;
+    double zPosition      = 0.;
+    double time           = 0.;
+  }; // Particle
+
+
+  /// Maps and indexes the file at the specified path.
+  explicit HepMCFileReader(std::string const& path);
+
+  ~HepMCFileReader();
+
+  // the mapping is owned: the reader can be moved, not copied
+  HepMCFileReader(HepMCFileReader const&) = delete;
+  HepMCFileReader& operator=(HepMCFileReader const&) = delete;
+  HepMCFileReader(HepMCFileReader&& from) noexcept;
+  HepMCFileReader& operator=(HepMCFileReader&& from) noexcept;
+
+
+  /// Returns the path of the file being read.
+  std::string const& path() const { return fPath; }
+
+  /// Returns the number of events in the file.
+  std::size_t nEvents() const { return fEvents.size(); }
+
+  /// Returns the event number written in the header of event `iEvent`.
+  int eventNumber(std::size_t iEvent) const
+    { return fEvents.at(iEvent).number; }
+
+  /// Returns the number of particles of event `iEvent`.
+  std::size_t nParticles(std::size_t iEvent) const
+    { return fEvents.at(iEvent).nParticles; }
+
+  /**
+   * @brief Parses the event at position `iEvent` in the file.
+   * @param iEvent index of the event in the file (`0` is the first one)
+   * @param particles [output] vector filled with the particles of the event
+   * @return the event number written in the event header
+   * @throw cet::exception (category `"HepMCFileReader"`) on format errors
+   *
+   * The content of `particles` is replaced; its memory is reused.
+   */
+  int readEvent(std::size_t iEvent, std::vector<Particle>& particles) const;
+
+
+    private:
+
+  /// Location of an event in the file.
+  struct EventIndex {
+    std::size_t offset;      ///< Start of the first particle line.
+    std::size_t line;        ///< Line number of the event header (from 1).
+    int         number;      ///< Event number in the header.
+    std::size_t nParticles;  ///< Number of particle lines following.
+  }; // EventIndex
+
+
+  std::string             fPath;       ///< Path of the mapped file.
+  char const*             fData = nullptr; ///< Start of the mapped file.
+  std::size_t             fSize = 0;   ///< Size of the mapped file.
+  std::vector<EventIndex> fEvents;     ///< Index of all the events.
+
+  /// Returns the whole file content.
+  std::string_view content() const { return { fData, fSize }; }
+
+  /// Scans the whole file and fills the event index.
+  void buildIndex();
+
+  /// Releases the mapping, if any.
+  void unmap() noexcept;
+
+}; // class evgen::HepMCFileReader
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_GENERATORS_HEPMCFILEREADER_H
@@ -0,0 +1,131 @@
+/**
+ * @file   icaruscode/PMT/Algorithms/MostProbableBaseline.cxx
+ * @brief  Estimates a PMT waveform baseline around its most probable value.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/Algorithms/MostProbableBaseline.h
+ */
+
+// library header
+#include "icaruscode/PMT/Algorithms/MostProbableBaseline.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::minmax_element(), std::find(), std::fill(), ...
+#include <map>
+
+
+// -----------------------------------------------------------------------------
+opdet::MostProbableBaseline::MostProbableBaseline()
+  : fHistogram(NSubHists * MaxADCSpan, 0)
+  {}
+
+
+// -----------------------------------------------------------------------------
+float opdet::MostProbableBaseline::operator()
+  (raw::OpDetWaveform const& waveform)
+{
+  if (waveform.empty()) return fromMap(waveform);
+
+  auto const [ minItr, maxItr ]
+    = std::minmax_element(waveform.begin(), waveform.end());
+  int const minADC = *minItr;
+  int const maxADC = *maxItr;
+  int const span = maxADC - minADC + 1;
+
+  if (span > MaxADCSpan) return fromMap(waveform);
+
+  raw::ADC_Count_t const* adcVec = waveform.data();
+  std::size_t const nADC = waveform.size();
+  int* hist = fHistogram.data();
+  int* hist1 = hist + 1 * MaxADCSpan;
+  int* hist2 = hist + 2 * MaxADCSpan;
+  int* hist3 = hist + 3 * MaxADCSpan;
+
+  // fill the interleaved histograms, then merge them into the first one
+  std::size_t idx = 0;
+  for (; idx + NSubHists <= nADC; idx += NSubHists) {
+    ++hist [adcVec[idx    ] - minADC];
+    ++hist1[adcVec[idx + 1] - minADC];
+    ++hist2[adcVec[idx + 2] - minADC];
+    ++hist3[adcVec[idx + 3] - minADC];
+  }
+  for (; idx < nADC; ++idx) ++hist[adcVec[idx] - minADC];
+
+  for (int bin = 0; bin < span; ++bin) {
+    hist[bin] += hist1[bin] + hist2[bin] + hist3[bin];
+    hist1[bin] = 0;
+    hist2[bin] = 0;
+    hist3[bin] = 0;
+  }
+
+  // find the highest count and how many bins have it
+  int maxCount = 0;
+  for (int bin = 0; bin < span; ++bin) maxCount = std::max(maxCount, hist[bin]);
+
+  int nMaxBins = 0;
+  for (int bin = 0; bin < span; ++bin) nMaxBins += (hist[bin] == maxCount);
+
+  int maxBin = 0;
+  if (nMaxBins == 1) {
+    maxBin = minADC + int(std::find(hist, hist + span, maxCount) - hist);
+  }
+  else {
+    // ties: replay the waveform to find which value reaches the count first
+    for (idx = 0; idx < nADC; ++idx) {
+      if (++hist1[adcVec[idx] - minADC] == maxCount) {
+        maxBin = adcVec[idx];
+        break;
+      }
+    }
+    std::fill(hist1, hist1 + span, 0);
+  }
+
+  // average over the window around the most probable value
+  // (absent values count zero)
+  float mostProbableBaseline = 0.f;
+  int mostProbableCount = 0;
+  for (int adcBin = maxBin - 3; adcBin <= maxBin + 3; ++adcBin) {
+    int const bin = std::clamp(adcBin - minADC, 0, span - 1);
+    int const count = (adcBin >= minADC && adcBin <= maxADC)? hist[bin]: 0;
+
+    mostProbableBaseline += count * float(adcBin);
+    mostProbableCount += count;
+  }
+
+  std::fill(hist, hist + span, 0);
+
+  return mostProbableBaseline / mostProbableCount;
+
+} // opdet::MostProbableBaseline::operator()
+
+
+// -----------------------------------------------------------------------------
+float opdet::MostProbableBaseline::fromMap(raw::OpDetWaveform const& waveform)
+{
+  std::map<raw::ADC_Count_t, int> adcFrequencyMap;
+
+  raw::ADC_Count_t maxBin = 0;
+  int maxCount = 0;
+  for (raw::ADC_Count_t const adc: waveform) {
+    int& adcFrequency = adcFrequencyMap[adc];
+    if (++adcFrequency > maxCount) {
+      maxBin = adc;
+      maxCount = adcFrequency;
+    }
+  } // for
+
+  float mostProbableBaseline = 0.f;
+  int mostProbableCount = 0;
+  for (raw::ADC_Count_t adcBin = maxBin - 3; adcBin <= maxBin + 3; ++adcBin) {
+    auto const iBin = adcFrequencyMap.find(adcBin);
+    if (iBin == adcFrequencyMap.end()) continue;
+
+    mostProbableBaseline += iBin->second * float(adcBin);
+    mostProbableCount += iBin->second;
+  } // for
+
+  return mostProbableBaseline / mostProbableCount;
+
+} // opdet::MostProbableBaseline::fromMap()
+
+
+// -----------------------------------------------------------------------------
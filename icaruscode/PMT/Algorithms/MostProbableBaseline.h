@@ -0,0 +1,65 @@
+/**
+ * @file   icaruscode/PMT/Algorithms/MostProbableBaseline.h
+ * @brief  Estimates a PMT waveform baseline around its most probable value.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/Algorithms/MostProbableBaseline.cxx
+ */
+
+#ifndef ICARUSCODE_PMT_ALGORITHMS_MOSTPROBABLEBASELINE_H
+#define ICARUSCODE_PMT_ALGORITHMS_MOSTPROBABLEBASELINE_H
+
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace opdet { class MostProbableBaseline; }
+/**
+ * @class opdet::MostProbableBaseline
+ * @brief Baseline from the average of the samples around the most probable one.
+ *
+ * The baseline of a waveform is the average of its samples within 3 ADC
+ * counts of the most probable sample value. If more values are equally
+ * probable, the first one to reach the highest count in waveform order is
+ * chosen.
+ *
+ * The sample values are counted in a dense histogram which is kept by the
+ * algorithm object and reused for each waveform: an algorithm object must not
+ * be used by more than one thread at a time. Waveforms whose values span more
+ * than `MaxADCSpan` counts, and empty ones, are processed with a `std::map`
+ * instead (`fromMap()`), which has no such restriction.
+ */
+class opdet::MostProbableBaseline {
+    public:
+
+  /// Largest span of sample values handled by the dense histogram.
+  static constexpr int MaxADCSpan = 1 << 14;
+
+  /// Constructor: allocates the histogram.
+  MostProbableBaseline();
+
+  /// Returns the baseline of the specified `waveform`.
+  float operator() (raw::OpDetWaveform const& waveform);
+
+  /// Returns the baseline of `waveform`, counting samples in a `std::map`.
+  static float fromMap(raw::OpDetWaveform const& waveform);
+
+    private:
+
+  /// Number of interleaved histograms, to avoid dependencies between
+  /// consecutive increments of the same bin.
+  static constexpr std::size_t NSubHists = 4;
+
+  std::vector<int> fHistogram; ///< Sample counts (kept zeroed between uses).
+
+}; // opdet::MostProbableBaseline
+
+
+//------------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_ALGORITHMS_MOSTPROBABLEBASELINE_H
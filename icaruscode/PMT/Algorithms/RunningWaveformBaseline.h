@@ -0,0 +1,90 @@
+/**
+ * @file   icaruscode/PMT/Algorithms/RunningWaveformBaseline.h
+ * @brief  Blends PMT channel baselines with the ones of previous events.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/Algorithms/SharedWaveformBaseline.h
+ */
+
+#ifndef ICARUSCODE_PMT_ALGORITHMS_RUNNINGWAVEFORMBASELINE_H
+#define ICARUSCODE_PMT_ALGORITHMS_RUNNINGWAVEFORMBASELINE_H
+
+
+// ICARUS libraries
+#include "icaruscode/PMT/Algorithms/SharedWaveformBaseline.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace opdet { class RunningWaveformBaseline; }
+/**
+ * @class opdet::RunningWaveformBaseline
+ * @brief Keeps a running baseline and RMS per channel.
+ *
+ * Each new baseline (and RMS) of a channel is blended with the running one as
+ * `w * running + (1 - w) * new`, and the result becomes the running value.
+ * With a weight `w` of `0` the running state is disabled and the baselines
+ * are returned unchanged.
+ *
+ * Values which were not extracted (`BaselineInfo_t::NoInfo`, e.g. for a
+ * channel with no usable waveform in the event) are returned as they are and
+ * do not affect the running state.
+ */
+class opdet::RunningWaveformBaseline {
+
+    public:
+  using BaselineInfo_t = SharedWaveformBaseline::BaselineInfo_t;
+
+  /// Constructor: sets the weight of the past (`0` disables the blending).
+  explicit RunningWaveformBaseline(double weight = 0.0): fWeight{ weight } {}
+
+  /// Returns the weight of the running value.
+  double weight() const { return fWeight; }
+
+  /// Returns whether the baselines are blended with the running ones.
+  bool enabled() const { return fWeight > 0.0; }
+
+  /// Forgets all the running baselines.
+  void reset() { fRunning.clear(); }
+
+  /// Merges `baseline` into the running baseline of `channel`, returns it.
+  BaselineInfo_t update(std::size_t channel, BaselineInfo_t baseline)
+    {
+      if (!enabled()) return baseline;
+
+      // no baseline extracted in this event: nothing to merge or to remember
+      if (baseline.baseline == BaselineInfo_t::NoInfo) return baseline;
+
+      if (fRunning.size() <= channel) fRunning.resize(channel + 1);
+      BaselineInfo_t& running = fRunning[channel];
+
+      blend(baseline.baseline, running.baseline);
+      blend(baseline.RMS, running.RMS);
+      running.nWaveforms = baseline.nWaveforms;
+      running.nSamples = baseline.nSamples;
+
+      return baseline;
+    } // update()
+
+    private:
+  double fWeight; ///< Weight of the running value.
+
+  std::vector<BaselineInfo_t> fRunning; ///< Running values, per channel.
+
+  /// Blends `value` with `running` (if available), and updates the latter.
+  void blend(double& value, double& running) const
+    {
+      if (value == BaselineInfo_t::NoInfo) return;
+      if (running != BaselineInfo_t::NoInfo)
+        value = fWeight * running + (1.0 - fWeight) * value;
+      running = value;
+    } // blend()
+
+}; // opdet::RunningWaveformBaseline
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_ALGORITHMS_RUNNINGWAVEFORMBASELINE_H
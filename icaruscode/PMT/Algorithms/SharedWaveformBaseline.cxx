@@ -9,6 +9,9 @@
 // library header
 #include "icaruscode/PMT/Algorithms/SharedWaveformBaseline.h"
 
+// ICARUS libraries
+#include "icaruscode/PMT/Algorithms/SmallIntegerSelection.h"
+
 // LArSoft libraries
 #include "lardataalg/Utilities/StatCollector.h"
 #include "lardataobj/RawData/OpDetWaveform.h"
@@ -18,7 +21,7 @@
 
 // C/C++ standard libraries
 #include <vector>
-#include <algorithm> // std::nth_element(), std::copy()
+#include <algorithm> // std::nth_element()
 #include <iterator> // std::distance(), std::next()
 #include <ostream>
 #include <cmath> // std::round()
@@ -125,8 +128,6 @@ auto opdet::SharedWaveformBaseline::operator()
   //
   // first pass: find statistics
   //
-  std::vector<raw::ADC_Count_t> samples;
-  samples.reserve(fParams.nSample * waveforms.size());
   std::vector<double> RMSs;
   RMSs.reserve(waveforms.size());
   
@@ -148,11 +149,21 @@ auto opdet::SharedWaveformBaseline::operator()
     for (auto it = begin; it != end; ++it) stats.add(*it);
     RMSs.push_back(stats.RMS());
     
-    std::copy(waveform->begin(), waveform->end(), back_inserter(samples));
   } // for
   
   double const medRMS = median(RMSs.cbegin(), RMSs.cend());
-  raw::ADC_Count_t const med = median(samples.cbegin(), samples.cend());
+  
+  // median of all the samples of all the waveforms used above,
+  // selected in place without collecting the samples
+  auto const forEachUsedWaveform = [this,&waveforms](auto&& f)
+    {
+      for (raw::OpDetWaveform const* waveform: waveforms) {
+        if (waveform->size() < fParams.nSample) continue;
+        f(waveform->cbegin(), waveform->cend());
+      }
+    };
+  raw::ADC_Count_t const med
+    = opdet::medianOfSmallIntegers<raw::ADC_Count_t>(forEachUsedWaveform);
   
   mf::LogTrace{ fLogCategory } << "Stats of channel "
     << waveforms.front()->ChannelNumber() << " from "
@@ -48,6 +48,11 @@ namespace opdet { class SharedWaveformBaseline; }
  * The parameters are specified at algorithm construction time and are contained
  * in the `Params_t` object.
  * 
+ * The median of the samples is selected by radix selection directly on the
+ * waveform data (see `opdet::medianOfSmallIntegers()`), without copying them.
+ * The algorithm object has no mutable state, and it can be used concurrently
+ * on different groups of waveforms.
+ * 
  */
 class opdet::SharedWaveformBaseline {
     public:
@@ -0,0 +1,192 @@
+/**
+ * @file   icaruscode/PMT/Algorithms/SmallIntegerSelection.h
+ * @brief  Selection of the n-th smallest value of 8- and 16-bit integers.
+ * @date   October 18, 2026
+ *
+ * This is a header-only library.
+ */
+
+#ifndef ICARUSCODE_PMT_ALGORITHMS_SMALLINTEGERSELECTION_H
+#define ICARUSCODE_PMT_ALGORITHMS_SMALLINTEGERSELECTION_H
+
+
+// C/C++ standard libraries
+#include <array>
+#include <type_traits> // std::make_unsigned_t, std::is_integral_v, ...
+#include <cstdint> // std::uint16_t
+#include <cstddef> // std::size_t
+#include <cassert>
+
+
+// -----------------------------------------------------------------------------
+namespace opdet {
+
+  /**
+   * @brief Returns the `n`-th smallest value among all the specified samples.
+   * @tparam T type of the samples (integral, no larger than 16 bits)
+   * @tparam ForEachRange type of callable feeding the samples
+   * @param forEachRange callable feeding all the sample ranges to its argument
+   * @param n the rank of the requested value (`0` is the smallest one)
+   * @return the requested value
+   *
+   * The samples are not copied nor modified. Instead, they are presented to
+   * the algorithm twice by the callable `forEachRange`: it is called with
+   * another callable `f` as only argument, and it must call `f(begin, end)`
+   * for each range of samples in the data set (e.g. once per waveform).
+   * The result is the same as the one of `std::nth_element()` on a copy of all
+   * the samples, i.e. the value which would be in position `n` if all samples
+   * were sorted.
+   *
+   * The algorithm is a two-pass radix selection on the high and the low byte
+   * of the values, which uses two fixed-size histograms and no dynamic memory.
+   *
+   * Example:
+   * ~~~~{.cpp}
+   * std::vector<std::vector<short int>> const waveforms = ...;
+   * short int const tenth = opdet::selectNthSmallInteger<short int>(
+   *   [&waveforms](auto&& f)
+   *     { for (auto const& wf: waveforms) f(wf.cbegin(), wf.cend()); },
+   *   10
+   *   );
+   * ~~~~
+   *
+   * The rank `n` must be smaller than the total number of samples.
+   */
+  template <typename T, typename ForEachRange>
+  T selectNthSmallInteger(ForEachRange&& forEachRange, std::size_t n);
+
+  /**
+   * @brief Returns the median of all the specified samples.
+   * @tparam T type of the samples (integral, no larger than 16 bits)
+   * @tparam ForEachRange type of callable feeding the samples
+   * @param forEachRange callable feeding all the sample ranges to its argument
+   * @return the median value
+   * @see `selectNthSmallInteger()`
+   *
+   * The median is defined as the value in position `N/2` (integer division)
+   * among the `N` sorted samples. There must be at least one sample.
+   * The samples are fed in the same way as in `selectNthSmallInteger()`.
+   */
+  template <typename T, typename ForEachRange>
+  T medianOfSmallIntegers(ForEachRange&& forEachRange);
+
+} // namespace opdet
+
+
+// -----------------------------------------------------------------------------
+// ---  Template implementation
+// -----------------------------------------------------------------------------
+namespace opdet::details {
+
+  /// Maps integral values into unsigned keys preserving their order.
+  template <typename T>
+  struct SmallIntegerKey {
+
+    static_assert(std::is_integral_v<T>, "Selection requires integral types.");
+    static_assert(sizeof(T) <= 2, "Selection supports up to 16-bit integers.");
+
+    using Unsigned_t = std::make_unsigned_t<T>;
+
+    /// Bit flipped to make negative values sort before positive ones.
+    static constexpr std::uint16_t SignFlip = std::is_signed_v<T>
+      ? static_cast<std::uint16_t>(1U << (8 * sizeof(T) - 1)): 0U;
+
+    static constexpr std::uint16_t toKey(T value)
+      {
+        return
+          static_cast<std::uint16_t>(static_cast<Unsigned_t>(value)) ^ SignFlip;
+      }
+
+    static constexpr T fromKey(std::uint16_t key)
+      { return static_cast<T>(static_cast<Unsigned_t>(key ^ SignFlip)); }
+
+  }; // SmallIntegerKey
+
+
+  /// Radix selection of the `n`-th value, with the high byte already known.
+  template <typename T, typename ForEachRange>
+  T selectNthSmallIntegerInBucket(
+    ForEachRange&& forEachRange,
+    std::array<std::size_t, 256U> const& highCounts, std::size_t n
+  ) {
+    using Key_t = SmallIntegerKey<T>;
+
+    // find the bucket (high byte) where the `n`-th value is
+    unsigned int high = 0U;
+    for (; high < highCounts.size(); ++high) {
+      if (n < highCounts[high]) break;
+      n -= highCounts[high];
+    }
+    assert(high < highCounts.size()); // fails if `n` is beyond the samples
+
+    // second pass: histogram of the low byte of the values in that bucket
+    std::array<std::size_t, 256U> lowCounts{};
+    forEachRange([&lowCounts,high](auto begin, auto end)
+      {
+        for (auto it = begin; it != end; ++it) {
+          std::uint16_t const key = Key_t::toKey(*it);
+          if ((key >> 8U) == int(high)) ++lowCounts[key & 0xFFU];
+        }
+      });
+
+    unsigned int low = 0U;
+    for (; low < lowCounts.size(); ++low) {
+      if (n < lowCounts[low]) break;
+      n -= lowCounts[low];
+    }
+    assert(low < lowCounts.size());
+
+    return Key_t::fromKey(static_cast<std::uint16_t>((high << 8U) | low));
+  } // selectNthSmallIntegerInBucket()
+
+
+  /// Fills the histogram of the high bytes of the values; returns the count.
+  template <typename T, typename ForEachRange>
+  std::size_t countSmallIntegerHighBytes
+    (ForEachRange&& forEachRange, std::array<std::size_t, 256U>& highCounts)
+  {
+    using Key_t = SmallIntegerKey<T>;
+
+    std::size_t N = 0U;
+    forEachRange([&highCounts,&N](auto begin, auto end)
+      {
+        for (auto it = begin; it != end; ++it) {
+          ++highCounts[Key_t::toKey(*it) >> 8U];
+          ++N;
+        }
+      });
+    return N;
+  } // countSmallIntegerHighBytes()
+
+} // namespace opdet::details
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename ForEachRange>
+T opdet::selectNthSmallInteger(ForEachRange&& forEachRange, std::size_t n) {
+
+  std::array<std::size_t, 256U> highCounts{};
+  details::countSmallIntegerHighBytes<T>(forEachRange, highCounts);
+  return details::selectNthSmallIntegerInBucket<T>
+    (forEachRange, highCounts, n);
+
+} // opdet::selectNthSmallInteger()
+
+
+// -----------------------------------------------------------------------------
+template <typename T, typename ForEachRange>
+T opdet::medianOfSmallIntegers(ForEachRange&& forEachRange) {
+
+  std::array<std::size_t, 256U> highCounts{};
+  std::size_t const N
+    = details::countSmallIntegerHighBytes<T>(forEachRange, highCounts);
+  assert(N > 0U);
+  return details::selectNthSmallIntegerInBucket<T>
+    (forEachRange, highCounts, N / 2);
+
+} // opdet::medianOfSmallIntegers()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_ALGORITHMS_SMALLINTEGERSELECTION_H
@@ -0,0 +1,118 @@
+/**
+ * @file   icaruscode/PMT/LibraryMappingTools/BatchedPhotonVisibility.cxx
+ * @brief  Photon visibility lookup for many points at once (implementation).
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/LibraryMappingTools/BatchedPhotonVisibility.h
+ */
+
+// library header
+#include "icaruscode/PMT/LibraryMappingTools/BatchedPhotonVisibility.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max(), std::min()
+
+
+// -----------------------------------------------------------------------------
+// ---  phot::BatchedPhotonVisibility
+// -----------------------------------------------------------------------------
+phot::BatchedPhotonVisibility::BatchedPhotonVisibility
+  (PhotonVisibilityTable const& library, MappingTables_t const& mapping)
+  : fLibrary(&library)
+  , fSwitchPoint(mapping.switchPoint)
+  , fTranslations(mapping.translations)
+{
+  std::size_t const nCryostats = fTranslations.size();
+  if ((nCryostats == 0U)
+    || (mapping.opDetToLibraryIndices.size() != nCryostats)
+  ) {
+    throw cet::exception("BatchedPhotonVisibility")
+      << "Inconsistent mapping: " << nCryostats << " translations and "
+      << mapping.opDetToLibraryIndices.size() << " channel mappings.\n";
+  }
+
+  for (auto const& libraryIndices: mapping.opDetToLibraryIndices)
+    fNChannels = std::max(fNChannels, libraryIndices.size());
+
+  // channels not mapped, or mapped beyond the library content, get `NoIndex`
+  long long const nLibraryChannels = fLibrary->nChannels();
+  fLibraryIndices.assign(nCryostats * fNChannels, NoIndex);
+  for (std::size_t cryo = 0; cryo < nCryostats; ++cryo) {
+    auto const& libraryIndices = mapping.opDetToLibraryIndices[cryo];
+    std::uint32_t* const indices = fLibraryIndices.data() + cryo * fNChannels;
+    for (std::size_t channel = 0; channel < libraryIndices.size(); ++channel) {
+      auto const libIndex = static_cast<long long>(libraryIndices[channel]);
+      if ((libIndex < 0) || (libIndex >= nLibraryChannels)) continue;
+      indices[channel] = static_cast<std::uint32_t>(libIndex);
+    } // for channels
+  } // for cryostats
+
+} // phot::BatchedPhotonVisibility::BatchedPhotonVisibility()
+
+
+// -----------------------------------------------------------------------------
+void phot::BatchedPhotonVisibility::fill
+  (std::vector<geo::Point_t> const& points, Visibilities_t& result) const
+{
+  std::size_t const nPoints = points.size();
+
+  result.fNPoints = nPoints;
+  result.fNChannels = fNChannels;
+  result.fData.resize(nPoints * fNChannels);
+  result.fEntries.resize(nPoints);
+  result.fIndices.resize(nPoints);
+
+  // first pass: point to library entry, once per point
+  for (std::size_t iPoint = 0; iPoint < nPoints; ++iPoint) {
+    result.fEntries[iPoint]
+      = libraryEntries(points[iPoint], result.fIndices[iPoint]);
+  }
+
+  // second pass: one channel at a time, writing contiguous values
+  float const* const* const entries = result.fEntries.data();
+  std::uint32_t const* const* const indices = result.fIndices.data();
+  for (std::size_t channel = 0; channel < fNChannels; ++channel) {
+    float* const out = result.fData.data() + channel * nPoints;
+    for (std::size_t iPoint = 0; iPoint < nPoints; ++iPoint) {
+      std::uint32_t const libIndex = indices[iPoint][channel];
+      out[iPoint] = (entries[iPoint] && (libIndex != NoIndex))
+        ? entries[iPoint][libIndex]: 0.0f;
+    } // for points
+  } // for channels
+
+} // phot::BatchedPhotonVisibility::fill()
+
+
+// -----------------------------------------------------------------------------
+std::vector<float> phot::BatchedPhotonVisibility::visibilities
+  (geo::Point_t const& point) const
+{
+  std::uint32_t const* indices = nullptr;
+  float const* const entries = libraryEntries(point, indices);
+
+  std::vector<float> vis(fNChannels, 0.0f);
+  if (!entries) return vis;
+  for (std::size_t channel = 0; channel < fNChannels; ++channel) {
+    if (indices[channel] != NoIndex) vis[channel] = entries[indices[channel]];
+  }
+  return vis;
+} // phot::BatchedPhotonVisibility::visibilities()
+
+
+// -----------------------------------------------------------------------------
+float const* phot::BatchedPhotonVisibility::libraryEntries
+  (geo::Point_t const& point, std::uint32_t const*& indices) const
+{
+  // same choice as `ICARUSPhotonMappingTransformations::whichCryostat()`
+  std::size_t const cryo = std::min<std::size_t>
+    ((point.X() > fSwitchPoint)? 1U: 0U, fTranslations.size() - 1U);
+
+  indices = fLibraryIndices.data() + cryo * fNChannels;
+  return fLibrary->visibilities
+    (fLibrary->voxelAt(point + fTranslations[cryo]));
+} // phot::BatchedPhotonVisibility::libraryEntries()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,147 @@
+/**
+ * @file   icaruscode/PMT/LibraryMappingTools/BatchedPhotonVisibility.h
+ * @brief  Photon visibility lookup for many points at once.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/LibraryMappingTools/BatchedPhotonVisibility.cxx
+ */
+
+#ifndef ICARUSCODE_PMT_LIBRARYMAPPINGTOOLS_BATCHEDPHOTONVISIBILITY_H
+#define ICARUSCODE_PMT_LIBRARYMAPPINGTOOLS_BATCHEDPHOTONVISIBILITY_H
+
+// ICARUS libraries
+#include "icaruscode/PMT/LibraryMappingTools/PhotonVisibilityTable.h"
+#include "icaruscode/PMT/LibraryMappingTools/ICARUSPhotonMappingTransformations.h"
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <limits>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+
+
+// -----------------------------------------------------------------------------
+namespace phot { class BatchedPhotonVisibility; }
+/**
+ * @brief Visibility of all optical detector channels from many points.
+ *
+ * This object returns the same visibilities as the photon visibility service
+ * configured with `ICARUSPhotonMappingTransformations` mapping (without
+ * interpolation), for a whole set of points at once.
+ * The mapping of the tool is copied at construction into flat tables
+ * (`ICARUSPhotonMappingTransformations::mappingTables()`), so that no virtual
+ * call and no per-point remapping of the channels is needed.
+ * The library content is read from a `PhotonVisibilityTable`, which is
+ * typically mapped in memory from a file.
+ *
+ * Example:
+ * ~~~~{.cpp}
+ * phot::PhotonVisibilityTable const library
+ *   = phot::PhotonVisibilityTable::fromFile("PhotonLibrary-20201209.vistable");
+ * phot::BatchedPhotonVisibility const visibility
+ *   { library, mappingTool.mappingTables() };
+ *
+ * phot::BatchedPhotonVisibility::Visibilities_t vis;
+ * visibility.fill(points, vis);
+ * float const* visFromChannel0 = vis.channel(0); // one value per point
+ * ~~~~
+ *
+ * Points outside the library have `0` visibility on all channels, and so do
+ * channels which are not covered by the library for that point.
+ *
+ * The object is not modified by the lookups, which can be run concurrently.
+ * The library table must stay available for the lifetime of this object.
+ */
+class phot::BatchedPhotonVisibility {
+    public:
+
+  using MappingTables_t
+    = ICARUSPhotonMappingTransformations::MappingTables_t;
+
+
+  /// Visibilities of a batch of points, one array per channel.
+  class Visibilities_t {
+      public:
+
+    /// Number of points in the batch.
+    std::size_t nPoints() const { return fNPoints; }
+
+    /// Number of optical detector channels.
+    std::size_t nChannels() const { return fNChannels; }
+
+    /// Returns the visibilities from all points to `channel` (`nPoints()`).
+    float const* channel(std::size_t channel) const
+      { return fData.data() + channel * fNPoints; }
+
+    /// Returns the visibility of `channel` from the point number `iPoint`.
+    float operator() (std::size_t channel, std::size_t iPoint) const
+      { return fData[channel * fNPoints + iPoint]; }
+
+    /// All visibilities: `nPoints()` values for each channel in sequence.
+    std::vector<float> const& data() const { return fData; }
+
+      private:
+    friend class BatchedPhotonVisibility;
+
+    std::size_t fNPoints = 0U;
+    std::size_t fNChannels = 0U;
+    std::vector<float> fData;
+
+    // scratch space, kept to reuse its memory
+    std::vector<float const*> fEntries; ///< Library entries for each point.
+    std::vector<std::uint32_t const*> fIndices; ///< Mapping for each point.
+
+  }; // Visibilities_t
+
+
+  /// Constructor: uses the `library` and the specified channel mapping.
+  BatchedPhotonVisibility
+    (PhotonVisibilityTable const& library, MappingTables_t const& mapping);
+
+  /// Returns the number of optical detector channels.
+  std::size_t nChannels() const { return fNChannels; }
+
+  /// Computes the visibilities from all `points` (detector frame) into
+  /// `result`, whose memory is reused.
+  void fill
+    (std::vector<geo::Point_t> const& points, Visibilities_t& result) const;
+
+  /// Returns the visibilities from all `points` (detector frame).
+  Visibilities_t operator() (std::vector<geo::Point_t> const& points) const
+    { Visibilities_t result; fill(points, result); return result; }
+
+  /// Returns the visibility of all channels from `point` (detector frame).
+  std::vector<float> visibilities(geo::Point_t const& point) const;
+
+
+    private:
+
+  /// Marker of a channel not covered by the library.
+  static constexpr std::uint32_t NoIndex
+    = std::numeric_limits<std::uint32_t>::max();
+
+  PhotonVisibilityTable const* fLibrary; ///< Library content.
+
+  double fSwitchPoint; ///< Points with x above this are in `C:1` [cm]
+
+  /// Translation into the library frame, indexed by cryostat number.
+  std::vector<geo::Vector_t> fTranslations;
+
+  std::size_t fNChannels = 0U; ///< Number of optical detector channels.
+
+  /// Library index of each channel (or `NoIndex`), for sources in each
+  /// cryostat: `fLibraryIndices[cryostat * fNChannels + channel]`.
+  std::vector<std::uint32_t> fLibraryIndices;
+
+  /// Returns the library entries for `point` and the channel mapping to use.
+  float const* libraryEntries
+    (geo::Point_t const& point, std::uint32_t const*& indices) const;
+
+}; // class phot::BatchedPhotonVisibility
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_LIBRARYMAPPINGTOOLS_BATCHEDPHOTONVISIBILITY_H
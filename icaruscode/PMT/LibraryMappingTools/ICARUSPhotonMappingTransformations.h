@@ -219,6 +219,38 @@ namespace phot {
     // --- END Optical detector identifier mapping interface -------------------
     
     
+    // --- BEGIN Precomputed mapping tables ------------------------------------
+    /// @name Precomputed mapping tables
+    /// @{
+    
+    /// All the information needed to map points and channels, per cryostat.
+    struct MappingTables_t {
+      
+      /// Points with x above this coordinate are in `C:1` [cm]
+      geo::Length_t switchPoint;
+      
+      /// Translation into the library frame, indexed by cryostat number.
+      std::vector<geo::Vector_t> translations;
+      
+      /// Detector channel to library mappings, indexed by cryostat number.
+      std::vector<OpDetToLibraryIndexMap> opDetToLibraryIndices;
+      
+    }; // MappingTables_t
+    
+    /**
+     * @brief Returns a copy of the mapping tables used by this tool.
+     * @see `phot::BatchedPhotonVisibility`
+     * 
+     * The tables allow to reproduce the mapping of this tool without virtual
+     * calls, e.g. for lookups of many points at once.
+     */
+    MappingTables_t mappingTables() const
+      { return { fSwitchPoint, fTranslations, fOpDetToLibraryIndexMaps }; }
+    
+    /// @}
+    // --- END Precomputed mapping tables --------------------------------------
+    
+    
       protected:
     //
     // configuration parameters
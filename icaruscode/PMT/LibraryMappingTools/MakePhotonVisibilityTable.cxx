@@ -0,0 +1,185 @@
+/**
+ * @file   icaruscode/PMT/LibraryMappingTools/MakePhotonVisibilityTable.cxx
+ * @brief  Utility converting a photon library into a visibility table file.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/LibraryMappingTools/PhotonVisibilityTable.h
+ *
+ * Usage:
+ *
+ *     MakePhotonVisibilityTable  config.fcl  output.vistable
+ *
+ * The configuration file must include a configuration for
+ * `PhotonVisibilityService` service, from which the library file
+ * (`LibraryFile`, searched in `FW_SEARCH_PATH`) and the voxel grid
+ * (`XMin`, `XMax`, `NX` etc.) are read. The content of the library
+ * (tree `PhotonLibraryData`) is written into a table file that can be read by
+ * `phot::PhotonVisibilityTable::fromFile()`. The number of channels is the
+ * highest channel number in the library plus one.
+ *
+ * It is using _art_ facilities for configuration, but it does not run in _art_
+ * environment. So it may break without warning and without solution.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/LibraryMappingTools/PhotonVisibilityTable.h"
+
+// LArSoft and framework libraries
+#include "larcorealg/TestUtils/unit_test_base.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib/search_path.h"
+#include "cetlib_except/exception.h"
+
+// ROOT libraries
+#include "TFile.h"
+#include "TTree.h"
+#include "TKey.h"
+
+// C/C++ standard libraries
+#include <iostream>
+#include <memory> // std::unique_ptr<>
+#include <string>
+#include <vector>
+#include <cstdint> // std::uint32_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Reads all the visibilities from the tree; returns the number of channels.
+  unsigned int readLibrary
+    (TTree& tree, std::size_t nVoxels, std::vector<float>& visibilities)
+  {
+    Int_t voxel = -1;
+    Int_t channel = -1;
+    Float_t visibility = 0.0;
+    tree.SetBranchAddress("Voxel", &voxel);
+    tree.SetBranchAddress("OpChannel", &channel);
+    tree.SetBranchAddress("Visibility", &visibility);
+
+    // first pass: number of channels
+    tree.SetBranchStatus("*", false);
+    tree.SetBranchStatus("OpChannel", true);
+    Int_t maxChannel = -1;
+    Long64_t const nEntries = tree.GetEntries();
+    for (Long64_t iEntry = 0; iEntry < nEntries; ++iEntry) {
+      tree.GetEntry(iEntry);
+      if (channel > maxChannel) maxChannel = channel;
+    }
+    unsigned int const nChannels = static_cast<unsigned int>(maxChannel + 1);
+
+    // second pass: content
+    tree.SetBranchStatus("*", true);
+    visibilities.assign(nVoxels * nChannels, 0.0f);
+    for (Long64_t iEntry = 0; iEntry < nEntries; ++iEntry) {
+      tree.GetEntry(iEntry);
+      if ((voxel < 0) || (static_cast<std::size_t>(voxel) >= nVoxels)) {
+        throw cet::exception("MakePhotonVisibilityTable")
+          << "Entry #" << iEntry << " has voxel " << voxel << " out of the "
+          << nVoxels << " of the configured grid.\n";
+      }
+      if (channel < 0) continue;
+      visibilities[static_cast<std::size_t>(voxel) * nChannels + channel]
+        = visibility;
+    } // for
+
+    return nChannels;
+  } // readLibrary()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  using Environment
+    = testing::TesterEnvironment<testing::BasicEnvironmentConfiguration>;
+
+  testing::BasicEnvironmentConfiguration config("MakePhotonVisibilityTable");
+
+  //
+  // parameter parsing
+  //
+  if (argc != 3) {
+    std::cerr << "Usage:  " << argv[0] << "  config.fcl  output.vistable"
+      << std::endl;
+    return 1;
+  }
+  config.SetConfigurationPath(argv[1]);
+  std::string const outputPath { argv[2] };
+
+  Environment const Env { config };
+
+  fhicl::ParameterSet const pvsConfig
+    = Env.ServiceParameters("PhotonVisibilityService");
+
+  phot::PhotonVisibilityTable::VoxelGrid_t const grid {
+    {
+      pvsConfig.get<double>("XMin"), pvsConfig.get<double>("YMin"),
+      pvsConfig.get<double>("ZMin")
+    },
+    {
+      pvsConfig.get<double>("XMax"), pvsConfig.get<double>("YMax"),
+      pvsConfig.get<double>("ZMax")
+    },
+    {
+      pvsConfig.get<std::uint32_t>("NX"), pvsConfig.get<std::uint32_t>("NY"),
+      pvsConfig.get<std::uint32_t>("NZ")
+    }
+    };
+
+  //
+  // read the library
+  //
+  std::string const libraryPath = cet::search_path{ "FW_SEARCH_PATH" }
+    .find_file(pvsConfig.get<std::string>("LibraryFile"));
+
+  std::unique_ptr<TFile> libraryFile { TFile::Open(libraryPath.c_str()) };
+  if (!libraryFile || libraryFile->IsZombie()) {
+    std::cerr << "Can't open photon library file '" << libraryPath << "'."
+      << std::endl;
+    return 1;
+  }
+  TTree* tree
+    = dynamic_cast<TTree*>(libraryFile->Get("PhotonLibraryData"));
+  if (!tree) { // library not in the top directory
+    TKey* const key = libraryFile->FindKeyAny("PhotonLibraryData");
+    if (key) tree = dynamic_cast<TTree*>(key->ReadObj());
+  }
+  if (!tree) {
+    std::cerr << "No photon library tree in '" << libraryPath << "'."
+      << std::endl;
+    return 1;
+  }
+
+  std::vector<float> visibilities;
+  unsigned int const nChannels
+    = readLibrary(*tree, grid.nVoxels(), visibilities);
+
+  //
+  // write the table, and read it back as a check
+  //
+  phot::PhotonVisibilityTable::fromVisibilities(grid, nChannels, visibilities)
+    .write(outputPath);
+
+  phot::PhotonVisibilityTable const table
+    = phot::PhotonVisibilityTable::fromFile(outputPath);
+  for (std::size_t voxel = 0; voxel < table.nVoxels(); ++voxel) {
+    float const* const values = table.visibilities(static_cast<int>(voxel));
+    for (unsigned int channel = 0; channel < nChannels; ++channel) {
+      if (values[channel] == visibilities[voxel * nChannels + channel])
+        continue;
+      std::cerr << "Table in '" << outputPath
+        << "' does not match the library content!" << std::endl;
+      return 1;
+    } // for channels
+  } // for voxels
+
+  std::cout << "Photon visibility table written into '" << outputPath << "' ("
+    << table.sizeInBytes() << " bytes) from '" << libraryPath << "':"
+    << "\n  " << table.nVoxels() << " voxels ("
+    << grid.steps[0] << " x " << grid.steps[1] << " x " << grid.steps[2]
+    << "), " << nChannels << " channels"
+    << std::endl;
+
+  return 0;
+} // main()
@@ -0,0 +1,225 @@
+/**
+ * @file   icaruscode/PMT/LibraryMappingTools/PhotonVisibilityTable.cxx
+ * @brief  Flat, memory-mappable photon visibility library (implementation).
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/LibraryMappingTools/PhotonVisibilityTable.h
+ */
+
+// library header
+#include "icaruscode/PMT/LibraryMappingTools/PhotonVisibilityTable.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::copy(), std::equal()
+#include <fstream>
+#include <utility> // std::exchange(), std::move()
+#include <cerrno>
+#include <cstring> // std::memcpy(), std::strerror()
+
+// POSIX
+#include <fcntl.h> // open()
+#include <sys/mman.h> // mmap(), munmap()
+#include <sys/stat.h> // fstat()
+#include <unistd.h> // close()
+
+
+// -----------------------------------------------------------------------------
+// ---  phot::PhotonVisibilityTable
+// -----------------------------------------------------------------------------
+phot::PhotonVisibilityTable::~PhotonVisibilityTable() { release(); }
+
+
+// -----------------------------------------------------------------------------
+phot::PhotonVisibilityTable::PhotonVisibilityTable
+  (PhotonVisibilityTable&& from) noexcept
+  : fData(std::exchange(from.fData, nullptr))
+  , fSize(std::exchange(from.fSize, 0))
+  , fOwned(std::move(from.fOwned))
+  , fMapped(std::exchange(from.fMapped, false))
+  , fVoxelDef(std::move(from.fVoxelDef))
+{}
+
+
+// -----------------------------------------------------------------------------
+auto phot::PhotonVisibilityTable::operator= (PhotonVisibilityTable&& from) noexcept
+  -> PhotonVisibilityTable&
+{
+  if (&from != this) {
+    release();
+    fData = std::exchange(from.fData, nullptr);
+    fSize = std::exchange(from.fSize, 0);
+    fOwned = std::move(from.fOwned);
+    fMapped = std::exchange(from.fMapped, false);
+    fVoxelDef = std::move(from.fVoxelDef);
+  }
+  return *this;
+} // phot::PhotonVisibilityTable::operator= ()
+
+
+// -----------------------------------------------------------------------------
+auto phot::PhotonVisibilityTable::fromVisibilities(
+  VoxelGrid_t const& grid, unsigned int nChannels,
+  std::vector<float> const& visibilities
+) -> PhotonVisibilityTable {
+
+  std::size_t const nVoxels = grid.nVoxels();
+  if (visibilities.size() != nVoxels * nChannels) {
+    throw cet::exception("PhotonVisibilityTable")
+      << "Expected " << nVoxels << " voxels x " << nChannels
+      << " channels = " << (nVoxels * nChannels) << " visibilities, got "
+      << visibilities.size() << ".\n";
+  }
+
+  Header header {};
+  std::copy(std::begin(Magic), std::end(Magic), header.magic);
+  header.version = FormatVersion;
+  header.byteOrder = ByteOrderMark;
+  header.nVoxels = nVoxels;
+  header.nChannels = nChannels;
+  header.grid = grid;
+
+  std::size_t const valueBytes = visibilities.size() * sizeof(float);
+  std::size_t const size
+    = (ValuesOffset + valueBytes + sizeof(std::uint64_t) - 1)
+      / sizeof(std::uint64_t) * sizeof(std::uint64_t);
+  header.size = size;
+
+  PhotonVisibilityTable table;
+  table.fOwned.assign(size / sizeof(std::uint64_t), 0);
+  std::byte* const data = reinterpret_cast<std::byte*>(table.fOwned.data());
+  std::memcpy(data, &header, sizeof(Header));
+  if (valueBytes > 0)
+    std::memcpy(data + ValuesOffset, visibilities.data(), valueBytes);
+  table.fData = data;
+  table.fSize = size;
+
+  table.setup();
+  return table;
+} // phot::PhotonVisibilityTable::fromVisibilities()
+
+
+// -----------------------------------------------------------------------------
+auto phot::PhotonVisibilityTable::fromFile(std::string const& path)
+  -> PhotonVisibilityTable
+{
+  int const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw cet::exception("PhotonVisibilityTable")
+      << "Photon visibility table file '" << path << "' can't be opened: "
+      << std::strerror(errno) << "\n";
+  }
+
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) != 0) {
+    int const error = errno;
+    ::close(fd);
+    throw cet::exception("PhotonVisibilityTable")
+      << "Can't determine the size of photon visibility table file '" << path
+      << "': " << std::strerror(error) << "\n";
+  }
+
+  std::size_t const size = static_cast<std::size_t>(fileStat.st_size);
+  if (size < ValuesOffset) {
+    ::close(fd);
+    throw cet::exception("PhotonVisibilityTable")
+      << "File '" << path << "' is too small (" << size
+      << " bytes) to be a photon visibility table.\n";
+  }
+
+  // shared mapping: all processes reading this file share the same pages
+  void* const data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    int const error = errno;
+    ::close(fd);
+    throw cet::exception("PhotonVisibilityTable")
+      << "Photon visibility table file '" << path
+      << "' can't be mapped in memory: " << std::strerror(error) << "\n";
+  }
+  ::close(fd); // the mapping stays valid
+
+  PhotonVisibilityTable table;
+  table.fData = static_cast<std::byte const*>(data);
+  table.fSize = size;
+  table.fMapped = true;
+
+  try {
+    table.setup();
+  }
+  catch (cet::exception& e) {
+    throw cet::exception("PhotonVisibilityTable", "", e)
+      << "Photon visibility table file '" << path << "' can't be used.\n";
+  }
+
+  return table;
+} // phot::PhotonVisibilityTable::fromFile()
+
+
+// -----------------------------------------------------------------------------
+void phot::PhotonVisibilityTable::write(std::string const& path) const {
+
+  std::ofstream out { path, std::ios::binary | std::ios::trunc };
+  if (!out) {
+    throw cet::exception("PhotonVisibilityTable")
+      << "Can't create photon visibility table file '" << path << "'.\n";
+  }
+  out.write(reinterpret_cast<char const*>(fData), fSize);
+  out.close();
+  if (!out) {
+    throw cet::exception("PhotonVisibilityTable")
+      << "Error writing photon visibility table file '" << path << "'.\n";
+  }
+
+} // phot::PhotonVisibilityTable::write()
+
+
+// -----------------------------------------------------------------------------
+void phot::PhotonVisibilityTable::setup() {
+
+  auto fail = [](){ return cet::exception("PhotonVisibilityTable"); };
+
+  Header const& h = header();
+  if (!std::equal(std::begin(Magic), std::end(Magic), h.magic))
+    throw fail() << "Not a photon visibility table.\n";
+  if (h.byteOrder != ByteOrderMark)
+    throw fail() << "Photon visibility table written with different byte order.\n";
+  if (h.version != FormatVersion) {
+    throw fail() << "Photon visibility table format version " << h.version
+      << " not supported (expected: " << FormatVersion << ").\n";
+  }
+  if (h.size != fSize) {
+    throw fail() << "Photon visibility table size mismatch: header says "
+      << h.size << " bytes, " << fSize << " are available.\n";
+  }
+  if (h.nVoxels != h.grid.nVoxels()) {
+    throw fail() << "Corrupted photon visibility table: " << h.nVoxels
+      << " voxels declared, the grid has " << h.grid.nVoxels() << ".\n";
+  }
+  if (ValuesOffset + h.nVoxels * h.nChannels * sizeof(float) > fSize) {
+    throw fail() << "Corrupted photon visibility table: " << h.nVoxels
+      << " voxels x " << h.nChannels << " channels do not fit in "
+      << fSize << " bytes.\n";
+  }
+
+  VoxelGrid_t const& g = h.grid;
+  fVoxelDef = sim::PhotonVoxelDef{
+    g.lower[0], g.upper[0], static_cast<int>(g.steps[0]),
+    g.lower[1], g.upper[1], static_cast<int>(g.steps[1]),
+    g.lower[2], g.upper[2], static_cast<int>(g.steps[2])
+    };
+
+} // phot::PhotonVisibilityTable::setup()
+
+
+// -----------------------------------------------------------------------------
+void phot::PhotonVisibilityTable::release() noexcept {
+  if (fMapped && fData) ::munmap(const_cast<std::byte*>(fData), fSize);
+  fOwned.clear();
+  fData = nullptr;
+  fSize = 0;
+  fMapped = false;
+} // phot::PhotonVisibilityTable::release()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,171 @@
+/**
+ * @file   icaruscode/PMT/LibraryMappingTools/PhotonVisibilityTable.h
+ * @brief  Flat, memory-mappable photon visibility library.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/LibraryMappingTools/PhotonVisibilityTable.cxx
+ */
+
+#ifndef ICARUSCODE_PMT_LIBRARYMAPPINGTOOLS_PHOTONVISIBILITYTABLE_H
+#define ICARUSCODE_PMT_LIBRARYMAPPINGTOOLS_PHOTONVISIBILITYTABLE_H
+
+// LArSoft libraries
+#include "larsim/Simulation/PhotonVoxels.h"
+
+// C/C++ standard libraries
+#include <array>
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, ...
+
+
+// -----------------------------------------------------------------------------
+namespace phot { class PhotonVisibilityTable; }
+/**
+ * @brief Photon visibility library stored as a single table.
+ *
+ * The table holds the visibility of each library channel from each voxel of
+ * the library, as a contiguous array of `float` (all the channels of the first
+ * voxel, then all the channels of the second one, and so on), preceded by a
+ * small header with the voxel grid.
+ *
+ * The table can be written into a file (`write()`) and mapped back into memory
+ * (`fromFile()`) without any parsing. The file is mapped read-only and shared,
+ * so that all the processes on the same node using the same table file share
+ * the same physical memory pages.
+ * The format carries a version number (`FormatVersion`): files with a
+ * different version, or written on a machine with a different byte order,
+ * are rejected and need to be generated again (see `MakePhotonVisibilityTable`
+ * executable).
+ *
+ * Voxels are identified in the same way as in the photon visibility service,
+ * by the `sim::PhotonVoxelDef` built from the grid of the table.
+ *
+ * All errors are reported with `cet::exception` (category
+ * `"PhotonVisibilityTable"`).
+ */
+class phot::PhotonVisibilityTable {
+    public:
+
+  /// Version of the binary format.
+  static constexpr std::uint32_t FormatVersion = 1U;
+
+  /// Definition of the voxel grid of the library.
+  struct VoxelGrid_t {
+    std::array<double, 3U> lower;        ///< Lower corner [cm]
+    std::array<double, 3U> upper;        ///< Upper corner [cm]
+    std::array<std::uint32_t, 3U> steps; ///< Number of voxels on each axis.
+
+    /// Returns the total number of voxels.
+    std::size_t nVoxels() const
+      { return std::size_t{ steps[0] } * steps[1] * steps[2]; }
+  }; // VoxelGrid_t
+
+
+  PhotonVisibilityTable() = default;
+  ~PhotonVisibilityTable();
+
+  PhotonVisibilityTable(PhotonVisibilityTable const&) = delete;
+  PhotonVisibilityTable& operator=(PhotonVisibilityTable const&) = delete;
+  PhotonVisibilityTable(PhotonVisibilityTable&& from) noexcept;
+  PhotonVisibilityTable& operator=(PhotonVisibilityTable&& from) noexcept;
+
+
+  // --- BEGIN -- Creation and persistency -------------------------------------
+  /**
+   * @brief Creates a table (in memory) from the specified visibilities.
+   * @param grid definition of the voxels
+   * @param nChannels number of library channels
+   * @param visibilities all visibilities, voxel by voxel (see class notes)
+   */
+  static PhotonVisibilityTable fromVisibilities(
+    VoxelGrid_t const& grid, unsigned int nChannels,
+    std::vector<float> const& visibilities
+    );
+
+  /// Maps in memory the table in the specified file (after checking it).
+  static PhotonVisibilityTable fromFile(std::string const& path);
+
+  /// Writes the table into the specified file.
+  void write(std::string const& path) const;
+
+  /// Returns the size of the table in bytes.
+  std::size_t sizeInBytes() const { return fSize; }
+  // --- END ---- Creation and persistency -------------------------------------
+
+
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// Returns the definition of the voxel grid.
+  VoxelGrid_t const& grid() const { return header().grid; }
+
+  /// Returns the voxel definition, as used by the visibility service.
+  sim::PhotonVoxelDef const& voxelDef() const { return fVoxelDef; }
+
+  /// Returns the number of voxels in the library.
+  std::size_t nVoxels() const { return fData? header().nVoxels: 0U; }
+
+  /// Returns the number of library channels.
+  unsigned int nChannels() const { return fData? header().nChannels: 0U; }
+
+  /// Returns the voxel containing `libraryPoint` (library frame), or `-1`.
+  int voxelAt(geo::Point_t const& libraryPoint) const
+    { return fVoxelDef.GetVoxelID(libraryPoint); }
+
+  /// Returns the visibilities of all channels from `voxel` (`nullptr` if
+  /// the voxel is not in the library).
+  float const* visibilities(int voxel) const
+    {
+      return ((voxel < 0) || (static_cast<std::size_t>(voxel) >= nVoxels()))
+        ? nullptr: values() + static_cast<std::size_t>(voxel) * nChannels();
+    }
+  // --- END ---- Access -------------------------------------------------------
+
+
+    private:
+
+  /// Header at the start of the table.
+  struct Header {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;   ///< `ByteOrderMark` as written by the creator.
+    std::uint64_t size;        ///< Total size of the table, in bytes.
+    std::uint64_t nVoxels;
+    std::uint32_t nChannels;
+    std::uint32_t padding;
+    VoxelGrid_t   grid;
+  }; // Header
+
+  static constexpr char Magic[8] = { 'I', 'C', 'P', 'H', 'V', 'I', 'S', 'T' };
+  static constexpr std::uint32_t ByteOrderMark = 0x01020304U;
+
+  /// Offset of the visibility values from the start of the table.
+  static constexpr std::size_t ValuesOffset
+    = (sizeof(Header) + alignof(std::uint64_t) - 1)
+      / alignof(std::uint64_t) * alignof(std::uint64_t);
+
+  std::byte const*           fData = nullptr; ///< Start of the table.
+  std::size_t                fSize = 0;       ///< Size of the table.
+  std::vector<std::uint64_t> fOwned;          ///< Storage, unless mapped.
+  bool                       fMapped = false; ///< Whether memory is mapped.
+
+  /// Voxel definition (from the table header).
+  sim::PhotonVoxelDef fVoxelDef;
+
+  Header const& header() const
+    { return *reinterpret_cast<Header const*>(fData); }
+
+  float const* values() const
+    { return reinterpret_cast<float const*>(fData + ValuesOffset); }
+
+  /// Checks the consistency of the table and sets the voxel definition.
+  void setup();
+
+  /// Releases the memory.
+  void release() noexcept;
+
+}; // class phot::PhotonVisibilityTable
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_LIBRARYMAPPINGTOOLS_PHOTONVISIBILITYTABLE_H
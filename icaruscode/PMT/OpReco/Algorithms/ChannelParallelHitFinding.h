@@ -0,0 +1,163 @@
+/**
+ * @file   icaruscode/PMT/OpReco/Algorithms/ChannelParallelHitFinding.h
+ * @brief  Runs a hit finder on waveforms in parallel, channel by channel.
+ * @date   October 18, 2026
+ *
+ * This library is header-only.
+ */
+
+#ifndef ICARUSCODE_PMT_OPRECO_ALGORITHMS_CHANNELPARALLELHITFINDING_H
+#define ICARUSCODE_PMT_OPRECO_ALGORITHMS_CHANNELPARALLELHITFINDING_H
+
+// TBB libraries
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::stable_sort()
+#include <atomic>
+#include <iterator> // std::back_inserter()
+#include <memory> // std::unique_ptr
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace opdet {
+
+  /// Indices of waveforms in their collection, one list per channel.
+  using ChannelWaveforms_t = std::vector<std::vector<std::size_t>>;
+
+  /**
+   * @brief Returns the indices of the selected `waveforms`, grouped by channel.
+   * @tparam Waveforms type of waveform collection (random access)
+   * @tparam Selector type of the waveform selection predicate
+   * @param waveforms the collection of waveforms (with `ChannelNumber()`)
+   * @param isSelected returns whether a waveform should be included
+   * @return the indices of the selected waveforms, one list per channel
+   *
+   * The channels are sorted by number, and within each channel the waveforms
+   * keep their order in the collection.
+   */
+  template <typename Waveforms, typename Selector>
+  ChannelWaveforms_t groupWaveformsByChannel
+    (Waveforms const& waveforms, Selector isSelected);
+
+  /**
+   * @brief Finds the hits of all `channelWaveforms` with a pool of workers.
+   * @tparam Hit type of hit
+   * @tparam Worker type of the set of hit finding algorithms
+   * @tparam FindChannelHits type of the hit finding function
+   * @param workers the sets of algorithms, each used by one thread at a time
+   * @param channelWaveforms indices of the waveforms to process, per channel
+   * @param nWaveforms number of waveforms in the whole collection
+   * @param findChannelHits the hit finder for the waveforms of one channel
+   * @return all the hits, in the order of the waveforms they come from
+   *
+   * Each worker keeps picking the next channel not yet processed, until none
+   * is left, and calls
+   * `findChannelHits(Worker&, std::vector<std::size_t> const& indices,
+   * std::vector<std::vector<Hit>>& waveformHits)` on it, which is expected to
+   * add the hits of each waveform to the element of `waveformHits` with the
+   * same index as the waveform.
+   * The hits are then merged in waveform order, so that the result does not
+   * depend on the number of workers nor on the scheduling.
+   * With a single worker, all the channels are processed in the calling
+   * thread.
+   */
+  template <typename Hit, typename Worker, typename FindChannelHits>
+  std::vector<Hit> findHitsByChannel(
+    std::vector<std::unique_ptr<Worker>> const& workers,
+    ChannelWaveforms_t const& channelWaveforms,
+    std::size_t nWaveforms,
+    FindChannelHits findChannelHits
+    );
+
+} // namespace opdet
+
+
+// -----------------------------------------------------------------------------
+// ---  Template implementation
+// -----------------------------------------------------------------------------
+template <typename Waveforms, typename Selector>
+opdet::ChannelWaveforms_t opdet::groupWaveformsByChannel
+  (Waveforms const& waveforms, Selector isSelected)
+{
+  // sort the waveform indices by channel, keeping the original order within
+  std::vector<std::size_t> indices;
+  indices.reserve(waveforms.size());
+  for (std::size_t iWaveform = 0; iWaveform < waveforms.size(); ++iWaveform)
+    if (isSelected(waveforms[iWaveform])) indices.push_back(iWaveform);
+
+  std::stable_sort(indices.begin(), indices.end(),
+    [&waveforms](std::size_t a, std::size_t b)
+      { return waveforms[a].ChannelNumber() < waveforms[b].ChannelNumber(); }
+    );
+
+  ChannelWaveforms_t channelWaveforms;
+  for (std::size_t const iWaveform: indices) {
+    if (channelWaveforms.empty()
+      || (waveforms[channelWaveforms.back().front()].ChannelNumber()
+        != waveforms[iWaveform].ChannelNumber())
+    ) {
+      channelWaveforms.emplace_back();
+    }
+    channelWaveforms.back().push_back(iWaveform);
+  } // for
+
+  return channelWaveforms;
+} // opdet::groupWaveformsByChannel()
+
+
+// -----------------------------------------------------------------------------
+template <typename Hit, typename Worker, typename FindChannelHits>
+std::vector<Hit> opdet::findHitsByChannel(
+  std::vector<std::unique_ptr<Worker>> const& workers,
+  ChannelWaveforms_t const& channelWaveforms,
+  std::size_t nWaveforms,
+  FindChannelHits findChannelHits
+) {
+
+  // each worker keeps picking the next channel to process until none is left
+  std::vector<std::vector<Hit>> waveformHits(nWaveforms);
+  std::atomic<std::size_t> nextChannel{ 0U };
+
+  auto const runWorker = [&](Worker& worker)
+    {
+      for (std::size_t iChannel = nextChannel++;
+        iChannel < channelWaveforms.size(); iChannel = nextChannel++
+      ) {
+        findChannelHits(worker, channelWaveforms[iChannel], waveformHits);
+      } // for
+    };
+
+  if (workers.size() == 1) runWorker(*workers.front());
+  else {
+    tbb::parallel_for(
+      tbb::blocked_range<std::size_t>{ 0U, workers.size(), 1U },
+      [&](tbb::blocked_range<std::size_t> const& range)
+        {
+          for (std::size_t iWorker = range.begin(); iWorker < range.end();
+            ++iWorker
+          )
+            runWorker(*workers[iWorker]);
+        }
+      );
+  }
+
+  // merge the hits in the same order as the waveforms they come from
+  std::size_t nHits = 0U;
+  for (auto const& hits: waveformHits) nHits += hits.size();
+
+  std::vector<Hit> allHits;
+  allHits.reserve(nHits);
+  for (auto& hits: waveformHits)
+    std::move(hits.begin(), hits.end(), std::back_inserter(allHits));
+
+  return allHits;
+} // opdet::findHitsByChannel()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_OPRECO_ALGORITHMS_CHANNELPARALLELHITFINDING_H
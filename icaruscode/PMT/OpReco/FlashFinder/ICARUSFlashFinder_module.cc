@@ -7,7 +7,8 @@
 // from cetpkgsupport v1_10_02.
 ////////////////////////////////////////////////////////////////////////
 
-#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Core/ReplicatedProducer.h"
+#include "art/Framework/Core/ProcessingFrame.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
@@ -29,9 +30,11 @@
 
 class ICARUSFlashFinder;
 
-class ICARUSFlashFinder : public art::EDProducer {
+// Each replica of this module owns its flash finding algorithm
+// (and its working buffers), so events can be processed concurrently.
+class ICARUSFlashFinder : public art::ReplicatedProducer {
 public:
-  explicit ICARUSFlashFinder(fhicl::ParameterSet const & p);
+  explicit ICARUSFlashFinder(fhicl::ParameterSet const & p, art::ProcessingFrame const& frame);
   // The destructor generated by the compiler is fine for classes
   // without bare pointers or other resource use.
 
@@ -42,7 +45,7 @@ public:
   ICARUSFlashFinder & operator = (ICARUSFlashFinder &&) = delete;
 
   // Required functions.
-  void produce(art::Event & e) override;
+  void produce(art::Event & e, art::ProcessingFrame const& frame) override;
 
 
 private:
@@ -57,8 +60,8 @@ private:
 };
 
 
-ICARUSFlashFinder::ICARUSFlashFinder(pmtana::Config_t const & p)
-  : EDProducer{p}
+ICARUSFlashFinder::ICARUSFlashFinder(pmtana::Config_t const & p, art::ProcessingFrame const& frame)
+  : art::ReplicatedProducer{p, frame}
 // Initialize member data here.
 {
   _hit_producer   = p.get<std::string>("OpHitProducer");
@@ -75,7 +78,7 @@ ICARUSFlashFinder::ICARUSFlashFinder(pmtana::Config_t const & p)
   produces< art::Assns <recob::OpHit, recob::OpFlash> >();
 }
 
-void ICARUSFlashFinder::produce(art::Event & e)
+void ICARUSFlashFinder::produce(art::Event & e, art::ProcessingFrame const&)
 {
 
   // produce OpFlash data-product to be filled within module
@@ -121,7 +124,7 @@ void ICARUSFlashFinder::produce(art::Event & e)
 
     for(auto const& hitidx : lflash.asshit_idx) {
       const art::Ptr<recob::OpHit> hit_ptr(ophit_h, hitidx);
-      util::CreateAssn(*this, e, *opflashes, hit_ptr, *flash2hit_assn_v);
+      util::CreateAssn(e, *opflashes, hit_ptr, *flash2hit_assn_v);
     }
   }
   
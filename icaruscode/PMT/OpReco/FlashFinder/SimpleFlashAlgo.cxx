@@ -2,6 +2,9 @@
 #define SIMPLEFLASHALGO_CXX
 
 #include "SimpleFlashAlgo.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <set>
 namespace pmtana{
     
@@ -106,16 +109,82 @@ namespace pmtana{
     SimpleFlashAlgo::~SimpleFlashAlgo()
     {}
     
+    void SimpleFlashAlgo::FillTimeBins(const LiteOpHitArray_t& ophits, double min_time, size_t nbins)
+    {
+        size_t max_ch = _opch_to_index_v.size() - 1;
+        size_t NOpDet = _index_to_opch_v.size();
+        
+        // clear the bins filled by the previous call
+        for(auto const& bin : _bin_v) _pesum_v[bin.index] = 0;
+        if(_pesum_v.size() < nbins) _pesum_v.resize(nbins,0);
+        _bin_v.clear();
+        _hit_bin_v.clear();
+        _bin_hit_v.clear();
+        _bin_pe_v.clear();
+        if(_pe_slot_v.size() != NOpDet) _pe_slot_v.assign(NOpDet,-1);
+        
+        // Select hits and assign them to their time bin
+        for(size_t hitidx = 0; hitidx < ophits.size(); ++hitidx) {
+            auto const& oph = ophits[hitidx];
+            if(oph.channel > max_ch || _opch_to_index_v[oph.channel] < 0) {
+                if(_debug) std::cout << "Ignoring OpChannel " << oph.channel << std::endl;
+                continue;
+            }
+            if(Veto(oph.peak_time)) {
+                if(_debug) std::cout << "Ignoring hit @ time " << oph.peak_time << std::endl;
+                continue;
+            }
+            if(oph.pe <= 0.) continue;
+            if(_min_pe_hit > 0. && oph.pe < _min_pe_hit) continue;
+            size_t index = (size_t)((oph.peak_time - min_time) / _time_res);
+            _hit_bin_v.emplace_back(index,hitidx);
+        }
+        
+        // group by bin, keeping the hit order within each bin
+        std::sort(_hit_bin_v.begin(),_hit_bin_v.end());
+        _bin_hit_v.reserve(_hit_bin_v.size());
+        
+        auto iHit = _hit_bin_v.cbegin();
+        auto const hend = _hit_bin_v.cend();
+        while(iHit != hend) {
+            TimeBin_t bin;
+            bin.index     = iHit->first;
+            bin.pesum     = 0;
+            bin.mult      = 0;
+            bin.hit_begin = _bin_hit_v.size();
+            bin.pe_begin  = _bin_pe_v.size();
+            for(; iHit != hend && iHit->first == bin.index; ++iHit) {
+                auto const& oph = ophits[iHit->second];
+                int const pmt_index = _opch_to_index_v[oph.channel];
+                bin.pesum += oph.pe;
+                bin.mult  += 1;
+                int& slot = _pe_slot_v[pmt_index];
+                if(slot < 0) {
+                    slot = _bin_pe_v.size();
+                    _bin_pe_v.emplace_back(pmt_index,0.);
+                }
+                _bin_pe_v[slot].second += oph.pe;
+                _bin_hit_v.push_back(iHit->second);
+            }
+            bin.hit_end = _bin_hit_v.size();
+            bin.pe_end  = _bin_pe_v.size();
+            for(size_t i=bin.pe_begin; i<bin.pe_end; ++i) _pe_slot_v[_bin_pe_v[i].first] = -1;
+            _pesum_v[bin.index] = bin.pesum;
+            _bin_v.push_back(bin);
+        }
+    }
+    
+    std::vector<SimpleFlashAlgo::TimeBin_t>::const_iterator SimpleFlashAlgo::FirstBinFrom(size_t index) const
+    {
+        return std::lower_bound(_bin_v.cbegin(), _bin_v.cend(), index,
+                                [](TimeBin_t const& bin, size_t i) { return bin.index < i; });
+    }
+    
     LiteOpFlashArray_t SimpleFlashAlgo::RecoFlash(const LiteOpHitArray_t ophits) {
         
         Reset();
         size_t max_ch = _opch_to_index_v.size() - 1;
-        size_t NOpDet = _index_to_opch_v.size();
         
-        //static std::vector<double> pesum_v;
-        static std::vector<double> mult_v;  //< this is not strictly a multiplicity of PMTs, but multiplicity of hits
-        static std::vector<std::vector<double> > pespec_v;
-        static std::vector<std::vector<unsigned int> > hitidx_v;
         double min_time=1.1e20;
         double max_time=1.1e20;
         for(auto const& oph : ophits) {
@@ -128,58 +197,59 @@ namespace pmtana{
             std::cout << "T span: " << min_time << " => " << max_time << " ... " << (size_t)((max_time - min_time) / _time_res) << std::endl;
         
         size_t nbins_pesum_v = (size_t)((max_time - min_time) / _time_res) + 1;
-        if(_pesum_v.size() < nbins_pesum_v) _pesum_v.resize(nbins_pesum_v,0);
-        if(mult_v.size()   < nbins_pesum_v) mult_v.resize(nbins_pesum_v,0);
-        if(pespec_v.size() < nbins_pesum_v) pespec_v.resize(nbins_pesum_v,std::vector<double>(NOpDet));
-        if(hitidx_v.size() < nbins_pesum_v) hitidx_v.resize(nbins_pesum_v,std::vector<unsigned int>());
-        for(size_t i=0; i<_pesum_v.size(); ++i) {
-            _pesum_v[i] = 0;
-            mult_v[i]  = 0;
-            hitidx_v[i].clear();
-            for(auto& v : pespec_v[i]) v=0;
-        }
         
-        // Fill _pesum_v
-        for(size_t hitidx = 0; hitidx < ophits.size(); ++hitidx) {
-            auto const& oph = ophits[hitidx];
-            if(oph.channel > max_ch || _opch_to_index_v[oph.channel] < 0) {
-                if(_debug) std::cout << "Ignoring OpChannel " << oph.channel << std::endl;
-                continue;
-            }
-            if(Veto(oph.peak_time)) {
-                if(_debug) std::cout << "Ignoring hit @ time " << oph.peak_time << std::endl;
-                continue;
-            }
-	    if(oph.pe <= 0.) continue;
-	    if(_min_pe_hit > 0. && oph.pe < _min_pe_hit) continue;
-            size_t index = (size_t)((oph.peak_time - min_time) / _time_res);
-            _pesum_v[index] += oph.pe;
-            mult_v[index] += 1;
-            pespec_v[index][_opch_to_index_v[oph.channel]] += oph.pe;
-            hitidx_v[index].push_back(hitidx);
-        }
+        // Fill the time bins (only the ones with hits are stored)
+        FillTimeBins(ophits, min_time, nbins_pesum_v);
         
-        // Order by pe (above threshold)
-        std::map<double,size_t> pesum_idx_map;
-        for(size_t idx=0; idx<nbins_pesum_v; ++idx) {
-            if(_pesum_v[idx] < _min_pe_coinc   ) continue;
-            if(mult_v[idx]  < _min_mult_coinc ) continue;
-            pesum_idx_map[1./(_pesum_v[idx])] = idx;
+        // Order by pe (above threshold): highest PE first; among bins with the
+        // same 1/PE value, only the latest one is considered
+        using Candidate_t = std::pair<double,size_t>; // (1/PE, bin index)
+        auto const laterCandidate = [](Candidate_t const& a, Candidate_t const& b)
+            { return (a.first > b.first) || (a.first == b.first && a.second < b.second); };
+        std::vector<Candidate_t> candidate_v;
+        candidate_v.reserve(_bin_v.size() + 1);
+        for(auto const& bin : _bin_v) {
+            if(bin.pesum < _min_pe_coinc   ) continue;
+            if(bin.mult  < _min_mult_coinc ) continue;
+            candidate_v.emplace_back(1./bin.pesum, bin.index);
+        }
+        if(0. >= _min_pe_coinc && 0. >= _min_mult_coinc) {
+            // empty bins qualify as well; they all share 1/PE = infinity
+            size_t idx = nbins_pesum_v;
+            bool found = false;
+            for(auto iBin = _bin_v.crbegin(); idx > 0 && !found; ) {
+                --idx;
+                if(iBin != _bin_v.crend() && iBin->index == idx) ++iBin;
+                else found = true;
+            }
+            if(found)
+                candidate_v.emplace_back(std::numeric_limits<double>::infinity(), idx);
         }
+        std::make_heap(candidate_v.begin(), candidate_v.end(), laterCandidate);
         
         // Get candidate flash times
         std::vector<std::pair<size_t,size_t> > flash_period_v;
         std::vector<size_t> flash_time_v;
+        std::set<size_t> flash_start_s; // start of all accepted flashes
         size_t veto_ctr = (size_t)(_veto_time / _time_res);
         size_t default_integral_ctr = (size_t)(_integral_time / _time_res);
         size_t precount = (size_t)(_pre_sample / _time_res);
-        flash_period_v.reserve(pesum_idx_map.size());
-        flash_time_v.reserve(pesum_idx_map.size());
+        flash_period_v.reserve(candidate_v.size());
+        flash_time_v.reserve(candidate_v.size());
         
         double sum_baseline = 0;
         //for(auto const& v : _pe_baseline_v) sum_baseline += v;
         
-        for(auto const& pe_idx : pesum_idx_map) {
+        bool first_candidate = true;
+        double last_key = 0.;
+        while(!candidate_v.empty()) {
+            
+            std::pop_heap(candidate_v.begin(), candidate_v.end(), laterCandidate);
+            auto const pe_idx = candidate_v.back();
+            candidate_v.pop_back();
+            if(!first_candidate && pe_idx.first == last_key) continue;
+            first_candidate = false;
+            last_key = pe_idx.first;
             
             //auto const& pe  = 1./(pe_idx.first);
             auto const& idx = pe_idx.second;
@@ -188,33 +258,26 @@ namespace pmtana{
             if(start_time < precount) start_time = 0;
             else start_time = idx - precount;
             
-            // see if this idx can be used
+            // see if this idx can be used: the closest accepted flashes
+            // on each side must be out of the veto window
             bool skip=false;
             size_t integral_ctr = default_integral_ctr;
-            for(auto const& used_period : flash_period_v) {
-                if( start_time <= used_period.first && (start_time + veto_ctr) > used_period.first ) {
-                    skip=true;
-                    break;
-                }
-                if( used_period.first <= start_time && start_time < (used_period.first + veto_ctr) ) {
-                    skip=true;
-                    break;
-                }
-                if( used_period.first >= start_time && used_period.first < (start_time + integral_ctr) ) {
+            auto const next_flash = flash_start_s.lower_bound(start_time);
+            if(next_flash != flash_start_s.end()) {
+                if((start_time + veto_ctr) > *next_flash) skip=true;
+                else if(*next_flash < (start_time + integral_ctr)) {
                     if(_debug) std::cout << "Truncating flash @ " << start_time
-                        << " (previous flash @ " << used_period.first
+                        << " (previous flash @ " << *next_flash
                         << ") ... integral ctr change: " << integral_ctr
-                        << " => " << used_period.first - start_time << std::endl;
+                        << " => " << *next_flash - start_time << std::endl;
                     
-                    integral_ctr = used_period.first - start_time;
-                }
-                if(_debug) {
-                    std::cout << "Flash @ " << min_time + used_period.first * _time_res
-                    << " => " << min_time + (used_period.first + used_period.second) * _time_res
-                    << " does not interfare with THIS flash @ " << min_time + start_time * _time_res
-                    << " => " << min_time + (start_time + integral_ctr) * _time_res << std::endl;
+                    integral_ctr = *next_flash - start_time;
                 }
             }
+            if(!skip && next_flash != flash_start_s.begin()) {
+                auto const prev_flash = std::prev(next_flash);
+                if(start_time < (*prev_flash + veto_ctr)) skip=true;
+            }
             if(skip) {
                 if(_debug) std::cout << "Skipping a candidate @ " << min_time + start_time * _time_res << " as it is in a veto window!" <<std::endl;
                 continue;
@@ -222,9 +285,10 @@ namespace pmtana{
             
             // See if this flash is declarable
             double pesum = 0;
-            for(size_t i=start_time; i<std::min(nbins_pesum_v,(start_time+integral_ctr)); ++i)
+            size_t const end_time = std::min(nbins_pesum_v,(start_time+integral_ctr));
+            for(auto iBin = FirstBinFrom(start_time); iBin != _bin_v.cend() && iBin->index < end_time; ++iBin)
                 
-                pesum += _pesum_v[i];
+                pesum += iBin->pesum;
             
             if(pesum < (_min_pe_flash + sum_baseline)) {
                 if(_debug) std::cout << "Skipping a candidate @ " << start_time  << " => " << start_time + integral_ctr
@@ -235,6 +299,7 @@ namespace pmtana{
             
             flash_period_v.push_back(std::pair<size_t,size_t>(start_time,integral_ctr));
             flash_time_v.push_back(idx);
+            flash_start_s.insert(start_time);
         }
         
         // Construct flash
@@ -246,12 +311,16 @@ namespace pmtana{
             auto const& time   = flash_time_v[flash_idx];
             
             std::vector<double> pe_v(max_ch+1,0);
-            for(size_t index=start; index<(start+period) && index<pespec_v.size(); ++index) {
+            std::vector<unsigned int> asshit_v;
+            for(auto iBin = FirstBinFrom(start); iBin != _bin_v.cend() && iBin->index < (start+period); ++iBin) {
                 
-                for(size_t pmt_index=0; pmt_index<NOpDet; ++pmt_index)
+                for(size_t i=iBin->pe_begin; i<iBin->pe_end; ++i)
                     
-                    pe_v[_index_to_opch_v[pmt_index]] += pespec_v[index][pmt_index];
+                    pe_v[_index_to_opch_v[_bin_pe_v[i].first]] += _bin_pe_v[i].second;
                 
+                asshit_v.insert(asshit_v.end(),
+                                _bin_hit_v.begin() + iBin->hit_begin,
+                                _bin_hit_v.begin() + iBin->hit_end);
             }
             
             for(size_t opch=0; opch<max_ch; ++opch) {
@@ -264,12 +333,6 @@ namespace pmtana{
                 
             }
             
-            std::vector<unsigned int> asshit_v;
-            for(size_t index=start; index<(start+period) && index<pespec_v.size(); ++index) {
-                for(auto const& idx : hitidx_v[index])
-                    asshit_v.push_back(idx);
-            }
-            
             if(_debug) {
                 std::cout << "Claiming a flash @ " << min_time + time * _time_res
                 << " : " << std::flush;
@@ -4,9 +4,20 @@
 #include "FlashAlgoBase.h"
 #include "FlashAlgoFactory.h"
 #include <map>
+#include <utility>
+#include <vector>
 namespace pmtana
 {
 
+  /**
+     \class pmtana::SimpleFlashAlgo
+     \brief Clusters optical hits into flashes around the highest PE time bins.
+
+     All the working buffers are owned by the algorithm instance, so that
+     different instances can run concurrently (each instance is still meant to
+     be used by one thread at a time).
+     Only the time bins with hits are stored and visited.
+  */
   class SimpleFlashAlgo : public FlashAlgoBase {
 
   public:
@@ -27,8 +38,25 @@ namespace pmtana
 
   private:
 
+    /// Content of a time bin with at least one hit
+    struct TimeBin_t {
+      size_t index;      ///< index of the bin
+      double pesum;      ///< total PE in the bin
+      double mult;       ///< number of hits in the bin
+      size_t hit_begin;  ///< first hit in `_bin_hit_v`
+      size_t hit_end;    ///< past the last hit in `_bin_hit_v`
+      size_t pe_begin;   ///< first channel PE entry in `_bin_pe_v`
+      size_t pe_end;     ///< past the last channel PE entry in `_bin_pe_v`
+    };
+
     double TotalCharge(const std::vector<double>& PEs);
 
+    /// Bins the hits, filling `_bin_v`, `_bin_hit_v`, `_bin_pe_v` and `_pesum_v`
+    void FillTimeBins(const LiteOpHitArray_t& ophits, double min_time, size_t nbins);
+
+    /// Returns the first bin in `_bin_v` with index not smaller than `index`
+    std::vector<TimeBin_t>::const_iterator FirstBinFrom(size_t index) const;
+
     // minimum PE to account for a hit
     double _min_pe_hit;
 
@@ -68,6 +96,17 @@ namespace pmtana
     // list of opchannel to use
     std::vector<int> _opch_to_index_v;
     std::vector<int> _index_to_opch_v;
+
+    // --- per-instance scratch storage (reused by each RecoFlash() call)
+    // time bins with hits, sorted by index
+    std::vector<TimeBin_t> _bin_v;
+    // (bin index, hit index) of all hits used, then hit indices sorted by bin
+    std::vector<std::pair<size_t,unsigned int> > _hit_bin_v;
+    std::vector<unsigned int> _bin_hit_v;
+    // (opdet index, PE) in each time bin
+    std::vector<std::pair<int,double> > _bin_pe_v;
+    // position of each opdet in the PE entries of the current bin (-1 if none)
+    std::vector<int> _pe_slot_v;
     
   };
 
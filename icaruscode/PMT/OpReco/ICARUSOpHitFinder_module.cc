@@ -9,6 +9,7 @@
 
 // ICARUS libraries
 #include "icaruscode/PMT/OpReco/Algorithms/PedAlgoFixed.h"
+#include "icaruscode/PMT/OpReco/Algorithms/ChannelParallelHitFinding.h"
 #include "icaruscode/PMT/OpReco/Algorithms/OpRecoFactoryStuff.h"
 #include "icaruscode/PMT/Data/WaveformRMS.h"
 #include "sbnobj/ICARUS/PMT/Data/WaveformBaseline.h"
@@ -48,11 +49,11 @@
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/DelegatedParameter.h"
 #include "fhiclcpp/ParameterSet.h"
+#include "tbb/task_arena.h"
 
 // C++ standard libraries
-#include <algorithm> // std::copy_if(), std::binary_search()
+#include <algorithm> // std::sort(), std::binary_search()
 #include <vector>
-#include <variant>
 #include <memory> // std::unique_ptr
 #include <string>
 #include <functional> // std::mem_fn()
@@ -171,6 +172,9 @@ namespace opdet { class ICARUSOpHitFinder; }
  *       by name.
  *     
  * * `HitThreshold` (real): hit threshold [ADC counts]
+ * * `NWorkers` (integer, default: `0`): number of independent sets of hit
+ *   finding algorithms to run in parallel; `0` uses as many as the threads
+ *   available to the job, and `1` runs the hit finding serially.
  * * `UseCalibrator` (flag, default: `false`): if set, use the calibration
  *   service configured in the job; otherwise, use the simpler calibration
  *   configured in this module (see the following parameters).
@@ -198,6 +202,15 @@ namespace opdet { class ICARUSOpHitFinder; }
  * (and multiple managers) but each of them sees an event at a time, in a way
  * that the module (replica) can predict.
  * 
+ * Within an event, the waveforms are grouped by channel (without being copied)
+ * and the channels are processed in parallel (TBB) by a pool of "workers",
+ * each owning its own pulse reconstruction manager, hit finding and pedestal
+ * algorithms, since none of those is thread-safe.
+ * Hits are collected per waveform and merged in the order of the input
+ * waveforms, so the output is the same as the one of a serial processing
+ * (like the one from LArSoft's `RunHitFinder()`) regardless of the number of
+ * workers and of the scheduling.
+ * 
  */
 class opdet::ICARUSOpHitFinder: public art::ReplicatedProducer {
     public:
@@ -233,6 +246,14 @@ class opdet::ICARUSOpHitFinder: public art::ReplicatedProducer {
       false
       };
     
+    fhicl::Atom<unsigned int> NWorkers {
+      Name{ "NWorkers" },
+      Comment{
+        "number of hit finders running in parallel (0: one per available thread)"
+        },
+      0U
+      };
+    
     fhicl::DelegatedParameter HitAlgoPset {
       Name{ "HitAlgoPset" },
       Comment{
@@ -311,19 +332,52 @@ class opdet::ICARUSOpHitFinder: public art::ReplicatedProducer {
   using FWInterfacedPedAlgo
     = opdet::factory::FWInterfacedIF<pmtana::PMTPedestalBase, ArtTraits>;
   
-  pmtana::PulseRecoManager fPulseRecoMgr;
-  std::unique_ptr<pmtana::PMTPulseRecoBase> const fThreshAlg;
-  std::unique_ptr<FWInterfacedPedAlgo> const fPedAlg;
+  /// A complete, independent set of hit finding algorithms.
+  struct HitFinderWorker {
+    pmtana::PulseRecoManager pulseRecoMgr;
+    std::unique_ptr<pmtana::PMTPulseRecoBase> threshAlg;
+    std::unique_ptr<FWInterfacedPedAlgo> pedAlg;
+  }; // HitFinderWorker
+  
+  /// Hit finders, each used by a single thread at a time.
+  std::vector<std::unique_ptr<HitFinderWorker>> fWorkers;
   
   // --- END ---- Algorithms ---------------------------------------------------
   
+  /// Indices of the waveforms in the input collection, one list per channel.
+  using ChannelWaveforms_t = opdet::ChannelWaveforms_t;
+  
+  /// Creates a new worker with the algorithms from the configuration.
+  std::unique_ptr<HitFinderWorker> makeWorker(Config const& config);
+  
   /// Optionally reads the beam gates from `fBeamGateTag`, empty if none.
   std::vector<sim::BeamGateInfo const*> fetchBeamGates
     (art::Event const& event) const;
 
-  /// Returns a vector with copies of only the waveforms not in masked channels.
-  std::vector<raw::OpDetWaveform> selectWaveforms
+  /// Returns the indices of the waveforms not in masked channels, by channel.
+  ChannelWaveforms_t groupWaveformsByChannel
     (std::vector<raw::OpDetWaveform> const& waveforms) const;
+  
+  /**
+   * @brief Finds hits on the specified waveforms of a single channel.
+   * @param worker the set of algorithms to use
+   * @param waveforms all the waveforms of the event
+   * @param channelWaveforms indices of the waveforms to process
+   * @param geom geometry service provider
+   * @param clockData timing information for the event
+   * @param[out] waveformHits hits found on each waveform
+   *
+   * The hits from each waveform are stored in the element of `waveformHits`
+   * with the same index as the waveform.
+   */
+  void findChannelHits(
+    HitFinderWorker& worker,
+    std::vector<raw::OpDetWaveform> const& waveforms,
+    std::vector<std::size_t> const& channelWaveforms,
+    geo::GeometryCore const& geom,
+    detinfo::DetectorClocksData const& clockData,
+    std::vector<std::vector<recob::OpHit>>& waveformHits
+    ) const;
 
 
 }; // opdet::ICARUSOpHitFinder
@@ -433,49 +487,6 @@ namespace {
     { sortVector(v); return v; }
   
   
-  /**
-   * @brief A "smart" pointer that may or may not own its data.
-   * @tparam T type of the data to point to
-   * 
-   * This pointer can be used when depending on a run-time condition a data set
-   * may come from an immutable, owning source (like `art::Event`) or from a
-   * local processing (e.g. a selection of the above).
-   * 
-   * If initialized with a pointer to the data, this pointer will refer to it
-   * without owning; if initialized with a r-value (reference) to data, the data
-   * is stolen and owned from now on.
-   */
-  template <typename T>
-  class MaybeOwnerPtr {
-      public:
-    using element_type = T;
-    using pointer = T*;
-    
-    /// Points to the given pointer without owning it.
-    MaybeOwnerPtr(pointer ptr) noexcept: fStorage{ ptr } {}
-    
-    /// Steals the data and owns it.
-    MaybeOwnerPtr(element_type&& data): fStorage{ std::move(data) } {}
-    
-    pointer get() const { return std::visit(PointerGetter{}, fStorage); }
-    
-    pointer operator->() const { return get(); }
-    auto& operator*() const { return *(get()); }
-    
-      private:
-    
-    struct PointerGetter {
-      pointer operator() (pointer ptr) const noexcept { return ptr; }
-      pointer operator() (element_type& item) const noexcept { return &item; }
-    }; // PointerGetter
-    
-    using store_t = std::variant<element_type, pointer>;
-    
-    store_t fStorage; ///< Contains the data or pointer to it.
-    
-  }; // MaybeOwnerPtr
-  
-  
 } // local namespace
 
 
@@ -491,12 +502,6 @@ opdet::ICARUSOpHitFinder::ICARUSOpHitFinder
   , fUseStartTime{ params().UseStartTime() }
   // caches
   , fMaxOpChannel{ frame.serviceHandle<geo::Geometry>()->MaxOpChannel() }
-  // algorithms
-  , fPulseRecoMgr{}
-  , fThreshAlg
-    { HitAlgoFactory.create(params().HitAlgoPset.get<fhicl::ParameterSet>()) }
-  , fPedAlg
-    { PedAlgoFactory.create(params().PedAlgoPset.get<fhicl::ParameterSet>()) }
 {
   
   //
@@ -522,37 +527,18 @@ opdet::ICARUSOpHitFinder::ICARUSOpHitFinder
   } // if ... else
   
   //
-  // register the algorithms in the manager
+  // create the workers, each with its own algorithms
   //
-  fPulseRecoMgr.AddRecoAlgo(fThreshAlg.get());
-  fPulseRecoMgr.SetDefaultPedAlgo(&(fPedAlg->algo()));
+  unsigned int const nWorkers = (params().NWorkers() > 0U)
+    ? params().NWorkers()
+    : static_cast<unsigned int>(tbb::this_task_arena::max_concurrency());
   
-  // framework hooks to the algorithms
-  if (!fChannelMasks.empty() && (fPedAlg->algo().Name() == "Fixed")) {
-    /* TODO
-     * The reason why this is not working is complicate.
-     * The interface of ophit mini-framework is quite minimal and tight,
-     * it accepts only `std::vector<short>` input and nothing more.
-     * The whole reason of this module is to overcome that limitation;
-     * since there is no channel information, we have to guess which channel
-     * this is the data of, and the way we do it is by address of the data;
-     * `raw::OpDetWaveform` derives from `std::vector<short>`, so when we use
-     * the original data product, the waveform data `std::vector<short>` is
-     * actually the same object and we can compare with the address of the data
-     * product, which we have because of the framework hooks here introduced;
-     * but if the `ChannelMasks` is not empty, we are forced to copy the
-     * original data in a new location (excluding the masked channels) and the
-     * new data has a different address. In principle we could still try to
-     * look for which `raw::OpDetWaveform` data product has the same content as
-     * the `std::vector<short>` we were given, which may be a bit tedious
-     * (thousand of vector comparisons to do, although all except the target one
-     * will be short because the noise pattern are different).
-     */
-    throw art::Exception{ art::errors::Configuration }
-      << "Pedestal algorithm \"Fixed\" will not work"
-      " since a channel mask list is specified.\n";
-  }
-  fPedAlg->initialize(consumesCollector());
+  mf::LogDebug{ "ICARUSOpHitFinder" }
+    << "Hit finding with " << nWorkers << " parallel workers.";
+  
+  fWorkers.reserve(nWorkers);
+  for (unsigned int iWorker = 0; iWorker < nWorkers; ++iWorker)
+    fWorkers.push_back(makeWorker(params()));
   
   //
   // declare output products
@@ -570,31 +556,18 @@ void opdet::ICARUSOpHitFinder::produce
   //
   // read and select the waveforms
   //
-  auto const& allWaveforms
+  auto const& waveforms
     = event.getProduct<std::vector<raw::OpDetWaveform>>(fWaveformTags);
   
-  // this pointer owns the waveforms only if they come from `selectWaveforms()`
-//   MaybeOwnerPtr<std::vector<raw::OpDetWaveform> const> waveforms
-//     = fChannelMasks.empty()? &allWaveforms: selectWaveforms(allWaveforms);
-  using WaveformsPtr_t = MaybeOwnerPtr<std::vector<raw::OpDetWaveform> const>;
-  WaveformsPtr_t waveforms = fChannelMasks.empty()
-    ? WaveformsPtr_t{ &allWaveforms }
-    : WaveformsPtr_t{ selectWaveforms(allWaveforms) }
-    ;
-  
-  if (fChannelMasks.empty() && (&allWaveforms != &*waveforms)) {
-    // if this happens, contact the author
-    throw art::Exception{ art::errors::LogicError }
-      << "Bug in MaybeOwnerPtr!\n";
-  }
-  assert(fChannelMasks.empty() || (&allWaveforms == &*waveforms));
+  ChannelWaveforms_t const channelWaveforms
+    = groupWaveformsByChannel(waveforms);
   
   //
   // run the algorithm
   //
   
   // framework hooks to the algorithms
-  fPedAlg->beginEvent(event);
+  for (auto const& worker: fWorkers) worker->pedAlg->beginEvent(event);
   
   std::vector<sim::BeamGateInfo const*> const beamGateArray
     = fetchBeamGates(event);
@@ -605,24 +578,26 @@ void opdet::ICARUSOpHitFinder::produce
       ->DataFor(event)
     ;
   
-  std::vector<recob::OpHit> opHits;
-
-  RunHitFinder(
-    *waveforms, opHits,
-    fPulseRecoMgr, *fThreshAlg,
-    geom,
-    fHitThreshold,
-    clockData,
-    *fCalib,
-    fUseStartTime
+  // hits are returned in the order of the waveforms they come from
+  std::vector<recob::OpHit> opHits = opdet::findHitsByChannel<recob::OpHit>(
+    fWorkers, channelWaveforms, waveforms.size(),
+    [&](HitFinderWorker& worker, std::vector<std::size_t> const& indices,
+      std::vector<std::vector<recob::OpHit>>& waveformHits)
+      {
+        findChannelHits
+          (worker, waveforms, indices, geom, clockData, waveformHits);
+      }
     );
   
+  std::size_t nSelected = 0U;
+  for (auto const& indices: channelWaveforms) nSelected += indices.size();
+  
   mf::LogInfo{ "ICARUSOpHitFinder" }
-    << "Found " << opHits.size() << " hits from " << waveforms->size()
+    << "Found " << opHits.size() << " hits from " << nSelected
     << " waveforms.";
   
   // framework hooks to the algorithms
-  fPedAlg->endEvent(event);
+  for (auto const& worker: fWorkers) worker->pedAlg->endEvent(event);
   
   //
   // store results into the event
@@ -632,6 +607,30 @@ void opdet::ICARUSOpHitFinder::produce
 } // opdet::ICARUSOpHitFinder::produce()
 
 
+//------------------------------------------------------------------------------
+auto opdet::ICARUSOpHitFinder::makeWorker(Config const& config)
+  -> std::unique_ptr<HitFinderWorker>
+{
+  auto worker = std::make_unique<HitFinderWorker>();
+  
+  worker->threshAlg
+    = HitAlgoFactory.create(config.HitAlgoPset.get<fhicl::ParameterSet>());
+  worker->pedAlg
+    = PedAlgoFactory.create(config.PedAlgoPset.get<fhicl::ParameterSet>());
+  
+  //
+  // register the algorithms in the manager
+  //
+  worker->pulseRecoMgr.AddRecoAlgo(worker->threshAlg.get());
+  worker->pulseRecoMgr.SetDefaultPedAlgo(&(worker->pedAlg->algo()));
+  
+  // framework hooks to the algorithms
+  worker->pedAlg->initialize(consumesCollector());
+  
+  return worker;
+} // opdet::ICARUSOpHitFinder::makeWorker()
+
+
 //------------------------------------------------------------------------------
 std::vector<sim::BeamGateInfo const*> opdet::ICARUSOpHitFinder::fetchBeamGates
   (art::Event const& event) const
@@ -649,22 +648,57 @@ std::vector<sim::BeamGateInfo const*> opdet::ICARUSOpHitFinder::fetchBeamGates
 
 
 //----------------------------------------------------------------------------
-std::vector<raw::OpDetWaveform> opdet::ICARUSOpHitFinder::selectWaveforms
+auto opdet::ICARUSOpHitFinder::groupWaveformsByChannel
   (std::vector<raw::OpDetWaveform> const& waveforms) const
+  -> ChannelWaveforms_t
 {
-  std::vector<raw::OpDetWaveform> selected;
-  
   auto const isNotMasked = [this](raw::OpDetWaveform const& waveform)
     {
       return !std::binary_search
         (fChannelMasks.begin(), fChannelMasks.end(), waveform.ChannelNumber());
     };
   
-  std::copy_if
-    (waveforms.begin(), waveforms.end(), back_inserter(selected), isNotMasked);
+  return opdet::groupWaveformsByChannel(waveforms, isNotMasked);
+} // opdet::ICARUSOpHitFinder::groupWaveformsByChannel()
+
+
+//----------------------------------------------------------------------------
+void opdet::ICARUSOpHitFinder::findChannelHits(
+  HitFinderWorker& worker,
+  std::vector<raw::OpDetWaveform> const& waveforms,
+  std::vector<std::size_t> const& channelWaveforms,
+  geo::GeometryCore const& geom,
+  detinfo::DetectorClocksData const& clockData,
+  std::vector<std::vector<recob::OpHit>>& waveformHits
+) const {
+  
+  // this mirrors `opdet::RunHitFinder()`, one channel at a time
+  int const channel
+    = static_cast<int>(waveforms[channelWaveforms.front()].ChannelNumber());
+  if (!geom.IsValidOpChannel(channel)) {
+    mf::LogError{ "ICARUSOpHitFinder" }
+      << "Error! unrecognized channel number " << channel << ". Ignoring "
+      << channelWaveforms.size() << " pulses";
+    return;
+  }
+  
+  for (std::size_t const iWaveform: channelWaveforms) {
+    raw::OpDetWaveform const& waveform = waveforms[iWaveform];
+    
+    // the waveform is passed by reference, so that algorithms like
+    // `pmtana::PedAlgoFixed` can identify it by its address
+    worker.pulseRecoMgr.Reconstruct(waveform);
+    
+    double const timeStamp = waveform.TimeStamp();
+    for (auto const& pulse: worker.threshAlg->GetPulses()) {
+      ConstructHit(
+        fHitThreshold, channel, timeStamp, pulse, waveformHits[iWaveform],
+        clockData, *fCalib, fUseStartTime
+        );
+    } // for pulses
+  } // for waveforms
   
-  return selected;
-} // selectWaveforms()
+} // opdet::ICARUSOpHitFinder::findChannelHits()
 
 
 // -----------------------------------------------------------------------------
@@ -11,10 +11,13 @@
 #include "cetlib_except/exception.h"
 
 #include "icaruscode/PMT/OpticalTools/IOpHitFinder.h"
+#include "icaruscode/PMT/Algorithms/MostProbableBaseline.h"
 #include "larreco/HitFinder/HitFinderTools/ICandidateHitFinder.h"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <vector>
 
 namespace light
 {
@@ -165,38 +168,11 @@ void OpHitFinder::FindOpHits(const raw::OpDetWaveform& opDetWaveform,
 
 float OpHitFinder::getBaseline(const raw::OpDetWaveform& locWaveform) const
 {
-    // Fill a map to determine the most probable value
-    std::map<raw::ADC_Count_t,int> adcFrequencyMap;
+    // The baseline algorithm reuses its histogram across waveforms, so each thread
+    // running this (const) tool gets its own
+    thread_local opdet::MostProbableBaseline baselineAlg;
     
-    raw::ADC_Count_t maxBin(0);
-    int              maxCount(0);
-    
-    for(const auto& adc : locWaveform)
-    {
-        int& adcFrequency = adcFrequencyMap[adc];
-        
-        if (++adcFrequency > maxCount)
-        {
-            maxBin   = adc;
-            maxCount = adcFrequency;
-        }
-    }
-    
-    float mostProbableBaseline(0.);
-    int   mostProbableCount(0);
-    
-    for(raw::ADC_Count_t adcBin = maxBin - 3; adcBin <= maxBin + 3; adcBin++)
-    {
-        try{
-            mostProbableBaseline += adcFrequencyMap.at(adcBin) * float(adcBin);
-            mostProbableCount    += adcFrequencyMap.at(adcBin);
-        }
-        catch(...) {}
-    }
-    
-    mostProbableBaseline /= mostProbableCount;
-   
-    return mostProbableBaseline;
+    return baselineAlg(locWaveform);
 }
 
     
@@ -7,6 +7,7 @@
 
 // ICARUS libraries
 #include "icaruscode/PMT/Algorithms/SharedWaveformBaseline.h"
+#include "icaruscode/PMT/Algorithms/RunningWaveformBaseline.h"
 #include "icaruscode/PMT/Data/WaveformRMS.h"
 #include "sbnobj/ICARUS/PMT/Data/WaveformBaseline.h"
 #include "sbnobj/Common/PMT/Data/PMTconfiguration.h"
@@ -49,6 +50,10 @@
 #include "TGraph.h"
 #include "TProfile.h"
 
+// TBB libraries
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 // C/C++ standard libraries
 #include <vector>
 #include <algorithm> // std::remove_if(), std::sort()
@@ -107,6 +112,15 @@ namespace icarus { class PMTWaveformBaselinesFromChannelData; }
  * 
  * The result of the `opdet::SharedWaveformBaseline` is currently used directly
  * as the baseline for all the waveforms on the channel on that event.
+ * The channels are processed in parallel (via TBB).
+ * 
+ * Optionally (`RunningBaselineWeight` parameter), the baseline of each channel
+ * can be carried over from one event to the next, for example in online
+ * monitoring: the baseline (and RMS) assigned to a channel is then the
+ * weighted average of the one extracted from the current event and the one
+ * assigned in the previous event which had waveforms on that channel.
+ * This running state is reset at the beginning of each run, and it requires
+ * the events to be processed one at a time, in order.
  * 
  * @todo Add run-level information and checks.
  * 
@@ -193,6 +207,12 @@ namespace icarus { class PMTWaveformBaselinesFromChannelData; }
  *         the baseline, there must be less than this number of samples in a
  *         row that are outside of the range defined by
  *         `AcceptedSampleRangeRMS` parameter.
+ * * `RunningBaselineWeight` (real, default: `0`): weight of the baseline from
+ *     the previous events in the baseline assigned in the current one; the
+ *     weight of the baseline extracted from the current event is the
+ *     complement to `1`. With the default value `0`, each event is processed
+ *     independently. Values larger than `0` make the module process one event
+ *     at a time.
  * * `PlotBaselines` (flag, default: `true`): whether to produce distributions
  *   of the extracted baselines.
  * * `BaselineTimeAverage` (real number, default: `600.0`): binning of the
@@ -273,6 +293,15 @@ class icarus::PMTWaveformBaselinesFromChannelData: public art::SharedProducer {
         Comment{ "baseline algorithm parameters" }
       };
     
+    fhicl::Atom<double> RunningBaselineWeight {
+      Name{ "RunningBaselineWeight" },
+      Comment{
+        "weight of the baseline from the previous events in the current one"
+        " (0: each event is independent)"
+      },
+      0.0
+      };
+    
     fhicl::Atom<bool> PlotBaselines {
       Name{ "PlotBaselines" },
       Comment{ "produce plots on the extracted baseline" },
@@ -345,6 +374,9 @@ class icarus::PMTWaveformBaselinesFromChannelData: public art::SharedProducer {
   /// Parameters for the baseline algorithm.
   opdet::SharedWaveformBaseline::Params_t fAlgoParams;
   
+  /// Weight of the running baseline from the previous events.
+  double const fRunningBaselineWeight;
+  
   bool const fPlotBaselines; ///< Whether to produce plots.
   
   /// Width of baseline time profile binning [s]
@@ -373,6 +405,9 @@ class icarus::PMTWaveformBaselinesFromChannelData: public art::SharedProducer {
     icarus::WaveformRMS RMS;
   }; // BaselineInfo_t
   
+  /// Baseline carried over from the previous events, per channel.
+  opdet::RunningWaveformBaseline fRunningBaselines;
+  
   std::size_t fNPlotChannels = 0U; ///< Number of plotted channels
   TH2* fHBaselines = nullptr; ///< All baselines, per channel.
   
@@ -468,6 +503,7 @@ icarus::PMTWaveformBaselinesFromChannelData::PMTWaveformBaselinesFromChannelData
   , fPMTconfigTag(config().PMTconfigurationTag())
   , fSampleFraction(config().PretriggerBufferFractionForBaseline())
   , fAlgoParams(config().AlgoParams())
+  , fRunningBaselineWeight(config().RunningBaselineWeight())
   , fPlotBaselines(config().PlotBaselines())
   , fBaselineTimeAverage(config().BaselineTimeAverage())
   , fLogCategory(config().OutputCategory())
@@ -478,11 +514,14 @@ icarus::PMTWaveformBaselinesFromChannelData::PMTWaveformBaselinesFromChannelData
         .OpticalClockPeriod()
     )
   // algorithms
+  , fRunningBaselines(fRunningBaselineWeight)
 {
   
   if (fPlotBaselines)
 //     serialize<art::InEvent>(art::TFileService::resource_name()); // TODO isn't art supposed to provide this method?
       serializeExternal<art::InEvent>(std::string{ "TFileService" });
+  else if (fRunningBaselineWeight > 0.0)
+    serialize<art::InEvent>();
   else
     async<art::InEvent>();
   
@@ -498,6 +537,13 @@ icarus::PMTWaveformBaselinesFromChannelData::PMTWaveformBaselinesFromChannelData
       << "' (with a positive value) must be specified!\n";
   }
   
+  if ((fRunningBaselineWeight < 0.0) || (fRunningBaselineWeight >= 1.0)) {
+    throw art::Exception(art::errors::Configuration)
+      << "Parameter '" << config().RunningBaselineWeight.name()
+      << "' must be in [ 0 ; 1 [ (" << fRunningBaselineWeight
+      << " specified).\n";
+  }
+  
   //
   // configuration report
   //
@@ -505,6 +551,10 @@ icarus::PMTWaveformBaselinesFromChannelData::PMTWaveformBaselinesFromChannelData
     mf::LogInfo log{ fLogCategory };
     log << "Using the standard (median) algorithm, waveform by waveform, on '"
       << fOpDetWaveformTag.encode() << "'";
+    if (fRunningBaselineWeight > 0.0) {
+      log << "; baselines are carried across events with weight "
+        << fRunningBaselineWeight;
+    }
   }
   
   //
@@ -560,6 +610,9 @@ void icarus::PMTWaveformBaselinesFromChannelData::beginRun
     fAlgoParams.dump(log, " - ");
   }
   
+  // the running baselines do not survive a change of run
+  fRunningBaselines.reset();
+  
 } // icarus::PMTWaveformBaselinesFromChannelData::beginRun()
 
 
@@ -599,42 +652,75 @@ void icarus::PMTWaveformBaselinesFromChannelData::produce
   
   auto waveformsByChannel = groupByChannel(waveforms);
   
+  //
+  // extract the baselines, one channel per task
+  //
+  std::vector<opdet::SharedWaveformBaseline::BaselineInfo_t> extractedBaselines
+    (waveformsByChannel.size());
+  
+  auto const extractChannelBaseline = [&](std::size_t channel)
+    {
+      auto& waveforms = waveformsByChannel[channel];
+      if (waveforms.empty()) return;
+      
+      mf::LogTrace{ fLogCategory }
+        << "Processing " << waveforms.size() << " waveforms for channel "
+        << channel;
+      
+      //
+      // remove global trigger waveform
+      //
+      if (waveforms.size() >= fExcludeSpillTimeIfMoreThan) {
+        
+        unsigned int const nExcluded
+          = removeWaveformsAround(waveforms, triggerTime.value());
+        if (nExcluded > 0U) {
+          mf::LogTrace{ fLogCategory }
+            << "Removed " << nExcluded << "/" << (waveforms.size() + nExcluded)
+            << " waveforms at trigger time " << triggerTime;
+        }
+        
+      } // if many waveforms
+      
+      //
+      // extract baseline
+      //
+      extractedBaselines[channel] = sharedWaveformBaselineAlgo(waveforms);
+      
+    }; // extractChannelBaseline()
+  
+  tbb::parallel_for(
+    tbb::blocked_range<std::size_t>{ 0U, waveformsByChannel.size() },
+    [&extractChannelBaseline](tbb::blocked_range<std::size_t> const& range)
+      {
+        for (std::size_t channel = range.begin(); channel < range.end();
+          ++channel
+        ) {
+          extractChannelBaseline(channel);
+        }
+      }
+    );
+  
+  //
+  // collect the baselines (and plot them)
+  //
   for (auto const& [ channel, waveforms ]: util::enumerate(waveformsByChannel))
   {
     if (waveforms.empty()) continue;
     
-    mf::LogTrace{ fLogCategory }
-      << "Processing " << waveforms.size() << " waveforms for channel "
-      << channel;
-    
-    //
-    // remove global trigger waveform
-    //
-    if (waveforms.size() >= fExcludeSpillTimeIfMoreThan) {
-      
-      unsigned int const nExcluded
-        = removeWaveformsAround(waveforms, triggerTime.value());
-      if (nExcluded > 0U) {
-        mf::LogTrace{ fLogCategory }
-          << "Removed " << nExcluded << "/" << (waveforms.size() + nExcluded)
-          << " waveforms at trigger time " << triggerTime;
-      }
-      
-    } // if many waveforms
+    opdet::SharedWaveformBaseline::BaselineInfo_t const& extracted
+      = extractedBaselines[channel];
     
-    //
-    // extract baseline
-    //
-    opdet::SharedWaveformBaseline::BaselineInfo_t const baseline
-      = sharedWaveformBaselineAlgo(waveforms);
-
     mf::LogTrace{ fLogCategory }
-      << "Channel " << channel << ": baseline " << baseline.baseline
-      << " ADC# from " << baseline.nSamples << " samples in "
-      << baseline.nWaveforms << "/" << waveforms.size()
-      << " waveforms; found RMS=" << baseline.RMS << " ADC#";
+      << "Channel " << channel << ": baseline " << extracted.baseline
+      << " ADC# from " << extracted.nSamples << " samples in "
+      << extracted.nWaveforms << "/" << waveforms.size()
+      << " waveforms; found RMS=" << extracted.RMS << " ADC#";
     
     auto const chIndex = static_cast<std::size_t>(channel);
+    opdet::SharedWaveformBaseline::BaselineInfo_t const baseline
+      = fRunningBaselines.update(chIndex, extracted);
+    
     baselineForChannel(chIndex) = { baseline.baseline, baseline.RMS };
     
     if (fHBaselines) fHBaselines->Fill(double(channel), baseline.baseline);
@@ -50,6 +50,9 @@ namespace icarus::trigger {
  * The algorithm keeps track at each time of which are the thresholds enclosing
  * the signal level, and if the level crosses one of them, the gates associated
  * to those thresholds, and only them, are offered a chance to react.
+ * 
+ * Channels are processed in parallel: the gate information objects created by
+ * the gate manager must only act on their own gate.
  */
 class icarus::trigger::ManagedTriggerGateBuilder
   : public icarus::trigger::TriggerGateBuilder
@@ -19,24 +19,28 @@
 
 // ICARUS libraries
 #include "icaruscode/PMT/Trigger/Algorithms/TriggerTypes.h" // icarus::trigger::ADCCounts_t
+#include "icaruscode/PMT/Trigger/Algorithms/details/ThresholdLevelScan.h"
 #include "icarusalg/Utilities/WaveformOperations.h"
 
 // LArSoft libraries
 #include "lardataobj/RawData/OpDetWaveform.h"
-#include "larcorealg/CoreUtils/counter.h"
-// #include "larcorealg/CoreUtils/StdUtils.h" // util::to_string()
 
 // framework libraries
 #include "messagefacility/MessageLogger/MessageLogger.h" // MF_LOG_TRACE()
 
 // range library
 #include "range/v3/view/group_by.hpp"
+#include "range/v3/view/subrange.hpp"
+
+// TBB libraries
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
 
 // C/C++ standard libraries
-#include <optional>
-#include <iterator> // std::next(), std::prev()
+#include <type_traits> // std::decay_t
 #include <cmath> // std::round()
-#include <cstddef> // std::ptrdiff_t
+#include <cstddef> // std::ptrdiff_t, std::size_t
+#include <cassert>
 
 
 //------------------------------------------------------------------------------
@@ -47,8 +51,10 @@ auto icarus::trigger::ManagedTriggerGateBuilder::unifiedBuild
   (GateMgr&& gateManager, std::vector<WaveformWithBaseline> const& waveforms)
   const -> std::vector<TriggerGates>
 {
-  using GateManager_t = GateMgr;
+  using GateManager_t = std::decay_t<GateMgr>;
   using GateInfo_t = typename GateManager_t::GateInfo_t;
+  using ChannelWaveforms_t = ranges::subrange
+    <std::vector<WaveformWithBaseline>::const_iterator>;
   
   /*
    * This is the simple algorithm where each channel is treated independently,
@@ -62,14 +68,21 @@ auto icarus::trigger::ManagedTriggerGateBuilder::unifiedBuild
   raw::Channel_t channel = InvalidChannel;
   
   // now group the waveforms by channel (must be already sorted!)
-  // and process waveforms channel by channel
   auto sameChannel
     = [] (WaveformWithBaseline const& a, WaveformWithBaseline const& b)
       { return a.waveform().ChannelNumber() == b.waveform().ChannelNumber(); }
     ;
   
-  auto byChannel = waveforms | ranges::views::group_by(sameChannel);
-  for (auto const& channelWaveforms: byChannel) {
+  std::vector<ChannelWaveforms_t> byChannel;
+  for (auto const& channelWaveforms
+    : waveforms | ranges::views::group_by(sameChannel)
+  ) {
+    byChannel.emplace_back(channelWaveforms.begin(), channelWaveforms.end());
+  }
+  
+  // create all the gates first, so that they are not moved around any more
+  // while the channels are processed
+  for (ChannelWaveforms_t const& channelWaveforms: byChannel) {
     
     auto const& firstWaveform = channelWaveforms.front().waveform();
     
@@ -82,23 +95,41 @@ auto icarus::trigger::ManagedTriggerGateBuilder::unifiedBuild
     if (firstWaveform.ChannelNumber() != channel)
       channel = firstWaveform.ChannelNumber();
     
-    // we don't know how many... (maybe C++20 ranges will tell us)
-    MF_LOG_TRACE(details::TriggerGateDebugLog)
-      << "Building trigger gates from waveforms on channel " << channel;
-    
-    std::vector<GateInfo_t> channelGates;
-    channelGates.reserve(nChannelThresholds());
-    for (TriggerGates& thrGates: allGates) {
-      channelGates.push_back 
-        (gateManager.create(thrGates.gateFor(firstWaveform)));
-    }
-    
-    // this method will update the channel gates referenced in `channelGates`,
-    // which are owned by `allGates`
-    buildChannelGates(channelGates, channelWaveforms);
+    for (TriggerGates& thrGates: allGates) thrGates.gateFor(firstWaveform);
     
   } // for channels
   
+  // process waveforms channel by channel; each channel updates only its gates
+  auto processChannels = [&](tbb::blocked_range<std::size_t> const& range)
+    {
+      for (std::size_t iChannel = range.begin(); iChannel != range.end();
+        ++iChannel
+      ) {
+        ChannelWaveforms_t const& channelWaveforms = byChannel[iChannel];
+        auto const& firstWaveform = channelWaveforms.front().waveform();
+        
+        // we don't know how many... (maybe C++20 ranges will tell us)
+        MF_LOG_TRACE(details::TriggerGateDebugLog)
+          << "Building trigger gates from waveforms on channel "
+          << firstWaveform.ChannelNumber();
+        
+        std::vector<GateInfo_t> channelGates;
+        channelGates.reserve(nChannelThresholds());
+        for (TriggerGates& thrGates: allGates) {
+          channelGates.push_back 
+            (gateManager.create(thrGates.gateFor(firstWaveform)));
+        }
+        
+        // this method will update the channel gates referenced in
+        // `channelGates`, which are owned by `allGates`
+        buildChannelGates(channelGates, channelWaveforms);
+        
+      } // for channels
+    }; // processChannels()
+  
+  tbb::parallel_for
+    (tbb::blocked_range<std::size_t>(0U, byChannel.size()), processChannels);
+  
   return allGates;
 } // icarus::trigger::ManagedTriggerGateBuilder::unifiedBuild()
 
@@ -126,13 +157,36 @@ void icarus::trigger::ManagedTriggerGateBuilder::buildChannelGates(
   optical_tick lastWaveformTick [[gnu::unused]]
     = timeStampToOpticalTick(firstWaveform.TimeStamp());
   
+  std::vector<ADCCounts_t> const& thresholds = channelThresholds();
+  std::size_t const nThresholds = thresholds.size();
+  
   /*
    * The algorithm finds gate openings and closing.
    * The actual actions on opening and closing depends on the gate info class.
    * For example, while a dynamic gate duration algorithm will perform open and
    * close operations directly, a fixed gate duration algorithm may perform
    * both opening and closing at open time, and nothing at all at closing time.
+   * 
+   * The state of the discrimination is the "level" of the waveform, that is
+   * the number of thresholds the current sample has reached (thresholds are
+   * sorted). Gates react only when the level changes: when it rises, the gates
+   * of all the thresholds passed are notified in increasing threshold order,
+   * and when it falls, the gates of the thresholds left are notified in
+   * decreasing order.
+   * 
+   * Since the waveform has negative polarity, a sample reaches a threshold
+   * when its raw value is at or below a "cut" value, which depends on the
+   * threshold and on the baseline of the waveform: all thresholds are
+   * translated into raw sample cuts once per waveform, and the waveform level
+   * does not change as long as the raw samples stay within the cuts of the
+   * current level. That range check is quickly applied to many samples at
+   * once (`details::scanThresholdLevels()`).
    */
+  
+  // for each threshold, the highest raw sample value reaching it;
+  // non-increasing with the threshold
+  std::vector<int> sampleCuts(nThresholds);
+  
   unsigned int nWaveforms = 0U;
   for (auto const& waveformData: channelWaveforms) {
 
@@ -141,11 +195,12 @@ void icarus::trigger::ManagedTriggerGateBuilder::buildChannelGates(
     ops const waveOps { waveformData.baseline().baseline() };
     
     // baseline subtraction is performed in floating point,
-    // but then rounding is applied again
-    auto subtractBaseline = [waveOps](float sample) -> ADCCounts_t
+    // but then rounding is applied again (as `ADCCounts_t`);
+    // this returns whether the `sample` reaches the `threshold`
+    auto const reaches = [waveOps](int sample, ADCCounts_t threshold)
       {
-        return
-          ADCCounts_t::castFrom(std::round(waveOps.subtractBaseline(sample)));
+        return std::round(waveOps.subtractBaseline(static_cast<float>(sample)))
+          >= static_cast<float>(threshold.value());
       };
     
     
@@ -168,145 +223,54 @@ void icarus::trigger::ManagedTriggerGateBuilder::buildChannelGates(
     assert(lastWaveformTick <= waveformTickStart);
     lastWaveformTick = waveformTickEnd;
     
-    auto const tbegin = channelThresholds().begin();
-    auto const tend = channelThresholds().end();
-    
     // register this waveform with the gates (this feature is unused here)
     for (auto& gateInfo: channelGates) gateInfo.addTrackingInfo(waveform);
     
-    // all gates start closed; this gate is not necessarily closed, but the
-    // waveform is not above the gate threshold any more.
-    auto nextGateToOpen = channelGates.begin();
+    // translate the thresholds into raw sample cuts
+    details::computeSampleCuts(nThresholds,
+      [&reaches,&thresholds](int sample, std::size_t iThr)
+        { return reaches(sample, thresholds[iThr]); },
+      sampleCuts
+      );
     
-    // we keep track of whether we have no lower or higher thresholds available
-    // to simplify the checks;
-    // we name them "pp" because they behave (almost) like pointers to pointers
-    #if defined( __GNUC__ )
-    # pragma GCC diagnostic push
-    # if (__GNUC__ <= 9) // last tested with: GCC 9.3.0
-    #  pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-    # else
-    #  error "Maintenance required here. See comments in the code"
-    /* [20210715 petrillo@slac.stanford.edu] The comments in the code:
-     * GCC 9.3.0 erroneously thinks that `ppXxxerThreshold` value _might_ be
-     * used before initialization. Due to the logic of the program, that is
-     * not the case (unless I am wrong!), and the only "solution" I have found
-     * is to disable the warning; Clang 7 on the other end does not complain.
-     * When GCC is updated and support for GCC 9 is dropped, this situation
-     * should be revisited by attempting the compilation with the warning
-     * still enabled (by just commenting out the #error directive).
-     * If compilation succeeds, this whole block and the `pop` directive below
-     * have become unnecessary and should be removed. Otherwise, the GCC version
-     * in the check above should be bumped up to cover the last tested GCC
-     * (here I went lazy and stuck to just the major version).
-     * I do not know which newer GCC version, if any, solves this issue so far.
-     */
-    # endif // GCC version
-    #endif // GCC
-    using ThresholdIterPtr_t
-      = std::optional<std::vector<ADCCounts_t>::const_iterator>;
-    // start at bottom with no lower threshold:
-    ThresholdIterPtr_t ppLowerThreshold = std::nullopt;
-    ThresholdIterPtr_t ppUpperThreshold = std::nullopt;
-    if (!channelThresholds().empty())
-      ppUpperThreshold = channelThresholds().begin(); // std::optional behavior
+    auto const tickOf = [waveformTickStart](std::size_t iSample)
+      {
+        return waveformTickStart
+          + optical_time_ticks{ static_cast<std::ptrdiff_t>(iSample) };
+      };
     
-    for (auto iSample: util::counter<std::ptrdiff_t>(waveform.size())) {
-      
-      // baseline subtraction is always a subtraction (as in "A minus B"),
-      // regardless the polarity of the waveform
-      auto const sample = waveform[iSample];
-      ADCCounts_t const relSample = subtractBaseline(sample);
-      
-      /* // this is too much also for regular debugging...
-      MF_LOG_TRACE(details::TriggerGateDebugLog)
-        << "Sample #" << iSample << ": " << sample << " [=> " << relSample
-        << "]; thresholds lower: "
-          << (ppLowerThreshold? util::to_string(**ppLowerThreshold): "none")
-        << ", upper: "
-          << (ppUpperThreshold? util::to_string(**ppUpperThreshold): "none")
-        ;
-      */
-      
-      //
-      // if this sample is lower than the current lower threshold,
-      // we are just tracking the thresholds: gate closing has already happened
-      //
-      if (ppLowerThreshold && (relSample < **ppLowerThreshold)) {
-        
+    // all gates start closed: the scan starts from level `0`
+    
+    //
+    // if the sample is lower than a threshold already reached,
+    // we are just tracking the thresholds: gate closing has already happened
+    //
+    auto const onFall = [&](std::size_t iThr, std::size_t iSample)
+      {
         MF_LOG_TRACE(details::TriggerGateDebugLog)
-          << "Sample " << sample << " (" << relSample << " on "
-          << waveOps.baseline() << ") leaving thresholds at "
-          << waveformTickStart << " + " << optical_time_ticks{ iSample };
-        
-        do { // we keep opening gates at increasing thresholds
-          
-          // if there is an lower threshold, there must also be a open gate!
-          assert(nextGateToOpen != channelGates.begin());
-          
-          
-          (--nextGateToOpen)->belowThresholdAt
-            (waveformTickStart + optical_time_ticks{ iSample });
-          
-          MF_LOG_TRACE(details::TriggerGateDebugLog)
-            << "  => decreasing threshold " << **ppLowerThreshold;
-          
-          if (*ppLowerThreshold == tbegin) { // was this the bottom threshold?
-            ppLowerThreshold = std::nullopt;
-            break;
-          }
-          --*ppLowerThreshold; // point to previous threshold
-          
-        } while (relSample < **ppLowerThreshold);
-        
-        // we can't be at the top since we just closed a gate
-        ppUpperThreshold
-          = ppLowerThreshold? std::next(*ppLowerThreshold): tbegin;
-        
-      } // if closing gate
-      
-      //
-      // if this sample is greater or matching the next threshold,
-      // we *are* opening gate(s)
-      //
-      else if (ppUpperThreshold && (relSample >= **ppUpperThreshold)) {
-        
+          << "Sample " << waveform[iSample] << " (on " << waveOps.baseline()
+          << ") leaving threshold " << thresholds[iThr]
+          << " at " << tickOf(iSample);
+        channelGates[iThr].belowThresholdAt(tickOf(iSample));
+      };
+    
+    //
+    // if the sample is greater or matching the next threshold,
+    // we *are* opening gate(s);
+    // note that it is not guaranteed that gates at lower thresholds are
+    // still open (that depends on the builder implementation)
+    //
+    auto const onRaise = [&](std::size_t iThr, std::size_t iSample)
+      {
         MF_LOG_TRACE(details::TriggerGateDebugLog)
-          << "Sample " << sample << " (" << relSample << " on "
-          << waveOps.baseline() << ") passing thresholds at "
-          << waveformTickStart << " + " << optical_time_ticks{ iSample };
-        
-        do { // we keep opening gates at increasing thresholds
-          
-          // note that it is not guaranteed that gates at lower thresholds are
-          // still open (that depends on the builder implementation)
-          
-          // if there is an upper threshold, there must also be a closed gate!
-          assert(nextGateToOpen != channelGates.end());
-          
-          MF_LOG_TRACE(details::TriggerGateDebugLog)
-            << "Opening thr=" << (**ppUpperThreshold);
-          
-          (nextGateToOpen++)->aboveThresholdAt
-            (waveformTickStart + optical_time_ticks{ iSample });
-          
-          if (++*ppUpperThreshold == tend) { // was this the top threshold?
-            ppUpperThreshold = std::nullopt;
-            break;
-          }
-          
-        } while (relSample >= **ppUpperThreshold);
-        
-        // we can't be at the bottom since we just opened a gate
-        ppLowerThreshold = std::prev(ppUpperThreshold? *ppUpperThreshold: tend);
-        
-      } // if opening gate
-      
-    } // for threshold
-
-    #if defined( __GNUC__ )
-    # pragma GCC diagnostic pop
-    #endif // __clang__
+          << "Sample " << waveform[iSample] << " (on " << waveOps.baseline()
+          << ") passing threshold " << thresholds[iThr]
+          << " at " << tickOf(iSample);
+        channelGates[iThr].aboveThresholdAt(tickOf(iSample));
+      };
+    
+    details::scanThresholdLevels
+      (waveform.data(), waveform.size(), sampleCuts, onRaise, onFall);
     
   } // for waveforms
   
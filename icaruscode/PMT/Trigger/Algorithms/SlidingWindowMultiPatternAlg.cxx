@@ -0,0 +1,108 @@
+/**
+ * @file   icaruscode/PMT/Trigger/Algorithms/SlidingWindowMultiPatternAlg.cxx
+ * @brief  Applies many sliding window trigger patterns on the same input.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/Trigger/Algorithms/SlidingWindowMultiPatternAlg.h
+ */
+
+
+// library header
+#include "icaruscode/PMT/Trigger/Algorithms/SlidingWindowMultiPatternAlg.h"
+
+// LArSoft libraries
+#include "larcorealg/CoreUtils/counter.h"
+
+// C/C++ standard libraries
+#include <utility> // std::move()
+#include <cassert>
+
+
+//------------------------------------------------------------------------------
+icarus::trigger::SlidingWindowMultiPatternAlg::SlidingWindowMultiPatternAlg(
+  WindowTopology_t windowTopology,
+  WindowPatterns_t windowPatterns,
+  icarus::trigger::ApplyBeamGateClass beamGate,
+  std::string const& logCategory /* = "SlidingWindowMultiPatternAlg" */
+  )
+  : icarus::ns::util::mfLoggingClass(logCategory)
+  , fWindowTopology(std::move(windowTopology))
+  , fWindowPatterns(std::move(windowPatterns))
+  , fBeamGate(std::move(beamGate))
+  {}
+
+
+//------------------------------------------------------------------------------
+icarus::trigger::SlidingWindowMultiPatternAlg::SlidingWindowMultiPatternAlg(
+  WindowTopology_t windowTopology,
+  WindowPatterns_t windowPatterns,
+  std::string const& logCategory /* = "SlidingWindowMultiPatternAlg" */
+  )
+  : icarus::ns::util::mfLoggingClass(logCategory)
+  , fWindowTopology(std::move(windowTopology))
+  , fWindowPatterns(std::move(windowPatterns))
+  {}
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::SlidingWindowMultiPatternAlg::simulateResponses
+  (TriggerGates_t const& gates) const -> std::vector<AllTriggerInfo_t>
+{
+  
+  // ensures input gates are in the same order as the configured windows
+  icarus::trigger::SlidingWindowPatternAlg::verifyInputTopology
+    (fWindowTopology, gates);
+  
+  //
+  // 1. sample all the gates (after the beam gate, if any) once
+  //
+  if (fBeamGate) fRaster.fill(fBeamGate->applyToAll(gates));
+  else           fRaster.fill(gates);
+  
+  mfLogTrace() << "Input gates sampled in " << fRaster.nIntervals()
+    << " intervals for " << fRaster.nWindows() << " windows";
+  
+  //
+  // 2. apply each pattern on the same sampling
+  //
+  std::vector<AllTriggerInfo_t> responses;
+  responses.reserve(fWindowPatterns.size());
+  for (WindowPattern_t const& pattern: fWindowPatterns)
+    responses.push_back(simulatePatternResponse(pattern));
+  
+  return responses;
+} // icarus::trigger::SlidingWindowMultiPatternAlg::simulateResponses()
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::SlidingWindowMultiPatternAlg::simulatePatternResponse
+  (WindowPattern_t const& pattern) const -> AllTriggerInfo_t
+{
+  AllTriggerInfo_t triggerInfo; // start empty
+  
+  for (std::size_t const iWindow: util::counter(fWindowTopology.nWindows())) {
+    
+    TriggerInfo_t windowResponse
+      = fRaster.applyWindowPattern(fWindowTopology.info(iWindow), pattern);
+    
+    if (!windowResponse) continue;
+    
+    assert(windowResponse.hasLocation());
+    assert(windowResponse.location() == iWindow);
+    mfLogTrace() << "Pattern " << pattern.tag() << " fired "
+      << windowResponse.nTriggers() << " times on window #" << iWindow
+      << ", first at tick " << windowResponse.atTick();
+    
+    // pick the main window with the earliest successful response;
+    // on ties, the window with the smallest index is kept
+    if (!triggerInfo || triggerInfo.info.atTick() > windowResponse.atTick()) {
+      triggerInfo.info = std::move(windowResponse);
+      triggerInfo.extra.windowIndex = iWindow;
+    }
+    
+  } // for windows
+  
+  return triggerInfo;
+} // icarus::trigger::SlidingWindowMultiPatternAlg::simulatePatternResponse()
+
+
+//------------------------------------------------------------------------------
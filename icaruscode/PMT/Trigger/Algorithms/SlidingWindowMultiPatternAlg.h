@@ -0,0 +1,170 @@
+/**
+ * @file   icaruscode/PMT/Trigger/Algorithms/SlidingWindowMultiPatternAlg.h
+ * @brief  Applies many sliding window trigger patterns on the same input.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/Trigger/Algorithms/SlidingWindowMultiPatternAlg.cxx
+ */
+
+#ifndef ICARUSCODE_PMT_TRIGGER_ALGORITHMS_SLIDINGWINDOWMULTIPATTERNALG_H
+#define ICARUSCODE_PMT_TRIGGER_ALGORITHMS_SLIDINGWINDOWMULTIPATTERNALG_H
+
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Algorithms/SlidingWindowPatternAlg.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowGateRaster.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowChannelMap.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowPattern.h"
+#include "icaruscode/PMT/Trigger/Algorithms/ApplyBeamGate.h"
+#include "icarusalg/Utilities/mfLoggingClass.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <optional>
+#include <string>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::trigger { class SlidingWindowMultiPatternAlg; }
+/**
+ * @brief Applies a set of sliding window patterns to the same window gates.
+ * 
+ * This algorithm is equivalent to a collection of
+ * `icarus::trigger::SlidingWindowPatternAlg`, one per pattern, all sharing the
+ * same window topology and beam gate, and it returns for each pattern the same
+ * response as the corresponding `SlidingWindowPatternAlg::simulateResponse()`.
+ * 
+ * Instead of combining the trigger gates of each window anew for each pattern
+ * and each window, the input gates are sampled only once per event into a
+ * `icarus::trigger::WindowGateRaster`, and all the requirements of all the
+ * patterns are evaluated as bit masks on that common sampling. Requirements
+ * shared by several patterns (e.g. the same threshold on the same window) are
+ * evaluated only once.
+ * 
+ * The input is one trigger gate per window, in window index order, as for
+ * `SlidingWindowPatternAlg`.
+ * 
+ * The algorithm keeps the sampled gates as internal cache, and it is
+ * therefore not thread-safe.
+ */
+class icarus::trigger::SlidingWindowMultiPatternAlg
+  : public icarus::ns::util::mfLoggingClass
+{
+  
+    public:
+  
+  /// Record of the trigger response.
+  using TriggerInfo_t = icarus::trigger::SlidingWindowPatternAlg::TriggerInfo_t;
+  
+  /// A list of trigger gates from input.
+  using TriggerGates_t = icarus::trigger::SlidingWindowPatternAlg::TriggerGates_t;
+  
+  /// Type holding information about composition and topology of all windows.
+  using WindowTopology_t
+    = icarus::trigger::SlidingWindowPatternAlg::WindowTopology_t;
+  
+  /// Type representing the requirement pattern for a window.
+  using WindowPattern_t
+    = icarus::trigger::SlidingWindowPatternAlg::WindowPattern_t;
+  
+  /// Type of list of patterns.
+  using WindowPatterns_t = std::vector<WindowPattern_t>;
+  
+  /// Complete information from this algorithm, standard + non-standard (extra).
+  using AllTriggerInfo_t
+    = icarus::trigger::SlidingWindowPatternAlg::AllTriggerInfo_t;
+  
+  
+  /**
+   * @brief Constructor: configures window topology, patterns and times.
+   * @param windowTopology full composition and topology description of windows
+   * @param windowPatterns the patterns that this algorithm applies
+   * @param beamGate object applying the beam gate to trigger gates
+   * @param logCategory category tag for algorithm messages on screen
+   * 
+   * See `icarus::trigger::SlidingWindowPatternAlg` constructor for details.
+   */
+  SlidingWindowMultiPatternAlg(
+    WindowTopology_t windowTopology,
+    WindowPatterns_t windowPatterns,
+    icarus::trigger::ApplyBeamGateClass beamGate,
+    std::string const& logCategory = "SlidingWindowMultiPatternAlg"
+    );
+  
+  /**
+   * @brief Constructor: configures window topology and patterns.
+   * @param windowTopology full composition and topology description of windows
+   * @param windowPatterns the patterns that this algorithm applies
+   * @param logCategory category tag for algorithm messages on screen
+   * 
+   * No beam gate is applied (the full input gates are used) until one is set
+   * via `setBeamGate()`.
+   */
+  SlidingWindowMultiPatternAlg(
+    WindowTopology_t windowTopology,
+    WindowPatterns_t windowPatterns,
+    std::string const& logCategory = "SlidingWindowMultiPatternAlg"
+    );
+  
+  
+  /// Returns the number of configured patterns.
+  std::size_t nPatterns() const { return fWindowPatterns.size(); }
+  
+  /// Returns the configured patterns.
+  WindowPatterns_t const& patterns() const { return fWindowPatterns; }
+  
+  /**
+   * @brief Returns the trigger response of all patterns to the `gates`.
+   * @param gates the trigger gates to be used as input, one per window
+   * @return the response to each configured pattern, in configuration order
+   * @throw cet::exception (category: `SlidingWindowPatternAlg`) if `gates`
+   *        do not match the configured window topology
+   * 
+   * The response for each pattern is the same as
+   * `SlidingWindowPatternAlg::simulateResponse()`: the trigger is located in
+   * the window that fires first, and in case of ties in the window with the
+   * smallest index.
+   */
+  std::vector<AllTriggerInfo_t> simulateResponses
+    (TriggerGates_t const& gates) const;
+  
+  
+  /// Returns whether a beam gate is being applied.
+  bool hasBeamGate() const { return fBeamGate.has_value(); }
+  
+  /// Changes the beam gate to the specified value.
+  void setBeamGate(icarus::trigger::ApplyBeamGateClass beamGate)
+    { fBeamGate.emplace(std::move(beamGate)); }
+  
+  /// Do not apply any beam gate.
+  void clearBeamGate() { fBeamGate.reset(); }
+  
+  
+    private:
+  
+  /// Type of sampled gates.
+  using Raster_t = icarus::trigger::WindowGateRaster
+    <icarus::trigger::SlidingWindowPatternAlg::TriggerGateData_t::GateData_t>;
+  
+  /// Definition of the neighborhood of each window in terms of window indices.
+  WindowTopology_t const fWindowTopology;
+  
+  /// Requirement patterns to be applied to each window.
+  WindowPatterns_t const fWindowPatterns;
+  
+  /// Time interval when to evaluate the trigger.
+  std::optional<icarus::trigger::ApplyBeamGateClass const> fBeamGate;
+  
+  mutable Raster_t fRaster; ///< Sampling of the current input gates (cache).
+  
+  
+  /// Returns the response of `pattern` from the gates in `fRaster`.
+  AllTriggerInfo_t simulatePatternResponse
+    (WindowPattern_t const& pattern) const;
+  
+}; // class icarus::trigger::SlidingWindowMultiPatternAlg
+
+
+//------------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_TRIGGER_ALGORITHMS_SLIDINGWINDOWMULTIPATTERNALG_H
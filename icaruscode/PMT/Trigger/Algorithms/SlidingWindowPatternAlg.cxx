@@ -136,7 +136,7 @@ void icarus::trigger::SlidingWindowPatternAlg::clearBeamGate()
 
 //------------------------------------------------------------------------------
 void icarus::trigger::SlidingWindowPatternAlg::verifyInputTopology
-  (TriggerGates_t const& gates) const
+  (WindowTopology_t const& windowTopology, TriggerGates_t const& gates)
 {
   /*
    * Verifies that the `gates` are in the expected order and have
@@ -149,7 +149,7 @@ void icarus::trigger::SlidingWindowPatternAlg::verifyInputTopology
     std::string windowError; // if this stays `empty()` there is no error
     
     // more input gates than windows?
-    if (iWindow >= fWindowTopology.nWindows()) {
+    if (iWindow >= windowTopology.nWindows()) {
       windowError = "unexpected input gate #" + std::to_string(iWindow) + " (";
       for (raw::Channel_t const channel: gate.channels())
         windowError += " " + std::to_string(channel);
@@ -159,7 +159,7 @@ void icarus::trigger::SlidingWindowPatternAlg::verifyInputTopology
     }
     
     WindowTopology_t::WindowInfo_t const& windowInfo
-      = fWindowTopology.info(iWindow);
+      = windowTopology.info(iWindow);
     
     auto const channelInWindow
       = [begin=windowInfo.channels.cbegin(),end=windowInfo.channels.cend()]
@@ -181,10 +181,10 @@ void icarus::trigger::SlidingWindowPatternAlg::verifyInputTopology
   } // for gates
 
   // more input gates than windows?
-  if (fWindowTopology.nWindows() > size(gates)) {
+  if (windowTopology.nWindows() > size(gates)) {
     errorMsg +=
       "Not enough input gates: " + std::to_string(size(gates)) + " gates for "
-      + std::to_string(fWindowTopology.nWindows()) + " windows\n";
+      + std::to_string(windowTopology.nWindows()) + " windows\n";
   }
   
   if (errorMsg.empty()) return;
@@ -196,7 +196,7 @@ void icarus::trigger::SlidingWindowPatternAlg::verifyInputTopology
     << errorMsg
     << "\n" // empty line
     << "Window configuration: "
-    << fWindowTopology << "\n";
+    << windowTopology << "\n";
   
 } // icarus::trigger::SlidingWindowPatternAlg::verifyInputTopology()
 
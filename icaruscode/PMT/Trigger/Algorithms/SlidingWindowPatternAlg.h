@@ -242,19 +242,28 @@ class icarus::trigger::SlidingWindowPatternAlg
     TriggerGates_t const& gates
     ) const;
   
+  /// Checks `gates` are compatible with the current window configuration.
+  /// @see `verifyInputTopology(WindowTopology_t const&, TriggerGates_t const&)`
+  void verifyInputTopology(TriggerGates_t const& gates) const
+    { verifyInputTopology(fWindowTopology, gates); }
+  
+  
+    public:
+  
   /**
-   * @brief Checks `gates` are compatible with the current window configuration.
+   * @brief Checks `gates` are compatible with the specified window topology.
+   * @param windowTopology the window configuration to check against
    * @param gates the combined sliding window trigger gates, per cryostat
-   * @throw cet::exception (category: `SlidingWindowTriggerEfficiencyPlots`)
+   * @throw cet::exception (category: `SlidingWindowPatternAlg`)
    *        or derived, if an incompatibility is found
    * 
-   * The method verifies that the current channel mapping is compatible with the
-   * gates.
+   * The method verifies that the channel mapping is compatible with the gates.
    * 
    * This currently means that the `gates` are in the expected order and have
    * the expected channel content.
    */
-  void verifyInputTopology(TriggerGates_t const& gates) const;
+  static void verifyInputTopology
+    (WindowTopology_t const& windowTopology, TriggerGates_t const& gates);
   
 }; // class icarus::trigger::SlidingWindowPatternAlg
 
@@ -0,0 +1,431 @@
+/**
+ * @file   icaruscode/PMT/Trigger/Algorithms/WindowGateRaster.h
+ * @brief  Rasterized opening levels of sliding window gates.
+ * @date   October 18, 2026
+ *
+ * This library is header-only.
+ */
+
+#ifndef ICARUSCODE_PMT_TRIGGER_ALGORITHMS_WINDOWGATERASTER_H
+#define ICARUSCODE_PMT_TRIGGER_ALGORITHMS_WINDOWGATERASTER_H
+
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Algorithms/WindowChannelMap.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowPattern.h"
+#include "icaruscode/PMT/Trigger/Algorithms/details/TriggerInfo_t.h"
+#include "icaruscode/PMT/Trigger/Utilities/TrackedTriggerGate.h" // gateDataIn()
+
+// LArSoft libraries
+#include "lardataalg/DetectorInfo/DetectorTimingTypes.h" // optical_tick
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::unique(), std::max_element()
+#include <map>
+#include <vector>
+#include <utility> // std::pair, std::declval()
+#include <type_traits> // std::decay_t
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+#include <cassert>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::trigger { template <typename GateData> class WindowGateRaster; }
+/**
+ * @brief Opening levels of all the window gates of an event, on a common grid.
+ * @tparam GateData type of trigger gate data (`icarus::trigger::TriggerGateData`)
+ *
+ * All the gates (one per sliding window) are sampled once, at all the ticks
+ * where any of them changes its opening level. Between two consecutive such
+ * ticks, each window has a constant level, so the time axis is reduced to a
+ * list of _intervals_; the first interval starts at `MinTick`, and the last
+ * one extends up to `MaxTick`. Levels are stored contiguously per window.
+ *
+ * A window requirement ("at least _N_ openings") is represented as a bit mask
+ * on the intervals, 64 intervals per word, which is computed once per event,
+ * window and threshold, and then reused by all the patterns needing it.
+ * A pattern is then the bitwise AND of its requirements, and the trigger
+ * openings are the runs of set bits in the result.
+ *
+ * `applyWindowPattern()` returns the same response as
+ * `icarus::trigger::SlidingWindowPatternAlg::applyWindowPattern()` on the same
+ * gates: the time of each opening is the start of the run, its level the
+ * highest level of the main window (or of the sum of main and opposite windows
+ * when a sum requirement is present) during the run.
+ *
+ * The requirement masks are cached on demand, so this object is not
+ * thread-safe even when used via constant methods.
+ */
+template <typename GateData>
+class icarus::trigger::WindowGateRaster {
+
+    public:
+
+  /// Type of trigger gate data.
+  using GateData_t = GateData;
+
+  /// Type of tick in the trigger gate data.
+  using ClockTick_t = typename GateData_t::ClockTick_t;
+
+  /// Type of trigger gate opening level.
+  using Opening_t = typename GateData_t::OpeningCount_t;
+
+  /// Record of the trigger response.
+  using TriggerInfo_t = icarus::trigger::details::TriggerInfo_t;
+
+  /// Topology of a window (index and neighbours).
+  using WindowTopology_t = icarus::trigger::WindowChannelMap::WindowTopology_t;
+
+  /// Type representing the requirement pattern for a window.
+  using WindowPattern_t = icarus::trigger::WindowPattern;
+
+  /// Type of the word holding the state of 64 intervals.
+  using Word_t = std::uint64_t;
+
+  /// Bit mask on all the intervals.
+  using BitMask_t = std::vector<Word_t>;
+
+
+  /// Constructor: an empty raster (no window).
+  WindowGateRaster() = default;
+
+  /// Constructor: rasterizes the specified `gates` (see `fill()`).
+  template <typename Gates>
+  explicit WindowGateRaster(Gates const& gates) { fill(gates); }
+
+  /**
+   * @brief Rasterizes all the `gates`, one per window.
+   * @tparam Gates type of collection of gates
+   * @param gates the gates to sample, one per window in window index order
+   *
+   * The gates can be of any type supported by `gateDataIn()`. Any previous
+   * content is discarded.
+   */
+  template <typename Gates>
+  void fill(Gates const& gates);
+
+
+  /// Returns the number of rasterized windows.
+  std::size_t nWindows() const { return fNWindows; }
+
+  /// Returns the number of intervals with constant opening levels.
+  std::size_t nIntervals() const { return fStarts.size(); }
+
+  /// Returns the first tick of the specified `interval`.
+  ClockTick_t intervalStart(std::size_t interval) const
+    { return fStarts[interval]; }
+
+  /// Returns the opening level of a `window` during an `interval`.
+  Opening_t level(std::size_t window, std::size_t interval) const
+    { return levels(window)[interval]; }
+
+
+  /**
+   * @brief Returns the trigger response for the specified window pattern.
+   * @param windowInfo the topology of the main window
+   * @param pattern the trigger requirement pattern
+   * @return a `TriggerInfo_t` record with the response of the pattern
+   *
+   * The window indices in `windowInfo` refer to the order of the gates in
+   * the last `fill()` call.
+   */
+  TriggerInfo_t applyWindowPattern
+    (WindowTopology_t const& windowInfo, WindowPattern_t const& pattern) const;
+
+
+    private:
+
+  static constexpr ClockTick_t MinTick = GateData_t::MinTick;
+  static constexpr ClockTick_t MaxTick = GateData_t::MaxTick;
+
+  static constexpr std::size_t WordBits = 64U;
+
+  std::size_t fNWindows = 0U; ///< Number of windows.
+
+  /// First tick of each interval (the first one is `MinTick`).
+  std::vector<ClockTick_t> fStarts;
+
+  /// Levels of all windows: all intervals of window `0`, then `1`...
+  std::vector<Opening_t> fLevels;
+
+  /// Levels of main plus opposite window, per window pair (cached).
+  mutable std::map<std::pair<std::size_t, std::size_t>, std::vector<Opening_t>>
+    fSumLevels;
+
+  /// Requirement masks by source (window or sum) and threshold (cached).
+  mutable std::map<std::pair<std::size_t, Opening_t>, BitMask_t> fMasks;
+
+
+  /// Returns a pointer to the levels of the specified `window`.
+  Opening_t const* levels(std::size_t window) const
+    { return fLevels.data() + window * nIntervals(); }
+
+  /// Returns a pointer to the levels of window plus its opposite.
+  Opening_t const* sumLevels(WindowTopology_t const& windowInfo) const;
+
+  /// Returns the mask source ID of the sum of window plus its opposite.
+  /// Sources up to `nWindows()` are single windows, the others are sums.
+  std::size_t sumSource(WindowTopology_t const& windowInfo) const
+    {
+      return windowInfo.hasOppositeWindow()
+        ? fNWindows * (windowInfo.index + 1) + windowInfo.opposite
+        : windowInfo.index;
+    }
+
+  /// Returns the mask of intervals where `levels` are at least `threshold`.
+  BitMask_t const& atLeast
+    (std::size_t source, Opening_t const* levels, Opening_t threshold) const;
+
+  /// Number of words needed to hold a bit mask.
+  std::size_t nWords() const { return (nIntervals() + WordBits - 1) / WordBits; }
+
+  /// Returns the first interval from `from` on with bit `value` in `mask`.
+  std::size_t findNext
+    (BitMask_t const& mask, std::size_t from, bool value) const;
+
+  /// Adds to `ticks` all the ticks where `gate` changes opening level.
+  static void collectChangeTicks
+    (GateData_t const& gate, std::vector<ClockTick_t>& ticks);
+
+  /// Index of the lowest bit set in a non-zero `word`.
+  static unsigned int lowestBit(Word_t word);
+
+}; // class icarus::trigger::WindowGateRaster<>
+
+
+// -----------------------------------------------------------------------------
+// ---  template implementation
+// -----------------------------------------------------------------------------
+template <typename GateData>
+template <typename Gates>
+void icarus::trigger::WindowGateRaster<GateData>::fill(Gates const& gates) {
+
+  fSumLevels.clear();
+  fMasks.clear();
+
+  //
+  // 1. find all the ticks where any of the gates changes its opening level
+  //
+  fStarts.assign(1U, MinTick);
+  fNWindows = 0U;
+  for (auto const& gate: gates) {
+    collectChangeTicks(gateDataIn(gate), fStarts);
+    ++fNWindows;
+  }
+  std::sort(fStarts.begin(), fStarts.end());
+  fStarts.erase(std::unique(fStarts.begin(), fStarts.end()), fStarts.end());
+
+  //
+  // 2. sample each gate at the start of each interval
+  //
+  std::size_t const nInt = nIntervals();
+  fLevels.resize(fNWindows * nInt);
+  auto iLevel = fLevels.begin();
+  for (auto const& gate: gates) {
+    GateData_t const& data = gateDataIn(gate);
+    for (ClockTick_t const tick: fStarts) *(iLevel++) = data.openingCount(tick);
+  } // for
+  assert(iLevel == fLevels.end());
+
+} // icarus::trigger::WindowGateRaster<>::fill()
+
+
+// -----------------------------------------------------------------------------
+template <typename GateData>
+auto icarus::trigger::WindowGateRaster<GateData>::applyWindowPattern
+  (WindowTopology_t const& windowInfo, WindowPattern_t const& pattern) const
+  -> TriggerInfo_t
+{
+  /*
+   * 1. check that the pattern can be applied; if not, return no trigger
+   * 2. combine in AND the masks of all the requirements
+   * 3. each run of intervals passing all requirements is a trigger opening
+   */
+  TriggerInfo_t res; // no trigger by default
+
+  //
+  // 1. check that the pattern can be applied; if not, return no trigger
+  //
+  if (pattern.requireUpstreamWindow && !windowInfo.hasUpstreamWindow())
+    return res;
+  if (pattern.requireDownstreamWindow && !windowInfo.hasDownstreamWindow())
+    return res;
+
+  //
+  // 2. combine in AND the masks of all the requirements
+  //
+  std::size_t const main = windowInfo.index;
+
+  // the trigger primitive has the levels of the main or main+opposite window
+  // depending on the requirements
+  bool const useSum = (pattern.minSumInOppositeWindows > 0U);
+  std::size_t const baseSource = useSum? sumSource(windowInfo): main;
+  Opening_t const* baseLevels = useSum? sumLevels(windowInfo): levels(main);
+
+  // the primitive needs to be open to start with
+  BitMask_t pass = atLeast(baseSource, baseLevels, 1U);
+
+  auto const require
+    = [this,&pass](std::size_t source, Opening_t const* lvl, Opening_t min)
+    {
+      BitMask_t const& mask = atLeast(source, lvl, min);
+      for (std::size_t i = 0; i < pass.size(); ++i) pass[i] &= mask[i];
+    };
+
+  if (pattern.minInMainWindow > 0U)
+    require(main, levels(main), pattern.minInMainWindow);
+
+  if ((pattern.minInOppositeWindow > 0U) && windowInfo.hasOppositeWindow()) {
+    require(windowInfo.opposite, levels(windowInfo.opposite),
+      pattern.minInOppositeWindow);
+  }
+
+  if (useSum)
+    require(baseSource, baseLevels, pattern.minSumInOppositeWindows);
+
+  if ((pattern.minInUpstreamWindow > 0U) && windowInfo.hasUpstreamWindow()) {
+    require(windowInfo.upstream, levels(windowInfo.upstream),
+      pattern.minInUpstreamWindow);
+  }
+
+  if ((pattern.minInDownstreamWindow > 0U) && windowInfo.hasDownstreamWindow())
+  {
+    require(windowInfo.downstream, levels(windowInfo.downstream),
+      pattern.minInDownstreamWindow);
+  }
+
+  //
+  // 3. each run of intervals passing all requirements is a trigger opening
+  //
+  std::size_t const nInt = nIntervals();
+  std::size_t start = findNext(pass, 0U, true);
+  while (start < nInt) {
+    std::size_t const end = findNext(pass, start + 1, false);
+    Opening_t const level
+      = *std::max_element(baseLevels + start, baseLevels + end);
+    res.add({
+      detinfo::timescales::optical_tick{ fStarts[start] },
+      level,
+      main
+      });
+    if (end >= nInt) break;
+    start = findNext(pass, end + 1, true);
+  } // while
+
+  return res;
+
+} // icarus::trigger::WindowGateRaster<>::applyWindowPattern()
+
+
+// -----------------------------------------------------------------------------
+template <typename GateData>
+auto icarus::trigger::WindowGateRaster<GateData>::sumLevels
+  (WindowTopology_t const& windowInfo) const -> Opening_t const*
+{
+  // without an opposite window the sum is just the main window
+  if (!windowInfo.hasOppositeWindow()) return levels(windowInfo.index);
+
+  auto [ it, added ]
+    = fSumLevels.try_emplace({ windowInfo.index, windowInfo.opposite });
+  std::vector<Opening_t>& sum = it->second;
+  if (added) {
+    std::size_t const nInt = nIntervals();
+    Opening_t const* main = levels(windowInfo.index);
+    Opening_t const* opposite = levels(windowInfo.opposite);
+    sum.resize(nInt);
+    for (std::size_t i = 0; i < nInt; ++i) sum[i] = main[i] + opposite[i];
+  }
+  return sum.data();
+} // icarus::trigger::WindowGateRaster<>::sumLevels()
+
+
+// -----------------------------------------------------------------------------
+template <typename GateData>
+auto icarus::trigger::WindowGateRaster<GateData>::atLeast
+  (std::size_t source, Opening_t const* levels, Opening_t threshold) const
+  -> BitMask_t const&
+{
+  auto [ it, added ] = fMasks.try_emplace({ source, threshold });
+  BitMask_t& mask = it->second;
+  if (!added) return mask;
+
+  std::size_t const nInt = nIntervals();
+  mask.assign(nWords(), Word_t{ 0 });
+  std::size_t iInt = 0;
+  for (Word_t& word: mask) {
+    std::size_t const nBits = std::min(WordBits, nInt - iInt);
+    Word_t bits = 0;
+    for (std::size_t b = 0; b < nBits; ++b)
+      bits |= Word_t{ levels[iInt + b] >= threshold } << b;
+    word = bits;
+    iInt += nBits;
+  } // for
+
+  return mask;
+} // icarus::trigger::WindowGateRaster<>::atLeast()
+
+
+// -----------------------------------------------------------------------------
+template <typename GateData>
+std::size_t icarus::trigger::WindowGateRaster<GateData>::findNext
+  (BitMask_t const& mask, std::size_t from, bool value) const
+{
+  std::size_t const nInt = nIntervals();
+  if (from >= nInt) return nInt;
+
+  std::size_t iWord = from / WordBits;
+  Word_t const flip = value? Word_t{ 0 }: ~Word_t{ 0 };
+  // mask away the bits before `from` in the first word
+  Word_t word = (mask[iWord] ^ flip) & (~Word_t{ 0 } << (from % WordBits));
+  while (word == 0) {
+    if (++iWord >= mask.size()) return nInt;
+    word = mask[iWord] ^ flip;
+  }
+  return std::min(iWord * WordBits + lowestBit(word), nInt);
+} // icarus::trigger::WindowGateRaster<>::findNext()
+
+
+// -----------------------------------------------------------------------------
+template <typename GateData>
+void icarus::trigger::WindowGateRaster<GateData>::collectChangeTicks
+  (GateData_t const& gate, std::vector<ClockTick_t>& ticks)
+{
+  /*
+   * Each change of level crosses at least one threshold: for each level `k`
+   * the ticks where the gate reaches `k` or drops below it are collected,
+   * with the same searches as `icarus::trigger::discriminate()`.
+   */
+  for (Opening_t k = 1U; ; ++k) {
+    ClockTick_t tick = gate.findOpen(k, MinTick);
+    if (tick == MaxTick) break; // never reaching this level
+    do {
+      ticks.push_back(tick);
+      tick = gate.findClose(k, tick);
+      if (tick == MaxTick) break;
+      ticks.push_back(tick);
+      tick = gate.findOpen(k, tick);
+    } while (tick != MaxTick);
+  } // for levels
+} // icarus::trigger::WindowGateRaster<>::collectChangeTicks()
+
+
+// -----------------------------------------------------------------------------
+template <typename GateData>
+unsigned int icarus::trigger::WindowGateRaster<GateData>::lowestBit
+  (Word_t word)
+{
+  assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(word);
+#else
+  unsigned int bit = 0U;
+  while (!(word & 1U)) { word >>= 1; ++bit; }
+  return bit;
+#endif
+} // icarus::trigger::WindowGateRaster<>::lowestBit()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_TRIGGER_ALGORITHMS_WINDOWGATERASTER_H
@@ -0,0 +1,90 @@
+/**
+ * @file   icaruscode/PMT/Trigger/Algorithms/details/SampleRangeScan.h
+ * @brief  Fast search of the first waveform sample out of a range.
+ * @date   October 18, 2026
+ *
+ * This library is header-only.
+ */
+
+#ifndef ICARUSCODE_PMT_TRIGGER_ALGORITHMS_DETAILS_SAMPLERANGESCAN_H
+#define ICARUSCODE_PMT_TRIGGER_ALGORITHMS_DETAILS_SAMPLERANGESCAN_H
+
+// C/C++ standard libraries
+#include <cstdint> // std::int16_t
+#include <cstddef> // std::size_t
+
+#if defined(__SSE2__)
+# include <emmintrin.h>
+#endif // __SSE2__
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::trigger::details {
+
+  /**
+   * @brief Returns the index of the first sample not in `[ lower, upper ]`.
+   * @tparam Sample type of the sample
+   * @param samples pointer to the first sample of the waveform
+   * @param nSamples total number of samples in the waveform
+   * @param first index of the first sample to be tested
+   * @param lower the lowest sample value in the range
+   * @param upper the highest sample value in the range
+   * @return the index of the first sample out of range, or `nSamples` if none
+   *
+   * Samples before `first` are ignored.
+   * This generic version is a plain sequential search.
+   */
+  template <typename Sample>
+  std::size_t findSampleOutside(
+    Sample const* samples, std::size_t nSamples, std::size_t first,
+    Sample lower, Sample upper
+    )
+    {
+      for (std::size_t i = first; i < nSamples; ++i)
+        if ((samples[i] < lower) || (samples[i] > upper)) return i;
+      return nSamples;
+    }
+
+
+  /**
+   * @brief Returns the index of the first sample not in `[ lower, upper ]`.
+   * @see `findSampleOutside(Sample const*, std::size_t, std::size_t, Sample, Sample)`
+   *
+   * Version for 16-bit samples (like `raw::ADC_Count_t`): when SSE2 is
+   * available, eight samples at a time are compared against both ends of the
+   * range, and the comparison result is reduced to a bit mask whose lowest set
+   * bit points to the first sample out of the range.
+   */
+  inline std::size_t findSampleOutside(
+    std::int16_t const* samples, std::size_t nSamples, std::size_t first,
+    std::int16_t lower, std::int16_t upper
+    )
+  {
+    std::size_t i = first;
+
+#if defined(__SSE2__)
+    constexpr std::size_t Lanes = sizeof(__m128i) / sizeof(std::int16_t);
+    __m128i const vLower = _mm_set1_epi16(lower);
+    __m128i const vUpper = _mm_set1_epi16(upper);
+    for (; i + Lanes <= nSamples; i += Lanes) {
+      __m128i const v
+        = _mm_loadu_si128(reinterpret_cast<__m128i const*>(samples + i));
+      __m128i const outside = _mm_or_si128
+        (_mm_cmplt_epi16(v, vLower), _mm_cmpgt_epi16(v, vUpper));
+      // two mask bits per 16-bit sample
+      unsigned int const mask = _mm_movemask_epi8(outside);
+      if (mask != 0U) return i + (__builtin_ctz(mask) / 2U);
+    } // for
+#endif // __SSE2__
+
+    return findSampleOutside<std::int16_t>
+      (samples, nSamples, i, lower, upper);
+
+  } // findSampleOutside(std::int16_t)
+
+} // namespace icarus::trigger::details
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_TRIGGER_ALGORITHMS_DETAILS_SAMPLERANGESCAN_H
@@ -0,0 +1,158 @@
+/**
+ * @file   icaruscode/PMT/Trigger/Algorithms/details/ThresholdLevelScan.h
+ * @brief  Discrimination of a waveform against a set of sorted thresholds.
+ * @date   October 18, 2026
+ *
+ * This library is header-only.
+ */
+
+#ifndef ICARUSCODE_PMT_TRIGGER_ALGORITHMS_DETAILS_THRESHOLDLEVELSCAN_H
+#define ICARUSCODE_PMT_TRIGGER_ALGORITHMS_DETAILS_THRESHOLDLEVELSCAN_H
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Algorithms/details/SampleRangeScan.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::clamp()
+#include <limits> // std::numeric_limits
+#include <utility> // std::pair
+#include <vector>
+#include <cstdint> // std::int16_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::trigger::details {
+
+  /**
+   * @brief Translates thresholds into cuts on the raw sample values.
+   * @tparam Reaches type of the threshold test
+   * @param nThresholds number of thresholds
+   * @param reaches `reaches(sample, iThreshold)` tells whether the raw
+   *                `sample` value reaches the threshold number `iThreshold`
+   * @param[out] sampleCuts for each threshold, the highest raw sample reaching it
+   *
+   * The samples are assumed to have negative polarity: if a raw value reaches
+   * a threshold, all the lower values do too.
+   * A cut lower than the lowest 16-bit value means that no sample can reach
+   * the threshold, and one higher than the highest that all samples do.
+   */
+  template <typename Reaches>
+  void computeSampleCuts
+    (std::size_t nThresholds, Reaches reaches, std::vector<int>& sampleCuts);
+
+
+  /**
+   * @brief Reports each change of the number of thresholds a waveform reaches.
+   * @tparam OnRaise type of the callable reacting to a threshold being reached
+   * @tparam OnFall type of the callable reacting to a threshold being left
+   * @param samples pointer to the first sample of the waveform
+   * @param nSamples number of samples in the waveform
+   * @param sampleCuts the thresholds, as from `computeSampleCuts()`
+   * @param onRaise called as `onRaise(iThreshold, iSample)`
+   * @param onFall called as `onFall(iThreshold, iSample)`
+   *
+   * The "level" of the waveform is the number of thresholds (sorted in
+   * increasing order) its current sample reaches, and it starts at `0`.
+   * When a sample raises the level, `onRaise` is called for each of the
+   * thresholds passed, in increasing order; when a sample lowers it, `onFall`
+   * is called for each of the thresholds left, in decreasing order.
+   * This is the same sequence as a sample-by-sample comparison yields, but
+   * the samples which do not change the level are skipped in blocks
+   * (`findSampleOutside()`).
+   */
+  template <typename OnRaise, typename OnFall>
+  void scanThresholdLevels(
+    std::int16_t const* samples, std::size_t nSamples,
+    std::vector<int> const& sampleCuts,
+    OnRaise onRaise, OnFall onFall
+    );
+
+} // namespace icarus::trigger::details
+
+
+// -----------------------------------------------------------------------------
+// ---  Template implementation
+// -----------------------------------------------------------------------------
+template <typename Reaches>
+void icarus::trigger::details::computeSampleCuts
+  (std::size_t nThresholds, Reaches reaches, std::vector<int>& sampleCuts)
+{
+  using SampleLimits_t = std::numeric_limits<std::int16_t>;
+
+  sampleCuts.resize(nThresholds);
+  for (std::size_t iThr = 0; iThr < nThresholds; ++iThr) {
+    int low = SampleLimits_t::min() - 1; // reaches (virtually)
+    int high = SampleLimits_t::max() + 1; // does not reach (virtually)
+    while (high - low > 1) {
+      int const mid = low + (high - low) / 2;
+      (reaches(mid, iThr)? low: high) = mid;
+    } // while
+    sampleCuts[iThr] = low;
+  } // for thresholds
+
+} // icarus::trigger::details::computeSampleCuts()
+
+
+// -----------------------------------------------------------------------------
+template <typename OnRaise, typename OnFall>
+void icarus::trigger::details::scanThresholdLevels(
+  std::int16_t const* samples, std::size_t nSamples,
+  std::vector<int> const& sampleCuts,
+  OnRaise onRaise, OnFall onFall
+) {
+  using Sample_t = std::int16_t;
+  using SampleLimits_t = std::numeric_limits<Sample_t>;
+
+  std::size_t const nThresholds = sampleCuts.size();
+
+  // the level of a sample (number of thresholds reached) starting from
+  // the level `level`
+  auto const levelOf = [&sampleCuts,nThresholds](int sample, std::size_t level)
+    {
+      while ((level < nThresholds) && (sample <= sampleCuts[level])) ++level;
+      while ((level > 0) && (sample > sampleCuts[level - 1])) --level;
+      return level;
+    };
+
+  // the range of raw sample values not changing the specified level
+  // (as long as the level can be reached by a sample at all)
+  auto const levelRange = [&sampleCuts,nThresholds](std::size_t level)
+    {
+      auto const clamp = [](int value)
+        {
+          return static_cast<Sample_t>(std::clamp<int>
+            (value, SampleLimits_t::min(), SampleLimits_t::max()));
+        };
+      return std::pair{
+        (level < nThresholds)
+          ? clamp(sampleCuts[level] + 1): SampleLimits_t::min(),
+        (level > 0)? clamp(sampleCuts[level - 1]): SampleLimits_t::max()
+        };
+    };
+
+  std::size_t level = 0;
+  std::size_t iSample = 0;
+  while (iSample < nSamples) {
+
+    std::size_t const newLevel = levelOf(samples[iSample], level);
+
+    if (newLevel < level) {
+      do onFall(--level, iSample); while (level > newLevel);
+    }
+    else if (newLevel > level) {
+      do onRaise(level++, iSample); while (level < newLevel);
+    }
+
+    // skip all the following samples which do not change the level
+    auto const [ lower, upper ] = levelRange(level);
+    iSample = findSampleOutside(samples, nSamples, iSample + 1, lower, upper);
+
+  } // while samples
+
+} // icarus::trigger::details::scanThresholdLevels()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_TRIGGER_ALGORITHMS_DETAILS_THRESHOLDLEVELSCAN_H
@@ -1420,7 +1420,7 @@ bool icarus::trigger::TriggerEfficiencyPlotsBase::deleteEmptyPlots
     mf::LogTrace(fLogCategory)
       << "Deleting empty " << obj->IsA()->GetName() << "['" << obj->GetName()
       << "'] from " << plots.name();
-    delete obj;
+    plots.deleteObject(obj);
     ++nDeleted;
     
   } // for objects in directory
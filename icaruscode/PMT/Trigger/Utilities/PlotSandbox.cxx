@@ -150,6 +150,18 @@ bool icarus::trigger::PlotSandbox::empty() const {
 } // icarus::trigger::PlotSandbox::empty()
 
 
+//------------------------------------------------------------------------------
+void icarus::trigger::PlotSandbox::deleteObject(TObject* obj) {
+  
+  for (auto it = fData.objects.begin(); it != fData.objects.end(); ) {
+    if (it->second == obj) it = fData.objects.erase(it);
+    else ++it;
+  }
+  delete obj;
+  
+} // icarus::trigger::PlotSandbox::deleteObject()
+
+
 //------------------------------------------------------------------------------
 auto icarus::trigger::PlotSandbox::findSandbox(std::string const& name)
   -> PlotSandbox*
@@ -182,6 +194,14 @@ bool icarus::trigger::PlotSandbox::deleteSubSandbox(std::string const& name) {
     if (getDirectory()) getDirectory()->Delete((name + ";*").c_str());
   }
   
+  // objects made in the deleted directory are gone with it
+  std::string const dirPrefix = name + '/';
+  for (auto itObj = fData.objects.begin(); itObj != fData.objects.end(); ) {
+    if (itObj->first.compare(0, dirPrefix.length(), dirPrefix) == 0)
+      itObj = fData.objects.erase(itObj);
+    else ++itObj;
+  }
+  
   fData.subBoxes.erase(it);
   return true;
 } // icarus::trigger::PlotSandbox::deleteSubSandbox()
@@ -27,6 +27,7 @@
 // C/C++ standard libraries
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <iterator> // std::prev()
 #include <utility> // std::pair<>
 #include <functional> // std::hash<>
@@ -132,6 +133,9 @@ class icarus::trigger::PlotSandbox {
     
     TFileDirectoryHelper outputDir; ///< Output ROOT directory of the sandbox.
     
+    /// Objects created by `make()`, by their unprocessed name (and path).
+    std::unordered_map<std::string, TObject*> objects;
+    
     Data_t() = default;
     Data_t(Data_t const&) = delete;
     Data_t(Data_t&&) = default;
@@ -236,6 +240,11 @@ class icarus::trigger::PlotSandbox {
    * 
    * The fetched object is converted to the desired type via `dynamic_cast`.
    * If conversion fails, a null pointer is returned.
+   * 
+   * Objects created with `make()` are resolved when they are created, and
+   * fetching them is a single lookup by `name`, with no name processing nor
+   * ROOT directory access: it is cheap enough to be done for each `Fill()`.
+   * Other objects are looked for in the ROOT directory.
    */
   template <typename Obj = TObject>
   Obj const* get(std::string const& name) const;
@@ -303,10 +312,24 @@ class icarus::trigger::PlotSandbox {
    * 
    * The name and title are processed with `processName()` and `processTitle()`
    * method respectively, before the object is created.
+   * The object is also registered under the unprocessed `name`, so that
+   * `get()`, `use()` and `demand()` find it directly. If an object with the
+   * same `name` was already made, the new one replaces it (as ROOT does with
+   * histograms in the same directory).
    */
   template <typename Obj, typename... Args>
   Obj* make(std::string const& name, std::string const& title, Args&&... args);
   
+  /**
+   * @brief Deletes an object of the sandbox.
+   * @param obj the object to be deleted
+   * 
+   * The object is destroyed (and removed from its ROOT directory) and, if it
+   * was created with `make()`, it is not fetched by `get()` any more.
+   * Objects in the sandbox must be deleted with this method.
+   */
+  void deleteObject(TObject* obj);
+  
   
   /// @}
   // --- END -- ROOT object management -----------------------------------------
@@ -651,6 +674,10 @@ Obj const* icarus::trigger::PlotSandbox::get(std::string const& name) const
 template <typename Obj /* = TObject */>
 Obj* icarus::trigger::PlotSandbox::use(std::string const& name) const {
   
+  // objects made by this sandbox are already resolved
+  if (auto const it = fData.objects.find(name); it != fData.objects.end())
+    return dynamic_cast<Obj*>(it->second);
+  
   auto [ objDir, objName ] = splitPath(name);
   
   TDirectory* dir = getDirectory(objDir);
@@ -709,10 +736,14 @@ Obj* icarus::trigger::PlotSandbox::make
     = objDir.empty()? fData.outputDir.fDir: fData.outputDir.fDir.mkdir(objDir);
   
   using ObjPtr_t = Obj*;
-  return doConstruct<Obj>(
+  Obj* obj = doConstruct<Obj>(
     destDir, ObjPtr_t{},
     processedName, processedTitle, std::forward<Args>(args)...
     );
+  
+  // a new histogram replaces the one with the same name in the ROOT directory
+  if (obj) fData.objects.insert_or_assign(name, obj);
+  return obj;
 } // icarus::trigger::PlotSandbox::make()
 
 
@@ -27,16 +27,21 @@
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include "art/Persistency/Common/PtrMaker.h"
+#include "canvas/Persistency/Common/FindOneP.h"
 
 #include "larcore/Geometry/Geometry.h"
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom()
 #include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/Wire.h"
+#include "lardataobj/RawData/RawDigit.h"
 #include "lardata/ArtDataHelper/HitCreator.h"
 #include "lardata/Utilities/AssociationUtil.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardata/DetectorInfoServices/LArPropertiesService.h"
 
+#include "icaruscode/TPC/SignalProcessing/HitFinder/HitMergingTools.h"
+
 class HitMerger : public art::EDProducer
 {
 public:
@@ -52,23 +57,15 @@ public:
     virtual void endJob();
     
 private:
-    using RecobHitToPtrMap = std::unordered_map<const recob::Hit*, art::Ptr<recob::Hit>>;
-    
-    /**
-     *  @brief Create recob::Wire to recob::Hit associations
-     */
-    void makeWireAssns(const art::Event&, art::Assns<recob::Wire, recob::Hit>&, RecobHitToPtrMap&) const;
-    
-    /**
-     *  @brief Create raw::RawDigit to recob::Hit associations
-     */
-    
-    void makeRawDigitAssns(const art::Event&, art::Assns<raw::RawDigit, recob::Hit>&, RecobHitToPtrMap&) const;
     // define vector for hits to make sure of uniform use
     using HitPtrVector = std::vector<art::Ptr<recob::Hit>>;
     
     // Fcl parameters.
     std::vector<art::InputTag>  HitMergerfHitProducerLabelVec;         ///< The full collection of hits
+    
+    // Channel lookups for the associations, kept to reuse their memory
+    icarus::ChannelLookup<art::Ptr<recob::Wire>>    fChannelToWire;      ///< Wire on each channel
+    icarus::ChannelLookup<art::Ptr<raw::RawDigit>>  fChannelToRawDigit;  ///< Raw digit on each channel
 };
 
 DEFINE_ART_MODULE(HitMerger)
@@ -138,104 +135,31 @@ void HitMerger::produce(art::Event & evt)
     
     /// Associations with raw digits.
     std::unique_ptr<art::Assns<raw::RawDigit, recob::Hit>> rawDigitAssns(new art::Assns<raw::RawDigit, recob::Hit>);
-
-    RecobHitToPtrMap recobHitToPtrMap;
-    
-    // Use this handy art utility to make art::Ptr objects to the new recob::Hits for use in the output phase
-    art::PtrMaker<recob::Hit> ptrMaker(evt);
-    
-    // Outside loop over the input hit producers
-    for(const auto& inputTag : HitMergerfHitProducerLabelVec)
-    {
-        // Start by looking up the original hits
-        art::Handle< std::vector<recob::Hit> > hitHandle;
-        evt.getByLabel(inputTag, hitHandle);
-        
-        for(size_t hitIdx = 0; hitIdx < hitHandle->size(); hitIdx++)
-        {
-            art::Ptr<recob::Hit> hitPtr(hitHandle,hitIdx);
-            
-            const recob::Hit* hit2D = hitPtr.get();
-            
-            // Create and save the new recob::Hit with the correct WireID
-            outputHitPtrVec->emplace_back(recob::HitCreator(*hit2D, hit2D->WireID()).copy());
-            
-            // Recover a pointer to it...
-            recob::Hit* newHit = &outputHitPtrVec->back();
-            
-            // Create a mapping from this hit to an art Ptr representing it
-            recobHitToPtrMap[newHit] = ptrMaker(outputHitPtrVec->size()-1);
-        }
-    }
-    
-    // Set up to make the associations (if desired)
-    makeWireAssns(evt, *wireAssns, recobHitToPtrMap);
-    
-    makeRawDigitAssns(evt, *rawDigitAssns, recobHitToPtrMap);
-    
-    // Move everything into the event
-    evt.put(std::move(outputHitPtrVec));
-    evt.put(std::move(wireAssns));
-    evt.put(std::move(rawDigitAssns));
     
-    return;
-}
+    // Recover the input hits and map their wires and raw digits by channel number,
+    // visiting each producer once; a channel seen by more producers keeps the last one
+    std::vector<const std::vector<recob::Hit>*> inputHitVecs;
     
-void HitMerger::makeWireAssns(const art::Event& evt, art::Assns<recob::Wire, recob::Hit>& wireAssns, RecobHitToPtrMap& recobHitPtrMap) const
-{
-    // Let's make sure the input associations container is empty
-    wireAssns = art::Assns<recob::Wire, recob::Hit>();
-    
-    // First task is to recover all of the previous wire <--> hit associations and map them by channel number
-    // Create the temporary container
-    std::unordered_map<raw::ChannelID_t, art::Ptr<recob::Wire>> channelToWireMap;
+    fChannelToWire.clear();
+    fChannelToRawDigit.clear();
     
-    // Go through the list of input sources and fill out the map
     for(const auto& inputTag : HitMergerfHitProducerLabelVec)
     {
         art::ValidHandle<std::vector<recob::Hit>> hitHandle = evt.getValidHandle<std::vector<recob::Hit>>(inputTag);
         
+        inputHitVecs.push_back(hitHandle.product());
+        
         art::FindOneP<recob::Wire> hitToWireAssns(hitHandle, evt, inputTag);
         
         if (hitToWireAssns.isValid())
         {
             for(size_t wireIdx = 0; wireIdx < hitToWireAssns.size(); wireIdx++)
             {
-                art::Ptr<recob::Wire> wire = hitToWireAssns.at(wireIdx);
+                const art::Ptr<recob::Wire>& wire = hitToWireAssns.at(wireIdx);
                 
-                channelToWireMap[wire->Channel()] = wire;
+                if (wire.isNonnull()) fChannelToWire.add(wire->Channel(), wire);
             }
         }
-    }
-    
-    // Now fill the container
-    for(const auto& hitPtrPair : recobHitPtrMap)
-    {
-        raw::ChannelID_t channel = hitPtrPair.first->Channel();
-        
-        std::unordered_map<raw::ChannelID_t, art::Ptr<recob::Wire>>::iterator chanWireItr = channelToWireMap.find(channel);
-        
-        if (!(chanWireItr != channelToWireMap.end())) continue;
-        
-        wireAssns.addSingle(chanWireItr->second, hitPtrPair.second);
-    }
-    
-    return;
-}
-    
-void HitMerger::makeRawDigitAssns(const art::Event& evt, art::Assns<raw::RawDigit, recob::Hit>& rawDigitAssns, RecobHitToPtrMap& recobHitPtrMap) const
-{
-    // Let's make sure the input associations container is empty
-    rawDigitAssns = art::Assns<raw::RawDigit, recob::Hit>();
-    
-    // First task is to recover all of the previous wire <--> hit associations and map them by channel number
-    // Create the temporary container
-    std::unordered_map<raw::ChannelID_t, art::Ptr<raw::RawDigit>> channelToRawDigitMap;
-    
-    // Go through the list of input sources and fill out the map
-    for(const auto& inputTag : HitMergerfHitProducerLabelVec)
-    {
-        art::ValidHandle<std::vector<recob::Hit>> hitHandle = evt.getValidHandle<std::vector<recob::Hit>>(inputTag);
         
         art::FindOneP<raw::RawDigit> hitToRawDigitAssns(hitHandle, evt, inputTag);
         
@@ -243,25 +167,41 @@ void HitMerger::makeRawDigitAssns(const art::Event& evt, art::Assns<raw::RawDigi
         {
             for(size_t rawDigitIdx = 0; rawDigitIdx < hitToRawDigitAssns.size(); rawDigitIdx++)
             {
-                art::Ptr<raw::RawDigit> rawDigit = hitToRawDigitAssns.at(rawDigitIdx);
+                const art::Ptr<raw::RawDigit>& rawDigit = hitToRawDigitAssns.at(rawDigitIdx);
                 
-                channelToRawDigitMap[rawDigit->Channel()] = rawDigit;
+                if (rawDigit.isNonnull()) fChannelToRawDigit.add(rawDigit->Channel(), rawDigit);
             }
         }
     }
     
-    // Now fill the container
-    for(const auto& hitPtrPair : recobHitPtrMap)
+    // The output is sized once and each input collection is copied into its own
+    // slice in parallel; the hits are in the order of the producer list
+    icarus::mergeCollections(inputHitVecs, *outputHitPtrVec);
+    
+    // Use this handy art utility to make art::Ptr objects to the new recob::Hits for use in the output phase
+    art::PtrMaker<recob::Hit> ptrMaker(evt);
+    
+    // Now fill the associations, in the order of the output hits
+    for(size_t hitIdx = 0; hitIdx < outputHitPtrVec->size(); hitIdx++)
     {
-        raw::ChannelID_t channel = hitPtrPair.first->Channel();
+        raw::ChannelID_t channel = (*outputHitPtrVec)[hitIdx].Channel();
         
-        std::unordered_map<raw::ChannelID_t, art::Ptr<raw::RawDigit>>::iterator chanRawDigitItr = channelToRawDigitMap.find(channel);
+        const art::Ptr<recob::Wire>*   wire     = fChannelToWire.find(channel);
+        const art::Ptr<raw::RawDigit>* rawDigit = fChannelToRawDigit.find(channel);
         
-        if (!(chanRawDigitItr != channelToRawDigitMap.end())) continue;
+        if (!wire && !rawDigit) continue;
         
-        rawDigitAssns.addSingle(chanRawDigitItr->second, hitPtrPair.second);
+        art::Ptr<recob::Hit> hitPtr = ptrMaker(hitIdx);
+        
+        if (wire)     wireAssns->addSingle(*wire, hitPtr);
+        if (rawDigit) rawDigitAssns->addSingle(*rawDigit, hitPtr);
     }
     
+    // Move everything into the event
+    evt.put(std::move(outputHitPtrVec));
+    evt.put(std::move(wireAssns));
+    evt.put(std::move(rawDigitAssns));
+    
     return;
 }
     
@@ -0,0 +1,106 @@
+#ifndef HITMERGINGTOOLS_H
+#define HITMERGINGTOOLS_H
+////////////////////////////////////////////////////////////////////////
+//
+// File:        HitMergingTools.h
+//
+//              Helpers to merge several hit collections into one, as done
+//              by the HitMerger module:
+//
+//              - mergeCollections() sizes the output once and copies each
+//                input collection, in parallel, into its own slice; the
+//                output is the concatenation of the inputs in their order,
+//                whatever the scheduling of the copies
+//              - ChannelLookup is a flat table from a channel number to an
+//                object (e.g. the art::Ptr of the wire on that channel);
+//                when a channel is added more than once the last one wins
+//
+//              Neither depends on art, so that the merging can be tested
+//              in isolation.
+//
+// Created on October 18, 2026
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+
+namespace icarus
+{
+
+/// Concatenates the `inputs` (none may be null) into `output`, which is
+/// replaced; returns the position of the first element of each input in
+/// `output`, plus the total size as last element.
+template <typename T>
+std::vector<size_t> mergeCollections(const std::vector<const std::vector<T>*>& inputs, std::vector<T>& output)
+{
+    std::vector<size_t> offsets(1, 0);
+
+    offsets.reserve(inputs.size() + 1);
+
+    for(const auto* input : inputs) offsets.push_back(offsets.back() + input->size());
+
+    output.clear();
+    output.resize(offsets.back());
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, inputs.size(), 1),
+        [&](const tbb::blocked_range<size_t>& range)
+        {
+            for(size_t inputIdx = range.begin(); inputIdx < range.end(); inputIdx++)
+                std::copy(inputs[inputIdx]->begin(),inputs[inputIdx]->end(),output.begin() + offsets[inputIdx]);
+        });
+
+    return offsets;
+}
+
+/// Flat table from channel number to an object of type `T`
+template <typename T>
+class ChannelLookup
+{
+public:
+
+    /// Associates `value` to `channel`, replacing any previous one
+    void add(size_t channel, const T& value)
+    {
+        if (channel >= fIndex.size()) fIndex.resize(channel + 1, NoEntry);
+
+        if (fIndex[channel] == NoEntry)
+        {
+            fIndex[channel] = fValues.size();
+            fValues.push_back(value);
+        }
+        else fValues[fIndex[channel]] = value;
+    }
+
+    /// The object associated to `channel` (null if none)
+    const T* find(size_t channel) const
+    {
+        if (channel >= fIndex.size() || fIndex[channel] == NoEntry) return nullptr;
+
+        return &fValues[fIndex[channel]];
+    }
+
+    /// Number of channels with an associated object
+    size_t size() const {return fValues.size();}
+
+    /// Removes all the entries, keeping the memory for the next use
+    void clear()
+    {
+        std::fill(fIndex.begin(),fIndex.end(),NoEntry);
+        fValues.clear();
+    }
+
+private:
+
+    static constexpr size_t NoEntry = ~size_t(0);
+
+    std::vector<size_t> fIndex;    ///< Channel to `fValues` index (`NoEntry` if none)
+    std::vector<T>      fValues;   ///< Objects, in order of first addition
+};
+
+} // end icarus namespace
+#endif
@@ -0,0 +1,266 @@
+#include "MorphologicalFilter2D.h"
+
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace caldata
+{
+
+namespace
+{
+    /// van Herk/Gil-Werman running extremum of `size` consecutive entries of `in`
+    /// (`length` long), for each of the `length - size + 1` starting points.
+    template <typename Op>
+    void runningExtremum(const short* in, size_t length, size_t size, short* prefix, short* suffix, short* out, Op op)
+    {
+        // extrema from the start of each block of `size` entries...
+        for(size_t idx = 0, inBlock = 0; idx < length; idx++)
+        {
+            prefix[idx] = (inBlock == 0) ? in[idx] : op(prefix[idx - 1], in[idx]);
+            if (++inBlock == size) inBlock = 0;
+        }
+
+        // ... and from the end of each block
+        for(size_t idx = length; idx-- > 0;)
+        {
+            suffix[idx] = ((idx + 1 == length) || ((idx + 1) % size == 0)) ? in[idx] : op(suffix[idx + 1], in[idx]);
+        }
+
+        // each window spans at most two blocks
+        for(size_t start = 0; start + size <= length; start++)
+            out[start] = op(suffix[start], prefix[start + size - 1]);
+    }
+
+    short minOf(short left, short right) {return std::min(left, right);}
+    short maxOf(short left, short right) {return std::max(left, right);}
+}
+
+//----------------------------------------------------------------------------
+/// Constructor.
+///
+/// Arguments:
+///
+/// wireSize - size of the structuring element in wires
+/// tickSize - size of the structuring element in ticks
+///
+MorphologicalFilter2D::MorphologicalFilter2D(size_t wireSize, size_t tickSize) :
+    fWireSize(wireSize),
+    fTickSize(tickSize)
+{
+    if (fWireSize == 0 || fTickSize == 0)
+    {
+        throw cet::exception("MorphologicalFilter2D") << "Invalid structuring element size: "
+                                                      << fWireSize << " wires x " << fTickSize << " ticks\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+void MorphologicalFilter2D::filter(const std::vector<const short*>& wires, size_t nTicks, const WireCallback& callback)
+{
+    size_t nWires = wires.size();
+
+    if (nWires < fWireSize || nTicks < fTickSize) return;
+
+    size_t halfWireSize = fWireSize / 2;
+    size_t halfTickSize = fTickSize / 2;
+    size_t nOutTicks    = nTicks - 2 * halfTickSize;
+
+    fNTicks  = nTicks;
+    fNStarts = nTicks - fTickSize + 1;
+
+    fScratchA.resize(nTicks);
+    fScratchB.resize(nTicks);
+
+    for(auto* buffer : {&fCurSuffixMin, &fCurSuffixMax, &fNextPrefixMin, &fNextPrefixMax, &fNextSuffixMin, &fNextSuffixMax})
+        buffer->resize(fWireSize * fNStarts);
+
+    fErosion.assign(nTicks, 0);
+    fDilation.assign(nTicks, 0);
+    fMedian.assign(nTicks, 0);
+
+    // The median histogram covers all the values in the image
+    short lowValue  = std::numeric_limits<short>::max();
+    short highValue = std::numeric_limits<short>::min();
+
+    for(const short* waveform : wires)
+    {
+        auto minMax = std::minmax_element(waveform, waveform + nTicks);
+
+        lowValue  = std::min(lowValue,  *minMax.first);
+        highValue = std::max(highValue, *minMax.second);
+    }
+
+    fHistLow = lowValue;
+    fHistogram.assign(int(highValue) - int(lowValue) + 1, 0);
+
+    // Wires are handled in blocks of the structuring element size: a structuring
+    // element starting in a block ends in the next one, and its extrema are the
+    // extrema from its first wire to the end of the block (suffix) combined with
+    // those from the start of the next block to its last wire (prefix)
+    size_t lastFirstWire = nWires - fWireSize;
+
+    fillBlock(wires, 0, fWireSize, fNextPrefixMin, fCurSuffixMin, fNextPrefixMax, fCurSuffixMax);
+
+    for(size_t blockStart = 0; blockStart <= lastFirstWire; blockStart += fWireSize)
+    {
+        size_t nextBlockStart = blockStart + fWireSize;
+
+        if (nextBlockStart < nWires)
+            fillBlock(wires, nextBlockStart, std::min(fWireSize, nWires - nextBlockStart),
+                      fNextPrefixMin, fNextSuffixMin, fNextPrefixMax, fNextSuffixMax);
+
+        size_t blockLast = std::min(blockStart + fWireSize - 1, lastFirstWire);
+
+        for(size_t firstWire = blockStart; firstWire <= blockLast; firstWire++)
+        {
+            size_t       inBlock = firstWire - blockStart;
+            const short* curMin  = fCurSuffixMin.data() + inBlock * fNStarts;
+            const short* curMax  = fCurSuffixMax.data() + inBlock * fNStarts;
+
+            if (inBlock == 0)
+            {
+                std::copy(curMin, curMin + nOutTicks, fErosion.begin()  + halfTickSize);
+                std::copy(curMax, curMax + nOutTicks, fDilation.begin() + halfTickSize);
+            }
+            else
+            {
+                const short* nextMin = fNextPrefixMin.data() + (inBlock - 1) * fNStarts;
+                const short* nextMax = fNextPrefixMax.data() + (inBlock - 1) * fNStarts;
+
+                for(size_t start = 0; start < nOutTicks; start++)
+                {
+                    fErosion[start + halfTickSize]  = std::min(curMin[start], nextMin[start]);
+                    fDilation[start + halfTickSize] = std::max(curMax[start], nextMax[start]);
+                }
+            }
+
+            filterMedian(wires, firstWire);
+
+            callback(firstWire + halfWireSize, fErosion, fDilation, fMedian);
+        }
+
+        std::swap(fCurSuffixMin, fNextSuffixMin);
+        std::swap(fCurSuffixMax, fNextSuffixMax);
+    }
+
+    return;
+}
+
+//----------------------------------------------------------------------------
+void MorphologicalFilter2D::filterTicks(const short* waveform, short* minimum, short* maximum)
+{
+    runningExtremum(waveform, fNTicks, fTickSize, fScratchA.data(), fScratchB.data(), minimum, minOf);
+    runningExtremum(waveform, fNTicks, fTickSize, fScratchA.data(), fScratchB.data(), maximum, maxOf);
+}
+
+//----------------------------------------------------------------------------
+void MorphologicalFilter2D::fillBlock(const std::vector<const short*>& wires,
+                                      size_t                           firstWire,
+                                      size_t                           nWires,
+                                      std::vector<short>&              prefixMin,
+                                      std::vector<short>&              suffixMin,
+                                      std::vector<short>&              prefixMax,
+                                      std::vector<short>&              suffixMax)
+{
+    // Extrema along the ticks go straight into the suffix rows, prefix extrema are accumulated
+    for(size_t wireIdx = 0; wireIdx < nWires; wireIdx++)
+    {
+        short* sMin = suffixMin.data() + wireIdx * fNStarts;
+        short* sMax = suffixMax.data() + wireIdx * fNStarts;
+        short* pMin = prefixMin.data() + wireIdx * fNStarts;
+        short* pMax = prefixMax.data() + wireIdx * fNStarts;
+
+        filterTicks(wires[firstWire + wireIdx], sMin, sMax);
+
+        if (wireIdx == 0)
+        {
+            std::copy(sMin, sMin + fNStarts, pMin);
+            std::copy(sMax, sMax + fNStarts, pMax);
+        }
+        else
+        {
+            const short* pMinPrev = pMin - fNStarts;
+            const short* pMaxPrev = pMax - fNStarts;
+
+            for(size_t start = 0; start < fNStarts; start++)
+            {
+                pMin[start] = std::min(pMinPrev[start], sMin[start]);
+                pMax[start] = std::max(pMaxPrev[start], sMax[start]);
+            }
+        }
+    }
+
+    for(size_t wireIdx = nWires - 1; wireIdx-- > 0;)
+    {
+        short*       sMin     = suffixMin.data() + wireIdx * fNStarts;
+        short*       sMax     = suffixMax.data() + wireIdx * fNStarts;
+        const short* sMinNext = sMin + fNStarts;
+        const short* sMaxNext = sMax + fNStarts;
+
+        for(size_t start = 0; start < fNStarts; start++)
+        {
+            sMin[start] = std::min(sMin[start], sMinNext[start]);
+            sMax[start] = std::max(sMax[start], sMaxNext[start]);
+        }
+    }
+
+    return;
+}
+
+//----------------------------------------------------------------------------
+void MorphologicalFilter2D::filterMedian(const std::vector<const short*>& wires, size_t firstWire)
+{
+    size_t nOutTicks = fNTicks - 2 * (fTickSize / 2);
+
+    if (nOutTicks == 0) return;
+
+    const short* const* elementWires = wires.data() + firstWire;
+    unsigned int*       histogram    = fHistogram.data();
+    size_t              medianRank   = fWireSize * fTickSize / 2;
+    size_t              halfTickSize = fTickSize / 2;
+
+    // Fill with the first structuring element, then look for the median bin
+    for(size_t wireIdx = 0; wireIdx < fWireSize; wireIdx++)
+        for(size_t tick = 0; tick < fTickSize; tick++) histogram[elementWires[wireIdx][tick] - fHistLow]++;
+
+    int    median = 0;
+    size_t below  = 0; // number of values in bins lower than the median bin
+
+    while(below + histogram[median] <= medianRank) below += histogram[median++];
+
+    fMedian[halfTickSize] = median + fHistLow;
+
+    // Slide along the ticks: one column leaves, one enters (fWireSize values each)
+    for(size_t start = 1; start < nOutTicks; start++)
+    {
+        size_t lastTick = start + fTickSize - 1;
+
+        for(size_t wireIdx = 0; wireIdx < fWireSize; wireIdx++)
+        {
+            int leaving  = elementWires[wireIdx][start - 1] - fHistLow;
+            int entering = elementWires[wireIdx][lastTick]  - fHistLow;
+
+            histogram[leaving]--;
+            histogram[entering]++;
+
+            if (leaving  < median) below--;
+            if (entering < median) below++;
+        }
+
+        while(below > medianRank) below -= histogram[--median];
+        while(below + histogram[median] <= medianRank) below += histogram[median++];
+
+        fMedian[start + halfTickSize] = median + fHistLow;
+    }
+
+    // Leave the histogram empty for the next structuring element
+    for(size_t wireIdx = 0; wireIdx < fWireSize; wireIdx++)
+        for(size_t tick = nOutTicks - 1; tick < nOutTicks - 1 + fTickSize; tick++)
+            histogram[elementWires[wireIdx][tick] - fHistLow]--;
+
+    return;
+}
+
+} // end caldata namespace
@@ -8,6 +8,9 @@
 //              to apply to plane by plane images with the intent to enhance the
 //              signal regions. The primary aim is to aid pattern recognition
 //
+//              The images of the planes are filled first, then filtered in
+//              parallel (see MorphologicalFilter2D for the algorithm).
+//
 // Configuration parameters:
 //
 // DigitModuleLabel      - the source of the RawDigit collection
@@ -18,6 +21,8 @@
 
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <iterator>
 #include <vector>
 
 #include "art/Framework/Core/EDProducer.h"
@@ -34,10 +39,14 @@
 #include "larevt/CalibrationDBI/Interface/DetPedestalProvider.h"
 
 #include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/RawDigitCharacterizationAlg.h"
+#include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/MorphologicalFilter2D.h"
 
 #include "lardataobj/RawData/RawDigit.h"
 #include "lardataobj/RawData/raw.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include <Eigen/Core>
 
 class RawDigitSmoother : public art::EDProducer
@@ -56,17 +65,26 @@ public:
 
 private:
     
-    // Set up our container for the waveforms
-    // We'll keep things in a tuple so we can also keep track of the pedestal and rms for output
-    using WireTuple    = std::tuple<raw::ChannelID_t,float,float,caldata::RawDigitVector>;
-    using WaveformVec  = std::vector<WireTuple>;
-    using WaveformList = std::list<WireTuple*>;
-
-    void saveRawDigits(std::unique_ptr<std::vector<raw::RawDigit> >&, WireTuple&);
-    void saveRawDigits(std::unique_ptr<std::vector<raw::RawDigit> >&, raw::ChannelID_t&, float, float, caldata::RawDigitVector&);
+    // The output collections, in the order of fOutputInstances
+    enum OutputType {EROSION, DILATION, EDGE, DIFFERENCE, AVERAGE, MEDIAN, NOUTPUTS};
+
+    using RawDigitVecArray = std::array<std::vector<raw::RawDigit>, NOUTPUTS>;
+
+    // The pedestal subtracted waveforms of a plane, wire after wire, with the
+    // channel, pedestal and rms of each wire for output
+    struct PlaneImage
+    {
+        std::vector<raw::ChannelID_t> channels;
+        std::vector<float>            pedestals;
+        std::vector<float>            rmsVals;
+        std::vector<short>            waveforms;
+    };
+
+    void filterPlane(const PlaneImage&, size_t, bool, RawDigitVecArray&) const;
+
+    void saveRawDigits(std::vector<raw::RawDigit>&, raw::ChannelID_t, float, float, const caldata::RawDigitVector&) const;
     
-    // Define the structuring element - currently just a vector of vectors
-    using StructuringElement = std::vector<std::vector<short>>;
+    static const std::array<std::string, NOUTPUTS> fOutputInstances;
 
     // Fcl parameters.
     std::string                          fDigitModuleLabel;      ///< The full collection of hits
@@ -78,10 +96,9 @@ private:
     // Statistics.
     int fNumEvent;        ///< Number of events seen.
     
-    // Once defined the structuring element will not change
+    // Once defined the structuring element will not change (it is rectangular)
     size_t                               fStructuringElementWireSize;
     size_t                               fStructuringElementTickSize;
-    StructuringElement                   fStructuringElement;
     
     // Correction algorithms
     caldata::RawDigitCharacterizationAlg fCharacterizationAlg;
@@ -93,6 +110,9 @@ private:
 
 DEFINE_ART_MODULE(RawDigitSmoother)
 
+const std::array<std::string, RawDigitSmoother::NOUTPUTS> RawDigitSmoother::fOutputInstances =
+    {"erosion", "dilation", "edge", "difference", "average", "median"};
+
 //----------------------------------------------------------------------------
 /// Constructor.
 ///
@@ -109,12 +129,7 @@ RawDigitSmoother::RawDigitSmoother(fhicl::ParameterSet const & pset) : EDProduce
     fGeometry = lar::providerFrom<geo::Geometry>();
     
     configure(pset);
-    produces<std::vector<raw::RawDigit>>("erosion");
-    produces<std::vector<raw::RawDigit>>("dilation");
-    produces<std::vector<raw::RawDigit>>("edge");
-    produces<std::vector<raw::RawDigit>>("average");
-    produces<std::vector<raw::RawDigit>>("difference");
-    produces<std::vector<raw::RawDigit>>("median");
+    for(const auto& instance : fOutputInstances) produces<std::vector<raw::RawDigit>>(instance);
 
     // Report.
     mf::LogInfo("RawDigitSmoother") << "RawDigitSmoother configured\n";
@@ -140,11 +155,6 @@ void RawDigitSmoother::configure(fhicl::ParameterSet const & pset)
     fOutputHistograms           = pset.get< bool      >("OutputHistograms",           false);
     fOutputWaveforms            = pset.get< bool      >("OutputWaveforms",            false);
 
-    fStructuringElement.resize(fStructuringElementWireSize);
-    
-    // Create a rectangular structuring element to start with
-    for(auto& row : fStructuringElement) row.resize(fStructuringElementTickSize,1);
-    
     // If asked, define the global histograms
     if (fOutputHistograms)
     {
@@ -187,20 +197,10 @@ void RawDigitSmoother::produce(art::Event & event)
 {
     ++fNumEvent;
     
-    // Agreed convention is to ALWAYS output to the event store so get a pointer to our collection
-    std::unique_ptr<std::vector<raw::RawDigit> > erosionRawDigit(new std::vector<raw::RawDigit>);
-    std::unique_ptr<std::vector<raw::RawDigit> > dilationRawDigit(new std::vector<raw::RawDigit>);
-    std::unique_ptr<std::vector<raw::RawDigit> > edgeRawDigit(new std::vector<raw::RawDigit>);
-    std::unique_ptr<std::vector<raw::RawDigit> > differenceRawDigit(new std::vector<raw::RawDigit>);
-    std::unique_ptr<std::vector<raw::RawDigit> > averageRawDigit(new std::vector<raw::RawDigit>);
-    std::unique_ptr<std::vector<raw::RawDigit> > medianRawDigit(new std::vector<raw::RawDigit>);
-
-    erosionRawDigit->clear();
-    dilationRawDigit->clear();
-    edgeRawDigit->clear();
-    differenceRawDigit->clear();
-    averageRawDigit->clear();
-    medianRawDigit->clear();
+    // Agreed convention is to ALWAYS output to the event store so get a pointer to our collections
+    std::array<std::unique_ptr<std::vector<raw::RawDigit>>, NOUTPUTS> filteredRawDigits;
+
+    for(auto& filteredRawDigit : filteredRawDigits) filteredRawDigit = std::make_unique<std::vector<raw::RawDigit>>();
 
     // Read in the digit List object(s).
     art::Handle< std::vector<raw::RawDigit> > digitVecHandle;
@@ -209,66 +209,28 @@ void RawDigitSmoother::produce(art::Event & event)
     // Require a valid handle
     if (digitVecHandle.isValid() && digitVecHandle->size() > 0)
     {
-        erosionRawDigit->reserve(digitVecHandle->size());
-        dilationRawDigit->reserve(digitVecHandle->size());
-        edgeRawDigit->reserve(digitVecHandle->size());
-        differenceRawDigit->reserve(digitVecHandle->size());
-        averageRawDigit->reserve(digitVecHandle->size());
-        medianRawDigit->reserve(digitVecHandle->size());
+        for(auto& filteredRawDigit : filteredRawDigits) filteredRawDigit->reserve(digitVecHandle->size());
         
         unsigned int maxChannels = fGeometry->Nchannels();
         
-        // Sadly, the RawDigits come to us in an unsorted condition which is not optimal for
-        // what we want to do here. So we make a vector of pointers to the input raw digits and sort them
+        // We want the RawDigits in channel order, they usually come that way already
         std::vector<const raw::RawDigit*> rawDigitVec;
+
+        rawDigitVec.reserve(digitVecHandle->size());
         
-        // Ugliness to fill the pointer vector...
-        for(size_t idx = 0; idx < digitVecHandle->size(); idx++) rawDigitVec.push_back(&digitVecHandle->at(idx));
+        for(const auto& rawDigit : *digitVecHandle) rawDigitVec.push_back(&rawDigit);
         
-        // Sort (use a lambda to sort by channel id)
-        std::sort(rawDigitVec.begin(),rawDigitVec.end(),[](const raw::RawDigit* left, const raw::RawDigit* right) {return left->Channel() < right->Channel();});
+        auto channelOrder = [](const raw::RawDigit* left, const raw::RawDigit* right) {return left->Channel() < right->Channel();};
+
+        if (!std::is_sorted(rawDigitVec.begin(),rawDigitVec.end(),channelOrder))
+            std::sort(rawDigitVec.begin(),rawDigitVec.end(),channelOrder);
         
         // Get size of input data vectors
         size_t rawDataSize = rawDigitVec.front()->Samples();
 
-        // Get an instance of our input waveform list and digit vect
-        WaveformList inputWaveformList;
-        WaveformVec  wireTupleVec;
-        
-        // First we create vector which contains the data
-        for(size_t idx = 0; idx < fStructuringElementWireSize; idx++) wireTupleVec.push_back(WireTuple(0,0.,0.,caldata::RawDigitVector(rawDataSize)));
-        
-        // Now set the address of each of these in the list
-        for(size_t idx = 0; idx < fStructuringElementWireSize; idx++) inputWaveformList.push_back(&wireTupleVec[idx]);
-
-        // ok, make containers for the various things we are going to calculate
-        WireTuple erosionTuple    = WireTuple(0,0.,0.,caldata::RawDigitVector(rawDataSize, 0));
-        WireTuple dilationTuple   = WireTuple(0,0.,0.,caldata::RawDigitVector(rawDataSize, 0));
-        WireTuple edgeTuple       = WireTuple(0,0.,0.,caldata::RawDigitVector(rawDataSize, 0));
-        WireTuple differenceTuple = WireTuple(0,0.,0.,caldata::RawDigitVector(rawDataSize, 0));
-        WireTuple averageTuple    = WireTuple(0,0.,0.,caldata::RawDigitVector(rawDataSize, 0));
-        WireTuple medianTuple     = WireTuple(0,0.,0.,caldata::RawDigitVector(rawDataSize, 0));
-        
-        caldata::RawDigitVector& erosionVec    = std::get<3>(erosionTuple);
-        caldata::RawDigitVector& dilationVec   = std::get<3>(dilationTuple);
-        caldata::RawDigitVector& edgeVec       = std::get<3>(edgeTuple);
-        caldata::RawDigitVector& differenceVec = std::get<3>(differenceTuple);
-        caldata::RawDigitVector& averageVec    = std::get<3>(averageTuple);
-        caldata::RawDigitVector& medianVec     = std::get<3>(medianTuple);
-
-        // Use an index for the last valid waveform...
-        size_t validIndex = 0;
-        
-        // On the very inside loop we are going to keep track of ADC values in a vector... we can speed things up by pre determining some parameters
-        size_t maxAdcBinSize(0);
-        
-        for(const auto& rowVec : fStructuringElement)
-        {
-            for(const auto& structElemVal : rowVec)
-                if (structElemVal) maxAdcBinSize++;
-        }
-        
-        std::vector<short> adcBinValVec(maxAdcBinSize, 0);
+        // The first pass fills the images of the planes; the characterization fills
+        // histograms, so this is done serially
+        std::vector<PlaneImage> planeImages(1);
 
         // Avoid creating and destroying a vector each loop... make a single one here
         caldata::RawDigitVector inputAdcVector(rawDataSize);
@@ -286,26 +248,7 @@ void RawDigitSmoother::produce(art::Event & event)
             std::vector<geo::WireID> wids = fGeometry->ChannelToWire(channel);
             
             // Look to see if we have crossed to another plane
-            if (lastWireID.asPlaneID().cmp(wids[0].asPlaneID()) != 0)
-            {
-                // Dispose of the end set of RawDigits (in order)
-                WaveformList::iterator inputWaveItr = inputWaveformList.begin();
-                
-                std::advance(inputWaveItr, fStructuringElementWireSize/2);
-                
-                while(++inputWaveItr != inputWaveformList.end())
-                {
-                    saveRawDigits(erosionRawDigit,    **inputWaveItr);
-                    saveRawDigits(dilationRawDigit,   **inputWaveItr);
-                    saveRawDigits(edgeRawDigit,       **inputWaveItr);
-                    saveRawDigits(differenceRawDigit, **inputWaveItr);
-                    saveRawDigits(averageRawDigit,    **inputWaveItr);
-                    saveRawDigits(medianRawDigit,     **inputWaveItr);
-                }
-                
-                // Reset the valid waveforms index
-                validIndex = 0;
-            }
+            if (lastWireID.asPlaneID().cmp(wids[0].asPlaneID()) != 0) planeImages.emplace_back();
             
             // Update the last wire id before we forget...
             lastWireID = wids[0];
@@ -320,23 +263,6 @@ void RawDigitSmoother::produce(art::Event & event)
                 continue;
             }
             
-            // If the buffer is "full" then we need to rotate the first to the end so we can reuse
-            if (validIndex == inputWaveformList.size())
-            {
-                inputWaveformList.push_back(inputWaveformList.front());
-                inputWaveformList.pop_front();
-            }
-            else validIndex++;
-            
-            // Find the right entry
-            WaveformList::iterator inputWaveItr = inputWaveformList.begin();
-            WaveformList::iterator midWaveItr   = inputWaveItr;
-            
-            std::advance(inputWaveItr, validIndex - 1);
-            std::advance(midWaveItr,   validIndex / 2);
-
-            caldata::RawDigitVector& rawadc = std::get<3>(**inputWaveItr);
-            
             // And now uncompress
             raw::Uncompress(rawDigit->ADCs(), inputAdcVector, rawDigit->Compression());
             
@@ -350,88 +276,39 @@ void RawDigitSmoother::produce(art::Event & event)
             // Recover the database version of the pedestal
             float pedestal = fPedestalRetrievalAlg.PedMean(channel);
 
-            std::transform(inputAdcVector.begin(),inputAdcVector.end(),rawadc.begin(),std::bind(std::minus<short>(),std::placeholders::_1,pedCorVal));
-            
-            std::get<0>(**inputWaveItr) = channel;
-            std::get<1>(**inputWaveItr) = pedestal;
-            std::get<2>(**inputWaveItr) = rmsVal;
-            
-            // Finally, at this point we are prepared to do some work!
-            if (validIndex == inputWaveformList.size())
-            {
-                
-                raw::ChannelID_t midChannel                     = std::get<0>(**midWaveItr);
-                float            midPedestal                    = std::get<1>(**midWaveItr);
-                float            midRmsVal                      = std::get<2>(**midWaveItr);
-                size_t           halfStructuringElementTickSize = fStructuringElementTickSize / 2;
-                
-                caldata::RawDigitVector& currentVec = std::get<3>(**midWaveItr);
-                
-                // Fill the edge bins with the pedestal value
-                for(size_t adcBinIdx = 0; adcBinIdx < halfStructuringElementTickSize; adcBinIdx++)
-                {
-                    size_t adcLastBinIdx = rawDataSize - adcBinIdx - 1;
-                    
-                    erosionVec[adcBinIdx]        = midPedestal;
-                    erosionVec[adcLastBinIdx]    = midPedestal;
-                    dilationVec[adcBinIdx]       = midPedestal;
-                    dilationVec[adcLastBinIdx]   = midPedestal;
-                    edgeVec[adcBinIdx]           = midPedestal;
-                    edgeVec[adcLastBinIdx]       = midPedestal;
-                    differenceVec[adcBinIdx]     = midPedestal;
-                    differenceVec[adcLastBinIdx] = midPedestal;
-                    averageVec[adcBinIdx]        = midPedestal;
-                    averageVec[adcLastBinIdx]    = midPedestal;
-                    medianVec[adcBinIdx]         = midPedestal;
-                    medianVec[adcLastBinIdx]     = midPedestal;
-                }
-
-                // Ok, buckle up!
-                // Loop will run from half the structuring element to size less half the structuring element. Edges will simply be what they were
-                for(size_t adcBinIdx = halfStructuringElementTickSize; adcBinIdx < erosionVec.size() - halfStructuringElementTickSize; adcBinIdx++)
-                {
-                    size_t rowIdx(0);
-                    size_t adcBinVecIdx(0);
-                    
-                    // Outside loop over vectors
-                    for(const auto& curTuple : inputWaveformList)
-                    {
-                        const caldata::RawDigitVector& curAdcVec = std::get<3>(*curTuple);
-                        
-                        for(size_t colIdx = 0; colIdx < fStructuringElementTickSize; colIdx++)
-                        {
-                            if (fStructuringElement[rowIdx][colIdx]) adcBinValVec[adcBinVecIdx++] = curAdcVec[colIdx + adcBinIdx - halfStructuringElementTickSize];
-                        }
-                        
-                        rowIdx++;
-                    }
-                    
-                    std::sort(adcBinValVec.begin(),adcBinValVec.end());
-                    
-                    erosionVec[adcBinIdx]    =  adcBinValVec.front();
-                    dilationVec[adcBinIdx]   =  adcBinValVec.back();
-                    edgeVec[adcBinIdx]       = (dilationVec[adcBinIdx] - currentVec[adcBinIdx]) + midPedestal;
-                    differenceVec[adcBinIdx] = (dilationVec[adcBinIdx] - erosionVec[adcBinIdx]) + midPedestal;
-                    averageVec[adcBinIdx]    = (dilationVec[adcBinIdx] + erosionVec[adcBinIdx]) / 2;
-                    medianVec[adcBinIdx]     =  adcBinValVec[adcBinValVec.size()/2];
-                }
-
-                saveRawDigits(erosionRawDigit,    midChannel, midPedestal, midRmsVal, std::get<3>(erosionTuple));
-                saveRawDigits(dilationRawDigit,   midChannel, midPedestal, midRmsVal, std::get<3>(dilationTuple));
-                saveRawDigits(edgeRawDigit,       midChannel, midPedestal, midRmsVal, std::get<3>(edgeTuple));
-                saveRawDigits(differenceRawDigit, midChannel, midPedestal, midRmsVal, std::get<3>(differenceTuple));
-                saveRawDigits(averageRawDigit,    midChannel, midPedestal, midRmsVal, std::get<3>(averageTuple));
-                saveRawDigits(medianRawDigit,     midChannel, midPedestal, midRmsVal, std::get<3>(medianTuple));
-            }
-            else if (validIndex <= fStructuringElementWireSize / 2)
-            {
-                saveRawDigits(erosionRawDigit,    **inputWaveItr);
-                saveRawDigits(dilationRawDigit,   **inputWaveItr);
-                saveRawDigits(edgeRawDigit,       **inputWaveItr);
-                saveRawDigits(differenceRawDigit, **inputWaveItr);
-                saveRawDigits(averageRawDigit,    **inputWaveItr);
-                saveRawDigits(medianRawDigit,     **inputWaveItr);
-            }
+            PlaneImage& planeImage = planeImages.back();
+
+            planeImage.channels.push_back(channel);
+            planeImage.pedestals.push_back(pedestal);
+            planeImage.rmsVals.push_back(rmsVal);
+
+            size_t wireStart = planeImage.waveforms.size();
+
+            planeImage.waveforms.resize(wireStart + rawDataSize);
+
+            std::transform(inputAdcVector.begin(),inputAdcVector.end(),planeImage.waveforms.begin() + wireStart,std::bind(std::minus<short>(),std::placeholders::_1,pedCorVal));
+        }
+
+        // Now filter the planes in parallel, each into its own output
+        std::vector<RawDigitVecArray> planeOutputs(planeImages.size());
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, planeImages.size(), 1),
+                          [&](const tbb::blocked_range<size_t>& range)
+                          {
+                              for(size_t planeIdx = range.begin(); planeIdx < range.end(); planeIdx++)
+                              {
+                                  // The trailing wires of the last plane have never been output
+                                  bool saveTrailingWires = planeIdx + 1 < planeImages.size();
+
+                                  filterPlane(planeImages[planeIdx], rawDataSize, saveTrailingWires, planeOutputs[planeIdx]);
+                              }
+                          });
+
+        // And collect them in plane order
+        for(auto& planeOutput : planeOutputs)
+        {
+            for(size_t outIdx = 0; outIdx < NOUTPUTS; outIdx++)
+                std::move(planeOutput[outIdx].begin(), planeOutput[outIdx].end(), std::back_inserter(*filteredRawDigits[outIdx]));
         }
     }
 /*
@@ -476,38 +353,122 @@ void RawDigitSmoother::produce(art::Event & event)
     }
 */
     // Add tracks and associations to event.
-    event.put(std::move(erosionRawDigit),    "erosion");
-    event.put(std::move(dilationRawDigit),   "dilation");
-    event.put(std::move(edgeRawDigit),       "edge");
-    event.put(std::move(differenceRawDigit), "difference");
-    event.put(std::move(averageRawDigit),    "average");
-    event.put(std::move(medianRawDigit),     "median");
+    for(size_t outIdx = 0; outIdx < NOUTPUTS; outIdx++)
+        event.put(std::move(filteredRawDigits[outIdx]), fOutputInstances[outIdx]);
     
     return;
 }
 
-void RawDigitSmoother::saveRawDigits(std::unique_ptr<std::vector<raw::RawDigit> >& filteredRawDigit,
-                                     WireTuple&                                    wireTuple)
+//----------------------------------------------------------------------------
+/// Filters the image of a plane.
+///
+/// Arguments:
+///
+/// planeImage        - the pedestal subtracted waveforms of the plane
+/// nTicks            - the number of ticks of each waveform
+/// saveTrailingWires - whether to output the wires after the last filtered one
+/// outputs           - the RawDigits of each output, in wire order
+///
+/// Wires without a full structuring element around are output as they are
+/// (pedestal subtracted) in all the collections.
+///
+void RawDigitSmoother::filterPlane(const PlaneImage& planeImage,
+                                   size_t            nTicks,
+                                   bool              saveTrailingWires,
+                                   RawDigitVecArray& outputs) const
 {
-    raw::ChannelID_t&        channel     = std::get<0>(wireTuple);
-    float                    pedestal    = std::get<1>(wireTuple);
-    float                    rms         = std::get<2>(wireTuple);
-    caldata::RawDigitVector& rawDigitVec = std::get<3>(wireTuple);
-    
-    filteredRawDigit->emplace_back(channel, rawDigitVec.size(), rawDigitVec, raw::kNone);
-    filteredRawDigit->back().SetPedestal(pedestal,rms);
-    
+    size_t nWires                         = planeImage.channels.size();
+    size_t halfStructuringElementWireSize = fStructuringElementWireSize / 2;
+    size_t halfStructuringElementTickSize = fStructuringElementTickSize / 2;
+
+    for(auto& output : outputs) output.reserve(nWires);
+
+    auto saveWire = [&](size_t wireIdx)
+    {
+        const short*            waveform = planeImage.waveforms.data() + wireIdx * nTicks;
+        caldata::RawDigitVector rawadc(waveform, waveform + nTicks);
+
+        for(auto& output : outputs)
+            saveRawDigits(output, planeImage.channels[wireIdx], planeImage.pedestals[wireIdx], planeImage.rmsVals[wireIdx], rawadc);
+    };
+
+    // The leading wires
+    for(size_t wireIdx = 0; wireIdx < std::min(halfStructuringElementWireSize, nWires); wireIdx++) saveWire(wireIdx);
+
+    // The filtered wires
+    std::vector<const short*> wires(nWires);
+
+    for(size_t wireIdx = 0; wireIdx < nWires; wireIdx++) wires[wireIdx] = planeImage.waveforms.data() + wireIdx * nTicks;
+
+    std::array<caldata::RawDigitVector, NOUTPUTS> filteredVecs;
+
+    for(auto& filteredVec : filteredVecs) filteredVec.resize(nTicks);
+
+    caldata::RawDigitVector& erosionVec    = filteredVecs[EROSION];
+    caldata::RawDigitVector& dilationVec   = filteredVecs[DILATION];
+    caldata::RawDigitVector& edgeVec       = filteredVecs[EDGE];
+    caldata::RawDigitVector& differenceVec = filteredVecs[DIFFERENCE];
+    caldata::RawDigitVector& averageVec    = filteredVecs[AVERAGE];
+    caldata::RawDigitVector& medianVec     = filteredVecs[MEDIAN];
+
+    caldata::MorphologicalFilter2D filter(fStructuringElementWireSize, fStructuringElementTickSize);
+
+    filter.filter(wires, nTicks, [&](size_t                                         midWire,
+                                     const caldata::MorphologicalFilter2D::Waveform& erosion,
+                                     const caldata::MorphologicalFilter2D::Waveform& dilation,
+                                     const caldata::MorphologicalFilter2D::Waveform& median)
+    {
+        float        midPedestal = planeImage.pedestals[midWire];
+        const short* currentVec  = wires[midWire];
+
+        // Fill the edge bins with the pedestal value
+        for(size_t adcBinIdx = 0; adcBinIdx < halfStructuringElementTickSize; adcBinIdx++)
+        {
+            size_t adcLastBinIdx = nTicks - adcBinIdx - 1;
+
+            for(auto& filteredVec : filteredVecs)
+            {
+                filteredVec[adcBinIdx]     = midPedestal;
+                filteredVec[adcLastBinIdx] = midPedestal;
+            }
+        }
+
+        for(size_t adcBinIdx = halfStructuringElementTickSize; adcBinIdx < nTicks - halfStructuringElementTickSize; adcBinIdx++)
+        {
+            erosionVec[adcBinIdx]    =  erosion[adcBinIdx];
+            dilationVec[adcBinIdx]   =  dilation[adcBinIdx];
+            edgeVec[adcBinIdx]       = (dilationVec[adcBinIdx] - currentVec[adcBinIdx]) + midPedestal;
+            differenceVec[adcBinIdx] = (dilationVec[adcBinIdx] - erosionVec[adcBinIdx]) + midPedestal;
+            averageVec[adcBinIdx]    = (dilationVec[adcBinIdx] + erosionVec[adcBinIdx]) / 2;
+            medianVec[adcBinIdx]     =  median[adcBinIdx];
+        }
+
+        for(size_t outIdx = 0; outIdx < NOUTPUTS; outIdx++)
+            saveRawDigits(outputs[outIdx], planeImage.channels[midWire], midPedestal, planeImage.rmsVals[midWire], filteredVecs[outIdx]);
+    });
+
+    // The trailing wires, after the last one with a full structuring element
+    if (saveTrailingWires)
+    {
+        size_t firstTrailingWire = halfStructuringElementWireSize + 1;
+
+        if (nWires >= fStructuringElementWireSize) firstTrailingWire += nWires - fStructuringElementWireSize;
+
+        for(size_t wireIdx = firstTrailingWire; wireIdx < nWires; wireIdx++) saveWire(wireIdx);
+    }
+
     return;
 }
 
-void RawDigitSmoother::RawDigitSmoother::saveRawDigits(std::unique_ptr<std::vector<raw::RawDigit> >& filteredRawDigit,
-                                                       raw::ChannelID_t&                             channel,
-                                                       float                                         pedestal,
-                                                       float                                         rms,
-                                                       caldata::RawDigitVector&                      rawDigitVec)
+//----------------------------------------------------------------------------
+void RawDigitSmoother::saveRawDigits(std::vector<raw::RawDigit>&    filteredRawDigit,
+                                     raw::ChannelID_t               channel,
+                                     float                          pedestal,
+                                     float                          rms,
+                                     const caldata::RawDigitVector& rawDigitVec) const
 {
-    filteredRawDigit->emplace_back(channel, rawDigitVec.size(), rawDigitVec, raw::kNone);
-    filteredRawDigit->back().SetPedestal(pedestal,rms);
+    filteredRawDigit.emplace_back(channel, rawDigitVec.size(), rawDigitVec, raw::kNone);
+    filteredRawDigit.back().SetPedestal(pedestal,rms);
     
     return;
 }
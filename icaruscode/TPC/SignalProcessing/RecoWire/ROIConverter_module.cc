@@ -29,9 +29,12 @@
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom()
 #include "larcorealg/CoreUtils/zip.h"
 #include "lardataobj/RecoBase/Wire.h"
-#include "lardata/ArtDataHelper/WireCreator.h"
 
 #include "icaruscode/IcarusObj/ChannelROI.h"
+#include "icaruscode/TPC/Utilities/ChannelROIWireView.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 
 ///creation of calibrated signals on wires
 namespace caldata {
@@ -53,6 +56,7 @@ private:
     bool                                                       fDiagnosticOutput;           ///< secret diagnostics flag
     size_t                                                     fEventCount;                 ///< count of event processed
 
+    std::vector<geo::View_t>                                   fChannelToViewVec;           ///< view of each channel, looked up once
     const geo::GeometryCore*                                   fGeometry = lar::providerFrom<geo::Geometry>();
     
 }; // class ROIConvert
@@ -92,6 +96,11 @@ void ROIConvert::reconfigure(fhicl::ParameterSet const& pset)
 void ROIConvert::beginJob()
 {
     fEventCount = 0;
+
+    // The geometry does not change in the job, so look up the view of each channel once
+    fChannelToViewVec.resize(fGeometry->Nchannels());
+
+    for(raw::ChannelID_t channel = 0; channel < fChannelToViewVec.size(); channel++) fChannelToViewVec[channel] = fGeometry->View(channel);
 } // beginJob
 
 //////////////////////////////////////////////////////
@@ -118,35 +127,25 @@ void ROIConvert::produce(art::Event& evt)
     
         if (!channelVec.empty())
         {
-            // Reserve the room for the output
-            wireCol->reserve(channelVec.size());
-
-            // Loop through the input ChannelROI collection
-            for(const auto& channelROI : channelVec)
-            {
-                // Recover the channel and the view
-                raw::ChannelID_t channel = channelROI.Channel();
-                geo::View_t      view    = fGeometry->View(channel);
-
-                // Create an ROI vector for output
-                recob::Wire::RegionsOfInterest_t ROIVec;
-    
-                // Loop through the ROIs for this channel
-                const recob::ChannelROI::RegionsOfInterest_t& channelROIs = channelROI.SignalROI();
+            // Size the output once, each channel then fills its own slot
+            wireCol->resize(channelVec.size());
 
-                for(const auto& range : channelROIs.get_ranges())
+            // Channels are independent, convert them in parallel
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, channelVec.size()),
+                [&](const tbb::blocked_range<size_t>& range)
                 {
-                    size_t startTick = range.begin_index();
-
-                    std::vector<float> dataVec(range.data().size());
-
-                    for(size_t binIdx = 0; binIdx < range.data().size(); binIdx++) dataVec[binIdx] = range.data()[binIdx];
-
-                    ROIVec.add_range(startTick, std::move(dataVec));
-                }
-
-                wireCol->push_back(recob::WireCreator(std::move(ROIVec),channel,view).move());
-            }
+                    for(size_t channelIdx = range.begin(); channelIdx < range.end(); channelIdx++)
+                    {
+                        const recob::ChannelROI& channelROI = channelVec[channelIdx];
+
+                        // Recover the channel and the view
+                        raw::ChannelID_t channel = channelROI.Channel();
+                        geo::View_t      view    = channel < fChannelToViewVec.size() ? fChannelToViewVec[channel] : fGeometry->View(channel);
+
+                        // The ROIs are converted to float in one pass over each range
+                        (*wireCol)[channelIdx] = recob::ChannelROIWireView(channelROI, view).makeWire();
+                    }
+                });
 
             // Time to stroe everything
             if(wireCol->empty()) mf::LogWarning("ROIConvert") << "No wires made for this event.";
@@ -0,0 +1,67 @@
+/** ****************************************************************************
+ * @file   ChannelROIWireView.cxx
+ * @brief  Read-only `recob::Wire`-like access to a `recob::ChannelROI`
+ * @date   October 18, 2026
+ * @see    ChannelROIWireView.h
+ *
+ * ****************************************************************************/
+
+// declaration header
+#include "icaruscode/TPC/Utilities/ChannelROIWireView.h"
+
+// C/C++ standard library
+#include <utility> // std::move()
+
+/// Reconstruction base classes
+namespace recob {
+
+  //----------------------------------------------------------------------
+  void ChannelROIWireView::ROI::copy(float* dest) const {
+    convert(fRange->data().data(), fRange->size(), fScale, dest);
+  } // ChannelROIWireView::ROI::copy()
+
+  //----------------------------------------------------------------------
+  std::vector<float> ChannelROIWireView::ROI::data() const {
+    std::vector<float> samples(size());
+    copy(samples.data());
+    return samples;
+  } // ChannelROIWireView::ROI::data()
+
+  //----------------------------------------------------------------------
+  std::vector<float> ChannelROIWireView::Signal() const {
+    std::vector<float> signal;
+    Signal(signal);
+    return signal;
+  } // ChannelROIWireView::Signal()
+
+  //----------------------------------------------------------------------
+  void ChannelROIWireView::Signal(std::vector<float>& signal) const {
+    signal.assign(NSignal(), 0.0f);
+    for (ROI const& range: get_ranges())
+      range.copy(signal.data() + range.begin_index());
+  } // ChannelROIWireView::Signal(std::vector<float>&)
+
+  //----------------------------------------------------------------------
+  Wire::RegionsOfInterest_t ChannelROIWireView::SignalROI() const {
+    Wire::RegionsOfInterest_t signalROI;
+    for (ROI const& range: get_ranges())
+      signalROI.add_range(range.begin_index(), range.data());
+    // the nominal size may extend beyond the last region
+    signalROI.resize(NSignal());
+    return signalROI;
+  } // ChannelROIWireView::SignalROI()
+
+  //----------------------------------------------------------------------
+  Wire ChannelROIWireView::makeWire() const {
+    return Wire{ SignalROI(), Channel(), View() };
+  } // ChannelROIWireView::makeWire()
+
+  //----------------------------------------------------------------------
+  void ChannelROIWireView::convert
+    (short int const* source, std::size_t n, float scale, float* dest)
+  {
+    // a plain loop on contiguous arrays, which the compiler vectorizes
+    for (std::size_t i = 0; i < n; ++i) dest[i] = scale * source[i];
+  } // ChannelROIWireView::convert()
+
+} // namespace recob
@@ -0,0 +1,191 @@
+/** ****************************************************************************
+ * @file   ChannelROIWireView.h
+ * @brief  Read-only `recob::Wire`-like access to a `recob::ChannelROI`
+ * @date   October 18, 2026
+ * @see    ChannelROI.h ChannelROIWireView.cxx
+ *
+ * ****************************************************************************/
+
+#ifndef ChannelROIWireView_H
+#define ChannelROIWireView_H
+
+// C/C++ standard library
+#include <vector>
+#include <cstddef> // std::size_t
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h" // geo::View_t
+#include "lardataobj/RecoBase/Wire.h"
+#include "icaruscode/IcarusObj/ChannelROI.h"
+
+/// Reconstruction base classes
+namespace recob {
+
+  /**
+   * @brief Reads a `recob::ChannelROI` as if it were a `recob::Wire`
+   *
+   * The signal of `recob::ChannelROI` is stored as `short int`; this view
+   * presents it as `float`, multiplied by a scale factor (`1` by default),
+   * converting each sample only when it is read.
+   * Nothing is copied: the view refers to the `recob::ChannelROI` it is
+   * built from, which must outlive it.
+   *
+   * The interface follows the one of `recob::Wire`, so that code reading
+   * wires can be written for both:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * recob::ChannelROIWireView const wire { channelROI, geom.View(channel) };
+   * for (auto const& ROI: wire.get_ranges()) {
+   *   std::size_t const firstTick = ROI.begin_index();
+   *   for (std::size_t i = 0; i < ROI.size(); ++i)
+   *     float const ADC = ROI.at(i); // tick is `firstTick + i`
+   *   // ...
+   * } // for
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * Full `recob::Wire` content (`Signal()`, `SignalROI()` and `makeWire()`)
+   * is created only on request.
+   */
+  class ChannelROIWireView {
+    public:
+
+      /// Type of a region of interest in the original object
+      using ChannelRange_t = ChannelROI::RegionsOfInterest_t::datarange_t;
+
+      /// A region of interest, with its samples read as scaled `float`
+      class ROI {
+        public:
+          ROI(ChannelRange_t const& range, float scale)
+            : fRange(&range), fScale(scale) {}
+
+          /// First tick of the region
+          std::size_t begin_index() const { return fRange->begin_index(); }
+
+          /// Tick after the last one of the region
+          std::size_t end_index() const { return fRange->end_index(); }
+
+          /// Number of ticks in the region
+          std::size_t size() const { return fRange->size(); }
+
+          /// Sample at position `i` from the start of the region
+          float at(std::size_t i) const { return fScale * fRange->data()[i]; }
+
+          /// Sample at absolute tick `tick` (must be in the region)
+          float operator[] (std::size_t tick) const
+            { return at(tick - begin_index()); }
+
+          /// Writes all the samples of the region starting at `dest`
+          void copy(float* dest) const;
+
+          /// Returns the samples of the region as a new vector
+          std::vector<float> data() const;
+
+          /// The region of interest in the original object
+          ChannelRange_t const& channelRange() const { return *fRange; }
+
+        private:
+          ChannelRange_t const* fRange; ///< Region in the original object.
+          float fScale; ///< Scale factor applied to each sample.
+      }; // class ROI
+
+      /// The list of regions of interest, iterable as `ROI` objects
+      class ROIList {
+          using Base_t = ChannelROI::RegionsOfInterest_t::range_list_t;
+        public:
+          class const_iterator {
+            public:
+              const_iterator(Base_t::const_iterator it, float scale)
+                : fIt(it), fScale(scale) {}
+              ROI operator* () const { return { *fIt, fScale }; }
+              const_iterator& operator++ () { ++fIt; return *this; }
+              bool operator== (const_iterator const& other) const
+                { return fIt == other.fIt; }
+              bool operator!= (const_iterator const& other) const
+                { return fIt != other.fIt; }
+            private:
+              Base_t::const_iterator fIt;
+              float fScale;
+          }; // class const_iterator
+
+          ROIList(Base_t const& ranges, float scale)
+            : fRanges(&ranges), fScale(scale) {}
+
+          const_iterator begin() const { return { fRanges->begin(), fScale }; }
+          const_iterator end() const { return { fRanges->end(), fScale }; }
+          std::size_t size() const { return fRanges->size(); }
+          bool empty() const { return fRanges->empty(); }
+          ROI operator[] (std::size_t i) const { return { (*fRanges)[i], fScale }; }
+
+        private:
+          Base_t const* fRanges;
+          float fScale;
+      }; // class ROIList
+
+
+      /**
+       * @brief Constructor: views `channelROI` as a wire on `view`
+       * @param channelROI the object to be read
+       * @param view the view the channel belongs to
+       * @param scale factor applied to each sample when read
+       */
+      ChannelROIWireView(
+        ChannelROI const& channelROI,
+        geo::View_t view = geo::kUnknown,
+        float scale = 1.0f
+        )
+        : fChannelROI(&channelROI), fView(view), fScale(scale)
+        {}
+
+
+      // --- BEGIN -- Accessors ------------------------------------------------
+      ///@name Accessors
+      ///@{
+
+      /// Returns the ID of the channel (or InvalidChannelID)
+      raw::ChannelID_t Channel() const { return fChannelROI->Channel(); }
+
+      /// Returns the view the channel belongs to
+      geo::View_t View() const { return fView; }
+
+      /// Returns the number of time ticks, or samples, in the channel
+      std::size_t NSignal() const { return fChannelROI->NSignal(); }
+
+      /// Returns the scale factor applied to the samples
+      float Scale() const { return fScale; }
+
+      /// Returns the regions of interest, with `float` samples
+      ROIList get_ranges() const
+        { return { fChannelROI->SignalROI().get_ranges(), fScale }; }
+
+      /// Returns the object being viewed
+      ChannelROI const& channelROI() const { return *fChannelROI; }
+
+      /// Return a zero-padded full length vector filled with RoI signal
+      std::vector<float> Signal() const;
+
+      /// Fills `signal` with the zero-padded full length signal
+      void Signal(std::vector<float>& signal) const;
+
+      /// Returns a copy of the regions of interest, with `float` samples
+      Wire::RegionsOfInterest_t SignalROI() const;
+
+      /// Returns a `recob::Wire` with the content of this view
+      Wire makeWire() const;
+
+      ///@}
+      // --- END -- Accessors --------------------------------------------------
+
+      /// Writes `n` samples from `source` into `dest`, multiplied by `scale`
+      static void convert
+        (short int const* source, std::size_t n, float scale, float* dest);
+
+    private:
+
+      ChannelROI const* fChannelROI; ///< The object being viewed.
+      geo::View_t fView; ///< View of the channel.
+      float fScale; ///< Scale factor applied to each sample.
+
+  }; // class ChannelROIWireView
+
+} // namespace recob
+
+#endif // ChannelROIWireView_H
@@ -0,0 +1,348 @@
+/**
+ * @file TPCPurityFit_test.cc
+ * @brief Unit test for the purity fit utilities in `TPCPurityFit.h`
+ * @date October 18, 2026
+ * @see icaruscode/Analysis/TPCPurityFit.h
+ *
+ * The closed-form solutions are compared with the iterative solver from Eigen,
+ * and the lifetime fit with the algorithm formerly in `TPCPurityMonitor`.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Analysis/TPCPurityFit.h"
+
+// Eigen
+#include "Eigen/Dense"
+#include "Eigen/Eigenvalues"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( TPCPurityFit_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+// --- reference implementation
+// -----------------------------------------------------------------------------
+struct RefPoint {
+  double time;
+  double charge;
+  bool   good = true;
+};
+
+struct RefPCA {
+  Eigen::Vector2d values;
+  Eigen::Matrix2d vectors; // by row
+  Eigen::Vector2d mean;
+};
+
+// principal components as computed by `TPCPurityMonitor` with unit weights
+RefPCA referencePCA(std::vector<RefPoint> const& points) {
+
+  Eigen::Vector2d meanPos(Eigen::Vector2d::Zero());
+  double meanWeightSum = 0.;
+  for (auto const& p: points) {
+    if (!p.good) continue;
+    meanPos(0) += p.time;
+    meanPos(1) += std::log(p.charge);
+    meanWeightSum += 1.;
+  }
+  meanPos /= meanWeightSum;
+
+  double xi2 = 0., xiyi = 0., yi2 = 0., weightSum = 0.;
+  for (auto const& p: points) {
+    if (!p.good) continue;
+    double const x = p.time - meanPos(0);
+    double const y = std::log(p.charge) - meanPos(1);
+    weightSum += 1.;
+    xi2  += x * x;
+    xiyi += x * y;
+    yi2  += y * y;
+  }
+
+  Eigen::Matrix2d sig;
+  sig << xi2, xiyi, xiyi, yi2;
+  sig *= 1. / weightSum;
+
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eigenMat(sig);
+  BOOST_TEST_REQUIRE((eigenMat.info() == Eigen::ComputationInfo::Success));
+
+  return { eigenMat.eigenvalues(), eigenMat.eigenvectors().transpose(), meanPos };
+} // referencePCA()
+
+
+// outlier rejection as performed by `TPCPurityMonitor`
+void referenceRejectOutliers
+  (std::vector<RefPoint>& points, RefPCA const& pca, float outlierRejectFrac)
+{
+  double const slope = pca.vectors.row(1)[1] / pca.vectors.row(1)[0];
+
+  std::vector<std::pair<RefPoint*, double>> deviations;
+  for (auto& p: points) {
+    if (!p.good) continue;
+    double const pred = (p.time - pca.mean[0]) * slope + pca.mean[1];
+    deviations.emplace_back(&p, std::log(p.charge) - pred);
+  }
+  std::sort(deviations.begin(), deviations.end(),
+    [](auto const& left, auto const& right){ return left.second < right.second; });
+
+  std::size_t const loRejectIdx = 0.01 * deviations.size();
+  std::size_t const hiRejectIdx = outlierRejectFrac * deviations.size();
+  for (std::size_t idx = 0; idx < deviations.size(); ++idx) {
+    if (idx < loRejectIdx || idx > hiRejectIdx) deviations[idx].first->good = false;
+    if (deviations[idx].second < -0.75) deviations[idx].first->good = false;
+  }
+} // referenceRejectOutliers()
+
+
+// -----------------------------------------------------------------------------
+// --- helpers
+// -----------------------------------------------------------------------------
+template <std::size_t N, typename Matrix>
+void checkEigenSystem(
+  icarus::purity::SymmetricEigenSystem<N> const& eigen, Matrix const& matrix
+) {
+  Eigen::SelfAdjointEigenSolver<Matrix> ref(matrix);
+  BOOST_TEST_REQUIRE((ref.info() == Eigen::ComputationInfo::Success));
+
+  double const scale = std::max(
+    { std::abs(ref.eigenvalues()[0]), std::abs(ref.eigenvalues()[N-1]), 1e-300 }
+    );
+  double const gap = ref.eigenvalues()[N-1] - ref.eigenvalues()[0];
+
+  for (std::size_t i = 0; i < N; ++i) {
+    BOOST_TEST(std::abs(eigen.values[i] - ref.eigenvalues()[i]) <= 1e-10 * scale);
+
+    // vectors are compared only for isolated eigenvalues, and up to the sign
+    bool isolated = true;
+    for (std::size_t j = 0; j < N; ++j) {
+      if ((j != i) && (std::abs(ref.eigenvalues()[j] - ref.eigenvalues()[i]) < 1e-6 * gap))
+        isolated = false;
+    }
+    if (!isolated || !(gap > 1e-6 * scale)) continue;
+    double dot = 0.;
+    for (std::size_t d = 0; d < N; ++d)
+      dot += eigen.vectors[i][d] * ref.eigenvectors().col(i)[d];
+    BOOST_TEST(std::abs(std::abs(dot) - 1.0) <= 1e-8);
+  } // for
+
+  // the eigenvectors must always be an orthonormal basis
+  for (std::size_t i = 0; i < N; ++i) {
+    for (std::size_t j = 0; j < N; ++j) {
+      double dot = 0.;
+      for (std::size_t d = 0; d < N; ++d)
+        dot += eigen.vectors[i][d] * eigen.vectors[j][d];
+      BOOST_TEST(std::abs(dot - ((i == j)? 1.0: 0.0)) <= 1e-10);
+    }
+  }
+} // checkEigenSystem()
+
+
+// a track-like sample: exponential attenuation of a Landau-ish charge
+std::vector<RefPoint> makeTrack(std::mt19937& rng, std::size_t nHits) {
+  std::uniform_real_distribution<double> startTime(50., 500.), span(150., 1200.);
+  std::uniform_real_distribution<double> lifetime(500., 10000.);
+  std::normal_distribution<double> smear(0., 0.15);
+  std::exponential_distribution<double> tail(8.);
+  std::bernoulli_distribution dip(0.03);
+
+  double const t0 = startTime(rng), dt = span(rng), tau = lifetime(rng);
+
+  std::vector<RefPoint> points;
+  for (std::size_t i = 0; i < nHits; ++i) {
+    double const t = t0 + dt * i / nHits;
+    double logQ = std::log(400.) - t / tau + smear(rng) + tail(rng);
+    if (dip(rng)) logQ -= 1.5;
+    points.push_back({ t, std::exp(logQ) });
+  }
+  return points;
+} // makeTrack()
+
+
+// -----------------------------------------------------------------------------
+// --- tests
+// -----------------------------------------------------------------------------
+void eigen2x2_test() {
+
+  std::mt19937 rng(2026);
+  std::uniform_real_distribution<double> uniform(-1., 1.);
+
+  for (int i = 0; i < 2000; ++i) {
+    double const xx = 1e4 * std::abs(uniform(rng));
+    double const yy = 0.5 * std::abs(uniform(rng));
+    double const xy = std::sqrt(xx * yy) * uniform(rng);
+    Eigen::Matrix2d m;
+    m << xx, xy, xy, yy;
+    checkEigenSystem<2>(icarus::purity::solveSymmetric2x2(xx, xy, yy), m);
+  }
+
+  // special cases: diagonal (either order), isotropic
+  for (auto const& [ xx, yy ]: { std::pair{ 3., 1. }, { 1., 3. }, { 2., 2. } }) {
+    Eigen::Matrix2d m;
+    m << xx, 0., 0., yy;
+    checkEigenSystem<2>(icarus::purity::solveSymmetric2x2(xx, 0., yy), m);
+  }
+
+} // eigen2x2_test()
+
+
+void eigen3x3_test() {
+
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<double> uniform(-1., 1.);
+  std::uniform_real_distribution<double> logScale(-2., 3.);
+
+  for (int i = 0; i < 2000; ++i) {
+    // random rotation of random (possibly very elongated) spreads
+    Eigen::Matrix3d const q
+      = Eigen::Quaterniond(uniform(rng), uniform(rng), uniform(rng), uniform(rng))
+      .normalized().toRotationMatrix();
+    Eigen::Vector3d const spreads(
+      std::pow(10., logScale(rng)), std::pow(10., logScale(rng)),
+      std::pow(10., logScale(rng))
+      );
+    Eigen::Matrix3d const m = q * spreads.asDiagonal() * q.transpose();
+    checkEigenSystem<3>(icarus::purity::solveSymmetric3x3
+      (m(0,0), m(0,1), m(0,2), m(1,1), m(1,2), m(2,2)), m);
+  }
+
+  // special cases: diagonal, degenerate pairs, isotropic
+  for (Eigen::Vector3d const& d: {
+    Eigen::Vector3d{ 3., 1., 2. }, Eigen::Vector3d{ 1., 1., 5. },
+    Eigen::Vector3d{ 5., 1., 1. }, Eigen::Vector3d{ 2., 2., 2. }
+  }) {
+    Eigen::Matrix3d const m = d.asDiagonal();
+    checkEigenSystem<3>
+      (icarus::purity::solveSymmetric3x3(d[0], 0., 0., d[1], 0., d[2]), m);
+  }
+
+} // eigen3x3_test()
+
+
+void lifetimeFit_test() {
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> nHitsDist(100, 3000);
+  std::uniform_real_distribution<float> rejectFrac(0.6f, 0.9f);
+
+  icarus::purity::LifetimeFitter fitter; // reused, as in the module
+
+  for (int iTrack = 0; iTrack < 500; ++iTrack) {
+
+    std::vector<RefPoint> points = makeTrack(rng, nHitsDist(rng));
+    float const outlierRejectFrac = rejectFrac(rng);
+
+    std::size_t const lowCutIdx = 0.05f * points.size();
+    std::size_t const hiCutIdx = 0.95f * points.size();
+
+    // reference
+    for (std::size_t i = 0; i < points.size(); ++i)
+      points[i].good = (i >= lowCutIdx) && (i < hiCutIdx);
+    RefPCA refPCA = referencePCA(points);
+    referenceRejectOutliers(points, refPCA, outlierRejectFrac);
+    refPCA = referencePCA(points);
+
+    // new implementation
+    fitter.clear();
+    for (auto const& p: points) fitter.addPoint(p.time, p.charge);
+    fitter.keepRange(lowCutIdx, hiCutIdx);
+    auto pca = fitter.principalComponents();
+    fitter.rejectOutliers(pca, outlierRejectFrac);
+    pca = fitter.principalComponents();
+    BOOST_TEST_REQUIRE(pca.ok);
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+      BOOST_TEST(fitter.isGood(i) == points[i].good);
+
+    double const refAttenuation
+      = refPCA.vectors.row(1)[1] / refPCA.vectors.row(1)[0];
+    double const refError = std::sqrt(refPCA.values[0] / refPCA.values[1]);
+    double const attenuation
+      = icarus::purity::LifetimeFitter::attenuationSlope(pca);
+    double const error = std::sqrt(pca.values[0] / pca.values[1]);
+
+    BOOST_TEST(attenuation == refAttenuation, boost::test_tools::tolerance(1e-8));
+    BOOST_TEST(error == refError, boost::test_tools::tolerance(1e-8));
+    BOOST_TEST(pca.mean[0] == refPCA.mean[0], boost::test_tools::tolerance(1e-12));
+    BOOST_TEST(pca.mean[1] == refPCA.mean[1], boost::test_tools::tolerance(1e-12));
+
+  } // for tracks
+
+} // lifetimeFit_test()
+
+
+void principalComponents3D_test() {
+
+  std::mt19937 rng(7);
+  std::normal_distribution<double> noise(0., 0.2);
+  std::uniform_real_distribution<double> along(-100., 100.);
+
+  // points along a line: the major axis must be the line direction
+  std::array<double, 3> const dir{ 0.48, 0.6, 0.64 };
+  std::vector<std::array<double, 3>> points;
+  for (int i = 0; i < 500; ++i) {
+    double const s = along(rng);
+    points.push_back({
+      10. + s * dir[0] + noise(rng), -5. + s * dir[1] + noise(rng),
+      300. + s * dir[2] + noise(rng)
+      });
+  }
+
+  auto const pca = icarus::purity::computePrincipalComponents<3>(points.size(),
+    [&points](std::size_t i){ return points[i]; },
+    [](std::size_t){ return 1.0; },
+    [](std::size_t){ return true; }
+    );
+
+  BOOST_TEST(pca.ok);
+  BOOST_TEST(pca.nPoints == 500);
+  BOOST_TEST(pca.values[0] <= pca.values[1]);
+  BOOST_TEST(pca.values[1] <= pca.values[2]);
+  double const cosAngle = pca.vectors[2][0] * dir[0]
+    + pca.vectors[2][1] * dir[1] + pca.vectors[2][2] * dir[2];
+  BOOST_TEST(std::abs(cosAngle) == 1.0, boost::test_tools::tolerance(1e-4));
+
+} // principalComponents3D_test()
+
+
+// -----------------------------------------------------------------------------
+// BEGIN Test cases  -----------------------------------------------------------
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(eigen2x2_testcase) {
+
+  eigen2x2_test();
+
+} // BOOST_AUTO_TEST_CASE(eigen2x2_testcase)
+
+
+BOOST_AUTO_TEST_CASE(eigen3x3_testcase) {
+
+  eigen3x3_test();
+
+} // BOOST_AUTO_TEST_CASE(eigen3x3_testcase)
+
+
+BOOST_AUTO_TEST_CASE(lifetimeFit_testcase) {
+
+  lifetimeFit_test();
+
+} // BOOST_AUTO_TEST_CASE(lifetimeFit_testcase)
+
+
+BOOST_AUTO_TEST_CASE(principalComponents3D_testcase) {
+
+  principalComponents3D_test();
+
+} // BOOST_AUTO_TEST_CASE(principalComponents3D_testcase)
+
+
+// -----------------------------------------------------------------------------
+// END Test cases  -------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,293 @@
+/**
+ * @file SimChannelTruthIndex_test.cc
+ * @brief Unit test for `icarus::SimChannelTruthIndex`
+ * @date October 18, 2026
+ * @see icaruscode/Analysis/tools/SimChannelTruthIndex.h
+ *
+ * The content of the index is compared with the nested maps from track ID to
+ * channel to TDC which the analysis tools used to build.
+ * `forEvent()` is exercised with a minimal stand-in for `art::Event`.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Analysis/tools/SimChannelTruthIndex.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( SimChannelTruthIndex_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <algorithm> // std::copy(), std::find_if()
+#include <iterator> // std::distance()
+#include <map>
+#include <random>
+#include <type_traits> // std::is_same_v
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Returns `nChannels` SimChannels with random deposits from `nTracks` tracks.
+  std::vector<sim::SimChannel> makeSimChannels
+    (unsigned int nChannels, int nTracks, unsigned int seed)
+  {
+    std::mt19937 engine { seed };
+    std::uniform_int_distribution<int> tracks { 1, nTracks };
+    std::uniform_int_distribution<unsigned int> ticks { 100U, 400U };
+    std::uniform_int_distribution<unsigned int> nDeposits { 0U, 40U };
+    std::uniform_real_distribution<double> electrons { 1.0, 1000.0 };
+
+    std::vector<sim::SimChannel> simChannels;
+    for (unsigned int channel = 0; channel < nChannels; channel += 3) {
+      sim::SimChannel simChannel { channel };
+      for (unsigned int i = nDeposits(engine); i > 0; --i) {
+        double const n = electrons(engine);
+        double const xyz[3] = { n, -n, 2.0 * n };
+        simChannel.AddIonizationElectrons
+          (tracks(engine), ticks(engine), n, xyz, n / 1000.0);
+      }
+      simChannels.push_back(std::move(simChannel));
+    }
+    return simChannels;
+  } // makeSimChannels()
+
+
+  /// Minimal stand-in for `art::Handle`.
+  template <typename T>
+  struct TestHandle {
+    T const* data = nullptr;
+    bool isValid() const { return data != nullptr; }
+    T const* product() const { return data; }
+    T const& operator*() const { return *data; }
+  }; // TestHandle
+
+  /// Minimal stand-in for `art::Event`, with a fixed event number.
+  struct TestEvent {
+    unsigned int event;
+    std::vector<sim::SimChannel> const* simChannels;
+    std::vector<simb::MCParticle> const* particles;
+
+    template <typename T>
+    TestHandle<T> getHandle(art::InputTag const&) const
+      {
+        if constexpr (std::is_same_v<T, std::vector<sim::SimChannel>>)
+          return { simChannels };
+        else
+          return { particles };
+      }
+  }; // TestEvent
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(NestedMaps_test) {
+
+  std::vector<sim::SimChannel> const simChannels
+    = makeSimChannels(300U, 12, 1234U);
+
+  std::map<int, std::map<raw::ChannelID_t, std::map<unsigned short, sim::IDE const*>>>
+    partToChanToTDCToIDE;
+  std::map<raw::ChannelID_t, std::size_t> chanToNDeposits;
+  std::size_t nDeposits = 0U;
+  for (sim::SimChannel const& simChannel: simChannels) {
+    for (auto const& tdcide: simChannel.TDCIDEMap()) {
+      for (sim::IDE const& ide: tdcide.second) {
+        partToChanToTDCToIDE[ide.trackID][simChannel.Channel()][tdcide.first]
+          = &ide;
+        ++chanToNDeposits[simChannel.Channel()];
+        ++nDeposits;
+      }
+    }
+  } // for
+
+  icarus::SimChannelTruthIndex const index { simChannels };
+
+  BOOST_TEST(index.nDeposits() == nDeposits);
+  BOOST_TEST(index.tracks().size() == partToChanToTDCToIDE.size());
+
+  auto itTrack = index.tracks().begin();
+  for (auto const& [ trackID, chanToTDCToIDE ]: partToChanToTDCToIDE) {
+    BOOST_TEST_CONTEXT("track ID " << trackID) {
+      BOOST_TEST(itTrack->trackID == trackID);
+      BOOST_TEST(index.track(trackID) == &*itTrack);
+      BOOST_TEST(itTrack->channels.size() == chanToTDCToIDE.size());
+
+      std::size_t nTrackDeposits = 0U;
+      auto itChannel = itTrack->channels.begin();
+      for (auto const& [ channel, tdcToIDE ]: chanToTDCToIDE) {
+        BOOST_TEST(itChannel->channel == channel);
+
+        auto const deposits = index.trackChannel(trackID, channel);
+        BOOST_TEST(deposits.begin() == itChannel->deposits.begin());
+        BOOST_TEST(deposits.size() == tdcToIDE.size());
+
+        auto itDeposit = deposits.begin();
+        for (auto const& [ tdc, ide ]: tdcToIDE) {
+          BOOST_TEST(itDeposit->trackID == trackID);
+          BOOST_TEST(itDeposit->channel == channel);
+          BOOST_TEST(itDeposit->tdc == tdc);
+          BOOST_TEST(itDeposit->ide == ide);
+          BOOST_TEST(icarus::SimChannelTruthIndex::findTDC(deposits, tdc) == &*itDeposit);
+          ++itDeposit;
+        } // for TDC
+
+        // a TDC interval from the middle of the first and last deposits
+        unsigned short const firstTDC = (deposits.front().tdc + deposits.back().tdc) / 2;
+        unsigned short const lastTDC = firstTDC + 10;
+        auto const inRange = icarus::SimChannelTruthIndex::tdcRange(deposits, firstTDC, lastTDC);
+        auto const first = tdcToIDE.lower_bound(firstTDC);
+        auto const last = tdcToIDE.upper_bound(lastTDC);
+        BOOST_TEST(inRange.size() == std::size_t(std::distance(first, last)));
+        if (!inRange.empty()) BOOST_TEST(inRange.front().tdc == first->first);
+
+        nTrackDeposits += deposits.size();
+        ++itChannel;
+      } // for channels
+
+      BOOST_TEST(itTrack->deposits.size() == nTrackDeposits);
+    } // context
+    ++itTrack;
+  } // for tracks
+
+  for (auto const& [ channel, nChannelDeposits ]: chanToNDeposits) {
+    auto const deposits = index.channel(channel);
+    BOOST_TEST(deposits.size() == nChannelDeposits);
+    for (std::size_t i = 1; i < deposits.size(); ++i) {
+      BOOST_TEST(deposits[i]->channel == channel);
+      BOOST_TEST(deposits[i - 1]->tdc <= deposits[i]->tdc);
+    }
+  } // for channels
+
+} // BOOST_AUTO_TEST_CASE(NestedMaps_test)
+
+
+BOOST_AUTO_TEST_CASE(Missing_test) {
+
+  std::vector<sim::SimChannel> const simChannels
+    = makeSimChannels(30U, 3, 42U);
+  std::vector<simb::MCParticle> const particles
+    = { simb::MCParticle{ 1, 13, "primary" }, simb::MCParticle{ 2, 11, "muIoni" } };
+
+  icarus::SimChannelTruthIndex const index { simChannels, &particles };
+
+  BOOST_TEST(index.track(4) == nullptr);
+  BOOST_TEST(index.trackChannel(1, 1U).empty());
+  BOOST_TEST(index.channel(1U).empty());
+  BOOST_TEST(index.particle(1) == &particles[0]);
+  BOOST_TEST(index.particle(2) == &particles[1]);
+  BOOST_TEST(index.particle(3) == nullptr);
+
+  icarus::SimChannelTruthIndex const empty { {} };
+  BOOST_TEST(empty.nDeposits() == 0U);
+  BOOST_TEST(empty.tracks().empty());
+  BOOST_TEST(empty.particle(1) == nullptr);
+
+} // BOOST_AUTO_TEST_CASE(Missing_test)
+
+
+
+BOOST_AUTO_TEST_CASE(SameEventID_test) {
+
+  // MC files often repeat event numbers, and a new data product may be
+  // allocated where the one of the previous event was, with the same size:
+  // the index of each event must describe that event's products only
+  std::vector<sim::SimChannel> simChannels = makeSimChannels(30U, 3, 42U);
+  std::vector<simb::MCParticle> const particles
+    = { simb::MCParticle{ 1, 13, "primary" } };
+
+  TestEvent const firstEvent { 1U, &simChannels, &particles };
+  auto const firstIndex
+    = icarus::SimChannelTruthIndex::forEvent(firstEvent, "largeant", "largeant");
+  BOOST_TEST_REQUIRE(firstIndex.get() != nullptr);
+  BOOST_TEST(firstIndex->particle(1) == &particles[0]);
+
+  // same event number, same product address and size, different content
+  std::vector<sim::SimChannel> const secondChannels
+    = makeSimChannels(30U, 5, 4242U);
+  BOOST_TEST_REQUIRE(secondChannels.size() == simChannels.size());
+  std::copy(secondChannels.begin(), secondChannels.end(), simChannels.begin());
+  TestEvent const secondEvent { 1U, &simChannels, nullptr };
+  auto const secondIndex
+    = icarus::SimChannelTruthIndex::forEvent(secondEvent, "largeant", "largeant");
+  BOOST_TEST_REQUIRE(secondIndex.get() != nullptr);
+  BOOST_TEST(secondIndex.get() != firstIndex.get());
+
+  icarus::SimChannelTruthIndex const expected { secondChannels };
+  BOOST_TEST(secondIndex->nDeposits() == expected.nDeposits());
+  BOOST_TEST(secondIndex->tracks().size() == expected.tracks().size());
+  BOOST_TEST(secondIndex->particle(1) == nullptr);
+
+  for (auto const& trackDeposits: secondIndex->tracks()) {
+    for (auto const& deposit: trackDeposits.deposits) {
+      auto const& tdcides = simChannels[deposit.channel / 3].TDCIDEMap();
+      auto const itTDC = std::find_if(tdcides.begin(), tdcides.end(),
+        [&deposit](auto const& tdcide){ return tdcide.first == deposit.tdc; });
+      BOOST_TEST_REQUIRE((itTDC != tdcides.end()));
+      BOOST_TEST(deposit.ide->trackID == deposit.trackID);
+      BOOST_TEST(deposit.ide >= itTDC->second.data());
+      BOOST_TEST(deposit.ide < itTDC->second.data() + itTDC->second.size());
+    }
+  }
+
+  // no SimChannels, no index
+  TestEvent const emptyEvent { 1U, nullptr, nullptr };
+  BOOST_TEST(icarus::SimChannelTruthIndex::forEvent(emptyEvent, "largeant", "largeant").get() == nullptr);
+
+} // BOOST_AUTO_TEST_CASE(SameEventID_test)
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(IndexSet_test) {
+
+  // the tools of one event share the index of the same products
+  std::vector<sim::SimChannel> simChannels = makeSimChannels(30U, 3, 42U);
+  std::vector<simb::MCParticle> const particles
+    = { simb::MCParticle{ 1, 13, "primary" } };
+
+  TestEvent const firstEvent { 1U, &simChannels, &particles };
+  icarus::SimChannelTruthIndexSet<TestEvent> firstSet { firstEvent };
+  BOOST_TEST(firstSet.size() == 0U);
+
+  icarus::SimChannelTruthIndex const* firstIndex
+    = firstSet.get("largeant", "largeant");
+  BOOST_TEST_REQUIRE(firstIndex != nullptr);
+  BOOST_TEST(firstSet.get("largeant", "largeant") == firstIndex);
+  BOOST_TEST(firstSet.size() == 1U);
+
+  // different labels, different index
+  icarus::SimChannelTruthIndex const* otherIndex
+    = firstSet.get("largeant", "generator");
+  BOOST_TEST_REQUIRE(otherIndex != nullptr);
+  BOOST_TEST(otherIndex != firstIndex);
+  BOOST_TEST(firstSet.get("largeant", "largeant") == firstIndex);
+  BOOST_TEST(firstSet.size() == 2U);
+
+  // the set of a new event with the same number builds its own index
+  std::vector<sim::SimChannel> const secondChannels
+    = makeSimChannels(30U, 5, 4242U);
+  std::copy(secondChannels.begin(), secondChannels.end(), simChannels.begin());
+  TestEvent const secondEvent { 1U, &simChannels, nullptr };
+  icarus::SimChannelTruthIndexSet<TestEvent> secondSet { secondEvent };
+
+  icarus::SimChannelTruthIndex const* secondIndex
+    = secondSet.get("largeant", "largeant");
+  BOOST_TEST_REQUIRE(secondIndex != nullptr);
+  BOOST_TEST(secondIndex != firstIndex);
+
+  icarus::SimChannelTruthIndex const expected { secondChannels };
+  BOOST_TEST(secondIndex->nDeposits() == expected.nDeposits());
+  BOOST_TEST(secondIndex->particle(1) == nullptr);
+
+  // no SimChannels, no index (and asking again does not build one)
+  TestEvent const emptyEvent { 1U, nullptr, nullptr };
+  icarus::SimChannelTruthIndexSet<TestEvent> emptySet { emptyEvent };
+  BOOST_TEST(emptySet.get("largeant", "largeant") == nullptr);
+  BOOST_TEST(emptySet.get("largeant", "largeant") == nullptr);
+  BOOST_TEST(emptySet.size() == 1U);
+
+} // BOOST_AUTO_TEST_CASE(IndexSet_test)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,258 @@
+/**
+ * @file CRTBackTrackerIndex_test.cc
+ * @brief Unit test for `icarus::crt::details::CollectionIndex`
+ * @date October 18, 2026
+ * @see icaruscode/CRT/CRTUtils/CRTBackTrackerIndex.h
+ *
+ * The truth returned through the index is compared with the linear scan with
+ * `DataCompare()`/`HitCompare()` which `CRTBackTracker` used to perform for
+ * each `AllTrueIds()` and `TrueIdFromTotalEnergy()` query.
+ */
+
+// ICARUS libraries
+#include "icaruscode/CRT/CRTUtils/CRTBackTrackerIndex.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( CRTBackTrackerIndex_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  using icarus::crt::CRTData;
+  using sbn::crt::CRTHit;
+  using icarus::crt::details::CollectionIndex;
+  using icarus::crt::details::IdEnergies;
+
+  /// Index of the element matching `element` as the original scan
+  /// (the last one; `noMatch` if none), and the number of matches.
+  template <typename T>
+  std::pair<int, unsigned int> scanCollection
+    (std::vector<T> const& collection, T const& element, int noMatch)
+  {
+    int match_i = noMatch, index = 0;
+    unsigned int nmatch = 0;
+    for(auto const& other : collection){
+      if(icarus::crt::details::SameContent(other, element)) {
+        match_i = index;
+        nmatch++;
+      }
+      index++;
+    }
+    return { match_i, nmatch };
+  }
+
+  /// `AllTrueIds()` as the original implementation, from the matching element.
+  std::vector<int> referenceAllTrueIds(IdEnergies const& truth) {
+    std::vector<int> ids;
+    for(auto const& [ id, energy ]: truth) ids.push_back(id);
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+  }
+
+  /// `TrueIdFromTotalEnergy()` as the original implementation.
+  int referenceTrueIdFromTotalEnergy(IdEnergies const& truth) {
+    std::map<int, double> ids;
+    for(auto const& [ id, energy ]: truth) ids[id] += energy;
+
+    double maxEnergy = -1;
+    int trueId = -99999;
+    for(auto &id : ids){
+      if(id.second > maxEnergy){
+        maxEnergy = id.second;
+        trueId = id.first;
+      }
+    }
+    return trueId;
+  }
+
+
+  /// Contributions to an element, with repeated IDs and negative (unsaved) ones.
+  IdEnergies makeTruth(std::mt19937& engine) {
+    std::uniform_int_distribution<int> nIDEs { 0, 6 };
+    std::uniform_int_distribution<int> id { -5, 12 };
+    std::uniform_int_distribution<int> energy { 0, 20 };
+
+    IdEnergies truth(nIDEs(engine));
+    for (auto& [ trackID, deposit ]: truth) {
+      trackID = id(engine);
+      deposit = energy(engine) * 0.25;
+    }
+    return truth;
+  }
+
+  CRTData makeData(std::mt19937& engine) {
+    std::uniform_int_distribution<int> mac5 { 0, 3 };
+    std::uniform_int_distribution<int> time { 0, 2 };
+    std::uniform_int_distribution<int> adc { 0, 1 };
+
+    CRTData data;
+    data.fMac5 = mac5(engine);
+    data.fTs0 = time(engine);
+    data.fTs1 = time(engine);
+    data.fEntry = 0;
+    for (int ch = 0; ch < 64; ++ch) data.fAdc[ch] = (ch == 7)? adc(engine): 0;
+    return data;
+  }
+
+  CRTHit makeHit(std::mt19937& engine) {
+    std::uniform_int_distribution<int> time { 0, 5 };
+    std::uniform_int_distribution<int> plane { 0, 2 };
+    std::uniform_int_distribution<int> pos { -1, 1 };
+    std::uniform_int_distribution<int> tagger { 0, 1 };
+
+    CRTHit hit;
+    hit.ts1_ns = time(engine);
+    hit.plane = plane(engine);
+    hit.x_pos = pos(engine) * 10.f;
+    hit.y_pos = (pos(engine) == 0)? -0.f: 0.f; // both zeros
+    hit.z_pos = pos(engine) * 5.f;
+    hit.x_err = hit.y_err = hit.z_err = 1.f;
+    hit.tagger = tagger(engine)? "Top": "Side";
+    return hit;
+  }
+
+
+  /// Checks all the queries on each element of `queries` (and on `collection`).
+  template <typename T>
+  unsigned int checkQueries(
+    CollectionIndex<T> const& index, std::vector<T> const& collection,
+    std::vector<IdEnergies> const& truth, std::vector<T> const& queries
+  ) {
+    unsigned int nDuplicates = 0U;
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      BOOST_TEST_CONTEXT("query #" << i) {
+        T const& query = queries[i];
+
+        // data and track queries used the first element when nothing matches
+        auto const [ expected_i, expectedCount ]
+          = scanCollection(collection, query, 0);
+        auto const match = index.Find(collection, query);
+
+        BOOST_TEST(match.count == expectedCount);
+        if (expectedCount > 1) ++nDuplicates;
+        if (collection.empty()) continue;
+        BOOST_TEST(match.index == std::size_t(expected_i));
+
+        BOOST_TEST(
+          icarus::crt::details::SortedIds(index.Truth(match.index))
+            == referenceAllTrueIds(truth[expected_i]),
+          boost::test_tools::per_element()
+          );
+        BOOST_TEST(
+          icarus::crt::details::MaxEnergyId(index.Truth(match.index))
+            == referenceTrueIdFromTotalEnergy(truth[expected_i])
+          );
+      }
+    } // for
+    return nDuplicates;
+  } // checkQueries()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(DataQueriesTest) {
+
+  std::mt19937 engine { 43U };
+
+  unsigned int nDuplicates = 0U;
+  for (int event = 0; event < 200; ++event) {
+    BOOST_TEST_CONTEXT("event #" << event) {
+      // few possible values, so that many elements have the same content
+      std::vector<CRTData> collection(event % 40);
+      std::vector<IdEnergies> truth;
+      for (CRTData& data: collection) {
+        data = makeData(engine);
+        truth.push_back(makeTruth(engine));
+      }
+      CollectionIndex<CRTData> const index { collection, truth };
+
+      std::vector<CRTData> queries = collection;
+      for (int i = 0; i < 10; ++i) queries.push_back(makeData(engine));
+      nDuplicates += checkQueries(index, collection, truth, queries);
+    }
+  } // for events
+
+  BOOST_TEST(nDuplicates > 100U);
+
+} // BOOST_AUTO_TEST_CASE(DataQueriesTest)
+
+
+BOOST_AUTO_TEST_CASE(HitQueriesTest) {
+
+  std::mt19937 engine { 44U };
+
+  unsigned int nDuplicates = 0U;
+  for (int event = 0; event < 200; ++event) {
+    BOOST_TEST_CONTEXT("event #" << event) {
+      std::vector<CRTHit> collection(event % 40);
+      std::vector<IdEnergies> truth;
+      for (CRTHit& hit: collection) {
+        hit = makeHit(engine);
+        truth.push_back(makeTruth(engine));
+      }
+      // a hit which does not even match itself
+      if (!collection.empty())
+        collection.back().x_pos = std::numeric_limits<float>::quiet_NaN();
+      CollectionIndex<CRTHit> const index { collection, truth };
+
+      std::vector<CRTHit> queries = collection;
+      for (int i = 0; i < 10; ++i) queries.push_back(makeHit(engine));
+      nDuplicates += checkQueries(index, collection, truth, queries);
+
+      // hit queries report no match at all
+      for (CRTHit const& query: queries) {
+        auto const [ expected_i, expectedCount ]
+          = scanCollection(collection, query, -1);
+        auto const match = index.Find(collection, query);
+        BOOST_TEST((match.count > 0) == (expected_i != -1));
+      }
+    }
+  } // for events
+
+  BOOST_TEST(nDuplicates > 100U);
+
+} // BOOST_AUTO_TEST_CASE(HitQueriesTest)
+
+
+BOOST_AUTO_TEST_CASE(SameEventIDTest) {
+
+  /*
+   * Two events with the same ID, whose collections have the same address and
+   * size but different content and truth: each event gets its own index.
+   */
+  std::mt19937 engine { 45U };
+
+  std::vector<CRTData> collection(30);
+  CRTData const* const address = collection.data();
+
+  for (int event = 0; event < 2; ++event) {
+    BOOST_TEST_CONTEXT("event #" << event) {
+      std::vector<IdEnergies> truth;
+      for (CRTData& data: collection) {
+        data = makeData(engine);
+        truth.push_back(makeTruth(engine));
+      }
+      BOOST_TEST_REQUIRE(collection.data() == address);
+
+      CollectionIndex<CRTData> const index { collection, truth };
+      checkQueries(index, collection, truth, collection);
+    }
+  } // for events
+
+} // BOOST_AUTO_TEST_CASE(SameEventIDTest)
+
+
+// -----------------------------------------------------------------------------
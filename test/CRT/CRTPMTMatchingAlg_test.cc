@@ -0,0 +1,182 @@
+/**
+ * @file CRTPMTMatchingAlg_test.cc
+ * @brief Unit test for `icarus::crt::CRTPMTMatchingAlg`
+ * @date October 18, 2026
+ * @see icaruscode/CRT/CRTUtils/CRTPMTMatchingAlg.h
+ *
+ * The matching is compared with the scan of all flashes and optical hits
+ * which `CRTPMTMatchingAna` used to perform for each CRT hit.
+ */
+
+// ICARUS libraries
+#include "icaruscode/CRT/CRTUtils/CRTPMTMatchingAlg.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( CRTPMTMatchingAlg_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  using icarus::crt::CRTPMTMatchingAlg;
+
+  constexpr double FlashPEThreshold = 50.;
+  constexpr double HitPEThreshold = 5.;
+  constexpr double CoincidenceWindow = 60.;
+
+  /// Flash matching as the original scan: closest flash in input order,
+  /// earliest hit among all the flashes which were the closest so far.
+  CRTPMTMatchingAlg::FlashMatch scanFlashes
+    (std::vector<CRTPMTMatchingAlg::FlashInfo> const& flashes, double tcrt)
+  {
+    CRTPMTMatchingAlg::FlashMatch match;
+    double tdiff = std::numeric_limits<double>::max();
+    double firstHitTime = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < flashes.size(); ++i) {
+      auto const& flash = flashes[i];
+      if (flash.totalPE < FlashPEThreshold) continue;
+      if (!(std::abs(tcrt - flash.time) < std::abs(tdiff))) continue;
+      tdiff = tcrt - flash.time;
+      match.flash = i;
+      if (flash.hasHits && flash.firstHit.time < firstHitTime) {
+        firstHitTime = flash.firstHit.time;
+        match.firstHitFlash = i;
+      }
+    } // for
+    return match;
+  } // scanFlashes()
+
+  /// Optical hit matching as the original scan: most PE in the window.
+  std::size_t scanOpHits
+    (std::vector<CRTPMTMatchingAlg::OpHitInfo> const& hits, double tcrt)
+  {
+    std::size_t best = CRTPMTMatchingAlg::NoMatch;
+    double pemax = 0.;
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+      auto const& hit = hits[i];
+      if (hit.pe < HitPEThreshold) continue;
+      if (std::abs(tcrt - hit.time) < CoincidenceWindow && hit.pe > pemax) {
+        pemax = hit.pe;
+        best = i;
+      }
+    } // for
+    return best;
+  } // scanOpHits()
+
+  /// Random flashes; times and PE are rounded to provoke ties.
+  std::vector<CRTPMTMatchingAlg::FlashInfo> makeFlashes
+    (std::mt19937& engine, std::size_t n)
+  {
+    std::uniform_real_distribution<double> times { -1500., 1500. };
+    std::uniform_real_distribution<double> PEs { 0., 200. };
+    std::uniform_int_distribution<int> nHits { 0, 3 };
+    std::vector<CRTPMTMatchingAlg::FlashInfo> flashes;
+    for (std::size_t i = 0; i < n; ++i) {
+      CRTPMTMatchingAlg::FlashInfo flash
+        { std::round(times(engine)), std::round(PEs(engine)), { 0., 1., 2. }, int(i % 2) };
+      for (int iHit = nHits(engine); iHit > 0; --iHit) {
+        double const t = std::round(flash.time + times(engine) / 100.);
+        if (t < flash.firstHit.time) {
+          flash.firstHit = { t, PEs(engine), { 3., 4., 5. } };
+          flash.hasHits = true;
+        }
+      } // for hits
+      flashes.push_back(flash);
+    } // for
+    return flashes;
+  } // makeFlashes()
+
+  /// Random optical hits; times and PE are rounded to provoke ties.
+  std::vector<CRTPMTMatchingAlg::OpHitInfo> makeOpHits
+    (std::mt19937& engine, std::size_t n)
+  {
+    std::uniform_real_distribution<double> times { -1500., 1500. };
+    std::uniform_real_distribution<double> PEs { 0., 30. };
+    std::vector<CRTPMTMatchingAlg::OpHitInfo> hits;
+    for (std::size_t i = 0; i < n; ++i)
+      hits.push_back({ std::round(times(engine)), std::round(PEs(engine)), { 0., 0., 0. } });
+    return hits;
+  } // makeOpHits()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(FlashChain_test) {
+
+  CRTPMTMatchingAlg alg { FlashPEThreshold, HitPEThreshold, CoincidenceWindow };
+
+  // the scan meets the flash at 100 first, then the closer one at 20;
+  // the "first hit" is the earliest of the two, not the one of the match
+  std::vector<CRTPMTMatchingAlg::FlashInfo> flashes {
+    { 100., 80., { 0., 0., 0. }, 0, { 90., 10., { 1., 1., 1. } }, true },
+    {  20., 10., { 0., 0., 0. }, 0, { -5., 10., { 2., 2., 2. } }, true }, // below threshold
+    {  20., 90., { 0., 0., 0. }, 1, { 95., 10., { 3., 3., 3. } }, true },
+    { -20., 90., { 0., 0., 0. }, 1, { -30., 10., { 4., 4., 4. } }, true }, // tie, later
+  };
+  alg.SetFlashes(flashes);
+
+  CRTPMTMatchingAlg::FlashMatch const match = alg.MatchFlash(0.);
+  BOOST_TEST(match.matched());
+  BOOST_TEST(match.flash == 2U);
+  BOOST_TEST(match.firstHitFlash == 0U);
+
+  // a flash list with nothing above threshold
+  alg.SetFlashes({ flashes[1] });
+  BOOST_TEST(!alg.MatchFlash(0.).matched());
+  BOOST_TEST(!alg.MatchFlash(0.).hasFirstHit());
+
+} // BOOST_AUTO_TEST_CASE(FlashChain_test)
+
+
+BOOST_AUTO_TEST_CASE(OpHitWindow_test) {
+
+  CRTPMTMatchingAlg alg { FlashPEThreshold, HitPEThreshold, CoincidenceWindow };
+  alg.SetOpHits({
+    {  59., 20., { 0., 0., 0. } },
+    { -60., 40., { 0., 0., 0. } }, // out of the window
+    { -10., 20., { 0., 0., 0. } }, // tie, later
+    {  10.,  4., { 0., 0., 0. } }, // below threshold
+  });
+
+  BOOST_TEST(alg.MatchOpHit(0.) == 0U);
+  BOOST_TEST(alg.MatchOpHit(-100.) == 1U);
+  BOOST_TEST(alg.MatchOpHit(500.) == CRTPMTMatchingAlg::NoMatch);
+
+} // BOOST_AUTO_TEST_CASE(OpHitWindow_test)
+
+
+BOOST_AUTO_TEST_CASE(Scan_test) {
+
+  std::mt19937 engine { 12345U };
+  std::uniform_real_distribution<double> CRTtimes { -1600., 1600. };
+
+  for (std::size_t n: { 0U, 1U, 2U, 7U, 64U, 300U }) {
+    CRTPMTMatchingAlg alg { FlashPEThreshold, HitPEThreshold, CoincidenceWindow };
+    auto const flashes = makeFlashes(engine, n);
+    auto const hits = makeOpHits(engine, 4 * n);
+    alg.SetFlashes(flashes);
+    alg.SetOpHits(hits);
+
+    for (int iCRT = 0; iCRT < 200; ++iCRT) {
+      double const tcrt = std::round(CRTtimes(engine));
+      auto const expected = scanFlashes(flashes, tcrt);
+      auto const match = alg.MatchFlash(tcrt);
+      BOOST_TEST(match.flash == expected.flash);
+      BOOST_TEST(match.firstHitFlash == expected.firstHitFlash);
+      BOOST_TEST(alg.MatchOpHit(tcrt) == scanOpHits(hits, tcrt));
+    } // for CRT hits
+  } // for sizes
+
+} // BOOST_AUTO_TEST_CASE(Scan_test)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,399 @@
+/**
+ * @file ChannelMapSnapshot_test.cc
+ * @brief Unit test for `icarusDB::ChannelMapSnapshot`
+ * @date October 18, 2026
+ * @see icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.h
+ *
+ * The test uses a synthetic channel mapping with the size and structure of
+ * the ICARUS one, and checks every entry of it against the snapshot, both
+ * created in memory and read back from a file.
+ * The time of the lookups is printed but not checked.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Decode/ChannelMapping/ChannelMapSnapshot.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ChannelMapSnapshot_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator> // std::istreambuf_iterator
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using Snapshot = icarusDB::ChannelMapSnapshot;
+
+
+// creates a mapping resembling the ICARUS one
+Snapshot::Maps makeMaps() {
+
+  Snapshot::Maps maps;
+
+  // TPC: 96 crates, 9 boards each, 64 channels each
+  unsigned int boardID = 0;
+  unsigned int channel = 0;
+  for (unsigned int crate = 0; crate < 96; ++crate) {
+    unsigned int const fragmentID = 0x1000 + crate;
+    auto& [ crateName, boards ] = maps.tpcFragments[fragmentID];
+    crateName = (crate % 2? "WW": "EE") + std::to_string(crate / 2);
+    for (unsigned int slot = 0; slot < 9; ++slot) {
+      ++boardID;
+      boards.push_back(boardID);
+      auto& [ boardSlot, channels ] = maps.tpcBoards[boardID];
+      boardSlot = slot;
+      for (unsigned int i = 0; i < 64; ++i) {
+        // non-monotonic channel numbering, as in the real mapping
+        channels.emplace_back(channel + 63 - i, (boardID + i) % 3);
+      }
+      channel += 64;
+    } // for boards
+  } // for crates
+  // a board that is not in any fragment, and an unreadout fragment
+  maps.tpcBoards[5000] = { 3, { { 99999, 2 } } };
+  maps.tpcFragments[0x1200] = { "spare", {} };
+
+  // PMT: 24 digitizers, 16 channels each (one not connected)
+  for (std::size_t key = 0; key < 24; ++key) {
+    auto& channels = maps.pmtFragments[key];
+    for (std::size_t ch = 0; ch < 16; ++ch)
+      channels.emplace_back(ch, (ch == 15)? 999999: key * 15 + ch);
+  }
+
+  // CRT: two channels for each side module; a few share the same hardware
+  // address (the last in channel ID order must win)
+  for (unsigned int channelID = 0; channelID < 200; ++channelID) {
+    unsigned int const hw = 1 + channelID / 2 + ((channelID % 50 == 7)? 1: 0);
+    maps.crtChannels[channelID] = { hw, 1000 + channelID };
+  }
+
+  for (unsigned int hw = 100; hw < 330; hw += 2) maps.topCRT[hw] = hw * 3;
+
+  for (int mac5 = 1; mac5 < 100; ++mac5) {
+    for (int chan = 0; chan < 32; chan += (mac5 % 3 + 1)) {
+      maps.sideCRTCalibration[{ mac5, chan }]
+        = { 1.0 + mac5 * 0.01 + chan * 1e-4, 100.0 + chan };
+    }
+  }
+
+  return maps;
+} // makeMaps()
+
+
+// -----------------------------------------------------------------------------
+// reference implementation of the lookups, as in `ICARUSChannelMapProvider`
+unsigned int referenceSimMacAddress
+  (Snapshot::Maps const& maps, unsigned int hw)
+{
+  unsigned int sim = 0;
+  for (auto const& pair: maps.crtChannels)
+    if (pair.second.first == hw) sim = pair.second.second;
+  return sim;
+} // referenceSimMacAddress()
+
+
+// -----------------------------------------------------------------------------
+// checks every entry of `maps` (and some missing ones) in `snapshot`
+void checkSnapshot(Snapshot const& snapshot, Snapshot::Maps const& maps) {
+
+  // TPC fragments
+  BOOST_TEST(snapshot.tpcFragments().size() == maps.tpcFragments.size());
+  for (auto const& [ fragmentID, crateAndBoards ]: maps.tpcFragments) {
+    BOOST_TEST_CONTEXT("TPC fragment " << fragmentID) {
+      std::uint32_t const index = snapshot.tpcFragmentIndex(fragmentID);
+      BOOST_TEST_REQUIRE(index != Snapshot::NoEntry);
+      auto const& fragment = snapshot.tpcFragments()[index];
+      BOOST_TEST(fragment.fragmentID == fragmentID);
+      BOOST_TEST(snapshot.crateName(fragment) == crateAndBoards.first);
+      auto const boards = snapshot.readoutBoards(fragment);
+      BOOST_TEST(std::vector<unsigned int>(boards.begin(), boards.end())
+        == crateAndBoards.second, boost::test_tools::per_element());
+    }
+  }
+  BOOST_TEST(snapshot.tpcFragmentIndex(0x0FFF) == Snapshot::NoEntry);
+  BOOST_TEST(snapshot.tpcFragmentIndex(0x1100) == Snapshot::NoEntry);
+  BOOST_TEST(snapshot.tpcFragmentIndex(0x1201) == Snapshot::NoEntry);
+  BOOST_TEST(snapshot.tpcFragmentIndex(0) == Snapshot::NoEntry);
+
+  // TPC boards
+  BOOST_TEST(snapshot.tpcBoards().size() == maps.tpcBoards.size());
+  for (auto const& [ boardID, slotAndChannels ]: maps.tpcBoards) {
+    BOOST_TEST_CONTEXT("TPC board " << boardID) {
+      std::uint32_t const index = snapshot.tpcBoardIndex(boardID);
+      BOOST_TEST_REQUIRE(index != Snapshot::NoEntry);
+      auto const& board = snapshot.tpcBoards()[index];
+      BOOST_TEST(board.boardID == boardID);
+      BOOST_TEST(board.slot == slotAndChannels.first);
+      auto const channels = snapshot.channelPlanes(board);
+      BOOST_TEST_REQUIRE(channels.size() == slotAndChannels.second.size());
+      for (std::size_t i = 0; i < channels.size(); ++i) {
+        BOOST_TEST(channels[i].channel == slotAndChannels.second[i].first);
+        BOOST_TEST(channels[i].plane == slotAndChannels.second[i].second);
+      }
+    }
+  }
+  BOOST_TEST(snapshot.tpcBoardIndex(0) == Snapshot::NoEntry);
+  BOOST_TEST(snapshot.tpcBoardIndex(4999) == Snapshot::NoEntry);
+  BOOST_TEST(snapshot.tpcBoardIndex(5001) == Snapshot::NoEntry);
+
+  // PMT
+  BOOST_TEST(snapshot.pmtFragments().size() == maps.pmtFragments.size());
+  for (auto const& [ dbKey, channels ]: maps.pmtFragments) {
+    BOOST_TEST_CONTEXT("PMT digitizer " << dbKey) {
+      std::uint32_t const index = snapshot.pmtFragmentIndex(dbKey);
+      BOOST_TEST_REQUIRE(index != Snapshot::NoEntry);
+      auto const& fragment = snapshot.pmtFragments()[index];
+      BOOST_TEST(fragment.dbKey == dbKey);
+      auto const snapChannels = snapshot.digitizerChannels(fragment);
+      BOOST_TEST_REQUIRE(snapChannels.size() == channels.size());
+      for (std::size_t i = 0; i < channels.size(); ++i) {
+        BOOST_TEST(snapChannels[i].digitizerChannel == channels[i].first);
+        BOOST_TEST(snapChannels[i].channelID == channels[i].second);
+      }
+    }
+  }
+  BOOST_TEST(snapshot.pmtFragmentIndex(24) == Snapshot::NoEntry);
+
+  // CRT
+  BOOST_TEST(snapshot.crtChannels().size() == maps.crtChannels.size());
+  for (unsigned int hw = 0; hw < 120; ++hw) {
+    BOOST_TEST_CONTEXT("CRT hardware MAC address " << hw) {
+      BOOST_TEST(snapshot.simMacAddress(hw) == referenceSimMacAddress(maps, hw));
+    }
+  }
+  BOOST_TEST(snapshot.topCRT().size() == maps.topCRT.size());
+  for (unsigned int hw = 0; hw < 400; ++hw) {
+    BOOST_TEST_CONTEXT("top CRT hardware MAC address " << hw) {
+      auto const it = maps.topCRT.find(hw);
+      BOOST_TEST(snapshot.topSimMacAddress(hw)
+        == ((it == maps.topCRT.end())? 0U: it->second));
+    }
+  }
+  BOOST_TEST
+    (snapshot.sideCRTCalibrations().size() == maps.sideCRTCalibration.size());
+  for (int mac5 = -2; mac5 < 105; ++mac5) {
+    for (int chan = -2; chan < 35; ++chan) {
+      BOOST_TEST_CONTEXT("side CRT MAC5 " << mac5 << " channel " << chan) {
+        auto const it = maps.sideCRTCalibration.find({ mac5, chan });
+        std::uint32_t const index = snapshot.sideCRTCalibrationIndex(mac5, chan);
+        if (it == maps.sideCRTCalibration.end()) {
+          BOOST_TEST(index == Snapshot::NoEntry);
+          continue;
+        }
+        BOOST_TEST_REQUIRE(index != Snapshot::NoEntry);
+        auto const& calib = snapshot.sideCRTCalibrations()[index];
+        BOOST_TEST(calib.gain == it->second.first);
+        BOOST_TEST(calib.pedestal == it->second.second);
+      }
+    }
+  }
+
+  // full round trip
+  Snapshot::Maps const copy = snapshot.toMaps();
+  BOOST_TEST((copy.tpcFragments == maps.tpcFragments));
+  BOOST_TEST((copy.tpcBoards == maps.tpcBoards));
+  BOOST_TEST((copy.pmtFragments == maps.pmtFragments));
+  BOOST_TEST((copy.crtChannels == maps.crtChannels));
+  BOOST_TEST((copy.topCRT == maps.topCRT));
+  BOOST_TEST((copy.sideCRTCalibration == maps.sideCRTCalibration));
+
+} // checkSnapshot()
+
+
+// -----------------------------------------------------------------------------
+void memorySnapshot_test() {
+
+  Snapshot::Maps const maps = makeMaps();
+  Snapshot const snapshot = Snapshot::fromMaps(maps);
+  checkSnapshot(snapshot, maps);
+
+  // moving keeps the content
+  Snapshot moved { Snapshot::fromMaps(maps) };
+  Snapshot target;
+  BOOST_TEST(target.tpcFragmentIndex(0x1000) == Snapshot::NoEntry);
+  BOOST_TEST(target.tpcFragments().empty());
+  target = std::move(moved);
+  checkSnapshot(target, maps);
+
+} // memorySnapshot_test()
+
+
+void fileSnapshot_test() {
+
+  Snapshot::Maps const maps = makeMaps();
+  Snapshot::fromMaps(maps).write("ChannelMapSnapshot_test.snapshot");
+
+  Snapshot const snapshot
+    = Snapshot::fromFile("ChannelMapSnapshot_test.snapshot");
+  checkSnapshot(snapshot, maps);
+
+} // fileSnapshot_test()
+
+
+void emptySnapshot_test() {
+
+  Snapshot::fromMaps({}).write("ChannelMapSnapshot_test_empty.snapshot");
+  Snapshot const snapshot
+    = Snapshot::fromFile("ChannelMapSnapshot_test_empty.snapshot");
+
+  BOOST_TEST(snapshot.tpcFragments().empty());
+  BOOST_TEST(snapshot.tpcFragmentIndex(0) == Snapshot::NoEntry);
+  BOOST_TEST(snapshot.tpcBoardIndex(0) == Snapshot::NoEntry);
+  BOOST_TEST(snapshot.pmtFragmentIndex(0) == Snapshot::NoEntry);
+  BOOST_TEST(snapshot.simMacAddress(0) == 0U);
+  BOOST_TEST(snapshot.topSimMacAddress(0) == 0U);
+  BOOST_TEST(snapshot.sideCRTCalibrationIndex(0, 0) == Snapshot::NoEntry);
+
+} // emptySnapshot_test()
+
+
+void formatErrors_test() {
+
+  Snapshot::fromMaps(makeMaps()).write("ChannelMapSnapshot_test_good.snapshot");
+  std::string content;
+  {
+    std::ifstream in
+      { "ChannelMapSnapshot_test_good.snapshot", std::ios::binary };
+    content.assign
+      (std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{});
+  }
+  BOOST_TEST_REQUIRE(content.size() > 64U);
+
+  auto writeAndRead = [](std::string const& data) {
+    {
+      std::ofstream out
+        { "ChannelMapSnapshot_test_bad.snapshot", std::ios::binary };
+      out << data;
+    }
+    Snapshot::fromFile("ChannelMapSnapshot_test_bad.snapshot");
+  };
+
+  // missing file
+  BOOST_CHECK_THROW(
+    Snapshot::fromFile("ChannelMapSnapshot_test_missing.snapshot"),
+    cet::exception
+    );
+
+  // wrong signature
+  std::string bad = content;
+  bad[0] = 'X';
+  BOOST_CHECK_THROW(writeAndRead(bad), cet::exception);
+
+  // different version (right after the 8-byte signature)
+  bad = content;
+  bad[8] += 1;
+  BOOST_CHECK_THROW(writeAndRead(bad), cet::exception);
+
+  // different byte order (after the version)
+  bad = content;
+  std::swap(bad[12], bad[15]);
+  BOOST_CHECK_THROW(writeAndRead(bad), cet::exception);
+
+  // truncated
+  BOOST_CHECK_THROW
+    (writeAndRead(content.substr(0, content.size() - 8)), cet::exception);
+  BOOST_CHECK_THROW(writeAndRead(content.substr(0, 20)), cet::exception);
+
+  // sanity check: the unmodified content is accepted
+  BOOST_CHECK_NO_THROW(writeAndRead(content));
+
+  // keys too sparse for a dense table
+  Snapshot::Maps sparse;
+  sparse.tpcBoards[0] = {};
+  sparse.tpcBoards[0x7FFFFFFF] = {};
+  BOOST_CHECK_THROW(Snapshot::fromMaps(sparse), cet::exception);
+
+} // formatErrors_test()
+
+
+void lookupTiming_test() {
+
+  using Clock_t = std::chrono::steady_clock;
+
+  Snapshot::Maps const maps = makeMaps();
+  Snapshot const snapshot = Snapshot::fromMaps(maps);
+
+  std::vector<unsigned int> boardIDs;
+  for (auto const& [ fragmentID, crateAndBoards ]: maps.tpcFragments)
+    boardIDs.insert(boardIDs.end(),
+      crateAndBoards.second.begin(), crateAndBoards.second.end());
+
+  constexpr unsigned int NRounds = 200;
+  unsigned long long checkMaps = 0, checkSnapshot = 0;
+
+  auto start = Clock_t::now();
+  for (unsigned int round = 0; round < NRounds; ++round) {
+    for (unsigned int const boardID: boardIDs)
+      checkMaps += maps.tpcBoards.find(boardID)->second.second.front().first;
+  }
+  std::chrono::duration<double> const mapTime = Clock_t::now() - start;
+
+  start = Clock_t::now();
+  for (unsigned int round = 0; round < NRounds; ++round) {
+    for (unsigned int const boardID: boardIDs) {
+      auto const& board = snapshot.tpcBoards()[snapshot.tpcBoardIndex(boardID)];
+      checkSnapshot += snapshot.channelPlanes(board)[0].channel;
+    }
+  }
+  std::chrono::duration<double> const snapshotTime = Clock_t::now() - start;
+
+  BOOST_TEST(checkMaps == checkSnapshot);
+
+  double const nLookups = double(NRounds) * boardIDs.size();
+  std::cout << "Board lookup: " << (mapTime.count() * 1e9 / nLookups)
+    << " ns from std::map, " << (snapshotTime.count() * 1e9 / nLookups)
+    << " ns from snapshot (" << snapshot.sizeInBytes() << " bytes)"
+    << std::endl;
+
+} // lookupTiming_test()
+
+
+// -----------------------------------------------------------------------------
+// BEGIN Test cases  -----------------------------------------------------------
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(memorySnapshot_testcase) {
+
+  memorySnapshot_test();
+
+} // BOOST_AUTO_TEST_CASE(memorySnapshot_testcase)
+
+
+BOOST_AUTO_TEST_CASE(fileSnapshot_testcase) {
+
+  fileSnapshot_test();
+
+} // BOOST_AUTO_TEST_CASE(fileSnapshot_testcase)
+
+
+BOOST_AUTO_TEST_CASE(emptySnapshot_testcase) {
+
+  emptySnapshot_test();
+
+} // BOOST_AUTO_TEST_CASE(emptySnapshot_testcase)
+
+
+BOOST_AUTO_TEST_CASE(formatErrors_testcase) {
+
+  formatErrors_test();
+
+} // BOOST_AUTO_TEST_CASE(formatErrors_testcase)
+
+
+BOOST_AUTO_TEST_CASE(lookupTiming_testcase) {
+
+  lookupTiming_test();
+
+} // BOOST_AUTO_TEST_CASE(lookupTiming_testcase)
+
+
+// -----------------------------------------------------------------------------
+// END Test cases  -------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -9,12 +9,16 @@
 
 // ICARUS libraries
 #include "icaruscode/Decode/DecoderTools/details/KeyedCSVparser.h"
+#include "icaruscode/Decode/DecoderTools/details/KeyPattern.h"
 
 // Boost libraries
 #define BOOST_TEST_MODULE ( KeyedCSVparser_test )
 #include <boost/test/unit_test.hpp>
 
 // C/C++ standard library
+#include <chrono>
+#include <iostream>
+#include <regex>
 #include <string>
 #include <vector>
 #include <cstdint> // std::uint32_t
@@ -156,6 +160,158 @@ void KeyedCSVparser_documentation_test() {
 } // KeyedCSVparser_documentation_test()
 
 
+// -----------------------------------------------------------------------------
+void KeyedCSVparser_errors_test() {
+  
+  using namespace std::string_view_literals;
+  icarus::details::KeyedCSVparser parser;
+  parser.addPatterns({
+        { "Trigger Type", 1U }
+      , { "TPChitTimes", icarus::details::KeyedCSVparser::FixedSize }
+      , { "Cryo. (EAST|WEST) Connector . and .", 1U }
+    });
+  
+  // values without a key
+  BOOST_CHECK_THROW
+    (parser("12, TPChits, 3"sv), icarus::details::KeyedCSVparser::InvalidFormat);
+  
+  // duplicate key
+  BOOST_CHECK_THROW
+    (parser("TPChits, 3, TPChits, 4"sv), icarus::KeyValuesData::DuplicateKey);
+  
+  // missing fixed values
+  BOOST_CHECK_THROW
+    (parser("TPChits, 3, Trigger Type"sv), icarus::details::KeyedCSVparser::MissingValues);
+  
+  // missing or bad size
+  BOOST_CHECK_THROW
+    (parser("TPChitTimes"sv), icarus::details::KeyedCSVparser::MissingSize);
+  BOOST_CHECK_THROW
+    (parser("TPChitTimes, "sv), icarus::details::KeyedCSVparser::MissingSize);
+  BOOST_CHECK_THROW
+    (parser("TPChitTimes, three, 1, 2, 3"sv), icarus::details::KeyedCSVparser::MissingSize);
+  
+  // all derive from the common error
+  BOOST_CHECK_THROW
+    (parser("TPChitTimes, 4, 1, 2"sv), icarus::details::KeyedCSVparser::Error);
+  
+  // patterns force keys and values
+  auto const data = parser(
+    "Cryo. EAST Connector 0 and 1, 00ff 0000,"
+    " Cryo. WEST Connector 2 and 3, 0000 0001,"
+    " Cryo. NORTH Connector 2 and 3, 5"
+    " \r\n"sv
+    );
+  BOOST_TEST(data.size() == 3U);
+  BOOST_TEST(data.getItem("Cryo. EAST Connector 0 and 1").value() == "00ff 0000");
+  BOOST_TEST(data.getItem("Cryo. WEST Connector 2 and 3").value() == "0000 0001");
+  BOOST_TEST(data.getItem("Cryo. NORTH Connector 2 and 3").value() == "5");
+  
+} // KeyedCSVparser_errors_test()
+
+
+// -----------------------------------------------------------------------------
+void KeyPattern_test() {
+  
+  std::vector<std::string> const patterns {
+      "Trigger Type"
+    , "Cryo. (EAST|WEST) Connector . and ."
+    , "icaruspmt.*"
+    , ".*pmt.*"
+    , "a.c"
+    , "(A|BB|)x(1|2)"
+    , R"(\.\*literal\(\))"
+    , "[0-9]+"      // unsupported syntax: uses std::regex
+    , "ab*c"        // unsupported syntax: uses std::regex
+    , R"(\d\d)"     // unsupported syntax: uses std::regex
+  };
+  std::vector<std::string> const keys {
+      "", "Trigger Type", "Trigger Type ", "trigger type", "Trigger"
+    , "Cryo. EAST Connector 0 and 1", "Cryo. WEST Connector 2 and 3"
+    , "Cryo. NORTH Connector 0 and 1", "Cryo. EAST Connector 10 and 1"
+    , "Cryo.\nEAST Connector 0 and 1"
+    , "icaruspmt", "icaruspmtee01", "icarustrigger", "xicaruspmt", "pmt"
+    , "icaruspmt\nee01"
+    , "abc", "a\nc", "ac", "abbc", "x", "Ax1", "BBx2", "Bx1", "Ax3"
+    , ".*literal()", "x*literal()", "123", "12"
+  };
+  
+  for (std::string const& pattern: patterns) {
+    icarus::details::KeyPattern const keyPattern { pattern };
+    std::regex const regex { pattern };
+    for (std::string const& key: keys) {
+      BOOST_TEST_CONTEXT("Pattern '" << pattern << "' on '" << key << "'") {
+        BOOST_TEST(keyPattern.match(key) == std::regex_match(key, regex));
+      }
+    } // for keys
+  } // for patterns
+  
+  BOOST_TEST(!icarus::details::KeyPattern{ "Cryo. (EAST|WEST) Connector . and ." }.usesRegex());
+  BOOST_TEST(!icarus::details::KeyPattern{ "icaruspmt.*" }.usesRegex());
+  BOOST_TEST(icarus::details::KeyPattern{ "[0-9]+" }.usesRegex());
+  BOOST_TEST(icarus::details::KeyPattern{ std::regex{ "icaruspmt.*" } }.usesRegex());
+  
+} // KeyPattern_test()
+
+
+// -----------------------------------------------------------------------------
+void KeyedCSVparser_benchmark() {
+  
+  // resembling the trigger string from the trigger DAQ
+  std::string const triggerString {
+    "Event, 36, Seconds, 1656000000, Nanoseconds, 537268790,"
+    " Wr type, 1, Trigger Type, 1, Trigger Source, 2, WR Seconds, 1656000037,"
+    " WR Nanoseconds, 537268790,"
+    " Cryo. EAST Connector 0 and 1, 00000000 00000000,"
+    " Cryo. EAST Connector 2 and 3, 00000000 00000100,"
+    " Cryo. WEST Connector 0 and 1, 00000000 00000000,"
+    " Cryo. WEST Connector 2 and 3, 00000000 00000000,"
+    " Cryo1 EAST counts, 3, Cryo2 WEST counts, 1, MJ_Adder Source East, 0,"
+    " MJ_Adder Source West, 0, Flag East, 1, Delay East, 54, Flag West, 0,"
+    " Delay West, 0, Gate ID, 12, Gate Type, 1, Beam seconds, 1656000037,"
+    " Beam nanoseconds, 536000000\r\n"
+  };
+  
+  icarus::details::KeyedCSVparser parser;
+  parser.addPatterns({
+      { "Cryo. (EAST|WEST) Connector . and .", 1U }
+    , { "Trigger Type", 1U }
+    });
+  
+  icarus::details::KeyedCSVparser regexParser;
+  regexParser.addPatterns({
+      { std::regex{ "Cryo. (EAST|WEST) Connector . and ." }, 1U }
+    , { std::regex{ "Trigger Type" }, 1U }
+    });
+  
+  auto const data = parser(triggerString);
+  BOOST_TEST(data.size() == 24U);
+  BOOST_TEST(data.getItem("Cryo. EAST Connector 2 and 3").value() == "00000000 00000100");
+  BOOST_TEST(data.getItem("Gate Type").getNumber<int>(0) == 1);
+  
+  using Clock_t = std::chrono::steady_clock;
+  auto timeParser = [&triggerString](auto const& parser)
+    {
+      constexpr unsigned int NRepetitions = 2000;
+      std::size_t nItems = 0;
+      auto const start = Clock_t::now();
+      for (unsigned int i = 0; i < NRepetitions; ++i)
+        nItems += parser(triggerString).size();
+      std::chrono::duration<double> const elapsed = Clock_t::now() - start;
+      BOOST_TEST(nItems == 24U * NRepetitions);
+      return elapsed.count() / NRepetitions * 1e6; // microseconds
+    };
+  
+  double const regexTime = timeParser(regexParser);
+  double const patternTime = timeParser(parser);
+  std::cout << "Parsing a " << triggerString.size() << "-char trigger string: "
+    << regexTime << " us with std::regex patterns, "
+    << patternTime << " us with simple patterns" << std::endl;
+  
+} // KeyedCSVparser_benchmark()
+
+
+
 // -----------------------------------------------------------------------------
 // BEGIN Test cases  -----------------------------------------------------------
 // -----------------------------------------------------------------------------
@@ -166,6 +322,27 @@ BOOST_AUTO_TEST_CASE(KeyedCSVparser_documentation_testcase) {
 } // BOOST_AUTO_TEST_CASE(KeyedCSVparser_documentation_testcase)
 
 
+BOOST_AUTO_TEST_CASE(KeyedCSVparser_errors_testcase) {
+  
+  KeyedCSVparser_errors_test();
+  
+} // BOOST_AUTO_TEST_CASE(KeyedCSVparser_errors_testcase)
+
+
+BOOST_AUTO_TEST_CASE(KeyPattern_testcase) {
+  
+  KeyPattern_test();
+  
+} // BOOST_AUTO_TEST_CASE(KeyPattern_testcase)
+
+
+BOOST_AUTO_TEST_CASE(KeyedCSVparser_benchmark_testcase) {
+  
+  KeyedCSVparser_benchmark();
+  
+} // BOOST_AUTO_TEST_CASE(KeyedCSVparser_benchmark_testcase)
+
+
 // -----------------------------------------------------------------------------
 // END Test cases  -------------------------------------------------------------
 // -----------------------------------------------------------------------------
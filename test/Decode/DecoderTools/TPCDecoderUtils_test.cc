@@ -0,0 +1,167 @@
+/**
+ * @file   test/Decode/DecoderTools/TPCDecoderUtils_test.cc
+ * @brief  Unit test for `TPCDecoderUtils.h` header.
+ * @date   October 18, 2026
+ * @see    `icaruscode/Decode/DecoderTools/details/TPCDecoderUtils.h`
+ *
+ * The helpers are compared with the code they replace in
+ * `DaqDecoderICARUSTPCwROI`: `std::round()` conversion, ROI extraction by
+ * copy of each run of the mask, and sorting of the output by channel.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Decode/DecoderTools/details/TPCDecoderUtils.h"
+
+// LArSoft libraries
+#include "lardataobj/Utilities/sparse_vector.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( TPCDecoderUtils_test )
+#include <boost/test/unit_test.hpp>
+
+// TBB libraries
+#include "tbb/parallel_for.h"
+
+// C/C++ standard library
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// A minimal data product with a channel.
+  struct ChannelData {
+    std::size_t channel = 0U;
+    std::vector<short> data;
+    std::size_t Channel() const { return channel; }
+  };
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(roundToADC_test) {
+
+  std::vector<float> values {
+    0.0f, -0.0f, 0.5f, -0.5f, 1.5f, -1.5f, 2.5f, -2.5f,
+    0.49999997f, -0.49999997f, 1.4999999f, 2047.5f, -2048.5f, 32767.0f,
+    -32768.0f, 0.25f, -0.75f
+  };
+  std::mt19937 engine { 2468U };
+  std::uniform_real_distribution<float> samples { -4096.f, 4096.f };
+  for (int i = 0; i < 10000; ++i) values.push_back(samples(engine));
+  // all the half-integers in a range
+  for (int i = -300; i <= 300; ++i) values.push_back(i + 0.5f);
+
+  std::vector<short> ADC(values.size(), 99);
+  daq::details::roundToADC(values.data(), values.size(), ADC.data());
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    BOOST_TEST(ADC[i] == short(std::round(values[i])), "value: " << values[i]);
+
+} // BOOST_AUTO_TEST_CASE(roundToADC_test)
+
+
+BOOST_AUTO_TEST_CASE(addMaskedRanges_test) {
+
+  std::mt19937 engine { 1357U };
+  std::bernoulli_distribution inROI { 0.3 };
+  std::uniform_int_distribution<short> samples { -100, 100 };
+
+  for (std::size_t n: { 0U, 1U, 2U, 17U, 4096U }) {
+    std::vector<bool> mask(n);
+    std::vector<short> wvfm(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      mask[i] = inROI(engine);
+      wvfm[i] = samples(engine);
+    }
+    if (n > 2) mask.front() = mask.back() = true; // ROIs at both edges
+
+    // what the decoder used to do
+    lar::sparse_vector<short> expected;
+    std::size_t roiIdx = 0;
+    while (roiIdx < mask.size()) {
+      std::size_t const roiStartIdx = roiIdx;
+      while (roiIdx < mask.size() && mask[roiIdx]) roiIdx++;
+      if (roiIdx > roiStartIdx) {
+        std::vector<short> holder(roiIdx - roiStartIdx);
+        for (std::size_t idx = 0; idx < holder.size(); idx++)
+          holder[idx] = wvfm[roiStartIdx + idx];
+        expected.add_range(roiStartIdx, std::move(holder));
+      }
+      roiIdx++;
+    } // while
+
+    lar::sparse_vector<short> ROIs;
+    daq::details::addMaskedRanges(mask, wvfm, ROIs);
+
+    BOOST_TEST(ROIs.size() == expected.size());
+    BOOST_TEST_REQUIRE(ROIs.n_ranges() == expected.n_ranges());
+    for (std::size_t i = 0; i < ROIs.n_ranges(); ++i) {
+      BOOST_TEST(ROIs.range(i).begin_index() == expected.range(i).begin_index());
+      BOOST_TEST(ROIs.range(i).data() == expected.range(i).data());
+    }
+  } // for sizes
+
+} // BOOST_AUTO_TEST_CASE(addMaskedRanges_test)
+
+
+BOOST_AUTO_TEST_CASE(ChannelSlotCollection_test) {
+
+  constexpr std::size_t NChannels = 1000U;
+
+  // channels in random order, some missing, some repeated, some beyond range
+  std::vector<std::size_t> channels;
+  for (std::size_t channel = 0; channel < NChannels + 20U; ++channel)
+    if (channel % 7 != 3) channels.push_back(channel);
+  for (std::size_t channel: { 5U, 5U, 42U, 999U, 2000U })
+    channels.push_back(channel);
+  std::shuffle(channels.begin(), channels.end(), std::mt19937{ 97531U });
+
+  daq::details::ChannelSlotCollection<ChannelData> slots { NChannels };
+  BOOST_TEST(slots.nSlots() == NChannels);
+
+  for (int event = 0; event < 3; ++event) { // the collection is reused
+
+    tbb::parallel_for(std::size_t(0), channels.size(), [&](std::size_t i){
+      ChannelData& stored
+        = slots.put(channels[i], { channels[i], std::vector<short>(10, short(i)) });
+      stored.data.push_back(-1);
+    });
+
+    std::vector<ChannelData> const objects = slots.extract();
+    BOOST_TEST_REQUIRE(objects.size() == channels.size());
+    BOOST_TEST(std::is_sorted(objects.begin(), objects.end(),
+      [](auto const& a, auto const& b){ return a.channel < b.channel; }));
+
+    std::vector<std::size_t> expected = channels;
+    std::sort(expected.begin(), expected.end());
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+      BOOST_TEST(objects[i].channel == expected[i]);
+      BOOST_TEST(objects[i].data.size() == 11U);
+    }
+
+  } // for events
+
+  BOOST_TEST(slots.extract().empty());
+
+  // an interrupted event: what was stored is dropped by clear()
+  for (std::size_t channel: { 3U, 4U, 4U, 2000U })
+    slots.put(channel, { channel, std::vector<short>(10, 1) });
+  slots.clear();
+  BOOST_TEST(slots.extract().empty());
+
+  slots.put(4U, { 4U, std::vector<short>(10, 2) });
+  std::vector<ChannelData> const objects = slots.extract();
+  BOOST_TEST_REQUIRE(objects.size() == 1U);
+  BOOST_TEST(objects[0].channel == 4U);
+  BOOST_TEST(objects[0].data[0] == 2);
+
+} // BOOST_AUTO_TEST_CASE(ChannelSlotCollection_test)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,303 @@
+/**
+ * @file   test/Decode/DecoderTools/TriggerDataParser_test.cc
+ * @brief  Unit test for `TriggerDataParser.h` header.
+ * @date   October 18, 2026
+ * @see    `icaruscode/Decode/DecoderTools/details/TriggerDataParser.h`
+ *
+ * The trigger strings reproduce the layout of the ones written by the trigger
+ * DAQ in different periods; the parsed content is compared with the one from
+ * the generic `KeyedCSVparser`.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Decode/DecoderTools/details/TriggerDataParser.h"
+#include "icaruscode/Decode/DecoderTools/details/KeyedCSVparser.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( TriggerDataParser_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint> // std::uint64_t
+
+
+// -----------------------------------------------------------------------------
+using namespace std::string_literals;
+
+// Run 1: no enable gate, no gate counts per gate type
+std::string const TriggerStringRun1 {
+  "Local_TS1, 36, 1656000037, 537268000, WR_TS1, 36, 1656000037, 537268790,"
+  " Gate ID, 12, Gate Type, 1, Beam_TS, 12, 1656000037, 536000000,"
+  " Trigger Type, 0, Trigger Source, 1, Cryo1 EAST counts, 3,"
+  " Cryo2 WEST counts, 0,"
+  " Cryo1 EAST Connector 0 and 1, 0000000000000000,"
+  " Cryo1 EAST Connector 2 and 3, 00000100000000ff,"
+  " Cryo2 WEST Connector 0 and 1, 0000000000000000,"
+  " Cryo2 WEST Connector 2 and 3, 0000000000000000,"
+  " MJ_Adder Source East, 0, MJ_Adder Source West, 0, Flag East, 1,"
+  " Delay East, 54, Flag West, 0, Delay West, 0\r\n"s
+};
+
+// Run 2: enable gate and gate counts per gate type; trailing garbage
+std::string const TriggerStringRun2 {
+  "Local_TS1, 1021, 1680000102, 120000000, WR_TS1, 1021, 1680000102, 120000512,"
+  " Enable Type, 2, Enable_TS, 4000, 1680000102, 118300000,"
+  " Gate ID, 4003, Gate Type, 4, Gate ID BNB, 1500, Gate ID NuMI, 1200,"
+  " Gate ID BNBOff, 800, Gate ID NuMIOff, 503,"
+  " Beam_TS, 503, 1680000102, 119900000,"
+  " Trigger Type, 1, Trigger Source, 7,"
+  " Cryo1 EAST counts, 2, Cryo2 WEST counts, 1,"
+  " Cryo1 EAST Connector 0 and 1, 0000000a00000000,"
+  " Cryo1 EAST Connector 2 and 3, 0000000000000010,"
+  " Cryo2 WEST Connector 0 and 1, ff00000000000001,"
+  " Cryo2 WEST Connector 2 and 3, 0000000000000000\n"
+  "Some other line, 1\0garbage"s
+};
+
+// alternative spellings of some keys; first event of the run
+std::string const TriggerStringAlt {
+  "WR_TS1, 1, 1660000000, 5, Gate ID, 1, Gate Type, 2,"
+  " BNB Gate ID, 0, NuMI Gate ID, 1, Offbeam BNB Gate ID, 0,"
+  " Offbeam NuMI Gate ID, 0, Trigger Type, 0, Trigger Source, 2,"
+  " Cryo. EAST Connector 0 and 1, 0000000000000000,"
+  " Cryo. EAST Connector 2 and 3, 0000000000000000,"
+  " Cryo. WEST Connector 0 and 1, 0000000000000000,"
+  " Cryo. WEST Connector 2 and 3, 00003f0000000000"s
+};
+
+
+// -----------------------------------------------------------------------------
+// checks the parsed `data` against the generic parser content
+void checkAgainstCSV
+  (std::string const& s, icarus::details::TriggerData const& data)
+{
+  icarus::details::KeyedCSVparser parser;
+  parser.addPatterns({
+      { "Cryo. (EAST|WEST) Connector . and .", 1U }
+    , { "Trigger Type", 1U }
+    });
+  icarus::KeyValuesData const csv
+    = parser(std::string_view{ s.data(), s.find_first_of("\n\r"s) });
+
+  auto const checkStamp = [&csv](
+    std::string const& key,
+    icarus::details::TriggerData::CountedTimestamp_t const& stamp
+  ) {
+    icarus::KeyValuesData::Item const& item = csv.getItem(key);
+    BOOST_TEST(stamp.count == item.getNumber<unsigned long int>(0));
+    BOOST_TEST(stamp.seconds == item.getNumber<unsigned int>(1));
+    BOOST_TEST(stamp.nanoseconds == item.getNumber<unsigned int>(2));
+  };
+  auto const number = [&csv](std::string const& key, unsigned int base = 10)
+    { return csv.getItem(key).getNumber<std::uint64_t>(0, base); };
+
+  checkStamp("WR_TS1", data.WRtrigger);
+  BOOST_TEST(data.beamGate.has_value() == csv.hasItem("Beam_TS"));
+  if (data.beamGate) checkStamp("Beam_TS", *data.beamGate);
+  BOOST_TEST(data.enableGate.has_value() == csv.hasItem("Enable_TS"));
+  if (data.enableGate) checkStamp("Enable_TS", *data.enableGate);
+
+  BOOST_TEST(data.gateID == number("Gate ID"));
+  BOOST_TEST(data.gateType == number("Gate Type"));
+  BOOST_TEST(data.triggerType == number("Trigger Type"));
+  BOOST_TEST(data.triggerSource == number("Trigger Source"));
+
+  std::string const cryoNames[] = { "Cryo1 EAST", "Cryo2 WEST" };
+  for (std::size_t cryo = 0; cryo < 2U; ++cryo) {
+    BOOST_TEST_CONTEXT("Cryostat " << cryoNames[cryo]) {
+      auto const& cryoData = data.cryostats[cryo];
+      std::string const counts = cryoNames[cryo] + " counts";
+      BOOST_TEST(cryoData.triggerCount.has_value() == csv.hasItem(counts));
+      if (cryoData.triggerCount)
+        BOOST_TEST(*cryoData.triggerCount == number(counts));
+      std::string const connectors = cryoNames[cryo] + " Connector ";
+      if (csv.hasItem(connectors + "0 and 1")) {
+        BOOST_TEST
+          (cryoData.connectors01.value() == number(connectors + "0 and 1", 16));
+        BOOST_TEST
+          (cryoData.connectors23.value() == number(connectors + "2 and 3", 16));
+      }
+    } // context
+  } // for
+
+} // checkAgainstCSV()
+
+
+// -----------------------------------------------------------------------------
+void TriggerDataParser_Run1_test() {
+
+  icarus::details::TriggerDataParser const parser;
+
+  auto const data = parser(TriggerStringRun1);
+  std::cout << "Run 1 format: " << data << std::endl;
+
+  BOOST_TEST(data.WRtrigger.count == 36UL);
+  BOOST_TEST(data.WRtrigger.timestamp() == 1656000037'537268790ULL);
+  BOOST_TEST(data.gateID == 12L);
+  BOOST_TEST(data.gateType == 1);
+  BOOST_TEST_REQUIRE(data.beamGate.has_value());
+  BOOST_TEST(data.beamGate->count == 12UL);
+  BOOST_TEST(data.beamGate->timestamp() == 1656000037'536000000ULL);
+  BOOST_TEST(!data.enableGate.has_value());
+  BOOST_TEST(data.triggerType == 0);
+  BOOST_TEST(data.triggerSource == 1);
+  BOOST_TEST(data.gateIDBNB == 0L);
+  BOOST_TEST(data.gateIDOffbeamNuMI == 0L);
+
+  auto const& east = data.cryostats[icarus::details::TriggerData::EastCryostat];
+  BOOST_TEST(east.triggerCount.value() == 3UL);
+  BOOST_TEST(east.connectors01.value() == 0x0ULL);
+  BOOST_TEST(east.connectors23.value() == 0x00000100000000ffULL);
+  auto const& west = data.cryostats[icarus::details::TriggerData::WestCryostat];
+  BOOST_TEST(west.triggerCount.value() == 0UL);
+
+  checkAgainstCSV(TriggerStringRun1, data);
+
+} // TriggerDataParser_Run1_test()
+
+
+// -----------------------------------------------------------------------------
+void TriggerDataParser_Run2_test() {
+
+  icarus::details::TriggerDataParser const parser;
+
+  auto const data = parser(TriggerStringRun2);
+  std::cout << "Run 2 format: " << data << std::endl;
+
+  BOOST_TEST(data.WRtrigger.count == 1021UL);
+  BOOST_TEST(data.WRtrigger.timestamp() == 1680000102'120000512ULL);
+  BOOST_TEST_REQUIRE(data.enableGate.has_value());
+  BOOST_TEST(data.enableGate->count == 4000UL);
+  BOOST_TEST(data.enableGate->timestamp() == 1680000102'118300000ULL);
+  BOOST_TEST_REQUIRE(data.beamGate.has_value());
+  BOOST_TEST(data.beamGate->timestamp() == 1680000102'119900000ULL);
+  BOOST_TEST(data.gateID == 4003L);
+  BOOST_TEST(data.gateType == 4);
+  BOOST_TEST(data.gateIDBNB == 1500L);
+  BOOST_TEST(data.gateIDNuMI == 1200L);
+  BOOST_TEST(data.gateIDOffbeamBNB == 800L);
+  BOOST_TEST(data.gateIDOffbeamNuMI == 503L);
+  BOOST_TEST(data.triggerType == 1);
+  BOOST_TEST(data.triggerSource == 7);
+
+  auto const& east = data.cryostats[icarus::details::TriggerData::EastCryostat];
+  BOOST_TEST(east.triggerCount.value() == 2UL);
+  BOOST_TEST(east.connectors01.value() == 0x0000000a00000000ULL);
+  BOOST_TEST(east.connectors23.value() == 0x0000000000000010ULL);
+  auto const& west = data.cryostats[icarus::details::TriggerData::WestCryostat];
+  BOOST_TEST(west.triggerCount.value() == 1UL);
+  BOOST_TEST(west.connectors01.value() == 0xff00000000000001ULL);
+  BOOST_TEST(west.connectors23.value() == 0x0ULL);
+
+  checkAgainstCSV(TriggerStringRun2, data);
+
+} // TriggerDataParser_Run2_test()
+
+
+// -----------------------------------------------------------------------------
+void TriggerDataParser_alternativeKeys_test() {
+
+  icarus::details::TriggerDataParser const parser;
+
+  auto const data = parser(TriggerStringAlt);
+  std::cout << "Alternative keys: " << data << std::endl;
+
+  BOOST_TEST(data.WRtrigger.count == 1UL);
+  BOOST_TEST(!data.beamGate.has_value());
+  BOOST_TEST(!data.enableGate.has_value());
+  BOOST_TEST(data.gateType == 2);
+  BOOST_TEST(data.gateIDNuMI == 1L);
+  BOOST_TEST(data.triggerSource == 2);
+
+  auto const& east = data.cryostats[icarus::details::TriggerData::EastCryostat];
+  BOOST_TEST(!east.triggerCount.has_value());
+  BOOST_TEST(east.connectors01.value() == 0x0ULL);
+  auto const& west = data.cryostats[icarus::details::TriggerData::WestCryostat];
+  BOOST_TEST(!west.triggerCount.has_value());
+  BOOST_TEST(west.connectors23.value() == 0x00003f0000000000ULL);
+
+} // TriggerDataParser_alternativeKeys_test()
+
+
+// -----------------------------------------------------------------------------
+void TriggerDataParser_errors_test() {
+
+  using Parser = icarus::details::TriggerDataParser;
+  Parser const parser;
+
+  std::string const required
+    = "WR_TS1, 1, 2, 3, Gate ID, 1, Gate Type, 1, Trigger Type, 0";
+
+  // missing required key
+  BOOST_CHECK_THROW(parser(required), Parser::ItemNotFound);
+  BOOST_CHECK_NO_THROW(parser(required + ", Trigger Source, 1"));
+
+  // values without key
+  BOOST_CHECK_THROW
+    (parser("12, " + required + ", Trigger Source, 1"), Parser::InvalidFormat);
+
+  // same item twice, also with different spellings
+  BOOST_CHECK_THROW
+    (parser(required + ", Trigger Source, 1, Trigger Source, 2"), Parser::DuplicateKey);
+  BOOST_CHECK_THROW(
+    parser(required + ", Trigger Source, 1, Gate ID BNB, 2, BNB Gate ID, 2"),
+    Parser::DuplicateKey
+    );
+
+  // truncated gate information
+  BOOST_CHECK_THROW
+    (parser(required + ", Trigger Source, 1, Beam_TS, 5, 10"), Parser::MissingValues);
+  BOOST_CHECK_THROW(
+    parser(required + ", Beam_TS, 5, 10, Trigger Source, 1"),
+    Parser::ConversionFailed
+    );
+
+  // not a hexadecimal number
+  BOOST_CHECK_THROW(
+    parser(required + ", Trigger Source, 1, Cryo1 EAST Connector 0 and 1, 00xx"),
+    Parser::ConversionFailed
+    );
+
+  // all derive from the common error
+  BOOST_CHECK_THROW(parser(required), Parser::Error);
+
+} // TriggerDataParser_errors_test()
+
+
+// -----------------------------------------------------------------------------
+// BEGIN Test cases  -----------------------------------------------------------
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(TriggerDataParser_Run1_testcase) {
+
+  TriggerDataParser_Run1_test();
+
+} // BOOST_AUTO_TEST_CASE(TriggerDataParser_Run1_testcase)
+
+
+BOOST_AUTO_TEST_CASE(TriggerDataParser_Run2_testcase) {
+
+  TriggerDataParser_Run2_test();
+
+} // BOOST_AUTO_TEST_CASE(TriggerDataParser_Run2_testcase)
+
+
+BOOST_AUTO_TEST_CASE(TriggerDataParser_alternativeKeys_testcase) {
+
+  TriggerDataParser_alternativeKeys_test();
+
+} // BOOST_AUTO_TEST_CASE(TriggerDataParser_alternativeKeys_testcase)
+
+
+BOOST_AUTO_TEST_CASE(TriggerDataParser_errors_testcase) {
+
+  TriggerDataParser_errors_test();
+
+} // BOOST_AUTO_TEST_CASE(TriggerDataParser_errors_testcase)
+
+
+// -----------------------------------------------------------------------------
+// END Test cases  -------------------------------------------------------------
+// -----------------------------------------------------------------------------
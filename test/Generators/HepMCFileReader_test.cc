@@ -0,0 +1,205 @@
+/**
+ * @file HepMCFileReader_test.cc
+ * @brief Unit test for `evgen::HepMCFileReader`
+ * @date October 18, 2026
+ * @see icaruscode/Generators/HepMCFileReader.h
+ *
+ * The test reads the reference file `HepMCFileReader_test.hepmc`, which must
+ * be in the current directory.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Generators/HepMCFileReader.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( HepMCFileReader_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+std::string const ReferenceFile { "HepMCFileReader_test.hepmc" };
+
+
+// writes a file with the specified content
+void writeFile(std::string const& path, std::string const& content) {
+  std::ofstream out { path };
+  out << content;
+  BOOST_TEST_REQUIRE(out.good());
+} // writeFile()
+
+
+// -----------------------------------------------------------------------------
+void index_test() {
+
+  evgen::HepMCFileReader const reader { ReferenceFile };
+
+  BOOST_TEST(reader.path() == ReferenceFile);
+  BOOST_TEST_REQUIRE(reader.nEvents() == 3U);
+
+  BOOST_TEST(reader.eventNumber(0) == 0);
+  BOOST_TEST(reader.eventNumber(1) == 7);
+  BOOST_TEST(reader.eventNumber(2) == 12);
+
+  BOOST_TEST(reader.nParticles(0) == 1U);
+  BOOST_TEST(reader.nParticles(1) == 3U);
+  BOOST_TEST(reader.nParticles(2) == 2U);
+
+} // index_test()
+
+
+void readEvent_test() {
+
+  evgen::HepMCFileReader const reader { ReferenceFile };
+
+  std::vector<evgen::HepMCFileReader::Particle> particles;
+
+  // random access: last event first, then the others
+  BOOST_TEST(reader.readEvent(2, particles) == 12);
+  BOOST_TEST_REQUIRE(particles.size() == 2U);
+  {
+    auto const& p = particles[0];
+    BOOST_TEST(p.status == 0);
+    BOOST_TEST(p.pdg == 52);
+    BOOST_TEST(p.firstMother == 0);
+    BOOST_TEST(p.secondMother == 0);
+    BOOST_TEST(p.firstDaughter == 1);
+    BOOST_TEST(p.secondDaughter == 2);
+    BOOST_TEST(p.xMomentum == 1.5e-2);
+    BOOST_TEST(p.yMomentum == -2e-3);
+    BOOST_TEST(p.zMomentum == 0.75);
+    BOOST_TEST(p.energy == 0.7502);
+    BOOST_TEST(p.mass == 0.01);
+    BOOST_TEST(p.xPosition == -150.5);
+    BOOST_TEST(p.yPosition == -40.0);
+    BOOST_TEST(p.zPosition == 900.0);
+    BOOST_TEST(p.time == 1500.0);
+  }
+  BOOST_TEST(particles[1].pdg == 11);
+  BOOST_TEST(particles[1].firstMother == 1);
+  BOOST_TEST(particles[1].mass == 0.000511);
+  BOOST_TEST(particles[1].time == 1500.25);
+
+  BOOST_TEST(reader.readEvent(0, particles) == 0);
+  BOOST_TEST_REQUIRE(particles.size() == 1U);
+  {
+    auto const& p = particles[0];
+    BOOST_TEST(p.status == 1);
+    BOOST_TEST(p.pdg == 13);
+    BOOST_TEST(p.xMomentum == 0.0);
+    BOOST_TEST(p.yMomentum == 0.0);
+    BOOST_TEST(p.zMomentum == 1.0);
+    BOOST_TEST(p.energy == 5.0011);
+    BOOST_TEST(p.mass == 0.105);
+    BOOST_TEST(p.xPosition == 1.0);
+    BOOST_TEST(p.yPosition == 1.0);
+    BOOST_TEST(p.zPosition == 1.0);
+    BOOST_TEST(p.time == 0.0);
+  }
+
+  BOOST_TEST(reader.readEvent(1, particles) == 7);
+  BOOST_TEST_REQUIRE(particles.size() == 3U);
+  BOOST_TEST(particles[0].pdg == 14);
+  BOOST_TEST(particles[0].mass == 0.0);
+  BOOST_TEST(particles[1].pdg == 13);
+  BOOST_TEST(particles[1].firstMother == 1);
+  BOOST_TEST(particles[1].xMomentum == -0.168856);
+  BOOST_TEST(particles[1].yMomentum == -0.0498011);
+  BOOST_TEST(particles[2].pdg == 2212);
+  BOOST_TEST(particles[2].mass == 938.272);
+  BOOST_TEST(particles[2].time == 4026.32);
+
+  BOOST_CHECK_THROW(reader.readEvent(3, particles), cet::exception);
+
+} // readEvent_test()
+
+
+void moveReader_test() {
+
+  evgen::HepMCFileReader reader { ReferenceFile };
+  evgen::HepMCFileReader moved { std::move(reader) };
+
+  BOOST_TEST(moved.nEvents() == 3U);
+
+  std::vector<evgen::HepMCFileReader::Particle> particles;
+  BOOST_TEST(moved.readEvent(1, particles) == 7);
+  BOOST_TEST(particles.size() == 3U);
+
+} // moveReader_test()
+
+
+void formatErrors_test() {
+
+  // missing file
+  BOOST_CHECK_THROW
+    (evgen::HepMCFileReader{ "HepMCFileReader_test_missing.hepmc" }, cet::exception);
+
+  // truncated event: detected when indexing
+  writeFile("HepMCFileReader_test_truncated.hepmc",
+    "0 2\n1 13 0 0 0 0 0. 0. 1.0 5.0011 0.105 1.0 1.0 1.0 0.0\n");
+  BOOST_CHECK_THROW
+    (evgen::HepMCFileReader{ "HepMCFileReader_test_truncated.hepmc" }, cet::exception);
+
+  // bad header: detected when indexing
+  writeFile("HepMCFileReader_test_header.hepmc", "zero 1\n1 13 0 0 0 0 0 0 1 5 0.1 1 1 1 0\n");
+  BOOST_CHECK_THROW
+    (evgen::HepMCFileReader{ "HepMCFileReader_test_header.hepmc" }, cet::exception);
+
+  // bad particle line (missing time): detected when reading
+  writeFile("HepMCFileReader_test_particle.hepmc",
+    "0 1\n1 13 0 0 0 0 0. 0. 1.0 5.0011 0.105 1.0 1.0 1.0\n"
+    "1 1\n1 13 0 0 0 0 0. 0. 1.0 5.0011 0.1O5 1.0 1.0 1.0 0.0\n");
+  evgen::HepMCFileReader const reader { "HepMCFileReader_test_particle.hepmc" };
+  BOOST_TEST(reader.nEvents() == 2U);
+  std::vector<evgen::HepMCFileReader::Particle> particles;
+  BOOST_CHECK_THROW(reader.readEvent(0, particles), cet::exception);
+  BOOST_CHECK_THROW(reader.readEvent(1, particles), cet::exception);
+
+  // empty file: no events
+  writeFile("HepMCFileReader_test_empty.hepmc", "");
+  BOOST_TEST(evgen::HepMCFileReader{ "HepMCFileReader_test_empty.hepmc" }.nEvents() == 0U);
+
+} // formatErrors_test()
+
+
+// -----------------------------------------------------------------------------
+// BEGIN Test cases  -----------------------------------------------------------
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(index_testcase) {
+
+  index_test();
+
+} // BOOST_AUTO_TEST_CASE(index_testcase)
+
+
+BOOST_AUTO_TEST_CASE(readEvent_testcase) {
+
+  readEvent_test();
+
+} // BOOST_AUTO_TEST_CASE(readEvent_testcase)
+
+
+BOOST_AUTO_TEST_CASE(moveReader_testcase) {
+
+  moveReader_test();
+
+} // BOOST_AUTO_TEST_CASE(moveReader_testcase)
+
+
+BOOST_AUTO_TEST_CASE(formatErrors_testcase) {
+
+  formatErrors_test();
+
+} // BOOST_AUTO_TEST_CASE(formatErrors_testcase)
+
+
+// -----------------------------------------------------------------------------
+// END Test cases  -------------------------------------------------------------
+// -----------------------------------------------------------------------------
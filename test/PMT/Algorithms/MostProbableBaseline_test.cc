@@ -0,0 +1,152 @@
+/**
+ * @file   MostProbableBaseline_test.cc
+ * @brief  Unit test for `opdet::MostProbableBaseline`.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/Algorithms/MostProbableBaseline.h
+ *
+ * The baselines are compared with the ones of the `std::map` histogram
+ * previously used by the `OpHitFinder` tool (copied here as it was).
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Algorithms/MostProbableBaseline.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( MostProbableBaseline_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <map>
+#include <random>
+#include <vector>
+#include <cmath> // std::isnan()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// The original `OpHitFinder::getBaseline()`.
+  float referenceBaseline(const raw::OpDetWaveform& locWaveform)
+  {
+      // Fill a map to determine the most probable value
+      std::map<raw::ADC_Count_t,int> adcFrequencyMap;
+
+      raw::ADC_Count_t maxBin(0);
+      int              maxCount(0);
+
+      for(const auto& adc : locWaveform)
+      {
+          int& adcFrequency = adcFrequencyMap[adc];
+
+          if (++adcFrequency > maxCount)
+          {
+              maxBin   = adc;
+              maxCount = adcFrequency;
+          }
+      }
+
+      float mostProbableBaseline(0.);
+      int   mostProbableCount(0);
+
+      for(raw::ADC_Count_t adcBin = maxBin - 3; adcBin <= maxBin + 3; adcBin++)
+      {
+          try{
+              mostProbableBaseline += adcFrequencyMap.at(adcBin) * float(adcBin);
+              mostProbableCount    += adcFrequencyMap.at(adcBin);
+          }
+          catch(...) {}
+      }
+
+      mostProbableBaseline /= mostProbableCount;
+
+      return mostProbableBaseline;
+  } // referenceBaseline()
+
+
+  raw::OpDetWaveform makeWaveform(std::vector<raw::ADC_Count_t> const& samples)
+  {
+    raw::OpDetWaveform waveform { 0.0, 0U, samples.size() };
+    waveform.insert(waveform.end(), samples.begin(), samples.end());
+    return waveform;
+  }
+
+
+  void checkBaseline
+    (opdet::MostProbableBaseline& alg, raw::OpDetWaveform const& waveform)
+  {
+    float const expected = referenceBaseline(waveform);
+    BOOST_TEST(alg(waveform) == expected);
+    BOOST_TEST(opdet::MostProbableBaseline::fromMap(waveform) == expected);
+  }
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(RandomWaveformTest) {
+
+  std::mt19937 engine { 30U };
+  std::uniform_int_distribution<std::size_t> nSamples { 1U, 3000U };
+  std::uniform_int_distribution<int> baseline { 14000, 16000 };
+  std::uniform_int_distribution<int> noise { -4, 4 };
+  std::uniform_int_distribution<int> pulse { 0, 3000 };
+  std::uniform_int_distribution<int> pulseAmplitude { 10, 12000 };
+
+  opdet::MostProbableBaseline alg; // reused for all waveforms
+
+  for (int iWaveform = 0; iWaveform < 3000; ++iWaveform) {
+    BOOST_TEST_CONTEXT("waveform #" << iWaveform) {
+      int const base = baseline(engine);
+      std::vector<raw::ADC_Count_t> samples(nSamples(engine));
+      for (raw::ADC_Count_t& sample: samples) sample = base + noise(engine);
+
+      // a few negative pulses, some beyond the range of the dense histogram
+      for (int iPulse = 0; iPulse < 3; ++iPulse) {
+        std::size_t const start = pulse(engine);
+        int const amplitude = pulseAmplitude(engine);
+        for (std::size_t i = start; i < std::min(samples.size(), start + 30); ++i)
+          samples[i] -= amplitude / int(i - start + 1);
+      }
+
+      checkBaseline(alg, makeWaveform(samples));
+    }
+  } // for waveforms
+
+} // BOOST_AUTO_TEST_CASE(RandomWaveformTest)
+
+
+BOOST_AUTO_TEST_CASE(SpecialWaveformTest) {
+
+  opdet::MostProbableBaseline alg;
+
+  // ties: the first value to reach the highest count wins
+  checkBaseline(alg, makeWaveform({ 100, 200, 200, 100, 300, 300 }));
+  checkBaseline(alg, makeWaveform({ 200, 100, 100, 200, 300, 300, 100, 200 }));
+  checkBaseline(alg, makeWaveform({ 100, 101, 102, 103, 104, 105, 106, 107 }));
+  checkBaseline(alg, makeWaveform({ 7 }));
+
+  // span at the limit of the dense histogram, and just beyond it
+  int const maxSpan = opdet::MostProbableBaseline::MaxADCSpan;
+  checkBaseline
+    (alg, makeWaveform({ 15000, 15001, 15000, 15000 - (maxSpan - 1), 15002 }));
+  checkBaseline
+    (alg, makeWaveform({ 15000, 15001, 15000, 15000 - maxSpan, 15002 }));
+  checkBaseline(alg, makeWaveform({ -20000, 20000, 20000, 0, 20001 }));
+
+  // the histogram is left clean after each waveform
+  raw::OpDetWaveform const waveform
+    = makeWaveform({ 500, 501, 502, 501, 500, 501, 499, 480 });
+  float const expected = referenceBaseline(waveform);
+  for (int i = 0; i < 5; ++i) BOOST_TEST(alg(waveform) == expected);
+
+  // no samples, no baseline
+  BOOST_TEST(std::isnan(alg(makeWaveform({}))));
+
+} // BOOST_AUTO_TEST_CASE(SpecialWaveformTest)
+
+
+// -----------------------------------------------------------------------------
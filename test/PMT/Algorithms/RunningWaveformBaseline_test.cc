@@ -0,0 +1,105 @@
+/**
+ * @file   RunningWaveformBaseline_test.cc
+ * @brief  Unit test for `opdet::RunningWaveformBaseline`.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/Algorithms/RunningWaveformBaseline.h
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Algorithms/RunningWaveformBaseline.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( RunningWaveformBaseline_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+  
+  using BaselineInfo_t = opdet::RunningWaveformBaseline::BaselineInfo_t;
+  constexpr double NoInfo = BaselineInfo_t::NoInfo;
+  
+  /// Baselines of a channel in a sequence of events, some not available.
+  std::vector<BaselineInfo_t> const Events {
+    { 14990.0, 2.0, 3U, 300U },
+    { 14994.0, 3.0, 3U, 300U },
+    {},                          // no waveform left in the channel
+    { 14998.0, NoInfo, 1U, 0U }, // no RMS
+    { 14992.0, 2.0, 2U, 200U },
+  };
+  
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Disabled_test) {
+  
+  // with no running baseline, each event has its own baseline (as the module
+  // had before the running baseline was introduced)
+  opdet::RunningWaveformBaseline running; // weight 0
+  BOOST_TEST(!running.enabled());
+  
+  for (std::size_t const channel: { 0U, 5U }) {
+    for (BaselineInfo_t const& extracted: Events) {
+      BaselineInfo_t const baseline = running.update(channel, extracted);
+      BOOST_TEST(baseline.baseline == extracted.baseline);
+      BOOST_TEST(baseline.RMS == extracted.RMS);
+      BOOST_TEST(baseline.nWaveforms == extracted.nWaveforms);
+      BOOST_TEST(baseline.nSamples == extracted.nSamples);
+    }
+  }
+  
+} // BOOST_AUTO_TEST_CASE(Disabled_test)
+
+
+BOOST_AUTO_TEST_CASE(Running_test) {
+  
+  double const w = 0.75;
+  opdet::RunningWaveformBaseline running { w };
+  BOOST_TEST(running.enabled());
+  
+  // first event: nothing to blend with
+  BaselineInfo_t baseline = running.update(3U, Events[0]);
+  BOOST_TEST(baseline.baseline == Events[0].baseline);
+  BOOST_TEST(baseline.RMS == Events[0].RMS);
+  double runningBaseline = baseline.baseline;
+  double runningRMS = baseline.RMS;
+  
+  baseline = running.update(3U, Events[1]);
+  BOOST_TEST(baseline.baseline == w * runningBaseline + (1.0 - w) * Events[1].baseline);
+  BOOST_TEST(baseline.RMS == w * runningRMS + (1.0 - w) * Events[1].RMS);
+  runningBaseline = baseline.baseline;
+  runningRMS = baseline.RMS;
+  
+  // no information: returned as is, the running state is untouched
+  baseline = running.update(3U, Events[2]);
+  BOOST_TEST(baseline.baseline == NoInfo);
+  BOOST_TEST(baseline.RMS == NoInfo);
+  
+  // no RMS: the baseline is blended, the running RMS is kept
+  baseline = running.update(3U, Events[3]);
+  BOOST_TEST(baseline.baseline == w * runningBaseline + (1.0 - w) * Events[3].baseline);
+  BOOST_TEST(baseline.RMS == NoInfo);
+  runningBaseline = baseline.baseline;
+  
+  baseline = running.update(3U, Events[4]);
+  BOOST_TEST(baseline.baseline == w * runningBaseline + (1.0 - w) * Events[4].baseline);
+  BOOST_TEST(baseline.RMS == w * runningRMS + (1.0 - w) * Events[4].RMS);
+  BOOST_TEST(baseline.baseline < 15000.0);
+  
+  // other channels are independent, and a missing first event starts nothing
+  BOOST_TEST(running.update(0U, Events[2]).baseline == NoInfo);
+  BOOST_TEST(running.update(0U, Events[1]).baseline == Events[1].baseline);
+  
+  // after a reset, no memory
+  running.reset();
+  BOOST_TEST(running.update(3U, Events[0]).baseline == Events[0].baseline);
+  
+} // BOOST_AUTO_TEST_CASE(Running_test)
+
+
+// -----------------------------------------------------------------------------
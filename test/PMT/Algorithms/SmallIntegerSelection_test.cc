@@ -0,0 +1,153 @@
+/**
+ * @file SmallIntegerSelection_test.cc
+ * @brief Unit test for utilities in `SmallIntegerSelection.h`
+ * @date October 18, 2026
+ * @see icaruscode/PMT/Algorithms/SmallIntegerSelection.h
+ *
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Algorithms/SmallIntegerSelection.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( SmallIntegerSelection_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <algorithm> // std::nth_element(), std::copy()
+#include <iterator> // std::back_inserter()
+#include <random>
+#include <vector>
+#include <cstdint> // std::int8_t, std::uint16_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Returns the `n`-th element of all the samples, via `std::nth_element()`.
+  template <typename T>
+  T referenceNth(std::vector<std::vector<T>> const& waveforms, std::size_t n) {
+    std::vector<T> samples;
+    for (auto const& waveform: waveforms)
+      std::copy(waveform.begin(), waveform.end(), std::back_inserter(samples));
+    std::nth_element(samples.begin(), samples.begin() + n, samples.end());
+    return samples[n];
+  } // referenceNth()
+
+
+  /// Returns a callable feeding `waveforms` to the selection algorithms.
+  template <typename T>
+  auto feeder(std::vector<std::vector<T>> const& waveforms) {
+    return [&waveforms](auto&& f)
+      { for (auto const& wf: waveforms) f(wf.cbegin(), wf.cend()); };
+  }
+
+
+  /// Checks all ranks and the median of `waveforms` against the reference.
+  template <typename T>
+  void checkAllRanks(std::vector<std::vector<T>> const& waveforms) {
+
+    std::size_t N = 0U;
+    for (auto const& waveform: waveforms) N += waveform.size();
+
+    for (std::size_t n = 0; n < N; ++n) {
+      BOOST_TEST_CONTEXT("rank " << n << " of " << N) {
+        BOOST_TEST(opdet::selectNthSmallInteger<T>(feeder(waveforms), n)
+          == referenceNth(waveforms, n));
+      }
+    } // for
+
+    BOOST_TEST(opdet::medianOfSmallIntegers<T>(feeder(waveforms))
+      == referenceNth(waveforms, N / 2));
+
+  } // checkAllRanks()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+void simpleSelection_test() {
+
+  std::vector<std::vector<short int>> const waveforms {
+      { 5, 3, 9 }
+    , {}
+    , { -2, 3, 3 }
+    , { 32767, -32768 }
+    };
+
+  checkAllRanks(waveforms);
+
+  BOOST_TEST(opdet::selectNthSmallInteger<short int>(feeder(waveforms), 0)
+    == -32768);
+  BOOST_TEST(opdet::selectNthSmallInteger<short int>(feeder(waveforms), 1)
+    == -2);
+  BOOST_TEST(opdet::selectNthSmallInteger<short int>(feeder(waveforms), 7)
+    == 32767);
+  BOOST_TEST(opdet::medianOfSmallIntegers<short int>(feeder(waveforms)) == 3);
+
+} // simpleSelection_test()
+
+
+// -----------------------------------------------------------------------------
+void typesSelection_test() {
+
+  checkAllRanks(std::vector<std::vector<std::int8_t>>
+    {{ -128, 127, 0, -1, 1, -1 }});
+  checkAllRanks(std::vector<std::vector<unsigned char>>
+    {{ 255, 0, 128, 127, 128 }});
+  checkAllRanks(std::vector<std::vector<std::uint16_t>>
+    {{ 65535, 0, 256, 255, 257, 256 }, { 1 }});
+
+} // typesSelection_test()
+
+
+// -----------------------------------------------------------------------------
+void waveformLikeSelection_test() {
+
+  // PMT-like waveforms: a 14-bit baseline with noise and some pulses
+  std::mt19937 rng { 12345 };
+  std::normal_distribution<double> noise { 14900.0, 3.5 };
+  std::uniform_int_distribution<int> pulse { 0, 9 };
+
+  std::vector<std::vector<short int>> waveforms(12);
+  for (auto& waveform: waveforms) {
+    waveform.resize(500);
+    for (short int& sample: waveform) {
+      sample = static_cast<short int>(noise(rng));
+      if (pulse(rng) == 0) sample -= 300; // negative polarity pulses
+    }
+  } // for
+
+  checkAllRanks(waveforms);
+
+} // waveformLikeSelection_test()
+
+
+// -----------------------------------------------------------------------------
+// BEGIN Test cases  -----------------------------------------------------------
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(simpleSelection_testcase) {
+
+  simpleSelection_test();
+
+} // BOOST_AUTO_TEST_CASE(simpleSelection_testcase)
+
+
+BOOST_AUTO_TEST_CASE(typesSelection_testcase) {
+
+  typesSelection_test();
+
+} // BOOST_AUTO_TEST_CASE(typesSelection_testcase)
+
+
+BOOST_AUTO_TEST_CASE(waveformLikeSelection_testcase) {
+
+  waveformLikeSelection_test();
+
+} // BOOST_AUTO_TEST_CASE(waveformLikeSelection_testcase)
+
+
+// -----------------------------------------------------------------------------
+// END Test cases  -------------------------------------------------------------
+// -----------------------------------------------------------------------------
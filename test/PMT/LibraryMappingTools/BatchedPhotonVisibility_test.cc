@@ -0,0 +1,268 @@
+/**
+ * @file BatchedPhotonVisibility_test.cc
+ * @brief Unit test for `phot::BatchedPhotonVisibility`
+ * @date October 18, 2026
+ * @see icaruscode/PMT/LibraryMappingTools/BatchedPhotonVisibility.h
+ *
+ * The test uses a small synthetic library and a two-cryostat mapping like the
+ * one of `ICARUSPhotonMappingTransformations`, and checks the batched lookup
+ * against the per-point lookup of `phot::PhotonVisibilityService` without
+ * interpolation: a LArSoft `phot::PhotonLibrary` with the same content,
+ * queried on the voxel that `sim::PhotonVoxelDef` assigns to each point,
+ * mapped to detector channels point by point.
+ * The table is both created in memory and read back from a file.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/LibraryMappingTools/BatchedPhotonVisibility.h"
+#include "icaruscode/PMT/LibraryMappingTools/PhotonVisibilityTable.h"
+
+// LArSoft libraries
+#include "larsim/PhotonPropagation/PhotonLibrary.h"
+#include "larsim/Simulation/PhotonVoxels.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( BatchedPhotonVisibility_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using Table = phot::PhotonVisibilityTable;
+using Mapping = phot::ICARUSPhotonMappingTransformations;
+
+// library: 10 x 6 x 4 cm, voxels of 2 cm, 4 channels
+Table::VoxelGrid_t const Grid {
+  { 0.0, 0.0, 0.0 }, { 10.0, 6.0, 4.0 }, { 5U, 3U, 2U }
+  };
+unsigned int const NLibraryChannels = 4U;
+
+// detector: C:0 covers x in [ 0, 10 ], C:1 in [ 30, 40 ]; 8 channels
+double const SwitchPoint = 20.0;
+geo::Vector_t const C1translation { -30.0, 0.0, 0.0 };
+auto const NoLib = Mapping::InvalidLibraryIndex;
+
+
+// creates a library with a different visibility for each voxel and channel
+std::vector<float> makeVisibilities() {
+  std::vector<float> visibilities(Grid.nVoxels() * NLibraryChannels);
+  for (std::size_t i = 0; i < visibilities.size(); ++i)
+    visibilities[i] = 1.0e-4f * (i + 1);
+  return visibilities;
+} // makeVisibilities()
+
+
+// creates the mapping tables: C:1 channels are shuffled in the library
+Mapping::MappingTables_t makeMapping() {
+  return {
+      SwitchPoint
+    , { geo::Vector_t{ 0.0, 0.0, 0.0 }, C1translation }
+    , {
+        { 0, 1, 2, 3, NoLib, NoLib, NoLib, NoLib }
+      , { NoLib, NoLib, NoLib, NoLib, 2, 3, 0, 1 }
+      }
+    };
+} // makeMapping()
+
+
+// fills a LArSoft photon library with the same content as the table
+void fillReferenceLibrary(phot::PhotonLibrary& library) {
+  std::vector<float> const visibilities = makeVisibilities();
+  library.CreateEmptyLibrary(Grid.nVoxels(), NLibraryChannels, false, false, 0);
+  for (std::size_t voxel = 0; voxel < Grid.nVoxels(); ++voxel) {
+    for (unsigned int channel = 0; channel < NLibraryChannels; ++channel) {
+      library.SetCount
+        (voxel, channel, visibilities[voxel * NLibraryChannels + channel]);
+    }
+  }
+} // fillReferenceLibrary()
+
+
+// the voxels of `Grid`, as configured in the visibility service
+sim::PhotonVoxelDef const ReferenceVoxelDef
+  { 0.0, 10.0, 5, 0.0, 6.0, 3, 0.0, 4.0, 2 };
+
+
+// returns the visibility of all channels from `point`, one point at a time,
+// like `phot::PhotonVisibilityService` does without interpolation
+std::vector<float> referenceVisibilities(
+  phot::PhotonLibrary const& library, Mapping::MappingTables_t const& mapping,
+  geo::Point_t const& point
+) {
+  // detector to library frame (`ICARUSPhotonMappingTransformations`)
+  std::size_t const cryo = (point.X() > mapping.switchPoint)? 1U: 0U;
+  geo::Point_t const libraryPoint = point + mapping.translations[cryo];
+
+  // library lookup
+  int const voxel = ReferenceVoxelDef.GetVoxelID(libraryPoint);
+
+  // library to detector channels (`applyOpDetMapping()`)
+  auto const& libraryIndices = mapping.opDetToLibraryIndices[cryo];
+  std::vector<float> vis(libraryIndices.size(), 0.0f);
+  if ((voxel < 0) || (static_cast<std::size_t>(voxel) >= Grid.nVoxels()))
+    return vis;
+  for (std::size_t channel = 0; channel < libraryIndices.size(); ++channel) {
+    if (libraryIndices[channel] == NoLib) continue;
+    vis[channel] = library.GetCount(voxel, libraryIndices[channel]);
+  }
+  return vis;
+} // referenceVisibilities()
+
+
+// creates points in both cryostats, mostly at the center of voxels
+std::vector<geo::Point_t> makePoints() {
+  std::mt19937 rng { 2026 };
+  std::uniform_int_distribution<int> voxelX { -1, 5 }, voxelY { 0, 2 };
+  std::uniform_int_distribution<int> voxelZ { 0, 1 }, cryo { 0, 1 };
+
+  std::vector<geo::Point_t> points;
+  for (int i = 0; i < 500; ++i) {
+    // voxel -1 on x is outside the library
+    points.emplace_back(
+      2.0 * voxelX(rng) + 1.0 + 30.0 * cryo(rng),
+      2.0 * voxelY(rng) + 1.0,
+      2.0 * voxelZ(rng) + 1.0
+      );
+  } // for
+  points.emplace_back(50.0, 1.0, 1.0); // beyond C:1
+  points.emplace_back(1.0, 1.0, -1.0); // below the library on z
+  return points;
+} // makePoints()
+
+
+// -----------------------------------------------------------------------------
+void checkVisibilities(Table const& table) {
+
+  phot::PhotonLibrary library;
+  fillReferenceLibrary(library);
+  Mapping::MappingTables_t const mapping = makeMapping();
+  std::vector<geo::Point_t> const points = makePoints();
+
+  phot::BatchedPhotonVisibility const batch { table, mapping };
+  BOOST_TEST(batch.nChannels() == 8U);
+
+  phot::BatchedPhotonVisibility::Visibilities_t const vis = batch(points);
+  BOOST_TEST(vis.nPoints() == points.size());
+  BOOST_TEST(vis.nChannels() == 8U);
+
+  unsigned int nNonZero = 0U;
+  for (std::size_t iPoint = 0; iPoint < points.size(); ++iPoint) {
+    std::vector<float> const single = batch.visibilities(points[iPoint]);
+    BOOST_TEST_REQUIRE(single.size() == 8U);
+    std::vector<float> const reference
+      = referenceVisibilities(library, mapping, points[iPoint]);
+    BOOST_TEST_REQUIRE(reference.size() == 8U);
+    for (unsigned int channel = 0; channel < 8U; ++channel) {
+      BOOST_TEST_CONTEXT("point #" << iPoint << " " << points[iPoint]
+        << ", channel " << channel
+      ) {
+        float const expected = reference[channel];
+        BOOST_TEST(vis(channel, iPoint) == expected);
+        BOOST_TEST(vis.channel(channel)[iPoint] == expected);
+        BOOST_TEST(single[channel] == expected);
+        if (expected != 0.0f) ++nNonZero;
+      }
+    } // for channels
+  } // for points
+  BOOST_TEST(nNonZero > 0U);
+
+  // reuse of the result memory
+  phot::BatchedPhotonVisibility::Visibilities_t reused = vis;
+  batch.fill({ points.front() }, reused);
+  BOOST_TEST(reused.nPoints() == 1U);
+  BOOST_TEST(reused.data().size() == 8U);
+  for (unsigned int channel = 0; channel < 8U; ++channel)
+    BOOST_TEST(reused(channel, 0) == vis(channel, 0));
+
+} // checkVisibilities()
+
+
+// -----------------------------------------------------------------------------
+void memoryTable_test() {
+
+  Table const table
+    = Table::fromVisibilities(Grid, NLibraryChannels, makeVisibilities());
+  BOOST_TEST(table.nVoxels() == 30U);
+  BOOST_TEST(table.nChannels() == NLibraryChannels);
+  BOOST_TEST(table.visibilities(-1) == nullptr);
+  BOOST_TEST(table.visibilities(30) == nullptr);
+
+  checkVisibilities(table);
+
+} // memoryTable_test()
+
+
+// -----------------------------------------------------------------------------
+void fileTable_test() {
+
+  Table::fromVisibilities(Grid, NLibraryChannels, makeVisibilities())
+    .write("BatchedPhotonVisibility_test.vistable");
+  Table const table = Table::fromFile("BatchedPhotonVisibility_test.vistable");
+  BOOST_TEST(table.nVoxels() == 30U);
+  BOOST_TEST(table.grid().steps[1] == 3U);
+
+  checkVisibilities(table);
+
+} // fileTable_test()
+
+
+// -----------------------------------------------------------------------------
+void tableErrors_test() {
+
+  BOOST_CHECK_THROW(
+    Table::fromVisibilities(Grid, NLibraryChannels, std::vector<float>(10)),
+    cet::exception
+    );
+
+  BOOST_CHECK_THROW(
+    Table::fromFile("BatchedPhotonVisibility_test_missing.vistable"),
+    cet::exception
+    );
+
+  {
+    std::ofstream out
+      { "BatchedPhotonVisibility_test_bad.vistable", std::ios::binary };
+    out << std::string(256, 'x');
+  }
+  BOOST_CHECK_THROW(
+    Table::fromFile("BatchedPhotonVisibility_test_bad.vistable"),
+    cet::exception
+    );
+
+  Table const table
+    = Table::fromVisibilities(Grid, NLibraryChannels, makeVisibilities());
+  Mapping::MappingTables_t badMapping = makeMapping();
+  badMapping.translations.pop_back();
+  BOOST_CHECK_THROW(
+    (phot::BatchedPhotonVisibility{ table, badMapping }),
+    cet::exception
+    );
+
+} // tableErrors_test()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(memoryTable_testcase) {
+  memoryTable_test();
+} // BOOST_AUTO_TEST_CASE(memoryTable_testcase)
+
+
+BOOST_AUTO_TEST_CASE(fileTable_testcase) {
+  fileTable_test();
+} // BOOST_AUTO_TEST_CASE(fileTable_testcase)
+
+
+BOOST_AUTO_TEST_CASE(tableErrors_testcase) {
+  tableErrors_test();
+} // BOOST_AUTO_TEST_CASE(tableErrors_testcase)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,219 @@
+/**
+ * @file   ChannelParallelHitFinding_test.cc
+ * @brief  Unit test for `ChannelParallelHitFinding.h` utilities.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/OpReco/Algorithms/ChannelParallelHitFinding.h
+ *
+ * The hits found by channel with different numbers of workers are compared
+ * with the ones of a serial loop on the waveforms in input order, as in
+ * LArSoft's `opdet::RunHitFinder()`.
+ * The test hit finder, like the ones in `larana`, keeps its own state and can
+ * not be shared between threads.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/OpReco/Algorithms/ChannelParallelHitFinding.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+#include "lardataobj/RecoBase/OpHit.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ChannelParallelHitFinding_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <algorithm> // std::shuffle()
+#include <memory> // std::make_unique()
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Simple threshold hit finder, with a work buffer of its own.
+  class TestHitFinder {
+
+    std::vector<double> fSubtracted; ///< Baseline subtracted waveform.
+
+      public:
+
+    /// Adds to `hits` the hits found on `waveform`.
+    void findHits
+      (raw::OpDetWaveform const& waveform, std::vector<recob::OpHit>& hits)
+      {
+        if (waveform.empty()) return;
+
+        // baseline from the first samples
+        std::size_t const nBaseline = std::min<std::size_t>(waveform.size(), 20U);
+        double baseline = 0.0;
+        for (std::size_t i = 0; i < nBaseline; ++i) baseline += waveform[i];
+        baseline /= nBaseline;
+
+        fSubtracted.resize(waveform.size());
+        for (std::size_t i = 0; i < waveform.size(); ++i)
+          fSubtracted[i] = baseline - waveform[i]; // negative polarity
+
+        constexpr double Threshold = 15.0;
+        std::size_t i = 0;
+        while (i < fSubtracted.size()) {
+          if (fSubtracted[i] < Threshold) { ++i; continue; }
+          std::size_t const start = i;
+          std::size_t peak = i;
+          double area = 0.0;
+          for (; (i < fSubtracted.size()) && (fSubtracted[i] >= Threshold); ++i) {
+            area += fSubtracted[i];
+            if (fSubtracted[i] > fSubtracted[peak]) peak = i;
+          }
+          double const peakTime = waveform.TimeStamp() + peak * 0.002;
+          hits.emplace_back(
+            static_cast<int>(waveform.ChannelNumber()), // channel
+            peakTime,                                   // peak time
+            peakTime,                                   // absolute peak time
+            0U,                                         // frame
+            (i - start) * 0.002,                        // width
+            area,                                       // area
+            fSubtracted[peak],                          // amplitude
+            area / 300.0,                               // photoelectrons
+            0.0                                         // fast to total
+            );
+        } // while
+      } // findHits()
+
+  }; // TestHitFinder
+
+
+  /// Returns waveforms on many channels, in shuffled order.
+  std::vector<raw::OpDetWaveform> makeWaveforms(unsigned int seed) {
+
+    std::mt19937 engine { seed };
+    std::uniform_int_distribution<int> nWaveforms { 0, 6 };
+    std::uniform_int_distribution<int> nPulses { 0, 4 };
+    std::uniform_int_distribution<std::size_t> pulseStart { 30U, 450U };
+    std::uniform_int_distribution<int> amplitude { 10, 200 };
+    std::normal_distribution<double> noise { 0.0, 2.0 };
+
+    std::vector<raw::OpDetWaveform> waveforms;
+    for (raw::Channel_t channel = 0; channel < 180; ++channel) {
+      for (int iWaveform = nWaveforms(engine); iWaveform > 0; --iWaveform) {
+        raw::OpDetWaveform waveform
+          { -1000.0 + 10.0 * iWaveform, channel, 500U };
+        for (std::size_t i = 0; i < 500U; ++i)
+          waveform.push_back(static_cast<short>(15000 + noise(engine)));
+        for (int iPulse = nPulses(engine); iPulse > 0; --iPulse) {
+          std::size_t const start = pulseStart(engine);
+          int const peak = amplitude(engine);
+          for (std::size_t i = 0; i < 40U; ++i)
+            waveform[start + i] -= peak * (i + 1) / (i * i / 4 + 1) / 4;
+        }
+        waveforms.push_back(std::move(waveform));
+      } // for waveforms
+    } // for channels
+
+    std::shuffle(waveforms.begin(), waveforms.end(), engine);
+    return waveforms;
+  } // makeWaveforms()
+
+
+  void checkSameHits
+    (std::vector<recob::OpHit> const& hits, std::vector<recob::OpHit> const& expected)
+  {
+    BOOST_TEST_REQUIRE(hits.size() == expected.size());
+    for (std::size_t iHit = 0; iHit < hits.size(); ++iHit) {
+      BOOST_TEST_INFO("hit #" << iHit);
+      recob::OpHit const& hit = hits[iHit];
+      recob::OpHit const& expHit = expected[iHit];
+      BOOST_TEST(hit.OpChannel() == expHit.OpChannel());
+      BOOST_TEST(hit.PeakTime() == expHit.PeakTime());
+      BOOST_TEST(hit.PeakTimeAbs() == expHit.PeakTimeAbs());
+      BOOST_TEST(hit.Frame() == expHit.Frame());
+      BOOST_TEST(hit.Width() == expHit.Width());
+      BOOST_TEST(hit.Area() == expHit.Area());
+      BOOST_TEST(hit.Amplitude() == expHit.Amplitude());
+      BOOST_TEST(hit.PE() == expHit.PE());
+      BOOST_TEST(hit.FastToTotal() == expHit.FastToTotal());
+    } // for
+  } // checkSameHits()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(groupWaveformsByChannel_test) {
+
+  std::vector<raw::OpDetWaveform> const waveforms = makeWaveforms(123U);
+
+  auto const isSelected
+    = [](raw::OpDetWaveform const& waveform){ return waveform.ChannelNumber() % 5 != 2; };
+
+  opdet::ChannelWaveforms_t const channelWaveforms
+    = opdet::groupWaveformsByChannel(waveforms, isSelected);
+
+  std::size_t nSelected = 0U;
+  for (raw::OpDetWaveform const& waveform: waveforms)
+    if (isSelected(waveform)) ++nSelected;
+
+  std::size_t nGrouped = 0U;
+  for (std::size_t iChannel = 0; iChannel < channelWaveforms.size(); ++iChannel) {
+    auto const& indices = channelWaveforms[iChannel];
+    BOOST_TEST_REQUIRE(!indices.empty());
+    raw::Channel_t const channel = waveforms[indices.front()].ChannelNumber();
+    BOOST_TEST(isSelected(waveforms[indices.front()]));
+    if (iChannel > 0)
+      BOOST_TEST(waveforms[channelWaveforms[iChannel - 1].front()].ChannelNumber() < channel);
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+      BOOST_TEST(waveforms[indices[i]].ChannelNumber() == channel);
+      if (i > 0) BOOST_TEST(indices[i - 1] < indices[i]);
+    }
+    nGrouped += indices.size();
+  } // for channels
+  BOOST_TEST(nGrouped == nSelected);
+
+} // BOOST_AUTO_TEST_CASE(groupWaveformsByChannel_test)
+
+
+BOOST_AUTO_TEST_CASE(findHitsByChannel_test) {
+
+  std::vector<raw::OpDetWaveform> const waveforms = makeWaveforms(456U);
+
+  // reference: serial processing of all the waveforms in input order
+  std::vector<recob::OpHit> expected;
+  TestHitFinder referenceFinder;
+  for (raw::OpDetWaveform const& waveform: waveforms)
+    referenceFinder.findHits(waveform, expected);
+  BOOST_TEST_REQUIRE(expected.size() > 100U);
+
+  opdet::ChannelWaveforms_t const channelWaveforms = opdet::groupWaveformsByChannel
+    (waveforms, [](raw::OpDetWaveform const&){ return true; });
+
+  auto const findChannelHits = [&waveforms](TestHitFinder& finder,
+    std::vector<std::size_t> const& indices,
+    std::vector<std::vector<recob::OpHit>>& waveformHits)
+    {
+      for (std::size_t const iWaveform: indices)
+        finder.findHits(waveforms[iWaveform], waveformHits[iWaveform]);
+    };
+
+  for (std::size_t const nWorkers: { 1U, 2U, 4U, 7U }) {
+    BOOST_TEST_CONTEXT("workers: " << nWorkers) {
+
+      std::vector<std::unique_ptr<TestHitFinder>> workers;
+      for (std::size_t i = 0; i < nWorkers; ++i)
+        workers.push_back(std::make_unique<TestHitFinder>());
+
+      for (int iEvent = 0; iEvent < 3; ++iEvent) { // workers are reused
+        std::vector<recob::OpHit> const hits
+          = opdet::findHitsByChannel<recob::OpHit>
+            (workers, channelWaveforms, waveforms.size(), findChannelHits);
+        checkSameHits(hits, expected);
+      }
+
+    } // BOOST_TEST_CONTEXT
+  } // for workers
+
+} // BOOST_AUTO_TEST_CASE(findHitsByChannel_test)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,280 @@
+/**
+ * @file   SimpleFlashAlgo_test.cc
+ * @brief  Unit test for `pmtana::SimpleFlashAlgo`.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/OpReco/FlashFinder/SimpleFlashAlgo.h
+ *
+ * The flashes are compared with the ones of the dense time bin algorithm
+ * previously implemented in `pmtana::SimpleFlashAlgo::RecoFlash()`, which is
+ * reproduced here (with local instead of static buffers).
+ * The comparison is exact: flash times, PE per channel and associated hits.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/OpReco/FlashFinder/SimpleFlashAlgo.h"
+
+// framework libraries
+#include "fhiclcpp/ParameterSet.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( SimpleFlashAlgo_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <map>
+#include <random>
+#include <utility> // std::pair
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Configuration of both the algorithm and the reference.
+  struct TestConfig_t {
+    double timeRes;
+    double minPEHit;
+    double minPEFlash;
+    double minPECoinc;
+    double minMultCoinc;
+    double integralTime;
+    double vetoTime;
+    double preSample;
+    std::vector<std::pair<double, double>> hitVetoRanges; ///< (start, end)
+    int nChannels; ///< Channels from `0` to `nChannels - 1` are used.
+
+    fhicl::ParameterSet pset() const
+      {
+        std::vector<double> vetoStart, vetoEnd;
+        for (auto const& [ start, end ]: hitVetoRanges) {
+          vetoStart.push_back(start);
+          vetoEnd.push_back(end);
+        }
+        fhicl::ParameterSet pset;
+        pset.put("TimeResolution", timeRes);
+        pset.put("PEThresholdHit", minPEHit);
+        pset.put("PEThreshold", minPEFlash);
+        pset.put("MinPECoinc", minPECoinc);
+        pset.put("MinMultCoinc", minMultCoinc);
+        pset.put("IntegralTime", integralTime);
+        pset.put("VetoSize", vetoTime);
+        pset.put("PreSample", preSample);
+        pset.put("HitVetoRangeStart", vetoStart);
+        pset.put("HitVetoRangeEnd", vetoEnd);
+        pset.put("OpChannelRange", std::vector<int>{ 0, nChannels - 1 });
+        return pset;
+      }
+  }; // TestConfig_t
+
+
+  /// The original dense time bin algorithm, for channels `0` to `N - 1`.
+  pmtana::LiteOpFlashArray_t referenceRecoFlash
+    (TestConfig_t const& config, pmtana::LiteOpHitArray_t const& ophits)
+  {
+    double const _time_res = config.timeRes;
+    std::size_t const NOpDet = config.nChannels;
+    std::size_t const max_ch = NOpDet - 1;
+
+    std::map<double,double> vetoRanges; // end => start
+    for (auto const& [ start, end ]: config.hitVetoRanges)
+      vetoRanges.emplace(end, start);
+    auto const Veto = [&vetoRanges](double t)
+      {
+        auto iter = vetoRanges.lower_bound(t);
+        if(iter == vetoRanges.end()) return false;
+        return (t >= (*iter).second);
+      };
+
+    double min_time=1.1e20;
+    double max_time=1.1e20;
+    for(auto const& oph : ophits) {
+      if(max_time > 1.e20 || oph.peak_time > max_time) max_time = oph.peak_time;
+      if(min_time > 1.e20 || oph.peak_time < min_time) min_time = oph.peak_time;
+    }
+    min_time -= 10* _time_res;
+    max_time += 10* _time_res;
+
+    std::size_t nbins_pesum_v = (std::size_t)((max_time - min_time) / _time_res) + 1;
+    std::vector<double> pesum_v(nbins_pesum_v, 0);
+    std::vector<double> mult_v(nbins_pesum_v, 0);
+    std::vector<std::vector<double> > pespec_v
+      (nbins_pesum_v, std::vector<double>(NOpDet));
+    std::vector<std::vector<unsigned int> > hitidx_v(nbins_pesum_v);
+
+    for(std::size_t hitidx = 0; hitidx < ophits.size(); ++hitidx) {
+      auto const& oph = ophits[hitidx];
+      if(oph.channel > max_ch) continue;
+      if(Veto(oph.peak_time)) continue;
+      if(oph.pe <= 0.) continue;
+      if(config.minPEHit > 0. && oph.pe < config.minPEHit) continue;
+      std::size_t index = (std::size_t)((oph.peak_time - min_time) / _time_res);
+      pesum_v[index] += oph.pe;
+      mult_v[index] += 1;
+      pespec_v[index][oph.channel] += oph.pe;
+      hitidx_v[index].push_back(hitidx);
+    }
+
+    std::map<double,std::size_t> pesum_idx_map;
+    for(std::size_t idx=0; idx<nbins_pesum_v; ++idx) {
+      if(pesum_v[idx] < config.minPECoinc  ) continue;
+      if(mult_v[idx]  < config.minMultCoinc) continue;
+      pesum_idx_map[1./(pesum_v[idx])] = idx;
+    }
+
+    std::vector<std::pair<std::size_t,std::size_t> > flash_period_v;
+    std::vector<std::size_t> flash_time_v;
+    std::size_t veto_ctr = (std::size_t)(config.vetoTime / _time_res);
+    std::size_t default_integral_ctr = (std::size_t)(config.integralTime / _time_res);
+    std::size_t precount = (std::size_t)(config.preSample / _time_res);
+
+    for(auto const& pe_idx : pesum_idx_map) {
+      auto const& idx = pe_idx.second;
+
+      std::size_t start_time = idx;
+      if(start_time < precount) start_time = 0;
+      else start_time = idx - precount;
+
+      bool skip=false;
+      std::size_t integral_ctr = default_integral_ctr;
+      for(auto const& used_period : flash_period_v) {
+        if( start_time <= used_period.first && (start_time + veto_ctr) > used_period.first ) {
+          skip=true;
+          break;
+        }
+        if( used_period.first <= start_time && start_time < (used_period.first + veto_ctr) ) {
+          skip=true;
+          break;
+        }
+        if( used_period.first >= start_time && used_period.first < (start_time + integral_ctr) )
+          integral_ctr = used_period.first - start_time;
+      }
+      if(skip) continue;
+
+      double pesum = 0;
+      for(std::size_t i=start_time; i<std::min(nbins_pesum_v,(start_time+integral_ctr)); ++i)
+        pesum += pesum_v[i];
+
+      if(pesum < config.minPEFlash) continue;
+
+      flash_period_v.emplace_back(start_time,integral_ctr);
+      flash_time_v.push_back(idx);
+    }
+
+    pmtana::LiteOpFlashArray_t res;
+    for(std::size_t flash_idx=0; flash_idx<flash_period_v.size(); ++flash_idx) {
+      auto const& start  = flash_period_v[flash_idx].first;
+      auto const& period = flash_period_v[flash_idx].second;
+      auto const& time   = flash_time_v[flash_idx];
+
+      std::vector<double> pe_v(max_ch+1,0);
+      for(std::size_t index=start; index<(start+period) && index<pespec_v.size(); ++index)
+        for(std::size_t pmt_index=0; pmt_index<NOpDet; ++pmt_index)
+          pe_v[pmt_index] += pespec_v[index][pmt_index];
+
+      for(std::size_t opch=0; opch<max_ch; ++opch)
+        if(pe_v[opch]<0) pe_v[opch]=0;
+
+      std::vector<unsigned int> asshit_v;
+      for(std::size_t index=start; index<(start+period) && index<pespec_v.size(); ++index)
+        for(auto const& idx : hitidx_v[index]) asshit_v.push_back(idx);
+
+      res.emplace_back(min_time + time * _time_res, period * _time_res / 2.,
+                       std::move(pe_v), std::move(asshit_v));
+    }
+    return res;
+  } // referenceRecoFlash()
+
+
+  /// Returns hits partially clustered in time, so that flashes compete.
+  pmtana::LiteOpHitArray_t makeHits(std::mt19937& engine, int nChannels) {
+
+    std::uniform_int_distribution<int> nHits { 0, 400 };
+    std::uniform_int_distribution<int> channel { 0, nChannels + 4 };
+    std::uniform_int_distribution<int> cluster { 0, 19 };
+    std::uniform_int_distribution<int> jitter { 0, 99 };
+    std::uniform_int_distribution<int> spread { 0, 1999 };
+    std::uniform_int_distribution<int> smallPE { 0, 3 };
+    std::uniform_int_distribution<int> pe { 0, 999 };
+    std::uniform_int_distribution<int> choice { 0, 14 };
+
+    pmtana::LiteOpHitArray_t hits(nHits(engine));
+    for (pmtana::LiteOpHit_t& hit: hits) {
+      int const kind = choice(engine);
+      hit.channel = channel(engine); // some channels are not used
+      hit.peak_time = (kind % 3 == 0)
+        ? cluster(engine) * 2.0 - 10.0 + jitter(engine) * 0.001
+        : spread(engine) * 0.01 - 8.0;
+      hit.pe = (kind % 5 == 0)? smallPE(engine): pe(engine) * 0.01;
+    }
+    return hits;
+  } // makeHits()
+
+
+  void checkSameFlashes(
+    pmtana::LiteOpFlashArray_t const& flashes,
+    pmtana::LiteOpFlashArray_t const& expected
+  ) {
+    BOOST_TEST_REQUIRE(flashes.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      BOOST_TEST_CONTEXT("flash #" << i) {
+        BOOST_TEST(flashes[i].time == expected[i].time);
+        BOOST_TEST(flashes[i].time_err == expected[i].time_err);
+        BOOST_TEST(flashes[i].channel_pe == expected[i].channel_pe,
+          boost::test_tools::per_element());
+        BOOST_TEST(flashes[i].asshit_idx == expected[i].asshit_idx,
+          boost::test_tools::per_element());
+      }
+    } // for
+  } // checkSameFlashes()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SameFlashesTest) {
+
+  std::vector<TestConfig_t> const configs {
+    // resol. hitPE flash coinc mult integr. veto presample veto ranges  channels
+    {  0.03,  0.5,  10.,  5.,   2.,  8.,     8.,  0.1,     { { -5., -4. } }, 90 },
+    {  0.1,   0.5,  10.,  5.,   2.,  2.,     5.,  0.,      { { -5., -4. } }, 90 },
+    {  0.03,  0.,   0.,   0.,   0.,  3.,     5.,  0.1,     {},               60 },
+    {  0.1,   1.0,  20.,  5.,   3.,  4.,     5.,  0.3,     { { -2., 0. }, { 5., 6. } }, 90 },
+  };
+
+  std::mt19937 engine { 29U };
+  unsigned int nFlashes = 0U;
+
+  for (std::size_t iConfig = 0; iConfig < configs.size(); ++iConfig) {
+    BOOST_TEST_CONTEXT("configuration #" << iConfig) {
+      TestConfig_t const& config = configs[iConfig];
+
+      // two instances, used alternately, to check that they share no state
+      pmtana::SimpleFlashAlgo algA { "A" }, algB { "B" };
+      algA.Configure(config.pset());
+      algB.Configure(config.pset());
+
+      for (int event = 0; event < 40; ++event) {
+        BOOST_TEST_CONTEXT("event #" << event) {
+          pmtana::LiteOpHitArray_t const hits
+            = makeHits(engine, config.nChannels);
+
+          pmtana::LiteOpFlashArray_t const expected
+            = referenceRecoFlash(config, hits);
+          nFlashes += expected.size();
+
+          pmtana::SimpleFlashAlgo& alg = (event % 3 == 0)? algB: algA;
+          checkSameFlashes(alg.RecoFlash(hits), expected);
+        }
+      } // for events
+    }
+  } // for configurations
+
+  // make sure the comparison is not just between empty results
+  BOOST_TEST(nFlashes > 100U);
+
+} // BOOST_AUTO_TEST_CASE(SameFlashesTest)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,255 @@
+/**
+ * @file SlidingWindowMultiPatternAlg_test.cc
+ * @brief Unit test for `icarus::trigger::SlidingWindowMultiPatternAlg`.
+ * @date October 18, 2026
+ * @see icaruscode/PMT/Trigger/Algorithms/SlidingWindowMultiPatternAlg.h
+ *
+ * The response of each pattern is compared with the one of a
+ * `icarus::trigger::SlidingWindowPatternAlg` on the same gates, both for the
+ * whole detector and window by window (`icarus::trigger::WindowGateRaster`).
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Algorithms/SlidingWindowMultiPatternAlg.h"
+#include "icaruscode/PMT/Trigger/Algorithms/SlidingWindowPatternAlg.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowGateRaster.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowChannelMap.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowPattern.h"
+#include "icaruscode/PMT/Trigger/Utilities/TrackedTriggerGate.h" // gateDataIn()
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( SlidingWindowMultiPatternAlg_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+using PatternAlg_t = icarus::trigger::SlidingWindowPatternAlg;
+using MultiPatternAlg_t = icarus::trigger::SlidingWindowMultiPatternAlg;
+using WindowChannelMap_t = icarus::trigger::WindowChannelMap;
+using Raster_t = icarus::trigger::WindowGateRaster
+  <PatternAlg_t::TriggerGateData_t::GateData_t>;
+using icarus::trigger::WindowPattern;
+
+
+// -----------------------------------------------------------------------------
+/**
+ * Four windows, two on each side:
+ *
+ *     upstream     downstream
+ *       [0]    -->    [1]
+ *       [2]    -->    [3]
+ *
+ * with 0 opposite to 2 and 1 opposite to 3.
+ */
+WindowChannelMap_t TestTopology() {
+
+  std::vector<WindowChannelMap_t::WindowInfo_t> windows(4U);
+  for (std::size_t iWindow = 0; iWindow < windows.size(); ++iWindow)
+    windows[iWindow].index = iWindow;
+
+  windows[0].downstream = 1;
+  windows[0].opposite = 2;
+  windows[1].upstream = 0;
+  windows[1].opposite = 3;
+  windows[2].downstream = 3;
+  windows[2].opposite = 0;
+  windows[3].upstream = 2;
+  windows[3].opposite = 1;
+
+  return WindowChannelMap_t{ std::move(windows) };
+} // TestTopology()
+
+
+/// Returns a list of patterns covering all the requirement types.
+std::vector<WindowPattern> TestPatterns() {
+
+  std::vector<WindowPattern> patterns;
+
+  auto pattern = [&patterns]() -> WindowPattern&
+    { return patterns.emplace_back(); };
+
+  pattern().minInMainWindow = 1U;
+  pattern().minInMainWindow = 3U;
+  {
+    WindowPattern& p = pattern();
+    p.minInMainWindow = 2U;
+    p.minInOppositeWindow = 1U;
+  }
+  {
+    WindowPattern& p = pattern();
+    p.minInMainWindow = 1U;
+    p.minSumInOppositeWindows = 4U;
+  }
+  {
+    WindowPattern& p = pattern();
+    p.minInMainWindow = 2U;
+    p.minInDownstreamWindow = 1U;
+  }
+  {
+    WindowPattern& p = pattern();
+    p.minInMainWindow = 2U;
+    p.minInUpstreamWindow = 2U;
+    p.requireUpstreamWindow = true;
+  }
+  {
+    WindowPattern& p = pattern();
+    p.minInMainWindow = 1U;
+    p.minInDownstreamWindow = 1U;
+    p.requireDownstreamWindow = true;
+  }
+  {
+    WindowPattern& p = pattern();
+    p.minInMainWindow = 2U;
+    p.minInOppositeWindow = 2U;
+    p.minSumInOppositeWindows = 5U;
+    p.minInUpstreamWindow = 1U;
+    p.minInDownstreamWindow = 1U;
+  }
+
+  return patterns;
+} // TestPatterns()
+
+
+/// Returns one gate per window, with random openings (`seed` drives them).
+PatternAlg_t::TriggerGates_t TestGates(std::size_t nWindows, unsigned int seed)
+{
+  std::mt19937 engine { seed };
+  std::uniform_int_distribution<int> nOpenings { 0, 12 };
+  std::uniform_int_distribution<int> start { -100, 2000 };
+  std::uniform_int_distribution<int> length { 1, 150 };
+  std::uniform_int_distribution<unsigned int> count { 1U, 3U };
+
+  PatternAlg_t::TriggerGates_t gates(nWindows);
+  for (auto& gate: gates) {
+    for (int i = nOpenings(engine); i > 0; --i) {
+      int const from = start(engine);
+      gateDataIn(gate).openBetween(from, from + length(engine), count(engine));
+    }
+  } // for
+
+  return gates;
+} // TestGates()
+
+
+// -----------------------------------------------------------------------------
+void CheckSameResponse(
+  PatternAlg_t::TriggerInfo_t const& response,
+  PatternAlg_t::TriggerInfo_t const& expected
+) {
+
+  BOOST_TEST(response.fired() == expected.fired());
+  if (!expected.fired()) return;
+
+  BOOST_TEST(response.atTick() == expected.atTick());
+  BOOST_TEST(response.level() == expected.level());
+  BOOST_TEST(response.location() == expected.location());
+  BOOST_TEST_REQUIRE(response.nTriggers() == expected.nTriggers());
+  for (std::size_t i = 0; i < expected.nTriggers(); ++i) {
+    BOOST_TEST_INFO("trigger #" << i);
+    BOOST_TEST(response.all()[i].tick == expected.all()[i].tick);
+    BOOST_TEST(response.all()[i].level == expected.all()[i].level);
+    BOOST_TEST(response.all()[i].locationID == expected.all()[i].locationID);
+  }
+
+} // CheckSameResponse()
+
+
+void CheckSameResponse(
+  PatternAlg_t::AllTriggerInfo_t const& response,
+  PatternAlg_t::AllTriggerInfo_t const& expected
+) {
+
+  CheckSameResponse(response.info, expected.info);
+  if (expected.info.fired())
+    BOOST_TEST(response.extra.windowIndex == expected.extra.windowIndex);
+
+} // CheckSameResponse()
+
+
+void SamePatternResponseTest() {
+
+  WindowChannelMap_t const topology = TestTopology();
+  std::vector<WindowPattern> const patterns = TestPatterns();
+
+  std::vector<PatternAlg_t> patternAlgs;
+  patternAlgs.reserve(patterns.size());
+  for (WindowPattern const& pattern: patterns)
+    patternAlgs.emplace_back(topology, pattern);
+
+  MultiPatternAlg_t const multiPatternAlg { topology, patterns };
+
+  unsigned int nFired = 0U;
+  for (unsigned int event = 0; event < 200U; ++event) {
+
+    PatternAlg_t::TriggerGates_t const gates
+      = TestGates(topology.nWindows(), event);
+
+    std::vector<PatternAlg_t::AllTriggerInfo_t> const responses
+      = multiPatternAlg.simulateResponses(gates);
+    BOOST_TEST_REQUIRE(responses.size() == patterns.size());
+
+    for (std::size_t iPattern = 0; iPattern < patterns.size(); ++iPattern) {
+      BOOST_TEST_INFO("event #" << event << ", pattern #" << iPattern);
+
+      PatternAlg_t::AllTriggerInfo_t const expected
+        = patternAlgs[iPattern].simulateResponse(gates);
+      if (expected) ++nFired;
+
+      CheckSameResponse(responses[iPattern], expected);
+    } // for patterns
+  } // for events
+
+  // make sure the comparison is not just between empty responses
+  BOOST_TEST(nFired > 0U);
+
+} // SamePatternResponseTest()
+
+
+void SameWindowResponseTest() {
+
+  WindowChannelMap_t const topology = TestTopology();
+  std::vector<WindowPattern> const patterns = TestPatterns();
+
+  PatternAlg_t const patternAlg { topology, patterns.front() };
+
+  for (unsigned int event = 0; event < 50U; ++event) {
+
+    PatternAlg_t::TriggerGates_t const gates
+      = TestGates(topology.nWindows(), 1000U + event);
+
+    Raster_t const raster { gates };
+
+    for (std::size_t iPattern = 0; iPattern < patterns.size(); ++iPattern) {
+      for (std::size_t iWindow = 0; iWindow < topology.nWindows(); ++iWindow) {
+        BOOST_TEST_INFO("event #" << event << ", pattern #" << iPattern
+          << ", window #" << iWindow);
+
+        WindowChannelMap_t::WindowInfo_t const& window
+          = topology.info(iWindow);
+
+        CheckSameResponse(
+          raster.applyWindowPattern(window, patterns[iPattern]),
+          patternAlg.applyWindowPattern(window, patterns[iPattern], gates)
+          );
+      } // for windows
+    } // for patterns
+  } // for events
+
+} // SameWindowResponseTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SlidingWindowMultiPatternAlgTestCase) {
+
+  SamePatternResponseTest();
+  SameWindowResponseTest();
+
+} // BOOST_AUTO_TEST_CASE(SlidingWindowMultiPatternAlgTestCase)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,262 @@
+/**
+ * @file   ThresholdLevelScan_test.cc
+ * @brief  Unit test for `details/ThresholdLevelScan.h` discrimination.
+ * @date   October 18, 2026
+ * @see    icaruscode/PMT/Trigger/Algorithms/details/ThresholdLevelScan.h
+ *
+ * The threshold crossings reported by `scanThresholdLevels()` are compared
+ * with the ones of the sample-by-sample discrimination previously used in
+ * `icarus::trigger::ManagedTriggerGateBuilder::buildChannelGates()`.
+ * The gates are built from these crossings alone, so matching crossings yield
+ * identical gates.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Algorithms/details/ThresholdLevelScan.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ThresholdLevelScan_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::fill()
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <vector>
+#include <cmath> // std::round()
+#include <cstdint> // std::int16_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  using Sample_t = std::int16_t;
+  using SampleLimits_t = std::numeric_limits<Sample_t>;
+
+  /// A threshold being reached (`raise`) or left at a sample.
+  struct Crossing_t {
+    std::size_t threshold;
+    std::size_t sample;
+    bool raise;
+
+    bool operator== (Crossing_t const& other) const
+      {
+        return (threshold == other.threshold) && (sample == other.sample)
+          && (raise == other.raise);
+      }
+  }; // Crossing_t
+
+  std::ostream& operator<< (std::ostream& out, Crossing_t const& crossing)
+    {
+      out << (crossing.raise? "raise": "fall") << " thr #" << crossing.threshold
+        << " at sample #" << crossing.sample;
+      return out;
+    }
+
+
+  /// Baseline subtraction (negative polarity) with rounding, as in the builder.
+  Sample_t relativeSample(float baseline, int sample)
+    {
+      return static_cast<Sample_t>
+        (std::round(baseline - static_cast<float>(sample)));
+    }
+
+
+  /// Sample-by-sample discrimination, with the original algorithm.
+  std::vector<Crossing_t> referenceCrossings(
+    std::vector<Sample_t> const& waveform, float baseline,
+    std::vector<Sample_t> const& thresholds
+  ) {
+    std::vector<Crossing_t> crossings;
+
+    std::size_t const nThresholds = thresholds.size();
+    std::size_t nextGateToOpen = 0;
+    std::optional<std::size_t> lowerThreshold;
+    std::optional<std::size_t> upperThreshold;
+    if (nThresholds > 0) upperThreshold = 0;
+
+    for (std::size_t iSample = 0; iSample < waveform.size(); ++iSample) {
+
+      Sample_t const relSample = relativeSample(baseline, waveform[iSample]);
+
+      if (lowerThreshold && (relSample < thresholds[*lowerThreshold])) {
+        do {
+          crossings.push_back({ --nextGateToOpen, iSample, false });
+          if (*lowerThreshold == 0) { lowerThreshold.reset(); break; }
+          --*lowerThreshold;
+        } while (relSample < thresholds[*lowerThreshold]);
+        upperThreshold = lowerThreshold? *lowerThreshold + 1: 0;
+      }
+      else if (upperThreshold && (relSample >= thresholds[*upperThreshold])) {
+        do {
+          crossings.push_back({ nextGateToOpen++, iSample, true });
+          if (++*upperThreshold == nThresholds) {
+            upperThreshold.reset();
+            break;
+          }
+        } while (relSample >= thresholds[*upperThreshold]);
+        lowerThreshold = (upperThreshold? *upperThreshold: nThresholds) - 1;
+      }
+
+    } // for samples
+
+    return crossings;
+  } // referenceCrossings()
+
+
+  /// Discrimination via `scanThresholdLevels()`, as in the builder.
+  std::vector<Crossing_t> scannedCrossings(
+    std::vector<Sample_t> const& waveform, float baseline,
+    std::vector<Sample_t> const& thresholds
+  ) {
+    std::vector<int> sampleCuts;
+    icarus::trigger::details::computeSampleCuts(thresholds.size(),
+      [baseline,&thresholds](int sample, std::size_t iThr)
+        {
+          return std::round(baseline - static_cast<float>(sample))
+            >= static_cast<float>(thresholds[iThr]);
+        },
+      sampleCuts
+      );
+
+    std::vector<Crossing_t> crossings;
+    icarus::trigger::details::scanThresholdLevels(
+      waveform.data(), waveform.size(), sampleCuts,
+      [&crossings](std::size_t iThr, std::size_t iSample)
+        { crossings.push_back({ iThr, iSample, true }); },
+      [&crossings](std::size_t iThr, std::size_t iSample)
+        { crossings.push_back({ iThr, iSample, false }); }
+      );
+    return crossings;
+  } // scannedCrossings()
+
+
+  void checkSameCrossings(
+    std::vector<Sample_t> const& waveform, float baseline,
+    std::vector<Sample_t> const& thresholds
+  ) {
+    std::vector<Crossing_t> const expected
+      = referenceCrossings(waveform, baseline, thresholds);
+    std::vector<Crossing_t> const crossings
+      = scannedCrossings(waveform, baseline, thresholds);
+
+    BOOST_TEST_REQUIRE(crossings.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      BOOST_TEST_INFO("crossing #" << i);
+      BOOST_TEST(crossings[i] == expected[i]);
+    }
+  } // checkSameCrossings()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ConstantRunsTest) {
+
+  std::vector<Sample_t> const thresholds { 5, 10, 10, 30, 200 };
+
+  for (float const baseline: { 15000.0f, 15000.5f, 14999.5f, 15000.3f }) {
+    BOOST_TEST_CONTEXT("baseline: " << baseline) {
+
+      Sample_t const base = static_cast<Sample_t>(baseline);
+
+      // long flat runs with step edges at many offsets, so that the level
+      // changes in every lane of a vector block and across block borders
+      for (std::size_t edge = 0; edge < 40; ++edge) {
+        BOOST_TEST_CONTEXT("edge at: " << edge) {
+          std::vector<Sample_t> waveform(1000, base);
+          std::fill(waveform.begin() + edge, waveform.begin() + edge + 300,
+            static_cast<Sample_t>(base - 35)); // above three thresholds
+          std::fill(waveform.begin() + 500 + edge, waveform.begin() + 501 + edge,
+            static_cast<Sample_t>(base - 10)); // single sample, on threshold
+          std::fill(waveform.begin() + 700 + edge, waveform.end(),
+            static_cast<Sample_t>(base - 250)); // above all, to the end
+          checkSameCrossings(waveform, baseline, thresholds);
+        }
+      } // for edges
+
+      // staircase up and down, one threshold value at a time
+      std::vector<Sample_t> staircase;
+      for (int step = -5; step < 40; ++step)
+        staircase.insert(staircase.end(), 17, static_cast<Sample_t>(base - step));
+      for (int step = 40; step > -5; --step)
+        staircase.insert(staircase.end(), 9, static_cast<Sample_t>(base - step));
+      checkSameCrossings(staircase, baseline, thresholds);
+
+    } // BOOST_TEST_CONTEXT
+  } // for baselines
+
+} // BOOST_AUTO_TEST_CASE(ConstantRunsTest)
+
+
+BOOST_AUTO_TEST_CASE(ExtremeValuesTest) {
+
+  // samples close to the limits of the range (the reference algorithm can't
+  // handle baseline subtracted values out of it), and thresholds out of reach
+  Sample_t const low = SampleLimits_t::min() + 101;
+  Sample_t const high = SampleLimits_t::max() - 101;
+  std::vector<Sample_t> waveform(50, 0);
+  waveform[3] = low;
+  waveform[4] = high;
+  waveform[20] = low;
+  std::fill(waveform.begin() + 30, waveform.end(), low);
+
+  for (float const baseline: { 0.0f, 100.0f, -100.0f }) {
+    BOOST_TEST_CONTEXT("baseline: " << baseline) {
+      checkSameCrossings(waveform, baseline, {});
+      checkSameCrossings(waveform, baseline, { 0 });
+      checkSameCrossings(waveform, baseline, { -200, 0, 50 });
+      checkSameCrossings(waveform, baseline, { 1, SampleLimits_t::max() });
+      checkSameCrossings
+        (std::vector<Sample_t>(waveform.begin(), waveform.begin() + 5),
+         baseline, { 1, 2 });
+      checkSameCrossings({}, baseline, { 1, 2 });
+    }
+  } // for baselines
+
+} // BOOST_AUTO_TEST_CASE(ExtremeValuesTest)
+
+
+BOOST_AUTO_TEST_CASE(RandomWaveformTest) {
+
+  std::mt19937 engine { 28U };
+  std::uniform_int_distribution<int> nThresholds { 0, 6 };
+  std::uniform_int_distribution<int> threshold { 0, 40 };
+  std::uniform_int_distribution<int> runLength { 1, 200 };
+  std::uniform_int_distribution<int> level { -10, 50 };
+  std::uniform_int_distribution<int> noise { -1, 1 };
+  std::uniform_int_distribution<int> baselineShift { -1000, 1000 };
+
+  for (int iWaveform = 0; iWaveform < 2000; ++iWaveform) {
+    BOOST_TEST_CONTEXT("waveform #" << iWaveform) {
+
+      std::vector<Sample_t> thresholds(nThresholds(engine));
+      for (Sample_t& thr: thresholds) thr = threshold(engine);
+      std::sort(thresholds.begin(), thresholds.end());
+
+      float const baseline = 15000.0f + baselineShift(engine) / 100.0f;
+
+      // runs of constant (or almost constant) level
+      std::vector<Sample_t> waveform;
+      std::size_t const nSamples = 1500;
+      while (waveform.size() < nSamples) {
+        int const runLevel = level(engine);
+        bool const noisy = (iWaveform % 2) == 1;
+        for (int i = runLength(engine); i > 0; --i) {
+          waveform.push_back(static_cast<Sample_t>
+            (baseline - runLevel + (noisy? noise(engine): 0)));
+        }
+      } // while
+
+      checkSameCrossings(waveform, baseline, thresholds);
+
+    } // BOOST_TEST_CONTEXT
+  } // for waveforms
+
+} // BOOST_AUTO_TEST_CASE(RandomWaveformTest)
+
+
+// -----------------------------------------------------------------------------
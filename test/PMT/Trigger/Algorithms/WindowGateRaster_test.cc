@@ -0,0 +1,174 @@
+/**
+ * @file WindowGateRaster_test.cc
+ * @brief Unit test for `icarus::trigger::WindowGateRaster`.
+ * @date October 18, 2026
+ * @see icaruscode/PMT/Trigger/Algorithms/WindowGateRaster.h
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Algorithms/WindowGateRaster.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowChannelMap.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowPattern.h"
+#include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateData.h"
+
+// LArSoft libraries
+#include "lardataalg/DetectorInfo/DetectorTimingTypes.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( WindowGateRaster_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using Gate_t = icarus::trigger::TriggerGateData<int, int>;
+using Raster_t = icarus::trigger::WindowGateRaster<Gate_t>;
+using WindowTopology_t = icarus::trigger::WindowChannelMap::WindowTopology_t;
+using icarus::trigger::WindowPattern;
+using detinfo::timescales::optical_tick;
+
+
+// -----------------------------------------------------------------------------
+std::vector<Gate_t> TestGates() {
+  
+  /*
+   *  window #0:  2 in [ 10, 20 ), 3 in [ 14, 16 )
+   *  window #1:  1 in [ 12, 30 )
+   *  window #2:  1 in [ 40, 45 ) and [ 50, 52 )
+   */
+  std::vector<Gate_t> gates(3U);
+  gates[0].openBetween(10, 20, 2);
+  gates[0].openBetween(14, 16);
+  gates[1].openBetween(12, 30);
+  gates[2].openBetween(40, 45);
+  gates[2].openBetween(50, 52);
+  
+  return gates;
+} // TestGates()
+
+
+// -----------------------------------------------------------------------------
+void SamplingTest() {
+  
+  Raster_t const raster { TestGates() };
+  
+  BOOST_TEST(raster.nWindows() == 3U);
+  
+  // interval starts: MinTick, 10, 12, 14, 16, 20, 30, 40, 45, 50, 52
+  BOOST_TEST(raster.nIntervals() == 11U);
+  BOOST_TEST(raster.intervalStart(1) == 10);
+  BOOST_TEST(raster.intervalStart(3) == 14);
+  BOOST_TEST(raster.intervalStart(10) == 52);
+  
+  BOOST_TEST(raster.level(0, 0) == 0U);
+  BOOST_TEST(raster.level(0, 1) == 2U);
+  BOOST_TEST(raster.level(0, 3) == 3U);
+  BOOST_TEST(raster.level(0, 5) == 0U);
+  BOOST_TEST(raster.level(1, 2) == 1U);
+  BOOST_TEST(raster.level(1, 6) == 0U);
+  BOOST_TEST(raster.level(2, 7) == 1U);
+  BOOST_TEST(raster.level(2, 8) == 0U);
+  
+} // SamplingTest()
+
+
+// -----------------------------------------------------------------------------
+void PatternTest() {
+  
+  Raster_t const raster { TestGates() };
+  
+  WindowTopology_t window0;
+  window0.index = 0;
+  window0.downstream = 1;
+  window0.opposite = 2;
+  
+  WindowTopology_t window2;
+  window2.index = 2;
+  
+  WindowPattern pattern;
+  
+  // main window only
+  pattern.minInMainWindow = 2U;
+  auto info = raster.applyWindowPattern(window0, pattern);
+  BOOST_TEST(info.nTriggers() == 1U);
+  BOOST_TEST(info.atTick() == optical_tick{ 10 });
+  BOOST_TEST(info.level() == 3U);
+  BOOST_TEST(info.location() == 0U);
+  
+  // main and downstream window
+  pattern.minInDownstreamWindow = 1U;
+  info = raster.applyWindowPattern(window0, pattern);
+  BOOST_TEST(info.nTriggers() == 1U);
+  BOOST_TEST(info.atTick() == optical_tick{ 12 });
+  BOOST_TEST(info.level() == 3U);
+  
+  // upstream window required but missing
+  pattern.requireUpstreamWindow = true;
+  info = raster.applyWindowPattern(window0, pattern);
+  BOOST_TEST(!info.fired());
+  
+  // opposite window never open at the same time
+  pattern = WindowPattern{};
+  pattern.minInMainWindow = 1U;
+  pattern.minInOppositeWindow = 1U;
+  info = raster.applyWindowPattern(window0, pattern);
+  BOOST_TEST(!info.fired());
+  
+  // sum of main and opposite windows
+  pattern = WindowPattern{};
+  pattern.minSumInOppositeWindows = 3U;
+  info = raster.applyWindowPattern(window0, pattern);
+  BOOST_TEST(info.nTriggers() == 1U);
+  BOOST_TEST(info.atTick() == optical_tick{ 14 });
+  BOOST_TEST(info.level() == 3U);
+  
+  // multiple openings
+  pattern = WindowPattern{};
+  pattern.minInMainWindow = 1U;
+  info = raster.applyWindowPattern(window2, pattern);
+  BOOST_TEST(info.nTriggers() == 2U);
+  BOOST_TEST(info.atTick() == optical_tick{ 40 });
+  BOOST_TEST(info.all().at(1).tick == optical_tick{ 50 });
+  BOOST_TEST(info.location() == 2U);
+  
+} // PatternTest()
+
+
+// -----------------------------------------------------------------------------
+void ManyIntervalsTest() {
+  
+  // 100 separate openings: more intervals than a single mask word
+  constexpr int nPulses = 100;
+  std::vector<Gate_t> gates(1U);
+  for (int i = 0; i < nPulses; ++i) gates[0].openBetween(100 + 4*i, 102 + 4*i);
+  
+  Raster_t const raster { gates };
+  BOOST_TEST(raster.nIntervals() == 2U * nPulses + 1U);
+  
+  WindowTopology_t window0;
+  window0.index = 0;
+  
+  WindowPattern pattern;
+  pattern.minInMainWindow = 1U;
+  
+  auto const info = raster.applyWindowPattern(window0, pattern);
+  BOOST_TEST(info.nTriggers() == static_cast<std::size_t>(nPulses));
+  BOOST_TEST(info.atTick() == optical_tick{ 100 });
+  BOOST_TEST(info.all().back().tick == optical_tick{ 100 + 4 * (nPulses - 1) });
+  
+} // ManyIntervalsTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(WindowGateRasterTestCase) {
+  
+  SamplingTest();
+  PatternTest();
+  ManyIntervalsTest();
+  
+} // BOOST_AUTO_TEST_CASE(WindowGateRasterTestCase)
+
+
+// -----------------------------------------------------------------------------
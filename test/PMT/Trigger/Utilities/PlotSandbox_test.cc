@@ -0,0 +1,143 @@
+/**
+ * @file PlotSandbox_test.cc
+ * @brief Unit test for the object registry of `icarus::trigger::PlotSandbox`.
+ * @date October 18, 2026
+ * @see icaruscode/PMT/Trigger/Utilities/PlotSandbox.h
+ *
+ * The objects returned by `use()` and `demand()` are compared with the ones
+ * found by name in the ROOT directory, which is how `PlotSandbox` used to look
+ * them up, after they are made and after they are deleted.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Utilities/PlotSandbox.h"
+
+// framework libraries
+#include "art_root_io/TFileDirectory.h"
+#include "cetlib_except/exception.h"
+
+// ROOT libraries
+#include "TMemFile.h"
+#include "TDirectory.h"
+#include "TH1F.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( PlotSandbox_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <string>
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// A `art::TFileDirectory` writing directly into a ROOT file.
+  struct TestFileDirectory: art::TFileDirectory {
+    TestFileDirectory(TFile& file)
+      : art::TFileDirectory("", "", &file, false) {}
+  };
+
+
+  /// The object with unprocessed `name` (and path) from the ROOT directory.
+  TH1* findInDirectory
+    (icarus::trigger::PlotSandbox const& box, std::string const& name)
+  {
+    auto const iSep = name.rfind('/');
+    std::string const dirName
+      = (iSep == std::string::npos)? "": name.substr(0, iSep);
+    std::string const objName
+      = (iSep == std::string::npos)? name: name.substr(iSep + 1);
+
+    TDirectory* dir = box.getDirectory(dirName);
+    return dir? dir->Get<TH1>(box.processName(objName).c_str()): nullptr;
+  } // findInDirectory()
+
+
+  /// Checks that `name` is found in `box`, and it is the object `expected`.
+  void checkFound(
+    icarus::trigger::PlotSandbox const& box, std::string const& name,
+    TH1 const* expected
+  ) {
+    BOOST_TEST_CONTEXT("object '" << name << "' in '" << box.ID() << "'") {
+      BOOST_TEST_REQUIRE(expected);
+      BOOST_TEST(box.use<TH1>(name) == expected);
+      BOOST_TEST(box.get<TH1>(name) == expected);
+      BOOST_TEST(&box.demand<TH1>(name) == expected);
+      BOOST_TEST(findInDirectory(box, name) == expected);
+    }
+  } // checkFound()
+
+
+  /// Checks that `name` is not found in `box`, as in its ROOT directory.
+  void checkNotFound
+    (icarus::trigger::PlotSandbox const& box, std::string const& name)
+  {
+    BOOST_TEST_CONTEXT("object '" << name << "' in '" << box.ID() << "'") {
+      BOOST_TEST(!findInDirectory(box, name));
+      BOOST_TEST(!box.use<TH1>(name));
+      BOOST_CHECK_THROW(box.demand<TH1>(name), cet::exception);
+    }
+  } // checkNotFound()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MakeDemandDeleteTest) {
+
+  TMemFile file { "PlotSandbox_test.root", "RECREATE" };
+  TestFileDirectory const fileDir { file };
+
+  icarus::trigger::PlotSandbox box { fileDir, "Box", "in the box" };
+
+  // make -> demand
+  TH1* const hA = box.make<TH1F>("A", "A", 10, 0.0, 1.0);
+  TH1* const hB = box.make<TH1F>("dir/B", "B", 10, 0.0, 1.0);
+  checkFound(box, "A", hA);
+  checkFound(box, "dir/B", hB);
+  BOOST_TEST(box.use<TH1>("B") == nullptr); // not without its path
+
+  // the object can't be converted: no object
+  BOOST_TEST(box.use<TDirectory>("A") == nullptr);
+
+  // a new histogram with the same name replaces the old one
+  TH1* const hB2 = box.make<TH1F>("dir/B", "B again", 5, 0.0, 1.0);
+  BOOST_TEST(hB2 != hB);
+  BOOST_TEST(box.use<TH1>("dir/B") == hB2);
+  BOOST_TEST(&box.demand<TH1>("dir/B") == hB2);
+
+  // deleteObject -> demand
+  box.deleteObject(hA);
+  checkNotFound(box, "A");
+  checkFound(box, "dir/B", hB2);
+
+  // objects in subboxes, made by the subbox and by its parent via path
+  auto& subbox = box.addSubSandbox("Sub", "in the subbox");
+  TH1* const hC = subbox.make<TH1F>("C", "C", 10, 0.0, 1.0);
+  TH1* const hD = box.make<TH1F>("Sub/D", "D", 10, 0.0, 1.0);
+  checkFound(subbox, "C", hC);
+  checkFound(box, "Sub/D", hD);
+  BOOST_TEST(box.use<TH1>("C") == nullptr); // belongs to the subbox
+
+  auto& subsubbox = subbox.addSubSandbox("SubSub", "deeper");
+  TH1* const hE = subsubbox.make<TH1F>("E", "E", 10, 0.0, 1.0);
+  checkFound(subsubbox, "E", hE);
+
+  // deleteSubSandbox -> demand
+  BOOST_TEST(box.deleteSubSandbox("Sub"));
+  BOOST_TEST(box.findSandbox("Sub") == nullptr);
+  checkNotFound(box, "Sub/D");
+  checkFound(box, "dir/B", hB2);
+
+  // a new subbox with the same name does not see the old objects
+  auto& newSubbox = box.addSubSandbox("Sub", "in the new subbox");
+  checkNotFound(newSubbox, "C");
+  checkNotFound(box, "Sub/D");
+  TH1* const hD2 = box.make<TH1F>("Sub/D", "D again", 10, 0.0, 1.0);
+  checkFound(box, "Sub/D", hD2);
+
+} // BOOST_AUTO_TEST_CASE(MakeDemandDeleteTest)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,134 @@
+/**
+ * @file HitMergingTools_test.cc
+ * @brief Unit test for the helpers in `HitMergingTools.h`
+ * @date October 18, 2026
+ * @see icaruscode/TPC/SignalProcessing/HitFinder/HitMergingTools.h
+ *
+ * The merged collection is compared with the plain concatenation of the inputs
+ * and it is checked to be the same over repeated (parallel) merges; the
+ * channel lookup is compared with a map filled the same way.
+ */
+
+// ICARUS libraries
+#include "icaruscode/TPC/SignalProcessing/HitFinder/HitMergingTools.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( HitMergingTools_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <map>
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// A stand-in for `recob::Hit`.
+  struct TestHit {
+    unsigned int channel;
+    float peakTime;
+    bool operator== (TestHit const& other) const
+      { return (channel == other.channel) && (peakTime == other.peakTime); }
+  };
+
+  /// Returns `nInputs` collections of random hits, some of them empty.
+  std::vector<std::vector<TestHit>> makeInputs
+    (unsigned int nInputs, unsigned int seed)
+  {
+    std::mt19937 engine { seed };
+    std::uniform_int_distribution<unsigned int> nHits { 0U, 5000U };
+    std::uniform_int_distribution<unsigned int> channels { 0U, 55000U };
+    std::uniform_real_distribution<float> times { 0.0f, 4096.0f };
+
+    std::vector<std::vector<TestHit>> inputs(nInputs);
+    for (auto& input: inputs) {
+      if (engine() % 4 == 0) continue; // leave empty
+      for (unsigned int i = nHits(engine); i > 0; --i)
+        input.push_back({ channels(engine), times(engine) });
+    }
+    return inputs;
+  } // makeInputs()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MergeCollections_test) {
+
+  auto const inputs = makeInputs(12U, 1234U);
+
+  std::vector<std::vector<TestHit> const*> inputPtrs;
+  std::vector<TestHit> expected;
+  for (auto const& input: inputs) {
+    inputPtrs.push_back(&input);
+    expected.insert(expected.end(), input.begin(), input.end());
+  }
+
+  std::vector<TestHit> merged { { 7U, 1.0f } }; // content is replaced
+  auto const offsets = icarus::mergeCollections(inputPtrs, merged);
+
+  BOOST_TEST(offsets.size() == inputs.size() + 1U);
+  BOOST_TEST(offsets.back() == expected.size());
+  for (std::size_t i = 0; i < inputs.size(); ++i)
+    BOOST_TEST(offsets[i + 1] - offsets[i] == inputs[i].size());
+  BOOST_TEST((merged == expected));
+
+  // repeated merges give the same result, whatever the scheduling
+  for (int iRun = 0; iRun < 20; ++iRun) {
+    std::vector<TestHit> again;
+    BOOST_TEST((icarus::mergeCollections(inputPtrs, again) == offsets));
+    BOOST_TEST((again == merged));
+  }
+
+  // no input at all
+  std::vector<TestHit> none { { 1U, 1.0f } };
+  BOOST_TEST(icarus::mergeCollections
+    (std::vector<std::vector<TestHit> const*>{}, none).size() == 1U);
+  BOOST_TEST(none.empty());
+
+} // BOOST_AUTO_TEST_CASE(MergeCollections_test)
+
+
+BOOST_AUTO_TEST_CASE(ChannelLookup_test) {
+
+  auto const inputs = makeInputs(5U, 42U);
+
+  // the last entry on a channel wins, as with the assignment to a map
+  std::map<unsigned int, TestHit> expected;
+  icarus::ChannelLookup<TestHit> lookup;
+  for (auto const& input: inputs) {
+    for (TestHit const& hit: input) {
+      expected[hit.channel] = hit;
+      lookup.add(hit.channel, hit);
+    }
+  }
+
+  BOOST_TEST(lookup.size() == expected.size());
+  for (unsigned int channel = 0; channel <= 55100U; ++channel) {
+    auto const it = expected.find(channel);
+    TestHit const* found = lookup.find(channel);
+    if (it == expected.end()) {
+      BOOST_TEST(found == nullptr);
+    }
+    else {
+      BOOST_TEST_REQUIRE(found != nullptr);
+      BOOST_TEST((*found == it->second));
+    }
+  } // for
+
+  lookup.clear();
+  BOOST_TEST(lookup.size() == 0U);
+  BOOST_TEST(lookup.find(expected.begin()->first) == nullptr);
+
+  lookup.add(3U, { 3U, 5.0f });
+  BOOST_TEST(lookup.size() == 1U);
+  BOOST_TEST(lookup.find(3U)->peakTime == 5.0f);
+  BOOST_TEST(lookup.find(2U) == nullptr);
+
+} // BOOST_AUTO_TEST_CASE(ChannelLookup_test)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,140 @@
+/**
+ * @file MorphologicalFilter2D_test.cc
+ * @brief Unit test for `caldata::MorphologicalFilter2D`
+ * @date October 18, 2026
+ * @see icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/MorphologicalFilter2D.h
+ *
+ * The results are compared with the ones from sorting all the values under the
+ * structuring element, for odd and even sizes of the structuring element.
+ */
+
+// ICARUS libraries
+#include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/MorphologicalFilter2D.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( MorphologicalFilter2D_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort()
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  using Image_t = std::vector<std::vector<short>>;
+
+  /// Returns an image of random values in [ `low`, `high` ].
+  Image_t makeImage(
+    std::size_t nWires, std::size_t nTicks, short low, short high,
+    unsigned int seed
+  ) {
+    std::mt19937 engine { seed };
+    std::uniform_int_distribution<short> values { low, high };
+    Image_t image(nWires, std::vector<short>(nTicks));
+    for (auto& waveform: image)
+      for (short& sample: waveform) sample = values(engine);
+    return image;
+  } // makeImage()
+
+
+  /// Checks the filter against sorting, for a `wireSize` x `tickSize` element.
+  void checkFilter
+    (Image_t const& image, std::size_t wireSize, std::size_t tickSize)
+  {
+    BOOST_TEST_MESSAGE("Structuring element: " << wireSize << " x " << tickSize);
+
+    std::size_t const nWires = image.size();
+    std::size_t const nTicks = image.front().size();
+    std::size_t const halfWire = wireSize / 2;
+    std::size_t const halfTick = tickSize / 2;
+
+    std::vector<short const*> wires;
+    for (auto const& waveform: image) wires.push_back(waveform.data());
+
+    caldata::MorphologicalFilter2D filter { wireSize, tickSize };
+
+    std::vector<short> window;
+    std::size_t nextWire = halfWire;
+    filter.filter(wires, nTicks,
+      [&](std::size_t wire, auto const& erosion, auto const& dilation,
+        auto const& median)
+      {
+        BOOST_TEST(wire == nextWire);
+        ++nextWire;
+
+        for (std::size_t tick = halfTick; tick < nTicks - halfTick; ++tick) {
+          std::size_t const firstTick = tick - halfTick;
+          window.clear();
+          for (std::size_t w = wire - halfWire; w < wire - halfWire + wireSize; ++w)
+          {
+            window.insert(window.end(), image[w].begin() + firstTick,
+              image[w].begin() + firstTick + tickSize);
+          }
+          std::sort(window.begin(), window.end());
+
+          BOOST_TEST(erosion[tick] == window.front());
+          BOOST_TEST(dilation[tick] == window.back());
+          BOOST_TEST(median[tick] == window[window.size() / 2]);
+        } // for ticks
+      });
+
+    BOOST_TEST(nextWire == nWires - wireSize + halfWire + 1);
+
+  } // checkFilter()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(OddElement_test) {
+
+  Image_t const image = makeImage(23U, 64U, -40, 60, 1234U);
+  checkFilter(image, 5U, 5U);
+  checkFilter(image, 3U, 7U);
+  checkFilter(image, 1U, 1U);
+
+} // BOOST_AUTO_TEST_CASE(OddElement_test)
+
+
+BOOST_AUTO_TEST_CASE(EvenElement_test) {
+
+  Image_t const image = makeImage(17U, 50U, -300, 300, 5678U);
+  checkFilter(image, 4U, 6U);
+  checkFilter(image, 2U, 5U);
+  checkFilter(image, 5U, 2U);
+
+} // BOOST_AUTO_TEST_CASE(EvenElement_test)
+
+
+BOOST_AUTO_TEST_CASE(LargeElement_test) {
+
+  // element covering the whole image, and a constant image
+  Image_t const image = makeImage(9U, 12U, 0, 5, 42U);
+  checkFilter(image, 9U, 12U);
+  checkFilter(image, 8U, 11U);
+  checkFilter(Image_t(6U, std::vector<short>(20U, 7)), 3U, 3U);
+
+} // BOOST_AUTO_TEST_CASE(LargeElement_test)
+
+
+BOOST_AUTO_TEST_CASE(SmallImage_test) {
+
+  // no wire with a full structuring element
+  Image_t const image = makeImage(3U, 30U, 0, 10, 7U);
+  std::vector<short const*> wires;
+  for (auto const& waveform: image) wires.push_back(waveform.data());
+
+  unsigned int nCalls = 0U;
+  caldata::MorphologicalFilter2D { 5U, 5U }.filter(wires, 30U,
+    [&nCalls](std::size_t, auto const&, auto const&, auto const&){ ++nCalls; }
+    );
+  BOOST_TEST(nCalls == 0U);
+
+} // BOOST_AUTO_TEST_CASE(SmallImage_test)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,147 @@
+/**
+ * @file ChannelROIWireView_test.cc
+ * @brief Unit test for `recob::ChannelROIWireView`
+ * @date October 18, 2026
+ * @see icaruscode/TPC/Utilities/ChannelROIWireView.h
+ *
+ * The view is compared with the `recob::Wire` which `ROIConvert` used to make,
+ * copying the samples of each region of interest one by one.
+ */
+
+// ICARUS libraries
+#include "icaruscode/TPC/Utilities/ChannelROIWireView.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ChannelROIWireView_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard libraries
+#include <random>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Returns a channel with `nROIs` random regions of interest.
+  recob::ChannelROI makeChannelROI
+    (raw::ChannelID_t channel, unsigned int nROIs, unsigned int seed)
+  {
+    std::mt19937 engine { seed };
+    std::uniform_int_distribution<std::size_t> gaps { 1U, 200U };
+    std::uniform_int_distribution<std::size_t> lengths { 1U, 80U };
+    std::uniform_int_distribution<short int> samples { -2048, 2047 };
+
+    recob::ChannelROI::RegionsOfInterest_t ROIs;
+    std::size_t tick = gaps(engine);
+    for (unsigned int iROI = 0; iROI < nROIs; ++iROI) {
+      std::vector<short int> data(lengths(engine));
+      for (short int& sample: data) sample = samples(engine);
+      ROIs.add_range(tick, data);
+      tick += data.size() + gaps(engine);
+    }
+    return { std::move(ROIs), channel };
+  } // makeChannelROI()
+
+
+  /// The wire `ROIConvert` made from `channelROI`, sample by sample.
+  recob::Wire convertOneByOne
+    (recob::ChannelROI const& channelROI, geo::View_t view)
+  {
+    recob::Wire::RegionsOfInterest_t ROIVec;
+    for (auto const& range: channelROI.SignalROI().get_ranges()) {
+      std::vector<float> dataVec(range.data().size());
+      for (std::size_t binIdx = 0; binIdx < range.data().size(); ++binIdx)
+        dataVec[binIdx] = range.data()[binIdx];
+      ROIVec.add_range(range.begin_index(), std::move(dataVec));
+    }
+    return { std::move(ROIVec), channelROI.Channel(), view };
+  } // convertOneByOne()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Conversion_test) {
+
+  recob::ChannelROI const channelROI = makeChannelROI(1234U, 12U, 42U);
+  recob::Wire const expected = convertOneByOne(channelROI, geo::kV);
+
+  recob::ChannelROIWireView const view { channelROI, geo::kV };
+  BOOST_TEST(view.Channel() == 1234U);
+  BOOST_TEST(view.View() == geo::kV);
+  BOOST_TEST(view.NSignal() == channelROI.NSignal());
+  BOOST_TEST(&view.channelROI() == &channelROI);
+
+  // regions of interest, read on the fly
+  auto const& expectedROIs = expected.SignalROI().get_ranges();
+  auto const ROIs = view.get_ranges();
+  BOOST_TEST_REQUIRE(ROIs.size() == expectedROIs.size());
+  std::size_t iROI = 0;
+  for (auto const& ROI: ROIs) {
+    auto const& expectedROI = expectedROIs[iROI++];
+    BOOST_TEST(ROI.begin_index() == expectedROI.begin_index());
+    BOOST_TEST(ROI.end_index() == expectedROI.end_index());
+    BOOST_TEST(ROI.size() == expectedROI.size());
+    BOOST_TEST(ROI.data() == expectedROI.data());
+    for (std::size_t i = 0; i < ROI.size(); ++i) {
+      BOOST_TEST(ROI.at(i) == expectedROI.data()[i]);
+      BOOST_TEST(ROI[ROI.begin_index() + i] == expectedROI.data()[i]);
+    }
+  } // for
+
+  // full content
+  BOOST_TEST(view.Signal() == expected.Signal());
+  std::vector<float> signal(5U, 3.0f); // content is replaced
+  view.Signal(signal);
+  BOOST_TEST(signal == expected.Signal());
+
+  recob::Wire const wire = view.makeWire();
+  BOOST_TEST(wire.Channel() == expected.Channel());
+  BOOST_TEST(wire.View() == expected.View());
+  BOOST_TEST(wire.NSignal() == expected.NSignal());
+  BOOST_TEST(wire.SignalROI().n_ranges() == expected.SignalROI().n_ranges());
+  BOOST_TEST(wire.Signal() == expected.Signal());
+
+} // BOOST_AUTO_TEST_CASE(Conversion_test)
+
+
+BOOST_AUTO_TEST_CASE(Scale_test) {
+
+  recob::ChannelROI const channelROI = makeChannelROI(7U, 5U, 1234U);
+  recob::ChannelROIWireView const plain { channelROI };
+  recob::ChannelROIWireView const scaled { channelROI, geo::kW, 0.5f };
+
+  BOOST_TEST(plain.View() == geo::kUnknown);
+  BOOST_TEST(scaled.Scale() == 0.5f);
+
+  std::vector<float> const plainSignal = plain.Signal();
+  std::vector<float> const scaledSignal = scaled.Signal();
+  BOOST_TEST_REQUIRE(scaledSignal.size() == plainSignal.size());
+  for (std::size_t tick = 0; tick < plainSignal.size(); ++tick)
+    BOOST_TEST(scaledSignal[tick] == 0.5f * plainSignal[tick]);
+
+  for (auto const& ROI: scaled.get_ranges()) {
+    for (std::size_t i = 0; i < ROI.size(); ++i)
+      BOOST_TEST(ROI.at(i) == 0.5f * ROI.channelRange().data()[i]);
+  }
+
+} // BOOST_AUTO_TEST_CASE(Scale_test)
+
+
+BOOST_AUTO_TEST_CASE(Empty_test) {
+
+  recob::ChannelROI::RegionsOfInterest_t ROIs;
+  ROIs.resize(50U);
+  recob::ChannelROI const channelROI { std::move(ROIs), 3U };
+  recob::ChannelROIWireView const view { channelROI };
+
+  BOOST_TEST(view.get_ranges().empty());
+  BOOST_TEST(view.Signal() == std::vector<float>(50U, 0.0f));
+  BOOST_TEST(view.makeWire().NSignal() == 50U);
+
+} // BOOST_AUTO_TEST_CASE(Empty_test)
+
+
+// -----------------------------------------------------------------------------